@@ -0,0 +1,485 @@
+/**************************************************//*
+	@file	| AssetRegistry.cpp
+	@brief	| アセット管理クラスのcppファイル
+	@note	| テクスチャ・モデルをハッシュ化したIDで管理し、
+			| 参照カウントとLRU方式の破棄を行う
+			| シングルトンパターンで作成
+*//**************************************************/
+#include "AssetRegistry.h"
+#include "JobSystem.h"
+#include <algorithm>
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CAssetRegistry::CAssetRegistry()
+	: m_EntryMap{}
+	, m_nMemoryBudget(ce_nDefaultAssetBudget)
+	, m_ulFrame(0)
+	, m_tStats{}
+	, m_dCounterFreq(1.0)
+{
+	// 検索時間計測用の周波数を取得
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	m_dCounterFreq = static_cast<double>(freq.QuadPart);
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CAssetRegistry::~CAssetRegistry()
+{
+	UnLoadAll();
+}
+
+/****************************************//*
+	@brief　	| フレーム毎の更新処理
+	@note		| メモリ予算を超えていれば参照されていないアセットを古い順に破棄する
+*//****************************************/
+void CAssetRegistry::Update()
+{
+	m_ulFrame++;
+
+	if (m_tStats.m_nMemoryUsage > m_nMemoryBudget)
+	{
+		Evict(m_nMemoryBudget);
+	}
+}
+
+/****************************************//*
+	@brief　	| アセットを読み込み、キーで登録する
+	@param　	| inKind：モデルorテクスチャ
+	@param　	| inPath：読み込むファイルのパス
+	@param　	| inKey：登録するキー
+	@param　	| inScale：モデルのスケール(scale倍)
+	@param　	| inFlip：モデルのフリップ
+	@return　	| 登録したアセットID(失敗時はce_nInvalidAssetID)
+*//****************************************/
+AssetID CAssetRegistry::Register(const RendererKind inKind, const char* inPath, const std::string& inKey, const float inScale, const Model::Flip inFlip)
+{
+	AssetID nID = HashAssetKey(inKey.c_str());
+
+	// そのキーで既に登録済みかをチェックする
+	auto itr = m_EntryMap.find(nID);
+	if (itr != m_EntryMap.end())
+	{
+		// 別のキーとハッシュ値が衝突している場合はエラー
+		if (itr->second.m_sKey != inKey)
+		{
+			std::string sError = "HashCollision:" + inKey + " / " + itr->second.m_sKey;
+			MessageBox(NULL, sError.c_str(), "Error", MB_OK);
+			return ce_nInvalidAssetID;
+		}
+		// 登録済みなら処理を飛ばす
+		return nID;
+	}
+
+	AssetEntry tEntry{};
+	tEntry.m_nID = nID;
+	tEntry.m_sKey = inKey;
+	tEntry.m_tObject.m_eKind = inKind;
+	tEntry.m_sPath = inPath;
+	tEntry.m_fScale = inScale;
+	tEntry.m_eFlip = inFlip;
+	tEntry.m_ulLastUseFrame = m_ulFrame;
+
+	if (!LoadEntry(tEntry))
+	{
+		MessageBox(NULL, inPath, "Error", MB_OK);
+		return ce_nInvalidAssetID;
+	}
+
+	m_EntryMap.emplace(nID, tEntry);
+	return nID;
+}
+
+/****************************************//*
+	@brief　	| 複数のアセットをジョブシステムで並列に読み込み、キーで登録する
+	@param　	| inRequestVec：読み込み要求の配列
+	@return　	| 登録に成功した数(登録済みのものを含む)
+*//****************************************/
+int CAssetRegistry::RegisterAll(const std::vector<AssetRequest>& inRequestVec)
+{
+	int nSuccess = 0;
+
+	// 未登録のものだけを読み込み対象にする
+	std::vector<AssetEntry> tEntryVec;
+	tEntryVec.reserve(inRequestVec.size());
+	for (const AssetRequest& tRequest : inRequestVec)
+	{
+		AssetID nID = HashAssetKey(tRequest.m_sKey.c_str());
+
+		// そのキーで既に登録済みかをチェックする
+		auto itr = m_EntryMap.find(nID);
+		if (itr != m_EntryMap.end())
+		{
+			if (itr->second.m_sKey != tRequest.m_sKey)
+			{
+				std::string sError = "HashCollision:" + tRequest.m_sKey + " / " + itr->second.m_sKey;
+				MessageBox(NULL, sError.c_str(), "Error", MB_OK);
+				continue;
+			}
+			nSuccess++;
+			continue;
+		}
+
+		// 同じ要求の中での重複も読み込まない
+		auto itrSame = std::find_if(tEntryVec.begin(), tEntryVec.end(), [nID](const AssetEntry& tEntry) { return tEntry.m_nID == nID; });
+		if (itrSame != tEntryVec.end()) continue;
+
+		AssetEntry tEntry{};
+		tEntry.m_nID = nID;
+		tEntry.m_sKey = tRequest.m_sKey;
+		tEntry.m_tObject.m_eKind = tRequest.m_eKind;
+		tEntry.m_sPath = tRequest.m_sPath;
+		tEntry.m_fScale = tRequest.m_fScale;
+		tEntry.m_eFlip = tRequest.m_eFlip;
+		tEntry.m_ulLastUseFrame = m_ulFrame;
+		tEntryVec.push_back(tEntry);
+	}
+
+	// ファイルの読み込みと変換をワーカースレッドで並列に行う
+	// (WaitAllでは他の処理が積んだジョブまで待ち、ジョブの中から呼ぶと止まるため、この要求の分だけを待つ)
+	std::vector<char> bResultVec(tEntryVec.size(), 0);
+	CJobSystem* pJobSystem = CJobSystem::GetInstance();
+	CJobSystem::Counter nLoadCounter{ 0 };
+	for (size_t i = 0; i < tEntryVec.size(); i++)
+	{
+		pJobSystem->Submit([&tEntryVec, &bResultVec, i]()
+			{
+				bResultVec[i] = LoadObject(tEntryVec[i]) ? 1 : 0;
+			}, nLoadCounter);
+	}
+	pJobSystem->Wait(nLoadCounter);
+
+	// アトラスへの追加と登録はメインスレッドで行う(まとめて追加した方がページに詰まる)
+	std::vector<AssetEntry*> pLoadedVec;
+	for (size_t i = 0; i < tEntryVec.size(); i++)
+	{
+		if (bResultVec[i]) pLoadedVec.push_back(&tEntryVec[i]);
+	}
+	PackAtlas(pLoadedVec);
+
+	for (size_t i = 0; i < tEntryVec.size(); i++)
+	{
+		if (!bResultVec[i] || !tEntryVec[i].m_bLoaded)
+		{
+			MessageBox(NULL, tEntryVec[i].m_sPath.c_str(), "Error", MB_OK);
+			continue;
+		}
+		CommitEntry(tEntryVec[i]);
+		m_EntryMap.emplace(tEntryVec[i].m_nID, tEntryVec[i]);
+		nSuccess++;
+	}
+
+	return nSuccess;
+}
+
+/****************************************//*
+	@brief　	| キーからアセットIDを検索する
+	@param　	| inKey：登録したキー
+	@return　	| アセットID(未登録の場合はce_nInvalidAssetID)
+*//****************************************/
+AssetID CAssetRegistry::Find(const std::string& inKey)
+{
+	LARGE_INTEGER start, end;
+	QueryPerformanceCounter(&start);
+
+	AssetID nID = HashAssetKey(inKey.c_str());
+	auto itr = m_EntryMap.find(nID);
+	if (itr == m_EntryMap.end() || itr->second.m_sKey != inKey)
+	{
+		nID = ce_nInvalidAssetID;
+	}
+
+	QueryPerformanceCounter(&end);
+
+	// 検索コストの記録
+	m_tStats.m_ulLookupCount++;
+	m_tStats.m_dLookupTimeUs += static_cast<double>(end.QuadPart - start.QuadPart) * 1000000.0 / m_dCounterFreq;
+
+	return nID;
+}
+
+/****************************************//*
+	@brief　	| アセットの参照を取得する
+	@param　	| inID：アセットID
+	@return　	| アセット情報(存在しない場合はnullptr)
+	@note		| 破棄されていた場合は再読み込みする
+*//****************************************/
+AssetEntry* CAssetRegistry::Acquire(AssetID inID)
+{
+	auto itr = m_EntryMap.find(inID);
+	if (itr == m_EntryMap.end()) return nullptr;
+
+	AssetEntry& tEntry = itr->second;
+
+	// 破棄されていたら読み込み直す
+	if (!tEntry.m_bLoaded)
+	{
+		if (!LoadEntry(tEntry))
+		{
+			MessageBox(NULL, tEntry.m_sPath.c_str(), "Error", MB_OK);
+			return nullptr;
+		}
+		m_tStats.m_nReloadCount++;
+	}
+
+	tEntry.m_nRefCount++;
+	tEntry.m_ulLastUseFrame = m_ulFrame;
+	return &tEntry;
+}
+
+/****************************************//*
+	@brief　	| アセットの参照を手放す
+	@param　	| inID：アセットID
+*//****************************************/
+void CAssetRegistry::Release(AssetID inID)
+{
+	auto itr = m_EntryMap.find(inID);
+	if (itr == m_EntryMap.end()) return;
+
+	if (itr->second.m_nRefCount > 0)
+	{
+		itr->second.m_nRefCount--;
+	}
+}
+
+/****************************************//*
+	@brief　	| 参照されていないアセットを予算内に収まるまで破棄する
+	@param　	| inBudget：メモリ予算(バイト)
+*//****************************************/
+void CAssetRegistry::Evict(size_t inBudget)
+{
+	// 破棄候補(参照されていない読み込み済みアセット)を集める
+	std::vector<AssetEntry*> candidateVec;
+	for (auto& itr : m_EntryMap)
+	{
+		// アトラスのページは他のテクスチャと共有しているので破棄しても減らない
+		if (itr.second.m_bLoaded && itr.second.m_nRefCount == 0 && !itr.second.m_bAtlas)
+		{
+			candidateVec.push_back(&itr.second);
+		}
+	}
+
+	// 最後に使用したフレームが古い順に並べる
+	std::sort(candidateVec.begin(), candidateVec.end(), [](const AssetEntry* a, const AssetEntry* b)
+		{
+			return a->m_ulLastUseFrame < b->m_ulLastUseFrame;
+		});
+
+	for (AssetEntry* pEntry : candidateVec)
+	{
+		if (m_tStats.m_nMemoryUsage <= inBudget) break;
+
+		UnLoadEntry(*pEntry);
+		m_tStats.m_nEvictCount++;
+	}
+}
+
+/****************************************//*
+	@brief　	| 登録した全てのアセットを解放する
+*//****************************************/
+void CAssetRegistry::UnLoadAll()
+{
+	for (auto& itr : m_EntryMap)
+	{
+		UnLoadEntry(itr.second);
+	}
+	m_EntryMap.clear();
+	CTextureAtlas::GetInstance()->Clear();
+}
+
+/****************************************//*
+	@brief　	| アセットの実データを読み込む
+	@param　	| inEntry：読み込むアセット情報
+	@return　	| true:成功 false:失敗
+*//****************************************/
+bool CAssetRegistry::LoadEntry(AssetEntry& inEntry)
+{
+	if (!LoadObject(inEntry)) return false;
+
+	PackAtlas({ &inEntry });
+	if (!inEntry.m_bLoaded) return false;
+
+	CommitEntry(inEntry);
+	return true;
+}
+
+/****************************************//*
+	@brief　	| アセットの実データを作成する
+	@param　	| inEntry：読み込むアセット情報
+	@return　	| true:成功 false:失敗
+	@note		| 計測情報には触れないのでワーカースレッドから呼び出せる
+*//****************************************/
+bool CAssetRegistry::LoadObject(AssetEntry& inEntry)
+{
+	Texture* pTexture = nullptr;    // 読み込み用テクスチャクラスポインタ
+	Model* pModel = nullptr;        // 読み込み用モデルクラスポインタ
+	size_t nMemorySize = 0;         // 使用メモリ量の概算
+
+	switch (inEntry.m_tObject.m_eKind)
+	{
+	case RendererKind::Texture:
+		// スプライトは中心が原点で1辺が1の四角形なので、その対角線の半分を半径にする
+		inEntry.m_tObject.m_tBounds = { DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f), 0.70710678f };
+		inEntry.m_tObject.m_f4UVRect = DirectX::XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f);
+
+		// 小さい画像は画素だけを読み込み、メインスレッドでアトラスに追加する
+		if (CTextureAtlas::LoadPixels(inEntry.m_sPath.c_str(), inEntry.m_tAtlasImage))
+		{
+			inEntry.m_tAtlasImage.m_sKey = inEntry.m_sKey;
+			inEntry.m_tObject.m_Data = static_cast<Texture*>(nullptr);
+			nMemorySize = inEntry.m_tAtlasImage.m_PixelVec.size();
+			break;
+		}
+
+		// テクスチャの読み込み
+		pTexture = new(std::nothrow) Texture();
+		if (!pTexture || FAILED(pTexture->Create(inEntry.m_sPath.c_str())))
+		{
+			SAFE_DELETE(pTexture);
+			return false;
+		}
+		// 変換済みのDDSならブロック圧縮とミップを含んだサイズになる
+		nMemorySize = pTexture->GetMemorySize();
+		inEntry.m_tObject.m_Data = pTexture;
+		break;
+	case RendererKind::Model:
+	{
+		// モデルの読み込み
+		pModel = new(std::nothrow) Model();
+		if (!pModel || !pModel->Load(inEntry.m_sPath.c_str(), inEntry.m_fScale, inEntry.m_eFlip))
+		{
+			SAFE_DELETE(pModel);
+			return false;
+		}
+
+		// Mesh情報の取得
+		ModelParam tModel;
+		tModel.m_pModel = pModel;
+		for (unsigned int i = 0; i < pModel->GetMeshNum(); i++)
+		{
+			const Model::Mesh* pMesh = pModel->GetMesh(i);
+			tModel.m_tMeshVec.push_back(*pMesh);
+
+			// GPUに置いたバッファのサイズ(LODのインデックスを含む)
+			if (!pMesh->pMesh) continue;
+			MeshBuffer::Description tDesc = pMesh->pMesh->GetDesc();
+			nMemorySize += static_cast<size_t>(tDesc.vtxSize) * tDesc.vtxCount;
+			nMemorySize += static_cast<size_t>(tDesc.idxSize) * tDesc.idxCount;
+		}
+		for (unsigned int i = 0; i < pModel->GetMaterialNum(); i++)
+		{
+			const Texture* pMaterialTex = pModel->GetMaterial(i)->pTexture;
+			if (pMaterialTex)
+			{
+				nMemorySize += pMaterialTex->GetMemorySize();
+			}
+		}
+		inEntry.m_tObject.m_Data = tModel;
+
+		// モデルの境界ボックスを囲む球
+		DirectX::XMFLOAT3 f3Min, f3Max;
+		pModel->GetBounds(f3Min, f3Max);
+		DirectX::XMVECTOR vMin = DirectX::XMLoadFloat3(&f3Min);
+		DirectX::XMVECTOR vMax = DirectX::XMLoadFloat3(&f3Max);
+		DirectX::XMStoreFloat3(&inEntry.m_tObject.m_tBounds.m_f3Center, DirectX::XMVectorScale(DirectX::XMVectorAdd(vMin, vMax), 0.5f));
+		inEntry.m_tObject.m_tBounds.m_fRadius = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(vMax, vMin))) * 0.5f;
+	}
+	break;
+	}
+
+	inEntry.m_bLoaded = true;
+	inEntry.m_nMemorySize = nMemorySize;
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 読み込んだ小さいテクスチャをアトラスにまとめて追加する
+	@param　	| inEntryVec：読み込んだアセット情報
+	@note		| 入らなかったものは単独のテクスチャにする。作成に失敗したものは未読み込みに戻す
+*//****************************************/
+void CAssetRegistry::PackAtlas(const std::vector<AssetEntry*>& inEntryVec)
+{
+	std::vector<AssetEntry*> pTargetVec;
+	std::vector<const AtlasImage*> pImageVec;
+	for (AssetEntry* pEntry : inEntryVec)
+	{
+		if (pEntry->m_tAtlasImage.m_PixelVec.empty()) continue;
+		pTargetVec.push_back(pEntry);
+		pImageVec.push_back(&pEntry->m_tAtlasImage);
+	}
+	if (pTargetVec.empty()) return;
+
+	std::vector<AtlasRegion> tRegionVec;
+	CTextureAtlas::GetInstance()->Add(pImageVec, tRegionVec);
+
+	for (size_t i = 0; i < pTargetVec.size(); i++)
+	{
+		AssetEntry& tEntry = *pTargetVec[i];
+		AtlasImage& tImage = tEntry.m_tAtlasImage;
+		if (tRegionVec[i].m_pPage)
+		{
+			// ページのテクスチャと使用範囲を参照する
+			tEntry.m_tObject.m_Data = tRegionVec[i].m_pPage;
+			tEntry.m_tObject.m_f4UVRect = tRegionVec[i].m_f4UVRect;
+			tEntry.m_bAtlas = true;
+		}
+		else
+		{
+			// 入らなかったものは読み込んだ画素から単独のテクスチャを作成する
+			Texture* pTexture = new(std::nothrow) Texture();
+			if (!pTexture || FAILED(pTexture->Create(DXGI_FORMAT_R8G8B8A8_UNORM, tImage.m_nWidth, tImage.m_nHeight, tImage.m_PixelVec.data())))
+			{
+				SAFE_DELETE(pTexture);
+				tEntry.m_bLoaded = false;
+			}
+			tEntry.m_tObject.m_Data = pTexture;
+			tEntry.m_bAtlas = false;
+		}
+
+		// 画素はページに書き込んだので手放す
+		std::vector<uint8_t>().swap(tImage.m_PixelVec);
+	}
+}
+
+/****************************************//*
+	@brief　	| 読み込んだアセットを計測情報に反映する
+	@param　	| inEntry：読み込んだアセット情報
+*//****************************************/
+void CAssetRegistry::CommitEntry(AssetEntry& inEntry)
+{
+	m_tStats.m_nMemoryUsage += inEntry.m_nMemorySize;
+	m_tStats.m_nLoadedCount++;
+}
+
+/****************************************//*
+	@brief　	| アセットの実データを解放する
+	@param　	| inEntry：解放するアセット情報
+*//****************************************/
+void CAssetRegistry::UnLoadEntry(AssetEntry& inEntry)
+{
+	if (!inEntry.m_bLoaded) return;
+
+	switch (inEntry.m_tObject.m_eKind)
+	{
+	case RendererKind::Texture:
+		// テクスチャならばテクスチャのdeleteをする(アトラスのページはアトラスが破棄する)
+		if (inEntry.m_bAtlas) std::get<Texture*>(inEntry.m_tObject.m_Data) = nullptr;
+		else SAFE_DELETE(std::get<Texture*>(inEntry.m_tObject.m_Data));
+		inEntry.m_bAtlas = false;
+		break;
+	case RendererKind::Model:
+		// モデルならばモデルのdeleteをする
+		SAFE_DELETE(std::get<ModelParam>(inEntry.m_tObject.m_Data).m_pModel);
+		std::get<ModelParam>(inEntry.m_tObject.m_Data).m_tMeshVec.clear();
+		break;
+	}
+
+	inEntry.m_bLoaded = false;
+	m_tStats.m_nMemoryUsage -= inEntry.m_nMemorySize;
+	m_tStats.m_nLoadedCount--;
+	inEntry.m_nMemorySize = 0;
+}
@@ -0,0 +1,232 @@
+/**************************************************//*
+	@file	| AssetRegistry.h
+	@brief	| アセット管理クラスのhファイル
+	@note	| テクスチャ・モデルをハッシュ化したIDで管理し、
+			| 参照カウントとLRU方式の破棄を行う
+			| シングルトンパターンで作成
+*//**************************************************/
+#pragma once
+#include "Singleton.h"
+#include "RendererComponent.h"
+#include "TextureAtlas.h"
+#include <unordered_map>
+#include <cstdint>
+
+// @brief アセットID(キー文字列のハッシュ値)
+using AssetID = uint32_t;
+
+// @brief 無効なアセットID
+constexpr AssetID ce_nInvalidAssetID = 0;
+
+// @brief メモリ予算の初期値(バイト)
+constexpr size_t ce_nDefaultAssetBudget = 256 * 1024 * 1024;
+
+// @brief キー文字列からアセットIDを生成する(FNV-1a)
+// @param inKey：キー文字列
+// @return アセットID
+constexpr AssetID HashAssetKey(const char* inKey)
+{
+	AssetID nHash = 2166136261u;
+	while (*inKey)
+	{
+		nHash ^= static_cast<uint8_t>(*inKey++);
+		nHash *= 16777619u;
+	}
+	// 0は無効IDとして予約しているので避ける
+	return nHash == ce_nInvalidAssetID ? 1u : nHash;
+}
+
+// @brief 登録されたアセットの情報
+struct AssetEntry
+{
+	// アセットID
+	AssetID m_nID;
+
+	// 登録キー(デバッグ表示用)
+	std::string m_sKey;
+
+	// 描画するオブジェクトの情報
+	RendererObject m_tObject;
+
+	// 読み込み済みかどうか
+	bool m_bLoaded;
+
+	// 参照しているコンポーネントの数
+	int m_nRefCount;
+
+	// 使用メモリ量の概算(バイト)
+	size_t m_nMemorySize;
+
+	// アトラスに入っているか(ページは共有なので破棄しない)
+	bool m_bAtlas;
+
+	// アトラスに追加する画素(読み込みから登録までの一時データ)
+	AtlasImage m_tAtlasImage;
+
+	// 最後に使用したフレーム
+	uint64_t m_ulLastUseFrame;
+
+	// 再読み込み用のパス
+	std::string m_sPath;
+
+	// 再読み込み用のモデルのスケール
+	float m_fScale;
+
+	// 再読み込み用のモデルのフリップ
+	Model::Flip m_eFlip;
+};
+
+// @brief アセットの読み込み要求
+struct AssetRequest
+{
+	// モデルorテクスチャ
+	RendererKind m_eKind;
+
+	// 読み込むファイルのパス
+	std::string m_sPath;
+
+	// 登録するキー
+	std::string m_sKey;
+
+	// モデルのスケール
+	float m_fScale;
+
+	// モデルのフリップ
+	Model::Flip m_eFlip;
+};
+
+// @brief アセット管理の計測情報
+struct AssetStats
+{
+	// キー検索の回数
+	uint64_t m_ulLookupCount;
+
+	// キー検索に掛かった合計時間(マイクロ秒)
+	double m_dLookupTimeUs;
+
+	// 読み込み済みアセットの使用メモリ量(バイト)
+	size_t m_nMemoryUsage;
+
+	// 読み込み済みアセットの数
+	int m_nLoadedCount;
+
+	// 破棄したアセットの数
+	int m_nEvictCount;
+
+	// 破棄後に再読み込みしたアセットの数
+	int m_nReloadCount;
+};
+
+// @brief アセット管理クラス
+class CAssetRegistry : public ISingleton<CAssetRegistry>
+{
+private:
+	// @brief コンストラクタ
+	CAssetRegistry();
+
+	friend class ISingleton<CAssetRegistry>;
+public:
+	// @brief デストラクタ
+	~CAssetRegistry();
+
+	// @brief フレーム毎の更新処理
+	// @note メモリ予算を超えていれば参照されていないアセットを古い順に破棄する
+	void Update();
+
+	// @brief アセットを読み込み、キーで登録する
+	// @param inKind：モデルorテクスチャ
+	// @param inPath：読み込むファイルのパス
+	// @param inKey：登録するキー
+	// @param inScale：モデルのスケール(scale倍)
+	// @param inFlip：モデルのフリップ
+	// @return 登録したアセットID(失敗時はce_nInvalidAssetID)
+	AssetID Register(const RendererKind inKind, const char* inPath, const std::string& inKey, const float inScale, const Model::Flip inFlip);
+
+	// @brief 複数のアセットをジョブシステムで並列に読み込み、キーで登録する
+	// @param inRequestVec：読み込み要求の配列
+	// @return 登録に成功した数
+	int RegisterAll(const std::vector<AssetRequest>& inRequestVec);
+
+	// @brief キーからアセットIDを検索する
+	// @param inKey：登録したキー
+	// @return アセットID(未登録の場合はce_nInvalidAssetID)
+	AssetID Find(const std::string& inKey);
+
+	// @brief アセットの参照を取得する
+	// @param inID：アセットID
+	// @return アセット情報(存在しない場合はnullptr)
+	// @note 破棄されていた場合は再読み込みする
+	AssetEntry* Acquire(AssetID inID);
+
+	// @brief アセットの参照を手放す
+	// @param inID：アセットID
+	void Release(AssetID inID);
+
+	// @brief アセットを使用したことを記録する
+	// @param inEntry：使用したアセット情報
+	void Touch(AssetEntry* inEntry) { inEntry->m_ulLastUseFrame = m_ulFrame; }
+
+	// @brief 参照されていないアセットを予算内に収まるまで破棄する
+	// @param inBudget：メモリ予算(バイト)
+	void Evict(size_t inBudget);
+
+	// @brief 登録した全てのアセットを解放する
+	void UnLoadAll();
+
+	// @brief メモリ予算を設定
+	// @param inBudget：メモリ予算(バイト)
+	void SetMemoryBudget(size_t inBudget) { m_nMemoryBudget = inBudget; }
+
+	// @brief メモリ予算を取得
+	// @return メモリ予算(バイト)
+	size_t GetMemoryBudget() const { return m_nMemoryBudget; }
+
+	// @brief 計測情報を取得
+	// @return 計測情報
+	const AssetStats& GetStats() const { return m_tStats; }
+
+	// @brief 登録されているアセットの一覧を取得
+	// @return アセットIDとアセット情報のマップ
+	const std::unordered_map<AssetID, AssetEntry>& GetEntries() const { return m_EntryMap; }
+
+private:
+	// @brief アセットの実データを読み込む
+	// @param inEntry：読み込むアセット情報
+	// @return true:成功 false:失敗
+	bool LoadEntry(AssetEntry& inEntry);
+
+	// @brief アセットの実データを作成する
+	// @param inEntry：読み込むアセット情報
+	// @return true:成功 false:失敗
+	// @note 計測情報には触れないのでワーカースレッドから呼び出せる
+	static bool LoadObject(AssetEntry& inEntry);
+
+	// @brief 読み込んだ小さいテクスチャをアトラスにまとめて追加する
+	// @param inEntryVec：読み込んだアセット情報
+	// @note 入らなかったものは単独のテクスチャにする。作成に失敗したものは未読み込みに戻す
+	void PackAtlas(const std::vector<AssetEntry*>& inEntryVec);
+
+	// @brief 読み込んだアセットを計測情報に反映する
+	// @param inEntry：読み込んだアセット情報
+	void CommitEntry(AssetEntry& inEntry);
+
+	// @brief アセットの実データを解放する
+	// @param inEntry：解放するアセット情報
+	void UnLoadEntry(AssetEntry& inEntry);
+
+private:
+	// @brief アセットIDをキーにしたアセット情報のマップ
+	std::unordered_map<AssetID, AssetEntry> m_EntryMap;
+
+	// @brief メモリ予算(バイト)
+	size_t m_nMemoryBudget;
+
+	// @brief 現在のフレーム数
+	uint64_t m_ulFrame;
+
+	// @brief 計測情報
+	AssetStats m_tStats;
+
+	// @brief パフォーマンスカウンタの周波数
+	double m_dCounterFreq;
+};
@@ -0,0 +1,168 @@
+/**************************************************//*
+	@file	| AtlasPacker.cpp
+	@brief	| アトラスの矩形配置クラスのcppファイル
+	@note	| imstb_rectpackで複数のページに矩形を詰め込む
+			| 配置の計算だけを行い、デバイスには触れない
+			| ページの空き領域は保持しているので、後から矩形を追加できる
+*//**************************************************/
+#include "AtlasPacker.h"
+
+// imgui_draw.cppの実装はファイル内でのみ有効(STBRP_STATIC)なので、こちらでも実体を作る
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+// @brief ページ1枚分の配置情報
+struct CAtlasPacker::Page
+{
+	// imstb_rectpackの配置状態
+	stbrp_context m_tContext;
+
+	// imstb_rectpackの作業用ノード(ページの横幅分必要)
+	std::vector<stbrp_node> m_NodeVec;
+};
+
+/****************************************//*
+	@brief　	| コンストラクタ
+	@param　	| inPageSize：ページの1辺の大きさ(ピクセル)
+	@param　	| inPadding：矩形の周囲に空ける余白(ピクセル)
+*//****************************************/
+CAtlasPacker::CAtlasPacker(uint32_t inPageSize, uint32_t inPadding)
+	: m_nPageSize(inPageSize)
+	, m_nPadding(inPadding)
+	, m_PageVec{}
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CAtlasPacker::~CAtlasPacker()
+{
+	Clear();
+}
+
+/****************************************//*
+	@brief　	| 複数の矩形をまとめて配置する
+	@param　	| inSizeVec：矩形の大きさ(横幅, 縦幅)の配列
+	@param　	| outPlacementVec：配置結果(inSizeVecと同じ順)
+	@return		| 配置できた矩形の数
+	@note		| 既存のページの空き領域から順に詰め、入らなければページを追加する
+*//****************************************/
+int CAtlasPacker::Pack(const std::vector<std::pair<uint32_t, uint32_t>>& inSizeVec, std::vector<AtlasPlacement>& outPlacementVec)
+{
+	outPlacementVec.assign(inSizeVec.size(), AtlasPlacement{ -1, 0, 0, false });
+
+	// 余白を含めた大きさで配置する(ページより大きいものは最初から除く)
+	std::vector<stbrp_rect> tRectVec;
+	tRectVec.reserve(inSizeVec.size());
+	for (size_t i = 0; i < inSizeVec.size(); i++)
+	{
+		uint32_t nWidth = inSizeVec[i].first + m_nPadding * 2;
+		uint32_t nHeight = inSizeVec[i].second + m_nPadding * 2;
+		if (inSizeVec[i].first == 0 || inSizeVec[i].second == 0 || nWidth > m_nPageSize || nHeight > m_nPageSize)
+		{
+			m_tStats.m_nFailNum++;
+			continue;
+		}
+
+		stbrp_rect tRect = {};
+		tRect.id = static_cast<int>(i);
+		tRect.w = static_cast<stbrp_coord>(nWidth);
+		tRect.h = static_cast<stbrp_coord>(nHeight);
+		tRectVec.push_back(tRect);
+	}
+
+	// 既存のページから順に詰め、残った分を新しいページに詰める
+	int nPackNum = 0;
+	size_t nPage = 0;
+	while (!tRectVec.empty())
+	{
+		bool bNewPage = nPage >= m_PageVec.size();
+		Page* pPage = bNewPage ? AddPage() : m_PageVec[nPage].get();
+		stbrp_pack_rects(&pPage->m_tContext, tRectVec.data(), static_cast<int>(tRectVec.size()));
+
+		std::vector<stbrp_rect> tRestVec;
+		for (const stbrp_rect& tRect : tRectVec)
+		{
+			if (!tRect.was_packed)
+			{
+				tRestVec.push_back(tRect);
+				continue;
+			}
+
+			AtlasPlacement& tPlacement = outPlacementVec[tRect.id];
+			tPlacement.m_nPage = static_cast<int>(nPage);
+			tPlacement.m_nX = static_cast<uint32_t>(tRect.x) + m_nPadding;
+			tPlacement.m_nY = static_cast<uint32_t>(tRect.y) + m_nPadding;
+			tPlacement.m_bValid = true;
+
+			m_tStats.m_nRectNum++;
+			m_tStats.m_ulUsedArea += static_cast<uint64_t>(inSizeVec[tRect.id].first) * inSizeVec[tRect.id].second;
+			m_tStats.m_ulPaddedArea += static_cast<uint64_t>(tRect.w) * tRect.h;
+			nPackNum++;
+		}
+
+		// 空のページに1つも入らない場合は以降も入らない(ページより大きい矩形は除いているので起こらない)
+		if (bNewPage && tRestVec.size() == tRectVec.size())
+		{
+			m_tStats.m_nFailNum += static_cast<int>(tRestVec.size());
+			break;
+		}
+		tRectVec.swap(tRestVec);
+		nPage++;
+	}
+
+	return nPackNum;
+}
+
+/****************************************//*
+	@brief　	| 矩形を1つ配置する
+	@param　	| inWidth：横幅
+	@param　	| inHeight：縦幅
+	@return		| 配置結果
+*//****************************************/
+AtlasPlacement CAtlasPacker::Pack(uint32_t inWidth, uint32_t inHeight)
+{
+	std::vector<AtlasPlacement> tPlacementVec;
+	Pack({ { inWidth, inHeight } }, tPlacementVec);
+	return tPlacementVec[0];
+}
+
+/****************************************//*
+	@brief　	| 全てのページを破棄する
+*//****************************************/
+void CAtlasPacker::Clear()
+{
+	m_PageVec.clear();
+	m_tStats = {};
+}
+
+/****************************************//*
+	@brief　	| ページの使用率の取得
+	@return		| 余白を除いた矩形の面積÷ページの面積の合計(0～1)
+*//****************************************/
+float CAtlasPacker::GetUtilization() const
+{
+	if (m_PageVec.empty()) return 0.0f;
+
+	double dPageArea = static_cast<double>(m_nPageSize) * m_nPageSize * m_PageVec.size();
+	return static_cast<float>(m_tStats.m_ulUsedArea / dPageArea);
+}
+
+/****************************************//*
+	@brief　	| ページを追加する
+	@return		| 追加したページ
+*//****************************************/
+CAtlasPacker::Page* CAtlasPacker::AddPage()
+{
+	std::unique_ptr<Page> pPage = std::make_unique<Page>();
+	pPage->m_NodeVec.resize(m_nPageSize);
+	stbrp_init_target(&pPage->m_tContext, static_cast<int>(m_nPageSize), static_cast<int>(m_nPageSize),
+		pPage->m_NodeVec.data(), static_cast<int>(pPage->m_NodeVec.size()));
+
+	m_PageVec.push_back(std::move(pPage));
+	m_tStats.m_nPageNum = static_cast<int>(m_PageVec.size());
+	return m_PageVec.back().get();
+}
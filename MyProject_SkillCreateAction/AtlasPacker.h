@@ -0,0 +1,110 @@
+/**************************************************//*
+	@file	| AtlasPacker.h
+	@brief	| アトラスの矩形配置クラスのhファイル
+	@note	| imstb_rectpackで複数のページに矩形を詰め込む
+			| 配置の計算だけを行い、デバイスには触れない
+			| ページの空き領域は保持しているので、後から矩形を追加できる
+*//**************************************************/
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// @brief 矩形の配置結果
+struct AtlasPlacement
+{
+	// 配置したページの番号
+	int m_nPage;
+
+	// ページ内の位置(余白を除いた左上、ピクセル)
+	uint32_t m_nX;
+	uint32_t m_nY;
+
+	// 配置できたか(余白を含めてページより大きい場合は失敗する)
+	bool m_bValid;
+};
+
+// @brief 矩形配置の統計情報
+struct AtlasPackerStats
+{
+	// ページ数
+	int m_nPageNum;
+
+	// 配置した矩形の数
+	int m_nRectNum;
+
+	// 配置できなかった矩形の数
+	int m_nFailNum;
+
+	// 配置した矩形の面積の合計(余白を除く、ピクセル)
+	uint64_t m_ulUsedArea;
+
+	// 配置した矩形の面積の合計(余白を含む、ピクセル)
+	uint64_t m_ulPaddedArea;
+};
+
+// @brief アトラスの矩形配置クラス
+class CAtlasPacker
+{
+public:
+	// @brief コンストラクタ
+	// @param inPageSize：ページの1辺の大きさ(ピクセル)
+	// @param inPadding：矩形の周囲に空ける余白(ピクセル)
+	CAtlasPacker(uint32_t inPageSize = 1024, uint32_t inPadding = 2);
+
+	// @brief デストラクタ
+	~CAtlasPacker();
+
+	// @brief 複数の矩形をまとめて配置する
+	// @param inSizeVec：矩形の大きさ(横幅, 縦幅)の配列
+	// @param outPlacementVec：配置結果(inSizeVecと同じ順)
+	// @return 配置できた矩形の数
+	// @note 既存のページの空き領域から順に詰め、入らなければページを追加する
+	int Pack(const std::vector<std::pair<uint32_t, uint32_t>>& inSizeVec, std::vector<AtlasPlacement>& outPlacementVec);
+
+	// @brief 矩形を1つ配置する
+	// @param inWidth：横幅
+	// @param inHeight：縦幅
+	// @return 配置結果
+	AtlasPlacement Pack(uint32_t inWidth, uint32_t inHeight);
+
+	// @brief 全てのページを破棄する
+	void Clear();
+
+	// @brief ページの1辺の大きさの取得
+	// @return 大きさ(ピクセル)
+	uint32_t GetPageSize() const { return m_nPageSize; }
+
+	// @brief 余白の取得
+	// @return 余白(ピクセル)
+	uint32_t GetPadding() const { return m_nPadding; }
+
+	// @brief 統計情報の取得
+	// @return 統計情報
+	const AtlasPackerStats& GetStats() const { return m_tStats; }
+
+	// @brief ページの使用率の取得
+	// @return 余白を除いた矩形の面積÷ページの面積の合計(0～1)
+	float GetUtilization() const;
+
+private:
+	// @brief ページ1枚分の配置情報
+	struct Page;
+
+	// @brief ページを追加する
+	// @return 追加したページ
+	Page* AddPage();
+
+private:
+	// @brief ページの1辺の大きさ(ピクセル)
+	uint32_t m_nPageSize;
+
+	// @brief 矩形の周囲に空ける余白(ピクセル)
+	uint32_t m_nPadding;
+
+	// @brief ページ
+	std::vector<std::unique_ptr<Page>> m_PageVec;
+
+	// @brief 統計情報
+	AtlasPackerStats m_tStats;
+};
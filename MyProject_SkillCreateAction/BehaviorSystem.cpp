@@ -0,0 +1,1216 @@
+/**************************************************//*
+	@file	| BehaviorSystem.cpp
+	@brief	| ビヘイビアツリーの実行クラスのcppファイル
+	@note	| 歩行者毎に実行中の葉だけを覚えておき、毎フレーム木を根からたどり直さない
+			| 葉は時間が来た時、行動が次のフレームを求めた時、見張っている黒板の値が変わった時だけ進める
+			| 値が変わった時は根から評価し直し、優先度の高い枝の条件が通れば実行中の葉を中断して切り替える
+			| (条件で始まらない優先度の高い枝は、木を根からやり直した時にだけ試し直す)
+			| 進める歩行者は待ち行列に積み、1回の更新で使う時間を超えた分は次のフレームに回す
+			| シングルトンパターンで作成
+*//**************************************************/
+#include "BehaviorSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+namespace
+{
+	// @brief 番号の枠の部分のビット数
+	constexpr uint32_t ce_nSlotBits = 20;
+
+	// @brief 番号の枠の部分のマスク
+	constexpr uint32_t ce_nSlotMask = (1u << ce_nSlotBits) - 1;
+
+	// @brief 空いている枠の並びの番号
+	constexpr uint32_t ce_nFreeIndex = ce_nSlotMask;
+
+	// @brief 実行中の葉が無い
+	constexpr uint32_t ce_nNoNode = UINT32_MAX;
+
+	// @brief 使った時間を確かめる間隔(進めた歩行者の数、時計を読む回数を減らす)
+	constexpr int ce_nBudgetCheck = 8;
+
+	// @brief 計測用の敵の行動
+	enum BenchAction : uint32_t
+	{
+		// 警戒(立ち止まった後に警報を消す)
+		BenchAlert,
+
+		// 攻撃
+		BenchAttack,
+
+		// 追跡(毎フレーム進める)
+		BenchChase,
+
+		// 巡回先を決める
+		BenchPickPatrol,
+
+		// 巡回先へ移動(着く時間まで待つ)
+		BenchMoveTo,
+
+		// 行動の数
+		BenchActionNum,
+	};
+
+	// @brief 計測用の敵
+	class CBenchEnemy : public IBehaviorAgent
+	{
+	public:
+		// 巡回の中心
+		float m_fHomeX, m_fHomeZ;
+
+		// 位置(移動中は移動を始めた位置)
+		float m_fPosX, m_fPosZ;
+
+		// 移動先
+		float m_fToX, m_fToZ;
+
+		// 移動を始めた時間
+		double m_dMoveStart;
+
+		// 移動にかかる時間(0:移動していない)
+		float m_fMoveTime;
+
+		// 巡回した回数
+		uint32_t m_nPatrol;
+
+		// 行動毎に始めた回数
+		uint32_t m_nStartNum[BenchActionNum];
+
+		// 追う相手の位置(XZ)
+		const float* m_pTarget;
+
+		// 警報のキー
+		uint32_t m_nAlarmKey;
+
+		// @brief 今の位置の取得(移動中は移動先との間を補間する)
+		void GetPos(double inTime, float& outX, float& outZ) const
+		{
+			float fRate = m_fMoveTime > 0.0f ? (std::min)(1.0f, static_cast<float>((inTime - m_dMoveStart) / m_fMoveTime)) : 0.0f;
+			outX = m_fPosX + (m_fToX - m_fPosX) * fRate;
+			outZ = m_fPosZ + (m_fToZ - m_fPosZ) * fRate;
+		}
+
+		// @brief 行動を実行する
+		BehaviorStatus OnBehaviorAction(BehaviorContext& ioContext) override
+		{
+			static constexpr float ce_fChaseSpeed = 5.0f;
+			static constexpr float ce_fWalkSpeed = 2.0f;
+			static constexpr float ce_fPatrol[4][2] = { { 6.0f, 0.0f }, { 0.0f, 6.0f }, { -6.0f, 0.0f }, { 0.0f, -6.0f } };
+			if (ioContext.m_bStart) m_nStartNum[ioContext.m_nAction]++;
+
+			switch (ioContext.m_nAction)
+			{
+			case BenchAlert:
+				if (ioContext.m_bStart)
+				{
+					ioContext.m_fSleep = 2.0f;
+					return BehaviorStatus::Running;
+				}
+				ioContext.m_pSystem->SetInt(ioContext.m_nHandle, m_nAlarmKey, 0);
+				return BehaviorStatus::Success;
+			case BenchAttack:
+				if (ioContext.m_bStart)
+				{
+					ioContext.m_fSleep = 0.8f;
+					return BehaviorStatus::Running;
+				}
+				return BehaviorStatus::Success;
+			case BenchChase:
+			{
+				float fDx = m_pTarget[0] - m_fPosX, fDz = m_pTarget[1] - m_fPosZ;
+				float fDistance = sqrtf(fDx * fDx + fDz * fDz);
+				if (fDistance > 1e-4f)
+				{
+					float fRate = (std::min)(ce_fChaseSpeed * ioContext.m_fDeltaTime, fDistance) / fDistance;
+					m_fPosX += fDx * fRate;
+					m_fPosZ += fDz * fRate;
+				}
+				ioContext.m_fSleep = 0.0f;
+				return BehaviorStatus::Running;
+			}
+			case BenchPickPatrol:
+				m_nPatrol++;
+				m_fToX = m_fHomeX + ce_fPatrol[m_nPatrol % 4][0];
+				m_fToZ = m_fHomeZ + ce_fPatrol[m_nPatrol % 4][1];
+				return BehaviorStatus::Success;
+			case BenchMoveTo:
+				if (ioContext.m_bStart)
+				{
+					float fDx = m_fToX - m_fPosX, fDz = m_fToZ - m_fPosZ;
+					m_fMoveTime = sqrtf(fDx * fDx + fDz * fDz) / ce_fWalkSpeed;
+					m_dMoveStart = ioContext.m_pSystem->GetTime();
+					if (m_fMoveTime <= 0.0f) return BehaviorStatus::Success;
+					ioContext.m_fSleep = m_fMoveTime;
+					return BehaviorStatus::Running;
+				}
+				m_fPosX = m_fToX;
+				m_fPosZ = m_fToZ;
+				m_fMoveTime = 0.0f;
+				return BehaviorStatus::Success;
+			}
+			return BehaviorStatus::Failure;
+		}
+
+		// @brief 実行中の行動を中断する(移動は途中の位置で止まる)
+		void OnBehaviorAbort(const BehaviorContext& inContext) override
+		{
+			if (inContext.m_nAction != BenchMoveTo) return;
+
+			float fX, fZ;
+			GetPos(inContext.m_pSystem->GetTime(), fX, fZ);
+			m_fPosX = fX;
+			m_fPosZ = fZ;
+			m_fMoveTime = 0.0f;
+		}
+	};
+
+	// @brief 成功と失敗を入れ替える
+	// @param inStatus：結果
+	// @return 入れ替えた結果(実行中はそのまま)
+	BehaviorStatus Invert(BehaviorStatus inStatus)
+	{
+		if (inStatus == BehaviorStatus::Success) return BehaviorStatus::Failure;
+		if (inStatus == BehaviorStatus::Failure) return BehaviorStatus::Success;
+		return inStatus;
+	}
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CBehaviorSystem::CBehaviorSystem()
+	: m_nReadyHead(0)
+	, m_dBudgetMs(ce_dDefaultBudgetMs)
+	, m_bFullTick(false)
+	, m_bUpdating(false)
+	, m_bHasRemoved(false)
+	, m_dTime(0.0)
+	, m_nFrame(0)
+	, m_nEventNum(0)
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CBehaviorSystem::~CBehaviorSystem()
+{
+}
+
+/****************************************//*
+	@brief　	| 組み立て済みの木を登録する
+	@param　	| inTree：組み立て済みの木
+	@return		| 木の番号
+*//****************************************/
+BehaviorTreeId CBehaviorSystem::AddTree(BehaviorTree&& inTree)
+{
+	m_TreeVec.push_back(std::move(inTree));
+	return static_cast<BehaviorTreeId>(m_TreeVec.size() - 1);
+}
+
+/****************************************//*
+	@brief　	| 名前から木を探す
+	@param　	| inName：名前
+	@return		| 木の番号(無ければce_nInvalidTree)
+*//****************************************/
+BehaviorTreeId CBehaviorSystem::FindTree(const std::string& inName) const
+{
+	for (uint32_t i = 0; i < m_TreeVec.size(); i++)
+	{
+		if (m_TreeVec[i].m_sName == inName) return i;
+	}
+	return ce_nInvalidTree;
+}
+
+/****************************************//*
+	@brief　	| 歩行者の配列を確保する
+	@param　	| inCapacity：最初に確保する歩行者の数(超えた分は追加時に広げる)
+*//****************************************/
+void CBehaviorSystem::Init(uint32_t inCapacity)
+{
+	Clear();
+
+	// 空きを表す並びの番号と重ならないよう、枠の部分で表せる数より1つ少なくする
+	inCapacity = (std::min)(inCapacity, ce_nMaxCapacity - 1);
+	m_AgentVec.reserve(inCapacity);
+	m_BlackboardVec.reserve(inCapacity);
+	m_SlotOfVec.reserve(inCapacity);
+	m_SlotVec.reserve(inCapacity);
+	m_ReadyVec.reserve(inCapacity);
+	m_NextFrameVec.reserve(inCapacity);
+}
+
+/****************************************//*
+	@brief　	| 歩行者を追加する
+	@param　	| inTree：木の番号
+	@param　	| inAgent：行動を実行する先(外すまで破棄しない)
+	@return		| 歩行者の番号(上限に達しているか木が無ければce_nInvalidHandle)
+*//****************************************/
+BehaviorHandle CBehaviorSystem::Add(BehaviorTreeId inTree, IBehaviorAgent* inAgent)
+{
+	if (inTree >= m_TreeVec.size() || inAgent == nullptr) return ce_nInvalidHandle;
+
+	// 空いている枠が無ければ枠を増やす(空きを表す並びの番号と重ならない数まで)
+	uint32_t nSlot;
+	if (!m_FreeSlotVec.empty())
+	{
+		nSlot = m_FreeSlotVec.back();
+		m_FreeSlotVec.pop_back();
+	}
+	else
+	{
+		if (m_SlotVec.size() >= ce_nMaxCapacity - 1) return ce_nInvalidHandle;
+		nSlot = static_cast<uint32_t>(m_SlotVec.size());
+		m_SlotVec.push_back(ce_nFreeIndex);
+	}
+
+	// 末尾に詰めて追加する
+	uint32_t nIndex = GetNum();
+	Agent tAgent = {};
+	tAgent.m_nTree = inTree;
+	tAgent.m_pAgent = inAgent;
+	tAgent.m_nRunning = ce_nNoNode;
+	tAgent.m_dLeafTime = m_dTime;
+	tAgent.m_bReevaluate = true;
+	m_AgentVec.push_back(tAgent);
+	m_BlackboardVec.push_back(Blackboard{});
+	m_SlotOfVec.push_back(nSlot);
+
+	uint32_t nGeneration = m_SlotVec[nSlot] & ~ce_nSlotMask;
+	m_SlotVec[nSlot] = nGeneration | nIndex;
+
+	// 次の更新で根から実行する
+	Enqueue(nIndex);
+	return nGeneration | nSlot;
+}
+
+/****************************************//*
+	@brief　	| 歩行者を外す
+	@param　	| inHandle：歩行者の番号
+	@return		| true:外した false:既に無い
+*//****************************************/
+bool CBehaviorSystem::Remove(BehaviorHandle inHandle)
+{
+	uint32_t nIndex = GetIndex(inHandle);
+	if (nIndex == UINT32_MAX) return false;
+
+	// 更新中は進めている歩行者の並びの番号がずれないよう、印を付けて更新の最後に詰める
+	if (m_bUpdating)
+	{
+		m_AgentVec[nIndex].m_bRemoved = true;
+		m_bHasRemoved = true;
+		return true;
+	}
+	RemoveAt(nIndex);
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 全ての歩行者を外す
+*//****************************************/
+void CBehaviorSystem::Clear()
+{
+	if (m_bUpdating)
+	{
+		for (Agent& tAgent : m_AgentVec) tAgent.m_bRemoved = true;
+		m_bHasRemoved = !m_AgentVec.empty();
+		return;
+	}
+
+	while (GetNum() > 0) RemoveAt(GetNum() - 1);
+	m_ReadyVec.clear();
+	m_nReadyHead = 0;
+	m_NextFrameVec.clear();
+	m_TimerQueue = {};
+}
+
+/****************************************//*
+	@brief　	| 歩行者がいるか
+	@param　	| inHandle：歩行者の番号
+	@return		| true:いる false:外された
+*//****************************************/
+bool CBehaviorSystem::IsAlive(BehaviorHandle inHandle) const
+{
+	return GetIndex(inHandle) != UINT32_MAX;
+}
+
+/****************************************//*
+	@brief　	| 黒板に整数を書く
+	@param　	| inHandle：歩行者の番号
+	@param　	| inKey：黒板のキー
+	@param　	| inValue：値
+*//****************************************/
+void CBehaviorSystem::SetInt(BehaviorHandle inHandle, uint32_t inKey, int32_t inValue)
+{
+	SetValue(inHandle, inKey, static_cast<uint32_t>(inValue));
+}
+
+/****************************************//*
+	@brief　	| 黒板に小数を書く
+	@param　	| inHandle：歩行者の番号
+	@param　	| inKey：黒板のキー
+	@param　	| inValue：値
+*//****************************************/
+void CBehaviorSystem::SetFloat(BehaviorHandle inHandle, uint32_t inKey, float inValue)
+{
+	SetValue(inHandle, inKey, BehaviorFloatToValue(inValue));
+}
+
+/****************************************//*
+	@brief　	| 黒板の整数の取得
+	@param　	| inHandle：歩行者の番号
+	@param　	| inKey：黒板のキー
+	@return		| 値(歩行者がいなければ0)
+*//****************************************/
+int32_t CBehaviorSystem::GetInt(BehaviorHandle inHandle, uint32_t inKey) const
+{
+	uint32_t nIndex = GetIndex(inHandle);
+	if (nIndex == UINT32_MAX || inKey >= BehaviorTree::ce_nMaxKey) return 0;
+
+	return static_cast<int32_t>(m_BlackboardVec[nIndex].m_nValue[inKey]);
+}
+
+/****************************************//*
+	@brief　	| 黒板の小数の取得
+	@param　	| inHandle：歩行者の番号
+	@param　	| inKey：黒板のキー
+	@return		| 値(歩行者がいなければ0)
+*//****************************************/
+float CBehaviorSystem::GetFloat(BehaviorHandle inHandle, uint32_t inKey) const
+{
+	uint32_t nIndex = GetIndex(inHandle);
+	if (nIndex == UINT32_MAX || inKey >= BehaviorTree::ce_nMaxKey) return 0.0f;
+
+	return BehaviorValueToFloat(m_BlackboardVec[nIndex].m_nValue[inKey]);
+}
+
+/****************************************//*
+	@brief　	| 実行中の行動を次の更新で呼ぶ(待っている時間は取り消す)
+	@param　	| inHandle：歩行者の番号
+*//****************************************/
+void CBehaviorSystem::Wake(BehaviorHandle inHandle)
+{
+	uint32_t nIndex = GetIndex(inHandle);
+	if (nIndex == UINT32_MAX || m_AgentVec[nIndex].m_nRunning == ce_nNoNode) return;
+
+	Agent& tAgent = m_AgentVec[nIndex];
+	tAgent.m_nSleepId++;
+	tAgent.m_bResume = true;
+	Enqueue(nIndex);
+}
+
+/****************************************//*
+	@brief　	| 更新
+	@param　	| inDeltaTime：経過時間(秒)
+*//****************************************/
+void CBehaviorSystem::Update(float inDeltaTime)
+{
+	auto tStart = std::chrono::high_resolution_clock::now();
+	m_nFrame++;
+	m_dTime += inDeltaTime;
+	m_bUpdating = true;
+	m_tStats = {};
+
+	// 前の更新で次のフレームを求めた歩行者は、前の更新で使い切れずに残った歩行者の後ろに積む
+	for (BehaviorHandle nHandle : m_NextFrameVec) m_ReadyVec.push_back(nHandle);
+	m_NextFrameVec.clear();
+
+	// 時間が来た歩行者を起こす(取り消した待ちは読み捨てる)
+	while (!m_TimerQueue.empty() && m_TimerQueue.top().m_dTime <= m_dTime)
+	{
+		Timer tTimer = m_TimerQueue.top();
+		m_TimerQueue.pop();
+		uint32_t nIndex = GetIndex(tTimer.m_nHandle);
+		if (nIndex == UINT32_MAX || m_AgentVec[nIndex].m_nSleepId != tTimer.m_nSleepId) continue;
+
+		m_AgentVec[nIndex].m_bResume = true;
+		m_tStats.m_nWakeNum++;
+		Enqueue(nIndex);
+	}
+
+	// 比較用に、全ての歩行者を根から評価し直す
+	if (m_bFullTick)
+	{
+		for (uint32_t i = 0; i < GetNum(); i++)
+		{
+			m_AgentVec[i].m_bReevaluate = true;
+			Enqueue(i);
+		}
+	}
+
+	// 待ち行列の先頭から進め、使える時間を超えたら残りは次の更新に回す
+	int nTickNum = 0;
+	while (m_nReadyHead < m_ReadyVec.size())
+	{
+		if (m_dBudgetMs > 0.0 && nTickNum > 0 && nTickNum % ce_nBudgetCheck == 0 &&
+			std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count() >= m_dBudgetMs)
+		{
+			break;
+		}
+
+		uint32_t nIndex = GetIndex(m_ReadyVec[m_nReadyHead++]);
+		if (nIndex == UINT32_MAX) continue;
+
+		Agent& tAgent = m_AgentVec[nIndex];
+		tAgent.m_bQueued = false;
+		m_tStats.m_nMaxDelay = (std::max)(m_tStats.m_nMaxDelay, static_cast<int>(m_nFrame - tAgent.m_nQueuedFrame));
+		Tick(nIndex);
+		nTickNum++;
+	}
+	m_tStats.m_nPendingNum = static_cast<int>(m_ReadyVec.size() - m_nReadyHead);
+
+	// 処理済みの分を詰める(毎回詰めると残りが多い時に写すだけで時間を使うため、半分を超えてから)
+	if (m_nReadyHead == m_ReadyVec.size())
+	{
+		m_ReadyVec.clear();
+		m_nReadyHead = 0;
+	}
+	else if (m_nReadyHead * 2 > m_ReadyVec.size())
+	{
+		m_ReadyVec.erase(m_ReadyVec.begin(), m_ReadyVec.begin() + m_nReadyHead);
+		m_nReadyHead = 0;
+	}
+	m_bUpdating = false;
+
+	// 行動の中で外された歩行者を詰める(後ろから詰めると入れ替えで動くのは確かめ終わった歩行者だけになる)
+	if (m_bHasRemoved)
+	{
+		for (uint32_t i = GetNum(); i-- > 0;)
+		{
+			if (m_AgentVec[i].m_bRemoved) RemoveAt(i);
+		}
+		m_bHasRemoved = false;
+	}
+
+	m_tStats.m_nAgentNum = static_cast<int>(GetNum());
+	m_tStats.m_nTickNum = nTickNum;
+	m_tStats.m_nEventNum = m_nEventNum;
+	m_nEventNum = 0;
+	m_tStats.m_dUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+}
+
+/****************************************//*
+	@brief　	| 黒板に値を書く
+	@param　	| inHandle：歩行者の番号
+	@param　	| inKey：黒板のキー
+	@param　	| inValue：値
+*//****************************************/
+void CBehaviorSystem::SetValue(BehaviorHandle inHandle, uint32_t inKey, uint32_t inValue)
+{
+	uint32_t nIndex = GetIndex(inHandle);
+	if (nIndex == UINT32_MAX || inKey >= BehaviorTree::ce_nMaxKey) return;
+
+	uint32_t& nValue = m_BlackboardVec[nIndex].m_nValue[inKey];
+	if (nValue == inValue) return;
+	nValue = inValue;
+
+	// 実行中の葉の判断に関わるキーだけ評価し直す
+	Agent& tAgent = m_AgentVec[nIndex];
+	if ((tAgent.m_nObserveMask & (1u << inKey)) == 0) return;
+	tAgent.m_bReevaluate = true;
+	m_nEventNum++;
+	Enqueue(nIndex);
+}
+
+/****************************************//*
+	@brief　	| 待ち行列に積む(進めている最中なら終わった時に次のフレームへ積む)
+	@param　	| inIndex：並びの番号
+*//****************************************/
+void CBehaviorSystem::Enqueue(uint32_t inIndex)
+{
+	Agent& tAgent = m_AgentVec[inIndex];
+	if (tAgent.m_bQueued || tAgent.m_bTicking) return;
+
+	tAgent.m_bQueued = true;
+	tAgent.m_nQueuedFrame = m_bUpdating ? m_nFrame : m_nFrame + 1;
+	m_ReadyVec.push_back(GetHandle(inIndex));
+}
+
+/****************************************//*
+	@brief　	| 歩行者を進める
+	@param　	| inIndex：並びの番号
+	@note		| 行動の中で歩行者が追加されると配列が動くため、行動を呼んだ後は並びの番号から引き直す
+*//****************************************/
+void CBehaviorSystem::Tick(uint32_t inIndex)
+{
+	Agent& tAgent = m_AgentVec[inIndex];
+	const bool isReevaluate = tAgent.m_bReevaluate;
+	const bool isResume = tAgent.m_bResume;
+	tAgent.m_bTicking = true;
+	tAgent.m_bReevaluate = false;
+	tAgent.m_bResume = false;
+
+	if (tAgent.m_nRunning == ce_nNoNode)
+	{
+		// 実行中の葉が無ければ根から始める(すぐに終わった時は次の更新でやり直す)
+		if (Enter(inIndex, 0) != BehaviorStatus::Running) m_AgentVec[inIndex].m_bReevaluate = true;
+	}
+	else
+	{
+		// 評価し直しで同じ葉が続いた時だけ、その葉を進める
+		const uint32_t nSerial = tAgent.m_nLeafSerial;
+		if (isReevaluate && Reevaluate(inIndex, 0) != BehaviorStatus::Running) m_AgentVec[inIndex].m_bReevaluate = true;
+
+		const Agent& tAfter = m_AgentVec[inIndex];
+		if (isResume && !tAfter.m_bRemoved && tAfter.m_nRunning != ce_nNoNode && tAfter.m_nLeafSerial == nSerial) Resume(inIndex);
+	}
+
+	// 進めている間に値が変わった時と、次の更新を求めた時は次のフレームに積む
+	Agent& tEnd = m_AgentVec[inIndex];
+	tEnd.m_bTicking = false;
+	if (!tEnd.m_bRemoved && (tEnd.m_bReevaluate || tEnd.m_bResume))
+	{
+		tEnd.m_bQueued = true;
+		tEnd.m_nQueuedFrame = m_nFrame + 1;
+		m_NextFrameVec.push_back(GetHandle(inIndex));
+	}
+}
+
+/****************************************//*
+	@brief　	| ノードを始めから実行する
+	@param　	| inIndex：並びの番号
+	@param　	| inNode：ノードの位置
+	@return		| 実行の結果
+*//****************************************/
+BehaviorStatus CBehaviorSystem::Enter(uint32_t inIndex, uint32_t inNode)
+{
+	m_tStats.m_nNodeNum++;
+	const BehaviorNode& tNode = m_TreeVec[m_AgentVec[inIndex].m_nTree].m_NodeVec[inNode];
+	switch (tNode.m_eType)
+	{
+	case BehaviorNodeType::Sequence:
+	case BehaviorNodeType::Selector:
+		return RunChildren(inIndex, inNode, inNode + 1);
+	case BehaviorNodeType::Inverter:
+		return Invert(Enter(inIndex, inNode + 1));
+	case BehaviorNodeType::Condition:
+		return Check(inIndex, inNode);
+	case BehaviorNodeType::Action:
+	{
+		float fSleep = 0.0f;
+		BehaviorStatus eStatus = CallAction(inIndex, inNode, true, fSleep);
+		if (eStatus == BehaviorStatus::Running) StartLeaf(inIndex, inNode, fSleep);
+		return eStatus;
+	}
+	case BehaviorNodeType::Wait:
+	{
+		float fSeconds = BehaviorValueToFloat(tNode.m_nParam);
+		if (fSeconds <= 0.0f) return BehaviorStatus::Success;
+
+		StartLeaf(inIndex, inNode, fSeconds);
+		m_AgentVec[inIndex].m_dWakeTime = m_dTime + fSeconds;
+		return BehaviorStatus::Running;
+	}
+	}
+	return BehaviorStatus::Failure;
+}
+
+/****************************************//*
+	@brief　	| 複合ノードの子を途中から順に実行する
+	@param　	| inIndex：並びの番号
+	@param　	| inParent：複合ノードの位置
+	@param　	| inFirst：最初に実行する子の位置
+	@return		| 複合ノードの結果
+*//****************************************/
+BehaviorStatus CBehaviorSystem::RunChildren(uint32_t inIndex, uint32_t inParent, uint32_t inFirst)
+{
+	const std::vector<BehaviorNode>& tNodeVec = m_TreeVec[m_AgentVec[inIndex].m_nTree].m_NodeVec;
+	const bool isSequence = tNodeVec[inParent].m_eType == BehaviorNodeType::Sequence;
+	for (uint32_t c = inFirst; c < tNodeVec[inParent].m_nEnd; c = tNodeVec[c].m_nEnd)
+	{
+		if (m_AgentVec[inIndex].m_bRemoved) return BehaviorStatus::Failure;
+
+		// 順に実行するノードは成功、成功するまで試すノードは失敗の間だけ次の子へ進む
+		BehaviorStatus eStatus = Enter(inIndex, c);
+		if (eStatus != (isSequence ? BehaviorStatus::Success : BehaviorStatus::Failure)) return eStatus;
+	}
+	return isSequence ? BehaviorStatus::Success : BehaviorStatus::Failure;
+}
+
+/****************************************//*
+	@brief　	| 実行中の葉の祖先を評価し直す
+	@param　	| inIndex：並びの番号
+	@param　	| inNode：祖先のノードの位置
+	@return		| 祖先のノードの結果
+	@note		| 順に実行するノードは先に成功した兄弟の条件だけを確かめ直し(行動は呼び直さない)、
+				| 成功するまで試すノードは優先度の高い兄弟の先頭の条件が通れば、実行中の葉を中断して切り替える
+*//****************************************/
+BehaviorStatus CBehaviorSystem::Reevaluate(uint32_t inIndex, uint32_t inNode)
+{
+	m_tStats.m_nNodeNum++;
+	const std::vector<BehaviorNode>& tNodeVec = m_TreeVec[m_AgentVec[inIndex].m_nTree].m_NodeVec;
+	const uint32_t nLeaf = m_AgentVec[inIndex].m_nRunning;
+	if (inNode == nLeaf) return BehaviorStatus::Running;
+
+	// 実行中の葉を含む子
+	uint32_t nPath = inNode + 1;
+	while (tNodeVec[nPath].m_nEnd <= nLeaf) nPath = tNodeVec[nPath].m_nEnd;
+
+	switch (tNodeVec[inNode].m_eType)
+	{
+	case BehaviorNodeType::Inverter:
+		return Invert(Reevaluate(inIndex, nPath));
+	case BehaviorNodeType::Sequence:
+	{
+		for (uint32_t c = inNode + 1; c < nPath; c = tNodeVec[c].m_nEnd)
+		{
+			if (IsBehaviorGuard(tNodeVec, c) && Check(inIndex, c) == BehaviorStatus::Failure)
+			{
+				AbortRunning(inIndex);
+				return BehaviorStatus::Failure;
+			}
+		}
+		BehaviorStatus eStatus = Reevaluate(inIndex, nPath);
+		if (eStatus != BehaviorStatus::Success) return eStatus;
+		return RunChildren(inIndex, inNode, tNodeVec[nPath].m_nEnd);
+	}
+	case BehaviorNodeType::Selector:
+	{
+		for (uint32_t c = inNode + 1; c < nPath; c = tNodeVec[c].m_nEnd)
+		{
+			if (Probe(inIndex, c) == BehaviorStatus::Failure) continue;
+
+			// 優先度の高い枝が通るため、実行中の葉を中断してから始める(通らなければ続きの兄弟を始めから試す)
+			AbortRunning(inIndex);
+			BehaviorStatus eStatus = Enter(inIndex, c);
+			if (eStatus != BehaviorStatus::Failure) return eStatus;
+			return RunChildren(inIndex, inNode, tNodeVec[c].m_nEnd);
+		}
+		BehaviorStatus eStatus = Reevaluate(inIndex, nPath);
+		if (eStatus != BehaviorStatus::Failure) return eStatus;
+		return RunChildren(inIndex, inNode, tNodeVec[nPath].m_nEnd);
+	}
+	default:
+		return BehaviorStatus::Running;
+	}
+}
+
+/****************************************//*
+	@brief　	| 終わった葉の結果を親へ伝える
+	@param　	| inIndex：並びの番号
+	@param　	| inNode：終わったノードの位置
+	@param　	| inStatus：終わったノードの結果
+	@return		| 根の結果(途中で実行中の葉が始まればRunning)
+*//****************************************/
+BehaviorStatus CBehaviorSystem::Propagate(uint32_t inIndex, uint32_t inNode, BehaviorStatus inStatus)
+{
+	const std::vector<BehaviorNode>& tNodeVec = m_TreeVec[m_AgentVec[inIndex].m_nTree].m_NodeVec;
+	for (uint32_t nNode = inNode; tNodeVec[nNode].m_nParent != BehaviorTree::ce_nNoParent; nNode = tNodeVec[nNode].m_nParent)
+	{
+		m_tStats.m_nNodeNum++;
+		const uint32_t nParent = tNodeVec[nNode].m_nParent;
+		switch (tNodeVec[nParent].m_eType)
+		{
+		case BehaviorNodeType::Inverter:
+			inStatus = Invert(inStatus);
+			break;
+		case BehaviorNodeType::Sequence:
+			if (inStatus == BehaviorStatus::Success) inStatus = RunChildren(inIndex, nParent, tNodeVec[nNode].m_nEnd);
+			break;
+		case BehaviorNodeType::Selector:
+			if (inStatus == BehaviorStatus::Failure) inStatus = RunChildren(inIndex, nParent, tNodeVec[nNode].m_nEnd);
+			break;
+		default:
+			break;
+		}
+		if (inStatus == BehaviorStatus::Running) return inStatus;
+	}
+	return inStatus;
+}
+
+/****************************************//*
+	@brief　	| 実行中の葉を進める
+	@param　	| inIndex：並びの番号
+*//****************************************/
+void CBehaviorSystem::Resume(uint32_t inIndex)
+{
+	const std::vector<BehaviorNode>& tNodeVec = m_TreeVec[m_AgentVec[inIndex].m_nTree].m_NodeVec;
+	const uint32_t nLeaf = m_AgentVec[inIndex].m_nRunning;
+	m_tStats.m_nNodeNum++;
+
+	BehaviorStatus eStatus = BehaviorStatus::Success;
+	if (tNodeVec[nLeaf].m_eType == BehaviorNodeType::Wait)
+	{
+		// Wakeで早く起こされた待機は、元の時間まで待ち直す
+		Agent& tAgent = m_AgentVec[inIndex];
+		if (m_dTime < tAgent.m_dWakeTime)
+		{
+			tAgent.m_nSleepId++;
+			m_TimerQueue.push({ tAgent.m_dWakeTime, GetHandle(inIndex), tAgent.m_nSleepId });
+			return;
+		}
+	}
+	else
+	{
+		float fSleep = 0.0f;
+		eStatus = CallAction(inIndex, nLeaf, false, fSleep);
+		if (m_AgentVec[inIndex].m_bRemoved) return;
+		if (eStatus == BehaviorStatus::Running)
+		{
+			Sleep(inIndex, fSleep);
+			return;
+		}
+	}
+
+	// 葉が終わったので親へ伝える(根まで終われば次の更新でやり直す)
+	Agent& tAgent = m_AgentVec[inIndex];
+	tAgent.m_nRunning = ce_nNoNode;
+	tAgent.m_nObserveMask = 0;
+	tAgent.m_nSleepId++;
+	if (Propagate(inIndex, nLeaf, eStatus) != BehaviorStatus::Running) m_AgentVec[inIndex].m_bReevaluate = true;
+}
+
+/****************************************//*
+	@brief　	| 条件を調べる
+	@param　	| inIndex：並びの番号
+	@param　	| inNode：条件(または条件を反転したもの)の位置
+	@return		| 結果
+*//****************************************/
+BehaviorStatus CBehaviorSystem::Check(uint32_t inIndex, uint32_t inNode)
+{
+	m_tStats.m_nNodeNum++;
+	const BehaviorNode& tNode = m_TreeVec[m_AgentVec[inIndex].m_nTree].m_NodeVec[inNode];
+	if (tNode.m_eType == BehaviorNodeType::Inverter) return Invert(Check(inIndex, inNode + 1));
+
+	const uint32_t nValue = m_BlackboardVec[inIndex].m_nValue[tNode.m_nKey];
+	bool bPass = false;
+	switch (tNode.m_eCompare)
+	{
+	case BehaviorCompare::Less:
+		bPass = BehaviorValueToFloat(nValue) < BehaviorValueToFloat(tNode.m_nParam);
+		break;
+	case BehaviorCompare::Greater:
+		bPass = BehaviorValueToFloat(nValue) > BehaviorValueToFloat(tNode.m_nParam);
+		break;
+	case BehaviorCompare::Equal:
+		bPass = nValue == tNode.m_nParam;
+		break;
+	case BehaviorCompare::NotEqual:
+		bPass = nValue != tNode.m_nParam;
+		break;
+	}
+	return bPass ? BehaviorStatus::Success : BehaviorStatus::Failure;
+}
+
+/****************************************//*
+	@brief　	| 枝の先頭の条件だけを調べる(行動は呼ばない)
+	@param　	| inIndex：並びの番号
+	@param　	| inNode：枝の根の位置
+	@return		| Failure:通らない Success:通る(行動の結果は分からない)
+*//****************************************/
+BehaviorStatus CBehaviorSystem::Probe(uint32_t inIndex, uint32_t inNode)
+{
+	m_tStats.m_nNodeNum++;
+	const std::vector<BehaviorNode>& tNodeVec = m_TreeVec[m_AgentVec[inIndex].m_nTree].m_NodeVec;
+	if (IsBehaviorGuard(tNodeVec, inNode)) return Check(inIndex, inNode);
+
+	switch (tNodeVec[inNode].m_eType)
+	{
+	case BehaviorNodeType::Sequence:
+		// 先頭から続く条件が全て通るか(条件以外に着いたら、そこから先は実行しないと分からない)
+		for (uint32_t c = inNode + 1; c < tNodeVec[inNode].m_nEnd; c = tNodeVec[c].m_nEnd)
+		{
+			if (!IsBehaviorGuard(tNodeVec, c)) break;
+			if (Check(inIndex, c) == BehaviorStatus::Failure) return BehaviorStatus::Failure;
+		}
+		return BehaviorStatus::Success;
+	case BehaviorNodeType::Selector:
+		for (uint32_t c = inNode + 1; c < tNodeVec[inNode].m_nEnd; c = tNodeVec[c].m_nEnd)
+		{
+			if (Probe(inIndex, c) != BehaviorStatus::Failure) return BehaviorStatus::Success;
+		}
+		return BehaviorStatus::Failure;
+	default:
+		return BehaviorStatus::Success;
+	}
+}
+
+/****************************************//*
+	@brief　	| 行動を呼ぶ
+	@param　	| inIndex：並びの番号
+	@param　	| inNode：行動の位置
+	@param　	| inStart：始める時の呼び出しか
+	@param　	| outSleep：実行中の時に次に呼ぶまでの時間
+	@return		| 結果(呼んでいる間に外されたらFailure)
+*//****************************************/
+BehaviorStatus CBehaviorSystem::CallAction(uint32_t inIndex, uint32_t inNode, bool inStart, float& outSleep)
+{
+	Agent& tAgent = m_AgentVec[inIndex];
+	if (tAgent.m_bRemoved) return BehaviorStatus::Failure;
+
+	BehaviorContext tContext;
+	tContext.m_pSystem = this;
+	tContext.m_nHandle = GetHandle(inIndex);
+	tContext.m_nAction = m_TreeVec[tAgent.m_nTree].m_NodeVec[inNode].m_nParam;
+	tContext.m_bStart = inStart;
+	tContext.m_fDeltaTime = inStart ? 0.0f : static_cast<float>(m_dTime - tAgent.m_dLeafTime);
+	tContext.m_fSleep = 0.0f;
+	tAgent.m_dLeafTime = m_dTime;
+	m_tStats.m_nActionNum++;
+
+	BehaviorStatus eStatus = tAgent.m_pAgent->OnBehaviorAction(tContext);
+	outSleep = tContext.m_fSleep;
+	return m_AgentVec[inIndex].m_bRemoved ? BehaviorStatus::Failure : eStatus;
+}
+
+/****************************************//*
+	@brief　	| 葉を実行中にする
+	@param　	| inIndex：並びの番号
+	@param　	| inNode：葉の位置
+	@param　	| inSleep：次に進めるまでの時間(0:次の更新 正:秒数 負:起こされるまで)
+*//****************************************/
+void CBehaviorSystem::StartLeaf(uint32_t inIndex, uint32_t inNode, float inSleep)
+{
+	Agent& tAgent = m_AgentVec[inIndex];
+	tAgent.m_nRunning = inNode;
+	tAgent.m_nObserveMask = m_TreeVec[tAgent.m_nTree].m_NodeVec[inNode].m_nObserveMask;
+	tAgent.m_nLeafSerial++;
+	tAgent.m_dLeafTime = m_dTime;
+	Sleep(inIndex, inSleep);
+}
+
+/****************************************//*
+	@brief　	| 実行中の葉を次に進めるまで待つ
+	@param　	| inIndex：並びの番号
+	@param　	| inSleep：次に進めるまでの時間(0:次の更新 正:秒数 負:起こされるまで)
+*//****************************************/
+void CBehaviorSystem::Sleep(uint32_t inIndex, float inSleep)
+{
+	Agent& tAgent = m_AgentVec[inIndex];
+	tAgent.m_nSleepId++;
+	if (inSleep > 0.0f) m_TimerQueue.push({ m_dTime + inSleep, GetHandle(inIndex), tAgent.m_nSleepId });
+	else if (inSleep == 0.0f) tAgent.m_bResume = true;
+}
+
+/****************************************//*
+	@brief　	| 実行中の葉を中断する
+	@param　	| inIndex：並びの番号
+*//****************************************/
+void CBehaviorSystem::AbortRunning(uint32_t inIndex)
+{
+	Agent& tAgent = m_AgentVec[inIndex];
+	const uint32_t nLeaf = tAgent.m_nRunning;
+	if (nLeaf == ce_nNoNode) return;
+
+	tAgent.m_nRunning = ce_nNoNode;
+	tAgent.m_nObserveMask = 0;
+	tAgent.m_nSleepId++;
+	tAgent.m_bResume = false;
+
+	const BehaviorNode& tNode = m_TreeVec[tAgent.m_nTree].m_NodeVec[nLeaf];
+	if (tNode.m_eType != BehaviorNodeType::Action || tAgent.m_bRemoved) return;
+
+	BehaviorContext tContext;
+	tContext.m_pSystem = this;
+	tContext.m_nHandle = GetHandle(inIndex);
+	tContext.m_nAction = tNode.m_nParam;
+	tContext.m_bStart = false;
+	tContext.m_fDeltaTime = static_cast<float>(m_dTime - tAgent.m_dLeafTime);
+	tContext.m_fSleep = 0.0f;
+	tAgent.m_pAgent->OnBehaviorAbort(tContext);
+}
+
+/****************************************//*
+	@brief　	| 並びの番号から番号を求める
+	@param　	| inIndex：並びの番号
+	@return		| 歩行者の番号
+*//****************************************/
+BehaviorHandle CBehaviorSystem::GetHandle(uint32_t inIndex) const
+{
+	uint32_t nSlot = m_SlotOfVec[inIndex];
+	return (m_SlotVec[nSlot] & ~ce_nSlotMask) | nSlot;
+}
+
+/****************************************//*
+	@brief　	| 番号から並びの番号を求める
+	@param　	| inHandle：歩行者の番号
+	@return		| 並びの番号(いなければUINT32_MAX)
+*//****************************************/
+uint32_t CBehaviorSystem::GetIndex(BehaviorHandle inHandle) const
+{
+	uint32_t nSlot = inHandle & ce_nSlotMask;
+	if (inHandle == ce_nInvalidHandle || nSlot >= m_SlotVec.size()) return UINT32_MAX;
+
+	uint32_t nEntry = m_SlotVec[nSlot];
+	if ((nEntry & ce_nSlotMask) == ce_nFreeIndex || (nEntry & ~ce_nSlotMask) != (inHandle & ~ce_nSlotMask)) return UINT32_MAX;
+
+	// 更新中に外された歩行者は、詰めるまでいないものとして扱う
+	uint32_t nIndex = nEntry & ce_nSlotMask;
+	return m_AgentVec[nIndex].m_bRemoved ? UINT32_MAX : nIndex;
+}
+
+/****************************************//*
+	@brief　	| 並びの番号の歩行者を末尾の歩行者と入れ替えて外す
+	@param　	| inIndex：並びの番号
+	@note		| 待ち行列と起きる時間の待ちに残った番号は、取り出した時に読み捨てる
+*//****************************************/
+void CBehaviorSystem::RemoveAt(uint32_t inIndex)
+{
+	uint32_t nSlot = m_SlotOfVec[inIndex];
+	uint32_t nLast = GetNum() - 1;
+	if (inIndex != nLast)
+	{
+		m_AgentVec[inIndex] = m_AgentVec[nLast];
+		m_BlackboardVec[inIndex] = m_BlackboardVec[nLast];
+
+		uint32_t nMovedSlot = m_SlotOfVec[nLast];
+		m_SlotOfVec[inIndex] = nMovedSlot;
+		m_SlotVec[nMovedSlot] = (m_SlotVec[nMovedSlot] & ~ce_nSlotMask) | inIndex;
+	}
+	m_AgentVec.pop_back();
+	m_BlackboardVec.pop_back();
+	m_SlotOfVec.pop_back();
+
+	// 世代を進めて古い番号を無効にする
+	uint32_t nGeneration = (m_SlotVec[nSlot] & ~ce_nSlotMask) + (1u << ce_nSlotBits);
+	m_SlotVec[nSlot] = nGeneration | ce_nFreeIndex;
+	m_FreeSlotVec.push_back(nSlot);
+}
+
+/****************************************//*
+	@brief　	| 1万人の敵を見張り・追跡・攻撃・巡回の木で動かし、毎フレーム評価し直す場合と比べて計測して書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CBehaviorSystem::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr int ce_nSide = 100;
+	static constexpr uint32_t ce_nAgentNum = ce_nSide * ce_nSide;
+	static constexpr int ce_nFrameNum = 1800;
+	static constexpr int ce_nAlarmFrame = 600;
+	static constexpr float ce_fDeltaTime = 1.0f / 60.0f;
+	static constexpr float ce_fSpacing = 4.0f;
+	static constexpr float ce_fAttackRange = 2.0f;
+	static constexpr float ce_fChaseRange = 12.0f;
+	static constexpr double ce_dBudgetMs = 0.5;
+	char szLine[256];
+	bool bSuccess = true;
+
+	// 警報が鳴れば警戒し、近ければ攻撃、見える距離なら追跡し、それ以外は巡回する敵の木
+	CBehaviorTreeBuilder tBuilder("Enemy");
+	const uint32_t nAlarm = tBuilder.AddKey("alarm");
+	const uint32_t nRange = tBuilder.AddKey("range");
+	tBuilder.BeginSelector();
+	{
+		tBuilder.BeginSequence();
+		tBuilder.ConditionInt(nAlarm, BehaviorCompare::NotEqual, 0);
+		tBuilder.Action(BenchAlert);
+		tBuilder.End();
+
+		tBuilder.BeginSequence();
+		tBuilder.ConditionInt(nRange, BehaviorCompare::Equal, 0);
+		tBuilder.Action(BenchAttack);
+		tBuilder.End();
+
+		tBuilder.BeginSequence();
+		tBuilder.ConditionInt(nRange, BehaviorCompare::Equal, 1);
+		tBuilder.Action(BenchChase);
+		tBuilder.End();
+
+		tBuilder.BeginSequence();
+		tBuilder.Action(BenchPickPatrol);
+		tBuilder.Action(BenchMoveTo);
+		tBuilder.Wait(1.5f);
+		tBuilder.End();
+	}
+	tBuilder.End();
+
+	BehaviorTree tTree;
+	std::string sError;
+	if (!tBuilder.Build(tTree, sError))
+	{
+		tReport << "build failed: " << sError << "\n";
+		return 1;
+	}
+
+	// 敵は格子に並べ、相手は場の中をリサージュ曲線で歩き回る
+	std::mt19937 tRandom(20261019);
+	std::uniform_real_distribution<float> tJitter(-1.0f, 1.0f);
+	std::vector<float> tHomeVec;
+	for (int z = 0; z < ce_nSide; z++)
+	{
+		for (int x = 0; x < ce_nSide; x++)
+		{
+			tHomeVec.push_back((x - ce_nSide * 0.5f) * ce_fSpacing + tJitter(tRandom));
+			tHomeVec.push_back((z - ce_nSide * 0.5f) * ce_fSpacing + tJitter(tRandom));
+		}
+	}
+
+	// 毎フレーム根から評価し直す場合、値が変わった時だけ評価し直す場合、それに使う時間の上限を付けた場合を比べる
+	std::vector<uint32_t> tResultVec[2];
+	long long nNodeTotal[2] = {};
+	double dUnlimitedPeakMs = 0.0;
+	for (int nMode = 0; nMode < 3; nMode++)
+	{
+		const bool isFullTick = nMode == 0;
+		const bool isBudget = nMode == 2;
+
+		CBehaviorSystem tSystem;
+		tSystem.SetFullTick(isFullTick);
+		tSystem.SetBudget(isBudget ? ce_dBudgetMs : 0.0);
+		BehaviorTreeId nTree = tSystem.AddTree(BehaviorTree(tTree));
+		tSystem.Init(ce_nAgentNum);
+
+		float fTarget[2] = { 0.0f, 0.0f };
+		std::vector<CBenchEnemy> tEnemyVec(ce_nAgentNum);
+		std::vector<BehaviorHandle> tHandleVec(ce_nAgentNum);
+		for (uint32_t i = 0; i < ce_nAgentNum; i++)
+		{
+			CBenchEnemy& tEnemy = tEnemyVec[i];
+			tEnemy.m_fHomeX = tEnemy.m_fPosX = tEnemy.m_fToX = tHomeVec[i * 2];
+			tEnemy.m_fHomeZ = tEnemy.m_fPosZ = tEnemy.m_fToZ = tHomeVec[i * 2 + 1];
+			tEnemy.m_dMoveStart = 0.0;
+			tEnemy.m_fMoveTime = 0.0f;
+			tEnemy.m_nPatrol = i;
+			std::fill(tEnemy.m_nStartNum, tEnemy.m_nStartNum + BenchActionNum, 0u);
+			tEnemy.m_pTarget = fTarget;
+			tEnemy.m_nAlarmKey = nAlarm;
+			tHandleVec[i] = tSystem.Add(nTree, &tEnemy);
+		}
+
+		long long nTickNum = 0, nNodeNum = 0, nActionNum = 0, nEventNum = 0, nWakeNum = 0;
+		int nMaxPending = 0, nMaxDelay = 0, nOverFrame = 0;
+		double dUpdateMs = 0.0, dMaxUpdateMs = 0.0, dAlarmMs = 0.0;
+		for (int nFrame = 0; nFrame < ce_nFrameNum; nFrame++)
+		{
+			// ゲーム側の知覚：相手との距離を3段階にして黒板に書く(段階が変わった敵だけが評価し直す)
+			const double dTime = tSystem.GetTime();
+			fTarget[0] = 150.0f * sinf(static_cast<float>(dTime) * 0.06f);
+			fTarget[1] = 150.0f * sinf(static_cast<float>(dTime) * 0.045f + 1.0f);
+			for (uint32_t i = 0; i < ce_nAgentNum; i++)
+			{
+				float fX, fZ;
+				tEnemyVec[i].GetPos(dTime, fX, fZ);
+				float fDx = fX - fTarget[0], fDz = fZ - fTarget[1];
+				float fDistanceSq = fDx * fDx + fDz * fDz;
+				int nBand = fDistanceSq < ce_fAttackRange * ce_fAttackRange ? 0 : fDistanceSq < ce_fChaseRange * ce_fChaseRange ? 1 : 2;
+				tSystem.SetInt(tHandleVec[i], nRange, nBand);
+			}
+
+			// 全員に一度に警報を鳴らし、評価し直しが1フレームに集まる場合を作る
+			if (nFrame == ce_nAlarmFrame)
+			{
+				for (uint32_t i = 0; i < ce_nAgentNum; i++) tSystem.SetInt(tHandleVec[i], nAlarm, 1);
+			}
+
+			tSystem.Update(ce_fDeltaTime);
+			const BehaviorStats& tStats = tSystem.GetStats();
+			dUpdateMs += tStats.m_dUpdateMs;
+			dMaxUpdateMs = (std::max)(dMaxUpdateMs, tStats.m_dUpdateMs);
+			if (nFrame >= ce_nAlarmFrame && nFrame < ce_nAlarmFrame + 3) dAlarmMs = (std::max)(dAlarmMs, tStats.m_dUpdateMs);
+			if (tStats.m_dUpdateMs > ce_dBudgetMs * 1.5) nOverFrame++;
+			nTickNum += tStats.m_nTickNum;
+			nNodeNum += tStats.m_nNodeNum;
+			nActionNum += tStats.m_nActionNum;
+			nEventNum += tStats.m_nEventNum;
+			nWakeNum += tStats.m_nWakeNum;
+			nMaxPending = (std::max)(nMaxPending, tStats.m_nPendingNum);
+			nMaxDelay = (std::max)(nMaxDelay, tStats.m_nMaxDelay);
+		}
+
+		// 行動毎に始めた回数と最後の位置(追加順)
+		std::vector<uint32_t> tResult;
+		uint32_t nStartNum[BenchActionNum] = {};
+		for (const CBenchEnemy& tEnemy : tEnemyVec)
+		{
+			for (uint32_t a = 0; a < BenchActionNum; a++)
+			{
+				nStartNum[a] += tEnemy.m_nStartNum[a];
+				tResult.push_back(tEnemy.m_nStartNum[a]);
+			}
+			tResult.push_back(BehaviorFloatToValue(tEnemy.m_fPosX));
+			tResult.push_back(BehaviorFloatToValue(tEnemy.m_fPosZ));
+		}
+		if (!isBudget)
+		{
+			tResultVec[nMode] = std::move(tResult);
+			nNodeTotal[nMode] = nNodeNum;
+			if (!isFullTick) dUnlimitedPeakMs = dMaxUpdateMs;
+		}
+
+		sprintf_s(szLine, "%-5s budget %-6s agent %u  frame %d  ai %.3f ms/frame (max %.3f, alarm %.3f)  %.1f%% of 60Hz\n",
+			isFullTick ? "full" : "event", isBudget ? "0.5ms" : "none", ce_nAgentNum, ce_nFrameNum, dUpdateMs / ce_nFrameNum, dMaxUpdateMs, dAlarmMs,
+			100.0 * dUpdateMs / ce_nFrameNum / (1000.0 * ce_fDeltaTime));
+		tReport << szLine;
+		sprintf_s(szLine, "             tick %.1f  node %.1f  action %.1f  event %.1f  wake %.1f per frame  pending max %d  delay max %d frames  over 1.5x budget %d frames\n",
+			static_cast<double>(nTickNum) / ce_nFrameNum, static_cast<double>(nNodeNum) / ce_nFrameNum, static_cast<double>(nActionNum) / ce_nFrameNum,
+			static_cast<double>(nEventNum) / ce_nFrameNum, static_cast<double>(nWakeNum) / ce_nFrameNum, nMaxPending, nMaxDelay, nOverFrame);
+		tReport << szLine;
+		sprintf_s(szLine, "             started alert %u  attack %u  chase %u  patrol %u  move %u\n",
+			nStartNum[BenchAlert], nStartNum[BenchAttack], nStartNum[BenchChase], nStartNum[BenchPickPatrol], nStartNum[BenchMoveTo]);
+		tReport << szLine;
+
+		// 全員が警報に1回だけ反応し、追跡と攻撃も起きていること
+		bSuccess &= nStartNum[BenchAlert] == ce_nAgentNum && nStartNum[BenchChase] > 0 && nStartNum[BenchAttack] > 0;
+
+		// 上限を付けた場合は警報の集中を複数のフレームに分け、上限を大きく超えるフレームがほぼ無いこと
+		if (isBudget) bSuccess &= nMaxPending > 0 && dMaxUpdateMs < dUnlimitedPeakMs && nOverFrame * 100 <= ce_nFrameNum;
+	}
+
+	// 見張っているキーが変わらない限り評価し直しても同じ葉が続くため、毎フレーム評価し直す場合と同じ行動と位置になる
+	bool bSame = tResultVec[0] == tResultVec[1];
+	bool bFewer = nNodeTotal[1] * 5 < nNodeTotal[0];
+	sprintf_s(szLine, "event-driven matches full re-evaluation %s  nodes visited %.1f%% of full %s\n", bSame ? "ok" : "FAILED",
+		100.0 * nNodeTotal[1] / (std::max)(nNodeTotal[0], 1LL), bFewer ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess &= bSame && bFewer;
+
+	// 組み立て：閉じ忘れと子の数の誤りを見つけ、葉毎に見張るキーが求まっていること
+	{
+		CBehaviorTreeBuilder tOpen("Open");
+		tOpen.BeginSequence();
+		tOpen.Action(0);
+		CBehaviorTreeBuilder tInvert("Invert");
+		tInvert.BeginInverter();
+		tInvert.Action(0);
+		tInvert.Action(1);
+		tInvert.End();
+		BehaviorTree tBad;
+		std::string sOpen, sInvert;
+		bool bError = !tOpen.Build(tBad, sOpen) && !tInvert.Build(tBad, sInvert);
+		const uint32_t nBoth = (1u << nAlarm) | (1u << nRange);
+		bool bMask = true;
+		for (const BehaviorNode& tNode : tTree.m_NodeVec)
+		{
+			if (tNode.m_eType == BehaviorNodeType::Action && tNode.m_nParam == BenchAlert) bMask &= tNode.m_nObserveMask == (1u << nAlarm);
+			else if (tNode.m_eType == BehaviorNodeType::Action || tNode.m_eType == BehaviorNodeType::Wait) bMask &= tNode.m_nObserveMask == nBoth;
+		}
+		sprintf_s(szLine, "builder check (unclosed: \"%s\", inverter: \"%s\", observe masks) %s\n", sOpen.c_str(), sInvert.c_str(), bError && bMask ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bError && bMask;
+	}
+
+	// 追加と削除：古い番号が無効になり、入れ替えで動いた歩行者の番号と黒板が生きていることを確かめる
+	{
+		CBehaviorSystem tSystem;
+		BehaviorTreeId nTree = tSystem.AddTree(BehaviorTree(tTree));
+		CBenchEnemy tEnemy[3] = {};
+		float fTarget[2] = { 1000.0f, 1000.0f };
+		for (CBenchEnemy& t : tEnemy)
+		{
+			t.m_pTarget = fTarget;
+			t.m_nAlarmKey = nAlarm;
+		}
+		BehaviorHandle nA = tSystem.Add(nTree, &tEnemy[0]);
+		BehaviorHandle nB = tSystem.Add(nTree, &tEnemy[1]);
+		tSystem.SetInt(nB, nRange, 2);
+		bool bRemove = tSystem.Remove(nA) && !tSystem.IsAlive(nA) && !tSystem.Remove(nA) && tSystem.IsAlive(nB);
+		BehaviorHandle nC = tSystem.Add(nTree, &tEnemy[2]);
+		tSystem.Update(ce_fDeltaTime);
+		bool bReuse = nC != nA && !tSystem.IsAlive(nA) && tSystem.GetInt(nB, nRange) == 2 && tSystem.GetNum() == 2 &&
+			tEnemy[0].m_nStartNum[BenchPickPatrol] == 0 && tEnemy[1].m_nStartNum[BenchPickPatrol] == 1;
+		sprintf_s(szLine, "handle check (stale handle, swap on remove, slot reuse)  %s\n", bRemove && bReuse ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bRemove && bReuse;
+	}
+
+	return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,448 @@
+/**************************************************//*
+	@file	| BehaviorSystem.h
+	@brief	| ビヘイビアツリーの実行クラスのhファイル
+	@note	| 歩行者毎に実行中の葉だけを覚えておき、毎フレーム木を根からたどり直さない
+			| 葉は時間が来た時、行動が次のフレームを求めた時、見張っている黒板の値が変わった時だけ進める
+			| 値が変わった時は根から評価し直し、優先度の高い枝の条件が通れば実行中の葉を中断して切り替える
+			| (条件で始まらない優先度の高い枝は、木を根からやり直した時にだけ試し直す)
+			| 進める歩行者は待ち行列に積み、1回の更新で使う時間を超えた分は次のフレームに回す
+			| シングルトンパターンで作成
+*//**************************************************/
+#pragma once
+#include "Singleton.h"
+#include "BehaviorTree.h"
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+// @brief ビヘイビアツリーの番号
+using BehaviorTreeId = uint32_t;
+
+// @brief 歩行者の番号(下位20bit:枠 上位12bit:世代)
+using BehaviorHandle = uint32_t;
+
+// @brief 前方宣言
+class CBehaviorSystem;
+
+// @brief 行動を呼ぶ時の情報
+struct BehaviorContext
+{
+	// 呼び出し元
+	CBehaviorSystem* m_pSystem;
+
+	// 歩行者の番号
+	BehaviorHandle m_nHandle;
+
+	// 行動の番号
+	uint32_t m_nAction;
+
+	// 行動を始めた最初の呼び出しか
+	bool m_bStart;
+
+	// 前にこの行動を呼んでからの経過時間(秒、最初の呼び出しは0)
+	float m_fDeltaTime;
+
+	// 実行中を返す時に、次に呼ぶまでの時間(0:次の更新 正:秒数 負:Wakeで起こすまで)
+	float m_fSleep;
+};
+
+// @brief ビヘイビアツリーで動くもののインターフェース
+class IBehaviorAgent
+{
+public:
+	// @brief デストラクタ
+	virtual ~IBehaviorAgent() {}
+
+	// @brief 行動を実行する
+	// @param ioContext：呼ぶ時の情報(実行中を返す時は次に呼ぶまでの時間を書く)
+	// @return 実行の結果
+	virtual BehaviorStatus OnBehaviorAction(BehaviorContext& ioContext) = 0;
+
+	// @brief 実行中の行動を中断する
+	// @param inContext：呼ぶ時の情報
+	virtual void OnBehaviorAbort(const BehaviorContext& inContext) { (void)inContext; }
+};
+
+// @brief ビヘイビアツリーの実行の統計情報(直前の更新1回分)
+struct BehaviorStats
+{
+	// 歩行者の数
+	int m_nAgentNum;
+
+	// 進めた歩行者の数
+	int m_nTickNum;
+
+	// たどったノードの数
+	int m_nNodeNum;
+
+	// 行動を呼んだ数
+	int m_nActionNum;
+
+	// 見張っている黒板の値が変わった数
+	int m_nEventNum;
+
+	// 時間が来て起きた数
+	int m_nWakeNum;
+
+	// 使える時間を超えて次のフレームに回した歩行者の数
+	int m_nPendingNum;
+
+	// 進めた歩行者が待ち行列で待ったフレーム数の最大
+	int m_nMaxDelay;
+
+	// 更新にかかった時間(ミリ秒)
+	double m_dUpdateMs;
+};
+
+// @brief ビヘイビアツリーの実行クラス
+class CBehaviorSystem : public ISingleton<CBehaviorSystem>
+{
+public:
+	// @brief 無効な番号
+	static constexpr BehaviorHandle ce_nInvalidHandle = UINT32_MAX;
+
+	// @brief 無効な木の番号
+	static constexpr BehaviorTreeId ce_nInvalidTree = UINT32_MAX;
+
+	// @brief 同時に動かせる歩行者の上限(番号の枠の部分で表せる数)
+	static constexpr uint32_t ce_nMaxCapacity = 1u << 20;
+
+	// @brief 1回の更新で使う時間の初期値(ミリ秒)
+	static constexpr double ce_dDefaultBudgetMs = 1.0;
+
+private:
+	// @brief コンストラクタ
+	CBehaviorSystem();
+
+	friend class ISingleton<CBehaviorSystem>;
+public:
+	// @brief デストラクタ
+	~CBehaviorSystem();
+
+	// @brief 組み立て済みの木を登録する
+	// @param inTree：組み立て済みの木
+	// @return 木の番号
+	// @note 更新中には登録しない
+	BehaviorTreeId AddTree(BehaviorTree&& inTree);
+
+	// @brief 名前から木を探す
+	// @param inName：名前
+	// @return 木の番号(無ければce_nInvalidTree)
+	BehaviorTreeId FindTree(const std::string& inName) const;
+
+	// @brief 木の取得
+	// @param inTree：木の番号
+	const BehaviorTree& GetTree(BehaviorTreeId inTree) const { return m_TreeVec[inTree]; }
+
+	// @brief 歩行者の配列を確保する
+	// @param inCapacity：最初に確保する歩行者の数(超えた分は追加時に広げる)
+	// @note 動いている歩行者は全て外される
+	void Init(uint32_t inCapacity);
+
+	// @brief 歩行者を追加する
+	// @param inTree：木の番号
+	// @param inAgent：行動を実行する先(外すまで破棄しない)
+	// @return 歩行者の番号(上限に達しているか木が無ければce_nInvalidHandle)
+	// @note 黒板は0で始まり、次の更新で根から実行する
+	BehaviorHandle Add(BehaviorTreeId inTree, IBehaviorAgent* inAgent);
+
+	// @brief 歩行者を外す
+	// @param inHandle：歩行者の番号
+	// @return true:外した false:既に無い
+	// @note 実行中の行動は中断しない、更新中(行動の中)に外した場合は更新の最後に詰める
+	bool Remove(BehaviorHandle inHandle);
+
+	// @brief 全ての歩行者を外す
+	void Clear();
+
+	// @brief 歩行者がいるか
+	// @param inHandle：歩行者の番号
+	bool IsAlive(BehaviorHandle inHandle) const;
+
+	// @brief 黒板に整数を書く
+	// @param inHandle：歩行者の番号
+	// @param inKey：黒板のキー
+	// @param inValue：値
+	// @note 値が変わり、実行中の葉が見張っているキーなら評価し直す
+	void SetInt(BehaviorHandle inHandle, uint32_t inKey, int32_t inValue);
+
+	// @brief 黒板に小数を書く
+	// @param inHandle：歩行者の番号
+	// @param inKey：黒板のキー
+	// @param inValue：値
+	// @note 値が変わり、実行中の葉が見張っているキーなら評価し直す
+	void SetFloat(BehaviorHandle inHandle, uint32_t inKey, float inValue);
+
+	// @brief 黒板の整数の取得
+	// @param inHandle：歩行者の番号
+	// @param inKey：黒板のキー
+	// @return 値(歩行者がいなければ0)
+	int32_t GetInt(BehaviorHandle inHandle, uint32_t inKey) const;
+
+	// @brief 黒板の小数の取得
+	// @param inHandle：歩行者の番号
+	// @param inKey：黒板のキー
+	// @return 値(歩行者がいなければ0)
+	float GetFloat(BehaviorHandle inHandle, uint32_t inKey) const;
+
+	// @brief 実行中の行動を次の更新で呼ぶ(待っている時間は取り消す)
+	// @param inHandle：歩行者の番号
+	void Wake(BehaviorHandle inHandle);
+
+	// @brief 1回の更新で使う時間の設定
+	// @param inMs：ミリ秒(0以下なら待ち行列を全て進める)
+	void SetBudget(double inMs) { m_dBudgetMs = inMs; }
+
+	// @brief 1回の更新で使う時間の取得
+	double GetBudget() const { return m_dBudgetMs; }
+
+	// @brief 毎フレーム全ての歩行者を根から評価し直すかの設定(比較用)
+	// @param inFullTick：true:毎フレーム評価し直す false:見張っている値が変わった時だけ
+	void SetFullTick(bool inFullTick) { m_bFullTick = inFullTick; }
+
+	// @brief 毎フレーム全ての歩行者を根から評価し直すか
+	bool IsFullTick() const { return m_bFullTick; }
+
+	// @brief 更新
+	// @param inDeltaTime：経過時間(秒)
+	// @note 前の更新で残った歩行者と更新の外で値が変わった歩行者、次の更新を求めた歩行者、時間が来た歩行者の順に進める
+	void Update(float inDeltaTime);
+
+	// @brief 更新を始めてからの時間の取得(秒)
+	double GetTime() const { return m_dTime; }
+
+	// @brief 歩行者の数の取得
+	uint32_t GetNum() const { return static_cast<uint32_t>(m_AgentVec.size()); }
+
+	// @brief 統計情報の取得
+	// @return 直前の更新の統計情報
+	const BehaviorStats& GetStats() const { return m_tStats; }
+
+	// @brief 1万人の敵を見張り・追跡・攻撃・巡回の木で動かし、毎フレーム評価し直す場合と比べて計測して書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief 歩行者1人分の情報
+	struct Agent
+	{
+		// 木の番号
+		BehaviorTreeId m_nTree;
+
+		// 行動を実行する先
+		IBehaviorAgent* m_pAgent;
+
+		// 実行中の葉の位置(無ければce_nNoNode)
+		uint32_t m_nRunning;
+
+		// 実行中の葉が見張っている黒板のキー
+		uint32_t m_nObserveMask;
+
+		// 葉を始める度に進める番号(評価し直しで同じ葉が続いたかを見分ける)
+		uint32_t m_nLeafSerial;
+
+		// 待つ度に進める番号(取り消した待ちを見分ける)
+		uint32_t m_nSleepId;
+
+		// 待ち行列に積んだフレーム
+		uint32_t m_nQueuedFrame;
+
+		// 葉を前に進めた時間
+		double m_dLeafTime;
+
+		// 待機が終わる時間
+		double m_dWakeTime;
+
+		// 待ち行列に積んであるか
+		bool m_bQueued;
+
+		// 進めている最中か
+		bool m_bTicking;
+
+		// 根から評価し直すか
+		bool m_bReevaluate;
+
+		// 実行中の葉を進めるか
+		bool m_bResume;
+
+		// 更新中に外されたか
+		bool m_bRemoved;
+	};
+
+	// @brief 歩行者1人分の黒板(キャッシュラインに揃える)
+	struct alignas(64) Blackboard
+	{
+		// 値
+		uint32_t m_nValue[BehaviorTree::ce_nMaxKey];
+	};
+
+	// @brief 起きる時間
+	struct Timer
+	{
+		// 時間
+		double m_dTime;
+
+		// 歩行者の番号
+		BehaviorHandle m_nHandle;
+
+		// 待った時の番号
+		uint32_t m_nSleepId;
+
+		// @brief 早い順に取り出す(同じ時間は番号順)
+		bool operator>(const Timer& inOther) const
+		{
+			return m_dTime != inOther.m_dTime ? m_dTime > inOther.m_dTime : m_nHandle > inOther.m_nHandle;
+		}
+	};
+
+	// @brief 黒板に値を書く
+	// @param inHandle：歩行者の番号
+	// @param inKey：黒板のキー
+	// @param inValue：値
+	void SetValue(BehaviorHandle inHandle, uint32_t inKey, uint32_t inValue);
+
+	// @brief 待ち行列に積む(進めている最中なら終わった時に次のフレームへ積む)
+	// @param inIndex：並びの番号
+	void Enqueue(uint32_t inIndex);
+
+	// @brief 歩行者を進める
+	// @param inIndex：並びの番号
+	void Tick(uint32_t inIndex);
+
+	// @brief ノードを始めから実行する
+	// @param inIndex：並びの番号
+	// @param inNode：ノードの位置
+	// @return 実行の結果
+	BehaviorStatus Enter(uint32_t inIndex, uint32_t inNode);
+
+	// @brief 複合ノードの子を途中から順に実行する
+	// @param inIndex：並びの番号
+	// @param inParent：複合ノードの位置
+	// @param inFirst：最初に実行する子の位置
+	// @return 複合ノードの結果
+	BehaviorStatus RunChildren(uint32_t inIndex, uint32_t inParent, uint32_t inFirst);
+
+	// @brief 実行中の葉の祖先を評価し直す
+	// @param inIndex：並びの番号
+	// @param inNode：祖先のノードの位置
+	// @return 祖先のノードの結果
+	BehaviorStatus Reevaluate(uint32_t inIndex, uint32_t inNode);
+
+	// @brief 終わった葉の結果を親へ伝える
+	// @param inIndex：並びの番号
+	// @param inNode：終わったノードの位置
+	// @param inStatus：終わったノードの結果
+	// @return 根の結果(途中で実行中の葉が始まればRunning)
+	BehaviorStatus Propagate(uint32_t inIndex, uint32_t inNode, BehaviorStatus inStatus);
+
+	// @brief 実行中の葉を進める
+	// @param inIndex：並びの番号
+	void Resume(uint32_t inIndex);
+
+	// @brief 条件を調べる
+	// @param inIndex：並びの番号
+	// @param inNode：条件(または条件を反転したもの)の位置
+	// @return 結果
+	BehaviorStatus Check(uint32_t inIndex, uint32_t inNode);
+
+	// @brief 枝の先頭の条件だけを調べる(行動は呼ばない)
+	// @param inIndex：並びの番号
+	// @param inNode：枝の根の位置
+	// @return Failure:通らない Success:通る(行動の結果は分からない)
+	BehaviorStatus Probe(uint32_t inIndex, uint32_t inNode);
+
+	// @brief 行動を呼ぶ
+	// @param inIndex：並びの番号
+	// @param inNode：行動の位置
+	// @param inStart：始める時の呼び出しか
+	// @param outSleep：実行中の時に次に呼ぶまでの時間
+	// @return 結果(呼んでいる間に外されたらFailure)
+	BehaviorStatus CallAction(uint32_t inIndex, uint32_t inNode, bool inStart, float& outSleep);
+
+	// @brief 葉を実行中にする
+	// @param inIndex：並びの番号
+	// @param inNode：葉の位置
+	// @param inSleep：次に進めるまでの時間(0:次の更新 正:秒数 負:起こされるまで)
+	void StartLeaf(uint32_t inIndex, uint32_t inNode, float inSleep);
+
+	// @brief 実行中の葉を次に進めるまで待つ
+	// @param inIndex：並びの番号
+	// @param inSleep：次に進めるまでの時間(0:次の更新 正:秒数 負:起こされるまで)
+	void Sleep(uint32_t inIndex, float inSleep);
+
+	// @brief 実行中の葉を中断する
+	// @param inIndex：並びの番号
+	void AbortRunning(uint32_t inIndex);
+
+	// @brief 並びの番号から番号を求める
+	// @param inIndex：並びの番号
+	// @return 歩行者の番号
+	BehaviorHandle GetHandle(uint32_t inIndex) const;
+
+	// @brief 番号から並びの番号を求める
+	// @param inHandle：歩行者の番号
+	// @return 並びの番号(いなければUINT32_MAX)
+	uint32_t GetIndex(BehaviorHandle inHandle) const;
+
+	// @brief 並びの番号の歩行者を末尾の歩行者と入れ替えて外す
+	// @param inIndex：並びの番号
+	void RemoveAt(uint32_t inIndex);
+
+private:
+	// @brief 登録した木
+	std::vector<BehaviorTree> m_TreeVec;
+
+	// @brief 歩行者
+	std::vector<Agent> m_AgentVec;
+
+	// @brief 黒板(歩行者と同じ並び)
+	std::vector<Blackboard> m_BlackboardVec;
+
+	// @brief 並びの番号から枠の番号
+	std::vector<uint32_t> m_SlotOfVec;
+
+	// @brief 枠の番号から並びの番号(下位20bit)と世代(上位12bit)
+	std::vector<uint32_t> m_SlotVec;
+
+	// @brief 空いている枠の番号
+	std::vector<uint32_t> m_FreeSlotVec;
+
+	// @brief 進める歩行者の待ち行列(m_nReadyHeadより前は処理済み)
+	std::vector<BehaviorHandle> m_ReadyVec;
+
+	// @brief 待ち行列の先頭の位置
+	size_t m_nReadyHead;
+
+	// @brief 次の更新で進める歩行者
+	std::vector<BehaviorHandle> m_NextFrameVec;
+
+	// @brief 起きる時間の早い順の待ち
+	std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> m_TimerQueue;
+
+	// @brief 1回の更新で使う時間(ミリ秒)
+	double m_dBudgetMs;
+
+	// @brief 毎フレーム全ての歩行者を根から評価し直すか
+	bool m_bFullTick;
+
+	// @brief 更新中か
+	bool m_bUpdating;
+
+	// @brief 更新中に外された歩行者がいるか
+	bool m_bHasRemoved;
+
+	// @brief 更新を始めてからの時間(秒)
+	double m_dTime;
+
+	// @brief 更新した回数
+	uint32_t m_nFrame;
+
+	// @brief 前の更新が終わってから見張っている黒板の値が変わった数
+	int m_nEventNum;
+
+	// @brief 直前の更新の統計情報
+	BehaviorStats m_tStats;
+};
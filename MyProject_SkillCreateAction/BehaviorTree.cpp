@@ -0,0 +1,300 @@
+/**************************************************//*
+	@file	| BehaviorTree.cpp
+	@brief	| ビヘイビアツリーの定義と組み立てクラスのcppファイル
+	@note	| ノードは木を行きがけ順に並べた配列で持ち、子は親の直後から続き、
+			| 部分木の終わりの位置で次の兄弟へ飛ぶ(ノード毎にメモリを確保しない)
+			| 黒板は歩行者毎に32bitの値を決まった数だけ持ち、条件はその値と比べる
+			| 葉のノード毎に、実行中に値が変わったら評価し直す黒板のキーを組み立て時に求めておく
+*//**************************************************/
+#include "BehaviorTree.h"
+#include <cstring>
+#include <string>
+
+namespace
+{
+	// @brief 部分木の中の条件が読む黒板のキーを集める
+	// @param inNodeVec：ノード
+	// @param inNode：部分木の根の位置
+	// @return キー(ビット毎)
+	uint32_t CollectKeys(const std::vector<BehaviorNode>& inNodeVec, uint32_t inNode)
+	{
+		uint32_t nMask = 0;
+		for (uint32_t i = inNode; i < inNodeVec[inNode].m_nEnd; i++)
+		{
+			if (inNodeVec[i].m_eType == BehaviorNodeType::Condition) nMask |= 1u << inNodeVec[i].m_nKey;
+		}
+		return nMask;
+	}
+}
+
+/****************************************//*
+	@brief　	| キーの名前から番号を探す
+	@param　	| inName：キーの名前
+	@return		| キーの番号(無ければUINT32_MAX)
+*//****************************************/
+uint32_t BehaviorTree::FindKey(const std::string& inName) const
+{
+	for (uint32_t i = 0; i < m_KeyVec.size(); i++)
+	{
+		if (m_KeyVec[i] == inName) return i;
+	}
+	return UINT32_MAX;
+}
+
+/****************************************//*
+	@brief　	| 評価し直す時に結果を確かめ直す条件か(条件と、条件を反転したもの)
+	@param　	| inNodeVec：ノード
+	@param　	| inNode：ノードの位置
+	@return		| true:条件 false:行動などを含む
+*//****************************************/
+bool IsBehaviorGuard(const std::vector<BehaviorNode>& inNodeVec, uint32_t inNode)
+{
+	while (inNodeVec[inNode].m_eType == BehaviorNodeType::Inverter) inNode++;
+	return inNodeVec[inNode].m_eType == BehaviorNodeType::Condition;
+}
+
+/****************************************//*
+	@brief　	| 小数を黒板の値に直す
+	@param　	| inValue：小数
+	@return		| 黒板の値
+*//****************************************/
+uint32_t BehaviorFloatToValue(float inValue)
+{
+	uint32_t nValue;
+	std::memcpy(&nValue, &inValue, sizeof(nValue));
+	return nValue;
+}
+
+/****************************************//*
+	@brief　	| 黒板の値を小数に直す
+	@param　	| inValue：黒板の値
+	@return		| 小数
+*//****************************************/
+float BehaviorValueToFloat(uint32_t inValue)
+{
+	float fValue;
+	std::memcpy(&fValue, &inValue, sizeof(fValue));
+	return fValue;
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+	@param　	| inName：木の名前
+*//****************************************/
+CBehaviorTreeBuilder::CBehaviorTreeBuilder(const std::string& inName)
+{
+	m_tTree.m_sName = inName;
+}
+
+/****************************************//*
+	@brief　	| 黒板のキーを追加する
+	@param　	| inName：キーの名前
+	@return		| キーの番号(同じ名前が既にあればその番号)
+*//****************************************/
+uint32_t CBehaviorTreeBuilder::AddKey(const std::string& inName)
+{
+	uint32_t nKey = m_tTree.FindKey(inName);
+	if (nKey != UINT32_MAX) return nKey;
+
+	if (m_tTree.m_KeyVec.size() >= BehaviorTree::ce_nMaxKey)
+	{
+		if (m_sError.empty()) m_sError = "too many keys: " + inName;
+		return 0;
+	}
+	m_tTree.m_KeyVec.push_back(inName);
+	return static_cast<uint32_t>(m_tTree.m_KeyVec.size() - 1);
+}
+
+/****************************************//*
+	@brief　	| 順に実行するノードを開く
+*//****************************************/
+void CBehaviorTreeBuilder::BeginSequence()
+{
+	AddNode(BehaviorNodeType::Sequence, BehaviorCompare::Equal, 0, 0);
+	m_OpenVec.push_back(static_cast<uint32_t>(m_tTree.m_NodeVec.size() - 1));
+}
+
+/****************************************//*
+	@brief　	| 成功するまで順に試すノードを開く
+*//****************************************/
+void CBehaviorTreeBuilder::BeginSelector()
+{
+	AddNode(BehaviorNodeType::Selector, BehaviorCompare::Equal, 0, 0);
+	m_OpenVec.push_back(static_cast<uint32_t>(m_tTree.m_NodeVec.size() - 1));
+}
+
+/****************************************//*
+	@brief　	| 結果を反転するノードを開く(子は1つ)
+*//****************************************/
+void CBehaviorTreeBuilder::BeginInverter()
+{
+	AddNode(BehaviorNodeType::Inverter, BehaviorCompare::Equal, 0, 0);
+	m_OpenVec.push_back(static_cast<uint32_t>(m_tTree.m_NodeVec.size() - 1));
+}
+
+/****************************************//*
+	@brief　	| 開いたノードを閉じる
+*//****************************************/
+void CBehaviorTreeBuilder::End()
+{
+	if (m_OpenVec.empty())
+	{
+		if (m_sError.empty()) m_sError = "End without Begin";
+		return;
+	}
+
+	// 閉じた時点の末尾が部分木の終わりになる
+	uint32_t nOpen = m_OpenVec.back();
+	m_OpenVec.pop_back();
+	m_tTree.m_NodeVec[nOpen].m_nEnd = static_cast<uint16_t>(m_tTree.m_NodeVec.size());
+}
+
+/****************************************//*
+	@brief　	| 黒板の値(小数)と比べる条件を追加する
+	@param　	| inKey：黒板のキー
+	@param　	| inCompare：比べ方
+	@param　	| inValue：比べる値
+*//****************************************/
+void CBehaviorTreeBuilder::ConditionFloat(uint32_t inKey, BehaviorCompare inCompare, float inValue)
+{
+	AddNode(BehaviorNodeType::Condition, inCompare, inKey, BehaviorFloatToValue(inValue));
+}
+
+/****************************************//*
+	@brief　	| 黒板の値(整数)と比べる条件を追加する
+	@param　	| inKey：黒板のキー
+	@param　	| inCompare：比べ方(Equal/NotEqualのみ)
+	@param　	| inValue：比べる値
+*//****************************************/
+void CBehaviorTreeBuilder::ConditionInt(uint32_t inKey, BehaviorCompare inCompare, int32_t inValue)
+{
+	if (inCompare != BehaviorCompare::Equal && inCompare != BehaviorCompare::NotEqual && m_sError.empty())
+	{
+		m_sError = "int condition must be Equal or NotEqual";
+	}
+	AddNode(BehaviorNodeType::Condition, inCompare, inKey, static_cast<uint32_t>(inValue));
+}
+
+/****************************************//*
+	@brief　	| 行動を追加する
+	@param　	| inAction：行動の番号(ゲーム側で決める)
+*//****************************************/
+void CBehaviorTreeBuilder::Action(uint32_t inAction)
+{
+	AddNode(BehaviorNodeType::Action, BehaviorCompare::Equal, 0, inAction);
+}
+
+/****************************************//*
+	@brief　	| 待機を追加する
+	@param　	| inSeconds：待つ時間(秒)
+*//****************************************/
+void CBehaviorTreeBuilder::Wait(float inSeconds)
+{
+	AddNode(BehaviorNodeType::Wait, BehaviorCompare::Equal, 0, BehaviorFloatToValue(inSeconds));
+}
+
+/****************************************//*
+	@brief　	| 組み立てる
+	@param　	| outTree：組み立て済みの木
+	@param　	| outError：失敗した理由
+	@return		| true:成功 false:失敗
+*//****************************************/
+bool CBehaviorTreeBuilder::Build(BehaviorTree& outTree, std::string& outError) const
+{
+	if (!m_sError.empty())
+	{
+		outError = m_sError;
+		return false;
+	}
+	if (!m_OpenVec.empty())
+	{
+		outError = "Begin without End";
+		return false;
+	}
+	const std::vector<BehaviorNode>& tNodeVec = m_tTree.m_NodeVec;
+	if (tNodeVec.empty() || tNodeVec[0].m_nEnd != tNodeVec.size())
+	{
+		outError = "tree must have exactly one root";
+		return false;
+	}
+
+	// 複合ノードは子を1つ以上、反転は子を1つだけ持つ
+	for (uint32_t i = 0; i < tNodeVec.size(); i++)
+	{
+		const BehaviorNode& tNode = tNodeVec[i];
+		uint32_t nChildNum = 0;
+		for (uint32_t c = i + 1; c < tNode.m_nEnd; c = tNodeVec[c].m_nEnd) nChildNum++;
+		if ((tNode.m_eType == BehaviorNodeType::Sequence || tNode.m_eType == BehaviorNodeType::Selector) && nChildNum == 0)
+		{
+			outError = "composite without children at node " + std::to_string(i);
+			return false;
+		}
+		if (tNode.m_eType == BehaviorNodeType::Inverter && nChildNum != 1)
+		{
+			outError = "inverter must have one child at node " + std::to_string(i);
+			return false;
+		}
+		if (tNode.m_eType == BehaviorNodeType::Condition && tNode.m_nKey >= m_tTree.m_KeyVec.size())
+		{
+			outError = "unknown key at node " + std::to_string(i);
+			return false;
+		}
+	}
+
+	// 実行中になれる葉(行動と待機)毎に、評価し直す時に読む条件のキーを求める
+	// 祖先の順に実行するノードでは先に成功した兄弟の条件だけを確かめ直し、
+	// 祖先の成功するまで試すノードでは優先度の高い兄弟の部分木を全て試し直す
+	outTree = m_tTree;
+	std::vector<BehaviorNode>& tOutVec = outTree.m_NodeVec;
+	for (uint32_t i = 0; i < tOutVec.size(); i++)
+	{
+		BehaviorNode& tLeaf = tOutVec[i];
+		if (tLeaf.m_eType != BehaviorNodeType::Action && tLeaf.m_eType != BehaviorNodeType::Wait) continue;
+
+		uint32_t nMask = 0;
+		for (uint32_t nNode = i; tOutVec[nNode].m_nParent != BehaviorTree::ce_nNoParent; nNode = tOutVec[nNode].m_nParent)
+		{
+			const uint32_t nParent = tOutVec[nNode].m_nParent;
+			const BehaviorNodeType eType = tOutVec[nParent].m_eType;
+			for (uint32_t c = nParent + 1; c < nNode; c = tOutVec[c].m_nEnd)
+			{
+				if (eType == BehaviorNodeType::Selector) nMask |= CollectKeys(tOutVec, c);
+				else if (eType == BehaviorNodeType::Sequence && IsBehaviorGuard(tOutVec, c)) nMask |= CollectKeys(tOutVec, c);
+			}
+		}
+		tLeaf.m_nObserveMask = nMask;
+	}
+	return true;
+}
+
+/****************************************//*
+	@brief　	| ノードを追加する
+	@param　	| inType：種類
+	@param　	| inCompare：比べ方
+	@param　	| inKey：黒板のキー
+	@param　	| inParam：値
+*//****************************************/
+void CBehaviorTreeBuilder::AddNode(BehaviorNodeType inType, BehaviorCompare inCompare, uint32_t inKey, uint32_t inParam)
+{
+	std::vector<BehaviorNode>& tNodeVec = m_tTree.m_NodeVec;
+	if (tNodeVec.size() >= BehaviorTree::ce_nMaxNode)
+	{
+		if (m_sError.empty()) m_sError = "too many nodes";
+		return;
+	}
+
+	// 根を閉じた後に並べたノードは根が2つになるため、組み立て時に誤りにする
+	uint32_t nIndex = static_cast<uint32_t>(tNodeVec.size());
+	if (m_OpenVec.empty() && nIndex > 0 && m_sError.empty()) m_sError = "tree must have exactly one root";
+	if (inType == BehaviorNodeType::Condition && inKey >= BehaviorTree::ce_nMaxKey && m_sError.empty()) m_sError = "unknown key at node " + std::to_string(nIndex);
+
+	BehaviorNode tNode = {};
+	tNode.m_eType = inType;
+	tNode.m_eCompare = inCompare;
+	tNode.m_nKey = static_cast<uint8_t>(inKey);
+	tNode.m_nParent = m_OpenVec.empty() ? BehaviorTree::ce_nNoParent : static_cast<uint16_t>(m_OpenVec.back());
+	tNode.m_nEnd = static_cast<uint16_t>(nIndex + 1);
+	tNode.m_nParam = inParam;
+	tNode.m_nObserveMask = 0;
+	tNodeVec.push_back(tNode);
+}
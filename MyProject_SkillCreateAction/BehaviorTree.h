@@ -0,0 +1,202 @@
+/**************************************************//*
+	@file	| BehaviorTree.h
+	@brief	| ビヘイビアツリーの定義と組み立てクラスのhファイル
+	@note	| ノードは木を行きがけ順に並べた配列で持ち、子は親の直後から続き、
+			| 部分木の終わりの位置で次の兄弟へ飛ぶ(ノード毎にメモリを確保しない)
+			| 黒板は歩行者毎に32bitの値を決まった数だけ持ち、条件はその値と比べる
+			| 葉のノード毎に、実行中に値が変わったら評価し直す黒板のキーを組み立て時に求めておく
+*//**************************************************/
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// @brief ノードの種類
+enum class BehaviorNodeType : uint8_t
+{
+	// 子を順に実行し、1つでも失敗したら失敗
+	Sequence,
+
+	// 子を順に実行し、1つでも成功したら成功
+	Selector,
+
+	// 1つの子の成功と失敗を入れ替える
+	Inverter,
+
+	// 黒板の値と比べる
+	Condition,
+
+	// ゲーム側の行動を実行する
+	Action,
+
+	// 決まった時間待って成功する
+	Wait,
+};
+
+// @brief 条件の比べ方
+enum class BehaviorCompare : uint8_t
+{
+	// 黒板の値(小数)が値より小さい
+	Less,
+
+	// 黒板の値(小数)が値より大きい
+	Greater,
+
+	// 黒板の値と値のビットが等しい(整数・フラグに使う)
+	Equal,
+
+	// 黒板の値と値のビットが異なる(整数・フラグに使う)
+	NotEqual,
+};
+
+// @brief 実行の結果
+enum class BehaviorStatus : uint8_t
+{
+	// 成功
+	Success,
+
+	// 失敗
+	Failure,
+
+	// 実行中(次の更新以降に続ける)
+	Running,
+};
+
+// @brief ノード
+struct BehaviorNode
+{
+	// 種類
+	BehaviorNodeType m_eType;
+
+	// 比べ方(条件のみ)
+	BehaviorCompare m_eCompare;
+
+	// 黒板のキー(条件のみ)
+	uint8_t m_nKey;
+
+	// 親の位置(根はUINT16_MAX)
+	uint16_t m_nParent;
+
+	// 部分木の終わりの位置(次の兄弟の位置)
+	uint16_t m_nEnd;
+
+	// 値(条件:比べる値のビット 行動:行動の番号 待機:秒数のビット)
+	uint32_t m_nParam;
+
+	// 葉が実行中の間に値が変わったら評価し直す黒板のキー(ビット毎)
+	uint32_t m_nObserveMask;
+};
+
+// @brief 組み立て済みのビヘイビアツリー
+struct BehaviorTree
+{
+	// 黒板のキーの上限(歩行者毎の黒板の大きさ)
+	static constexpr uint32_t ce_nMaxKey = 16;
+
+	// ノードの上限(位置を16bitで持つ)
+	static constexpr uint32_t ce_nMaxNode = UINT16_MAX;
+
+	// 親の無いノード(根)の親の位置
+	static constexpr uint16_t ce_nNoParent = UINT16_MAX;
+
+	// 名前
+	std::string m_sName;
+
+	// ノード(行きがけ順、先頭が根)
+	std::vector<BehaviorNode> m_NodeVec;
+
+	// 黒板のキーの名前
+	std::vector<std::string> m_KeyVec;
+
+	// @brief キーの名前から番号を探す
+	// @param inName：キーの名前
+	// @return キーの番号(無ければUINT32_MAX)
+	uint32_t FindKey(const std::string& inName) const;
+};
+
+// @brief 評価し直す時に結果を確かめ直す条件か(条件と、条件を反転したもの)
+// @param inNodeVec：ノード
+// @param inNode：ノードの位置
+bool IsBehaviorGuard(const std::vector<BehaviorNode>& inNodeVec, uint32_t inNode);
+
+// @brief 小数を黒板の値に直す
+// @param inValue：小数
+// @return 黒板の値
+uint32_t BehaviorFloatToValue(float inValue);
+
+// @brief 黒板の値を小数に直す
+// @param inValue：黒板の値
+// @return 小数
+float BehaviorValueToFloat(uint32_t inValue);
+
+// @brief ビヘイビアツリーの組み立てクラス
+// @note Begin～Endで複合ノードと反転を開き、その間に子を並べる
+class CBehaviorTreeBuilder
+{
+public:
+	// @brief コンストラクタ
+	// @param inName：木の名前
+	CBehaviorTreeBuilder(const std::string& inName);
+
+	// @brief 黒板のキーを追加する
+	// @param inName：キーの名前
+	// @return キーの番号(同じ名前が既にあればその番号)
+	uint32_t AddKey(const std::string& inName);
+
+	// @brief 順に実行するノードを開く
+	void BeginSequence();
+
+	// @brief 成功するまで順に試すノードを開く
+	void BeginSelector();
+
+	// @brief 結果を反転するノードを開く(子は1つ)
+	void BeginInverter();
+
+	// @brief 開いたノードを閉じる
+	void End();
+
+	// @brief 黒板の値(小数)と比べる条件を追加する
+	// @param inKey：黒板のキー
+	// @param inCompare：比べ方
+	// @param inValue：比べる値
+	void ConditionFloat(uint32_t inKey, BehaviorCompare inCompare, float inValue);
+
+	// @brief 黒板の値(整数)と比べる条件を追加する
+	// @param inKey：黒板のキー
+	// @param inCompare：比べ方(Equal/NotEqualのみ)
+	// @param inValue：比べる値
+	void ConditionInt(uint32_t inKey, BehaviorCompare inCompare, int32_t inValue);
+
+	// @brief 行動を追加する
+	// @param inAction：行動の番号(ゲーム側で決める)
+	void Action(uint32_t inAction);
+
+	// @brief 待機を追加する
+	// @param inSeconds：待つ時間(秒)
+	void Wait(float inSeconds);
+
+	// @brief 組み立てる
+	// @param outTree：組み立て済みの木
+	// @param outError：失敗した理由
+	// @return true:成功 false:失敗
+	// @note 部分木の終わりの位置と、葉毎に評価し直す黒板のキーを求める
+	bool Build(BehaviorTree& outTree, std::string& outError) const;
+
+private:
+	// @brief ノードを追加する
+	// @param inType：種類
+	// @param inCompare：比べ方
+	// @param inKey：黒板のキー
+	// @param inParam：値
+	void AddNode(BehaviorNodeType inType, BehaviorCompare inCompare, uint32_t inKey, uint32_t inParam);
+
+private:
+	// @brief 組み立て中の木
+	BehaviorTree m_tTree;
+
+	// @brief 開いているノードの位置
+	std::vector<uint32_t> m_OpenVec;
+
+	// @brief 組み立て中に見つかった誤り(最初の1つ)
+	std::string m_sError;
+};
@@ -4,7 +4,7 @@
 	@note	| CRendererComponentを継承
 *//**************************************************/
 #include "BillboardRenderer.h"
-#include "Sprite.h"
+#include "SpriteBatch.h"
 #include "DirectX.h"
 
 /*****************************************//*
@@ -21,22 +21,9 @@ CBillboardRenderer::~CBillboardRenderer()
 void CBillboardRenderer::Draw()
 {
 	// キーが設定されていない時は描画しない
-	if (m_sKey.empty()) return;
+	const RendererObject* pObject = GetRendererObject();
+	if (!pObject) return;
 
-	// 深度バッファを無効にする 
-	RenderTarget* pRTV = GetDefaultRTV();
-	DepthStencil* pDSV = GetDefaultDSV();
-	SetRenderTargets(1, &pRTV, pDSV);
-
-	// カリングのセット
-	SetCullingMode(m_tParam.m_eCulling);
-
-	// 描画用パラメータのセット
-	Sprite::SetParam(m_tParam, SpriteKind::Billboard);
-
-	// テクスチャのセット
-	Sprite::SetTexture(std::get<Texture*>(m_RendererObjectMap.find(m_sKey.c_str())->second.m_Data));
-
-	// 描画
-	Sprite::Draw();
+	// まとめ描画に追加(深度バッファを使う)
+	SpriteBatch::Add(GetDrawParam(*pObject), SpriteKind::Billboard, std::get<Texture*>(pObject->m_Data), true);
 }
@@ -0,0 +1,28 @@
+/**************************************************//*
+	@file	| CollisionAabb.cpp
+	@brief	| AABB当たり判定クラス
+*//**************************************************/
+#include "CollisionAabb.h"
+#include "GameObject.h"
+#include "Geometory.h"
+
+// @brief 位置と向きを反映した形状を作る
+CollisionVolume CCollisionAabb::MakeVolume()
+{
+	const float fCenter[3] = { m_f3Center.x, m_f3Center.y, m_f3Center.z };
+	const float fHalfSize[3] = { m_f3HalfSize.x, m_f3HalfSize.y, m_f3HalfSize.z };
+	return CCollisionDispatch::MakeAabb(fCenter, fHalfSize);
+}
+
+// @brief 描画処理
+void CCollisionAabb::Draw()
+{
+	// コリジョンが有効でない時は描画を行わない
+	if (!m_bActive) return;
+
+	// 1辺が1の立方体を当たり判定の大きさ・位置に変換して線を積む
+	DirectX::XMMATRIX world =
+		DirectX::XMMatrixScaling(m_f3HalfSize.x * 2.0f, m_f3HalfSize.y * 2.0f, m_f3HalfSize.z * 2.0f) *
+		DirectX::XMMatrixTranslation(m_f3Center.x, m_f3Center.y, m_f3Center.z);
+	Geometory::AddBox(world, DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f));
+}
@@ -0,0 +1,47 @@
+/**************************************************//*
+	@file	| CollisionAabb.h
+	@brief	| AABB当たり判定クラス
+	@note	| ゲームオブジェクトの回転は反映しない
+*//**************************************************/
+#pragma once
+#include "CollisionBase.h"
+#include <DirectXMath.h>
+#include "Oparation.h"
+
+// @brief AABB当たり判定クラス
+class CCollisionAabb : public CCollisionBase
+{
+public:
+	// コンストラクタの継承
+	using CCollisionBase::CCollisionBase;
+
+	// @brief 描画処理
+	void Draw() override;
+
+	// @brief 位置と向きを反映した形状を作る
+	CollisionVolume MakeVolume() override;
+
+	// @brief コリジョンの中心座標を取得
+	// @return (DirectX::XMFLOAT3)コリジョンの中心座標
+	DirectX::XMFLOAT3 GetCenter() { return m_f3Center; }
+
+	// @brief コリジョンの中心座標をセット
+	// @param center：コリジョンの中心座標
+	void SetCenter(const DirectX::XMFLOAT3& center) { m_f3Center = center; }
+
+	// @brief コリジョンのサイズを取得
+	// @return (DirectX::XMFLOAT3)コリジョンのサイズ
+	DirectX::XMFLOAT3 GetSize() { return m_f3HalfSize * 2.0f; }
+
+	// @brief コリジョンのサイズをセット
+	// @param inSize：コリジョンのサイズ
+	void SetSize(const DirectX::XMFLOAT3& inSize) { m_f3HalfSize = inSize / 2.0f; }
+
+private:
+	// @brief 中心座標
+	DirectX::XMFLOAT3 m_f3Center = { 0.0f, 0.0f, 0.0f };
+
+	// @brief ハーフサイズ
+	DirectX::XMFLOAT3 m_f3HalfSize = { 0.5f, 0.5f, 0.5f };
+
+};
@@ -4,6 +4,17 @@
 *//**************************************************/
 #include "CollisionBase.h"
 
+/*****************************************//*
+	@brief　	| 引数付きコンストラクタ
+	@param　	| inPtr：紐付けるゲームオブジェクトのポインタ
+*//*****************************************/
+CCollisionBase::CCollisionBase(CGameObject* inPtr)
+	: CComponent(inPtr)
+{
+	// 形状を作るまでは判定を行わない形状にしておく
+	m_tVolume.m_eShape = CollisionShape::Max;
+}
+
 /*****************************************//*
 	@brief　	| デストラクタ
 *//*****************************************/
@@ -16,8 +27,34 @@ CCollisionBase::~CCollisionBase()
 	@brief　	| 衝突が起きたかどうかを取得
 	@param　	| other：衝突先
 	@return		| true:衝突 false:非衝突
+	@note		| 保持している形状を書き換えると、掃引に使う前回の位置が変わるので一時的な形状で調べる
 *//*****************************************/
 bool CCollisionBase::IsHit(CCollisionBase* other)
 {
-    return false;
+    return CCollisionDispatch::Test(MakeVolume(), other->MakeVolume());
+}
+
+/*****************************************//*
+	@brief　	| 位置と向きを反映した形状を作る
+	@return		| 形状
+*//*****************************************/
+CollisionVolume CCollisionBase::MakeVolume()
+{
+    CollisionVolume tVolume{};
+    tVolume.m_eShape = CollisionShape::Max;
+    return tVolume;
+}
+
+/*****************************************//*
+	@brief　	| 形状を作り直し、前回作り直してからの移動量を求める
+*//*****************************************/
+void CCollisionBase::SyncVolume()
+{
+    const bool bPrev = m_tVolume.m_eShape != CollisionShape::Max;
+    const float fPrev[3] = { m_tVolume.m_fCenter[0], m_tVolume.m_fCenter[1], m_tVolume.m_fCenter[2] };
+    m_tVolume = MakeVolume();
+    for (int k = 0; k < 3; k++)
+    {
+        m_fMove[k] = (bPrev && m_tVolume.m_eShape != CollisionShape::Max) ? m_tVolume.m_fCenter[k] - fPrev[k] : 0.0f;
+    }
 }
@@ -3,14 +3,50 @@
 	@brief	| 当たり判定基底クラス
 *//**************************************************/
 #pragma once
+#include <cstdint>
 #include "Component.h" 
+#include "CollisionDispatch.h"
+
+// @brief 当たり判定のレイヤー(マスクのビットの位置)
+enum class CollisionLayer : uint32_t
+{
+	// 指定なし
+	Default,
+
+	// プレイヤー
+	Player,
+
+	// 敵
+	Enemy,
+
+	// 壁・床などの地形
+	Wall,
+
+	// 弾
+	Projectile,
+
+	// 拾える物
+	Item,
+
+	// レイヤーの数
+	Max,
+};
+
+// @brief 全てのレイヤーのマスク
+constexpr uint32_t ce_nAllCollisionLayer = UINT32_MAX;
+
+// @brief レイヤーのビットの取得
+// @param inLayer：レイヤー
+// @return マスクでのビット
+constexpr uint32_t CollisionLayerBit(CollisionLayer inLayer) { return 1u << static_cast<uint32_t>(inLayer); }
 
 // @brief 当たり判定基底クラス
 class CCollisionBase : public CComponent
 {
 public:
-	// コンストラクタの継承
-    using CComponent::CComponent;
+	// @brief 引数付きコンストラクタ
+	// @param inPtr：紐付けるゲームオブジェクトのポインタ
+	CCollisionBase(CGameObject* inPtr);
 
 	// @brief デストラクタ
     virtual ~CCollisionBase();
@@ -18,9 +54,91 @@ public:
 	// @brief 衝突が起きたかどうかを取得
 	// @param other：衝突先
 	// @return true:衝突 false:非衝突
+	// @note 今の位置と向きで一時的に作った形状同士を調べる(空間検索に反映した形状と移動量は変えない)
     virtual bool IsHit(CCollisionBase* other);
 
+	// @brief 位置と向きを反映した形状を作る
+	// @return 形状
+	// @note 派生クラスで形状を作る(基底クラスは判定を行わない形状にする)
+	virtual CollisionVolume MakeVolume();
+
+	// @brief 形状を作り直し、前回作り直してからの移動量を求める
+	// @note 保持する形状を書き換えるのはここだけ(シーンが空間検索に反映する時に呼ぶ)
+	void SyncVolume();
+
+	// @brief 移動量を0にする
+	// @note 瞬間移動させた時や空間検索に登録し直す時に呼び、移動を掃引しないようにする
+	void ResetMove() { m_fMove[0] = m_fMove[1] = m_fMove[2] = 0.0f; }
+
+	// @brief 前回形状を作り直してからの移動量の取得
+	// @return 移動量(XYZ)
+	const float* GetMove() const { return m_fMove; }
+
+	// @brief 高速に動く当たり判定かどうかを設定
+	// @param isFast：true:前回の位置から掃引して判定する(薄い当たり判定のすり抜けを防ぐ) false:今の位置だけで判定する
+	void SetFast(bool isFast) { m_bFast = isFast; }
+
+	// @brief 高速に動く当たり判定かどうかを取得
+	// @return true:掃引して判定する false:今の位置だけで判定する
+	bool IsFast() const { return m_bFast; }
+
+	// @brief 直前に作り直した形状の取得
+	// @return 位置と向きを反映した形状
+	const CollisionVolume& GetVolume() const { return m_tVolume; }
+
+	// @brief 動かない当たり判定かどうかを設定
+	// @param isStatic：true:動かない(ナビゲーショングリッドに障害物として焼き込む) false:動く
+	void SetStatic(bool isStatic) { m_bStatic = isStatic; }
+
+	// @brief 動かない当たり判定かどうかを取得
+	// @return true:動かない false:動く
+	bool IsStatic() const { return m_bStatic; }
+
+	// @brief レイヤーを設定
+	// @param inLayer：レイヤー
+	void SetLayer(CollisionLayer inLayer) { m_eLayer = inLayer; }
+
+	// @brief レイヤーを取得
+	// @return レイヤー
+	CollisionLayer GetLayer() const { return m_eLayer; }
+
+	// @brief 衝突する相手のレイヤーのマスクを設定
+	// @param inMask：CollisionLayerBitを組み合わせたビット
+	// @note 互いのレイヤーがもう一方のマスクに含まれる組だけを判定する
+	void SetMask(uint32_t inMask) { m_nMask = inMask; }
+
+	// @brief 衝突する相手のレイヤーのマスクを取得
+	// @return CollisionLayerBitを組み合わせたビット
+	uint32_t GetMask() const { return m_nMask; }
+
+	// @brief シーンの空間検索に登録した番号を設定
+	// @param inIndex：登録時の番号(登録していなければCSpatialQuery::ce_nInvalid)
+	void SetQueryIndex(uint32_t inIndex) { m_nQueryIndex = inIndex; }
+
+	// @brief シーンの空間検索に登録した番号を取得
+	// @return 登録時の番号(登録していなければCSpatialQuery::ce_nInvalid)
+	uint32_t GetQueryIndex() const { return m_nQueryIndex; }
+
 protected:
+	// @brief 動かない当たり判定かどうか
+	bool m_bStatic = false;
+
+	// @brief レイヤー
+	CollisionLayer m_eLayer = CollisionLayer::Default;
+
+	// @brief 衝突する相手のレイヤーのマスク
+	uint32_t m_nMask = ce_nAllCollisionLayer;
+
+	// @brief シーンの空間検索に登録した番号
+	uint32_t m_nQueryIndex = UINT32_MAX;
+
+	// @brief 位置と向きを反映した形状
+	CollisionVolume m_tVolume{};
+
+	// @brief 前回形状を作り直してからの移動量
+	float m_fMove[3] = { 0.0f, 0.0f, 0.0f };
 
+	// @brief 高速に動く当たり判定かどうか
+	bool m_bFast = false;
 
 };
@@ -0,0 +1,32 @@
+/**************************************************//*
+	@file	| CollisionCapsule.cpp
+	@brief	| カプセル当たり判定クラス
+*//**************************************************/
+#include "CollisionCapsule.h"
+#include "GameObject.h"
+#include "Geometory.h"
+
+// @brief 位置と向きを反映した形状を作る
+CollisionVolume CCollisionCapsule::MakeVolume()
+{
+	const DirectX::XMFLOAT3 f3Rotate = this->GetGameObject()->GetRotate();
+	const float fCenter[3] = { m_f3Center.x, m_f3Center.y, m_f3Center.z };
+	const float fRotate[3] = { f3Rotate.x, f3Rotate.y, f3Rotate.z };
+	return CCollisionDispatch::MakeCapsule(fCenter, m_fRadius, m_fHalfHeight, fRotate);
+}
+
+// @brief 描画処理
+void CCollisionCapsule::Draw()
+{
+	// コリジョンが有効でない時は描画を行わない
+	if (!m_bActive) return;
+
+	// 判定と同じ形状から線分の両端を求める(空間検索に反映した形状は変えない)
+	const CollisionVolume tVolume = MakeVolume();
+	const float* pAxis = tVolume.m_fAxis[1];
+	const DirectX::XMFLOAT3 f3Start(
+		m_f3Center.x - pAxis[0] * m_fHalfHeight, m_f3Center.y - pAxis[1] * m_fHalfHeight, m_f3Center.z - pAxis[2] * m_fHalfHeight);
+	const DirectX::XMFLOAT3 f3End(
+		m_f3Center.x + pAxis[0] * m_fHalfHeight, m_f3Center.y + pAxis[1] * m_fHalfHeight, m_f3Center.z + pAxis[2] * m_fHalfHeight);
+	Geometory::AddCapsule(f3Start, f3End, m_fRadius, DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f));
+}
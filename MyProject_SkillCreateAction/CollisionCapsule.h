@@ -0,0 +1,59 @@
+/**************************************************//*
+	@file	| CollisionCapsule.h
+	@brief	| カプセル当たり判定クラス
+	@note	| ローカルY軸に沿った線分を半径で膨らませた形
+			| 向きはゲームオブジェクトの回転を使う
+*//**************************************************/
+#pragma once
+#include "CollisionBase.h"
+#include <DirectXMath.h>
+#include <algorithm>
+
+// @brief カプセル当たり判定クラス
+class CCollisionCapsule : public CCollisionBase
+{
+public:
+	// コンストラクタの継承
+	using CCollisionBase::CCollisionBase;
+
+	// @brief 描画処理
+	void Draw() override;
+
+	// @brief 位置と向きを反映した形状を作る
+	CollisionVolume MakeVolume() override;
+
+	// @brief コリジョンの中心座標を取得
+	// @return (DirectX::XMFLOAT3)コリジョンの中心座標
+	DirectX::XMFLOAT3 GetCenter() { return m_f3Center; }
+
+	// @brief コリジョンの中心座標をセット
+	// @param center：コリジョンの中心座標
+	void SetCenter(const DirectX::XMFLOAT3& center) { m_f3Center = center; }
+
+	// @brief コリジョンの半径を取得
+	// @return 半径
+	float GetRadius() { return m_fRadius; }
+
+	// @brief コリジョンの半径をセット
+	// @param inRadius：半径
+	void SetRadius(float inRadius) { m_fRadius = inRadius; }
+
+	// @brief コリジョンの高さ(両端の半球を含む)を取得
+	// @return 高さ
+	float GetHeight() { return (m_fHalfHeight + m_fRadius) * 2.0f; }
+
+	// @brief コリジョンの高さ(両端の半球を含む)をセット
+	// @param inHeight：高さ(半径の2倍より小さい時は球になる)
+	void SetHeight(float inHeight) { m_fHalfHeight = (std::max)(inHeight * 0.5f - m_fRadius, 0.0f); }
+
+private:
+	// @brief 中心座標
+	DirectX::XMFLOAT3 m_f3Center = { 0.0f, 0.0f, 0.0f };
+
+	// @brief 半径
+	float m_fRadius = 0.5f;
+
+	// @brief 線分の長さの半分
+	float m_fHalfHeight = 0.5f;
+
+};
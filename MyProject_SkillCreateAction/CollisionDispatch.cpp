@@ -0,0 +1,1263 @@
+/**************************************************//*
+	@file	| CollisionDispatch.cpp
+	@brief	| 当たり判定の形状の組毎の判定関数の表のcppファイル
+	@note	| 球・カプセル同士は中心や線分の距離、箱との組は箱のローカル座標での最近点、
+			| 箱同士は分離軸(AABB同士は軸毎の区間、AABBとOBBは軸の内積を省いた分離軸)で判定する
+			| 逆の組は引数を入れ替える関数を表に入れ、形状の判定は表を引くだけで済ませる
+			| 掃引は、球・カプセルを含む組は表面の距離だけ進めることを繰り返し、
+			| 箱同士は分離軸毎に重なっている時間の区間を求めて共通部分の始めを触れた時間にする
+*//**************************************************/
+#include "CollisionDispatch.h"
+#include "SpatialQuery.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// @brief 表の大きさ(判定を行わないMaxの行と列を含む)
+	constexpr uint32_t ce_nShapeNum = static_cast<uint32_t>(CollisionShape::Max) + 1;
+
+	// @brief 分離軸の判定で、平行な辺の外積が0になっても誤判定しないように足す値
+	constexpr float ce_fParallelEpsilon = 1e-6f;
+
+	// @brief 長さが無いとみなす値
+	constexpr float ce_fEpsilon = 1e-8f;
+
+	// @brief 掃引で触れたとみなす表面の距離
+	constexpr float ce_fSweepTolerance = 1e-4f;
+
+	// @brief 掃引で距離だけ進める最大の回数(超えたら残りの区間を探す)
+	constexpr int ce_nMaxSweepStep = 32;
+
+	// @brief 掃引で進めきれなかった区間を探す回数
+	constexpr int ce_nSweepSearchStep = 40;
+
+	using TestFunc = CCollisionDispatch::TestFunc;
+	using SweepFunc = CCollisionDispatch::SweepFunc;
+
+	// @brief 表面の距離を求める関数(重なっていれば0以下)
+	using DistanceFunc = float(*)(const CollisionVolume& inA, const CollisionVolume& inB);
+
+	// @brief 内積
+	float Dot(const float* inA, const float* inB)
+	{
+		return inA[0] * inB[0] + inA[1] * inB[1] + inA[2] * inB[2];
+	}
+
+	// @brief 回転(ピッチ・ヨー・ロール)からローカル軸を求める
+	// @note DirectX::XMMatrixRotationRollPitchYawの各行と同じ
+	void SetAxis(CollisionVolume& outVolume, const float* inRotate)
+	{
+		const float fCosP = cosf(inRotate[0]), fSinP = sinf(inRotate[0]);
+		const float fCosY = cosf(inRotate[1]), fSinY = sinf(inRotate[1]);
+		const float fCosR = cosf(inRotate[2]), fSinR = sinf(inRotate[2]);
+		const float fAxis[3][3] = {
+			{ fCosR * fCosY + fSinR * fSinP * fSinY, fSinR * fCosP, fSinR * fSinP * fCosY - fCosR * fSinY },
+			{ fCosR * fSinP * fSinY - fSinR * fCosY, fCosR * fCosP, fSinR * fSinY + fCosR * fSinP * fCosY },
+			{ fCosP * fSinY, -fSinP, fCosP * fCosY } };
+		for (int i = 0; i < 3; i++)
+		{
+			for (int k = 0; k < 3; k++) outVolume.m_fAxis[i][k] = fAxis[i][k];
+		}
+	}
+
+	// @brief ワールドの軸を設定する
+	void SetWorldAxis(CollisionVolume& outVolume)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			for (int k = 0; k < 3; k++) outVolume.m_fAxis[i][k] = (i == k) ? 1.0f : 0.0f;
+		}
+	}
+
+	// @brief カプセルの線分の両端
+	void CapsuleSegment(const CollisionVolume& inCapsule, float* outStart, float* outEnd)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			float fOffset = inCapsule.m_fAxis[1][k] * inCapsule.m_fHalfHeight;
+			outStart[k] = inCapsule.m_fCenter[k] - fOffset;
+			outEnd[k] = inCapsule.m_fCenter[k] + fOffset;
+		}
+	}
+
+	// @brief 点と線分の距離の2乗
+	float PointSegmentDistanceSq(const float* inPoint, const float* inStart, const float* inEnd)
+	{
+		float fSegment[3], fToPoint[3];
+		for (int k = 0; k < 3; k++)
+		{
+			fSegment[k] = inEnd[k] - inStart[k];
+			fToPoint[k] = inPoint[k] - inStart[k];
+		}
+		float fLengthSq = Dot(fSegment, fSegment);
+		float fT = (fLengthSq > ce_fEpsilon) ? (std::min)((std::max)(Dot(fToPoint, fSegment) / fLengthSq, 0.0f), 1.0f) : 0.0f;
+		float fDistSq = 0.0f;
+		for (int k = 0; k < 3; k++)
+		{
+			float fDiff = fToPoint[k] - fSegment[k] * fT;
+			fDistSq += fDiff * fDiff;
+		}
+		return fDistSq;
+	}
+
+	// @brief 線分同士の距離の2乗
+	// @note 両方の線分の媒介変数を[0,1]に収めた最近点の組を求める
+	float SegmentSegmentDistanceSq(const float* inStartA, const float* inEndA, const float* inStartB, const float* inEndB)
+	{
+		float fD1[3], fD2[3], fR[3];
+		for (int k = 0; k < 3; k++)
+		{
+			fD1[k] = inEndA[k] - inStartA[k];
+			fD2[k] = inEndB[k] - inStartB[k];
+			fR[k] = inStartA[k] - inStartB[k];
+		}
+		const float fA = Dot(fD1, fD1), fE = Dot(fD2, fD2), fF = Dot(fD2, fR);
+
+		float fS = 0.0f, fT = 0.0f;
+		if (fA <= ce_fEpsilon && fE <= ce_fEpsilon)
+		{
+			// どちらも点
+		}
+		else if (fA <= ce_fEpsilon)
+		{
+			fT = (std::min)((std::max)(fF / fE, 0.0f), 1.0f);
+		}
+		else
+		{
+			const float fC = Dot(fD1, fR);
+			if (fE <= ce_fEpsilon)
+			{
+				fS = (std::min)((std::max)(-fC / fA, 0.0f), 1.0f);
+			}
+			else
+			{
+				// 平行でなければ直線同士の最近点から始め、範囲に収めて相手側を求め直す
+				const float fB = Dot(fD1, fD2);
+				const float fDenom = fA * fE - fB * fB;
+				fS = (fDenom > ce_fEpsilon) ? (std::min)((std::max)((fB * fF - fC * fE) / fDenom, 0.0f), 1.0f) : 0.0f;
+				fT = (fB * fS + fF) / fE;
+				if (fT < 0.0f)
+				{
+					fT = 0.0f;
+					fS = (std::min)((std::max)(-fC / fA, 0.0f), 1.0f);
+				}
+				else if (fT > 1.0f)
+				{
+					fT = 1.0f;
+					fS = (std::min)((std::max)((fB - fC) / fA, 0.0f), 1.0f);
+				}
+			}
+		}
+
+		float fDistSq = 0.0f;
+		for (int k = 0; k < 3; k++)
+		{
+			float fDiff = (inStartA[k] + fD1[k] * fS) - (inStartB[k] + fD2[k] * fT);
+			fDistSq += fDiff * fDiff;
+		}
+		return fDistSq;
+	}
+
+	// @brief 箱のローカル座標での点と箱の距離の2乗
+	float PointBoxDistanceSq(const float* inLocal, const float* inHalfSize)
+	{
+		float fDistSq = 0.0f;
+		for (int k = 0; k < 3; k++)
+		{
+			float fExcess = fabsf(inLocal[k]) - inHalfSize[k];
+			if (fExcess > 0.0f) fDistSq += fExcess * fExcess;
+		}
+		return fDistSq;
+	}
+
+	// @brief 点を箱のローカル座標に変換する
+	void ToLocal(const CollisionVolume& inBox, const float* inPoint, float* outLocal)
+	{
+		float fOffset[3] = { inPoint[0] - inBox.m_fCenter[0], inPoint[1] - inBox.m_fCenter[1], inPoint[2] - inBox.m_fCenter[2] };
+		for (int k = 0; k < 3; k++) outLocal[k] = Dot(fOffset, inBox.m_fAxis[k]);
+	}
+
+	// @brief 箱のローカル座標での線分と箱の距離の2乗
+	// @param inStart：始点
+	// @param inDirection：始点から終点まで
+	// @param inHalfSize：箱の大きさの半分
+	// @note 距離の2乗は、線分上の点が箱の面を越える位置で区切った区間毎に2次式になるため、
+	//       区間毎に最小の位置を求めて比べる
+	float SegmentBoxDistanceSq(const float* inStart, const float* inDirection, const float* inHalfSize)
+	{
+		// 区間の境目(両端と、各軸で面を越える位置)
+		float fBreak[8];
+		int nBreakNum = 0;
+		fBreak[nBreakNum++] = 0.0f;
+		for (int k = 0; k < 3; k++)
+		{
+			if (fabsf(inDirection[k]) <= ce_fEpsilon) continue;
+			for (float fSide : { -inHalfSize[k], inHalfSize[k] })
+			{
+				float fT = (fSide - inStart[k]) / inDirection[k];
+				if (fT > 0.0f && fT < 1.0f) fBreak[nBreakNum++] = fT;
+			}
+		}
+		fBreak[nBreakNum++] = 1.0f;
+
+		// 境目は最大8個なので挿入で並べる
+		for (int i = 1; i < nBreakNum; i++)
+		{
+			float fValue = fBreak[i];
+			int j = i;
+			for (; j > 0 && fBreak[j - 1] > fValue; j--) fBreak[j] = fBreak[j - 1];
+			fBreak[j] = fValue;
+		}
+
+		float fBest = FLT_MAX;
+		for (int i = 0; i + 1 < nBreakNum; i++)
+		{
+			// 区間の中で面の外にいる軸は変わらないため、その軸だけの2次式の最小を求める
+			const float fFrom = fBreak[i], fTo = fBreak[i + 1];
+			const float fMid = (fFrom + fTo) * 0.5f;
+			float fNumerator = 0.0f, fDenominator = 0.0f;
+			for (int k = 0; k < 3; k++)
+			{
+				float fPos = inStart[k] + inDirection[k] * fMid;
+				if (fabsf(fPos) <= inHalfSize[k]) continue;
+				float fSide = (fPos > 0.0f) ? inHalfSize[k] : -inHalfSize[k];
+				fNumerator -= (inStart[k] - fSide) * inDirection[k];
+				fDenominator += inDirection[k] * inDirection[k];
+			}
+			float fT = (fDenominator > ce_fEpsilon) ? (std::min)((std::max)(fNumerator / fDenominator, fFrom), fTo) : fFrom;
+
+			float fPoint[3] = { inStart[0] + inDirection[0] * fT, inStart[1] + inDirection[1] * fT, inStart[2] + inDirection[2] * fT };
+			fBest = (std::min)(fBest, PointBoxDistanceSq(fPoint, inHalfSize));
+			if (fBest == 0.0f) break;
+		}
+		return fBest;
+	}
+
+	// @brief 箱同士の分離軸の判定
+	// @param inHalfA：箱Aの大きさの半分
+	// @param inHalfB：箱Bの大きさの半分
+	// @param inRotate：箱Aのローカル軸から見た箱Bのローカル軸([Aの軸][Bの軸])
+	// @param inOffset：箱Aのローカル座標での箱Bの中心
+	// @note 面の法線6軸と辺の外積9軸の15軸を調べる
+	bool SeparatingAxis(const float* inHalfA, const float* inHalfB, const float (&inRotate)[3][3], const float* inOffset)
+	{
+		float fAbs[3][3];
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++) fAbs[i][j] = fabsf(inRotate[i][j]) + ce_fParallelEpsilon;
+		}
+
+		// Aの面の法線
+		for (int i = 0; i < 3; i++)
+		{
+			float fRadiusB = inHalfB[0] * fAbs[i][0] + inHalfB[1] * fAbs[i][1] + inHalfB[2] * fAbs[i][2];
+			if (fabsf(inOffset[i]) > inHalfA[i] + fRadiusB) return false;
+		}
+
+		// Bの面の法線
+		for (int j = 0; j < 3; j++)
+		{
+			float fRadiusA = inHalfA[0] * fAbs[0][j] + inHalfA[1] * fAbs[1][j] + inHalfA[2] * fAbs[2][j];
+			float fDistance = inOffset[0] * inRotate[0][j] + inOffset[1] * inRotate[1][j] + inOffset[2] * inRotate[2][j];
+			if (fabsf(fDistance) > fRadiusA + inHalfB[j]) return false;
+		}
+
+		// Aの辺iとBの辺jの外積
+		for (int i = 0; i < 3; i++)
+		{
+			const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+			for (int j = 0; j < 3; j++)
+			{
+				const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+				float fRadiusA = inHalfA[i1] * fAbs[i2][j] + inHalfA[i2] * fAbs[i1][j];
+				float fRadiusB = inHalfB[j1] * fAbs[i][j2] + inHalfB[j2] * fAbs[i][j1];
+				float fDistance = inOffset[i2] * inRotate[i1][j] - inOffset[i1] * inRotate[i2][j];
+				if (fabsf(fDistance) > fRadiusA + fRadiusB) return false;
+			}
+		}
+		return true;
+	}
+
+	// @brief 判定を行わない
+	bool TestNone(const CollisionVolume&, const CollisionVolume&)
+	{
+		return false;
+	}
+
+	// @brief 引数を入れ替えて判定する
+	template<TestFunc Func>
+	bool TestSwap(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		return Func(inB, inA);
+	}
+
+	// @brief 球と球
+	bool TestSphereSphere(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fOffset[3] = { inB.m_fCenter[0] - inA.m_fCenter[0], inB.m_fCenter[1] - inA.m_fCenter[1], inB.m_fCenter[2] - inA.m_fCenter[2] };
+		float fRadius = inA.m_fRadius + inB.m_fRadius;
+		return Dot(fOffset, fOffset) <= fRadius * fRadius;
+	}
+
+	// @brief 球とカプセル
+	bool TestSphereCapsule(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fStart[3], fEnd[3];
+		CapsuleSegment(inB, fStart, fEnd);
+		float fRadius = inA.m_fRadius + inB.m_fRadius;
+		return PointSegmentDistanceSq(inA.m_fCenter, fStart, fEnd) <= fRadius * fRadius;
+	}
+
+	// @brief 球とAABB
+	bool TestSphereAabb(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fOffset[3] = { inA.m_fCenter[0] - inB.m_fCenter[0], inA.m_fCenter[1] - inB.m_fCenter[1], inA.m_fCenter[2] - inB.m_fCenter[2] };
+		return PointBoxDistanceSq(fOffset, inB.m_fHalfSize) <= inA.m_fRadius * inA.m_fRadius;
+	}
+
+	// @brief 球とOBB
+	bool TestSphereObb(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fLocal[3];
+		ToLocal(inB, inA.m_fCenter, fLocal);
+		return PointBoxDistanceSq(fLocal, inB.m_fHalfSize) <= inA.m_fRadius * inA.m_fRadius;
+	}
+
+	// @brief カプセルとカプセル
+	bool TestCapsuleCapsule(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fStartA[3], fEndA[3], fStartB[3], fEndB[3];
+		CapsuleSegment(inA, fStartA, fEndA);
+		CapsuleSegment(inB, fStartB, fEndB);
+		float fRadius = inA.m_fRadius + inB.m_fRadius;
+		return SegmentSegmentDistanceSq(fStartA, fEndA, fStartB, fEndB) <= fRadius * fRadius;
+	}
+
+	// @brief カプセルと箱(AABB・OBB)
+	bool TestCapsuleBox(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fStart[3], fEnd[3], fLocalStart[3], fLocalEnd[3];
+		CapsuleSegment(inA, fStart, fEnd);
+		ToLocal(inB, fStart, fLocalStart);
+		ToLocal(inB, fEnd, fLocalEnd);
+
+		// 線分を半径だけ広げた範囲が箱と重ならなければ離れている
+		float fDirection[3];
+		for (int k = 0; k < 3; k++)
+		{
+			if ((std::min)(fLocalStart[k], fLocalEnd[k]) - inA.m_fRadius > inB.m_fHalfSize[k]) return false;
+			if ((std::max)(fLocalStart[k], fLocalEnd[k]) + inA.m_fRadius < -inB.m_fHalfSize[k]) return false;
+			fDirection[k] = fLocalEnd[k] - fLocalStart[k];
+		}
+		return SegmentBoxDistanceSq(fLocalStart, fDirection, inB.m_fHalfSize) <= inA.m_fRadius * inA.m_fRadius;
+	}
+
+	// @brief AABBとAABB
+	bool TestAabbAabb(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			if (fabsf(inA.m_fCenter[k] - inB.m_fCenter[k]) > inA.m_fHalfSize[k] + inB.m_fHalfSize[k]) return false;
+		}
+		return true;
+	}
+
+	// @brief AABBとOBB
+	// @note AABBの軸はワールドの軸なので、OBBの軸がそのまま回転になる
+	bool TestAabbObb(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fRotate[3][3];
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++) fRotate[i][j] = inB.m_fAxis[j][i];
+		}
+		float fOffset[3] = { inB.m_fCenter[0] - inA.m_fCenter[0], inB.m_fCenter[1] - inA.m_fCenter[1], inB.m_fCenter[2] - inA.m_fCenter[2] };
+		return SeparatingAxis(inA.m_fHalfSize, inB.m_fHalfSize, fRotate, fOffset);
+	}
+
+	// @brief OBBとOBB
+	bool TestObbObb(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fRotate[3][3];
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++) fRotate[i][j] = Dot(inA.m_fAxis[i], inB.m_fAxis[j]);
+		}
+		float fLocal[3];
+		ToLocal(inA, inB.m_fCenter, fLocal);
+		return SeparatingAxis(inA.m_fHalfSize, inB.m_fHalfSize, fRotate, fLocal);
+	}
+
+	// @brief 球と球の表面の距離
+	float DistanceSphereSphere(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fOffset[3] = { inB.m_fCenter[0] - inA.m_fCenter[0], inB.m_fCenter[1] - inA.m_fCenter[1], inB.m_fCenter[2] - inA.m_fCenter[2] };
+		return sqrtf(Dot(fOffset, fOffset)) - (inA.m_fRadius + inB.m_fRadius);
+	}
+
+	// @brief 球とカプセルの表面の距離
+	float DistanceSphereCapsule(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fStart[3], fEnd[3];
+		CapsuleSegment(inB, fStart, fEnd);
+		return sqrtf(PointSegmentDistanceSq(inA.m_fCenter, fStart, fEnd)) - (inA.m_fRadius + inB.m_fRadius);
+	}
+
+	// @brief 球と箱(AABB・OBB)の表面の距離
+	float DistanceSphereBox(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fLocal[3];
+		ToLocal(inB, inA.m_fCenter, fLocal);
+		return sqrtf(PointBoxDistanceSq(fLocal, inB.m_fHalfSize)) - inA.m_fRadius;
+	}
+
+	// @brief カプセルとカプセルの表面の距離
+	float DistanceCapsuleCapsule(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fStartA[3], fEndA[3], fStartB[3], fEndB[3];
+		CapsuleSegment(inA, fStartA, fEndA);
+		CapsuleSegment(inB, fStartB, fEndB);
+		return sqrtf(SegmentSegmentDistanceSq(fStartA, fEndA, fStartB, fEndB)) - (inA.m_fRadius + inB.m_fRadius);
+	}
+
+	// @brief カプセルと箱(AABB・OBB)の表面の距離
+	float DistanceCapsuleBox(const CollisionVolume& inA, const CollisionVolume& inB)
+	{
+		float fStart[3], fEnd[3], fLocalStart[3], fLocalEnd[3], fDirection[3];
+		CapsuleSegment(inA, fStart, fEnd);
+		ToLocal(inB, fStart, fLocalStart);
+		ToLocal(inB, fEnd, fLocalEnd);
+		for (int k = 0; k < 3; k++) fDirection[k] = fLocalEnd[k] - fLocalStart[k];
+		return sqrtf(SegmentBoxDistanceSq(fLocalStart, fDirection, inB.m_fHalfSize)) - inA.m_fRadius;
+	}
+
+	// @brief 掃引を行わない
+	bool SweepNone(const CollisionVolume&, const CollisionVolume&, const float*, float&)
+	{
+		return false;
+	}
+
+	// @brief 引数を入れ替えて掃引する(相手から見た移動は逆向きになる)
+	template<SweepFunc Func>
+	bool SweepSwap(const CollisionVolume& inA, const CollisionVolume& inB, const float* inMove, float& outTime)
+	{
+		const float fMove[3] = { -inMove[0], -inMove[1], -inMove[2] };
+		return Func(inB, inA, fMove, outTime);
+	}
+
+	// @brief 表面の距離だけ進めることを繰り返して掃引する
+	// @note 平行移動では表面の距離は移動した長さより速く縮まないため、距離だけ進めても通り過ぎない
+	template<DistanceFunc Func>
+	bool SweepAdvance(const CollisionVolume& inA, const CollisionVolume& inB, const float* inMove, float& outTime)
+	{
+		const float fLength = sqrtf(Dot(inMove, inMove));
+		CollisionVolume tMoved = inA;
+		float fTime = 0.0f;
+		for (int nStep = 0; nStep < ce_nMaxSweepStep; nStep++)
+		{
+			for (int k = 0; k < 3; k++) tMoved.m_fCenter[k] = inA.m_fCenter[k] + inMove[k] * fTime;
+			const float fDistance = Func(tMoved, inB);
+			if (fDistance <= ce_fSweepTolerance)
+			{
+				outTime = fTime;
+				return true;
+			}
+			if (fLength <= ce_fEpsilon) return false;
+
+			fTime += fDistance / fLength;
+			if (fTime > 1.0f) return false;
+		}
+
+		// かすめるように近付き続けて収まらない時は、残りの区間を探す
+		// 凸形状同士の距離は平行移動に対して凸なので、3分割で一番近い時間を求め、触れていれば手前を2分割で詰める
+		auto DistanceAt = [&](float inTime)
+			{
+				for (int k = 0; k < 3; k++) tMoved.m_fCenter[k] = inA.m_fCenter[k] + inMove[k] * inTime;
+				return Func(tMoved, inB);
+			};
+		float fLow = fTime, fHigh = 1.0f;
+		for (int nStep = 0; nStep < ce_nSweepSearchStep; nStep++)
+		{
+			const float fThird = (fHigh - fLow) / 3.0f;
+			if (DistanceAt(fLow + fThird) <= DistanceAt(fHigh - fThird)) fHigh -= fThird;
+			else fLow += fThird;
+		}
+		float fNearest = (fLow + fHigh) * 0.5f;
+		if (DistanceAt(fNearest) > ce_fSweepTolerance) return false;
+
+		for (int nStep = 0; nStep < ce_nSweepSearchStep; nStep++)
+		{
+			const float fMid = (fTime + fNearest) * 0.5f;
+			if (DistanceAt(fMid) <= ce_fSweepTolerance) fNearest = fMid;
+			else fTime = fMid;
+		}
+		outTime = fNearest;
+		return true;
+	}
+
+	// @brief 箱と箱(AABB・OBB)の掃引
+	// @note 分離軸毎に影が重なっている時間の区間を求め、全ての軸の区間の共通部分があれば触れる
+	bool SweepBoxBox(const CollisionVolume& inA, const CollisionVolume& inB, const float* inMove, float& outTime)
+	{
+		const float fOffset[3] = { inB.m_fCenter[0] - inA.m_fCenter[0], inB.m_fCenter[1] - inA.m_fCenter[1], inB.m_fCenter[2] - inA.m_fCenter[2] };
+		float fEnter = 0.0f, fExit = 1.0f;
+		auto Axis = [&](const float* inAxis)
+			{
+				float fRadius = 0.0f;
+				for (int i = 0; i < 3; i++)
+				{
+					fRadius += inA.m_fHalfSize[i] * fabsf(Dot(inA.m_fAxis[i], inAxis)) + inB.m_fHalfSize[i] * fabsf(Dot(inB.m_fAxis[i], inAxis));
+				}
+
+				// 時間tでの中心の距離は fDistance - fSpeed * t
+				const float fDistance = Dot(fOffset, inAxis);
+				const float fSpeed = Dot(inMove, inAxis);
+				if (fabsf(fSpeed) <= ce_fEpsilon) return fabsf(fDistance) <= fRadius;
+
+				float fT0 = (fDistance - fRadius) / fSpeed, fT1 = (fDistance + fRadius) / fSpeed;
+				if (fT0 > fT1) std::swap(fT0, fT1);
+				fEnter = (std::max)(fEnter, fT0);
+				fExit = (std::min)(fExit, fT1);
+				return fEnter <= fExit;
+			};
+
+		for (int i = 0; i < 3; i++)
+		{
+			if (!Axis(inA.m_fAxis[i]) || !Axis(inB.m_fAxis[i])) return false;
+		}
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				// 平行な辺の外積は面の法線の軸で調べ済み
+				const float* pA = inA.m_fAxis[i];
+				const float* pB = inB.m_fAxis[j];
+				const float fCross[3] = { pA[1] * pB[2] - pA[2] * pB[1], pA[2] * pB[0] - pA[0] * pB[2], pA[0] * pB[1] - pA[1] * pB[0] };
+				if (Dot(fCross, fCross) <= ce_fParallelEpsilon) continue;
+				if (!Axis(fCross)) return false;
+			}
+		}
+		outTime = fEnter;
+		return true;
+	}
+
+	// @brief 形状の組毎の判定関数([形状A][形状B])
+	const TestFunc g_TestTable[ce_nShapeNum][ce_nShapeNum] =
+	{
+		// 球
+		{ TestSphereSphere, TestSphereCapsule, TestSphereAabb, TestSphereObb, TestNone },
+		// カプセル
+		{ TestSwap<TestSphereCapsule>, TestCapsuleCapsule, TestCapsuleBox, TestCapsuleBox, TestNone },
+		// AABB
+		{ TestSwap<TestSphereAabb>, TestSwap<TestCapsuleBox>, TestAabbAabb, TestAabbObb, TestNone },
+		// OBB
+		{ TestSwap<TestSphereObb>, TestSwap<TestCapsuleBox>, TestSwap<TestAabbObb>, TestObbObb, TestNone },
+		// 判定を行わない
+		{ TestNone, TestNone, TestNone, TestNone, TestNone },
+	};
+
+	// @brief 形状の組毎の掃引の判定関数([形状A][形状B])
+	const SweepFunc g_SweepTable[ce_nShapeNum][ce_nShapeNum] =
+	{
+		// 球
+		{ SweepAdvance<DistanceSphereSphere>, SweepAdvance<DistanceSphereCapsule>, SweepAdvance<DistanceSphereBox>, SweepAdvance<DistanceSphereBox>, SweepNone },
+		// カプセル
+		{ SweepSwap<SweepAdvance<DistanceSphereCapsule>>, SweepAdvance<DistanceCapsuleCapsule>, SweepAdvance<DistanceCapsuleBox>, SweepAdvance<DistanceCapsuleBox>, SweepNone },
+		// AABB
+		{ SweepSwap<SweepAdvance<DistanceSphereBox>>, SweepSwap<SweepAdvance<DistanceCapsuleBox>>, SweepBoxBox, SweepBoxBox, SweepNone },
+		// OBB
+		{ SweepSwap<SweepAdvance<DistanceSphereBox>>, SweepSwap<SweepAdvance<DistanceCapsuleBox>>, SweepBoxBox, SweepBoxBox, SweepNone },
+		// 判定を行わない
+		{ SweepNone, SweepNone, SweepNone, SweepNone, SweepNone },
+	};
+}
+
+/****************************************//*
+	@brief　	| 2つの形状が重なっているか調べる
+	@param　	| inA：形状A
+	@param　	| inB：形状B
+	@return		| true:重なっている false:離れている
+*//****************************************/
+bool CCollisionDispatch::Test(const CollisionVolume& inA, const CollisionVolume& inB)
+{
+	return g_TestTable[static_cast<uint32_t>(inA.m_eShape)][static_cast<uint32_t>(inB.m_eShape)](inA, inB);
+}
+
+/****************************************//*
+	@brief　	| 形状の組の判定関数の取得
+	@param　	| inA：形状Aの種類
+	@param　	| inB：形状Bの種類
+	@return		| 判定関数
+*//****************************************/
+CCollisionDispatch::TestFunc CCollisionDispatch::GetTestFunc(CollisionShape inA, CollisionShape inB)
+{
+	return g_TestTable[static_cast<uint32_t>(inA)][static_cast<uint32_t>(inB)];
+}
+
+/****************************************//*
+	@brief　	| 動く2つの形状が移動中に最初に触れる時間を求める
+	@param　	| inA：動いた後の形状A
+	@param　	| inMoveA：形状Aの移動量(XYZ)
+	@param　	| inB：動いた後の形状B
+	@param　	| inMoveB：形状Bの移動量(XYZ)
+	@param　	| outTime：最初に触れる時間(0:動く前 1:動いた後)
+	@return		| true:触れる false:触れない
+*//****************************************/
+bool CCollisionDispatch::Sweep(const CollisionVolume& inA, const float* inMoveA, const CollisionVolume& inB, const float* inMoveB, float& outTime)
+{
+	// 動く前の位置に戻し、形状Bを止めて形状Aだけを相対的に動かす
+	CollisionVolume tStartA = inA, tStartB = inB;
+	float fMove[3];
+	for (int k = 0; k < 3; k++)
+	{
+		tStartA.m_fCenter[k] -= inMoveA[k];
+		tStartB.m_fCenter[k] -= inMoveB[k];
+		fMove[k] = inMoveA[k] - inMoveB[k];
+	}
+	return g_SweepTable[static_cast<uint32_t>(inA.m_eShape)][static_cast<uint32_t>(inB.m_eShape)](tStartA, tStartB, fMove, outTime);
+}
+
+/****************************************//*
+	@brief　	| 球の形状を作る
+	@param　	| inCenter：中心(XYZ)
+	@param　	| inRadius：半径
+	@return		| 形状
+*//****************************************/
+CollisionVolume CCollisionDispatch::MakeSphere(const float* inCenter, float inRadius)
+{
+	CollisionVolume tVolume = {};
+	tVolume.m_eShape = CollisionShape::Sphere;
+	for (int k = 0; k < 3; k++)
+	{
+		tVolume.m_fCenter[k] = inCenter[k];
+		tVolume.m_fHalfSize[k] = inRadius;
+	}
+	SetWorldAxis(tVolume);
+	tVolume.m_fRadius = inRadius;
+	return tVolume;
+}
+
+/****************************************//*
+	@brief　	| カプセルの形状を作る
+	@param　	| inCenter：中心(XYZ)
+	@param　	| inRadius：半径
+	@param　	| inHalfHeight：線分の長さの半分
+	@param　	| inRotate：回転(ピッチ・ヨー・ロール)
+	@return		| 形状
+*//****************************************/
+CollisionVolume CCollisionDispatch::MakeCapsule(const float* inCenter, float inRadius, float inHalfHeight, const float* inRotate)
+{
+	CollisionVolume tVolume = {};
+	tVolume.m_eShape = CollisionShape::Capsule;
+	for (int k = 0; k < 3; k++) tVolume.m_fCenter[k] = inCenter[k];
+	tVolume.m_fHalfSize[0] = inRadius;
+	tVolume.m_fHalfSize[1] = inHalfHeight + inRadius;
+	tVolume.m_fHalfSize[2] = inRadius;
+	SetAxis(tVolume, inRotate);
+	tVolume.m_fRadius = inRadius;
+	tVolume.m_fHalfHeight = inHalfHeight;
+	return tVolume;
+}
+
+/****************************************//*
+	@brief　	| 軸に沿った箱の形状を作る
+	@param　	| inCenter：中心(XYZ)
+	@param　	| inHalfSize：大きさの半分(XYZ)
+	@return		| 形状
+*//****************************************/
+CollisionVolume CCollisionDispatch::MakeAabb(const float* inCenter, const float* inHalfSize)
+{
+	CollisionVolume tVolume = {};
+	tVolume.m_eShape = CollisionShape::Aabb;
+	for (int k = 0; k < 3; k++)
+	{
+		tVolume.m_fCenter[k] = inCenter[k];
+		tVolume.m_fHalfSize[k] = inHalfSize[k];
+	}
+	SetWorldAxis(tVolume);
+	return tVolume;
+}
+
+/****************************************//*
+	@brief　	| 向きを持った箱の形状を作る
+	@param　	| inCenter：中心(XYZ)
+	@param　	| inHalfSize：大きさの半分(ローカル軸毎)
+	@param　	| inRotate：回転(ピッチ・ヨー・ロール)
+	@return		| 形状
+*//****************************************/
+CollisionVolume CCollisionDispatch::MakeObb(const float* inCenter, const float* inHalfSize, const float* inRotate)
+{
+	CollisionVolume tVolume = {};
+	tVolume.m_eShape = CollisionShape::Obb;
+	for (int k = 0; k < 3; k++)
+	{
+		tVolume.m_fCenter[k] = inCenter[k];
+		tVolume.m_fHalfSize[k] = inHalfSize[k];
+	}
+	SetAxis(tVolume, inRotate);
+	return tVolume;
+}
+
+/****************************************//*
+	@brief　	| 形状を包む向きを持った箱の形状に変換する
+	@param　	| inVolume：形状
+	@return		| 包む箱
+	@note		| 全ての形状は包む箱の中心・大きさ・軸を持っているため、形状の種類を変えるだけ
+*//****************************************/
+CollisionVolume CCollisionDispatch::ToObb(const CollisionVolume& inVolume)
+{
+	CollisionVolume tVolume = inVolume;
+	if (tVolume.m_eShape != CollisionShape::Max) tVolume.m_eShape = CollisionShape::Obb;
+	return tVolume;
+}
+
+/****************************************//*
+	@brief　	| 形状の組毎の判定を確かめ、全てOBBで判定する場合と速さを比べて書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CCollisionDispatch::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr uint32_t ce_nVolumeNum = 4000;
+	static constexpr float ce_fMapSize = 120.0f;
+	static constexpr int ce_nRepeatNum = 50;
+	static constexpr int ce_nSampleNum = 64;
+	char szLine[256];
+	bool bSuccess = true;
+	const char* pShapeName[ce_nShapeNum] = { "sphere", "capsule", "aabb", "obb", "none" };
+
+	// 決まった配置で結果を確かめる
+	{
+		const float fZero[3] = { 0.0f, 0.0f, 0.0f };
+		const float fUnit[3] = { 1.0f, 1.0f, 1.0f };
+		const float fYaw45[3] = { 0.0f, 0.78539816f, 0.0f };
+		const float fLying[3] = { 0.0f, 0.0f, 1.57079633f };
+		auto Pos = [](float inX, float inY, float inZ) { return std::vector<float>{ inX, inY, inZ }; };
+
+		bool bCheck = true;
+		// 球同士は半径の和
+		bCheck &= Test(MakeSphere(fZero, 1.0f), MakeSphere(Pos(1.99f, 0.0f, 0.0f).data(), 1.0f));
+		bCheck &= !Test(MakeSphere(fZero, 1.0f), MakeSphere(Pos(2.01f, 0.0f, 0.0f).data(), 1.0f));
+		// 球と箱は角の丸み(角の方向は面の方向より遠くまで離れない)
+		bCheck &= Test(MakeSphere(Pos(1.5f, 1.5f, 0.0f).data(), 0.71f), MakeAabb(fZero, fUnit));
+		bCheck &= !Test(MakeSphere(Pos(1.5f, 1.5f, 0.0f).data(), 0.70f), MakeAabb(fZero, fUnit));
+		// 45度回した箱は角が1.414まで届く
+		bCheck &= Test(MakeSphere(Pos(1.9f, 0.0f, 0.0f).data(), 0.5f), MakeObb(fZero, fUnit, fYaw45));
+		bCheck &= !Test(MakeSphere(Pos(1.9f, 0.0f, 0.0f).data(), 0.5f), MakeAabb(Pos(0.0f, 0.0f, 0.0f).data(), Pos(0.9f, 1.0f, 1.0f).data()));
+		// 立てたカプセルと、寝かせたカプセル(ロールで線分がX軸に沿う)
+		bCheck &= Test(MakeCapsule(fZero, 0.5f, 1.0f, fZero), MakeSphere(Pos(0.0f, 1.9f, 0.0f).data(), 0.5f));
+		bCheck &= !Test(MakeCapsule(fZero, 0.5f, 1.0f, fZero), MakeSphere(Pos(0.0f, 2.1f, 0.0f).data(), 0.5f));
+		bCheck &= Test(MakeCapsule(fZero, 0.5f, 1.0f, fLying), MakeCapsule(Pos(1.9f, 0.0f, 0.0f).data(), 0.5f, 1.0f, fZero));
+		bCheck &= !Test(MakeCapsule(fZero, 0.5f, 1.0f, fLying), MakeCapsule(Pos(2.1f, 0.0f, 0.0f).data(), 0.5f, 1.0f, fZero));
+		// ねじれた位置の線分同士(X方向とZ方向、高さの差が半径の和)
+		bCheck &= Test(MakeCapsule(fZero, 0.5f, 1.0f, fLying), MakeCapsule(Pos(0.0f, 0.99f, 0.0f).data(), 0.5f, 1.0f, Pos(1.57079633f, 0.0f, 0.0f).data()));
+		bCheck &= !Test(MakeCapsule(fZero, 0.5f, 1.0f, fLying), MakeCapsule(Pos(0.0f, 1.01f, 0.0f).data(), 0.5f, 1.0f, Pos(1.57079633f, 0.0f, 0.0f).data()));
+		// 寝かせたカプセルの端が箱の角をかすめる
+		bCheck &= Test(MakeCapsule(Pos(2.3f, 1.3f, 0.0f).data(), 0.45f, 1.0f, fLying), MakeAabb(fZero, fUnit));
+		bCheck &= !Test(MakeCapsule(Pos(2.3f, 1.3f, 0.0f).data(), 0.40f, 1.0f, fLying), MakeAabb(fZero, fUnit));
+		// 箱同士(AABBの面、45度回したOBBの角、辺同士)
+		bCheck &= Test(MakeAabb(fZero, fUnit), MakeAabb(Pos(1.99f, 1.99f, 0.0f).data(), fUnit));
+		bCheck &= !Test(MakeAabb(fZero, fUnit), MakeAabb(Pos(2.01f, 0.0f, 0.0f).data(), fUnit));
+		bCheck &= Test(MakeAabb(fZero, fUnit), MakeObb(Pos(2.4f, 0.0f, 0.0f).data(), fUnit, fYaw45));
+		bCheck &= !Test(MakeAabb(fZero, fUnit), MakeObb(Pos(2.45f, 0.0f, 0.0f).data(), fUnit, fYaw45));
+		bCheck &= Test(MakeObb(fZero, fUnit, fYaw45), MakeObb(Pos(2.8f, 0.0f, 0.0f).data(), fUnit, fYaw45));
+		bCheck &= !Test(MakeObb(fZero, fUnit, fYaw45), MakeObb(Pos(2.9f, 0.0f, 0.0f).data(), fUnit, fYaw45));
+		bCheck &= Test(MakeObb(fZero, fUnit, fYaw45), MakeObb(Pos(2.35f, 0.0f, 0.0f).data(), fUnit, Pos(0.78539816f, 0.0f, 0.0f).data()));
+		bCheck &= !Test(MakeObb(fZero, fUnit, fYaw45), MakeObb(Pos(2.45f, 0.0f, 0.0f).data(), fUnit, Pos(0.78539816f, 0.0f, 0.0f).data()));
+		// Maxは何とも当たらない
+		CollisionVolume tNone = MakeSphere(fZero, 1.0f);
+		tNone.m_eShape = CollisionShape::Max;
+		bCheck &= !Test(tNone, MakeSphere(fZero, 1.0f)) && !Test(MakeAabb(fZero, fUnit), tNone);
+
+		sprintf_s(szLine, "fixed cases (sphere/capsule/aabb/obb pairs, rounded corners, skew segments)  %s\n", bCheck ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bCheck;
+	}
+
+	// 形状を混ぜて置く(キャラクターの球とカプセル、立てた箱のAABB、回した箱のOBB)
+	std::mt19937 tRandom(20261019);
+	std::uniform_real_distribution<float> tPos(0.0f, ce_fMapSize);
+	std::uniform_real_distribution<float> tUnit(0.0f, 1.0f);
+	std::uniform_real_distribution<float> tAngle(0.0f, 6.2831853f);
+	std::vector<CollisionVolume> tVolumeVec(ce_nVolumeNum);
+	for (uint32_t i = 0; i < ce_nVolumeNum; i++)
+	{
+		float fCenter[3] = { tPos(tRandom), tUnit(tRandom) * 4.0f, tPos(tRandom) };
+		float fPick = tUnit(tRandom);
+		if (fPick < 0.4f)
+		{
+			tVolumeVec[i] = MakeSphere(fCenter, 0.4f + tUnit(tRandom) * 0.8f);
+		}
+		else if (fPick < 0.65f)
+		{
+			// 大半は立てたカプセル、一部は倒れている
+			float fRotate[3] = { (tUnit(tRandom) < 0.2f) ? 1.57079633f : 0.0f, tAngle(tRandom), 0.0f };
+			tVolumeVec[i] = MakeCapsule(fCenter, 0.3f + tUnit(tRandom) * 0.4f, 0.5f + tUnit(tRandom) * 0.8f, fRotate);
+		}
+		else if (fPick < 0.85f)
+		{
+			float fHalf[3] = { 0.5f + tUnit(tRandom) * 2.5f, 0.5f + tUnit(tRandom) * 2.0f, 0.5f + tUnit(tRandom) * 2.5f };
+			tVolumeVec[i] = MakeAabb(fCenter, fHalf);
+		}
+		else
+		{
+			float fHalf[3] = { 0.5f + tUnit(tRandom) * 2.5f, 0.5f + tUnit(tRandom) * 2.0f, 0.5f + tUnit(tRandom) * 2.5f };
+			float fRotate[3] = { (tUnit(tRandom) < 0.3f) ? (tUnit(tRandom) - 0.5f) : 0.0f, tAngle(tRandom), 0.0f };
+			tVolumeVec[i] = MakeObb(fCenter, fHalf, fRotate);
+		}
+	}
+
+	// 包む箱のAABBが重なる組を候補にする(シーンの空間検索が渡す組と同じ条件)
+	std::vector<float> tBoundsVec(ce_nVolumeNum * 6);
+	for (uint32_t i = 0; i < ce_nVolumeNum; i++)
+	{
+		const CollisionVolume& tVolume = tVolumeVec[i];
+		for (int k = 0; k < 3; k++)
+		{
+			float fExtent = fabsf(tVolume.m_fAxis[0][k]) * tVolume.m_fHalfSize[0] + fabsf(tVolume.m_fAxis[1][k]) * tVolume.m_fHalfSize[1]
+				+ fabsf(tVolume.m_fAxis[2][k]) * tVolume.m_fHalfSize[2];
+			tBoundsVec[i * 6 + k] = tVolume.m_fCenter[k] - fExtent;
+			tBoundsVec[i * 6 + 3 + k] = tVolume.m_fCenter[k] + fExtent;
+		}
+	}
+	std::vector<std::pair<uint32_t, uint32_t>> tPairVec;
+	for (uint32_t i = 0; i < ce_nVolumeNum; i++)
+	{
+		for (uint32_t j = i + 1; j < ce_nVolumeNum; j++)
+		{
+			const float* pA = &tBoundsVec[i * 6];
+			const float* pB = &tBoundsVec[j * 6];
+			if (pA[0] > pB[3] || pA[3] < pB[0] || pA[1] > pB[4] || pA[4] < pB[1] || pA[2] > pB[5] || pA[5] < pB[2]) continue;
+			tPairVec.push_back({ i, j });
+		}
+	}
+
+	// 組の向きを入れ替えても、AABBをOBBとして扱っても、球を長さ0のカプセルとして扱っても結果が変わらない
+	// カプセルは線分上に並べた球と比べる(並べた球が当たれば当たり、当たっていれば間隔の半分だけ大きな球のどれかが当たる)
+	{
+		int nSwapMismatch = 0, nShapeMismatch = 0, nSampleMismatch = 0;
+		for (const auto& tPair : tPairVec)
+		{
+			const CollisionVolume& tA = tVolumeVec[tPair.first];
+			const CollisionVolume& tB = tVolumeVec[tPair.second];
+			const bool bHit = Test(tA, tB);
+			nSwapMismatch += (bHit != Test(tB, tA)) ? 1 : 0;
+
+			CollisionVolume tAltA = tA, tAltB = tB;
+			for (CollisionVolume* pAlt : { &tAltA, &tAltB })
+			{
+				if (pAlt->m_eShape == CollisionShape::Aabb) pAlt->m_eShape = CollisionShape::Obb;
+				else if (pAlt->m_eShape == CollisionShape::Sphere) pAlt->m_eShape = CollisionShape::Capsule;
+			}
+			nShapeMismatch += (bHit != Test(tAltA, tAltB)) ? 1 : 0;
+
+			for (int nSide = 0; nSide < 2; nSide++)
+			{
+				const CollisionVolume& tCapsule = nSide ? tB : tA;
+				const CollisionVolume& tOther = nSide ? tA : tB;
+				if (tCapsule.m_eShape != CollisionShape::Capsule) continue;
+
+				float fStart[3], fEnd[3];
+				CapsuleSegment(tCapsule, fStart, fEnd);
+				const float fHalfStep = tCapsule.m_fHalfHeight / (ce_nSampleNum - 1);
+				bool bSampleHit = false, bWideHit = false;
+				for (int s = 0; s < ce_nSampleNum; s++)
+				{
+					float fT = static_cast<float>(s) / (ce_nSampleNum - 1);
+					float fCenter[3] = { fStart[0] + (fEnd[0] - fStart[0]) * fT, fStart[1] + (fEnd[1] - fStart[1]) * fT, fStart[2] + (fEnd[2] - fStart[2]) * fT };
+					bSampleHit |= Test(MakeSphere(fCenter, tCapsule.m_fRadius), tOther);
+					bWideHit |= Test(MakeSphere(fCenter, tCapsule.m_fRadius + fHalfStep + 1e-4f), tOther);
+				}
+				nSampleMismatch += ((bSampleHit && !bHit) || (bHit && !bWideHit)) ? 1 : 0;
+			}
+		}
+
+		bool bCheck = nSwapMismatch == 0 && nShapeMismatch == 0 && nSampleMismatch == 0;
+		sprintf_s(szLine, "consistency %zu pairs  swap %d  aabb as obb / sphere as capsule %d  capsule vs sampled spheres %d  %s\n",
+			tPairVec.size(), nSwapMismatch, nShapeMismatch, nSampleMismatch, bCheck ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bCheck;
+	}
+
+	// 形状の組毎に、専用の判定と全てを包む箱(OBB)で判定する場合の速さと当たった数を比べる
+	std::vector<CollisionVolume> tObbVec(ce_nVolumeNum);
+	for (uint32_t i = 0; i < ce_nVolumeNum; i++) tObbVec[i] = ToObb(tVolumeVec[i]);
+
+	// 他の処理に割り込まれた回を除くため、繰り返した中で一番速い回の時間を使う
+	auto Measure = [&](const std::vector<CollisionVolume>& inVolumeVec, const std::vector<std::pair<uint32_t, uint32_t>>& inPairVec, int& outHitNum)
+		{
+			double dBestMs = 1e30;
+			for (int r = 0; r < ce_nRepeatNum; r++)
+			{
+				int nHitNum = 0;
+				auto tStart = std::chrono::high_resolution_clock::now();
+				for (const auto& tPair : inPairVec) nHitNum += Test(inVolumeVec[tPair.first], inVolumeVec[tPair.second]) ? 1 : 0;
+				dBestMs = (std::min)(dBestMs, std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count());
+				outHitNum = nHitNum;
+			}
+			return inPairVec.empty() ? 0.0 : dBestMs * 1e6 / static_cast<double>(inPairVec.size());
+		};
+
+	sprintf_s(szLine, "%-16s %7s  %9s %6s  %9s %6s  %s\n", "pair", "count", "ns/pair", "hit", "obb ns", "hit", "speedup");
+	tReport << szLine;
+	for (uint32_t nShapeA = 0; nShapeA < ce_nShapeNum - 1; nShapeA++)
+	{
+		for (uint32_t nShapeB = nShapeA; nShapeB < ce_nShapeNum - 1; nShapeB++)
+		{
+			std::vector<std::pair<uint32_t, uint32_t>> tKindVec;
+			for (const auto& tPair : tPairVec)
+			{
+				uint32_t nA = static_cast<uint32_t>(tVolumeVec[tPair.first].m_eShape);
+				uint32_t nB = static_cast<uint32_t>(tVolumeVec[tPair.second].m_eShape);
+				if ((nA == nShapeA && nB == nShapeB) || (nA == nShapeB && nB == nShapeA)) tKindVec.push_back(tPair);
+			}
+			int nHit = 0, nObbHit = 0;
+			double dNs = Measure(tVolumeVec, tKindVec, nHit);
+			double dObbNs = Measure(tObbVec, tKindVec, nObbHit);
+			char szName[32];
+			sprintf_s(szName, "%s-%s", pShapeName[nShapeA], pShapeName[nShapeB]);
+			sprintf_s(szLine, "%-16s %7zu  %9.1f %6d  %9.1f %6d  x%.2f\n", szName, tKindVec.size(), dNs, nHit, dObbNs, nObbHit, dNs > 0.0 ? dObbNs / dNs : 0.0);
+			tReport << szLine;
+
+			// 包む箱は形状を含むため、専用の判定で当たる組は必ず箱でも当たる
+			if (nObbHit < nHit) bSuccess = false;
+		}
+	}
+
+	int nHit = 0, nObbHit = 0;
+	double dNs = Measure(tVolumeVec, tPairVec, nHit);
+	double dObbNs = Measure(tObbVec, tPairVec, nObbHit);
+	sprintf_s(szLine, "%-16s %7zu  %9.1f %6d  %9.1f %6d  x%.2f  (all-obb extra hits %d)\n", "total", tPairVec.size(), dNs, nHit, dObbNs, nObbHit,
+		dNs > 0.0 ? dObbNs / dNs : 0.0, nObbHit - nHit);
+	tReport << szLine;
+
+	return bSuccess ? 0 : 1;
+}
+
+/****************************************//*
+	@brief　	| すり抜けが起きる決まった配置と乱数の配置で掃引の判定を確かめ、毎フレームの負荷を計測して書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CCollisionDispatch::SweepBenchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr int ce_nRandomCaseNum = 4000;
+	static constexpr int ce_nSubStepNum = 1024;
+	static constexpr float ce_fTimeTolerance = 1e-3f;
+	static constexpr float ce_fInflate = 2e-3f;
+	static constexpr int ce_nRepeatNum = 64;
+	char szLine[256];
+	bool bSuccess = true;
+	const char* pShapeName[ce_nShapeNum] = { "sphere", "capsule", "aabb", "obb", "none" };
+	const float fZero[3] = { 0.0f, 0.0f, 0.0f };
+
+	// 形状を動かした位置に置く
+	auto Moved = [](const CollisionVolume& inVolume, const float* inMove, float inTime)
+		{
+			CollisionVolume tVolume = inVolume;
+			for (int k = 0; k < 3; k++) tVolume.m_fCenter[k] += inMove[k] * inTime;
+			return tVolume;
+		};
+
+	// 決まった配置(動いた後の位置では重ならないのに、移動中に薄い壁や相手を通り過ぎる)
+	{
+		const float fWallHalf[3] = { 0.05f, 2.0f, 2.0f };
+		const float fYaw45[3] = { 0.0f, 0.78539816f, 0.0f };
+		const float fYaw30[3] = { 0.0f, 0.52359878f, 0.0f };
+		auto Pos = [](float inX, float inY, float inZ) { return std::vector<float>{ inX, inY, inZ }; };
+		const CollisionVolume tWall = MakeObb(Pos(5.0f, 0.0f, 0.0f).data(), fWallHalf, fZero);
+
+		tReport << "case                        discrete  sweep  time     expect   result\n";
+		auto Case = [&](const char* inName, const CollisionVolume& inA, const std::vector<float>& inMoveA, const CollisionVolume& inB, const std::vector<float>& inMoveB, bool isHit, float inTime)
+			{
+				float fTime = -1.0f;
+				const bool bDiscrete = Test(inA, inB);
+				const bool bSweep = Sweep(inA, inMoveA.data(), inB, inMoveB.data(), fTime);
+				const bool bCheck = bSweep == isHit && (!isHit || fabsf(fTime - inTime) <= ce_fTimeTolerance);
+				sprintf_s(szLine, "%-26s  %-8s  %-5s  %7.4f  %7.4f  %s\n", inName, bDiscrete ? "hit" : "miss", bSweep ? "hit" : "miss",
+					bSweep ? fTime : 0.0f, isHit ? inTime : 0.0f, bCheck ? "ok" : "FAILED");
+				tReport << szLine;
+				bSuccess &= bCheck;
+			};
+
+		// 薄い壁を1フレームで通り過ぎる球・箱・カプセル
+		Case("sphere thin wall", MakeSphere(Pos(10.0f, 0.0f, 0.0f).data(), 0.25f), Pos(10.0f, 0.0f, 0.0f), tWall, Pos(0.0f, 0.0f, 0.0f), true, 0.47f);
+		Case("sphere yawed wall", MakeSphere(Pos(10.0f, 0.0f, 0.0f).data(), 0.25f), Pos(10.0f, 0.0f, 0.0f),
+			MakeObb(Pos(5.0f, 0.0f, 0.0f).data(), fWallHalf, fYaw45), Pos(0.0f, 0.0f, 0.0f), true, 0.457574f);
+		Case("sphere beside wall", MakeSphere(Pos(10.0f, 0.0f, 2.4f).data(), 0.25f), Pos(10.0f, 0.0f, 0.0f), tWall, Pos(0.0f, 0.0f, 0.0f), false, 0.0f);
+		Case("sphere grazes wall edge", MakeSphere(Pos(10.0f, 0.0f, 2.24f).data(), 0.25f), Pos(10.0f, 0.0f, 0.0f), tWall, Pos(0.0f, 0.0f, 0.0f), true, 0.488f);
+		Case("aabb thin wall", MakeAabb(Pos(10.0f, 0.0f, 0.0f).data(), Pos(0.2f, 0.2f, 0.2f).data()), Pos(10.0f, 0.0f, 0.0f), tWall, Pos(0.0f, 0.0f, 0.0f), true, 0.475f);
+		Case("yawed obb dash", MakeObb(Pos(10.0f, 0.0f, 0.0f).data(), Pos(0.5f, 1.0f, 0.5f).data(), fYaw30), Pos(10.0f, 0.0f, 0.0f),
+			tWall, Pos(0.0f, 0.0f, 0.0f), true, 0.426699f);
+		Case("capsule dash", MakeCapsule(Pos(8.0f, 0.0f, 0.0f).data(), 0.3f, 0.6f, fZero), Pos(8.0f, 0.0f, 0.0f),
+			MakeObb(Pos(4.0f, 0.0f, 0.0f).data(), fWallHalf, fZero), Pos(0.0f, 0.0f, 0.0f), true, 0.45625f);
+		Case("wall as obb vs sphere", tWall, Pos(0.0f, 0.0f, 0.0f), MakeSphere(Pos(10.0f, 0.0f, 0.0f).data(), 0.25f), Pos(10.0f, 0.0f, 0.0f), true, 0.47f);
+		// 両方が動く(相対的な移動で触れる時間が決まる)
+		Case("sphere vs moving wall", MakeSphere(Pos(6.0f, 0.0f, 0.0f).data(), 0.25f), Pos(10.0f, 0.0f, 0.0f),
+			MakeObb(Pos(3.0f, 0.0f, 0.0f).data(), fWallHalf, fZero), Pos(-2.0f, 0.0f, 0.0f), true, 0.725f);
+		Case("thin boxes crossing", MakeObb(Pos(3.0f, 0.0f, 0.0f).data(), Pos(0.05f, 1.0f, 1.0f).data(), fZero), Pos(6.0f, 0.0f, 0.0f),
+			MakeObb(Pos(-3.0f, 0.0f, 0.0f).data(), Pos(0.05f, 1.0f, 1.0f).data(), fYaw45), Pos(-6.0f, 0.0f, 0.0f), true, 0.433958f);
+		Case("spheres crossing", MakeSphere(Pos(3.0f, 0.0f, 0.0f).data(), 0.2f), Pos(6.0f, 0.0f, 0.0f),
+			MakeSphere(Pos(-3.0f, 0.0f, 0.0f).data(), 0.2f), Pos(-6.0f, 0.0f, 0.0f), true, 0.466667f);
+		// 壁に沿って動く、動く前から重なっている、動かない
+		Case("sphere along wall", MakeSphere(Pos(4.5f, 0.0f, 5.0f).data(), 0.25f), Pos(0.0f, 0.0f, 10.0f), tWall, Pos(0.0f, 0.0f, 0.0f), false, 0.0f);
+		Case("start overlapping", MakeSphere(Pos(5.5f, 0.0f, 0.0f).data(), 0.25f), Pos(0.5f, 0.0f, 0.0f), tWall, Pos(0.0f, 0.0f, 0.0f), true, 0.0f);
+		Case("no motion touching", MakeSphere(Pos(4.75f, 0.0f, 0.0f).data(), 0.25f), Pos(0.0f, 0.0f, 0.0f), tWall, Pos(0.0f, 0.0f, 0.0f), true, 0.0f);
+		Case("no motion apart", MakeSphere(Pos(4.5f, 0.0f, 0.0f).data(), 0.25f), Pos(0.0f, 0.0f, 0.0f), tWall, Pos(0.0f, 0.0f, 0.0f), false, 0.0f);
+	}
+
+	// 乱数の配置で、細かく刻んで判定した結果とすり抜けが無いことを比べる
+	{
+		std::mt19937 tRandom(48);
+		std::uniform_real_distribution<float> tPos(-3.0f, 3.0f);
+		std::uniform_real_distribution<float> tMove(-8.0f, 8.0f);
+		std::uniform_real_distribution<float> tSize(0.05f, 1.0f);
+		std::uniform_real_distribution<float> tAngle(-3.14159265f, 3.14159265f);
+		auto Random = [&](CollisionShape inShape)
+			{
+				const float fCenter[3] = { tPos(tRandom), tPos(tRandom), tPos(tRandom) };
+				const float fRotate[3] = { tAngle(tRandom), tAngle(tRandom), tAngle(tRandom) };
+				// 箱は1軸を薄くして壁にする
+				float fHalf[3] = { tSize(tRandom), tSize(tRandom), tSize(tRandom) };
+				fHalf[tRandom() % 3] = 0.05f;
+				switch (inShape)
+				{
+				case CollisionShape::Sphere: return MakeSphere(fCenter, fHalf[0] * 0.5f);
+				case CollisionShape::Capsule: return MakeCapsule(fCenter, fHalf[0] * 0.5f, fHalf[1], fRotate);
+				case CollisionShape::Aabb: return MakeAabb(fCenter, fHalf);
+				default: return MakeObb(fCenter, fHalf, fRotate);
+				}
+			};
+		auto Inflate = [](CollisionVolume inVolume)
+			{
+				for (int k = 0; k < 3; k++) inVolume.m_fHalfSize[k] += ce_fInflate;
+				inVolume.m_fRadius += (inVolume.m_eShape == CollisionShape::Sphere || inVolume.m_eShape == CollisionShape::Capsule) ? ce_fInflate : 0.0f;
+				return inVolume;
+			};
+
+		int nCaseNum[4][4] = {}, nTunnelNum[4][4] = {}, nMissNum[4][4] = {}, nFalseNum[4][4] = {};
+		double dTestNs[4][4] = {}, dSweepNs[4][4] = {};
+		long long nRepeatHitNum = 0;
+		for (int nCase = 0; nCase < ce_nRandomCaseNum; nCase++)
+		{
+			const uint32_t a = nCase % 4, b = (nCase / 4) % 4;
+			const CollisionVolume tA = Random(static_cast<CollisionShape>(a));
+			const CollisionVolume tB = Random(static_cast<CollisionShape>(b));
+			const float fMoveA[3] = { tMove(tRandom), tMove(tRandom) * 0.25f, tMove(tRandom) };
+			const float fMoveB[3] = { tMove(tRandom) * 0.25f, 0.0f, tMove(tRandom) * 0.25f };
+			float fRelative[3];
+			for (int k = 0; k < 3; k++) fRelative[k] = fMoveA[k] - fMoveB[k];
+
+			// tA・tBは動いた後の位置として渡し、刻む判定は動く前から進める
+			const CollisionVolume tStartA = Moved(tA, fMoveA, -1.0f), tStartB = Moved(tB, fMoveB, -1.0f);
+			int nFirstStep = -1;
+			for (int nStep = 0; nStep <= ce_nSubStepNum && nFirstStep < 0; nStep++)
+			{
+				if (Test(Moved(tStartA, fRelative, static_cast<float>(nStep) / ce_nSubStepNum), tStartB)) nFirstStep = nStep;
+			}
+
+			float fTime = -1.0f;
+			const bool bSweep = Sweep(tA, fMoveA, tB, fMoveB, fTime);
+			nCaseNum[a][b]++;
+			if (nFirstStep > 0 && !Test(tA, tB)) nTunnelNum[a][b]++;
+
+			// 刻んで触れたならすり抜けずに同じか早い時間で触れ、掃引で触れた時間には本当に触れている
+			if (nFirstStep >= 0 && (!bSweep || fTime > static_cast<float>(nFirstStep) / ce_nSubStepNum + 1e-4f)) nMissNum[a][b]++;
+			if (bSweep && !Test(Inflate(Moved(tStartA, fRelative, fTime)), Inflate(tStartB))) nFalseNum[a][b]++;
+
+			// 1組の時間は短いので繰り返して測る
+			auto tStart = std::chrono::high_resolution_clock::now();
+			for (int r = 0; r < ce_nRepeatNum; r++) nRepeatHitNum += Test(tA, tB) ? 1 : 0;
+			auto tMid = std::chrono::high_resolution_clock::now();
+			for (int r = 0; r < ce_nRepeatNum; r++) nRepeatHitNum += Sweep(tA, fMoveA, tB, fMoveB, fTime) ? 1 : 0;
+			auto tEnd = std::chrono::high_resolution_clock::now();
+			dTestNs[a][b] += std::chrono::duration<double, std::nano>(tMid - tStart).count() / ce_nRepeatNum;
+			dSweepNs[a][b] += std::chrono::duration<double, std::nano>(tEnd - tMid).count() / ce_nRepeatNum;
+		}
+
+		tReport << "\npair             cases  tunnel  missed  false   test ns  sweep ns\n";
+		for (uint32_t a = 0; a < 4; a++)
+		{
+			for (uint32_t b = 0; b < 4; b++)
+			{
+				char szPair[32];
+				sprintf_s(szPair, "%s-%s", pShapeName[a], pShapeName[b]);
+				sprintf_s(szLine, "%-15s  %5d  %6d  %6d  %5d  %8.1f  %8.1f\n", szPair, nCaseNum[a][b], nTunnelNum[a][b], nMissNum[a][b], nFalseNum[a][b],
+					dTestNs[a][b] / nCaseNum[a][b], dSweepNs[a][b] / nCaseNum[a][b]);
+				tReport << szLine;
+				bSuccess &= nMissNum[a][b] == 0 && nFalseNum[a][b] == 0;
+			}
+		}
+		sprintf_s(szLine, "timed hits %lld (test and sweep, %d repeats)\n", nRepeatHitNum, ce_nRepeatNum);
+		tReport << szLine;
+	}
+
+	// 薄い壁の間を動く物のうち、一部だけを高速として掃引し、すり抜けの数と毎フレームの負荷を比べる
+	{
+		static constexpr uint32_t ce_nWallNum = 300;
+		static constexpr uint32_t ce_nMoverNum = 3000;
+		static constexpr uint32_t ce_nFastInterval = 20;
+		static constexpr int ce_nFrameNum = 120;
+		static constexpr int ce_nTruthStepNum = 32;
+		static constexpr float ce_fMapSize = 120.0f;
+		static constexpr float ce_fSlowSpeed = 0.05f;
+		static constexpr float ce_fFastSpeed = 1.5f;
+		static constexpr float ce_fMoverRadius = 0.3f;
+
+		std::mt19937 tRandom(480);
+		std::uniform_real_distribution<float> tPos(0.0f, ce_fMapSize);
+		std::uniform_real_distribution<float> tAngle(-3.14159265f, 3.14159265f);
+		const float fWallHalf[3] = { 0.05f, 1.0f, 2.5f };
+
+		CSpatialQuery tDiscreteQuery, tSweptQuery;
+		std::vector<CollisionVolume> tVolumeVec;
+		std::vector<std::vector<float>> tVelocityVec;
+		auto BoxOf = [](const CollisionVolume& inVolume)
+			{
+				SpatialBox tBox;
+				for (int k = 0; k < 3; k++)
+				{
+					tBox.m_fCenter[k] = inVolume.m_fCenter[k];
+					tBox.m_fHalfSize[k] = inVolume.m_fHalfSize[k];
+					for (int j = 0; j < 3; j++) tBox.m_fAxis[k][j] = inVolume.m_fAxis[k][j];
+				}
+				return tBox;
+			};
+		auto IsFast = [](uint32_t inIndex) { return inIndex >= ce_nWallNum && (inIndex - ce_nWallNum) % ce_nFastInterval == 0; };
+
+		// 壁(動かない)を先に、動く物を後に登録して、登録時の番号を配列の番号と揃える
+		for (uint32_t i = 0; i < ce_nWallNum + ce_nMoverNum; i++)
+		{
+			const bool bWall = i < ce_nWallNum;
+			const float fCenter[3] = { tPos(tRandom), 0.0f, tPos(tRandom) };
+			const float fRotate[3] = { 0.0f, tAngle(tRandom), 0.0f };
+			const float fHeading = tAngle(tRandom);
+			const float fSpeed = bWall ? 0.0f : IsFast(i) ? ce_fFastSpeed : ce_fSlowSpeed;
+			tVolumeVec.push_back(bWall ? MakeObb(fCenter, fWallHalf, fRotate) : MakeSphere(fCenter, ce_fMoverRadius));
+			tVelocityVec.push_back({ cosf(fHeading) * fSpeed, 0.0f, sinf(fHeading) * fSpeed });
+			tDiscreteQuery.Add(BoxOf(tVolumeVec[i]), CSpatialQuery::ce_nAllTag, nullptr, bWall);
+			tSweptQuery.Add(BoxOf(tVolumeVec[i]), CSpatialQuery::ce_nAllTag, nullptr, bWall);
+		}
+		tDiscreteQuery.Update();
+		tSweptQuery.Update();
+
+		std::vector<SpatialPair> tPairVec;
+		std::vector<uint64_t> tDiscreteHitVec, tSweptHitVec, tTruthHitVec;
+		long long nDiscretePairNum = 0, nSweptPairNum = 0, nSweepNum = 0, nTruthNum = 0, nDiscreteMissNum = 0, nSweptMissNum = 0, nExtraNum = 0;
+		double dDiscreteFindMs = 0.0, dSweptFindMs = 0.0, dDiscreteNarrowMs = 0.0, dSweptNarrowMs = 0.0;
+		auto Key = [](uint32_t inA, uint32_t inB) { return (static_cast<uint64_t>((std::min)(inA, inB)) << 32) | (std::max)(inA, inB); };
+		auto IsFastWall = [&](const SpatialPair& inPair) { return inPair.m_nIndexA < ce_nWallNum && IsFast(inPair.m_nIndexB); };
+
+		for (int nFrame = 0; nFrame < ce_nFrameNum; nFrame++)
+		{
+			// 動かして端で跳ね返す(瞬間移動させると掃引が端から端まで伸びるため)
+			for (uint32_t i = ce_nWallNum; i < tVolumeVec.size(); i++)
+			{
+				CollisionVolume& tVolume = tVolumeVec[i];
+				std::vector<float>& tVelocity = tVelocityVec[i];
+				for (int k = 0; k < 3; k += 2)
+				{
+					if (tVolume.m_fCenter[k] + tVelocity[k] < 0.0f || tVolume.m_fCenter[k] + tVelocity[k] > ce_fMapSize) tVelocity[k] = -tVelocity[k];
+					tVolume.m_fCenter[k] += tVelocity[k];
+				}
+				tDiscreteQuery.Move(i, BoxOf(tVolume));
+				tSweptQuery.Move(i, BoxOf(tVolume), IsFast(i) ? tVelocity.data() : nullptr);
+			}
+
+			// 今の位置だけで判定する
+			tDiscreteHitVec.clear();
+			auto tStart = std::chrono::high_resolution_clock::now();
+			tDiscreteQuery.FindPairs(tPairVec);
+			auto tFind = std::chrono::high_resolution_clock::now();
+			for (const SpatialPair& tPair : tPairVec)
+			{
+				if (Test(tVolumeVec[tPair.m_nIndexA], tVolumeVec[tPair.m_nIndexB]) && IsFastWall(tPair)) tDiscreteHitVec.push_back(Key(tPair.m_nIndexA, tPair.m_nIndexB));
+			}
+			auto tEnd = std::chrono::high_resolution_clock::now();
+			nDiscretePairNum += static_cast<long long>(tPairVec.size());
+			dDiscreteFindMs += std::chrono::duration<double, std::milli>(tFind - tStart).count();
+			dDiscreteNarrowMs += std::chrono::duration<double, std::milli>(tEnd - tFind).count();
+
+			// 高速な物を含む組だけを掃引する
+			tSweptHitVec.clear();
+			tStart = std::chrono::high_resolution_clock::now();
+			tSweptQuery.FindPairs(tPairVec);
+			tFind = std::chrono::high_resolution_clock::now();
+			for (const SpatialPair& tPair : tPairVec)
+			{
+				const uint32_t a = tPair.m_nIndexA, b = tPair.m_nIndexB;
+				bool bHit;
+				if (IsFast(a) || IsFast(b))
+				{
+					float fTime;
+					bHit = Sweep(tVolumeVec[a], tVelocityVec[a].data(), tVolumeVec[b], tVelocityVec[b].data(), fTime);
+					nSweepNum++;
+				}
+				else bHit = Test(tVolumeVec[a], tVolumeVec[b]);
+				if (bHit && IsFastWall(tPair)) tSweptHitVec.push_back(Key(a, b));
+			}
+			tEnd = std::chrono::high_resolution_clock::now();
+			nSweptPairNum += static_cast<long long>(tPairVec.size());
+			dSweptFindMs += std::chrono::duration<double, std::milli>(tFind - tStart).count();
+			dSweptNarrowMs += std::chrono::duration<double, std::milli>(tEnd - tFind).count();
+
+			// 正解は高速な物を細かく刻んで全ての壁と判定する
+			tTruthHitVec.clear();
+			for (uint32_t i = ce_nWallNum; i < tVolumeVec.size(); i++)
+			{
+				if (!IsFast(i)) continue;
+				for (uint32_t w = 0; w < ce_nWallNum; w++)
+				{
+					for (int nStep = 0; nStep <= ce_nTruthStepNum; nStep++)
+					{
+						if (!Test(Moved(tVolumeVec[i], tVelocityVec[i].data(), static_cast<float>(nStep) / ce_nTruthStepNum - 1.0f), tVolumeVec[w])) continue;
+						tTruthHitVec.push_back(Key(w, i));
+						break;
+					}
+				}
+			}
+
+			std::sort(tDiscreteHitVec.begin(), tDiscreteHitVec.end());
+			std::sort(tSweptHitVec.begin(), tSweptHitVec.end());
+			std::sort(tTruthHitVec.begin(), tTruthHitVec.end());
+			nTruthNum += static_cast<long long>(tTruthHitVec.size());
+			for (uint64_t nKey : tTruthHitVec)
+			{
+				nDiscreteMissNum += std::binary_search(tDiscreteHitVec.begin(), tDiscreteHitVec.end(), nKey) ? 0 : 1;
+				nSweptMissNum += std::binary_search(tSweptHitVec.begin(), tSweptHitVec.end(), nKey) ? 0 : 1;
+			}
+			for (uint64_t nKey : tSweptHitVec) nExtraNum += std::binary_search(tTruthHitVec.begin(), tTruthHitVec.end(), nKey) ? 0 : 1;
+
+			tDiscreteQuery.Update();
+			tSweptQuery.Update();
+		}
+
+		sprintf_s(szLine, "\nwalls %u  movers %u (fast %u at %.1f/frame)  frames %d\n", ce_nWallNum, ce_nMoverNum, ce_nMoverNum / ce_nFastInterval, ce_fFastSpeed, ce_nFrameNum);
+		tReport << szLine;
+		tReport << "mode      pairs/f  sweeps/f  find ms  narrow ms  fast-wall hits  tunneled\n";
+		sprintf_s(szLine, "discrete  %7lld  %8d  %7.3f  %9.3f  %14lld  %8lld\n", nDiscretePairNum / ce_nFrameNum, 0,
+			dDiscreteFindMs / ce_nFrameNum, dDiscreteNarrowMs / ce_nFrameNum, nTruthNum - nDiscreteMissNum, nDiscreteMissNum);
+		tReport << szLine;
+		sprintf_s(szLine, "swept     %7lld  %8lld  %7.3f  %9.3f  %14lld  %8lld\n", nSweptPairNum / ce_nFrameNum, nSweepNum / ce_nFrameNum,
+			dSweptFindMs / ce_nFrameNum, dSweptNarrowMs / ce_nFrameNum, nTruthNum - nSweptMissNum, nSweptMissNum);
+		tReport << szLine;
+		sprintf_s(szLine, "truth (%d sub-steps) hits %lld  swept hits between sub-steps %lld\n", ce_nTruthStepNum, nTruthNum, nExtraNum);
+		tReport << szLine;
+		bSuccess &= nSweptMissNum == 0;
+	}
+
+	return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+/**************************************************//*
+	@file	| CollisionDispatch.h
+	@brief	| 当たり判定の形状の組毎の判定関数の表のhファイル
+	@note	| 当たり判定は位置と向きを反映した形状(CollisionVolume)に変換してから、
+			| 形状の組で引く関数の表で専用の判定を呼ぶ(dynamic_castを使わない)
+			| 形状は全て、向きを持った箱(全形状を包む箱)の情報も持つ
+			| 高速に動く形状は、移動を掃引して最初に触れる時間を求める関数の表も引ける
+*//**************************************************/
+#pragma once
+#include <cstdint>
+
+// @brief 当たり判定の形状
+enum class CollisionShape : uint32_t
+{
+	// 球
+	Sphere,
+
+	// カプセル(ローカルY軸に沿った線分を半径で膨らませた形)
+	Capsule,
+
+	// 軸に沿った箱(向きを持たない)
+	Aabb,
+
+	// 向きを持った箱
+	Obb,
+
+	// 形状の数(判定を行わない)
+	Max,
+};
+
+// @brief 位置と向きを反映した当たり判定の形状
+struct CollisionVolume
+{
+	// 形状
+	CollisionShape m_eShape;
+
+	// 中心(XYZ)
+	float m_fCenter[3];
+
+	// 形状を包む箱の大きさの半分(ローカル軸毎)
+	float m_fHalfSize[3];
+
+	// ローカル軸(正規化済み、[軸][XYZ]、AABBと球はワールドの軸)
+	float m_fAxis[3][3];
+
+	// 半径(球・カプセルのみ)
+	float m_fRadius;
+
+	// 線分の長さの半分(カプセルのみ、線分はローカルY軸に沿う)
+	float m_fHalfHeight;
+};
+
+// @brief 当たり判定の形状の組毎の判定関数の表
+class CCollisionDispatch
+{
+public:
+	// @brief 判定関数
+	// @param inA：形状A
+	// @param inB：形状B
+	// @return true:重なっている false:離れている
+	using TestFunc = bool(*)(const CollisionVolume& inA, const CollisionVolume& inB);
+
+	// @brief 掃引の判定関数
+	// @param inA：動く前の形状A
+	// @param inB：動く前の形状B
+	// @param inMove：形状Bから見た形状Aの移動量(XYZ)
+	// @param outTime：最初に触れる時間(0:動く前 1:動いた後)
+	// @return true:触れる false:触れない
+	using SweepFunc = bool(*)(const CollisionVolume& inA, const CollisionVolume& inB, const float* inMove, float& outTime);
+
+public:
+	// @brief 2つの形状が重なっているか調べる
+	// @param inA：形状A
+	// @param inB：形状B
+	// @return true:重なっている false:離れている(どちらかがMaxなら常にfalse)
+	static bool Test(const CollisionVolume& inA, const CollisionVolume& inB);
+
+	// @brief 形状の組の判定関数の取得
+	// @param inA：形状Aの種類
+	// @param inB：形状Bの種類
+	// @return 判定関数
+	static TestFunc GetTestFunc(CollisionShape inA, CollisionShape inB);
+
+	// @brief 動く2つの形状が移動中に最初に触れる時間を求める
+	// @param inA：動いた後の形状A
+	// @param inMoveA：形状Aの移動量(XYZ)
+	// @param inB：動いた後の形状B
+	// @param inMoveB：形状Bの移動量(XYZ)
+	// @param outTime：最初に触れる時間(0:動く前 1:動いた後)
+	// @return true:触れる false:触れない(どちらかがMaxなら常にfalse)
+	// @note 向きは動いた後のまま平行移動したとみなす
+	//       球・カプセルを含む組は距離で安全に進める方法、箱同士は分離軸毎に重なる時間の区間を求める
+	static bool Sweep(const CollisionVolume& inA, const float* inMoveA, const CollisionVolume& inB, const float* inMoveB, float& outTime);
+
+	// @brief 球の形状を作る
+	// @param inCenter：中心(XYZ)
+	// @param inRadius：半径
+	static CollisionVolume MakeSphere(const float* inCenter, float inRadius);
+
+	// @brief カプセルの形状を作る
+	// @param inCenter：中心(XYZ)
+	// @param inRadius：半径
+	// @param inHalfHeight：線分の長さの半分
+	// @param inRotate：回転(ピッチ・ヨー・ロール)
+	static CollisionVolume MakeCapsule(const float* inCenter, float inRadius, float inHalfHeight, const float* inRotate);
+
+	// @brief 軸に沿った箱の形状を作る
+	// @param inCenter：中心(XYZ)
+	// @param inHalfSize：大きさの半分(XYZ)
+	static CollisionVolume MakeAabb(const float* inCenter, const float* inHalfSize);
+
+	// @brief 向きを持った箱の形状を作る
+	// @param inCenter：中心(XYZ)
+	// @param inHalfSize：大きさの半分(ローカル軸毎)
+	// @param inRotate：回転(ピッチ・ヨー・ロール)
+	static CollisionVolume MakeObb(const float* inCenter, const float* inHalfSize, const float* inRotate);
+
+	// @brief 形状を包む向きを持った箱の形状に変換する
+	// @param inVolume：形状
+	// @return 包む箱(OBB)
+	static CollisionVolume ToObb(const CollisionVolume& inVolume);
+
+	// @brief 形状の組毎の判定を確かめ、全てOBBで判定する場合と速さを比べて書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int Benchmark(const char* inReportPath);
+
+	// @brief すり抜けが起きる決まった配置と乱数の配置で掃引の判定を確かめ、毎フレームの負荷を計測して書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int SweepBenchmark(const char* inReportPath);
+};
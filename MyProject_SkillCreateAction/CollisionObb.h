@@ -27,10 +27,9 @@ public:
 	// @brief 描画処理
 	void Draw() override;
 
-	// @brief 衝突が起きたかどうかを取得
-	// @param other：衝突先
-	// @return true:衝突 false:非衝突
-	bool IsHit(CCollisionBase* other) override;
+	// @brief 位置と向きを反映した形状を作る
+	// @note 中心と大きさはワールド座標、向きはゲームオブジェクトの回転を使う
+	CollisionVolume MakeVolume() override;
 
 	// @brief コリジョン情報の中心座標
 	// @return (DirectX::XMFLOAT3)コリジョンの中心座標
@@ -0,0 +1,23 @@
+/**************************************************//*
+	@file	| CollisionSphere.cpp
+	@brief	| 球当たり判定クラス
+*//**************************************************/
+#include "CollisionSphere.h"
+#include "GameObject.h"
+#include "Geometory.h"
+
+// @brief 位置と向きを反映した形状を作る
+CollisionVolume CCollisionSphere::MakeVolume()
+{
+	const float fCenter[3] = { m_f3Center.x, m_f3Center.y, m_f3Center.z };
+	return CCollisionDispatch::MakeSphere(fCenter, m_fRadius);
+}
+
+// @brief 描画処理
+void CCollisionSphere::Draw()
+{
+	// コリジョンが有効でない時は描画を行わない
+	if (!m_bActive) return;
+
+	Geometory::AddSphere(m_f3Center, m_fRadius, DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f));
+}
@@ -0,0 +1,45 @@
+/**************************************************//*
+	@file	| CollisionSphere.h
+	@brief	| 球当たり判定クラス
+*//**************************************************/
+#pragma once
+#include "CollisionBase.h"
+#include <DirectXMath.h>
+
+// @brief 球当たり判定クラス
+class CCollisionSphere : public CCollisionBase
+{
+public:
+	// コンストラクタの継承
+	using CCollisionBase::CCollisionBase;
+
+	// @brief 描画処理
+	void Draw() override;
+
+	// @brief 位置と向きを反映した形状を作る
+	CollisionVolume MakeVolume() override;
+
+	// @brief コリジョンの中心座標を取得
+	// @return (DirectX::XMFLOAT3)コリジョンの中心座標
+	DirectX::XMFLOAT3 GetCenter() { return m_f3Center; }
+
+	// @brief コリジョンの中心座標をセット
+	// @param center：コリジョンの中心座標
+	void SetCenter(const DirectX::XMFLOAT3& center) { m_f3Center = center; }
+
+	// @brief コリジョンの半径を取得
+	// @return 半径
+	float GetRadius() { return m_fRadius; }
+
+	// @brief コリジョンの半径をセット
+	// @param inRadius：半径
+	void SetRadius(float inRadius) { m_fRadius = inRadius; }
+
+private:
+	// @brief 中心座標
+	DirectX::XMFLOAT3 m_f3Center = { 0.0f, 0.0f, 0.0f };
+
+	// @brief 半径
+	float m_fRadius = 0.5f;
+
+};
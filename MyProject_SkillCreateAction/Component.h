@@ -57,7 +57,7 @@ public:
 
 	// @brief ʗp^O̎擾
 	// @return ʗp^O
-	const std::string GetTag() { return m_sTag; }
+	const std::string& GetTag() const { return m_sTag; }
 
 protected:
 	// @brief RtĂQ[IuWFNg̃|C^
@@ -0,0 +1,107 @@
+/**************************************************//*
+	@file	| ConstantBufferRing.cpp
+	@brief	| 定数バッファのリング割り当てクラスのcppファイル
+	@note	| 描画毎の定数を1つの大きな定数バッファから切り出して書き込み、
+			| 先頭からの位置を指定して割り当てる(D3D11.1の機能を使う)
+			| 使えない環境ではシェーダー毎の定数バッファに書き込む
+*//**************************************************/
+#include "ConstantBufferRing.h"
+#include "DirectX.h"
+#include "Defines.h"
+#include <cstring>
+
+//--- 静的メンバ変数の実体定義
+CRingAllocator ConstantBufferRing::m_tAllocator;
+ID3D11Buffer* ConstantBufferRing::m_pBuffer = nullptr;
+ID3D11DeviceContext1* ConstantBufferRing::m_pContext1 = nullptr;
+bool ConstantBufferRing::m_bEnable = true;
+ConstantBufferStats ConstantBufferRing::m_tFrameStats = {};
+ConstantBufferStats ConstantBufferRing::m_tStats = {};
+
+/****************************************//*
+	@brief　	| 初期化
+	@note		| 位置を指定した割り当てができない環境では使用しない
+*//****************************************/
+void ConstantBufferRing::Init()
+{
+	// 位置を指定した定数バッファの設定と、定数バッファへの追記ができるか確認
+	D3D11_FEATURE_DATA_D3D11_OPTIONS tOptions = {};
+	if (FAILED(GetDevice()->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &tOptions, sizeof(tOptions)))) return;
+	if (!tOptions.ConstantBufferOffsetting || !tOptions.MapNoOverwriteOnDynamicConstantBuffer) return;
+	if (FAILED(GetContext()->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(&m_pContext1)))) return;
+
+	D3D11_BUFFER_DESC bufDesc = {};
+	bufDesc.ByteWidth = ce_nCapacity;
+	bufDesc.Usage = D3D11_USAGE_DYNAMIC;
+	bufDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	bufDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	if (FAILED(GetDevice()->CreateBuffer(&bufDesc, nullptr, &m_pBuffer)))
+	{
+		m_pBuffer = nullptr;
+		SAFE_RELEASE(m_pContext1);
+		return;
+	}
+
+	m_tAllocator.Reset(ce_nCapacity, ce_nAlignment);
+}
+
+/****************************************//*
+	@brief　	| 終了
+*//****************************************/
+void ConstantBufferRing::Uninit()
+{
+	SAFE_RELEASE(m_pBuffer);
+	SAFE_RELEASE(m_pContext1);
+}
+
+/****************************************//*
+	@brief　	| フレームの開始
+	@note		| 直前のフレームの統計情報を確定し、次の書き込みはバッファを破棄して先頭から行う
+*//****************************************/
+void ConstantBufferRing::BeginFrame()
+{
+	m_tStats = m_tFrameStats;
+	m_tStats.m_nWrapNum = m_tAllocator.GetStats().m_nWrapNum;
+	m_tFrameStats = {};
+	m_tAllocator.BeginFrame();
+}
+
+/****************************************//*
+	@brief　	| 定数を書き込む
+	@param　	| pData：書き込むデータ
+	@param　	| inSize：データのサイズ(バイト)
+	@param　	| outFirstConstant：書き込んだ位置(16バイト単位)
+	@param　	| outNumConstants：割り当てた大きさ(16バイト単位)
+	@return		| true:書き込めた false:書き込めなかった
+*//****************************************/
+bool ConstantBufferRing::Write(const void* pData, UINT inSize, UINT& outFirstConstant, UINT& outNumConstants)
+{
+	if (!IsEnable()) return false;
+
+	RingAllocation tAlloc = m_tAllocator.Allocate(inSize);
+	if (!tAlloc.m_bValid) return false;
+
+	// フレームの最初と先頭に戻った時は破棄、それ以外はGPUが使用中の領域に触れないので追記
+	D3D11_MAP eMap = tAlloc.m_bDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+	D3D11_MAPPED_SUBRESOURCE mapResource;
+	if (FAILED(GetContext()->Map(m_pBuffer, 0, eMap, 0, &mapResource))) return false;
+	memcpy(static_cast<char*>(mapResource.pData) + tAlloc.m_nOffset, pData, inSize);
+	GetContext()->Unmap(m_pBuffer, 0);
+
+	outFirstConstant = tAlloc.m_nOffset / 16;
+	outNumConstants = tAlloc.m_nSize / 16;
+
+	m_tFrameStats.m_nRingWriteNum++;
+	m_tFrameStats.m_nRingByte += tAlloc.m_nSize;
+	return true;
+}
+
+/****************************************//*
+	@brief　	| シェーダー毎の定数バッファに書き込んだことを記録する
+	@param　	| inSize：書き込んだバイト数
+*//****************************************/
+void ConstantBufferRing::CountUpdate(UINT inSize)
+{
+	m_tFrameStats.m_nUpdateNum++;
+	m_tFrameStats.m_nUpdateByte += inSize;
+}
@@ -0,0 +1,111 @@
+/**************************************************//*
+	@file	| ConstantBufferRing.h
+	@brief	| 定数バッファのリング割り当てクラスのhファイル
+	@note	| 描画毎の定数を1つの大きな定数バッファから切り出して書き込み、
+			| 先頭からの位置を指定して割り当てる(D3D11.1の機能を使う)
+			| 使えない環境ではシェーダー毎の定数バッファに書き込む
+*//**************************************************/
+#pragma once
+#include "RingAllocator.h"
+#include <d3d11_1.h>
+
+// @brief 定数バッファの書き込みの統計情報
+struct ConstantBufferStats
+{
+	// リングに書き込んだ回数
+	int m_nRingWriteNum;
+
+	// リングに書き込んだバイト数
+	UINT m_nRingByte;
+
+	// リングの末尾に入らず先頭に戻った回数
+	int m_nWrapNum;
+
+	// シェーダー毎の定数バッファに書き込んだ回数(UpdateSubresource)
+	int m_nUpdateNum;
+
+	// シェーダー毎の定数バッファに書き込んだバイト数
+	UINT m_nUpdateByte;
+};
+
+// @brief 定数バッファのリング割り当てクラス
+class ConstantBufferRing
+{
+public:
+	// @brief 初期化
+	// @note 位置を指定した割り当てができない環境では使用しない
+	static void Init();
+
+	// @brief 終了
+	static void Uninit();
+
+	// @brief フレームの開始
+	// @note 直前のフレームの統計情報を確定し、次の書き込みはバッファを破棄して先頭から行う
+	static void BeginFrame();
+
+	// @brief 定数を書き込む
+	// @param pData：書き込むデータ
+	// @param inSize：データのサイズ(バイト)
+	// @param outFirstConstant：書き込んだ位置(16バイト単位)
+	// @param outNumConstants：割り当てた大きさ(16バイト単位)
+	// @return true:書き込めた false:書き込めなかった
+	static bool Write(const void* pData, UINT inSize, UINT& outFirstConstant, UINT& outNumConstants);
+
+	// @brief シェーダー毎の定数バッファに書き込んだことを記録する
+	// @param inSize：書き込んだバイト数
+	static void CountUpdate(UINT inSize);
+
+	// @brief 使用するかどうかの設定
+	// @param isEnable：true:使用する false:シェーダー毎の定数バッファを使う
+	static void SetEnable(bool isEnable) { m_bEnable = isEnable; }
+
+	// @brief 使用できるかどうか
+	// @return true:使用できる false:使用しない、または使用できない環境
+	static bool IsEnable() { return m_bEnable && m_pBuffer != nullptr; }
+
+	// @brief 使用できる環境かどうか
+	// @return true:使用できる false:使用できない
+	static bool IsSupported() { return m_pBuffer != nullptr; }
+
+	// @brief リングの世代の取得
+	// @return バッファを破棄して書き込む度に増える番号(書き込んだ内容はこの番号の間だけ有効)
+	// @note フレームの最初だけでなく、フレームの途中で先頭に戻った時も増える
+	static UINT GetGeneration() { return m_tAllocator.GetGeneration(); }
+
+	// @brief リングの定数バッファの取得
+	// @return 定数バッファ
+	static ID3D11Buffer* GetBuffer() { return m_pBuffer; }
+
+	// @brief 位置を指定して定数バッファを設定できるコンテキストの取得
+	// @return コンテキスト
+	static ID3D11DeviceContext1* GetContext1() { return m_pContext1; }
+
+	// @brief 直前のフレームの統計情報の取得
+	// @return 統計情報
+	static const ConstantBufferStats& GetStats() { return m_tStats; }
+
+private:
+	// @brief リングのサイズ(バイト)
+	static constexpr UINT ce_nCapacity = 4 * 1024 * 1024;
+
+	// @brief 割り当ての境界(D3D11.1では16定数 = 256バイト単位で位置を指定する)
+	static constexpr UINT ce_nAlignment = 256;
+
+	// @brief 割り当て位置の計算
+	static CRingAllocator m_tAllocator;
+
+	// @brief リングの定数バッファ
+	static ID3D11Buffer* m_pBuffer;
+
+	// @brief 位置を指定して定数バッファを設定できるコンテキスト
+	static ID3D11DeviceContext1* m_pContext1;
+
+	// @brief 使用するかどうか
+	static bool m_bEnable;
+
+	// @brief 現在のフレームの統計情報
+	static ConstantBufferStats m_tFrameStats;
+
+	// @brief 直前のフレームの統計情報
+	static ConstantBufferStats m_tStats;
+};
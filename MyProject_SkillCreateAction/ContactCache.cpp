@@ -0,0 +1,382 @@
+/**************************************************//*
+	@file	| ContactCache.cpp
+	@brief	| 接触している当たり判定の組を覚えておくクラスのcppファイル
+	@note	| 空間検索の登録時の番号の組をキーにしたハッシュ表で、前のフレームから触れている組を覚えておき、
+			| 触れ始め(Enter)、触れ続け(Stay)、離れた(Exit)を区別する
+			| 組は詰めた配列に持ち、ハッシュ表は配列の番号を引くための開番地法の表にする
+			| 配列と表は使い回し、組の数が増えた時以外はメモリを確保しない
+*//**************************************************/
+#include "ContactCache.h"
+#include "CollisionBase.h"
+#include "CollisionDispatch.h"
+#include "SpatialQuery.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <set>
+
+namespace
+{
+	// @brief 2つの登録時の番号からキーを作る
+	// @param inIndexA：小さい方の番号
+	// @param inIndexB：大きい方の番号
+	uint64_t MakeKey(uint32_t inIndexA, uint32_t inIndexB)
+	{
+		return (static_cast<uint64_t>(inIndexA) << 32) | inIndexB;
+	}
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CContactCache::CContactCache()
+	: m_nFrame(0)
+	, m_tCount{}
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CContactCache::~CContactCache()
+{
+}
+
+/****************************************//*
+	@brief　	| 重なっている組を記録する
+	@param　	| inIndexA：当たり判定Aの登録時の番号
+	@param　	| inIndexB：当たり判定Bの登録時の番号
+	@param　	| inCollisionA：当たり判定A
+	@param　	| inCollisionB：当たり判定B
+	@return		| true:触れ始めた false:前のフレームから触れ続けている
+*//****************************************/
+bool CContactCache::Touch(uint32_t inIndexA, uint32_t inIndexB, CCollisionBase* inCollisionA, CCollisionBase* inCollisionB)
+{
+	if (inIndexA > inIndexB)
+	{
+		std::swap(inIndexA, inIndexB);
+		std::swap(inCollisionA, inCollisionB);
+	}
+	if (m_SlotVec.empty()) Rehash(ce_nInitialSlotNum);
+
+	const uint64_t nKey = MakeKey(inIndexA, inIndexB);
+	uint32_t nSlot = FindSlot(nKey);
+	if (m_SlotVec[nSlot] != ce_nEmpty)
+	{
+		m_ContactVec[m_SlotVec[nSlot]].m_nFrame = m_nFrame;
+		m_tCount.m_nStayNum++;
+		return false;
+	}
+
+	// 埋まっている割合を半分以下に保つ
+	if ((m_ContactVec.size() + 1) * 2 > m_SlotVec.size())
+	{
+		Rehash(static_cast<uint32_t>(m_SlotVec.size()) * 2);
+		nSlot = FindSlot(nKey);
+	}
+	m_SlotVec[nSlot] = static_cast<uint32_t>(m_ContactVec.size());
+	m_ContactVec.push_back({ nKey, inCollisionA, inCollisionB, m_nFrame });
+	m_tCount.m_nEnterNum++;
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 全ての組を外す
+*//****************************************/
+void CContactCache::Clear()
+{
+	m_ContactVec.clear();
+	std::fill(m_SlotVec.begin(), m_SlotVec.end(), ce_nEmpty);
+}
+
+/****************************************//*
+	@brief　	| キーのハッシュ表での最初の位置
+	@param　	| inKey：キー
+	@return		| 位置
+*//****************************************/
+uint32_t CContactCache::HomeSlot(uint64_t inKey) const
+{
+	// 番号が連続していても散らばるように混ぜる
+	uint64_t nHash = inKey;
+	nHash ^= nHash >> 33;
+	nHash *= 0xff51afd7ed558ccdull;
+	nHash ^= nHash >> 33;
+	return static_cast<uint32_t>(nHash) & static_cast<uint32_t>(m_SlotVec.size() - 1);
+}
+
+/****************************************//*
+	@brief　	| キーのハッシュ表での位置を探す
+	@param　	| inKey：キー
+	@return		| 位置(無ければキーを入れる空きの位置)
+*//****************************************/
+uint32_t CContactCache::FindSlot(uint64_t inKey) const
+{
+	const uint32_t nMask = static_cast<uint32_t>(m_SlotVec.size() - 1);
+	uint32_t nSlot = HomeSlot(inKey);
+	while (m_SlotVec[nSlot] != ce_nEmpty && m_ContactVec[m_SlotVec[nSlot]].m_nKey != inKey)
+	{
+		nSlot = (nSlot + 1) & nMask;
+	}
+	return nSlot;
+}
+
+/****************************************//*
+	@brief　	| 配列の組を外す
+	@param　	| inContact：配列の番号
+	@note		| 空いた位置より後ろの要素を詰め、墓標を残さない
+*//****************************************/
+void CContactCache::EraseAt(uint32_t inContact)
+{
+	const uint32_t nMask = static_cast<uint32_t>(m_SlotVec.size() - 1);
+	uint32_t nHole = FindSlot(m_ContactVec[inContact].m_nKey);
+	for (uint32_t nNext = (nHole + 1) & nMask; m_SlotVec[nNext] != ce_nEmpty; nNext = (nNext + 1) & nMask)
+	{
+		// 本来の位置から穴までの方が近い要素は穴に詰める
+		const uint32_t nHome = HomeSlot(m_ContactVec[m_SlotVec[nNext]].m_nKey);
+		if (((nNext - nHome) & nMask) >= ((nNext - nHole) & nMask))
+		{
+			m_SlotVec[nHole] = m_SlotVec[nNext];
+			nHole = nNext;
+		}
+	}
+	m_SlotVec[nHole] = ce_nEmpty;
+
+	// 最後の組を空いた位置に詰める
+	const uint32_t nLast = static_cast<uint32_t>(m_ContactVec.size() - 1);
+	if (inContact != nLast)
+	{
+		m_SlotVec[FindSlot(m_ContactVec[nLast].m_nKey)] = inContact;
+		m_ContactVec[inContact] = m_ContactVec[nLast];
+	}
+	m_ContactVec.pop_back();
+}
+
+/****************************************//*
+	@brief　	| ハッシュ表を広げて入れ直す
+	@param　	| inSlotNum：新しい大きさ(2の累乗)
+*//****************************************/
+void CContactCache::Rehash(uint32_t inSlotNum)
+{
+	m_SlotVec.assign(inSlotNum, ce_nEmpty);
+	for (uint32_t i = 0; i < m_ContactVec.size(); i++)
+	{
+		m_SlotVec[FindSlot(m_ContactVec[i].m_nKey)] = i;
+	}
+}
+
+/****************************************//*
+	@brief　	| 大量の箱を動かし、レイヤーで絞り込んだ組の接触の変化を集合で求めた結果と比べて速さを書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CContactCache::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr uint32_t ce_nBodyNum = 6000;
+	static constexpr uint32_t ce_nRespawnNum = 300;
+	static constexpr int ce_nFrameNum = 240;
+	static constexpr int ce_nRespawnFrame = 120;
+	static constexpr float ce_fMapSize = 160.0f;
+	static constexpr float ce_fMoveSpeed = 4.0f / 60.0f;
+	char szLine[256];
+	bool bSuccess = true;
+
+	// レイヤー毎の割合と衝突する相手
+	// 壁は動かない、敵同士と弾同士は当たらない
+	const uint32_t nWall = CollisionLayerBit(CollisionLayer::Wall);
+	const uint32_t nPlayer = CollisionLayerBit(CollisionLayer::Player);
+	const uint32_t nEnemy = CollisionLayerBit(CollisionLayer::Enemy);
+	const uint32_t nProjectile = CollisionLayerBit(CollisionLayer::Projectile);
+	auto LayerOf = [&](uint32_t inBody) { return (inBody % 10 == 0) ? nWall : (inBody % 100 == 1) ? nPlayer : (inBody % 2 == 0) ? nEnemy : nProjectile; };
+	auto MaskOf = [&](uint32_t inLayerBit)
+		{
+			if (inLayerBit == nWall) return nPlayer | nEnemy | nProjectile;
+			if (inLayerBit == nEnemy) return nWall | nPlayer | nProjectile;
+			if (inLayerBit == nProjectile) return nWall | nEnemy;
+			return ce_nAllCollisionLayer;
+		};
+
+	sprintf_s(szLine, "bodies %u  frames %d  respawn %u at frame %d\n", ce_nBodyNum, ce_nFrameNum, ce_nRespawnNum, ce_nRespawnFrame);
+	tReport << szLine;
+	tReport << "filter  pairs/f  filtered/f  hits/f  enter  stay  exit   find ms  narrow ms  cache ms  set ms  events\n";
+
+	for (int nFilter = 0; nFilter < 2; nFilter++)
+	{
+		std::mt19937 tRandom(47);
+		std::uniform_real_distribution<float> tPos(0.0f, ce_fMapSize);
+		std::uniform_real_distribution<float> tRadius(0.4f, 1.2f);
+		std::uniform_real_distribution<float> tTurn(-0.3f, 0.3f);
+
+		// 当たり判定の代わりに、登録時の番号を取り出せる目印のアドレスを渡す(中身は使わない)
+		std::vector<uint8_t> tTokenVec(ce_nBodyNum);
+		auto Token = [&](uint32_t inIndex) { return reinterpret_cast<CCollisionBase*>(&tTokenVec[inIndex]); };
+		auto IndexOf = [&](CCollisionBase* inCollision) { return static_cast<uint32_t>(reinterpret_cast<uint8_t*>(inCollision) - tTokenVec.data()); };
+
+		CSpatialQuery tQuery;
+		CContactCache tCache;
+		std::vector<CollisionVolume> tVolumeVec(ce_nBodyNum);
+		std::vector<float> tHeadingVec(ce_nBodyNum);
+		auto Spawn = [&](uint32_t inBody)
+			{
+				const float fCenter[3] = { tPos(tRandom), 0.0f, tPos(tRandom) };
+				tVolumeVec[inBody] = CCollisionDispatch::MakeSphere(fCenter, tRadius(tRandom));
+				tHeadingVec[inBody] = tPos(tRandom);
+			};
+		auto BoxOf = [&](uint32_t inBody)
+			{
+				const CollisionVolume& tVolume = tVolumeVec[inBody];
+				SpatialBox tBox = {};
+				for (int k = 0; k < 3; k++)
+				{
+					tBox.m_fCenter[k] = tVolume.m_fCenter[k];
+					tBox.m_fHalfSize[k] = tVolume.m_fHalfSize[k];
+					tBox.m_fAxis[k][k] = 1.0f;
+				}
+				return tBox;
+			};
+		auto Register = [&](uint32_t inBody)
+			{
+				const uint32_t nIndex = tQuery.Add(BoxOf(inBody), CSpatialQuery::ce_nAllTag, Token(inBody), LayerOf(inBody) == nWall);
+				if (nFilter) tQuery.SetFilter(nIndex, LayerOf(inBody), MaskOf(LayerOf(inBody)));
+				return nIndex;
+			};
+
+		// 登録時の番号と目印の番号を揃えるため、順に登録する
+		for (uint32_t i = 0; i < ce_nBodyNum; i++)
+		{
+			Spawn(i);
+			Register(i);
+		}
+		tQuery.Update();
+
+		std::vector<SpatialPair> tPairVec;
+		std::set<uint64_t> tPrevSet;
+		std::vector<uint64_t> tEnterVec, tExitVec, tRefEnterVec, tRefExitVec;
+		double dFindMs = 0.0, dNarrowMs = 0.0, dCacheMs = 0.0, dSetMs = 0.0;
+		long long nPairNum = 0, nFilterNum = 0, nHitNum = 0, nEnterNum = 0, nStayNum = 0, nExitNum = 0;
+		int nMismatchFrame = 0;
+		auto OnExit = [&](CCollisionBase* inA, CCollisionBase* inB) { tExitVec.push_back(MakeKey(IndexOf(inA), IndexOf(inB))); };
+
+		for (int nFrame = 0; nFrame < ce_nFrameNum; nFrame++)
+		{
+			tEnterVec.clear();
+			tExitVec.clear();
+			tRefEnterVec.clear();
+			tRefExitVec.clear();
+
+			// 途中で一部を外して別の場所に登録し直す(外した時に離れた処理を呼ぶ)
+			if (nFrame == ce_nRespawnFrame)
+			{
+				for (uint32_t n = 0; n < ce_nRespawnNum; n++)
+				{
+					const uint32_t nBody = n * (ce_nBodyNum / ce_nRespawnNum) + 1;
+					tQuery.Remove(nBody);
+					tCache.Remove(nBody, OnExit);
+					for (auto itr = tPrevSet.begin(); itr != tPrevSet.end();)
+					{
+						if (static_cast<uint32_t>(*itr >> 32) == nBody || static_cast<uint32_t>(*itr) == nBody)
+						{
+							tRefExitVec.push_back(*itr);
+							itr = tPrevSet.erase(itr);
+						}
+						else itr++;
+					}
+				}
+				// 外した番号は後から外したものから使い回される
+				for (uint32_t n = ce_nRespawnNum; n-- > 0;)
+				{
+					const uint32_t nBody = n * (ce_nBodyNum / ce_nRespawnNum) + 1;
+					Spawn(nBody);
+					bSuccess &= Register(nBody) == nBody;
+				}
+			}
+
+			// 動く物は向きを少しずつ変えながら進み、端で折り返す
+			for (uint32_t i = 0; i < ce_nBodyNum; i++)
+			{
+				if (LayerOf(i) == nWall) continue;
+				CollisionVolume& tVolume = tVolumeVec[i];
+				tHeadingVec[i] += tTurn(tRandom);
+				tVolume.m_fCenter[0] += cosf(tHeadingVec[i]) * ce_fMoveSpeed * ((i & 1) ? 3.0f : 1.0f);
+				tVolume.m_fCenter[2] += sinf(tHeadingVec[i]) * ce_fMoveSpeed * ((i & 1) ? 3.0f : 1.0f);
+				for (int k = 0; k < 3; k += 2)
+				{
+					if (tVolume.m_fCenter[k] < 0.0f || tVolume.m_fCenter[k] > ce_fMapSize) tHeadingVec[i] += 3.14159265f;
+					tVolume.m_fCenter[k] = (std::min)((std::max)(tVolume.m_fCenter[k], 0.0f), ce_fMapSize);
+				}
+				tQuery.Move(i, BoxOf(i));
+			}
+
+			auto tStart = std::chrono::high_resolution_clock::now();
+			tQuery.FindPairs(tPairVec);
+			auto tFind = std::chrono::high_resolution_clock::now();
+
+			// 詳細な判定で重なった組だけを残す
+			size_t nHit = 0;
+			for (const SpatialPair& tPair : tPairVec)
+			{
+				if (CCollisionDispatch::Test(tVolumeVec[tPair.m_nIndexA], tVolumeVec[tPair.m_nIndexB])) tPairVec[nHit++] = tPair;
+			}
+			tPairVec.resize(nHit);
+			auto tNarrow = std::chrono::high_resolution_clock::now();
+
+			for (const SpatialPair& tPair : tPairVec)
+			{
+				if (tCache.Touch(tPair.m_nIndexA, tPair.m_nIndexB, tPair.m_pCollisionA, tPair.m_pCollisionB))
+				{
+					tEnterVec.push_back(MakeKey(tPair.m_nIndexA, tPair.m_nIndexB));
+				}
+			}
+			tCache.Update(OnExit);
+			auto tCacheEnd = std::chrono::high_resolution_clock::now();
+
+			// 比べるための集合による答え
+			std::set<uint64_t> tCurSet;
+			for (const SpatialPair& tPair : tPairVec) tCurSet.insert(MakeKey(tPair.m_nIndexA, tPair.m_nIndexB));
+			std::set_difference(tCurSet.begin(), tCurSet.end(), tPrevSet.begin(), tPrevSet.end(), std::back_inserter(tRefEnterVec));
+			std::set_difference(tPrevSet.begin(), tPrevSet.end(), tCurSet.begin(), tCurSet.end(), std::back_inserter(tRefExitVec));
+			tPrevSet.swap(tCurSet);
+			auto tEnd = std::chrono::high_resolution_clock::now();
+
+			tQuery.Update();
+			dFindMs += std::chrono::duration<double, std::milli>(tFind - tStart).count();
+			dNarrowMs += std::chrono::duration<double, std::milli>(tNarrow - tFind).count();
+			dCacheMs += std::chrono::duration<double, std::milli>(tCacheEnd - tNarrow).count();
+			dSetMs += std::chrono::duration<double, std::milli>(tEnd - tCacheEnd).count();
+
+			const SpatialQueryStats& tQueryStats = tQuery.GetStats();
+			const ContactStats& tContactStats = tCache.GetStats();
+			nPairNum += tQueryStats.m_nPairNum;
+			nFilterNum += tQueryStats.m_nFilterNum;
+			nHitNum += static_cast<long long>(nHit);
+			nEnterNum += tContactStats.m_nEnterNum;
+			nStayNum += tContactStats.m_nStayNum;
+			nExitNum += static_cast<long long>(tExitVec.size());
+
+			std::sort(tEnterVec.begin(), tEnterVec.end());
+			std::sort(tExitVec.begin(), tExitVec.end());
+			std::sort(tRefExitVec.begin(), tRefExitVec.end());
+			const bool bMatch = tEnterVec == tRefEnterVec && tExitVec == tRefExitVec
+				&& tContactStats.m_nStayNum == static_cast<int>(nHit - tEnterVec.size())
+				&& tContactStats.m_nContactNum == static_cast<int>(tPrevSet.size());
+			if (!bMatch) nMismatchFrame++;
+		}
+
+		sprintf_s(szLine, "%-6s  %7lld  %10lld  %6lld  %5lld  %5lld  %4lld   %7.3f  %9.3f  %8.3f  %6.3f  %s\n",
+			nFilter ? "on" : "off", nPairNum / ce_nFrameNum, nFilterNum / ce_nFrameNum, nHitNum / ce_nFrameNum,
+			nEnterNum, nStayNum, nExitNum,
+			dFindMs / ce_nFrameNum, dNarrowMs / ce_nFrameNum, dCacheMs / ce_nFrameNum, dSetMs / ce_nFrameNum,
+			nMismatchFrame == 0 ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= nMismatchFrame == 0;
+	}
+
+	return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/**************************************************//*
+	@file	| ContactCache.h
+	@brief	| 接触している当たり判定の組を覚えておくクラスのhファイル
+	@note	| 空間検索の登録時の番号の組をキーにしたハッシュ表で、前のフレームから触れている組を覚えておき、
+			| 触れ始め(Enter)、触れ続け(Stay)、離れた(Exit)を区別する
+			| 組は詰めた配列に持ち、ハッシュ表は配列の番号を引くための開番地法の表にする
+			| 配列と表は使い回し、組の数が増えた時以外はメモリを確保しない
+*//**************************************************/
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// @brief 前方宣言
+class CCollisionBase;
+
+// @brief 接触している当たり判定の組
+struct ContactPair
+{
+	// 登録時の番号の組のキー(小さい番号が上位)
+	uint64_t m_nKey;
+
+	// 当たり判定A(登録時の番号が小さい方)
+	CCollisionBase* m_pCollisionA;
+
+	// 当たり判定B(登録時の番号が大きい方)
+	CCollisionBase* m_pCollisionB;
+
+	// 最後に触れたフレーム
+	uint32_t m_nFrame;
+};
+
+// @brief 接触の統計情報(直前の更新から次の更新まで)
+struct ContactStats
+{
+	// 触れている組の数
+	int m_nContactNum;
+
+	// 触れ始めた組の数
+	int m_nEnterNum;
+
+	// 触れ続けている組の数
+	int m_nStayNum;
+
+	// 離れた組の数
+	int m_nExitNum;
+};
+
+// @brief 接触している当たり判定の組を覚えておくクラス
+class CContactCache
+{
+public:
+	// @brief ハッシュ表の空き
+	static constexpr uint32_t ce_nEmpty = UINT32_MAX;
+
+	// @brief ハッシュ表の大きさの初期値(2の累乗)
+	static constexpr uint32_t ce_nInitialSlotNum = 256;
+
+public:
+	// @brief コンストラクタ
+	CContactCache();
+
+	// @brief デストラクタ
+	~CContactCache();
+
+	// @brief 重なっている組を記録する
+	// @param inIndexA：当たり判定Aの登録時の番号
+	// @param inIndexB：当たり判定Bの登録時の番号
+	// @param inCollisionA：当たり判定A
+	// @param inCollisionB：当たり判定B
+	// @return true:触れ始めた false:前のフレームから触れ続けている
+	bool Touch(uint32_t inIndexA, uint32_t inIndexB, CCollisionBase* inCollisionA, CCollisionBase* inCollisionB);
+
+	// @brief 更新
+	// @tparam TCallback：void(CCollisionBase* inCollisionA, CCollisionBase* inCollisionB)
+	// @param inExit：このフレームに触れなかった組毎に呼ぶ処理
+	// @note 触れなかった組を外し、直前の更新からの統計情報を確定して次のフレームに進める
+	template<typename TCallback>
+	void Update(TCallback&& inExit)
+	{
+		for (uint32_t i = 0; i < m_ContactVec.size();)
+		{
+			if (m_ContactVec[i].m_nFrame == m_nFrame)
+			{
+				i++;
+				continue;
+			}
+			inExit(m_ContactVec[i].m_pCollisionA, m_ContactVec[i].m_pCollisionB);
+			EraseAt(i);
+			m_tCount.m_nExitNum++;
+		}
+
+		m_tStats = m_tCount;
+		m_tStats.m_nContactNum = static_cast<int>(m_ContactVec.size());
+		m_tCount = {};
+		m_nFrame++;
+	}
+
+	// @brief 当たり判定を含む組を全て外す
+	// @tparam TCallback：void(CCollisionBase* inCollisionA, CCollisionBase* inCollisionB)
+	// @param inIndex：当たり判定の登録時の番号
+	// @param inExit：外した組毎に呼ぶ処理
+	// @note 登録時の番号は使い回されるため、空間検索から外す時に必ず呼ぶ
+	template<typename TCallback>
+	void Remove(uint32_t inIndex, TCallback&& inExit)
+	{
+		for (uint32_t i = 0; i < m_ContactVec.size();)
+		{
+			const uint64_t nKey = m_ContactVec[i].m_nKey;
+			if (static_cast<uint32_t>(nKey >> 32) != inIndex && static_cast<uint32_t>(nKey) != inIndex)
+			{
+				i++;
+				continue;
+			}
+			inExit(m_ContactVec[i].m_pCollisionA, m_ContactVec[i].m_pCollisionB);
+			EraseAt(i);
+			m_tCount.m_nExitNum++;
+		}
+	}
+
+	// @brief 全ての組を外す(離れた処理は呼ばない)
+	void Clear();
+
+	// @brief 触れている組の数の取得
+	uint32_t GetContactNum() const { return static_cast<uint32_t>(m_ContactVec.size()); }
+
+	// @brief 統計情報の取得
+	// @return 直前の更新から次の更新までの統計情報
+	const ContactStats& GetStats() const { return m_tStats; }
+
+	// @brief 大量の箱を動かし、レイヤーで絞り込んだ組の接触の変化を集合で求めた結果と比べて速さを書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief キーのハッシュ表での最初の位置
+	// @param inKey：キー
+	uint32_t HomeSlot(uint64_t inKey) const;
+
+	// @brief キーのハッシュ表での位置を探す
+	// @param inKey：キー
+	// @return 位置(無ければキーを入れる空きの位置)
+	uint32_t FindSlot(uint64_t inKey) const;
+
+	// @brief 配列の組を外す
+	// @param inContact：配列の番号
+	// @note 最後の組を空いた位置に詰める
+	void EraseAt(uint32_t inContact);
+
+	// @brief ハッシュ表を広げて入れ直す
+	// @param inSlotNum：新しい大きさ(2の累乗)
+	void Rehash(uint32_t inSlotNum);
+
+private:
+	// @brief 触れている組(詰めて持つ)
+	std::vector<ContactPair> m_ContactVec;
+
+	// @brief キーから組の配列の番号を引くハッシュ表(空きはce_nEmpty)
+	std::vector<uint32_t> m_SlotVec;
+
+	// @brief 今のフレーム
+	uint32_t m_nFrame;
+
+	// @brief 集計中の統計情報
+	ContactStats m_tCount;
+
+	// @brief 直前の更新から次の更新までの統計情報
+	ContactStats m_tStats;
+};
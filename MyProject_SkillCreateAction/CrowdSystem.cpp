@@ -0,0 +1,768 @@
+/**************************************************//*
+	@file	| CrowdSystem.cpp
+	@brief	| 群衆の歩行シミュレーションクラスのcppファイル
+	@note	| 歩行者の位置・速度・半径を要素毎の配列(SoA)で持ち、
+			| 目標への移動に分離・結合・整列と衝突の予測による回避を加えて、重ならないように歩かせる
+			| 近傍は位置をグリッドのバケットに振り分けて探す(毎フレーム数え上げで並べ直す)
+			| 操舵は前のフレームの位置と速度だけを読んで次の配列に書くため、塊に分けてジョブシステムで並列に行い、
+			| スレッドの数に関わらず同じ結果になる
+			| シングルトンパターンで作成
+*//**************************************************/
+#include "CrowdSystem.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <thread>
+
+namespace
+{
+	// @brief 番号の枠の部分のビット数
+	constexpr uint32_t ce_nSlotBits = 20;
+
+	// @brief 番号の枠の部分のマスク
+	constexpr uint32_t ce_nSlotMask = (1u << ce_nSlotBits) - 1;
+
+	// @brief 空いている枠の並びの番号
+	constexpr uint32_t ce_nFreeIndex = ce_nSlotMask;
+
+	// @brief グリッドのバケットの数(2のべき乗)
+	constexpr uint32_t ce_nBucketNum = 16384;
+
+	// @brief 操舵の塊1つの歩行者の数(塊は空いたスレッドから順に取り出す)
+	constexpr uint32_t ce_nChunkAgent = 256;
+
+	// @brief 重なっているとみなす距離の割合(混み合った時に押し戻しきれない僅かな接触は数えない)
+	constexpr float ce_fOverlapSlop = 0.95f;
+
+	// @brief 回避で右側へ寄せる量(半径の和に対する割合)
+	constexpr float ce_fSideBias = 0.5f;
+
+	// @brief 同じ位置とみなす距離の2乗
+	constexpr float ce_fEpsilon = 1e-8f;
+
+	// @brief ベクトルの長さを上限に収める
+	// @param ioX：X成分
+	// @param ioZ：Z成分
+	// @param inMax：長さの上限
+	void ClampLength(float& ioX, float& ioZ, float inMax)
+	{
+		float fLengthSq = ioX * ioX + ioZ * ioZ;
+		if (fLengthSq <= inMax * inMax) return;
+
+		float fScale = inMax / sqrtf(fLengthSq);
+		ioX *= fScale;
+		ioZ *= fScale;
+	}
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CCrowdSystem::CCrowdSystem()
+	: m_tParams(ce_tDefaultParams)
+	, m_nChunkNum(0)
+	, m_fDeltaTime(0.0f)
+	, m_nNextChunk(0)
+	, m_nDoneChunk(0)
+	, m_nRunningNum(0)
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CCrowdSystem::~CCrowdSystem()
+{
+	// 塊を取り出しに来るジョブが自分を参照しているため、終わるまで待つ
+	WaitRunning();
+}
+
+/****************************************//*
+	@brief　	| 歩行者の配列を確保する
+	@param　	| inCapacity：最初に確保する歩行者の数(超えた分は追加時に広げる)
+*//****************************************/
+void CCrowdSystem::Init(uint32_t inCapacity)
+{
+	Clear();
+
+	// 空きを表す並びの番号と重ならないよう、枠の部分で表せる数より1つ少なくする
+	inCapacity = (std::min)(inCapacity, ce_nMaxCapacity - 1);
+	for (std::vector<float>* pVec : { &m_PosXVec, &m_PosZVec, &m_VelXVec, &m_VelZVec, &m_NextPosXVec, &m_NextPosZVec, &m_NextVelXVec, &m_NextVelZVec,
+		&m_GoalXVec, &m_GoalZVec, &m_RadiusVec, &m_MaxSpeedVec, &m_CellPosXVec, &m_CellPosZVec, &m_CellVelXVec, &m_CellVelZVec, &m_CellRadiusVec })
+	{
+		pVec->reserve(inCapacity);
+	}
+	for (std::vector<uint32_t>* pVec : { &m_GroupVec, &m_SlotOfVec, &m_SlotVec, &m_AgentBucketVec, &m_CellAgentVec, &m_CellGroupVec })
+	{
+		pVec->reserve(inCapacity);
+	}
+	m_HasGoalVec.reserve(inCapacity);
+}
+
+/****************************************//*
+	@brief　	| 歩行者を追加する
+	@param　	| inDesc：生成情報
+	@return		| 歩行者の番号(上限に達していればce_nInvalidHandle)
+*//****************************************/
+CrowdHandle CCrowdSystem::Add(const CrowdAgentDesc& inDesc)
+{
+	// 空いている枠が無ければ枠を増やす(空きを表す並びの番号と重ならない数まで)
+	uint32_t nSlot;
+	if (!m_FreeSlotVec.empty())
+	{
+		nSlot = m_FreeSlotVec.back();
+		m_FreeSlotVec.pop_back();
+	}
+	else
+	{
+		if (m_SlotVec.size() >= ce_nMaxCapacity - 1) return ce_nInvalidHandle;
+		nSlot = static_cast<uint32_t>(m_SlotVec.size());
+		m_SlotVec.push_back(ce_nFreeIndex);
+	}
+
+	// 末尾に詰めて追加する
+	uint32_t nIndex = GetNum();
+	m_PosXVec.push_back(inDesc.m_tPos.m_fX);
+	m_PosZVec.push_back(inDesc.m_tPos.m_fZ);
+	m_VelXVec.push_back(0.0f);
+	m_VelZVec.push_back(0.0f);
+	m_GoalXVec.push_back(inDesc.m_tPos.m_fX);
+	m_GoalZVec.push_back(inDesc.m_tPos.m_fZ);
+	m_HasGoalVec.push_back(0);
+	m_RadiusVec.push_back(inDesc.m_fRadius);
+	m_MaxSpeedVec.push_back(inDesc.m_fMaxSpeed);
+	m_GroupVec.push_back(inDesc.m_nGroup);
+	m_SlotOfVec.push_back(nSlot);
+
+	uint32_t nGeneration = m_SlotVec[nSlot] & ~ce_nSlotMask;
+	m_SlotVec[nSlot] = nGeneration | nIndex;
+	return nGeneration | nSlot;
+}
+
+/****************************************//*
+	@brief　	| 歩行者を外す
+	@param　	| inHandle：歩行者の番号
+	@return		| true:外した false:既に無い
+*//****************************************/
+bool CCrowdSystem::Remove(CrowdHandle inHandle)
+{
+	uint32_t nIndex = GetIndex(inHandle);
+	if (nIndex == UINT32_MAX) return false;
+
+	RemoveAt(nIndex);
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 全ての歩行者を外す
+*//****************************************/
+void CCrowdSystem::Clear()
+{
+	while (GetNum() > 0) RemoveAt(GetNum() - 1);
+}
+
+/****************************************//*
+	@brief　	| 歩行者がいるか
+	@param　	| inHandle：歩行者の番号
+	@return		| true:いる false:外された
+*//****************************************/
+bool CCrowdSystem::IsAlive(CrowdHandle inHandle) const
+{
+	return GetIndex(inHandle) != UINT32_MAX;
+}
+
+/****************************************//*
+	@brief　	| 目標を設定する
+	@param　	| inHandle：歩行者の番号
+	@param　	| inGoal：目標の位置
+*//****************************************/
+void CCrowdSystem::SetGoal(CrowdHandle inHandle, const NavPoint& inGoal)
+{
+	uint32_t nIndex = GetIndex(inHandle);
+	if (nIndex == UINT32_MAX) return;
+
+	m_GoalXVec[nIndex] = inGoal.m_fX;
+	m_GoalZVec[nIndex] = inGoal.m_fZ;
+	m_HasGoalVec[nIndex] = 1;
+}
+
+/****************************************//*
+	@brief　	| 目標を外す(その場に止まる)
+	@param　	| inHandle：歩行者の番号
+*//****************************************/
+void CCrowdSystem::ClearGoal(CrowdHandle inHandle)
+{
+	uint32_t nIndex = GetIndex(inHandle);
+	if (nIndex == UINT32_MAX) return;
+
+	m_HasGoalVec[nIndex] = 0;
+}
+
+/****************************************//*
+	@brief　	| 位置を直接設定する(速度は0になる)
+	@param　	| inHandle：歩行者の番号
+	@param　	| inPos：位置
+*//****************************************/
+void CCrowdSystem::SetPosition(CrowdHandle inHandle, const NavPoint& inPos)
+{
+	uint32_t nIndex = GetIndex(inHandle);
+	if (nIndex == UINT32_MAX) return;
+
+	m_PosXVec[nIndex] = inPos.m_fX;
+	m_PosZVec[nIndex] = inPos.m_fZ;
+	m_VelXVec[nIndex] = 0.0f;
+	m_VelZVec[nIndex] = 0.0f;
+}
+
+/****************************************//*
+	@brief　	| 位置と速度の取得
+	@param　	| inHandle：歩行者の番号
+	@param　	| outPos：位置
+	@param　	| outVelocity：速度(XZ、1秒あたり)
+	@return		| true:取得した false:歩行者がいない
+*//****************************************/
+bool CCrowdSystem::GetAgent(CrowdHandle inHandle, NavPoint& outPos, NavPoint& outVelocity) const
+{
+	uint32_t nIndex = GetIndex(inHandle);
+	if (nIndex == UINT32_MAX) return false;
+
+	outPos = { m_PosXVec[nIndex], m_PosZVec[nIndex] };
+	outVelocity = { m_VelXVec[nIndex], m_VelZVec[nIndex] };
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 更新
+	@param　	| inDeltaTime：経過時間(秒)
+*//****************************************/
+void CCrowdSystem::Update(float inDeltaTime)
+{
+	auto tStart = std::chrono::high_resolution_clock::now();
+
+	// 前回の更新で塊が無くなった後に始まったジョブが残っていれば、塊の番号を戻す前に終わるのを待つ
+	WaitRunning();
+
+	const uint32_t nNum = GetNum();
+	m_tStats = {};
+	m_tStats.m_nAgentNum = static_cast<int>(nNum);
+	if (nNum == 0) return;
+
+	// 近傍を探す範囲が隣のセルまでに収まるよう、セルの大きさを近傍を探す距離に合わせて振り分ける
+	BuildGrid();
+	auto tGrid = std::chrono::high_resolution_clock::now();
+	m_tStats.m_dGridMs = std::chrono::duration<double, std::milli>(tGrid - tStart).count();
+
+	for (std::vector<float>* pVec : { &m_NextPosXVec, &m_NextPosZVec, &m_NextVelXVec, &m_NextVelZVec }) pVec->resize(nNum);
+	m_fDeltaTime = inDeltaTime;
+	m_nChunkNum = (nNum + ce_nChunkAgent - 1) / ce_nChunkAgent;
+	m_ChunkVec.assign(m_nChunkNum, ChunkStats{ 0, 0, 0, 0.0f });
+	m_nNextChunk.store(0, std::memory_order_relaxed);
+	m_nDoneChunk.store(0, std::memory_order_relaxed);
+
+	// ワーカースレッド毎に塊を取り出し続けるジョブを1つずつ渡し、メインスレッドも同じように取り出す
+	// (全体の完了をWaitAllで待つと経路探索などの他のジョブも待ってしまうため、終わった塊の数で待つ)
+	CJobSystem* pJobSystem = CJobSystem::GetInstance();
+	int nJobNum = static_cast<int>((std::min)(pJobSystem->GetThreadNum(), m_nChunkNum - 1));
+	m_nRunningNum.store(nJobNum, std::memory_order_release);
+	for (int i = 0; i < nJobNum; i++)
+	{
+		pJobSystem->Submit([this]()
+		{
+			RunChunks();
+			m_nRunningNum.fetch_sub(1, std::memory_order_release);
+		});
+	}
+	RunChunks();
+	while (m_nDoneChunk.load(std::memory_order_acquire) < m_nChunkNum)
+	{
+		std::this_thread::yield();
+	}
+
+	m_PosXVec.swap(m_NextPosXVec);
+	m_PosZVec.swap(m_NextPosZVec);
+	m_VelXVec.swap(m_NextVelXVec);
+	m_VelZVec.swap(m_NextVelZVec);
+
+	for (const ChunkStats& tChunk : m_ChunkVec)
+	{
+		m_tStats.m_nNeighborNum += tChunk.m_nNeighborNum;
+		m_tStats.m_nAvoidNum += tChunk.m_nAvoidNum;
+		m_tStats.m_nOverlapNum += tChunk.m_nOverlapNum;
+		m_tStats.m_fMaxOverlap = (std::max)(m_tStats.m_fMaxOverlap, tChunk.m_fMaxOverlap);
+	}
+	m_tStats.m_nChunkNum = static_cast<int>(m_nChunkNum);
+	m_tStats.m_nJobNum = nJobNum;
+	auto tEnd = std::chrono::high_resolution_clock::now();
+	m_tStats.m_dSteerMs = std::chrono::duration<double, std::milli>(tEnd - tGrid).count();
+	m_tStats.m_dUpdateMs = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+}
+
+/****************************************//*
+	@brief　	| 歩行者をグリッドのバケット順に並べる
+*//****************************************/
+void CCrowdSystem::BuildGrid()
+{
+	const uint32_t nNum = GetNum();
+	m_AgentBucketVec.resize(nNum);
+	m_BucketStartVec.assign(ce_nBucketNum + 1, 0);
+
+	// 1回目で歩行者が入るバケット毎の数を数える
+	for (uint32_t i = 0; i < nNum; i++)
+	{
+		uint32_t nBucket = GetBucket(ToCell(m_PosXVec[i]), ToCell(m_PosZVec[i]));
+		m_AgentBucketVec[i] = nBucket;
+		m_BucketStartVec[nBucket + 1]++;
+	}
+	for (uint32_t i = 1; i <= ce_nBucketNum; i++) m_BucketStartVec[i] += m_BucketStartVec[i - 1];
+
+	// 2回目は各バケットの末尾から詰めていき、終わると先頭の位置になる(後ろから回してバケット内を並びの番号順にする)
+	m_CellAgentVec.resize(nNum);
+	for (std::vector<float>* pVec : { &m_CellPosXVec, &m_CellPosZVec, &m_CellVelXVec, &m_CellVelZVec, &m_CellRadiusVec }) pVec->resize(nNum);
+	m_CellGroupVec.resize(nNum);
+	for (uint32_t i = nNum; i-- > 0;)
+	{
+		uint32_t nEntry = --m_BucketStartVec[m_AgentBucketVec[i] + 1];
+		m_CellAgentVec[nEntry] = i;
+		m_CellPosXVec[nEntry] = m_PosXVec[i];
+		m_CellPosZVec[nEntry] = m_PosZVec[i];
+		m_CellVelXVec[nEntry] = m_VelXVec[i];
+		m_CellVelZVec[nEntry] = m_VelZVec[i];
+		m_CellRadiusVec[nEntry] = m_RadiusVec[i];
+		m_CellGroupVec[nEntry] = m_GroupVec[i];
+	}
+
+	// 末尾から詰めたため、1つ後ろのバケットの位置が先頭になっている
+	for (uint32_t i = 0; i < ce_nBucketNum; i++) m_BucketStartVec[i] = m_BucketStartVec[i + 1];
+	m_BucketStartVec[ce_nBucketNum] = nNum;
+}
+
+/****************************************//*
+	@brief　	| 残っている操舵の塊を取り出して処理する
+*//****************************************/
+void CCrowdSystem::RunChunks()
+{
+	while (true)
+	{
+		uint32_t nChunk = m_nNextChunk.fetch_add(1, std::memory_order_relaxed);
+		if (nChunk >= m_nChunkNum) return;
+
+		SteerChunk(nChunk);
+		m_nDoneChunk.fetch_add(1, std::memory_order_release);
+	}
+}
+
+/****************************************//*
+	@brief　	| 塊1つ分の歩行者を操舵して動かす
+	@param　	| inChunk：塊の番号
+	@note		| バケット順に並べた前のフレームの値だけを読み、次の配列の自分の分だけに書く
+				| 近い歩行者が続けて処理されるよう、塊はバケット順の並びで分ける
+*//****************************************/
+void CCrowdSystem::SteerChunk(uint32_t inChunk)
+{
+	const CrowdParams& tParams = m_tParams;
+	const float fDeltaTime = m_fDeltaTime;
+	const float fNeighborSq = tParams.m_fNeighborRadius * tParams.m_fNeighborRadius;
+	const float fInvReaction = 1.0f / (std::max)(tParams.m_fReactionTime, fDeltaTime);
+	const float fInvAvoidTime = 1.0f / (std::max)(tParams.m_fAvoidanceTime, fDeltaTime);
+	ChunkStats tChunk = { 0, 0, 0, 0.0f };
+
+	const uint32_t nBegin = inChunk * ce_nChunkAgent;
+	const uint32_t nEnd = (std::min)(nBegin + ce_nChunkAgent, GetNum());
+	for (uint32_t nSelf = nBegin; nSelf < nEnd; nSelf++)
+	{
+		const uint32_t i = m_CellAgentVec[nSelf];
+		const float fPosX = m_CellPosXVec[nSelf], fPosZ = m_CellPosZVec[nSelf];
+		const float fVelX = m_CellVelXVec[nSelf], fVelZ = m_CellVelZVec[nSelf];
+		const float fRadius = m_CellRadiusVec[nSelf];
+		const uint32_t nGroup = m_CellGroupVec[nSelf];
+		const float fMaxSpeed = m_MaxSpeedVec[i];
+
+		// 周りの3x3のセルのバケット(畳み込みで同じバケットになったセルは1回だけ見る)
+		uint32_t nBucketVec[9];
+		uint32_t nBucketNum = 0;
+		const int nCellX = ToCell(fPosX), nCellZ = ToCell(fPosZ);
+		for (int z = nCellZ - 1; z <= nCellZ + 1; z++)
+		{
+			for (int x = nCellX - 1; x <= nCellX + 1; x++)
+			{
+				uint32_t nBucket = GetBucket(x, z);
+				if (std::find(nBucketVec, nBucketVec + nBucketNum, nBucket) == nBucketVec + nBucketNum) nBucketVec[nBucketNum++] = nBucket;
+			}
+		}
+
+		float fSeparationX = 0.0f, fSeparationZ = 0.0f;
+		float fCohesionX = 0.0f, fCohesionZ = 0.0f;
+		float fAlignX = 0.0f, fAlignZ = 0.0f;
+		float fAvoidX = 0.0f, fAvoidZ = 0.0f;
+		float fPushX = 0.0f, fPushZ = 0.0f;
+		int nGroupNum = 0;
+		for (uint32_t b = 0; b < nBucketNum; b++)
+		{
+			const uint32_t nBucket = nBucketVec[b];
+			for (uint32_t k = m_BucketStartVec[nBucket]; k < m_BucketStartVec[nBucket + 1]; k++)
+			{
+				// 相手への向き(バケットには遠いセルの歩行者も混ざるため距離で絞る)
+				const float fToX = m_CellPosXVec[k] - fPosX, fToZ = m_CellPosZVec[k] - fPosZ;
+				const float fDistanceSq = fToX * fToX + fToZ * fToZ;
+				if (fDistanceSq > fNeighborSq || k == nSelf) continue;
+				tChunk.m_nNeighborNum++;
+
+				// 分離：半径の和に間隔を足した距離より近い相手から、近いほど強く離れる
+				// 同じ位置に重なった時は並びの番号で向きを決めて、両者が逆に離れるようにする
+				const float fRadiusSum = fRadius + m_CellRadiusVec[k];
+				const float fPersonal = fRadiusSum + tParams.m_fSeparationGap;
+				if (fDistanceSq < fPersonal * fPersonal)
+				{
+					const float fDistance = sqrtf(fDistanceSq);
+					float fAwayX, fAwayZ;
+					if (fDistanceSq > ce_fEpsilon)
+					{
+						fAwayX = -fToX / fDistance;
+						fAwayZ = -fToZ / fDistance;
+					}
+					else
+					{
+						fAwayX = i < m_CellAgentVec[k] ? -1.0f : 1.0f;
+						fAwayZ = 0.0f;
+					}
+					float fStrength = (fPersonal - fDistance) / fPersonal;
+					fSeparationX += fAwayX * fStrength;
+					fSeparationZ += fAwayZ * fStrength;
+
+					// 重なっている分は位置で押し戻す(両者が半分ずつ動く)
+					if (fDistance < fRadiusSum)
+					{
+						float fDepth = fRadiusSum - fDistance;
+						fPushX += fAwayX * fDepth * 0.5f;
+						fPushZ += fAwayZ * fDepth * 0.5f;
+						if (fDistance < fRadiusSum * ce_fOverlapSlop)
+						{
+							tChunk.m_nOverlapNum++;
+							tChunk.m_fMaxOverlap = (std::max)(tChunk.m_fMaxOverlap, fDepth / fRadiusSum);
+						}
+					}
+				}
+
+				// 結合・整列：同じ群れの中心と平均の速度を集める
+				if (m_CellGroupVec[k] == nGroup)
+				{
+					fCohesionX += fToX;
+					fCohesionZ += fToZ;
+					fAlignX += m_CellVelXVec[k];
+					fAlignZ += m_CellVelZVec[k];
+					nGroupNum++;
+				}
+
+				// 回避：今の速度のまま進んだ時に触れる時間を求め、近いうちに触れる相手ほど強く、その時の位置から離れる
+				// (|相手への向き - 相対速度 * t| = 半径の和 を解く、既に重なっている相手は分離に任せる)
+				const float fRelX = fVelX - m_CellVelXVec[k], fRelZ = fVelZ - m_CellVelZVec[k];
+				const float fA = fRelX * fRelX + fRelZ * fRelZ;
+				const float fB = fToX * fRelX + fToZ * fRelZ;
+				const float fC = fDistanceSq - fRadiusSum * fRadiusSum;
+				if (fC <= 0.0f || fB <= 0.0f || fA < ce_fEpsilon) continue;
+				const float fDiscriminant = fB * fB - fA * fC;
+				if (fDiscriminant <= 0.0f) continue;
+				const float fTime = (fB - sqrtf(fDiscriminant)) / fA;
+				if (fTime >= tParams.m_fAvoidanceTime) continue;
+
+				// 正面からぶつかる時に左右が決まらず止まらないよう、相対速度の右側へ少し寄せる(両者が同じ側に避ける)
+				const float fRelLength = sqrtf(fA);
+				const float fAtX = fRelX * fTime - fToX + fRelZ / fRelLength * fRadiusSum * ce_fSideBias;
+				const float fAtZ = fRelZ * fTime - fToZ - fRelX / fRelLength * fRadiusSum * ce_fSideBias;
+				const float fAtLength = sqrtf(fAtX * fAtX + fAtZ * fAtZ);
+				if (fAtLength < 1e-4f) continue;
+				const float fStrength = (tParams.m_fAvoidanceTime - fTime) * fInvAvoidTime;
+				fAvoidX += fAtX / fAtLength * fStrength;
+				fAvoidZ += fAtZ / fAtLength * fStrength;
+				tChunk.m_nAvoidNum++;
+			}
+		}
+
+		// 加速度は分離と回避に先に割り当て、残りを目標への追従と結合・整列に回す
+		// (混み合うほど前に押す力が弱まり、押し合って重なり続けることが無くなる)
+		float fAccelX = fSeparationX * tParams.m_fSeparationWeight + fAvoidX * tParams.m_fAvoidanceWeight;
+		float fAccelZ = fSeparationZ * tParams.m_fSeparationWeight + fAvoidZ * tParams.m_fAvoidanceWeight;
+		ClampLength(fAccelX, fAccelZ, tParams.m_fMaxAccel);
+		const float fRemain = tParams.m_fMaxAccel - sqrtf(fAccelX * fAccelX + fAccelZ * fAccelZ);
+
+		// 目標に向かう速度(手前で減速し、着いたら止まる)
+		float fDesiredX = 0.0f, fDesiredZ = 0.0f;
+		if (m_HasGoalVec[i])
+		{
+			float fToX = m_GoalXVec[i] - fPosX, fToZ = m_GoalZVec[i] - fPosZ;
+			float fDistance = sqrtf(fToX * fToX + fToZ * fToZ);
+			if (fDistance > fRadius)
+			{
+				float fSpeed = fMaxSpeed * (std::min)(1.0f, fDistance / (std::max)(tParams.m_fArriveRadius, 1e-3f));
+				fDesiredX = fToX / fDistance * fSpeed;
+				fDesiredZ = fToZ / fDistance * fSpeed;
+			}
+		}
+		float fSteerX = (fDesiredX - fVelX) * fInvReaction;
+		float fSteerZ = (fDesiredZ - fVelZ) * fInvReaction;
+		if (nGroupNum > 0)
+		{
+			float fInvGroup = 1.0f / static_cast<float>(nGroupNum);
+			fSteerX += fCohesionX * fInvGroup * tParams.m_fCohesionWeight + (fAlignX * fInvGroup - fVelX) * tParams.m_fAlignmentWeight;
+			fSteerZ += fCohesionZ * fInvGroup * tParams.m_fCohesionWeight + (fAlignZ * fInvGroup - fVelZ) * tParams.m_fAlignmentWeight;
+		}
+		ClampLength(fSteerX, fSteerZ, (std::max)(fRemain, 0.0f));
+		fAccelX += fSteerX;
+		fAccelZ += fSteerZ;
+
+		float fNextVelX = fVelX + fAccelX * fDeltaTime;
+		float fNextVelZ = fVelZ + fAccelZ * fDeltaTime;
+		ClampLength(fNextVelX, fNextVelZ, fMaxSpeed);
+
+		// 押し戻した分も速度に含め、押し合っている相手に向かう速度を残さない
+		float fMoveX = fNextVelX * fDeltaTime + fPushX * tParams.m_fPushRate;
+		float fMoveZ = fNextVelZ * fDeltaTime + fPushZ * tParams.m_fPushRate;
+		m_NextPosXVec[i] = fPosX + fMoveX;
+		m_NextPosZVec[i] = fPosZ + fMoveZ;
+		fNextVelX = fMoveX / fDeltaTime;
+		fNextVelZ = fMoveZ / fDeltaTime;
+		ClampLength(fNextVelX, fNextVelZ, fMaxSpeed);
+		m_NextVelXVec[i] = fNextVelX;
+		m_NextVelZVec[i] = fNextVelZ;
+	}
+
+	// 集計は最後にまとめて書き、他の塊の集計と同じキャッシュラインを何度も書かないようにする
+	m_ChunkVec[inChunk] = tChunk;
+}
+
+/****************************************//*
+	@brief　	| 前回の更新で渡したジョブが全て終わるまで待つ
+*//****************************************/
+void CCrowdSystem::WaitRunning()
+{
+	while (m_nRunningNum.load(std::memory_order_acquire) > 0)
+	{
+		std::this_thread::yield();
+	}
+}
+
+/****************************************//*
+	@brief　	| 番号から並びの番号を求める
+	@param　	| inHandle：歩行者の番号
+	@return		| 並びの番号(いなければUINT32_MAX)
+*//****************************************/
+uint32_t CCrowdSystem::GetIndex(CrowdHandle inHandle) const
+{
+	uint32_t nSlot = inHandle & ce_nSlotMask;
+	if (nSlot >= m_SlotVec.size()) return UINT32_MAX;
+
+	uint32_t nEntry = m_SlotVec[nSlot];
+	if ((nEntry & ce_nSlotMask) == ce_nFreeIndex || (nEntry & ~ce_nSlotMask) != (inHandle & ~ce_nSlotMask)) return UINT32_MAX;
+	return nEntry & ce_nSlotMask;
+}
+
+/****************************************//*
+	@brief　	| 並びの番号の歩行者を末尾の歩行者と入れ替えて外す
+	@param　	| inIndex：並びの番号
+*//****************************************/
+void CCrowdSystem::RemoveAt(uint32_t inIndex)
+{
+	uint32_t nSlot = m_SlotOfVec[inIndex];
+	uint32_t nLast = GetNum() - 1;
+	if (inIndex != nLast)
+	{
+		m_PosXVec[inIndex] = m_PosXVec[nLast];
+		m_PosZVec[inIndex] = m_PosZVec[nLast];
+		m_VelXVec[inIndex] = m_VelXVec[nLast];
+		m_VelZVec[inIndex] = m_VelZVec[nLast];
+		m_GoalXVec[inIndex] = m_GoalXVec[nLast];
+		m_GoalZVec[inIndex] = m_GoalZVec[nLast];
+		m_HasGoalVec[inIndex] = m_HasGoalVec[nLast];
+		m_RadiusVec[inIndex] = m_RadiusVec[nLast];
+		m_MaxSpeedVec[inIndex] = m_MaxSpeedVec[nLast];
+		m_GroupVec[inIndex] = m_GroupVec[nLast];
+
+		uint32_t nMovedSlot = m_SlotOfVec[nLast];
+		m_SlotOfVec[inIndex] = nMovedSlot;
+		m_SlotVec[nMovedSlot] = (m_SlotVec[nMovedSlot] & ~ce_nSlotMask) | inIndex;
+	}
+	for (std::vector<float>* pVec : { &m_PosXVec, &m_PosZVec, &m_VelXVec, &m_VelZVec, &m_GoalXVec, &m_GoalZVec, &m_RadiusVec, &m_MaxSpeedVec }) pVec->pop_back();
+	m_HasGoalVec.pop_back();
+	m_GroupVec.pop_back();
+	m_SlotOfVec.pop_back();
+
+	// 世代を進めて古い番号を無効にする
+	uint32_t nGeneration = (m_SlotVec[nSlot] & ~ce_nSlotMask) + (1u << ce_nSlotBits);
+	m_SlotVec[nSlot] = nGeneration | ce_nFreeIndex;
+	m_FreeSlotVec.push_back(nSlot);
+}
+
+/****************************************//*
+	@brief　	| セル座標からバケットの番号を求める
+	@param　	| inX：X方向のセル座標
+	@param　	| inZ：Z方向のセル座標
+	@return		| バケットの番号
+*//****************************************/
+uint32_t CCrowdSystem::GetBucket(int inX, int inZ) const
+{
+	// 範囲の決まっていないグリッドを固定数のバケットに畳み込む
+	uint32_t nHash = static_cast<uint32_t>(inX) * 73856093u ^ static_cast<uint32_t>(inZ) * 19349663u;
+	return nHash & (ce_nBucketNum - 1);
+}
+
+/****************************************//*
+	@brief　	| 座標をセル座標に直す
+	@param　	| inPos：座標
+	@return		| セル座標
+*//****************************************/
+int CCrowdSystem::ToCell(float inPos) const
+{
+	return static_cast<int>(floorf(inPos / m_tParams.m_fNeighborRadius));
+}
+
+/****************************************//*
+	@brief　	| 2500人ずつの2つの群れ(計5000人)をすれ違わせて、重なりと60Hzでの更新の負荷を計測して書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CCrowdSystem::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr int ce_nColumn = 25;
+	static constexpr int ce_nRow = 100;
+	static constexpr uint32_t ce_nAgentNum = ce_nColumn * ce_nRow * 2;
+	static constexpr int ce_nFrameNum = 2700;
+	static constexpr float ce_fDeltaTime = 1.0f / 60.0f;
+	static constexpr float ce_fSpacing = 1.2f;
+	static constexpr float ce_fGap = 10.0f;
+	static constexpr float ce_fTravel = ce_nColumn * ce_fSpacing * 2.0f + ce_fGap;
+	static constexpr float ce_fArrived = 3.0f;
+	char szLine[256];
+	bool bSuccess = true;
+
+	// 2つの群れを間を空けて向かい合わせに並べ、相手の群れの後ろの同じ並びの位置を目標にして正面からすれ違わせる
+	std::mt19937 tRandom(20261019);
+	std::uniform_real_distribution<float> tJitter(-0.2f, 0.2f);
+	std::uniform_real_distribution<float> tRadius(0.3f, 0.45f);
+	std::uniform_real_distribution<float> tSpeed(2.5f, 3.5f);
+	std::vector<CrowdAgentDesc> tDescVec;
+	std::vector<NavPoint> tGoalVec;
+	for (uint32_t nGroup = 0; nGroup < 2; nGroup++)
+	{
+		float fSign = nGroup == 0 ? -1.0f : 1.0f;
+		for (int z = 0; z < ce_nRow; z++)
+		{
+			for (int x = 0; x < ce_nColumn; x++)
+			{
+				float fX = fSign * (ce_fGap * 0.5f + x * ce_fSpacing) + tJitter(tRandom);
+				float fZ = (z - ce_nRow * 0.5f) * ce_fSpacing + tJitter(tRandom);
+				tDescVec.push_back({ { fX, fZ }, tRadius(tRandom), tSpeed(tRandom), nGroup });
+				tGoalVec.push_back({ fX - fSign * ce_fTravel, fZ });
+			}
+		}
+	}
+
+	// 操舵無し(目標に向かうだけで重なる)、操舵ありのメインスレッドだけ、操舵ありのジョブシステム経由を比べる
+	CJobSystem* pJobSystem = CJobSystem::GetInstance();
+	bool bStartJob = pJobSystem->GetThreadNum() == 0;
+	std::vector<float> tFinalVec[2];
+	float fSeekMaxOverlap = 0.0f;
+	for (int nMode = 0; nMode < 3; nMode++)
+	{
+		if (nMode == 2 && bStartJob) pJobSystem->Init();
+		const bool isSeekOnly = nMode == 0;
+		const bool isJob = nMode == 2;
+
+		CCrowdSystem tSystem;
+		if (isSeekOnly)
+		{
+			CrowdParams tParams = ce_tDefaultParams;
+			tParams.m_fSeparationWeight = tParams.m_fCohesionWeight = tParams.m_fAlignmentWeight = tParams.m_fAvoidanceWeight = tParams.m_fPushRate = 0.0f;
+			tSystem.SetParams(tParams);
+		}
+		tSystem.Init(ce_nAgentNum);
+		std::vector<CrowdHandle> tHandleVec(ce_nAgentNum);
+		for (uint32_t i = 0; i < ce_nAgentNum; i++)
+		{
+			tHandleVec[i] = tSystem.Add(tDescVec[i]);
+			tSystem.SetGoal(tHandleVec[i], tGoalVec[i]);
+		}
+
+		long long nNeighborNum = 0, nAvoidNum = 0, nOverlapNum = 0;
+		int nMaxOverlapNum = 0, nMaxJobNum = 0;
+		float fMaxOverlap = 0.0f;
+		double dUpdateMs = 0.0, dMaxUpdateMs = 0.0, dGridMs = 0.0, dSteerMs = 0.0;
+		for (int nFrame = 0; nFrame < ce_nFrameNum; nFrame++)
+		{
+			tSystem.Update(ce_fDeltaTime);
+			const CrowdStats& tStats = tSystem.GetStats();
+			dUpdateMs += tStats.m_dUpdateMs;
+			dMaxUpdateMs = (std::max)(dMaxUpdateMs, tStats.m_dUpdateMs);
+			dGridMs += tStats.m_dGridMs;
+			dSteerMs += tStats.m_dSteerMs;
+			nNeighborNum += tStats.m_nNeighborNum;
+			nAvoidNum += tStats.m_nAvoidNum;
+			nOverlapNum += tStats.m_nOverlapNum;
+			nMaxOverlapNum = (std::max)(nMaxOverlapNum, tStats.m_nOverlapNum);
+			fMaxOverlap = (std::max)(fMaxOverlap, tStats.m_fMaxOverlap);
+			nMaxJobNum = (std::max)(nMaxJobNum, tStats.m_nJobNum);
+		}
+
+		// 相手の群れの向こう側まで抜けた人数と目標に着いた人数、最後の位置(追加順)
+		int nCrossNum = 0, nArrivedNum = 0;
+		std::vector<float> tFinal;
+		for (uint32_t i = 0; i < ce_nAgentNum; i++)
+		{
+			NavPoint tPos = {}, tVelocity = {};
+			tSystem.GetAgent(tHandleVec[i], tPos, tVelocity);
+			float fSign = tDescVec[i].m_nGroup == 0 ? -1.0f : 1.0f;
+			if (-fSign * tPos.m_fX > ce_fGap * 0.5f + ce_nColumn * ce_fSpacing) nCrossNum++;
+			float fDx = tPos.m_fX - tGoalVec[i].m_fX, fDz = tPos.m_fZ - tGoalVec[i].m_fZ;
+			if (fDx * fDx + fDz * fDz < ce_fArrived * ce_fArrived) nArrivedNum++;
+			tFinal.push_back(tPos.m_fX);
+			tFinal.push_back(tPos.m_fZ);
+		}
+		if (!isSeekOnly) tFinalVec[isJob ? 1 : 0] = std::move(tFinal);
+
+		// 重なっていた組の数は片側ずつ数えているため半分にする
+		sprintf_s(szLine, "%-5s %-4s job %d  agent %u  frame %d  update %.3f ms/frame (max %.3f, grid %.3f, steer %.3f)  %.1f%% of 60Hz\n",
+			isSeekOnly ? "seek" : "crowd", isJob ? "job" : "main", nMaxJobNum, ce_nAgentNum, ce_nFrameNum, dUpdateMs / ce_nFrameNum, dMaxUpdateMs,
+			dGridMs / ce_nFrameNum, dSteerMs / ce_nFrameNum, 100.0 * dUpdateMs / ce_nFrameNum / (1000.0 * ce_fDeltaTime));
+		tReport << szLine;
+		sprintf_s(szLine, "           neighbor %.1f/agent  avoid %.2f/agent  overlap %.1f pairs/frame (peak %d, max depth %.0f%%)  crossed %d  arrived %d\n",
+			static_cast<double>(nNeighborNum) / (static_cast<double>(ce_nAgentNum) * ce_nFrameNum), static_cast<double>(nAvoidNum) / (static_cast<double>(ce_nAgentNum) * ce_nFrameNum),
+			nOverlapNum * 0.5 / ce_nFrameNum, nMaxOverlapNum / 2, fMaxOverlap * 100.0f, nCrossNum, nArrivedNum);
+		tReport << szLine;
+
+		// 操舵ありは重なりが浅いまま8割以上がすれ違えること(操舵無しは重なり放題ですり抜けること)
+		if (isSeekOnly) fSeekMaxOverlap = fMaxOverlap;
+		else bSuccess &= fMaxOverlap < 0.25f && nCrossNum * 10 >= static_cast<int>(ce_nAgentNum) * 8;
+	}
+	if (bStartJob) pJobSystem->Uninit();
+
+	// 操舵は前のフレームの値だけを読むため、スレッドの数に関わらず同じ位置になる
+	bool bSame = tFinalVec[0].size() == tFinalVec[1].size() && memcmp(tFinalVec[0].data(), tFinalVec[1].data(), tFinalVec[0].size() * sizeof(float)) == 0;
+	sprintf_s(szLine, "main and job results identical %s  seek-only max depth %.0f%% (scene forces contact) %s\n", bSame ? "ok" : "FAILED",
+		fSeekMaxOverlap * 100.0f, fSeekMaxOverlap > 0.5f ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess &= bSame && fSeekMaxOverlap > 0.5f;
+
+	// 追加と削除：古い番号が無効になり、入れ替えで動いた歩行者の番号が生きていることを確かめる
+	{
+		CCrowdSystem tSystem;
+		CrowdHandle nA = tSystem.Add({ { 0.0f, 0.0f }, 0.4f, 3.0f, 0 });
+		CrowdHandle nB = tSystem.Add({ { 5.0f, 0.0f }, 0.4f, 3.0f, 0 });
+		bool bRemove = tSystem.Remove(nA) && !tSystem.IsAlive(nA) && !tSystem.Remove(nA) && tSystem.IsAlive(nB);
+		CrowdHandle nC = tSystem.Add({ { 9.0f, 0.0f }, 0.4f, 3.0f, 0 });
+		NavPoint tPos = {}, tVelocity = {};
+		bool bReuse = nC != nA && !tSystem.IsAlive(nA) && tSystem.GetAgent(nB, tPos, tVelocity) && tPos.m_fX == 5.0f && tSystem.GetNum() == 2;
+		sprintf_s(szLine, "handle check (stale handle, swap on remove, slot reuse)  %s\n", bRemove && bReuse ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bRemove && bReuse;
+	}
+
+	return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,332 @@
+/**************************************************//*
+	@file	| CrowdSystem.h
+	@brief	| 群衆の歩行シミュレーションクラスのhファイル
+	@note	| 歩行者の位置・速度・半径を要素毎の配列(SoA)で持ち、
+			| 目標への移動に分離・結合・整列と衝突の予測による回避を加えて、重ならないように歩かせる
+			| 近傍は位置をグリッドのバケットに振り分けて探す(毎フレーム数え上げで並べ直す)
+			| 操舵は前のフレームの位置と速度だけを読んで次の配列に書くため、塊に分けてジョブシステムで並列に行い、
+			| スレッドの数に関わらず同じ結果になる
+			| シングルトンパターンで作成
+*//**************************************************/
+#pragma once
+#include "Singleton.h"
+#include "NavGrid.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// @brief 歩行者の番号(下位20bit:枠 上位12bit:世代)
+using CrowdHandle = uint32_t;
+
+// @brief 歩行者の生成情報
+struct CrowdAgentDesc
+{
+	// 位置
+	NavPoint m_tPos;
+
+	// 半径
+	float m_fRadius;
+
+	// 最高速度(1秒あたり)
+	float m_fMaxSpeed;
+
+	// 群れの番号(同じ群れの歩行者とだけ結合・整列する)
+	uint32_t m_nGroup;
+};
+
+// @brief 操舵の設定
+struct CrowdParams
+{
+	// 近傍を探す距離(グリッドのセルの大きさ)
+	float m_fNeighborRadius;
+
+	// 最大の加速度(1秒あたり)
+	float m_fMaxAccel;
+
+	// 目標の速度に合わせるまでの時間(秒)
+	float m_fReactionTime;
+
+	// 目標の手前で減速し始める距離
+	float m_fArriveRadius;
+
+	// 分離の間隔(半径の和にこの間隔を足した距離より近いと離れる)
+	float m_fSeparationGap;
+
+	// 分離の強さ(加速度)
+	float m_fSeparationWeight;
+
+	// 結合の強さ(群れの中心までの距離に掛ける)
+	float m_fCohesionWeight;
+
+	// 整列の強さ(群れの平均の速度との差に掛ける)
+	float m_fAlignmentWeight;
+
+	// 回避の強さ(加速度)
+	float m_fAvoidanceWeight;
+
+	// 衝突を予測する時間(秒)
+	float m_fAvoidanceTime;
+
+	// 重なりを位置で押し戻す割合(0～1)
+	float m_fPushRate;
+};
+
+// @brief 群衆の歩行シミュレーションの統計情報(直前の更新1回分)
+struct CrowdStats
+{
+	// 歩行者の数
+	int m_nAgentNum;
+
+	// 近傍を探す距離の中にいた組の数(片側ずつ数える)
+	int m_nNeighborNum;
+
+	// 衝突を予測して回避した組の数(片側ずつ数える)
+	int m_nAvoidNum;
+
+	// 半径の和の5%より深く重なっていた組の数(片側ずつ数える)
+	int m_nOverlapNum;
+
+	// 一番深い重なり(半径の和に対する割合)
+	float m_fMaxOverlap;
+
+	// 操舵を分けた塊の数
+	int m_nChunkNum;
+
+	// ワーカースレッドに渡したジョブの数
+	int m_nJobNum;
+
+	// グリッドへの振り分けにかかった時間(ミリ秒)
+	double m_dGridMs;
+
+	// 操舵と移動にかかった時間(ミリ秒)
+	double m_dSteerMs;
+
+	// 更新にかかった時間(ミリ秒)
+	double m_dUpdateMs;
+};
+
+// @brief 群衆の歩行シミュレーションクラス
+class CCrowdSystem : public ISingleton<CCrowdSystem>
+{
+public:
+	// @brief 無効な番号
+	static constexpr CrowdHandle ce_nInvalidHandle = UINT32_MAX;
+
+	// @brief 同時に歩かせられる歩行者の上限(番号の枠の部分で表せる数)
+	static constexpr uint32_t ce_nMaxCapacity = 1u << 20;
+
+	// @brief 操舵の設定の初期値(半径0.3～0.5の人が歩く速さ3前後を想定)
+	static constexpr CrowdParams ce_tDefaultParams = { 2.0f, 8.0f, 0.3f, 1.5f, 0.2f, 30.0f, 0.1f, 0.2f, 6.0f, 1.5f, 0.5f };
+
+private:
+	// @brief コンストラクタ
+	CCrowdSystem();
+
+	friend class ISingleton<CCrowdSystem>;
+public:
+	// @brief デストラクタ
+	~CCrowdSystem();
+
+	// @brief 歩行者の配列を確保する
+	// @param inCapacity：最初に確保する歩行者の数(超えた分は追加時に広げる)
+	// @note 歩いている歩行者は全て外される
+	void Init(uint32_t inCapacity);
+
+	// @brief 歩行者を追加する
+	// @param inDesc：生成情報
+	// @return 歩行者の番号(上限に達していればce_nInvalidHandle)
+	// @note 目標を設定するまではその場に止まる
+	CrowdHandle Add(const CrowdAgentDesc& inDesc);
+
+	// @brief 歩行者を外す
+	// @param inHandle：歩行者の番号
+	// @return true:外した false:既に無い
+	bool Remove(CrowdHandle inHandle);
+
+	// @brief 全ての歩行者を外す
+	void Clear();
+
+	// @brief 歩行者がいるか
+	// @param inHandle：歩行者の番号
+	bool IsAlive(CrowdHandle inHandle) const;
+
+	// @brief 目標を設定する
+	// @param inHandle：歩行者の番号
+	// @param inGoal：目標の位置
+	void SetGoal(CrowdHandle inHandle, const NavPoint& inGoal);
+
+	// @brief 目標を外す(その場に止まる)
+	// @param inHandle：歩行者の番号
+	void ClearGoal(CrowdHandle inHandle);
+
+	// @brief 位置を直接設定する(速度は0になる)
+	// @param inHandle：歩行者の番号
+	// @param inPos：位置
+	void SetPosition(CrowdHandle inHandle, const NavPoint& inPos);
+
+	// @brief 位置と速度の取得
+	// @param inHandle：歩行者の番号
+	// @param outPos：位置
+	// @param outVelocity：速度(XZ、1秒あたり)
+	// @return true:取得した false:歩行者がいない
+	bool GetAgent(CrowdHandle inHandle, NavPoint& outPos, NavPoint& outVelocity) const;
+
+	// @brief 操舵の設定
+	// @param inParams：設定
+	void SetParams(const CrowdParams& inParams) { m_tParams = inParams; }
+
+	// @brief 操舵の設定の取得
+	const CrowdParams& GetParams() const { return m_tParams; }
+
+	// @brief 更新
+	// @param inDeltaTime：経過時間(秒)
+	// @note 操舵の塊はメインスレッドも取り出して処理し、全ての塊が終わるまで待つ
+	//       (他のジョブでワーカースレッドが埋まっていてもメインスレッドだけで進む)
+	void Update(float inDeltaTime);
+
+	// @brief 歩行者の数の取得
+	uint32_t GetNum() const { return static_cast<uint32_t>(m_PosXVec.size()); }
+
+	// @brief 歩行者の位置の取得(GetNumまでが歩行者、順番は追加や削除で入れ替わる)
+	const float* GetPosX() const { return m_PosXVec.data(); }
+	const float* GetPosZ() const { return m_PosZVec.data(); }
+
+	// @brief 歩行者の速度の取得(GetPosXと同じ並び)
+	const float* GetVelocityX() const { return m_VelXVec.data(); }
+	const float* GetVelocityZ() const { return m_VelZVec.data(); }
+
+	// @brief 統計情報の取得
+	// @return 直前の更新の統計情報
+	const CrowdStats& GetStats() const { return m_tStats; }
+
+	// @brief 2500人ずつの2つの群れ(計5000人)をすれ違わせて、重なりと60Hzでの更新の負荷を計測して書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief 塊1つ分の集計(ワーカースレッドが書き込む)
+	struct ChunkStats
+	{
+		// 近傍を探す距離の中にいた組の数
+		int m_nNeighborNum;
+
+		// 回避した組の数
+		int m_nAvoidNum;
+
+		// 重なっていた組の数
+		int m_nOverlapNum;
+
+		// 一番深い重なり
+		float m_fMaxOverlap;
+	};
+
+	// @brief 歩行者をグリッドのバケット順に並べる
+	void BuildGrid();
+
+	// @brief 残っている操舵の塊を取り出して処理する
+	void RunChunks();
+
+	// @brief 塊1つ分の歩行者を操舵して動かす
+	// @param inChunk：塊の番号
+	void SteerChunk(uint32_t inChunk);
+
+	// @brief 前回の更新で渡したジョブが全て終わるまで待つ
+	void WaitRunning();
+
+	// @brief 番号から並びの番号を求める
+	// @param inHandle：歩行者の番号
+	// @return 並びの番号(いなければUINT32_MAX)
+	uint32_t GetIndex(CrowdHandle inHandle) const;
+
+	// @brief 並びの番号の歩行者を末尾の歩行者と入れ替えて外す
+	// @param inIndex：並びの番号
+	void RemoveAt(uint32_t inIndex);
+
+	// @brief セル座標からバケットの番号を求める
+	uint32_t GetBucket(int inX, int inZ) const;
+
+	// @brief 座標をセル座標に直す
+	int ToCell(float inPos) const;
+
+private:
+	// @brief 操舵の設定
+	CrowdParams m_tParams;
+
+	// @brief 位置
+	std::vector<float> m_PosXVec;
+	std::vector<float> m_PosZVec;
+
+	// @brief 速度
+	std::vector<float> m_VelXVec;
+	std::vector<float> m_VelZVec;
+
+	// @brief 操舵で書き込む次のフレームの位置と速度(更新の最後に入れ替える)
+	std::vector<float> m_NextPosXVec;
+	std::vector<float> m_NextPosZVec;
+	std::vector<float> m_NextVelXVec;
+	std::vector<float> m_NextVelZVec;
+
+	// @brief 目標の位置
+	std::vector<float> m_GoalXVec;
+	std::vector<float> m_GoalZVec;
+
+	// @brief 目標があるか(0:その場に止まる)
+	std::vector<uint8_t> m_HasGoalVec;
+
+	// @brief 半径
+	std::vector<float> m_RadiusVec;
+
+	// @brief 最高速度
+	std::vector<float> m_MaxSpeedVec;
+
+	// @brief 群れの番号
+	std::vector<uint32_t> m_GroupVec;
+
+	// @brief 並びの番号から枠の番号
+	std::vector<uint32_t> m_SlotOfVec;
+
+	// @brief 枠の番号から並びの番号(下位20bit)と世代(上位12bit)
+	std::vector<uint32_t> m_SlotVec;
+
+	// @brief 空いている枠の番号
+	std::vector<uint32_t> m_FreeSlotVec;
+
+	// @brief 歩行者毎のバケットの番号
+	std::vector<uint32_t> m_AgentBucketVec;
+
+	// @brief バケット毎の先頭の位置
+	std::vector<uint32_t> m_BucketStartVec;
+
+	// @brief バケット順に並べた歩行者の並びの番号
+	std::vector<uint32_t> m_CellAgentVec;
+
+	// @brief バケット順に並べた位置・速度・半径・群れ(近傍を探す時に並びの番号の配列を読みに行かない)
+	std::vector<float> m_CellPosXVec;
+	std::vector<float> m_CellPosZVec;
+	std::vector<float> m_CellVelXVec;
+	std::vector<float> m_CellVelZVec;
+	std::vector<float> m_CellRadiusVec;
+	std::vector<uint32_t> m_CellGroupVec;
+
+	// @brief 塊毎の集計
+	std::vector<ChunkStats> m_ChunkVec;
+
+	// @brief 今回の更新の塊の数
+	uint32_t m_nChunkNum;
+
+	// @brief 今回の更新の経過時間
+	float m_fDeltaTime;
+
+	// @brief 次に取り出す塊の番号
+	std::atomic<uint32_t> m_nNextChunk;
+
+	// @brief 終わった塊の数
+	std::atomic<uint32_t> m_nDoneChunk;
+
+	// @brief 実行中のジョブの数
+	std::atomic<int> m_nRunningNum;
+
+	// @brief 直前の更新の統計情報
+	CrowdStats m_tStats;
+};
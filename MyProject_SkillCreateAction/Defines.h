@@ -18,6 +18,10 @@ static const float fDeltaTime = 1.0f / fFPS;
 #define TEXTURE_PATH(path) ("Assets/Texture/" path)
 // @brief VF[_[t@CpX
 #define SHADER_PATH(path) ("Assets/Shader/" path)
+// @brief ft@CpX
+#define MODEL_PATH(path) ("Assets/Model/" path)
+// @brief XL`t@CpX
+#define SKILL_PATH(path) ("Assets/Skill/" path)
 
 // 3DԒ`
 #define CMETER(value) (value * 0.01f)
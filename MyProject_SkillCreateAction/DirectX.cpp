@@ -233,16 +233,6 @@ void UninitDirectX()
 	SAFE_RELEASE(g_pDevice);
 }
 
-/*************************//*
-@brief  | `Jn
-*//*************************/
-void BeginDrawDirectX()
-{
-	float color[4] = { 0.8f, 0.9f, 1.0f, 1.0f };
-	g_pRTV->Clear(color);
-	g_pDSV->Clear();
-}
-
 /*************************//*
 @brief  | `I
 *//*************************/
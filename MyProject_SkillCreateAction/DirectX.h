@@ -46,8 +46,6 @@ DepthStencil* GetDefaultDSV();
 HRESULT InitDirectX(HWND hWnd, UINT width, UINT height, bool fullscreen);
 // DirectX̏I
 void UninitDirectX();
-// `Jn
-void BeginDrawDirectX();
 // `I
 void EndDrawDirectX();
 // _[^[QbgAfvXXeV̐ݒ
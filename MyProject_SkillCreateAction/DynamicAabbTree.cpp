@@ -0,0 +1,870 @@
+/**************************************************//*
+	@file	| DynamicAabbTree.cpp
+	@brief	| 動的AABBツリークラスのcppファイル
+	@note	| 1つの葉に1つの箱(プロキシ)を持つBVHを、追加・削除・移動の度に部分的に直す
+			| 葉には実際の範囲より少し広げた範囲(ファットAABB)を持たせ、
+			| 広げた範囲の中で動いている間は木を触らない
+			| 追加と削除の後は高さの差で回転して偏りを直し、
+			| 木の質(表面積の合計)が落ちてきたら葉から全体を作り直す
+*//**************************************************/
+#include "DynamicAabbTree.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+namespace
+{
+	// @brief 作り直す時に箱の中心を振り分ける区間の数
+	constexpr int ce_nBinNum = 12;
+
+	// @brief これより深いノードは箱の数で半分に分ける
+	constexpr uint32_t ce_nMaxSahDepth = 48;
+
+	// @brief 広げた範囲がこの倍率の幅より大きくなったら、止まった箱として範囲を縮める
+	constexpr float ce_fShrinkScale = 4.0f;
+
+	// @brief AABBの表面積の半分
+	float HalfArea(const float* inMin, const float* inMax)
+	{
+		float fX = inMax[0] - inMin[0], fY = inMax[1] - inMin[1], fZ = inMax[2] - inMin[2];
+		return fX * fY + fY * fZ + fZ * fX;
+	}
+
+	// @brief 2つのAABBをまとめたAABBの表面積の半分
+	float HalfAreaUnion(const AabbTreeNode& inA, const float* inMin, const float* inMax)
+	{
+		float fMin[3], fMax[3];
+		for (int k = 0; k < 3; k++)
+		{
+			fMin[k] = (std::min)(inA.m_fMin[k], inMin[k]);
+			fMax[k] = (std::max)(inA.m_fMax[k], inMax[k]);
+		}
+		return HalfArea(fMin, fMax);
+	}
+
+	// @brief 子の範囲と高さとレイヤーのビットから親の範囲と高さとレイヤーのビットを求める
+	void Combine(AabbTreeNode& outParent, const AabbTreeNode& inA, const AabbTreeNode& inB)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			outParent.m_fMin[k] = (std::min)(inA.m_fMin[k], inB.m_fMin[k]);
+			outParent.m_fMax[k] = (std::max)(inA.m_fMax[k], inB.m_fMax[k]);
+		}
+		outParent.m_nHeight = 1 + (std::max)(inA.m_nHeight, inB.m_nHeight);
+		outParent.m_nLayerBits = inA.m_nLayerBits | inB.m_nLayerBits;
+	}
+
+	// @brief 範囲inOuterが範囲inMin～inMaxを含んでいるか
+	bool Contains(const float* inOuterMin, const float* inOuterMax, const float* inMin, const float* inMax)
+	{
+		return inOuterMin[0] <= inMin[0] && inOuterMin[1] <= inMin[1] && inOuterMin[2] <= inMin[2]
+			&& inOuterMax[0] >= inMax[0] && inOuterMax[1] >= inMax[1] && inOuterMax[2] >= inMax[2];
+	}
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CDynamicAabbTree::CDynamicAabbTree()
+	: m_NodeVec{}
+	, m_nRoot(ce_nNull)
+	, m_nFreeNode(ce_nNull)
+	, m_nProxyNum(0)
+	, m_fMargin(ce_fDefaultMargin)
+	, m_LeafVec{}
+	, m_fBaseAreaRatio(0.0f)
+	, m_nUpdateCount(0)
+	, m_tCount{}
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CDynamicAabbTree::~CDynamicAabbTree()
+{
+}
+
+/****************************************//*
+	@brief　	| 箱を追加する
+	@param　	| inMin：最小(XYZ)
+	@param　	| inMax：最大(XYZ)
+	@param　	| inUserData：使う側が自由に使う値
+	@return		| 葉のノードの番号
+*//****************************************/
+uint32_t CDynamicAabbTree::CreateProxy(const float* inMin, const float* inMax, uint32_t inUserData)
+{
+	uint32_t nProxy = AllocateNode();
+	AabbTreeNode& tNode = m_NodeVec[nProxy];
+	for (int k = 0; k < 3; k++)
+	{
+		tNode.m_fMin[k] = inMin[k] - m_fMargin;
+		tNode.m_fMax[k] = inMax[k] + m_fMargin;
+	}
+	tNode.m_nHeight = 0;
+	tNode.m_nUserData = inUserData;
+
+	InsertLeaf(nProxy);
+	m_nProxyNum++;
+	return nProxy;
+}
+
+/****************************************//*
+	@brief　	| 箱を削除する
+	@param　	| inProxy：葉のノードの番号
+*//****************************************/
+void CDynamicAabbTree::DestroyProxy(uint32_t inProxy)
+{
+	RemoveLeaf(inProxy);
+	FreeNode(inProxy);
+	m_nProxyNum--;
+}
+
+/****************************************//*
+	@brief　	| 箱を動かす
+	@param　	| inProxy：葉のノードの番号
+	@param　	| inMin：動いた後の最小(XYZ)
+	@param　	| inMax：動いた後の最大(XYZ)
+	@param　	| inDisplacement：今回の移動量(XYZ、nullptrなら予測しない)
+	@return		| true:入れ直した false:広げた範囲の中なので何もしていない
+*//****************************************/
+bool CDynamicAabbTree::MoveProxy(uint32_t inProxy, const float* inMin, const float* inMax, const float* inDisplacement)
+{
+	m_tCount.m_nMoveNum++;
+
+	// 広げた範囲の中にいて、範囲が大きくなりすぎていなければ何もしない(速く動いた後に止まった箱は縮める)
+	AabbTreeNode& tNode = m_NodeVec[inProxy];
+	float fHugeMin[3], fHugeMax[3];
+	for (int k = 0; k < 3; k++)
+	{
+		fHugeMin[k] = inMin[k] - m_fMargin * ce_fShrinkScale;
+		fHugeMax[k] = inMax[k] + m_fMargin * ce_fShrinkScale;
+	}
+	if (Contains(tNode.m_fMin, tNode.m_fMax, inMin, inMax) && Contains(fHugeMin, fHugeMax, tNode.m_fMin, tNode.m_fMax)) return false;
+
+	RemoveLeaf(inProxy);
+
+	// 動いている向きには移動量の分だけ先まで広げておく
+	AabbTreeNode& tMoved = m_NodeVec[inProxy];
+	for (int k = 0; k < 3; k++)
+	{
+		tMoved.m_fMin[k] = inMin[k] - m_fMargin;
+		tMoved.m_fMax[k] = inMax[k] + m_fMargin;
+		if (!inDisplacement) continue;
+
+		float fAhead = inDisplacement[k] * ce_fDisplacementScale;
+		if (fAhead < 0.0f) tMoved.m_fMin[k] += fAhead;
+		else tMoved.m_fMax[k] += fAhead;
+	}
+
+	InsertLeaf(inProxy);
+	m_tCount.m_nReinsertNum++;
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 箱のレイヤーを設定する
+	@param　	| inProxy：葉のノードの番号
+	@param　	| inLayerBits：レイヤーのビット(追加した時は全てのビット)
+	@note		| 親をたどって枝のレイヤーのビットを直す
+*//****************************************/
+void CDynamicAabbTree::SetProxyLayer(uint32_t inProxy, uint32_t inLayerBits)
+{
+	if (m_NodeVec[inProxy].m_nLayerBits == inLayerBits) return;
+
+	// 範囲と形は変わらないので、ビットが変わらなくなった所で止める
+	m_NodeVec[inProxy].m_nLayerBits = inLayerBits;
+	uint32_t nIndex = m_NodeVec[inProxy].m_nParent;
+	while (nIndex != ce_nNull)
+	{
+		AabbTreeNode& tNode = m_NodeVec[nIndex];
+		uint32_t nLayerBits = m_NodeVec[tNode.m_nChild[0]].m_nLayerBits | m_NodeVec[tNode.m_nChild[1]].m_nLayerBits;
+		if (tNode.m_nLayerBits == nLayerBits) break;
+		tNode.m_nLayerBits = nLayerBits;
+		nIndex = tNode.m_nParent;
+	}
+}
+
+/****************************************//*
+	@brief　	| 全ての箱を削除する
+*//****************************************/
+void CDynamicAabbTree::Clear()
+{
+	m_NodeVec.clear();
+	m_nRoot = ce_nNull;
+	m_nFreeNode = ce_nNull;
+	m_nProxyNum = 0;
+	m_fBaseAreaRatio = 0.0f;
+}
+
+/****************************************//*
+	@brief　	| 更新
+	@note		| 一定の間隔で木の質を確かめて、落ちていれば全体を作り直す
+*//****************************************/
+void CDynamicAabbTree::Update()
+{
+	if (++m_nUpdateCount % ce_nRebuildCheckInterval == 0 && m_nProxyNum > 2)
+	{
+		// まだ作り直していなければ、追加した順で決まった形なので一度作り直して基準にする
+		float fRatio = ComputeAreaRatio();
+		if (m_fBaseAreaRatio <= 0.0f || fRatio > m_fBaseAreaRatio * ce_fRebuildRatio)
+		{
+			Rebuild();
+			fRatio = m_fBaseAreaRatio;
+		}
+		m_tCount.m_fAreaRatio = fRatio;
+	}
+	else
+	{
+		m_tCount.m_fAreaRatio = m_tStats.m_fAreaRatio;
+	}
+
+	m_tCount.m_nProxyNum = static_cast<int>(m_nProxyNum);
+	m_tCount.m_nHeight = GetHeight();
+	m_tStats = m_tCount;
+	m_tCount = {};
+}
+
+/****************************************//*
+	@brief　	| 葉から全体を作り直す
+*//****************************************/
+void CDynamicAabbTree::Rebuild()
+{
+	if (m_nRoot == ce_nNull) return;
+
+	// 葉を集め、枝のノードは全て空きに戻す
+	m_LeafVec.clear();
+	for (uint32_t i = 0; i < m_NodeVec.size(); i++)
+	{
+		AabbTreeNode& tNode = m_NodeVec[i];
+		if (tNode.m_nHeight < 0) continue;
+
+		if (tNode.IsLeaf())
+		{
+			tNode.m_nParent = ce_nNull;
+			m_LeafVec.push_back(i);
+		}
+		else
+		{
+			FreeNode(i);
+		}
+	}
+
+	m_nRoot = BuildRange(0, static_cast<uint32_t>(m_LeafVec.size()), 0);
+	m_NodeVec[m_nRoot].m_nParent = ce_nNull;
+	m_fBaseAreaRatio = ComputeAreaRatio();
+	m_tCount.m_nRebuildNum++;
+}
+
+/****************************************//*
+	@brief　	| 葉の範囲をまとめて枝を作る
+	@param　	| inStart：m_LeafVecの最初の番号
+	@param　	| inCount：葉の数
+	@param　	| inDepth：根からの深さ
+	@return		| 作ったノードの番号
+*//****************************************/
+uint32_t CDynamicAabbTree::BuildRange(uint32_t inStart, uint32_t inCount, uint32_t inDepth)
+{
+	if (inCount == 1) return m_LeafVec[inStart];
+
+	const uint32_t nEnd = inStart + inCount;
+	float fCenterMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, fCenterMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (uint32_t i = inStart; i < nEnd; i++)
+	{
+		const AabbTreeNode& tLeaf = m_NodeVec[m_LeafVec[i]];
+		for (int k = 0; k < 3; k++)
+		{
+			float fCenter = (tLeaf.m_fMin[k] + tLeaf.m_fMax[k]) * 0.5f;
+			fCenterMin[k] = (std::min)(fCenterMin[k], fCenter);
+			fCenterMax[k] = (std::max)(fCenterMax[k], fCenter);
+		}
+	}
+
+	// 表面積と葉の数の積が一番小さくなる軸と区間の境目を探す
+	int nBestAxis = -1;
+	int nBestBin = 0;
+	float fBestCost = FLT_MAX;
+	if (inDepth < ce_nMaxSahDepth)
+	{
+		for (int nAxis = 0; nAxis < 3; nAxis++)
+		{
+			float fExtent = fCenterMax[nAxis] - fCenterMin[nAxis];
+			if (fExtent <= 0.0f) continue;
+
+			uint32_t nBinCount[ce_nBinNum] = {};
+			float fBinMin[ce_nBinNum][3], fBinMax[ce_nBinNum][3];
+			for (int b = 0; b < ce_nBinNum; b++)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					fBinMin[b][k] = FLT_MAX;
+					fBinMax[b][k] = -FLT_MAX;
+				}
+			}
+
+			float fScale = ce_nBinNum / fExtent;
+			for (uint32_t i = inStart; i < nEnd; i++)
+			{
+				const AabbTreeNode& tLeaf = m_NodeVec[m_LeafVec[i]];
+				float fCenter = (tLeaf.m_fMin[nAxis] + tLeaf.m_fMax[nAxis]) * 0.5f;
+				int nBin = (std::min)(static_cast<int>((fCenter - fCenterMin[nAxis]) * fScale), ce_nBinNum - 1);
+				nBinCount[nBin]++;
+				for (int k = 0; k < 3; k++)
+				{
+					fBinMin[nBin][k] = (std::min)(fBinMin[nBin][k], tLeaf.m_fMin[k]);
+					fBinMax[nBin][k] = (std::max)(fBinMax[nBin][k], tLeaf.m_fMax[k]);
+				}
+			}
+
+			// 右側から積み上げた表面積と数
+			float fRightArea[ce_nBinNum];
+			uint32_t nRightCount[ce_nBinNum];
+			float fAccMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, fAccMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+			uint32_t nAcc = 0;
+			for (int b = ce_nBinNum - 1; b > 0; b--)
+			{
+				nAcc += nBinCount[b];
+				for (int k = 0; k < 3; k++)
+				{
+					fAccMin[k] = (std::min)(fAccMin[k], fBinMin[b][k]);
+					fAccMax[k] = (std::max)(fAccMax[k], fBinMax[b][k]);
+				}
+				nRightCount[b] = nAcc;
+				fRightArea[b] = nAcc ? HalfArea(fAccMin, fAccMax) : 0.0f;
+			}
+
+			// 左側から積み上げながら、区間bの右で分けた時の評価値を求める
+			for (int k = 0; k < 3; k++)
+			{
+				fAccMin[k] = FLT_MAX;
+				fAccMax[k] = -FLT_MAX;
+			}
+			nAcc = 0;
+			for (int b = 0; b < ce_nBinNum - 1; b++)
+			{
+				nAcc += nBinCount[b];
+				for (int k = 0; k < 3; k++)
+				{
+					fAccMin[k] = (std::min)(fAccMin[k], fBinMin[b][k]);
+					fAccMax[k] = (std::max)(fAccMax[k], fBinMax[b][k]);
+				}
+				if (nAcc == 0 || nRightCount[b + 1] == 0) continue;
+
+				float fCost = HalfArea(fAccMin, fAccMax) * nAcc + fRightArea[b + 1] * nRightCount[b + 1];
+				if (fCost < fBestCost)
+				{
+					fBestCost = fCost;
+					nBestAxis = nAxis;
+					nBestBin = b;
+				}
+			}
+		}
+	}
+
+	uint32_t nMid = inStart;
+	if (nBestAxis >= 0)
+	{
+		float fScale = ce_nBinNum / (fCenterMax[nBestAxis] - fCenterMin[nBestAxis]);
+		float fCenterBase = fCenterMin[nBestAxis];
+		auto itMid = std::partition(m_LeafVec.begin() + inStart, m_LeafVec.begin() + nEnd, [&](uint32_t inLeaf)
+			{
+				const AabbTreeNode& tLeaf = m_NodeVec[inLeaf];
+				float fCenter = (tLeaf.m_fMin[nBestAxis] + tLeaf.m_fMax[nBestAxis]) * 0.5f;
+				return (std::min)(static_cast<int>((fCenter - fCenterBase) * fScale), ce_nBinNum - 1) <= nBestBin;
+			});
+		nMid = static_cast<uint32_t>(itMid - m_LeafVec.begin());
+	}
+
+	// 分けられない(中心が全て同じ、深すぎる)場合は最も広い軸で数を半分に分ける
+	if (nMid == inStart || nMid == nEnd)
+	{
+		int nAxis = 0;
+		for (int k = 1; k < 3; k++)
+		{
+			if (fCenterMax[k] - fCenterMin[k] > fCenterMax[nAxis] - fCenterMin[nAxis]) nAxis = k;
+		}
+		nMid = inStart + inCount / 2;
+		std::nth_element(m_LeafVec.begin() + inStart, m_LeafVec.begin() + nMid, m_LeafVec.begin() + nEnd, [&](uint32_t inA, uint32_t inB)
+			{
+				return m_NodeVec[inA].m_fMin[nAxis] + m_NodeVec[inA].m_fMax[nAxis] < m_NodeVec[inB].m_fMin[nAxis] + m_NodeVec[inB].m_fMax[nAxis];
+			});
+	}
+
+	uint32_t nLeft = BuildRange(inStart, nMid - inStart, inDepth + 1);
+	uint32_t nRight = BuildRange(nMid, nEnd - nMid, inDepth + 1);
+
+	// ノードを取り出すと配列が伸びて参照が無効になるため、子を作った後に取り出す
+	uint32_t nNode = AllocateNode();
+	AabbTreeNode& tNode = m_NodeVec[nNode];
+	tNode.m_nChild[0] = nLeft;
+	tNode.m_nChild[1] = nRight;
+	Combine(tNode, m_NodeVec[nLeft], m_NodeVec[nRight]);
+	m_NodeVec[nLeft].m_nParent = nNode;
+	m_NodeVec[nRight].m_nParent = nNode;
+	return nNode;
+}
+
+/****************************************//*
+	@brief　	| 枝のノードの表面積の合計と根の表面積の比を求める
+	@return		| 表面積の比(枝が無ければ0)
+*//****************************************/
+float CDynamicAabbTree::ComputeAreaRatio() const
+{
+	if (m_nRoot == ce_nNull) return 0.0f;
+
+	const AabbTreeNode& tRoot = m_NodeVec[m_nRoot];
+	float fRootArea = HalfArea(tRoot.m_fMin, tRoot.m_fMax);
+	if (fRootArea <= 0.0f) return 0.0f;
+
+	float fTotalArea = 0.0f;
+	for (const AabbTreeNode& tNode : m_NodeVec)
+	{
+		if (tNode.m_nHeight <= 0) continue;
+		fTotalArea += HalfArea(tNode.m_fMin, tNode.m_fMax);
+	}
+	return fTotalArea / fRootArea;
+}
+
+/****************************************//*
+	@brief　	| 空きノードを取り出す
+	@return		| ノードの番号
+*//****************************************/
+uint32_t CDynamicAabbTree::AllocateNode()
+{
+	uint32_t nNode = m_nFreeNode;
+	if (nNode == ce_nNull)
+	{
+		nNode = static_cast<uint32_t>(m_NodeVec.size());
+		m_NodeVec.push_back({});
+	}
+	else
+	{
+		m_nFreeNode = m_NodeVec[nNode].m_nParent;
+	}
+
+	AabbTreeNode& tNode = m_NodeVec[nNode];
+	tNode.m_nParent = ce_nNull;
+	tNode.m_nChild[0] = ce_nNull;
+	tNode.m_nChild[1] = ce_nNull;
+	tNode.m_nHeight = 0;
+	tNode.m_nUserData = 0;
+	tNode.m_nLayerBits = UINT32_MAX;
+	return nNode;
+}
+
+/****************************************//*
+	@brief　	| ノードを空きに戻す
+	@param　	| inNode：ノードの番号
+*//****************************************/
+void CDynamicAabbTree::FreeNode(uint32_t inNode)
+{
+	m_NodeVec[inNode].m_nParent = m_nFreeNode;
+	m_NodeVec[inNode].m_nHeight = -1;
+	m_nFreeNode = inNode;
+}
+
+/****************************************//*
+	@brief　	| 葉を木に入れる
+	@param　	| inLeaf：葉のノードの番号
+	@note		| 根から、まとめた時に増える表面積が一番小さくなる兄弟を探して隣に入れる
+*//****************************************/
+void CDynamicAabbTree::InsertLeaf(uint32_t inLeaf)
+{
+	if (m_nRoot == ce_nNull)
+	{
+		m_nRoot = inLeaf;
+		m_NodeVec[inLeaf].m_nParent = ce_nNull;
+		return;
+	}
+
+	const float* pMin = m_NodeVec[inLeaf].m_fMin;
+	const float* pMax = m_NodeVec[inLeaf].m_fMax;
+	uint32_t nIndex = m_nRoot;
+	while (!m_NodeVec[nIndex].IsLeaf())
+	{
+		const AabbTreeNode& tNode = m_NodeVec[nIndex];
+		float fArea = HalfArea(tNode.m_fMin, tNode.m_fMax);
+		float fCombinedArea = HalfAreaUnion(tNode, pMin, pMax);
+
+		// ここに新しい親を作る場合の費用と、下に降りる場合に上の階層で必ず増える費用
+		float fCost = 2.0f * fCombinedArea;
+		float fInheritCost = 2.0f * (fCombinedArea - fArea);
+
+		float fChildCost[2];
+		for (int c = 0; c < 2; c++)
+		{
+			const AabbTreeNode& tChild = m_NodeVec[tNode.m_nChild[c]];
+			float fChildArea = HalfAreaUnion(tChild, pMin, pMax);
+			fChildCost[c] = (tChild.IsLeaf() ? fChildArea : fChildArea - HalfArea(tChild.m_fMin, tChild.m_fMax)) + fInheritCost;
+		}
+
+		if (fCost < fChildCost[0] && fCost < fChildCost[1]) break;
+		nIndex = (fChildCost[0] < fChildCost[1]) ? tNode.m_nChild[0] : tNode.m_nChild[1];
+	}
+
+	// 兄弟と自分をまとめる親を作る
+	uint32_t nSibling = nIndex;
+	uint32_t nOldParent = m_NodeVec[nSibling].m_nParent;
+	uint32_t nNewParent = AllocateNode();
+	AabbTreeNode& tNewParent = m_NodeVec[nNewParent];
+	tNewParent.m_nParent = nOldParent;
+	tNewParent.m_nChild[0] = nSibling;
+	tNewParent.m_nChild[1] = inLeaf;
+	Combine(tNewParent, m_NodeVec[nSibling], m_NodeVec[inLeaf]);
+	m_NodeVec[nSibling].m_nParent = nNewParent;
+	m_NodeVec[inLeaf].m_nParent = nNewParent;
+
+	if (nOldParent == ce_nNull)
+	{
+		m_nRoot = nNewParent;
+	}
+	else
+	{
+		AabbTreeNode& tOldParent = m_NodeVec[nOldParent];
+		tOldParent.m_nChild[(tOldParent.m_nChild[0] == nSibling) ? 0 : 1] = nNewParent;
+	}
+
+	Refit(nOldParent);
+}
+
+/****************************************//*
+	@brief　	| 葉を木から外す
+	@param　	| inLeaf：葉のノードの番号
+	@note		| 親を外して兄弟を祖父母に繋ぎ直す
+*//****************************************/
+void CDynamicAabbTree::RemoveLeaf(uint32_t inLeaf)
+{
+	if (inLeaf == m_nRoot)
+	{
+		m_nRoot = ce_nNull;
+		return;
+	}
+
+	uint32_t nParent = m_NodeVec[inLeaf].m_nParent;
+	const AabbTreeNode& tParent = m_NodeVec[nParent];
+	uint32_t nGrandParent = tParent.m_nParent;
+	uint32_t nSibling = (tParent.m_nChild[0] == inLeaf) ? tParent.m_nChild[1] : tParent.m_nChild[0];
+
+	m_NodeVec[nSibling].m_nParent = nGrandParent;
+	FreeNode(nParent);
+	if (nGrandParent == ce_nNull)
+	{
+		m_nRoot = nSibling;
+		return;
+	}
+
+	AabbTreeNode& tGrandParent = m_NodeVec[nGrandParent];
+	tGrandParent.m_nChild[(tGrandParent.m_nChild[0] == nParent) ? 0 : 1] = nSibling;
+	Refit(nGrandParent);
+}
+
+/****************************************//*
+	@brief　	| 親をたどって範囲と高さを直す
+	@param　	| inNode：直し始めるノードの番号
+*//****************************************/
+void CDynamicAabbTree::Refit(uint32_t inNode)
+{
+	uint32_t nIndex = inNode;
+	while (nIndex != ce_nNull)
+	{
+		nIndex = Balance(nIndex);
+
+		AabbTreeNode& tNode = m_NodeVec[nIndex];
+		Combine(tNode, m_NodeVec[tNode.m_nChild[0]], m_NodeVec[tNode.m_nChild[1]]);
+		nIndex = tNode.m_nParent;
+	}
+}
+
+/****************************************//*
+	@brief　	| 子の高さの差が2以上なら回転して偏りを直す
+	@param　	| inNode：ノードの番号
+	@return		| 回転後にその位置にあるノードの番号
+	@note		| 高い方の子(C)をこのノード(A)の位置に上げ、
+				| Cの子のうち高い方をCに残し、低い方をAに渡す
+*//****************************************/
+uint32_t CDynamicAabbTree::Balance(uint32_t inNode)
+{
+	const uint32_t nA = inNode;
+	AabbTreeNode& tA = m_NodeVec[nA];
+	if (tA.IsLeaf() || tA.m_nHeight < 2) return nA;
+
+	int nBalance = m_NodeVec[tA.m_nChild[1]].m_nHeight - m_NodeVec[tA.m_nChild[0]].m_nHeight;
+	if (nBalance >= -1 && nBalance <= 1) return nA;
+
+	// 上げる子(C)と残る子(B)
+	const int nUp = (nBalance > 1) ? 1 : 0;
+	const uint32_t nC = tA.m_nChild[nUp];
+	const uint32_t nB = tA.m_nChild[1 - nUp];
+	AabbTreeNode& tC = m_NodeVec[nC];
+	const uint32_t nF = tC.m_nChild[0];
+	const uint32_t nG = tC.m_nChild[1];
+
+	// CをAの位置に上げる
+	tC.m_nChild[0] = nA;
+	tC.m_nParent = tA.m_nParent;
+	tA.m_nParent = nC;
+	if (tC.m_nParent == ce_nNull)
+	{
+		m_nRoot = nC;
+	}
+	else
+	{
+		AabbTreeNode& tParent = m_NodeVec[tC.m_nParent];
+		tParent.m_nChild[(tParent.m_nChild[0] == nA) ? 0 : 1] = nC;
+	}
+
+	// Cの子のうち高い方はCに残し、低い方はCがいた位置(Aの子)に入れる
+	const bool bKeepF = m_NodeVec[nF].m_nHeight > m_NodeVec[nG].m_nHeight;
+	const uint32_t nKeep = bKeepF ? nF : nG;
+	const uint32_t nMove = bKeepF ? nG : nF;
+	tC.m_nChild[1] = nKeep;
+	tA.m_nChild[nUp] = nMove;
+	m_NodeVec[nMove].m_nParent = nA;
+
+	Combine(tA, m_NodeVec[nB], m_NodeVec[nMove]);
+	Combine(tC, tA, m_NodeVec[nKeep]);
+	m_tCount.m_nRotateNum++;
+	return nC;
+}
+
+/****************************************//*
+	@brief　	| 親子の繋がり、高さ、範囲、レイヤーのビットが正しいか確かめる
+	@return		| true:正しい false:壊れている
+*//****************************************/
+bool CDynamicAabbTree::Validate() const
+{
+	if (m_nRoot == ce_nNull) return m_nProxyNum == 0;
+	if (m_NodeVec[m_nRoot].m_nParent != ce_nNull) return false;
+
+	uint32_t nLeafNum = 0;
+	uint32_t nStack[ce_nStackSize];
+	int nTop = 0;
+	nStack[nTop++] = m_nRoot;
+	while (nTop > 0)
+	{
+		uint32_t nIndex = nStack[--nTop];
+		const AabbTreeNode& tNode = m_NodeVec[nIndex];
+		if (tNode.IsLeaf())
+		{
+			if (tNode.m_nHeight != 0) return false;
+			nLeafNum++;
+			continue;
+		}
+
+		const AabbTreeNode& tLeft = m_NodeVec[tNode.m_nChild[0]];
+		const AabbTreeNode& tRight = m_NodeVec[tNode.m_nChild[1]];
+		if (tLeft.m_nParent != nIndex || tRight.m_nParent != nIndex) return false;
+		if (tNode.m_nHeight != 1 + (std::max)(tLeft.m_nHeight, tRight.m_nHeight)) return false;
+		if (!Contains(tNode.m_fMin, tNode.m_fMax, tLeft.m_fMin, tLeft.m_fMax)) return false;
+		if (!Contains(tNode.m_fMin, tNode.m_fMax, tRight.m_fMin, tRight.m_fMax)) return false;
+		if (tNode.m_nLayerBits != (tLeft.m_nLayerBits | tRight.m_nLayerBits)) return false;
+		if (nTop + 2 > ce_nStackSize) return false;
+
+		nStack[nTop++] = tNode.m_nChild[0];
+		nStack[nTop++] = tNode.m_nChild[1];
+	}
+	return nLeafNum == m_nProxyNum;
+}
+
+/****************************************//*
+	@brief　	| 動く箱の割合を変えて更新の負荷を計測して書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CDynamicAabbTree::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr uint32_t ce_nBoxNum = 20000;
+	static constexpr int ce_nFrameNum = 300;
+	static constexpr uint32_t ce_nQueryNum = 2000;
+	static constexpr float ce_fMapSize = 1024.0f;
+	static constexpr float ce_fQueryHalf = 8.0f;
+	static constexpr float ce_fSpeed = 6.0f;
+	static constexpr float ce_fDeltaTime = 1.0f / 60.0f;
+	char szLine[256];
+	bool bSuccess = true;
+
+	std::mt19937 tRandom(20261019);
+	std::uniform_real_distribution<float> tPos(0.0f, ce_fMapSize);
+	std::uniform_real_distribution<float> tHeight(0.0f, 8.0f);
+	std::uniform_real_distribution<float> tHalf(0.5f, 3.0f);
+	std::uniform_real_distribution<float> tAngle(0.0f, 6.2831853f);
+
+	// 箱の配置と向き(動く箱はこの向きに進み、マップの端で折り返す)
+	struct Box
+	{
+		float m_fMin[3];
+		float m_fMax[3];
+		float m_fVelocity[3];
+	};
+	std::vector<Box> tBaseVec(ce_nBoxNum);
+	for (Box& tBox : tBaseVec)
+	{
+		float fX = tPos(tRandom), fY = tHeight(tRandom), fZ = tPos(tRandom);
+		float fHalfX = tHalf(tRandom), fHalfY = tHalf(tRandom), fHalfZ = tHalf(tRandom);
+		float fAngle = tAngle(tRandom);
+		tBox = { { fX - fHalfX, fY - fHalfY, fZ - fHalfZ }, { fX + fHalfX, fY + fHalfY, fZ + fHalfZ },
+			{ cosf(fAngle) * ce_fSpeed, 0.0f, sinf(fAngle) * ce_fSpeed } };
+	}
+	std::vector<float> tQueryVec(ce_nQueryNum * 3);
+	for (uint32_t i = 0; i < ce_nQueryNum; i++)
+	{
+		tQueryVec[i * 3 + 0] = tPos(tRandom);
+		tQueryVec[i * 3 + 1] = tHeight(tRandom);
+		tQueryVec[i * 3 + 2] = tPos(tRandom);
+	}
+
+	// 全ての箱を毎フレーム作り直す場合の費用(比較用)
+	double dRebuildMs = 0.0;
+	double dInsertMs = 0.0;
+	{
+		CDynamicAabbTree tTree;
+		auto tStart = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < ce_nBoxNum; i++) tTree.CreateProxy(tBaseVec[i].m_fMin, tBaseVec[i].m_fMax, i);
+		dInsertMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		tStart = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < 10; i++) tTree.Rebuild();
+		dRebuildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count() / 10.0;
+	}
+	sprintf_s(szLine, "box %u  insert all %.3f ms (%.0f ns/box)  full rebuild %.3f ms\n",
+		ce_nBoxNum, dInsertMs, dInsertMs * 1e6 / ce_nBoxNum, dRebuildMs);
+	tReport << szLine;
+
+	// 動く箱の割合毎に、移動と木の更新にかかる時間と検索の速さ
+	for (float fFraction : { 0.0f, 0.01f, 0.05f, 0.1f, 0.25f, 0.5f, 1.0f })
+	{
+		std::vector<Box> tBoxVec = tBaseVec;
+		CDynamicAabbTree tTree;
+		std::vector<uint32_t> tProxyVec(ce_nBoxNum);
+		for (uint32_t i = 0; i < ce_nBoxNum; i++) tProxyVec[i] = tTree.CreateProxy(tBoxVec[i].m_fMin, tBoxVec[i].m_fMax, i);
+		tTree.Rebuild();
+		tTree.Update();
+
+		const uint32_t nMoveNum = static_cast<uint32_t>(ce_nBoxNum * fFraction);
+		double dUpdateMs = 0.0, dMaxMs = 0.0;
+		long long nReinsertNum = 0, nRotateNum = 0;
+		int nRebuildNum = 0;
+		for (int nFrame = 0; nFrame < ce_nFrameNum; nFrame++)
+		{
+			auto tStart = std::chrono::high_resolution_clock::now();
+			for (uint32_t i = 0; i < nMoveNum; i++)
+			{
+				Box& tBox = tBoxVec[i];
+				float fMove[3];
+				for (int k = 0; k < 3; k++)
+				{
+					if ((tBox.m_fMin[k] < 0.0f && tBox.m_fVelocity[k] < 0.0f) || (tBox.m_fMax[k] > ce_fMapSize && tBox.m_fVelocity[k] > 0.0f)) tBox.m_fVelocity[k] = -tBox.m_fVelocity[k];
+					fMove[k] = tBox.m_fVelocity[k] * ce_fDeltaTime;
+					tBox.m_fMin[k] += fMove[k];
+					tBox.m_fMax[k] += fMove[k];
+				}
+				tTree.MoveProxy(tProxyVec[i], tBox.m_fMin, tBox.m_fMax, fMove);
+			}
+			tTree.Update();
+			double dMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+			dUpdateMs += dMs;
+			dMaxMs = (std::max)(dMaxMs, dMs);
+
+			const AabbTreeStats& tStats = tTree.GetStats();
+			nReinsertNum += tStats.m_nReinsertNum;
+			nRotateNum += tStats.m_nRotateNum;
+			nRebuildNum += tStats.m_nRebuildNum;
+		}
+
+		// 最後の配置で、実際の範囲が重なる箱が全て見つかるか総当たりと比べる
+		long long nFoundNum = 0;
+		uint32_t nMissNum = 0;
+		auto tStart = std::chrono::high_resolution_clock::now();
+		for (uint32_t q = 0; q < ce_nQueryNum; q++)
+		{
+			const float* pCenter = &tQueryVec[q * 3];
+			float fMin[3] = { pCenter[0] - ce_fQueryHalf, pCenter[1] - ce_fQueryHalf, pCenter[2] - ce_fQueryHalf };
+			float fMax[3] = { pCenter[0] + ce_fQueryHalf, pCenter[1] + ce_fQueryHalf, pCenter[2] + ce_fQueryHalf };
+			tTree.QueryAabb(fMin, fMax, [&](uint32_t) { nFoundNum++; return true; });
+		}
+		double dQueryMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		std::vector<uint8_t> tFoundVec(ce_nBoxNum);
+		for (uint32_t q = 0; q < ce_nQueryNum / 10; q++)
+		{
+			const float* pCenter = &tQueryVec[q * 3];
+			float fMin[3] = { pCenter[0] - ce_fQueryHalf, pCenter[1] - ce_fQueryHalf, pCenter[2] - ce_fQueryHalf };
+			float fMax[3] = { pCenter[0] + ce_fQueryHalf, pCenter[1] + ce_fQueryHalf, pCenter[2] + ce_fQueryHalf };
+			std::fill(tFoundVec.begin(), tFoundVec.end(), 0);
+			tTree.QueryAabb(fMin, fMax, [&](uint32_t inProxy) { tFoundVec[tTree.GetUserData(inProxy)] = 1; return true; });
+			for (uint32_t i = 0; i < ce_nBoxNum; i++)
+			{
+				if (!tFoundVec[i] && !(tBoxVec[i].m_fMin[0] > fMax[0] || tBoxVec[i].m_fMax[0] < fMin[0] ||
+						tBoxVec[i].m_fMin[1] > fMax[1] || tBoxVec[i].m_fMax[1] < fMin[1] ||
+						tBoxVec[i].m_fMin[2] > fMax[2] || tBoxVec[i].m_fMax[2] < fMin[2])) nMissNum++;
+			}
+		}
+
+		bool bCheck = tTree.Validate() && nMissNum == 0;
+		sprintf_s(szLine, "move %5.1f%% (%5u)  update %.3f ms/frame (max %.3f)  reinsert %.1f/frame  rotate %.1f/frame  rebuild %d\n",
+			fFraction * 100.0f, nMoveNum, dUpdateMs / ce_nFrameNum, dMaxMs,
+			static_cast<double>(nReinsertNum) / ce_nFrameNum, static_cast<double>(nRotateNum) / ce_nFrameNum, nRebuildNum);
+		tReport << szLine;
+		sprintf_s(szLine, "                      height %d  area ratio %.1f  query %.2f us (%.1f found)  validate %s\n",
+			tTree.GetHeight(), tTree.ComputeAreaRatio(), dQueryMs * 1e3 / ce_nQueryNum,
+			static_cast<double>(nFoundNum) / ce_nQueryNum, bCheck ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bCheck;
+	}
+
+	// 追加と削除とレイヤーの変更を繰り返しても壊れず、レイヤーで絞った検索が絞らない検索と一致すること
+	{
+		CDynamicAabbTree tTree;
+		std::vector<uint32_t> tProxyVec;
+		std::uniform_int_distribution<int> tCoin(0, 2);
+		bool bCheck = true;
+		for (int i = 0; i < 20000; i++)
+		{
+			if (tProxyVec.empty() || tCoin(tRandom) != 0)
+			{
+				const Box& tBox = tBaseVec[i % ce_nBoxNum];
+				tProxyVec.push_back(tTree.CreateProxy(tBox.m_fMin, tBox.m_fMax, i));
+				tTree.SetProxyLayer(tProxyVec.back(), 1u << (i % 4));
+			}
+			else if (tCoin(tRandom) == 0)
+			{
+				tTree.SetProxyLayer(tProxyVec[tRandom() % tProxyVec.size()], 1u << (tRandom() % 4));
+			}
+			else
+			{
+				size_t nPick = tRandom() % tProxyVec.size();
+				tTree.DestroyProxy(tProxyVec[nPick]);
+				tProxyVec[nPick] = tProxyVec.back();
+				tProxyVec.pop_back();
+			}
+			if (i % 5000 == 4999) bCheck &= tTree.Validate();
+		}
+
+		uint32_t nMaskMissNum = 0;
+		for (uint32_t q = 0; q < ce_nQueryNum / 10; q++)
+		{
+			const float* pCenter = &tQueryVec[q * 3];
+			float fMin[3] = { pCenter[0] - ce_fQueryHalf, pCenter[1] - ce_fQueryHalf, pCenter[2] - ce_fQueryHalf };
+			float fMax[3] = { pCenter[0] + ce_fQueryHalf, pCenter[1] + ce_fQueryHalf, pCenter[2] + ce_fQueryHalf };
+			const uint32_t nMask = 1u + q % 15;
+			int nMaskedNum = 0, nFilteredNum = 0;
+			tTree.QueryAabb(fMin, fMax, nMask, [&](uint32_t) { nMaskedNum++; return true; });
+			tTree.QueryAabb(fMin, fMax, [&](uint32_t inProxy) { nFilteredNum += (tTree.GetNode(inProxy).m_nLayerBits & nMask) ? 1 : 0; return true; });
+			if (nMaskedNum != nFilteredNum) nMaskMissNum++;
+		}
+		bCheck &= nMaskMissNum == 0;
+		sprintf_s(szLine, "insert/remove/layer 20000 ops  proxy %u  height %d  mask miss %u  validate %s\n", tTree.GetProxyNum(), tTree.GetHeight(), nMaskMissNum, bCheck ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bCheck;
+	}
+
+	return bSuccess ? 0 : 1;
+}
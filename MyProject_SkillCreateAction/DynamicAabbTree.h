@@ -0,0 +1,277 @@
+/**************************************************//*
+	@file	| DynamicAabbTree.h
+	@brief	| 動的AABBツリークラスのhファイル
+	@note	| 1つの葉に1つの箱(プロキシ)を持つBVHを、追加・削除・移動の度に部分的に直す
+			| 葉には実際の範囲より少し広げた範囲(ファットAABB)を持たせ、
+			| 広げた範囲の中で動いている間は木を触らない
+			| 追加と削除の後は高さの差で回転して偏りを直し、
+			| 木の質(表面積の合計)が落ちてきたら葉から全体を作り直す
+*//**************************************************/
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// @brief 動的AABBツリーのノード
+struct AabbTreeNode
+{
+	// 範囲の最小(XYZ、葉はファットAABB)
+	float m_fMin[3];
+
+	// 範囲の最大(XYZ、葉はファットAABB)
+	float m_fMax[3];
+
+	// 親のノードの番号(空きノードは次の空きノードの番号)
+	uint32_t m_nParent;
+
+	// 子のノードの番号(葉はどちらもCDynamicAabbTree::ce_nNull)
+	uint32_t m_nChild[2];
+
+	// 葉からの高さ(葉:0 空き:-1)
+	int32_t m_nHeight;
+
+	// 使う側が自由に使う値(葉のみ)
+	uint32_t m_nUserData;
+
+	// レイヤーのビット(葉は箱のレイヤー、枝は子孫の葉のレイヤーをまとめたもの)
+	uint32_t m_nLayerBits;
+
+	// @brief 葉かどうか
+	bool IsLeaf() const { return m_nChild[0] == UINT32_MAX; }
+};
+
+// @brief 動的AABBツリーの統計情報(直前の更新から次の更新まで)
+struct AabbTreeStats
+{
+	// 葉の数
+	int m_nProxyNum;
+
+	// 木の高さ
+	int m_nHeight;
+
+	// 移動の回数
+	int m_nMoveNum;
+
+	// 広げた範囲から出て入れ直した回数
+	int m_nReinsertNum;
+
+	// 偏りを直すための回転の回数
+	int m_nRotateNum;
+
+	// 全体を作り直した回数
+	int m_nRebuildNum;
+
+	// 枝のノードの表面積の合計と根の表面積の比(小さいほど検索が速い)
+	float m_fAreaRatio;
+};
+
+// @brief 動的AABBツリークラス
+class CDynamicAabbTree
+{
+public:
+	// @brief 無効なノードの番号
+	static constexpr uint32_t ce_nNull = UINT32_MAX;
+
+	// @brief 実際の範囲を広げる幅の初期値
+	static constexpr float ce_fDefaultMargin = 0.25f;
+
+	// @brief 移動量の何倍先まで範囲を広げておくか
+	static constexpr float ce_fDisplacementScale = 2.0f;
+
+	// @brief 木の質を確かめる間隔(更新の回数)
+	static constexpr uint32_t ce_nRebuildCheckInterval = 60;
+
+	// @brief 作り直した直後に比べて表面積の比がこの倍率を超えたら作り直す
+	static constexpr float ce_fRebuildRatio = 1.3f;
+
+	// @brief 辿る時のスタックの大きさ(回転と作り直しで高さを抑えている)
+	static constexpr int ce_nStackSize = 256;
+
+public:
+	// @brief コンストラクタ
+	CDynamicAabbTree();
+
+	// @brief デストラクタ
+	~CDynamicAabbTree();
+
+	// @brief 実際の範囲を広げる幅を設定
+	// @param inMargin：幅
+	// @note 次に入れ直す葉から反映される
+	void SetMargin(float inMargin) { m_fMargin = inMargin; }
+
+	// @brief 箱を追加する
+	// @param inMin：最小(XYZ)
+	// @param inMax：最大(XYZ)
+	// @param inUserData：使う側が自由に使う値
+	// @return 葉のノードの番号
+	uint32_t CreateProxy(const float* inMin, const float* inMax, uint32_t inUserData);
+
+	// @brief 箱を削除する
+	// @param inProxy：葉のノードの番号
+	void DestroyProxy(uint32_t inProxy);
+
+	// @brief 箱を動かす
+	// @param inProxy：葉のノードの番号
+	// @param inMin：動いた後の最小(XYZ)
+	// @param inMax：動いた後の最大(XYZ)
+	// @param inDisplacement：今回の移動量(XYZ、nullptrなら予測しない)
+	// @return true:入れ直した false:広げた範囲の中なので何もしていない
+	bool MoveProxy(uint32_t inProxy, const float* inMin, const float* inMax, const float* inDisplacement);
+
+	// @brief 箱のレイヤーを設定する
+	// @param inProxy：葉のノードの番号
+	// @param inLayerBits：レイヤーのビット(追加した時は全てのビット)
+	// @note 親をたどって枝のレイヤーのビットを直す
+	void SetProxyLayer(uint32_t inProxy, uint32_t inLayerBits);
+
+	// @brief 全ての箱を削除する
+	void Clear();
+
+	// @brief 更新
+	// @note 一定の間隔で木の質を確かめて、落ちていれば全体を作り直す
+	//       直前の更新からの統計情報を確定する
+	void Update();
+
+	// @brief 葉から全体を作り直す
+	// @note 箱の中心を区間に振り分け、表面積と箱の数の積が一番小さくなる位置で分ける
+	//       作り直した後の表面積の比を、次に作り直すかどうかの基準にする
+	void Rebuild();
+
+	// @brief 範囲と重なる葉を探す
+	// @tparam TCallback：bool(uint32_t inProxy)、falseを返すと探すのをやめる
+	// @param inMin：最小(XYZ)
+	// @param inMax：最大(XYZ)
+	// @param inCallback：見つかった葉毎に呼ぶ処理
+	template<typename TCallback>
+	void QueryAabb(const float* inMin, const float* inMax, TCallback&& inCallback) const
+	{
+		QueryAabb(inMin, inMax, UINT32_MAX, inCallback);
+	}
+
+	// @brief 範囲と重なり、レイヤーがマスクに含まれる葉を探す
+	// @tparam TCallback：bool(uint32_t inProxy)、falseを返すと探すのをやめる
+	// @param inMin：最小(XYZ)
+	// @param inMax：最大(XYZ)
+	// @param inLayerMask：対象のレイヤーのビット
+	// @param inCallback：見つかった葉毎に呼ぶ処理
+	// @note 子孫にマスクのレイヤーの葉が無い枝は、範囲を比べる前に降りるのをやめる
+	template<typename TCallback>
+	void QueryAabb(const float* inMin, const float* inMax, uint32_t inLayerMask, TCallback&& inCallback) const
+	{
+		if (m_nRoot == ce_nNull) return;
+
+		uint32_t nStack[ce_nStackSize];
+		int nTop = 0;
+		nStack[nTop++] = m_nRoot;
+		while (nTop > 0)
+		{
+			const AabbTreeNode& tNode = m_NodeVec[nStack[--nTop]];
+			if (!(tNode.m_nLayerBits & inLayerMask)) continue;
+			if (tNode.m_fMin[0] > inMax[0] || tNode.m_fMax[0] < inMin[0] ||
+				tNode.m_fMin[1] > inMax[1] || tNode.m_fMax[1] < inMin[1] ||
+				tNode.m_fMin[2] > inMax[2] || tNode.m_fMax[2] < inMin[2]) continue;
+
+			if (tNode.IsLeaf())
+			{
+				if (!inCallback(static_cast<uint32_t>(&tNode - m_NodeVec.data()))) return;
+				continue;
+			}
+			nStack[nTop++] = tNode.m_nChild[0];
+			nStack[nTop++] = tNode.m_nChild[1];
+		}
+	}
+
+	// @brief 根のノードの番号の取得(空ならce_nNull)
+	uint32_t GetRoot() const { return m_nRoot; }
+
+	// @brief ノードの取得
+	// @param inNode：ノードの番号
+	const AabbTreeNode& GetNode(uint32_t inNode) const { return m_NodeVec[inNode]; }
+
+	// @brief 葉の使う側が自由に使う値の取得
+	// @param inProxy：葉のノードの番号
+	uint32_t GetUserData(uint32_t inProxy) const { return m_NodeVec[inProxy].m_nUserData; }
+
+	// @brief 葉の数の取得
+	uint32_t GetProxyNum() const { return m_nProxyNum; }
+
+	// @brief 木の高さの取得
+	int GetHeight() const { return (m_nRoot == ce_nNull) ? 0 : m_NodeVec[m_nRoot].m_nHeight; }
+
+	// @brief 枝のノードの表面積の合計と根の表面積の比を求める
+	float ComputeAreaRatio() const;
+
+	// @brief 統計情報の取得
+	// @return 直前の更新から次の更新までの統計情報
+	const AabbTreeStats& GetStats() const { return m_tStats; }
+
+	// @brief 動く箱の割合を変えて更新の負荷を計測して書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief 空きノードを取り出す
+	uint32_t AllocateNode();
+
+	// @brief ノードを空きに戻す
+	void FreeNode(uint32_t inNode);
+
+	// @brief 葉を木に入れる
+	// @param inLeaf：葉のノードの番号
+	void InsertLeaf(uint32_t inLeaf);
+
+	// @brief 葉を木から外す
+	// @param inLeaf：葉のノードの番号
+	void RemoveLeaf(uint32_t inLeaf);
+
+	// @brief 親をたどって範囲と高さを直す
+	// @param inNode：直し始めるノードの番号
+	void Refit(uint32_t inNode);
+
+	// @brief 子の高さの差が2以上なら回転して偏りを直す
+	// @param inNode：ノードの番号
+	// @return 回転後にその位置にあるノードの番号
+	uint32_t Balance(uint32_t inNode);
+
+	// @brief 親子の繋がり、高さ、範囲、レイヤーのビットが正しいか確かめる
+	// @return true:正しい false:壊れている
+	bool Validate() const;
+
+	// @brief 葉の範囲をまとめて枝を作る
+	// @param inStart：m_LeafVecの最初の番号
+	// @param inCount：葉の数
+	// @param inDepth：根からの深さ
+	// @return 作ったノードの番号
+	uint32_t BuildRange(uint32_t inStart, uint32_t inCount, uint32_t inDepth);
+
+private:
+	// @brief ノード
+	std::vector<AabbTreeNode> m_NodeVec;
+
+	// @brief 根のノードの番号
+	uint32_t m_nRoot;
+
+	// @brief 空きノードの先頭の番号
+	uint32_t m_nFreeNode;
+
+	// @brief 葉の数
+	uint32_t m_nProxyNum;
+
+	// @brief 実際の範囲を広げる幅
+	float m_fMargin;
+
+	// @brief 作り直す時に使う葉の番号
+	std::vector<uint32_t> m_LeafVec;
+
+	// @brief 作り直した直後の表面積の比(まだ作り直していなければ0)
+	float m_fBaseAreaRatio;
+
+	// @brief 更新の回数
+	uint32_t m_nUpdateCount;
+
+	// @brief 集計中の統計情報
+	AabbTreeStats m_tCount;
+
+	// @brief 直前の更新から次の更新までの統計情報
+	AabbTreeStats m_tStats;
+};
@@ -3,15 +3,22 @@
 	@brief	| GeBeBNX
 	@note	| GeBeB̋ʏ`
 			| CGameObjectp
+			| rwCrAc[̍sIBehaviorAgentƂĎ󂯎
 *//**************************************************/
 #include "Entity.h"
 
+// ɐUXL̑Ώۂ̔ԍ
+static uint32_t s_nNextEntityId = 0;
+
 /****************************************//* 
 	@brief@	| RXgN^
 *//****************************************/
 CEntity::CEntity()
 	:CGameObject()
 	, m_f3Velocity({ 0.0f, 0.0f, 0.0f })
+	, m_nCrowdHandle(CCrowdSystem::ce_nInvalidHandle)
+	, m_nBehaviorHandle(CBehaviorSystem::ce_nInvalidHandle)
+	, m_nEntityId(s_nNextEntityId++)
 {
 }
 
@@ -20,4 +27,99 @@ CEntity::CEntity()
 *//****************************************/
 CEntity::~CEntity()
 {
-}
\ No newline at end of file
+	LeaveCrowd();
+	StopBehavior();
+}
+
+/****************************************//* 
+	@brief@	| XĽʂ󂯂̏
+	@param@	| inEventF
+*//****************************************/
+void CEntity::OnSkillEffect(const SkillEffectEvent& inEvent)
+{
+	// ʂ󂯂ȂGeBeB͉Ȃ
+	(void)inEvent;
+}
+
+/****************************************//* 
+	@brief@	| rwCrAc[̍ss
+	@param@	| ioContextFĂԎ̏(sԂ͎ɌĂԂ܂ł̎Ԃ)
+	@return		| š
+*//****************************************/
+BehaviorStatus CEntity::OnBehaviorAction(BehaviorContext& ioContext)
+{
+	// sȂGeBeB͎sԂ(؂͎̎})
+	(void)ioContext;
+	return BehaviorStatus::Failure;
+}
+
+/****************************************//* 
+	@brief@	| QO̕sV~[Vɉ
+	@param@	| inRadiusFa
+	@param@	| inMaxSpeedFōx(1b)
+	@param@	| inGroupFQ̔ԍ(QƂE񂷂)
+*//****************************************/
+void CEntity::JoinCrowd(float inRadius, float inMaxSpeed, uint32_t inGroup)
+{
+	LeaveCrowd();
+	m_nCrowdHandle = CCrowdSystem::GetInstance()->Add({ { m_tParam.m_f3Pos.x, m_tParam.m_f3Pos.z }, inRadius, inMaxSpeed, inGroup });
+}
+
+/****************************************//* 
+	@brief@	| QO̕sV~[VO
+*//****************************************/
+void CEntity::LeaveCrowd()
+{
+	if (m_nCrowdHandle == CCrowdSystem::ce_nInvalidHandle) return;
+
+	CCrowdSystem::GetInstance()->Remove(m_nCrowdHandle);
+	m_nCrowdHandle = CCrowdSystem::ce_nInvalidHandle;
+}
+
+/****************************************//* 
+	@brief@	| QO̒Ŗڎwʒuݒ
+	@param@	| inGoalFڎwʒu(͎gȂ)
+*//****************************************/
+void CEntity::SetCrowdGoal(const DirectX::XMFLOAT3& inGoal)
+{
+	if (m_nCrowdHandle == CCrowdSystem::ce_nInvalidHandle) return;
+
+	CCrowdSystem::GetInstance()->SetGoal(m_nCrowdHandle, { inGoal.x, inGoal.z });
+}
+
+/****************************************//* 
+	@brief@	| QO̕sV~[VœʒuƑx𔽉f
+	@return		| true:f false:ĂȂ
+*//****************************************/
+bool CEntity::ApplyCrowd()
+{
+	NavPoint tPos, tVelocity;
+	if (m_nCrowdHandle == CCrowdSystem::ce_nInvalidHandle || !CCrowdSystem::GetInstance()->GetAgent(m_nCrowdHandle, tPos, tVelocity)) return false;
+
+	m_tParam.m_f3Pos.x = tPos.m_fX;
+	m_tParam.m_f3Pos.z = tPos.m_fZ;
+	m_f3Velocity.x = tVelocity.m_fX;
+	m_f3Velocity.z = tVelocity.m_fZ;
+	return true;
+}
+
+/****************************************//* 
+	@brief@	| rwCrAc[œn߂
+	@param@	| inTreeF؂̔ԍ
+*//****************************************/
+void CEntity::StartBehavior(BehaviorTreeId inTree)
+{
+	StopBehavior();
+	m_nBehaviorHandle = CBehaviorSystem::GetInstance()->Add(inTree, this);
+}
+
+/****************************************//* 
+	@brief@	| rwCrAc[œ̂~߂
+*//****************************************/
+void CEntity::StopBehavior()
+{
+	if (m_nBehaviorHandle == CBehaviorSystem::ce_nInvalidHandle) return;
+
+	CBehaviorSystem::GetInstance()->Remove(m_nBehaviorHandle);
+	m_nBehaviorHandle = CBehaviorSystem::ce_nInvalidHandle;
+}
@@ -3,12 +3,19 @@
 	@brief	| GeBeBNX
 	@note	| GeBeB̋ʏ`
 			| CGameObjectp
+			| rwCrAc[̍sIBehaviorAgentƂĎ󂯎
 *//**************************************************/
 #pragma once
 #include "GameObject.h"
+#include "CrowdSystem.h"
+#include "BehaviorSystem.h"
+#include <cstdint>
+
+// @brief O錾
+struct SkillEffectEvent;
 
 // @brief GeBeBNX
-class CEntity : public CGameObject
+class CEntity : public CGameObject, public IBehaviorAgent
 {
 public:
 	// @brief RXgN^
@@ -17,8 +24,60 @@ public:
 	// @brief fXgN^
 	virtual ~CEntity();
 
+	// @brief XĽʂ󂯂̏
+	// @param inEventF
+	virtual void OnSkillEffect(const SkillEffectEvent& inEvent);
+
+	// @brief XL̑Ώۂ̔ԍ̎擾
+	// @return ɐUԍ(V[ׂłdȂ)
+	uint32_t GetEntityId() const { return m_nEntityId; }
+
+	// @brief rwCrAc[̍ss
+	// @param ioContextFĂԎ̏(sԂ͎ɌĂԂ܂ł̎Ԃ)
+	// @return š
+	// @note sȂGeBeB͎sԂ
+	BehaviorStatus OnBehaviorAction(BehaviorContext& ioContext) override;
+
+protected:
+	// @brief QO̕sV~[Vɉ
+	// @param inRadiusFa
+	// @param inMaxSpeedFōx(1b)
+	// @param inGroupFQ̔ԍ(QƂE񂷂)
+	// @note ̈ʒun߂(ɉĂΊOĂ蒼)
+	void JoinCrowd(float inRadius, float inMaxSpeed, uint32_t inGroup);
+
+	// @brief QO̕sV~[VO
+	void LeaveCrowd();
+
+	// @brief QO̒Ŗڎwʒuݒ
+	// @param inGoalFڎwʒu(͎gȂ)
+	void SetCrowdGoal(const DirectX::XMFLOAT3& inGoal);
+
+	// @brief QO̕sV~[VœʒuƑx𔽉f
+	// @return true:f false:ĂȂ
+	// @note ͕ςȂ
+	bool ApplyCrowd();
+
+	// @brief rwCrAc[œn߂
+	// @param inTreeF؂̔ԍ
+	// @note ɓĂΎ~߂Ă獪蒼
+	void StartBehavior(BehaviorTreeId inTree);
+
+	// @brief rwCrAc[œ̂~߂
+	void StopBehavior();
+
 protected:
 	// @brief xxNg
 	DirectX::XMFLOAT3 m_f3Velocity;
+
+	// @brief QO̕sV~[V̔ԍ(ĂȂce_nInvalidHandle)
+	CrowdHandle m_nCrowdHandle;
+
+	// @brief rwCrAc[̕s҂̔ԍ(ĂȂce_nInvalidHandle)
+	BehaviorHandle m_nBehaviorHandle;
+
+private:
+	// @brief XL̑Ώۂ̔ԍ
+	uint32_t m_nEntityId;
 };
 
@@ -12,8 +12,16 @@
 #include "Input.h"
 #include "ImguiSystem.h"
 #include "Defines.h"
+#include "CollisionObb.h"
+#include "PathService.h"
 #include <cmath>
 
+// irQ[VObh̃Z1̑傫
+constexpr float ce_fNavCellSize = 0.5f;
+
+// QL镝(vC[̔̑傫)
+constexpr float ce_fNavAgentRadius = 1.0f;
+
 /*****************************************//*
 	@brief@	| RXgN^
 *//*****************************************/
@@ -137,4 +145,36 @@ DirectX::XMFLOAT3 CField::GetMovePos()
 	DirectX::XMFLOAT3 hitPos{};
 	DirectX::XMStoreFloat3(&hitPos, hit);
 	return hitPos;
+}
+
+/*****************************************//*
+	@brief@	| irQ[VObh쐬ČoHTT[rXɓn
+	@param@	| inCollisionVecFV[̓蔻(Ȃ̂Qɂ)
+*//*****************************************/
+void CField::BakeNavigation(const std::vector<CCollisionBase*>& inCollisionVec)
+{
+	// X]ŐQĂ邽߁AXvCg̏cZ̑傫ɂȂ
+	const float fSizeX = m_tParam.m_f3Size.x;
+	const float fSizeZ = m_tParam.m_f3Size.y;
+
+	CNavGrid tGrid;
+	tGrid.Init(m_tParam.m_f3Pos.x - fSizeX * 0.5f, m_tParam.m_f3Pos.z - fSizeZ * 0.5f,
+		static_cast<uint32_t>(fSizeX / ce_fNavCellSize), static_cast<uint32_t>(fSizeZ / ce_fNavCellSize), ce_fNavCellSize);
+
+	for (CCollisionBase* pCollision : inCollisionVec)
+	{
+		if (!pCollision->GetActive() || !pCollision->IsStatic()) continue;
+
+		CCollisionObb* pObb = dynamic_cast<CCollisionObb*>(pCollision);
+		if (!pObb) continue;
+
+		// ̌X͖AY]𕽖ʂɗƂ
+		const DirectX::XMFLOAT3 f3Center = pObb->GetCenter();
+		const DirectX::XMFLOAT3 f3Size = pObb->GetSize();
+		tGrid.AddObstacle({ f3Center.x, f3Center.z }, { f3Size.x * 0.5f, f3Size.z * 0.5f },
+			pObb->GetGameObject()->GetRotate().y, ce_fNavAgentRadius);
+	}
+	tGrid.BuildRegions();
+
+	CPathService::GetInstance()->SetGrid(std::move(tGrid));
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 *//**************************************************/
 #pragma once
 #include "GameObject.h"
+#include "CollisionBase.h"
+#include <vector>
 
 // @brief tB[hNX
 class CField : public CGameObject
@@ -26,4 +28,9 @@ public:
 	// @brief ړʒu̎擾
 	// @note }EXNbNɂړʒu̎擾
 	DirectX::XMFLOAT3 GetMovePos();
+
+	// @brief irQ[VObh쐬ČoHTT[rXɓn
+	// @param inCollisionVecFV[̓蔻(Ȃ̂Qɂ)
+	// @note V[̑SẴIuWFNgǉɌĂ
+	void BakeNavigation(const std::vector<CCollisionBase*>& inCollisionVec);
 };
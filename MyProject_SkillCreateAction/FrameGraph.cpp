@@ -0,0 +1,522 @@
+/**************************************************//*
+	@file	| FrameGraph.cpp
+	@brief	| フレームグラフクラスのcppファイル
+	@note	| 描画パスと、パスが読み書きするレンダーターゲットを毎フレーム登録し、
+			| 使われないパスの除外、一時レンダーターゲットのメモリの使い回し、
+			| レンダーターゲットの設定と状態遷移の最小化を行ってから実行する
+			| 実行順の計算だけを行い、デバイスには触れない
+*//**************************************************/
+#include "FrameGraph.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+/****************************************//*
+	@brief　	| コンストラクタ
+	@param　	| pGraph：登録先
+	@param　	| inPass：パスの番号
+*//****************************************/
+CFrameGraph::PassBuilder::PassBuilder(CFrameGraph* pGraph, uint32_t inPass)
+	: m_pGraph(pGraph)
+	, m_nPass(inPass)
+{
+}
+
+/****************************************//*
+	@brief　	| シェーダーから読むリソースを登録する
+	@param　	| inResource：リソースの番号
+	@return		| 自身
+*//****************************************/
+CFrameGraph::PassBuilder& CFrameGraph::PassBuilder::Read(FGResource inResource)
+{
+	m_pGraph->m_PassVec[m_nPass].m_ReadVec.push_back(inResource);
+	return *this;
+}
+
+/****************************************//*
+	@brief　	| 書き込むリソースを登録する(種類に合わせてカラーバッファか深度バッファにする)
+	@param　	| inResource：リソースの番号
+	@param　	| isClear：書き込む前にクリアするか(しない場合は前の内容に書き足す)
+	@return		| 自身
+*//****************************************/
+CFrameGraph::PassBuilder& CFrameGraph::PassBuilder::Write(FGResource inResource, bool isClear)
+{
+	Pass& tPass = m_pGraph->m_PassVec[m_nPass];
+	if (m_pGraph->m_ResourceVec[inResource].m_tDesc.m_eKind == FGTargetKind::Depth) tPass.m_nDepth = inResource;
+	else tPass.m_ColorVec.push_back(inResource);
+
+	if (isClear) tPass.m_ClearVec.push_back(inResource);
+	return *this;
+}
+
+/****************************************//*
+	@brief　	| 書き込み先が使われなくても除外しないようにする
+	@return		| 自身
+*//****************************************/
+CFrameGraph::PassBuilder& CFrameGraph::PassBuilder::SideEffect()
+{
+	m_pGraph->m_PassVec[m_nPass].m_bSideEffect = true;
+	return *this;
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CFrameGraph::CFrameGraph()
+	: m_ResourceVec{}
+	, m_PassVec{}
+	, m_PhysicalVec{}
+	, m_CommandVec{}
+	, m_bCompiled(false)
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| 登録したパスとリソースを破棄する
+*//****************************************/
+void CFrameGraph::Reset()
+{
+	m_ResourceVec.clear();
+	m_PassVec.clear();
+	m_PhysicalVec.clear();
+	m_CommandVec.clear();
+	m_bCompiled = false;
+}
+
+/****************************************//*
+	@brief　	| 一時リソースを作成する
+	@param　	| inName：名前(文字列リテラル)
+	@param　	| inDesc：リソースの内容
+	@return		| リソースの番号
+*//****************************************/
+FGResource CFrameGraph::CreateTexture(const char* inName, const FGTextureDesc& inDesc)
+{
+	m_ResourceVec.push_back({ inName, inDesc, false, ce_nInvalid, ce_nInvalid, ce_nInvalid });
+	m_bCompiled = false;
+	return static_cast<FGResource>(m_ResourceVec.size() - 1);
+}
+
+/****************************************//*
+	@brief　	| フレームグラフの外で作成したリソースを取り込む
+	@param　	| inName：名前(文字列リテラル)
+	@param　	| inDesc：リソースの内容
+	@param　	| inImportId：実行先が実体を探すための番号
+	@return		| リソースの番号
+*//****************************************/
+FGResource CFrameGraph::Import(const char* inName, const FGTextureDesc& inDesc, uint32_t inImportId)
+{
+	m_ResourceVec.push_back({ inName, inDesc, true, inImportId, ce_nInvalid, ce_nInvalid });
+	m_bCompiled = false;
+	return static_cast<FGResource>(m_ResourceVec.size() - 1);
+}
+
+/****************************************//*
+	@brief　	| パスを登録する
+	@param　	| inName：名前(文字列リテラル)
+	@param　	| inFunc：実行する処理(レンダーターゲットは設定済み)
+	@return		| 読み書きするリソースの登録先
+*//****************************************/
+CFrameGraph::PassBuilder CFrameGraph::AddPass(const char* inName, std::function<void()> inFunc)
+{
+	Pass tPass = {};
+	tPass.m_pName = inName;
+	tPass.m_Func = std::move(inFunc);
+	tPass.m_nDepth = ce_nInvalid;
+	m_PassVec.push_back(std::move(tPass));
+	m_bCompiled = false;
+	return PassBuilder(this, static_cast<uint32_t>(m_PassVec.size() - 1));
+}
+
+/****************************************//*
+	@brief　	| 除外するパス、実体の割り当て、実行する命令を決める
+*//****************************************/
+void CFrameGraph::Compile()
+{
+	m_tStats = {};
+	m_tStats.m_nPassNum = static_cast<int>(m_PassVec.size());
+
+	Cull();
+	Alias();
+	Schedule();
+	m_bCompiled = true;
+}
+
+/****************************************//*
+	@brief　	| 実行する
+	@param　	| inBackend：実行先
+	@note		| コンパイルしていない場合はコンパイルしてから実行する
+*//****************************************/
+void CFrameGraph::Execute(IFrameGraphBackend& inBackend)
+{
+	if (!m_bCompiled) Compile();
+
+	inBackend.Realize(m_PhysicalVec);
+
+	// D3D11で同時に設定できるレンダーターゲットの数
+	static constexpr uint32_t ce_nMaxColorNum = 8;
+
+	for (const FGCommand& tCommand : m_CommandVec)
+	{
+		switch (tCommand.m_eKind)
+		{
+		case FGCommandKind::Transition:
+			inBackend.Transition(GetTarget(tCommand.m_nResource), tCommand.m_eState);
+			break;
+
+		case FGCommandKind::Clear:
+			inBackend.Clear(GetTarget(tCommand.m_nResource), m_ResourceVec[tCommand.m_nResource].m_tDesc);
+			break;
+
+		case FGCommandKind::Bind:
+		{
+			if (tCommand.m_nPass == ce_nInvalid)
+			{
+				inBackend.BindTargets(nullptr, 0, nullptr);
+				break;
+			}
+
+			const Pass& tPass = m_PassVec[tCommand.m_nPass];
+			FGTarget tColor[ce_nMaxColorNum];
+			uint32_t nColorNum = (std::min)(static_cast<uint32_t>(tPass.m_ColorVec.size()), ce_nMaxColorNum);
+			for (uint32_t i = 0; i < nColorNum; i++) tColor[i] = GetTarget(tPass.m_ColorVec[i]);
+			FGTarget tDepth = {};
+			if (tPass.m_nDepth != ce_nInvalid) tDepth = GetTarget(tPass.m_nDepth);
+			inBackend.BindTargets(tColor, nColorNum, tPass.m_nDepth != ce_nInvalid ? &tDepth : nullptr);
+			break;
+		}
+
+		case FGCommandKind::Execute:
+			if (m_PassVec[tCommand.m_nPass].m_Func) m_PassVec[tCommand.m_nPass].m_Func();
+			break;
+		}
+	}
+}
+
+/****************************************//*
+	@brief　	| リソースの実体を取得する
+	@param　	| inResource：リソースの番号
+	@return		| 実体(使われない一時リソースはm_nIndexがce_nInvalid)
+*//****************************************/
+FGTarget CFrameGraph::GetTarget(FGResource inResource) const
+{
+	const Resource& tResource = m_ResourceVec[inResource];
+	return { tResource.m_nIndex, tResource.m_bImported };
+}
+
+/****************************************//*
+	@brief　	| 使われないパスを除外する
+	@note		| 後ろのパスから順に、必要なリソースに書き込むパスだけを残す
+				| 取り込んだリソースは最終的な出力なので最初から必要とする
+*//****************************************/
+void CFrameGraph::Cull()
+{
+	std::vector<bool> bNeededVec(m_ResourceVec.size(), false);
+	for (size_t i = 0; i < m_ResourceVec.size(); i++)
+	{
+		bNeededVec[i] = m_ResourceVec[i].m_bImported;
+	}
+
+	for (size_t i = m_PassVec.size(); i-- > 0;)
+	{
+		Pass& tPass = m_PassVec[i];
+
+		bool bNeeded = tPass.m_bSideEffect;
+		for (FGResource nColor : tPass.m_ColorVec) bNeeded = bNeeded || bNeededVec[nColor];
+		if (tPass.m_nDepth != ce_nInvalid) bNeeded = bNeeded || bNeededVec[tPass.m_nDepth];
+
+		tPass.m_bCulled = !bNeeded;
+		if (!bNeeded)
+		{
+			m_tStats.m_nCulledNum++;
+			continue;
+		}
+
+		// クリアして書き込むリソースは前の内容を使わないので、前のパスでの書き込みは不要になる
+		// (クリアしない場合は前の内容に書き足すので、必要かどうかはそのまま)
+		for (FGResource nClear : tPass.m_ClearVec) bNeededVec[nClear] = false;
+		for (FGResource nRead : tPass.m_ReadVec) bNeededVec[nRead] = true;
+	}
+}
+
+/****************************************//*
+	@brief　	| 一時リソースの使用期間を求め、期間が重ならないもの同士で実体を使い回す
+*//****************************************/
+void CFrameGraph::Alias()
+{
+	// 実行するパスの中で最初と最後に使うパス
+	for (Resource& tResource : m_ResourceVec)
+	{
+		tResource.m_nFirst = ce_nInvalid;
+		tResource.m_nLast = ce_nInvalid;
+		if (!tResource.m_bImported) tResource.m_nIndex = ce_nInvalid;
+	}
+	auto Use = [this](FGResource inResource, uint32_t inPass)
+	{
+		Resource& tResource = m_ResourceVec[inResource];
+		if (tResource.m_nFirst == ce_nInvalid) tResource.m_nFirst = inPass;
+		tResource.m_nLast = inPass;
+	};
+	for (uint32_t i = 0; i < m_PassVec.size(); i++)
+	{
+		const Pass& tPass = m_PassVec[i];
+		if (tPass.m_bCulled) continue;
+		for (FGResource nRead : tPass.m_ReadVec) Use(nRead, i);
+		for (FGResource nColor : tPass.m_ColorVec) Use(nColor, i);
+		if (tPass.m_nDepth != ce_nInvalid) Use(tPass.m_nDepth, i);
+	}
+
+	// 使い始めの早い順に、同じ内容で使い終わった実体があれば使い回す
+	std::vector<FGResource> tOrderVec;
+	for (FGResource i = 0; i < m_ResourceVec.size(); i++)
+	{
+		if (!m_ResourceVec[i].m_bImported && m_ResourceVec[i].m_nFirst != ce_nInvalid) tOrderVec.push_back(i);
+	}
+	std::stable_sort(tOrderVec.begin(), tOrderVec.end(),
+		[this](FGResource a, FGResource b) { return m_ResourceVec[a].m_nFirst < m_ResourceVec[b].m_nFirst; });
+
+	// 実体毎の最後に使うパス
+	std::vector<uint32_t> tPhysicalLastVec;
+	for (FGResource nResource : tOrderVec)
+	{
+		Resource& tResource = m_ResourceVec[nResource];
+		uint32_t nPhysical = ce_nInvalid;
+		for (uint32_t i = 0; i < m_PhysicalVec.size(); i++)
+		{
+			const FGTextureDesc& tDesc = m_PhysicalVec[i];
+			if (tPhysicalLastVec[i] < tResource.m_nFirst &&
+				tDesc.m_nWidth == tResource.m_tDesc.m_nWidth &&
+				tDesc.m_nHeight == tResource.m_tDesc.m_nHeight &&
+				tDesc.m_nFormat == tResource.m_tDesc.m_nFormat &&
+				tDesc.m_eKind == tResource.m_tDesc.m_eKind)
+			{
+				nPhysical = i;
+				break;
+			}
+		}
+		if (nPhysical == ce_nInvalid)
+		{
+			nPhysical = static_cast<uint32_t>(m_PhysicalVec.size());
+			m_PhysicalVec.push_back(tResource.m_tDesc);
+			tPhysicalLastVec.push_back(0);
+		}
+		tResource.m_nIndex = nPhysical;
+		tPhysicalLastVec[nPhysical] = tResource.m_nLast;
+	}
+
+	m_tStats.m_nTransientNum = static_cast<int>(tOrderVec.size());
+	m_tStats.m_nPhysicalNum = static_cast<int>(m_PhysicalVec.size());
+}
+
+/****************************************//*
+	@brief　	| 状態遷移、クリア、レンダーターゲットの設定、パスの実行の順に命令を並べる
+	@note		| 状態が変わる時、設定するレンダーターゲットが変わる時だけ命令を追加する
+*//****************************************/
+void CFrameGraph::Schedule()
+{
+	// 取り込んだリソースはレンダーターゲットとして使われている状態から始める
+	std::vector<FGState> tStateVec(m_PhysicalVec.size() + m_ResourceVec.size(), FGState::Unknown);
+	for (FGResource i = 0; i < m_ResourceVec.size(); i++)
+	{
+		if (m_ResourceVec[i].m_bImported) tStateVec[GetStateIndex(i)] = FGState::RenderTarget;
+	}
+
+	// 設定中のレンダーターゲット(設定していない場合はパスがce_nInvalid)
+	uint32_t nBoundPass = ce_nInvalid;
+
+	// 設定中のレンダーターゲットに含まれるか
+	auto IsBound = [this, &nBoundPass](FGResource inResource)
+	{
+		if (nBoundPass == ce_nInvalid) return false;
+		const Pass& tBound = m_PassVec[nBoundPass];
+		for (FGResource nColor : tBound.m_ColorVec) if (IsSameTarget(nColor, inResource)) return true;
+		return tBound.m_nDepth != ce_nInvalid && IsSameTarget(tBound.m_nDepth, inResource);
+	};
+
+	auto AddTransition = [this, &tStateVec](uint32_t inPass, FGResource inResource, FGState inState)
+	{
+		FGState& eState = tStateVec[GetStateIndex(inResource)];
+		if (eState == inState) return;
+		eState = inState;
+		m_CommandVec.push_back({ FGCommandKind::Transition, inPass, inResource, inState });
+		m_tStats.m_nTransitionNum++;
+	};
+
+	for (uint32_t i = 0; i < m_PassVec.size(); i++)
+	{
+		const Pass& tPass = m_PassVec[i];
+		if (tPass.m_bCulled) continue;
+
+		// 読むリソースがレンダーターゲットに設定されたままなら外す
+		// (書き込み先を設定するパスは設定し直すことで外れるので、書き込み先が無いパスだけ命令を追加する)
+		bool bTarget = !tPass.m_ColorVec.empty() || tPass.m_nDepth != ce_nInvalid;
+		bool bUnbind = false;
+		for (FGResource nRead : tPass.m_ReadVec) bUnbind = bUnbind || IsBound(nRead);
+		if (bUnbind)
+		{
+			if (!bTarget)
+			{
+				m_CommandVec.push_back({ FGCommandKind::Bind, ce_nInvalid, ce_nInvalid, FGState::Unknown });
+				m_tStats.m_nBindNum++;
+			}
+			nBoundPass = ce_nInvalid;
+		}
+
+		for (FGResource nRead : tPass.m_ReadVec) AddTransition(i, nRead, FGState::ShaderResource);
+		for (FGResource nColor : tPass.m_ColorVec) AddTransition(i, nColor, FGState::RenderTarget);
+		if (tPass.m_nDepth != ce_nInvalid) AddTransition(i, tPass.m_nDepth, FGState::RenderTarget);
+
+		// 一時リソースは前に使っていた内容が残っているので、最初に書き込むパスで必ずクリアする
+		auto AddClear = [this, &tPass, i](FGResource inResource)
+		{
+			const Resource& tResource = m_ResourceVec[inResource];
+			bool bClear = !tResource.m_bImported && tResource.m_nFirst == i;
+			bClear = bClear || std::find(tPass.m_ClearVec.begin(), tPass.m_ClearVec.end(), inResource) != tPass.m_ClearVec.end();
+			if (!bClear) return;
+			m_CommandVec.push_back({ FGCommandKind::Clear, i, inResource, FGState::RenderTarget });
+			m_tStats.m_nClearNum++;
+		};
+		for (FGResource nColor : tPass.m_ColorVec) AddClear(nColor);
+		if (tPass.m_nDepth != ce_nInvalid) AddClear(tPass.m_nDepth);
+
+		// 書き込み先が直前のパスと同じなら設定し直さない
+		if (bTarget)
+		{
+			bool bSame = nBoundPass != ce_nInvalid;
+			if (bSame)
+			{
+				const Pass& tBound = m_PassVec[nBoundPass];
+				bSame = tBound.m_ColorVec.size() == tPass.m_ColorVec.size() &&
+					(tBound.m_nDepth == ce_nInvalid) == (tPass.m_nDepth == ce_nInvalid) &&
+					(tPass.m_nDepth == ce_nInvalid || IsSameTarget(tBound.m_nDepth, tPass.m_nDepth));
+				for (size_t j = 0; bSame && j < tPass.m_ColorVec.size(); j++)
+				{
+					bSame = IsSameTarget(tBound.m_ColorVec[j], tPass.m_ColorVec[j]);
+				}
+			}
+
+			if (bSame)
+			{
+				m_tStats.m_nBindSkipNum++;
+			}
+			else
+			{
+				m_CommandVec.push_back({ FGCommandKind::Bind, i, ce_nInvalid, FGState::Unknown });
+				m_tStats.m_nBindNum++;
+			}
+			nBoundPass = i;
+		}
+
+		m_CommandVec.push_back({ FGCommandKind::Execute, i, ce_nInvalid, FGState::Unknown });
+	}
+}
+
+/****************************************//*
+	@brief　	| 2つのリソースの実体が同じか
+	@param　	| inA：リソースの番号
+	@param　	| inB：リソースの番号
+	@return		| true:同じ false:異なる
+*//****************************************/
+bool CFrameGraph::IsSameTarget(FGResource inA, FGResource inB) const
+{
+	const Resource& tA = m_ResourceVec[inA];
+	const Resource& tB = m_ResourceVec[inB];
+	return tA.m_bImported == tB.m_bImported && tA.m_nIndex == tB.m_nIndex && tA.m_nIndex != ce_nInvalid;
+}
+
+/****************************************//*
+	@brief　	| 実体毎の状態の番号を取得する
+	@param　	| inResource：リソースの番号
+	@return		| 状態の番号(取り込んだリソースは一時リソースの実体の後ろに並べる)
+*//****************************************/
+size_t CFrameGraph::GetStateIndex(FGResource inResource) const
+{
+	const Resource& tResource = m_ResourceVec[inResource];
+	if (tResource.m_bImported) return m_PhysicalVec.size() + inResource;
+	return tResource.m_nIndex;
+}
+
+/****************************************//*
+	@brief　	| 影とポストエフェクトを想定したグラフでコンパイル結果を計測して書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CFrameGraph::MeasureCompile(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	// DXGI_FORMATの値(デバイスのヘッダーに依存しないよう数値で持つ)
+	static constexpr uint32_t ce_nFormatRGBA16F = 10;
+	static constexpr uint32_t ce_nFormatR11G11B10F = 26;
+	static constexpr uint32_t ce_nFormatRGBA8 = 28;
+	static constexpr uint32_t ce_nFormatD32F = 40;
+	static constexpr uint32_t ce_nFormatR32F = 41;
+
+	CFrameGraph tGraph;
+	auto Build = [&tGraph]()
+	{
+		tGraph.Reset();
+		FGTextureDesc tBackDesc = { 1280, 720, 0, FGTargetKind::Color, { 0.8f, 0.9f, 1.0f, 1.0f } };
+		FGTextureDesc tDepthDesc = { 1280, 720, 0, FGTargetKind::Depth, {} };
+		FGResource nBack = tGraph.Import("BackBuffer", tBackDesc, 0);
+		FGResource nDepth = tGraph.Import("Depth", tDepthDesc, 1);
+
+		FGResource nShadow = tGraph.CreateTexture("ShadowMap", { 2048, 2048, ce_nFormatD32F, FGTargetKind::Depth, {} });
+		FGResource nHDR = tGraph.CreateTexture("HDR", { 1280, 720, ce_nFormatRGBA16F, FGTargetKind::Color, {} });
+		FGResource nDebug = tGraph.CreateTexture("DebugView", { 1280, 720, ce_nFormatRGBA8, FGTargetKind::Color, {} });
+		FGResource nLum = tGraph.CreateTexture("Luminance", { 1, 1, ce_nFormatR32F, FGTargetKind::Color, {} });
+		FGResource nBloomA = tGraph.CreateTexture("BloomDown", { 640, 360, ce_nFormatR11G11B10F, FGTargetKind::Color, {} });
+		FGResource nBloomB = tGraph.CreateTexture("BloomBlurH", { 640, 360, ce_nFormatR11G11B10F, FGTargetKind::Color, {} });
+		FGResource nBloomC = tGraph.CreateTexture("BloomBlurV", { 640, 360, ce_nFormatR11G11B10F, FGTargetKind::Color, {} });
+		FGResource nLDR = tGraph.CreateTexture("LDR", { 1280, 720, ce_nFormatRGBA8, FGTargetKind::Color, {} });
+
+		tGraph.AddPass("Shadow", nullptr).Write(nShadow);
+		tGraph.AddPass("Scene", nullptr).Read(nShadow).Write(nHDR).Write(nDepth, true);
+		tGraph.AddPass("SceneTranslucent", nullptr).Read(nShadow).Write(nHDR).Write(nDepth);
+		tGraph.AddPass("DebugView", nullptr).Read(nHDR).Write(nDebug);
+		tGraph.AddPass("Luminance", nullptr).Read(nHDR).Write(nLum);
+		tGraph.AddPass("BloomDown", nullptr).Read(nHDR).Write(nBloomA);
+		tGraph.AddPass("BloomBlurH", nullptr).Read(nBloomA).Write(nBloomB);
+		tGraph.AddPass("BloomBlurV", nullptr).Read(nBloomB).Write(nBloomC);
+		tGraph.AddPass("Tonemap", nullptr).Read(nHDR).Read(nBloomC).Write(nLDR);
+		tGraph.AddPass("FXAA", nullptr).Read(nLDR).Write(nBack, true);
+		tGraph.AddPass("Line", nullptr).Write(nBack).Write(nDepth);
+		tGraph.AddPass("UI", nullptr).Write(nBack);
+	};
+
+	// コンパイルにかかる時間(登録を含む)
+	static constexpr int ce_nRepeat = 10000;
+	auto tStart = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < ce_nRepeat; i++)
+	{
+		Build();
+		tGraph.Compile();
+	}
+	double dUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - tStart).count() / ce_nRepeat;
+
+	const FrameGraphStats& tStats = tGraph.GetStats();
+	char szLine[256];
+	sprintf_s(szLine, "pass %d  culled %d  transient %d  physical %d\n",
+		tStats.m_nPassNum, tStats.m_nCulledNum, tStats.m_nTransientNum, tStats.m_nPhysicalNum);
+	tReport << szLine;
+	sprintf_s(szLine, "bind %d  skip %d  transition %d  clear %d  build+compile %.2f us\n",
+		tStats.m_nBindNum, tStats.m_nBindSkipNum, tStats.m_nTransitionNum, tStats.m_nClearNum, dUs);
+	tReport << szLine;
+
+	for (uint32_t i = 0; i < tGraph.GetPassNum(); i++)
+	{
+		sprintf_s(szLine, "  %-18s %s\n", tGraph.GetPassName(i), tGraph.IsCulled(i) ? "culled" : "");
+		tReport << szLine;
+	}
+	for (FGResource i = 0; i < tGraph.m_ResourceVec.size(); i++)
+	{
+		const Resource& tResource = tGraph.m_ResourceVec[i];
+		if (tResource.m_bImported) continue;
+		if (tResource.m_nIndex == ce_nInvalid) sprintf_s(szLine, "  %-18s unused\n", tResource.m_pName);
+		else sprintf_s(szLine, "  %-18s physical %u  pass %u-%u\n", tResource.m_pName, tResource.m_nIndex, tResource.m_nFirst, tResource.m_nLast);
+		tReport << szLine;
+	}
+	return 0;
+}
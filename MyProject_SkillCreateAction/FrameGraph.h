@@ -0,0 +1,353 @@
+/**************************************************//*
+	@file	| FrameGraph.h
+	@brief	| フレームグラフクラスのhファイル
+	@note	| 描画パスと、パスが読み書きするレンダーターゲットを毎フレーム登録し、
+			| 使われないパスの除外、一時レンダーターゲットのメモリの使い回し、
+			| レンダーターゲットの設定と状態遷移の最小化を行ってから実行する
+			| 実行順の計算だけを行い、デバイスには触れない
+*//**************************************************/
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// @brief フレームグラフのリソースの番号
+using FGResource = uint32_t;
+
+// @brief レンダーターゲットの種類
+enum class FGTargetKind
+{
+	// カラーバッファ
+	Color,
+
+	// 深度バッファ
+	Depth,
+};
+
+// @brief レンダーターゲットの内容
+struct FGTextureDesc
+{
+	// 横幅
+	uint32_t m_nWidth;
+
+	// 縦幅
+	uint32_t m_nHeight;
+
+	// ピクセルフォーマット(DXGI_FORMAT)
+	uint32_t m_nFormat;
+
+	// 種類
+	FGTargetKind m_eKind;
+
+	// クリアカラー(カラーバッファのみ)
+	float m_fClearColor[4];
+};
+
+// @brief リソースの状態
+enum class FGState
+{
+	// 未使用
+	Unknown,
+
+	// レンダーターゲットとして書き込む
+	RenderTarget,
+
+	// シェーダーから読む
+	ShaderResource,
+};
+
+// @brief リソースの実体
+struct FGTarget
+{
+	// 番号(取り込んだリソースは取り込み番号、一時リソースは実体の番号)
+	uint32_t m_nIndex;
+
+	// 取り込んだリソースかどうか
+	bool m_bImported;
+};
+
+// @brief 実行する命令の種類
+enum class FGCommandKind
+{
+	// 状態遷移
+	Transition,
+
+	// クリア
+	Clear,
+
+	// レンダーターゲットの設定
+	Bind,
+
+	// パスの実行
+	Execute,
+};
+
+// @brief 実行する命令1回分
+struct FGCommand
+{
+	// 命令の種類
+	FGCommandKind m_eKind;
+
+	// パスの番号(設定の解除はCFrameGraph::ce_nInvalid)
+	uint32_t m_nPass;
+
+	// リソースの番号(状態遷移、クリア)
+	FGResource m_nResource;
+
+	// 遷移後の状態
+	FGState m_eState;
+};
+
+// @brief フレームグラフの統計情報
+struct FrameGraphStats
+{
+	// 登録されたパスの数
+	int m_nPassNum;
+
+	// 使われないため除外したパスの数
+	int m_nCulledNum;
+
+	// 使用した一時リソースの数
+	int m_nTransientNum;
+
+	// 一時リソースの実体の数(使い回した分だけ少なくなる)
+	int m_nPhysicalNum;
+
+	// レンダーターゲットを設定した回数
+	int m_nBindNum;
+
+	// 直前と同じため省いた設定の回数
+	int m_nBindSkipNum;
+
+	// 状態遷移の回数
+	int m_nTransitionNum;
+
+	// クリアの回数
+	int m_nClearNum;
+};
+
+// @brief フレームグラフの実行先のインターフェース
+class IFrameGraphBackend
+{
+public:
+	// @brief デストラクタ
+	virtual ~IFrameGraphBackend() {}
+
+	// @brief 一時リソースの実体を用意する(実行の先頭で1回)
+	// @param inPhysicalVec：実体毎の内容(FGTarget::m_nIndexの順)
+	virtual void Realize(const std::vector<FGTextureDesc>& inPhysicalVec) = 0;
+
+	// @brief 状態遷移
+	// @param inTarget：リソースの実体
+	// @param inState：遷移後の状態
+	virtual void Transition(const FGTarget& inTarget, FGState inState) = 0;
+
+	// @brief クリア
+	// @param inTarget：リソースの実体
+	// @param inDesc：リソースの内容
+	virtual void Clear(const FGTarget& inTarget, const FGTextureDesc& inDesc) = 0;
+
+	// @brief レンダーターゲットの設定
+	// @param pColors：カラーバッファの配列
+	// @param inColorNum：カラーバッファの数(0で設定を解除)
+	// @param pDepth：深度バッファ(nullptrで使わない)
+	virtual void BindTargets(const FGTarget* pColors, uint32_t inColorNum, const FGTarget* pDepth) = 0;
+};
+
+// @brief フレームグラフクラス
+class CFrameGraph
+{
+public:
+	// @brief 無効な番号
+	static constexpr uint32_t ce_nInvalid = UINT32_MAX;
+
+	// @brief パスの読み書きするリソースを登録するクラス
+	class PassBuilder
+	{
+	public:
+		// @brief シェーダーから読むリソースを登録する
+		// @param inResource：リソースの番号
+		// @return 自身
+		PassBuilder& Read(FGResource inResource);
+
+		// @brief 書き込むリソースを登録する(種類に合わせてカラーバッファか深度バッファにする)
+		// @param inResource：リソースの番号
+		// @param isClear：書き込む前にクリアするか(しない場合は前の内容に書き足す)
+		// @return 自身
+		PassBuilder& Write(FGResource inResource, bool isClear = false);
+
+		// @brief 書き込み先が使われなくても除外しないようにする
+		// @return 自身
+		PassBuilder& SideEffect();
+
+	private:
+		friend class CFrameGraph;
+
+		// @brief コンストラクタ
+		// @param pGraph：登録先
+		// @param inPass：パスの番号
+		PassBuilder(CFrameGraph* pGraph, uint32_t inPass);
+
+		// @brief 登録先
+		CFrameGraph* m_pGraph;
+
+		// @brief パスの番号
+		uint32_t m_nPass;
+	};
+
+public:
+	// @brief コンストラクタ
+	CFrameGraph();
+
+	// @brief 登録したパスとリソースを破棄する
+	void Reset();
+
+	// @brief 一時リソースを作成する
+	// @param inName：名前(文字列リテラル)
+	// @param inDesc：リソースの内容
+	// @return リソースの番号
+	// @note 最初に書き込むパスで必ずクリアされ、実体は他の一時リソースと使い回す
+	FGResource CreateTexture(const char* inName, const FGTextureDesc& inDesc);
+
+	// @brief フレームグラフの外で作成したリソースを取り込む
+	// @param inName：名前(文字列リテラル)
+	// @param inDesc：リソースの内容
+	// @param inImportId：実行先が実体を探すための番号
+	// @return リソースの番号
+	// @note 取り込んだリソースへの書き込みは最終的な出力として扱う
+	FGResource Import(const char* inName, const FGTextureDesc& inDesc, uint32_t inImportId);
+
+	// @brief パスを登録する
+	// @param inName：名前(文字列リテラル)
+	// @param inFunc：実行する処理(レンダーターゲットは設定済み)
+	// @return 読み書きするリソースの登録先
+	PassBuilder AddPass(const char* inName, std::function<void()> inFunc);
+
+	// @brief 除外するパス、実体の割り当て、実行する命令を決める
+	void Compile();
+
+	// @brief 実行する
+	// @param inBackend：実行先
+	// @note コンパイルしていない場合はコンパイルしてから実行する
+	void Execute(IFrameGraphBackend& inBackend);
+
+	// @brief リソースの実体を取得する
+	// @param inResource：リソースの番号
+	// @return 実体(使われない一時リソースはm_nIndexがce_nInvalid)
+	FGTarget GetTarget(FGResource inResource) const;
+
+	// @brief パスの数の取得
+	// @return パスの数
+	uint32_t GetPassNum() const { return static_cast<uint32_t>(m_PassVec.size()); }
+
+	// @brief パスの名前の取得
+	// @param inPass：パスの番号
+	// @return 名前
+	const char* GetPassName(uint32_t inPass) const { return m_PassVec[inPass].m_pName; }
+
+	// @brief パスが除外されたか
+	// @param inPass：パスの番号
+	// @return true:除外された false:実行する
+	bool IsCulled(uint32_t inPass) const { return m_PassVec[inPass].m_bCulled; }
+
+	// @brief 実行する命令の取得
+	// @return 命令の配列
+	const std::vector<FGCommand>& GetCommands() const { return m_CommandVec; }
+
+	// @brief 直前にコンパイルした統計情報の取得
+	// @return 統計情報
+	const FrameGraphStats& GetStats() const { return m_tStats; }
+
+	// @brief 影とポストエフェクトを想定したグラフでコンパイル結果を計測して書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int MeasureCompile(const char* inReportPath);
+
+private:
+	// @brief リソース1つ分の情報
+	struct Resource
+	{
+		// 名前
+		const char* m_pName;
+
+		// 内容
+		FGTextureDesc m_tDesc;
+
+		// 取り込んだリソースかどうか
+		bool m_bImported;
+
+		// 取り込み番号、または実体の番号
+		uint32_t m_nIndex;
+
+		// 最初と最後に使う実行するパスの番号
+		uint32_t m_nFirst;
+		uint32_t m_nLast;
+	};
+
+	// @brief パス1つ分の情報
+	struct Pass
+	{
+		// 名前
+		const char* m_pName;
+
+		// 実行する処理
+		std::function<void()> m_Func;
+
+		// シェーダーから読むリソース
+		std::vector<FGResource> m_ReadVec;
+
+		// 書き込むカラーバッファ
+		std::vector<FGResource> m_ColorVec;
+
+		// 書き込む深度バッファ
+		FGResource m_nDepth;
+
+		// 書き込む前にクリアするリソース
+		std::vector<FGResource> m_ClearVec;
+
+		// 書き込み先が使われなくても除外しないか
+		bool m_bSideEffect;
+
+		// 除外されたか
+		bool m_bCulled;
+	};
+
+	// @brief 使われないパスを除外する
+	void Cull();
+
+	// @brief 一時リソースの使用期間を求め、期間が重ならないもの同士で実体を使い回す
+	void Alias();
+
+	// @brief 状態遷移、クリア、レンダーターゲットの設定、パスの実行の順に命令を並べる
+	void Schedule();
+
+	// @brief 2つのリソースの実体が同じか
+	// @param inA：リソースの番号
+	// @param inB：リソースの番号
+	// @return true:同じ false:異なる
+	bool IsSameTarget(FGResource inA, FGResource inB) const;
+
+	// @brief 実体毎の状態の番号を取得する
+	// @param inResource：リソースの番号
+	// @return 状態の番号(取り込んだリソースは一時リソースの実体の後ろに並べる)
+	size_t GetStateIndex(FGResource inResource) const;
+
+private:
+	// @brief リソース
+	std::vector<Resource> m_ResourceVec;
+
+	// @brief パス
+	std::vector<Pass> m_PassVec;
+
+	// @brief 一時リソースの実体毎の内容
+	std::vector<FGTextureDesc> m_PhysicalVec;
+
+	// @brief 実行する命令
+	std::vector<FGCommand> m_CommandVec;
+
+	// @brief コンパイル済みか
+	bool m_bCompiled;
+
+	// @brief 統計情報
+	FrameGraphStats m_tStats;
+};
@@ -0,0 +1,216 @@
+/**************************************************//*
+	@file	| FrameGraphBackend.cpp
+	@brief	| フレームグラフの実行先クラスのcppファイル
+	@note	| DirectX11でレンダーターゲットの設定とクリアを行い、
+			| 一時レンダーターゲットの実体をフレームをまたいで使い回す
+*//**************************************************/
+#include "FrameGraphBackend.h"
+#include "DirectX.h"
+#include <algorithm>
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CFrameGraphBackendDX::CFrameGraphBackendDX()
+	: m_ImportVec{}
+	, m_PoolVec{}
+	, m_PhysicalVec{}
+	, m_tPoolStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CFrameGraphBackendDX::~CFrameGraphBackendDX()
+{
+	for (PoolEntry& tEntry : m_PoolVec)
+	{
+		SAFE_DELETE(tEntry.m_pTexture);
+	}
+	m_PoolVec.clear();
+}
+
+/****************************************//*
+	@brief　	| 取り込むリソースの実体を登録する
+	@param　	| inImportId：取り込み番号(CFrameGraph::Importに渡す番号)
+	@param　	| pTexture：実体(RenderTargetかDepthStencil)
+*//****************************************/
+void CFrameGraphBackendDX::SetImport(uint32_t inImportId, Texture* pTexture)
+{
+	if (inImportId >= m_ImportVec.size()) m_ImportVec.resize(inImportId + 1, nullptr);
+	m_ImportVec[inImportId] = pTexture;
+}
+
+/****************************************//*
+	@brief　	| リソースの実体のテクスチャを取得する
+	@param　	| inTarget：リソースの実体
+	@return		| テクスチャ(無い場合はnullptr)
+*//****************************************/
+Texture* CFrameGraphBackendDX::GetTexture(const FGTarget& inTarget) const
+{
+	if (inTarget.m_bImported)
+	{
+		return inTarget.m_nIndex < m_ImportVec.size() ? m_ImportVec[inTarget.m_nIndex] : nullptr;
+	}
+	if (inTarget.m_nIndex >= m_PhysicalVec.size()) return nullptr;
+	return m_PoolVec[m_PhysicalVec[inTarget.m_nIndex]].m_pTexture;
+}
+
+/****************************************//*
+	@brief　	| 一時リソースの実体を用意する
+	@param　	| inPhysicalVec：実体毎の内容
+	@note		| 同じ内容の実体が置き場にあれば使い、無ければ作成する
+				| 使われないまま一定のフレーム数が経った実体は解放する
+*//****************************************/
+void CFrameGraphBackendDX::Realize(const std::vector<FGTextureDesc>& inPhysicalVec)
+{
+	for (PoolEntry& tEntry : m_PoolVec) tEntry.m_bUsed = false;
+
+	m_PhysicalVec.resize(inPhysicalVec.size());
+	for (size_t i = 0; i < inPhysicalVec.size(); i++)
+	{
+		const FGTextureDesc& tDesc = inPhysicalVec[i];
+
+		size_t nEntry = m_PoolVec.size();
+		for (size_t j = 0; j < m_PoolVec.size(); j++)
+		{
+			const PoolEntry& tEntry = m_PoolVec[j];
+			if (!tEntry.m_bUsed &&
+				tEntry.m_tDesc.m_nWidth == tDesc.m_nWidth &&
+				tEntry.m_tDesc.m_nHeight == tDesc.m_nHeight &&
+				tEntry.m_tDesc.m_nFormat == tDesc.m_nFormat &&
+				tEntry.m_tDesc.m_eKind == tDesc.m_eKind)
+			{
+				nEntry = j;
+				break;
+			}
+		}
+
+		if (nEntry == m_PoolVec.size())
+		{
+			PoolEntry tEntry = { tDesc, nullptr, 0, false };
+			HRESULT hr = E_FAIL;
+			if (tDesc.m_eKind == FGTargetKind::Depth)
+			{
+				DepthStencil* pDSV = new(std::nothrow) DepthStencil();
+				if (pDSV) hr = pDSV->Create(tDesc.m_nWidth, tDesc.m_nHeight, false);
+				tEntry.m_pTexture = pDSV;
+			}
+			else
+			{
+				RenderTarget* pRTV = new(std::nothrow) RenderTarget();
+				if (pRTV) hr = pRTV->Create(static_cast<DXGI_FORMAT>(tDesc.m_nFormat), tDesc.m_nWidth, tDesc.m_nHeight);
+				tEntry.m_pTexture = pRTV;
+			}
+			if (FAILED(hr))
+			{
+				SAFE_DELETE(tEntry.m_pTexture);
+				MessageBox(NULL, "CreateFailed:FrameGraphTarget", "Error:FrameGraphBackend.cpp", MB_OK);
+			}
+			m_PoolVec.push_back(tEntry);
+			m_tPoolStats.m_nCreateNum++;
+		}
+
+		m_PoolVec[nEntry].m_bUsed = true;
+		m_PoolVec[nEntry].m_nUnusedFrame = 0;
+		m_PhysicalVec[i] = nEntry;
+	}
+
+	// 使われなくなった実体を解放する(番号が変わるので後ろから詰める)
+	for (size_t j = m_PoolVec.size(); j-- > 0;)
+	{
+		PoolEntry& tEntry = m_PoolVec[j];
+		if (tEntry.m_bUsed || ++tEntry.m_nUnusedFrame < ce_nReleaseFrame) continue;
+
+		SAFE_DELETE(tEntry.m_pTexture);
+		m_PoolVec.erase(m_PoolVec.begin() + j);
+		for (size_t& nEntry : m_PhysicalVec)
+		{
+			if (nEntry > j) nEntry--;
+		}
+		m_tPoolStats.m_nReleaseNum++;
+	}
+
+	m_tPoolStats.m_nTargetNum = static_cast<int>(m_PoolVec.size());
+	m_tPoolStats.m_nTargetByte = 0;
+	for (const PoolEntry& tEntry : m_PoolVec)
+	{
+		if (tEntry.m_pTexture) m_tPoolStats.m_nTargetByte += tEntry.m_pTexture->GetMemorySize();
+	}
+}
+
+/****************************************//*
+	@brief　	| 状態遷移
+	@param　	| inTarget：リソースの実体
+	@param　	| inState：遷移後の状態
+	@note		| DirectX11は同じリソースを読み書き両方に設定しなければ自動で同期するので、
+				| 書き込みに使う前にピクセルシェーダーのテクスチャを外すだけにする
+				| (読む前のレンダーターゲットの解除はフレームグラフが命令に含める)
+*//****************************************/
+void CFrameGraphBackendDX::Transition(const FGTarget& inTarget, FGState inState)
+{
+	if (inState != FGState::RenderTarget) return;
+
+	ID3D11ShaderResourceView* pNullSRV[ce_nUnbindSlotNum] = {};
+	GetContext()->PSSetShaderResources(0, ce_nUnbindSlotNum, pNullSRV);
+}
+
+/****************************************//*
+	@brief　	| クリア
+	@param　	| inTarget：リソースの実体
+	@param　	| inDesc：リソースの内容
+*//****************************************/
+void CFrameGraphBackendDX::Clear(const FGTarget& inTarget, const FGTextureDesc& inDesc)
+{
+	Texture* pTexture = GetTexture(inTarget);
+	if (!pTexture) return;
+
+	if (inDesc.m_eKind == FGTargetKind::Depth) static_cast<DepthStencil*>(pTexture)->Clear();
+	else static_cast<RenderTarget*>(pTexture)->Clear(inDesc.m_fClearColor);
+}
+
+/****************************************//*
+	@brief　	| レンダーターゲットの設定
+	@param　	| pColors：カラーバッファの配列
+	@param　	| inColorNum：カラーバッファの数(0で設定を解除)
+	@param　	| pDepth：深度バッファ(nullptrで使わない)
+	@note		| ビューポートは最初のカラーバッファ(無ければ深度バッファ)の大きさに合わせる
+*//****************************************/
+void CFrameGraphBackendDX::BindTargets(const FGTarget* pColors, uint32_t inColorNum, const FGTarget* pDepth)
+{
+	ID3D11RenderTargetView* pRTV[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT] = {};
+	Texture* pViewport = nullptr;
+	UINT nNum = (std::min)(inColorNum, static_cast<uint32_t>(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT));
+	for (UINT i = 0; i < nNum; i++)
+	{
+		RenderTarget* pTarget = static_cast<RenderTarget*>(GetTexture(pColors[i]));
+		if (!pTarget) continue;
+		pRTV[i] = pTarget->GetView();
+		if (!pViewport) pViewport = pTarget;
+	}
+
+	ID3D11DepthStencilView* pDSV = nullptr;
+	if (pDepth)
+	{
+		DepthStencil* pTarget = static_cast<DepthStencil*>(GetTexture(*pDepth));
+		if (pTarget)
+		{
+			pDSV = pTarget->GetView();
+			if (!pViewport) pViewport = pTarget;
+		}
+	}
+
+	ID3D11DeviceContext* pContext = GetContext();
+	pContext->OMSetRenderTargets(nNum, pRTV, pDSV);
+	if (!pViewport) return;
+
+	D3D11_VIEWPORT vp;
+	vp.TopLeftX = 0.0f;
+	vp.TopLeftY = 0.0f;
+	vp.Width = static_cast<float>(pViewport->GetWidth());
+	vp.Height = static_cast<float>(pViewport->GetHeight());
+	vp.MinDepth = 0.0f;
+	vp.MaxDepth = 1.0f;
+	pContext->RSSetViewports(1, &vp);
+}
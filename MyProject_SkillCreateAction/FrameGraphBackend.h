@@ -0,0 +1,90 @@
+/**************************************************//*
+	@file	| FrameGraphBackend.h
+	@brief	| フレームグラフの実行先クラスのhファイル
+	@note	| DirectX11でレンダーターゲットの設定とクリアを行い、
+			| 一時レンダーターゲットの実体をフレームをまたいで使い回す
+*//**************************************************/
+#pragma once
+#include "FrameGraph.h"
+#include "Texture.h"
+
+// @brief レンダーターゲットの置き場の統計情報
+struct FrameGraphPoolStats
+{
+	// 置き場にある実体の数
+	int m_nTargetNum;
+
+	// 置き場にある実体のメモリ使用量(バイト)
+	size_t m_nTargetByte;
+
+	// 新しく作成した回数
+	int m_nCreateNum;
+
+	// 使われないまま時間が経ったため解放した回数
+	int m_nReleaseNum;
+};
+
+// @brief DirectX11でフレームグラフを実行するクラス
+class CFrameGraphBackendDX : public IFrameGraphBackend
+{
+public:
+	// @brief コンストラクタ
+	CFrameGraphBackendDX();
+
+	// @brief デストラクタ
+	~CFrameGraphBackendDX();
+
+	// @brief 取り込むリソースの実体を登録する
+	// @param inImportId：取り込み番号(CFrameGraph::Importに渡す番号)
+	// @param pTexture：実体(RenderTargetかDepthStencil)
+	void SetImport(uint32_t inImportId, Texture* pTexture);
+
+	// @brief リソースの実体のテクスチャを取得する(パスの中でシェーダーに渡す時に使う)
+	// @param inTarget：リソースの実体
+	// @return テクスチャ(無い場合はnullptr)
+	Texture* GetTexture(const FGTarget& inTarget) const;
+
+	// @brief 置き場の統計情報の取得
+	// @return 統計情報
+	const FrameGraphPoolStats& GetPoolStats() const { return m_tPoolStats; }
+
+	void Realize(const std::vector<FGTextureDesc>& inPhysicalVec) override;
+	void Transition(const FGTarget& inTarget, FGState inState) override;
+	void Clear(const FGTarget& inTarget, const FGTextureDesc& inDesc) override;
+	void BindTargets(const FGTarget* pColors, uint32_t inColorNum, const FGTarget* pDepth) override;
+
+private:
+	// @brief 置き場の実体1つ分
+	struct PoolEntry
+	{
+		// 内容
+		FGTextureDesc m_tDesc;
+
+		// 実体(種類に合わせてRenderTargetかDepthStencil)
+		Texture* m_pTexture;
+
+		// 使われなかったフレーム数
+		UINT m_nUnusedFrame;
+
+		// このフレームで使っているか
+		bool m_bUsed;
+	};
+
+	// @brief 使われないまま解放するまでのフレーム数
+	static constexpr UINT ce_nReleaseFrame = 120;
+
+	// @brief レンダーターゲットに設定する前に外すシェーダーリソースの数
+	static constexpr UINT ce_nUnbindSlotNum = 8;
+
+	// @brief 取り込んだリソースの実体(取り込み番号の順)
+	std::vector<Texture*> m_ImportVec;
+
+	// @brief 一時リソースの実体の置き場
+	std::vector<PoolEntry> m_PoolVec;
+
+	// @brief 一時リソースの実体毎の置き場の番号(FGTarget::m_nIndexの順)
+	std::vector<size_t> m_PhysicalVec;
+
+	// @brief 置き場の統計情報
+	FrameGraphPoolStats m_tPoolStats;
+};
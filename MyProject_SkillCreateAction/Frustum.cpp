@@ -0,0 +1,238 @@
+/**************************************************//*
+	@file	| Frustum.cpp
+	@brief	| 視錐台カリングクラスのcppファイル
+	@note	| カメラのビュー行列とプロジェクション行列から6平面を取り出し、
+			| 境界球が視錐台の外にあるかを判定する
+			| 複数の境界球は4つずつSIMDでまとめて判定する
+*//**************************************************/
+#include "Frustum.h"
+#include "Camera.h"
+#include "Defines.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <fstream>
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CFrustum::CFrustum()
+	: m_f4Plane{}
+{
+}
+
+/****************************************//*
+	@brief　	| ビュー行列とプロジェクション行列から視錐台を作成
+	@param　	| inView：ビュー行列(転置していない)
+	@param　	| inProj：プロジェクション行列(転置していない)
+*//****************************************/
+void CFrustum::Build(const DirectX::XMFLOAT4X4& inView, const DirectX::XMFLOAT4X4& inProj)
+{
+	// 行ベクトルの座標変換なので、ビュープロジェクション行列の列から平面を取り出す
+	DirectX::XMMATRIX mViewProj = DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&inView), DirectX::XMLoadFloat4x4(&inProj));
+	DirectX::XMMATRIX mColumn = DirectX::XMMatrixTranspose(mViewProj);
+
+	DirectX::XMVECTOR vPlane[6] =
+	{
+		DirectX::XMVectorAdd(mColumn.r[3], mColumn.r[0]),		// 左
+		DirectX::XMVectorSubtract(mColumn.r[3], mColumn.r[0]),	// 右
+		DirectX::XMVectorAdd(mColumn.r[3], mColumn.r[1]),		// 下
+		DirectX::XMVectorSubtract(mColumn.r[3], mColumn.r[1]),	// 上
+		mColumn.r[2],											// 手前(DirectXの深度は0～1)
+		DirectX::XMVectorSubtract(mColumn.r[3], mColumn.r[2]),	// 奥
+	};
+
+	for (int i = 0; i < 6; i++)
+	{
+		DirectX::XMStoreFloat4(&m_f4Plane[i], DirectX::XMPlaneNormalize(vPlane[i]));
+	}
+}
+
+/****************************************//*
+	@brief　	| 境界球が視錐台の中にあるかどうか
+	@param　	| inSphere：境界球
+	@return		| true:中にある(一部でも入っている) false:完全に外にある
+*//****************************************/
+bool CFrustum::IsVisible(const BoundingSphere& inSphere) const
+{
+	DirectX::XMVECTOR vCenter = DirectX::XMLoadFloat3(&inSphere.m_f3Center);
+	for (int i = 0; i < 6; i++)
+	{
+		float fDistance = DirectX::XMVectorGetX(DirectX::XMPlaneDotCoord(DirectX::XMLoadFloat4(&m_f4Plane[i]), vCenter));
+		if (fDistance < -inSphere.m_fRadius) return false;
+	}
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 複数の境界球をまとめて判定する
+	@param　	| pSphere：境界球の配列
+	@param　	| inNum：境界球の数
+	@param　	| pVisible：判定結果の書き込み先(1:中にある 0:外にある)
+	@return		| 中にあった境界球の数
+*//****************************************/
+int CFrustum::Cull(const BoundingSphere* pSphere, size_t inNum, uint8_t* pVisible) const
+{
+	// 平面の各成分を4要素に複製しておく
+	DirectX::XMVECTOR vPlaneX[6], vPlaneY[6], vPlaneZ[6], vPlaneW[6];
+	for (int i = 0; i < 6; i++)
+	{
+		DirectX::XMVECTOR vPlane = DirectX::XMLoadFloat4(&m_f4Plane[i]);
+		vPlaneX[i] = DirectX::XMVectorSplatX(vPlane);
+		vPlaneY[i] = DirectX::XMVectorSplatY(vPlane);
+		vPlaneZ[i] = DirectX::XMVectorSplatZ(vPlane);
+		vPlaneW[i] = DirectX::XMVectorSplatW(vPlane);
+	}
+
+	int nVisible = 0;
+	size_t i = 0;
+
+	// 4つの境界球を成分毎に並べ替えて1回の計算で判定する
+	for (; i + 4 <= inNum; i += 4)
+	{
+		const BoundingSphere* p = pSphere + i;
+		DirectX::XMVECTOR vX = DirectX::XMVectorSet(p[0].m_f3Center.x, p[1].m_f3Center.x, p[2].m_f3Center.x, p[3].m_f3Center.x);
+		DirectX::XMVECTOR vY = DirectX::XMVectorSet(p[0].m_f3Center.y, p[1].m_f3Center.y, p[2].m_f3Center.y, p[3].m_f3Center.y);
+		DirectX::XMVECTOR vZ = DirectX::XMVectorSet(p[0].m_f3Center.z, p[1].m_f3Center.z, p[2].m_f3Center.z, p[3].m_f3Center.z);
+		DirectX::XMVECTOR vNegRadius = DirectX::XMVectorNegate(DirectX::XMVectorSet(p[0].m_fRadius, p[1].m_fRadius, p[2].m_fRadius, p[3].m_fRadius));
+
+		// どれか1つの平面の外側にあれば視錐台の外
+		DirectX::XMVECTOR vOutside = DirectX::XMVectorFalseInt();
+		for (int j = 0; j < 6; j++)
+		{
+			DirectX::XMVECTOR vDistance = DirectX::XMVectorMultiplyAdd(vX, vPlaneX[j], vPlaneW[j]);
+			vDistance = DirectX::XMVectorMultiplyAdd(vY, vPlaneY[j], vDistance);
+			vDistance = DirectX::XMVectorMultiplyAdd(vZ, vPlaneZ[j], vDistance);
+			vOutside = DirectX::XMVectorOrInt(vOutside, DirectX::XMVectorLess(vDistance, vNegRadius));
+		}
+
+		uint32_t nOutside[4];
+		DirectX::XMStoreInt4(nOutside, vOutside);
+		for (int k = 0; k < 4; k++)
+		{
+			pVisible[i + k] = nOutside[k] ? 0 : 1;
+			nVisible += pVisible[i + k];
+		}
+	}
+
+	// 4つに満たない残りは1つずつ判定する
+	for (; i < inNum; i++)
+	{
+		pVisible[i] = IsVisible(pSphere[i]) ? 1 : 0;
+		nVisible += pVisible[i];
+	}
+
+	return nVisible;
+}
+
+/****************************************//*
+	@brief　	| 2つの境界球を囲む境界球を作成
+	@param　	| inA：境界球
+	@param　	| inB：境界球
+	@return		| 両方を囲む境界球
+*//****************************************/
+BoundingSphere CFrustum::Merge(const BoundingSphere& inA, const BoundingSphere& inB)
+{
+	DirectX::XMVECTOR vA = DirectX::XMLoadFloat3(&inA.m_f3Center);
+	DirectX::XMVECTOR vB = DirectX::XMLoadFloat3(&inB.m_f3Center);
+	float fDistance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(vB, vA)));
+
+	// 片方がもう片方を含んでいる場合は大きい方をそのまま使う
+	if (fDistance + inB.m_fRadius <= inA.m_fRadius) return inA;
+	if (fDistance + inA.m_fRadius <= inB.m_fRadius) return inB;
+
+	BoundingSphere tResult;
+	tResult.m_fRadius = (fDistance + inA.m_fRadius + inB.m_fRadius) * 0.5f;
+
+	// Aの中心からBの方向へ、Aの外周が新しい外周に接する位置まで中心を動かす
+	float fRate = (tResult.m_fRadius - inA.m_fRadius) / fDistance;
+	DirectX::XMStoreFloat3(&tResult.m_f3Center, DirectX::XMVectorLerp(vA, vB, fRate));
+	return tResult;
+}
+
+/****************************************//*
+	@brief　	| 現在のカメラで境界球を判定し、掛かった時間を計測する
+	@param　	| inNum：判定する境界球の数
+	@return		| 計測結果
+*//****************************************/
+CullBenchmark CFrustum::Benchmark(int inNum)
+{
+	CullBenchmark tResult = {};
+	tResult.m_nBoundsNum = inNum;
+	if (inNum <= 0) return tResult;
+
+	CCamera* pCamera = CCamera::GetInstance();
+	CFrustum tFrustum;
+	tFrustum.Build(pCamera->GetViewMatrix(false), pCamera->GetProjectionMatrix(false));
+
+	// カメラの周囲に境界球を散らばらせる(毎回同じ配置になるようにシードは固定)
+	const float ce_fRange = 200.0f;
+	std::mt19937 tRand(0);
+	std::uniform_real_distribution<float> tPosDist(-ce_fRange, ce_fRange);
+	std::uniform_real_distribution<float> tRadiusDist(0.5f, 2.0f);
+	DirectX::XMFLOAT3 f3CamPos = pCamera->GetPos();
+	std::vector<BoundingSphere> tSphereVec(inNum);
+	for (BoundingSphere& tSphere : tSphereVec)
+	{
+		tSphere.m_f3Center = DirectX::XMFLOAT3(f3CamPos.x + tPosDist(tRand), f3CamPos.y + tPosDist(tRand), f3CamPos.z + tPosDist(tRand));
+		tSphere.m_fRadius = tRadiusDist(tRand);
+	}
+	std::vector<uint8_t> bSingleVec(inNum);
+	std::vector<uint8_t> bVisibleVec(inNum);
+
+	LARGE_INTEGER freq, start, end;
+	QueryPerformanceFrequency(&freq);
+
+	// 1つずつ判定
+	QueryPerformanceCounter(&start);
+	int nSingleVisible = 0;
+	for (int i = 0; i < inNum; i++)
+	{
+		bSingleVec[i] = tFrustum.IsVisible(tSphereVec[i]) ? 1 : 0;
+		nSingleVisible += bSingleVec[i];
+	}
+	QueryPerformanceCounter(&end);
+	tResult.m_dSingleMs = static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(freq.QuadPart);
+
+	// 4つずつまとめて判定
+	QueryPerformanceCounter(&start);
+	tResult.m_nVisibleNum = tFrustum.Cull(tSphereVec.data(), tSphereVec.size(), bVisibleVec.data());
+	QueryPerformanceCounter(&end);
+	tResult.m_dBatchMs = static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(freq.QuadPart);
+
+	// 2つの判定結果は境界球毎に一致するはず
+	for (int i = 0; i < inNum; i++)
+	{
+		if (bSingleVec[i] != bVisibleVec[i]) tResult.m_nMismatchNum++;
+	}
+	assert(nSingleVisible == tResult.m_nVisibleNum);
+
+	return tResult;
+}
+
+/****************************************//*
+	@brief　	| 10万個の境界球で計測し、結果を書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:判定結果が一致した 1:食い違いがあった
+*//****************************************/
+int CFrustum::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	CullBenchmark tResult = Benchmark(100000);
+
+	// 全て見えている、または全て見えていない場合は判定が機能していない
+	bool bSuccess = tResult.m_nMismatchNum == 0 &&
+		tResult.m_nVisibleNum > 0 && tResult.m_nVisibleNum < tResult.m_nBoundsNum;
+
+	char szLine[256];
+	sprintf_s(szLine, "bounds %d visible %d mismatch %d\n", tResult.m_nBoundsNum, tResult.m_nVisibleNum, tResult.m_nMismatchNum);
+	tReport << szLine;
+	sprintf_s(szLine, "single %.3f ms batch %.3f ms speedup %.2fx\n", tResult.m_dSingleMs, tResult.m_dBatchMs,
+		tResult.m_dBatchMs > 0.0 ? tResult.m_dSingleMs / tResult.m_dBatchMs : 0.0);
+	tReport << szLine;
+	tReport << (bSuccess ? "ok\n" : "FAILED\n");
+
+	return bSuccess ? 0 : 1;
+}
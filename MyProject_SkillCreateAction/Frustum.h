@@ -0,0 +1,97 @@
+/**************************************************//*
+	@file	| Frustum.h
+	@brief	| 視錐台カリングクラスのhファイル
+	@note	| カメラのビュー行列とプロジェクション行列から6平面を取り出し、
+			| 境界球が視錐台の外にあるかを判定する
+			| 複数の境界球は4つずつSIMDでまとめて判定する
+*//**************************************************/
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+
+// @brief 境界球
+struct BoundingSphere
+{
+	// 中心座標
+	DirectX::XMFLOAT3 m_f3Center;
+
+	// 半径
+	float m_fRadius;
+};
+
+// @brief 視錐台カリングの統計情報
+struct CullStats
+{
+	// 判定した境界球の数
+	int m_nTestNum;
+
+	// 視錐台の中にあった数
+	int m_nVisibleNum;
+
+	// 視錐台の外にあったため描画しなかった数
+	int m_nCulledNum;
+};
+
+// @brief 視錐台カリングの計測結果
+struct CullBenchmark
+{
+	// 判定した境界球の数
+	int m_nBoundsNum;
+
+	// 視錐台の中にあった数
+	int m_nVisibleNum;
+
+	// 1つずつ判定した時間(ミリ秒)
+	double m_dSingleMs;
+
+	// 4つずつまとめて判定した時間(ミリ秒)
+	double m_dBatchMs;
+
+	// 1つずつと4つずつで判定結果が食い違った数
+	int m_nMismatchNum;
+};
+
+// @brief 視錐台カリングクラス
+class CFrustum
+{
+public:
+	// @brief コンストラクタ
+	CFrustum();
+
+	// @brief ビュー行列とプロジェクション行列から視錐台を作成
+	// @param inView：ビュー行列(転置していない)
+	// @param inProj：プロジェクション行列(転置していない)
+	void Build(const DirectX::XMFLOAT4X4& inView, const DirectX::XMFLOAT4X4& inProj);
+
+	// @brief 境界球が視錐台の中にあるかどうか
+	// @param inSphere：境界球
+	// @return true:中にある(一部でも入っている) false:完全に外にある
+	bool IsVisible(const BoundingSphere& inSphere) const;
+
+	// @brief 複数の境界球をまとめて判定する
+	// @param pSphere：境界球の配列
+	// @param inNum：境界球の数
+	// @param pVisible：判定結果の書き込み先(1:中にある 0:外にある)
+	// @return 中にあった境界球の数
+	int Cull(const BoundingSphere* pSphere, size_t inNum, uint8_t* pVisible) const;
+
+	// @brief 2つの境界球を囲む境界球を作成
+	// @param inA：境界球
+	// @param inB：境界球
+	// @return 両方を囲む境界球
+	static BoundingSphere Merge(const BoundingSphere& inA, const BoundingSphere& inB);
+
+	// @brief 現在のカメラで境界球を判定し、掛かった時間を計測する
+	// @param inNum：判定する境界球の数
+	// @return 計測結果
+	static CullBenchmark Benchmark(int inNum);
+
+	// @brief 10万個の境界球で計測し、結果を書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:判定結果が一致した 1:食い違いがあった
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief 視錐台の6平面(法線は内向き、正規化済み)
+	DirectX::XMFLOAT4 m_f4Plane[6];
+};
@@ -87,11 +87,55 @@ void CGameObject::Draw()
 }
 
 /****************************************//*
-    @brief　	| 他のオブジェクトと衝突した時の処理
-    @param      | other：衝突先のオブジェクト
-    @param      | thisTag：衝突したオブジェクトのコリジョン識別用タグ
+    @brief　	| 視錐台カリング用の境界球を取得
+    @param      | outSphere：全ての描画用コンポーネントを囲む境界球の書き込み先
+    @return     | true:取得できた false:常に描画する(描画用コンポーネントが無い、または画面に直接描画するものがある)
 *//****************************************/
-void CGameObject::OnColliderHit(CCollisionBase* other, std::string thisTag)
+bool CGameObject::GetCullBounds(BoundingSphere& outSphere)
+{
+    bool bFound = false;
+    for (auto comp : m_pComponent_List)
+    {
+        CRendererComponent* pRenderer = dynamic_cast<CRendererComponent*>(comp);
+        if (!pRenderer) continue;
+
+        // 描画時と同じ汎用パラメータで境界球を求める
+        pRenderer->SetRendererParam(m_tParam);
+        BoundingSphere tSphere;
+        if (!pRenderer->GetWorldBounds(tSphere)) return false;
+
+        outSphere = bFound ? CFrustum::Merge(outSphere, tSphere) : tSphere;
+        bFound = true;
+    }
+    return bFound;
+}
+
+/****************************************//*
+    @brief　	| 他の当たり判定と触れ始めた時の処理
+    @param      | other：衝突先の当たり判定
+    @param      | thisCollision：衝突したこのオブジェクトの当たり判定
+*//****************************************/
+void CGameObject::OnCollisionEnter(CCollisionBase* other, CCollisionBase* thisCollision)
+{
+
+}
+
+/****************************************//*
+    @brief　	| 他の当たり判定と前のフレームから触れ続けている時の処理
+    @param      | other：衝突先の当たり判定
+    @param      | thisCollision：衝突したこのオブジェクトの当たり判定
+*//****************************************/
+void CGameObject::OnCollisionStay(CCollisionBase* other, CCollisionBase* thisCollision)
+{
+
+}
+
+/****************************************//*
+    @brief　	| 他の当たり判定から離れた時の処理
+    @param      | other：衝突先の当たり判定
+    @param      | thisCollision：衝突したこのオブジェクトの当たり判定
+*//****************************************/
+void CGameObject::OnCollisionExit(CCollisionBase* other, CCollisionBase* thisCollision)
 {
 
 }
@@ -70,10 +70,26 @@ public:
 	// @brief 描画処理
 	virtual void Draw();
 
-	// @brief 他のオブジェクトと衝突した時の処理
-	// @param other：衝突先のオブジェクト
-	// @param thisTag：衝突したオブジェクトのコリジョン識別用タグ
-	 virtual void OnColliderHit(CCollisionBase* other, std::string thisTag = "None");
+	// @brief 視錐台カリング用の境界球を取得
+	// @param outSphere：全ての描画用コンポーネントを囲む境界球の書き込み先
+	// @return true:取得できた false:常に描画する(描画用コンポーネントが無い、または画面に直接描画するものがある)
+	bool GetCullBounds(BoundingSphere& outSphere);
+
+	// @brief 他の当たり判定と触れ始めた時の処理
+	// @param other：衝突先の当たり判定
+	// @param thisCollision：衝突したこのオブジェクトの当たり判定(GetLayerで区別する)
+	virtual void OnCollisionEnter(CCollisionBase* other, CCollisionBase* thisCollision);
+
+	// @brief 他の当たり判定と前のフレームから触れ続けている時の処理
+	// @param other：衝突先の当たり判定
+	// @param thisCollision：衝突したこのオブジェクトの当たり判定(GetLayerで区別する)
+	virtual void OnCollisionStay(CCollisionBase* other, CCollisionBase* thisCollision);
+
+	// @brief 他の当たり判定から離れた時の処理
+	// @param other：衝突先の当たり判定
+	// @param thisCollision：衝突したこのオブジェクトの当たり判定(GetLayerで区別する)
+	// @note どちらかの当たり判定が破棄予定になった時や、アクティブでなくなった時も呼ぶ
+	virtual void OnCollisionExit(CCollisionBase* other, CCollisionBase* thisCollision);
 
 	// @brief オブジェクトが破棄された時の処理
     virtual void OnDestroy();
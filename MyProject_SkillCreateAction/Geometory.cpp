@@ -7,13 +7,15 @@
 MeshBuffer* Geometory::m_pBox;
 MeshBuffer* Geometory::m_pCylinder;
 MeshBuffer* Geometory::m_pSphere;
-MeshBuffer* Geometory::m_pLines;
 Shader* Geometory::m_pVS;
 Shader* Geometory::m_pPS;
 Shader* Geometory::m_pLineShader[2];
 DirectX::XMFLOAT4X4 Geometory::m_WVP[3];
-void* Geometory::m_pLineVtx;
-int Geometory::m_lineCnt = 0;
+std::vector<Geometory::LineVertex> Geometory::m_LineVtx[(int)LineMode::Max];
+ID3D11Buffer* Geometory::m_pLineBuffer = nullptr;
+UINT Geometory::m_lineCapacity = 0;
+UINT Geometory::m_lineWritePos = 0;
+LineStats Geometory::m_tLineStats = {};
 
 /*************************//*
 @brief  | 
@@ -28,7 +30,7 @@ void Geometory::Init()
 	MakeVS();
 	MakePS();
 	MakeLineShader();
-	MakeLine();
+	MakeLine(INIT_LINE_NUM);
 }
 
 /*************************//*
@@ -36,12 +38,13 @@ void Geometory::Init()
 *//*************************/
 void Geometory::Uninit()
 {
-	SAFE_DELETE_ARRAY(m_pLineVtx);
+	for (auto& vtx : m_LineVtx)
+		vtx.clear();
+	SAFE_RELEASE(m_pLineBuffer);
 	SAFE_DELETE(m_pLineShader[1]);
 	SAFE_DELETE(m_pLineShader[0]);
 	SAFE_DELETE(m_pPS);
 	SAFE_DELETE(m_pVS);
-	SAFE_DELETE(m_pLines);
 	SAFE_DELETE(m_pSphere);
 	SAFE_DELETE(m_pCylinder);
 	SAFE_DELETE(m_pBox);
@@ -79,29 +82,198 @@ void Geometory::SetProjection(DirectX::XMFLOAT4X4 proj)
 @param[in]  | startF̎n_
 @param[in]  | endF̏I_
 @param[in]  | colorF̐F
+@param[in]  | modeF`@
 *//*************************/
-void Geometory::AddLine(DirectX::XMFLOAT3 start, DirectX::XMFLOAT3 end, DirectX::XMFLOAT4 color)
+void Geometory::AddLine(DirectX::XMFLOAT3 start, DirectX::XMFLOAT3 end, DirectX::XMFLOAT4 color, LineMode mode)
 {
-	if (m_lineCnt < MAX_LINE_NUM)
+	LineVertex* pVtx = AllocLines(1, mode);
+	pVtx[0] = { start.x, start.y, start.z, color.x, color.y, color.z, color.w };
+	pVtx[1] = { end.x, end.y, end.z, color.x, color.y, color.z, color.w };
+}
+
+/*************************//*
+@brief		| ̐ǉ
+@param[in]  | worldF1ӂ1̗̂ϊ郏[hs(]uĂȂ)
+@param[in]  | colorF̐F
+@param[in]  | modeF`@
+*//*************************/
+void Geometory::AddBox(const DirectX::XMMATRIX& world, DirectX::XMFLOAT4 color, LineMode mode)
+{
+	static const DirectX::XMFLOAT3 local[8] = {
+		{-0.5f,-0.5f,-0.5f}, { 0.5f,-0.5f,-0.5f}, {-0.5f, 0.5f,-0.5f}, { 0.5f, 0.5f,-0.5f},
+		{-0.5f,-0.5f, 0.5f}, { 0.5f,-0.5f, 0.5f}, {-0.5f, 0.5f, 0.5f}, { 0.5f, 0.5f, 0.5f},
+	};
+
+	// 8_܂Ƃ߂ĕϊ
+	DirectX::XMFLOAT3 corner[8];
+	DirectX::XMVector3TransformCoordStream(corner, sizeof(DirectX::XMFLOAT3), local, sizeof(DirectX::XMFLOAT3), 8, world);
+	AddCorners(corner, color, mode);
+}
+
+/*************************//*
+@brief		| ̐ǉ(3̉~)
+@param[in]  | centerFSW
+@param[in]  | radiusFa
+@param[in]  | colorF̐F
+@param[in]  | modeF`@
+*//*************************/
+void Geometory::AddSphere(DirectX::XMFLOAT3 center, float radius, DirectX::XMFLOAT4 color, LineMode mode)
+{
+	DirectX::XMVECTOR vCenter = DirectX::XMLoadFloat3(&center);
+	DirectX::XMVECTOR vX = DirectX::XMVectorSet(radius, 0.0f, 0.0f, 0.0f);
+	DirectX::XMVECTOR vY = DirectX::XMVectorSet(0.0f, radius, 0.0f, 0.0f);
+	DirectX::XMVECTOR vZ = DirectX::XMVectorSet(0.0f, 0.0f, radius, 0.0f);
+	AddArc(vCenter, vX, vY, DirectX::XM_2PI, color, mode);
+	AddArc(vCenter, vY, vZ, DirectX::XM_2PI, color, mode);
+	AddArc(vCenter, vZ, vX, DirectX::XM_2PI, color, mode);
+}
+
+/*************************//*
+@brief		| JvZ̐ǉ
+@param[in]  | startFS̎n_
+@param[in]  | endFS̏I_
+@param[in]  | radiusFa
+@param[in]  | colorF̐F
+@param[in]  | modeF`@
+*//*************************/
+void Geometory::AddCapsule(DirectX::XMFLOAT3 start, DirectX::XMFLOAT3 end, float radius, DirectX::XMFLOAT4 color, LineMode mode)
+{
+	DirectX::XMVECTOR vStart = DirectX::XMLoadFloat3(&start);
+	DirectX::XMVECTOR vEnd = DirectX::XMLoadFloat3(&end);
+	DirectX::XMVECTOR vAxis = DirectX::XMVectorSubtract(vEnd, vStart);
+
+	// ꍇ͋ɂȂ
+	if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(vAxis)) < 1.0e-8f)
+	{
+		AddSphere(start, radius, color, mode);
+		return;
+	}
+
+	// Sɐ2߂
+	DirectX::XMVECTOR vDir = DirectX::XMVector3Normalize(vAxis);
+	DirectX::XMVECTOR vRef = fabsf(DirectX::XMVectorGetY(vDir)) < 0.99f ? DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f) : DirectX::XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+	DirectX::XMVECTOR vU = DirectX::XMVector3Normalize(DirectX::XMVector3Cross(vDir, vRef));
+	DirectX::XMVECTOR vV = DirectX::XMVector3Cross(vDir, vU);
+	vU = DirectX::XMVectorScale(vU, radius);
+	vV = DirectX::XMVectorScale(vV, radius);
+	vDir = DirectX::XMVectorScale(vDir, radius);
+
+	// [̉~
+	AddArc(vStart, vU, vV, DirectX::XM_2PI, color, mode);
+	AddArc(vEnd, vU, vV, DirectX::XM_2PI, color, mode);
+
+	// ʂ̐
+	DirectX::XMVECTOR vSide[4] = { vU, vV, DirectX::XMVectorNegate(vU), DirectX::XMVectorNegate(vV) };
+	for (int i = 0; i < 4; ++i)
+	{
+		DirectX::XMFLOAT3 pos[2];
+		DirectX::XMStoreFloat3(&pos[0], DirectX::XMVectorAdd(vStart, vSide[i]));
+		DirectX::XMStoreFloat3(&pos[1], DirectX::XMVectorAdd(vEnd, vSide[i]));
+		AddLine(pos[0], pos[1], color, mode);
+	}
+
+	// [̔
+	AddArc(vEnd, vU, vDir, DirectX::XM_PI, color, mode);
+	AddArc(vEnd, vV, vDir, DirectX::XM_PI, color, mode);
+	AddArc(vStart, vU, DirectX::XMVectorNegate(vDir), DirectX::XM_PI, color, mode);
+	AddArc(vStart, vV, DirectX::XMVectorNegate(vDir), DirectX::XM_PI, color, mode);
+}
+
+/*************************//*
+@brief		| ̐ǉ
+@param[in]  | viewFr[s(]uĂȂ)
+@param[in]  | projFvWFNVs(]uĂȂ)
+@param[in]  | colorF̐F
+@param[in]  | modeF`@
+*//*************************/
+void Geometory::AddFrustum(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& proj, DirectX::XMFLOAT4 color, LineMode mode)
+{
+	static const DirectX::XMFLOAT3 clip[8] = {
+		{-1.0f,-1.0f, 0.0f}, { 1.0f,-1.0f, 0.0f}, {-1.0f, 1.0f, 0.0f}, { 1.0f, 1.0f, 0.0f},
+		{-1.0f,-1.0f, 1.0f}, { 1.0f,-1.0f, 1.0f}, {-1.0f, 1.0f, 1.0f}, { 1.0f, 1.0f, 1.0f},
+	};
+
+	// KfoCXW8_[hWɖ߂
+	DirectX::XMMATRIX viewProj = DirectX::XMMatrixMultiply(DirectX::XMLoadFloat4x4(&view), DirectX::XMLoadFloat4x4(&proj));
+	DirectX::XMMATRIX invViewProj = DirectX::XMMatrixInverse(nullptr, viewProj);
+	DirectX::XMFLOAT3 corner[8];
+	DirectX::XMVector3TransformCoordStream(corner, sizeof(DirectX::XMFLOAT3), clip, sizeof(DirectX::XMFLOAT3), 8, invViewProj);
+	AddCorners(corner, color, mode);
+}
+
+/*************************//*
+@brief	| 1t[̐悤ɒ_obt@L
+@note	| ςݏIADrawLines̑O1񂾂Ă
+*//*************************/
+void Geometory::PrepareLines()
+{
+	m_tLineStats = {};
+
+	UINT lineNum = 0;
+	for (auto& vtx : m_LineVtx)
+		lineNum += static_cast<UINT>(vtx.size() / 2);
+	if (lineNum > m_lineCapacity)
 	{
-		LineVertex* pVtx = reinterpret_cast<LineVertex*>(m_pLineVtx);
-		pVtx[m_lineCnt * 2 + 0] = { start.x, start.y, start.z, color.x, color.y, color.z, color.w};
-		pVtx[m_lineCnt * 2 + 1] = { end.x, end.y, end.z, color.x, color.y, color.z, color.w };
-		++m_lineCnt;
+		UINT capacity = m_lineCapacity > 0 ? m_lineCapacity : INIT_LINE_NUM;
+		while (capacity < lineNum)
+			capacity *= 2;
+		MakeLine(capacity);
 	}
+	m_tLineStats.m_nCapacity = m_lineCapacity;
 }
 
 /*************************//*
-@brief	| `
+@brief		| 1t[̐̂Aw肵`@̐܂Ƃ߂ĕ`
+@param[in]	| modeF`@
+@note		| _[^[Qbg̓t[Otݒ肷
+			| (őOʂɕ`悷͐[xobt@OpXŕ`悷)
 *//*************************/
-void Geometory::DrawLines()
+void Geometory::DrawLines(LineMode mode)
 {
+	std::vector<LineVertex>& vtx = m_LineVtx[(int)mode];
+	if (vtx.empty() || !m_pLineBuffer)
+		return;
+	UINT vtxNum = static_cast<UINT>(vtx.size());
+
+	ID3D11DeviceContext* pContext = GetContext();
+
+	// O񏑂񂾑ɒǋLAɓȂjĐ擪珑
+	D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+	if (m_lineWritePos == 0 || m_lineWritePos + vtxNum > m_lineCapacity * 2)
+	{
+		mapType = D3D11_MAP_WRITE_DISCARD;
+		m_lineWritePos = 0;
+	}
+	D3D11_MAPPED_SUBRESOURCE mapResource;
+	if (FAILED(pContext->Map(m_pLineBuffer, 0, mapType, 0, &mapResource)))
+		return;
+	memcpy(reinterpret_cast<LineVertex*>(mapResource.pData) + m_lineWritePos, vtx.data(), sizeof(LineVertex) * vtxNum);
+	pContext->Unmap(m_pLineBuffer, 0);
+
 	m_pLineShader[0]->WriteBuffer(0, m_WVP);
 	m_pLineShader[0]->Bind();
 	m_pLineShader[1]->Bind();
-	m_pLines->Write(m_pLineVtx);
-	m_pLines->Draw(m_lineCnt * 2);
-	m_lineCnt = 0;
+
+	UINT stride = sizeof(LineVertex);
+	UINT offset = 0;
+	pContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+	pContext->IASetVertexBuffers(0, 1, &m_pLineBuffer, &stride, &offset);
+	pContext->Draw(vtxNum, m_lineWritePos);
+	m_lineWritePos += vtxNum;
+
+	m_tLineStats.m_nLineNum += static_cast<int>(vtxNum / 2);
+	m_tLineStats.m_nDrawNum++;
+	m_tLineStats.m_nUploadByte += sizeof(LineVertex) * vtxNum;
+}
+
+/*************************//*
+@brief	| ς񂾐j
+@note	| mۂ͎̈̃t[łg
+*//*************************/
+void Geometory::ClearLines()
+{
+	for (auto& vtx : m_LineVtx)
+		vtx.clear();
 }
 
 /*************************//*
@@ -160,8 +332,6 @@ void Geometory::DrawHorizontalSquare(DirectX::XMFLOAT3 tPoint1, DirectX::XMFLOAT
 	AddLine(tMinPoint, { tMinPoint.x ,tMinPoint.y,tMaxPoint.z }, { 1.0f,0.0f,0.0f,1.0f });
 	AddLine(tMinPoint, { tMaxPoint.x ,tMinPoint.y,tMinPoint.z }, { 1.0f,0.0f,0.0f,1.0f });
 
-	DrawLines();
-
 }
 
 /*************************//*
@@ -181,7 +351,6 @@ void Geometory::DrawVerticalXSquare(DirectX::XMFLOAT3 tPoint1, DirectX::XMFLOAT3
 	AddLine(tMaxPoint, { tMaxPoint.x ,tMaxPoint.y,tMinPoint.z }, { 1.0f,0.0f,0.0f,1.0f });
 	AddLine(tMinPoint, { tMinPoint.x ,tMinPoint.y,tMaxPoint.z }, { 1.0f,0.0f,0.0f,1.0f });
 
-	DrawLines();
 }
 
 /*************************//*
@@ -201,7 +370,6 @@ void Geometory::DrawVerticalZSquare(DirectX::XMFLOAT3 tPoint1, DirectX::XMFLOAT3
 	AddLine(tMaxPoint, { tMinPoint.x ,tMaxPoint.y,tMaxPoint.z }, { 1.0f,0.0f,0.0f,1.0f });
 	AddLine(tMinPoint, { tMaxPoint.x ,tMinPoint.y,tMinPoint.z }, { 1.0f,0.0f,0.0f,1.0f });
 
-	DrawLines();
 }
 
 /*************************//*
@@ -318,18 +486,98 @@ float4 main(PS_IN pin) : SV_TARGET0 {
 }
 
 /*************************//*
-@brief  | `pbV쐬
+@brief		| ̒_obt@쐬
+@param[in]	| lineNumF_obt@ɓ̐
 *//*************************/
-void Geometory::MakeLine()
+void Geometory::MakeLine(UINT lineNum)
 {
-	m_pLineVtx = new LineVertex[MAX_LINE_NUM * 2];
-	m_lineCnt = 0;
-	MeshBuffer::Description desc = {};
-	desc.pVtx = m_pLineVtx;
-	desc.vtxCount = MAX_LINE_NUM * 2;
-	desc.vtxSize = sizeof(LineVertex);
-	desc.topology = D3D11_PRIMITIVE_TOPOLOGY_LINELIST;
-	desc.isWrite = true;
-	m_pLines = new MeshBuffer();
-	m_pLines->Create(desc);
+	SAFE_RELEASE(m_pLineBuffer);
+	m_lineCapacity = 0;
+	m_lineWritePos = 0;
+
+	D3D11_BUFFER_DESC bufDesc = {};
+	bufDesc.ByteWidth = sizeof(LineVertex) * lineNum * 2;
+	bufDesc.Usage = D3D11_USAGE_DYNAMIC;
+	bufDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	bufDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	if (FAILED(GetDevice()->CreateBuffer(&bufDesc, nullptr, &m_pLineBuffer)))
+	{
+		m_pLineBuffer = nullptr;
+		MessageBox(NULL, "CreateFailed:LineBuffer", "Error:Geometory.cpp", MB_OK);
+		return;
+	}
+	m_lineCapacity = lineNum;
+}
+
+/*************************//*
+@brief		| ǉ̈̊m
+@param[in]	| lineNumFǉ̐
+@param[in]	| modeF`@
+@return		| ݐ̒_(lineNum * 2)
+*//*************************/
+Geometory::LineVertex* Geometory::AllocLines(int lineNum, LineMode mode)
+{
+	std::vector<LineVertex>& vtx = m_LineVtx[(int)mode];
+	size_t start = vtx.size();
+	vtx.resize(start + static_cast<size_t>(lineNum) * 2);
+	return vtx.data() + start;
+}
+
+/*************************//*
+@brief		| ~̐ǉ
+@param[in]	| centerFSW
+@param[in]	| axisUF~̖ʏ̎(a|)
+@param[in]	| axisVF~̖ʏ̎(a|)
+@param[in]	| angleF`悷px(radAaxisU甽v)
+@param[in]	| colorF̐F
+@param[in]	| modeF`@
+*//*************************/
+void Geometory::AddArc(DirectX::FXMVECTOR center, DirectX::FXMVECTOR axisU, DirectX::FXMVECTOR axisV, float angle,
+	DirectX::XMFLOAT4 color, LineMode mode)
+{
+	// 1CIRCLE_DETAILׂŕ
+	int num = static_cast<int>(ceilf(CIRCLE_DETAIL * angle / DirectX::XM_2PI));
+	if (num < 1)
+		num = 1;
+
+	LineVertex* pVtx = AllocLines(num, mode);
+	DirectX::XMFLOAT3 prev;
+	DirectX::XMStoreFloat3(&prev, DirectX::XMVectorAdd(center, axisU));
+	for (int i = 1; i <= num; ++i)
+	{
+		float sinValue, cosValue;
+		DirectX::XMScalarSinCos(&sinValue, &cosValue, angle * i / num);
+		DirectX::XMVECTOR v = DirectX::XMVectorMultiplyAdd(axisU, DirectX::XMVectorReplicate(cosValue), center);
+		v = DirectX::XMVectorMultiplyAdd(axisV, DirectX::XMVectorReplicate(sinValue), v);
+		DirectX::XMFLOAT3 pos;
+		DirectX::XMStoreFloat3(&pos, v);
+
+		pVtx[(i - 1) * 2 + 0] = { prev.x, prev.y, prev.z, color.x, color.y, color.z, color.w };
+		pVtx[(i - 1) * 2 + 1] = { pos.x, pos.y, pos.z, color.x, color.y, color.z, color.w };
+		prev = pos;
+	}
+}
+
+/*************************//*
+@brief		| 8_12{̐ǉ
+@param[in]	| cornerF_(ԍbit0XAbit1YAbit2Z̐)
+@param[in]	| colorF̐F
+@param[in]	| modeF`@
+*//*************************/
+void Geometory::AddCorners(const DirectX::XMFLOAT3 (&corner)[8], DirectX::XMFLOAT4 color, LineMode mode)
+{
+	static const int edge[12][2] = {
+		{0, 1}, {2, 3}, {4, 5}, {6, 7},	// X
+		{0, 2}, {1, 3}, {4, 6}, {5, 7},	// Y
+		{0, 4}, {1, 5}, {2, 6}, {3, 7},	// Z
+	};
+
+	LineVertex* pVtx = AllocLines(12, mode);
+	for (int i = 0; i < 12; ++i)
+	{
+		const DirectX::XMFLOAT3& start = corner[edge[i][0]];
+		const DirectX::XMFLOAT3& end = corner[edge[i][1]];
+		pVtx[i * 2 + 0] = { start.x, start.y, start.z, color.x, color.y, color.z, color.w };
+		pVtx[i * 2 + 1] = { end.x, end.y, end.z, color.x, color.y, color.z, color.w };
+	}
 }
\ No newline at end of file
@@ -6,6 +6,35 @@
 #include <DirectXMath.h>
 #include "Shader.h"
 #include "MeshBuffer.h"
+#include <vector>
+
+// @brief ̕`@
+enum class LineMode
+{
+	// [xeXgs
+	Depth,
+
+	// [xeXgs킸őOʂɕ`悷
+	Overlay,
+
+	Max
+};
+
+// @brief `̓v
+struct LineStats
+{
+	// 1t[ɕ`悵̐
+	int m_nLineNum;
+
+	// `施߂̐
+	int m_nDrawNum;
+
+	// _obt@ɏ񂾃oCg
+	UINT m_nUploadByte;
+
+	// _obt@ɓ̐
+	UINT m_nCapacity;
+};
 
 // @brief 3D}``NX
 class Geometory
@@ -46,11 +75,63 @@ public:
 	// @param[in] start ̎n_
 	// @param[in] end ̏I_
 	// @param[in] color ̐F
+	// @param[in] mode `@
 	static void AddLine(DirectX::XMFLOAT3 start, DirectX::XMFLOAT3 end,
-		DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+		DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), LineMode mode = LineMode::Depth);
 
-	// @brief `
-	static void DrawLines();
+	// @brief ̐ǉ
+	// @param[in] world 1ӂ1̗̂ϊ郏[hs(]uĂȂ)
+	// @param[in] color ̐F
+	// @param[in] mode `@
+	static void AddBox(const DirectX::XMMATRIX& world,
+		DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), LineMode mode = LineMode::Depth);
+
+	// @brief ̐ǉ(3̉~)
+	// @param[in] center SW
+	// @param[in] radius a
+	// @param[in] color ̐F
+	// @param[in] mode `@
+	static void AddSphere(DirectX::XMFLOAT3 center, float radius,
+		DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), LineMode mode = LineMode::Depth);
+
+	// @brief JvZ̐ǉ
+	// @param[in] start S̎n_
+	// @param[in] end S̏I_
+	// @param[in] radius a
+	// @param[in] color ̐F
+	// @param[in] mode `@
+	static void AddCapsule(DirectX::XMFLOAT3 start, DirectX::XMFLOAT3 end, float radius,
+		DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), LineMode mode = LineMode::Depth);
+
+	// @brief ̐ǉ
+	// @param[in] view r[s(]uĂȂ)
+	// @param[in] proj vWFNVs(]uĂȂ)
+	// @param[in] color ̐F
+	// @param[in] mode `@
+	static void AddFrustum(const DirectX::XMFLOAT4X4& view, const DirectX::XMFLOAT4X4& proj,
+		DirectX::XMFLOAT4 color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), LineMode mode = LineMode::Depth);
+
+	// @brief 1t[̐悤ɒ_obt@L
+	// @note ςݏIADrawLines̑O1񂾂Ă
+	static void PrepareLines();
+
+	// @brief 1t[̐̂Aw肵`@̐܂Ƃ߂ĕ`
+	// @param[in] mode `@
+	// @note _[^[Qbg̓t[Otݒ肷
+	static void DrawLines(LineMode mode);
+
+	// @brief w肵`@̐ς܂Ă邩
+	// @param[in] mode `@
+	// @return true:ς܂Ă false:
+	static bool HasLines(LineMode mode) { return !m_LineVtx[(int)mode].empty(); }
+
+	// @brief ς񂾐j
+	// @note mۂ͎̈̃t[łg
+	static void ClearLines();
+
+	// @brief Oɕ`悵t[̐̓v̎擾
+	// @return v
+	static const LineStats& GetLineStats() { return m_tLineStats; }
 
 	// @brief `
 	static void DrawBox();
@@ -90,11 +171,34 @@ private:
 	static void MakeLineShader();
 
 	// @brief ̒_obt@쐬
-	static void MakeLine();
+	// @param[in] lineNum _obt@ɓ̐
+	static void MakeLine(UINT lineNum);
+
+	// @brief ǉ̈̊m
+	// @param[in] lineNum ǉ̐
+	// @param[in] mode `@
+	// @return ݐ̒_(lineNum * 2)
+	static LineVertex* AllocLines(int lineNum, LineMode mode);
+
+	// @brief ~̐ǉ
+	// @param[in] center SW
+	// @param[in] axisU ~̖ʏ̎(a|)
+	// @param[in] axisV ~̖ʏ̎(a|)
+	// @param[in] angle `悷px(radAaxisU甽v)
+	// @param[in] color ̐F
+	// @param[in] mode `@
+	static void AddArc(DirectX::FXMVECTOR center, DirectX::FXMVECTOR axisU, DirectX::FXMVECTOR axisV, float angle,
+		DirectX::XMFLOAT4 color, LineMode mode);
+
+	// @brief 8_12{̐ǉ
+	// @param[in] corner _(ԍbit0XAbit1YAbit2Z̐)
+	// @param[in] color ̐F
+	// @param[in] mode `@
+	static void AddCorners(const DirectX::XMFLOAT3 (&corner)[8], DirectX::XMFLOAT4 color, LineMode mode);
 
 private:
-	// ̍ő吔
-	static const int MAX_LINE_NUM = 1000;
+	// _obt@ɓ̏(Ȃꍇ͔{XɍL)
+	static const UINT INIT_LINE_NUM = 65536;
 
 	// ~̕
 	static const int CIRCLE_DETAIL = 16;
@@ -103,11 +207,15 @@ private:
 	static MeshBuffer* m_pBox;
 	static MeshBuffer* m_pCylinder;
 	static MeshBuffer* m_pSphere;
-	static MeshBuffer* m_pLines;
 	static Shader* m_pVS;
 	static Shader* m_pPS;
 	static Shader* m_pLineShader[2];
 	static DirectX::XMFLOAT4X4 m_WVP[3];
-	static void* m_pLineVtx;
-	static int m_lineCnt;
+	// `@1t[߂̒_
+	static std::vector<LineVertex> m_LineVtx[(int)LineMode::Max];
+	// ̒_obt@(O珇ɏ݁A܂Ŏg擪ɖ߂)
+	static ID3D11Buffer* m_pLineBuffer;
+	static UINT m_lineCapacity;
+	static UINT m_lineWritePos;
+	static LineStats m_tLineStats;
 };
@@ -9,6 +9,18 @@
 #include "imgui_impl_win32.h"
 #include "Main.h"
 #include "Camera.h"
+#include "AssetRegistry.h"
+#include "SpriteBatch.h"
+#include "RenderQueue.h"
+#include "FrameGraph.h"
+#include "PathService.h"
+#include "SkillEngine.h"
+#include "CrowdSystem.h"
+#include "BehaviorSystem.h"
+#include "Geometory.h"
+#include "ConstantBufferRing.h"
+#include "ShaderManager.h"
+#include <algorithm>
 
 //-- ÓIoϐ̏ --//
 CImguiSystem* CImguiSystem::m_pInstance = nullptr;
@@ -21,6 +33,9 @@ CImguiSystem::CImguiSystem()
 	: m_pGameObject(nullptr)
 	, m_bUpdate(true)
 	, m_bCollisionDraw(true)
+	, m_bLineStress(false)
+	, m_tImportBenchmark{}
+	, m_tCullBenchmark{}
 {
 }
 
@@ -111,6 +126,8 @@ void CImguiSystem::Draw()
 	DrawUpdateTick();
 	DrawCollision();
 	DrawFPS();
+	DrawAssetRegistry();
+	DrawRenderStats();
 
 	// IĂQ[IuWFNg݂ꍇ
 	// IĂIuWFNg̃CXyN^[\
@@ -272,12 +289,35 @@ void CImguiSystem::DrawCollision()
 	ImGui::Checkbox("DrawCollision", &m_bCollisionDraw);
 	ImGui::EndChild();
 	ImGui::End();
-	if (!m_bCollisionDraw)return;
+}
 
-	auto CollisionVec = GetScene()->GetCollisionVec();
-	for (int i = 0; i < CollisionVec.size(); i++)
+/****************************************//*
+	@brief@	| fobO\p̐ς
+	@note		| 蔻Ȃǂ̐A1t[̐܂Ƃ߂ĕ`悷Oɐς
+*//****************************************/
+void CImguiSystem::AddDebugLines()
+{
+	// 蔻
+	if (m_bCollisionDraw)
 	{
-		CollisionVec[i]->Draw();
+		auto CollisionVec = GetScene()->GetCollisionVec();
+		for (int i = 0; i < CollisionVec.size(); i++)
+		{
+			CollisionVec[i]->Draw();
+		}
+	}
+
+	// ̕`敉׊mFp10{(8334)ׂ
+	if (m_bLineStress)
+	{
+		constexpr int ce_nStressBoxNum = 8334;
+		constexpr int ce_nStressRowNum = 100;
+		for (int i = 0; i < ce_nStressBoxNum; i++)
+		{
+			float fX = static_cast<float>(i % ce_nStressRowNum - ce_nStressRowNum / 2);
+			float fZ = static_cast<float>(i / ce_nStressRowNum - ce_nStressRowNum / 2);
+			Geometory::AddBox(DirectX::XMMatrixTranslation(fX, 0.5f, fZ), DirectX::XMFLOAT4(1.0f, 1.0f, 0.0f, 1.0f));
+		}
 	}
 }
 
@@ -297,3 +337,229 @@ void CImguiSystem::DrawFPS()
 	ImGui::EndChild();
 	ImGui::End();
 }
+
+/****************************************//*
+	@brief@	| AZbg̃gpʁERXg\
+*//****************************************/
+void CImguiSystem::DrawAssetRegistry()
+{
+	ImGui::SetNextWindowPos(ImVec2(SCREEN_WIDTH - 300, 20.0f), ImGuiCond_Once);
+	ImGui::SetNextWindowSize(ImVec2(280, 220), ImGuiCond_Once);
+	ImGui::Begin("AssetRegistry");
+
+	CAssetRegistry* pRegistry = CAssetRegistry::GetInstance();
+	const AssetStats& tStats = pRegistry->GetStats();
+
+	// gp(KB)
+	ImGui::Text("Memory:%zu / %zu KB", tStats.m_nMemoryUsage / 1024, pRegistry->GetMemoryBudget() / 1024);
+	ImGui::Text("Loaded:%d  Evict:%d  Reload:%d", tStats.m_nLoadedCount, tStats.m_nEvictCount, tStats.m_nReloadCount);
+
+	// L[̃RXg
+	double dAverage = tStats.m_ulLookupCount > 0 ? tStats.m_dLookupTimeUs / static_cast<double>(tStats.m_ulLookupCount) : 0.0;
+	ImGui::Text("Lookup:%llu  Avg:%.3f us", static_cast<unsigned long long>(tStats.m_ulLookupCount), dAverage);
+
+	// fǂݍ݂1Xbhƕ̔r
+	if (ImGui::Button("ImportBenchmark"))
+	{
+		m_tImportBenchmark = CObjectLoad::BenchmarkImport();
+	}
+	if (m_tImportBenchmark.m_nFileNum > 0)
+	{
+		ImGui::Text("Files:%d 1T:%.1fms %uT:%.1fms", m_tImportBenchmark.m_nFileNum,
+			m_tImportBenchmark.m_dSingleMs, m_tImportBenchmark.m_nThreadNum, m_tImportBenchmark.m_dMultiMs);
+	}
+
+	// AZbg̏
+	if (ImGui::CollapsingHeader("[Assets]"))
+	{
+		for (const auto& itr : pRegistry->GetEntries())
+		{
+			const AssetEntry& tEntry = itr.second;
+			ImGui::Text("%s Ref:%d %zuKB %s", tEntry.m_sKey.c_str(), tEntry.m_nRefCount, tEntry.m_nMemorySize / 1024, tEntry.m_bLoaded ? "" : "(Evicted)");
+
+			// f͓ǂݍݎ̃bVœKʂ\
+			if (tEntry.m_bLoaded && tEntry.m_tObject.m_eKind == RendererKind::Model)
+			{
+				const MeshOptimizeStats& tOpt = std::get<ModelParam>(tEntry.m_tObject.m_Data).m_pModel->GetOptimizeStats();
+				ImGui::Text("  Vtx:%zu->%zu ACMR:%.2f->%.2f", tOpt.m_nVtxCountBefore, tOpt.m_nVtxCountAfter, tOpt.m_fACMRBefore, tOpt.m_fACMRAfter);
+				ImGui::Text("  VB:%zu->%zuKB IB:%zu->%zuKB", tOpt.m_nVtxBytesBefore / 1024, tOpt.m_nVtxBytesAfter / 1024, tOpt.m_nIdxBytesBefore / 1024, tOpt.m_nIdxBytesAfter / 1024);
+
+				// _ǩ
+				const VertexPackStats& tPack = std::get<ModelParam>(tEntry.m_tObject.m_Data).m_pModel->GetVertexPackStats();
+				ImGui::Text("  Pack:%zu->%zuKB S:%d SC:%d K:%d KC:%d", tPack.m_nFullBytes / 1024, tPack.m_nPackedBytes / 1024,
+					tPack.m_nLayoutCount[(int)VertexLayout::Static], tPack.m_nLayoutCount[(int)VertexLayout::StaticColor],
+					tPack.m_nLayoutCount[(int)VertexLayout::Skinned], tPack.m_nLayoutCount[(int)VertexLayout::SkinnedColor]);
+				ImGui::Text("  Err N:%.3fdeg UV:%.4f W:%.4f", tPack.m_fMaxNormalError, tPack.m_fMaxUVError, tPack.m_fMaxWeightError);
+
+				// LOD̎Op`ƍő덷
+				Model* pModel = std::get<ModelParam>(tEntry.m_tObject.m_Data).m_pModel;
+				size_t nLodTri[Model::MAX_LOD] = {};
+				float fLodError[Model::MAX_LOD] = {};
+				for (unsigned int i = 0; i < pModel->GetMeshNum(); i++)
+				{
+					const Model::MeshLods& lods = pModel->GetMesh(i)->lods;
+					for (UINT j = 0; j < Model::MAX_LOD && !lods.empty(); j++)
+					{
+						// LODȂbV͍łeLODŕ`悳
+						const Model::MeshLod& tLod = lods[(std::min<size_t>)(j, lods.size() - 1)];
+						nLodTri[j] += tLod.idxCount / 3;
+						fLodError[j] = (std::max)(fLodError[j], tLod.error);
+					}
+				}
+				for (UINT j = 0; j < Model::MAX_LOD; j++)
+				{
+					ImGui::Text("  LOD%u Tri:%zu Err:%.4f", j, nLodTri[j], fLodError[j]);
+				}
+			}
+		}
+	}
+
+	ImGui::End();
+}
+
+/****************************************//*
+	@brief@	| `施ߐ̕\
+*//****************************************/
+void CImguiSystem::DrawRenderStats()
+{
+	ImGui::SetNextWindowPos(ImVec2(SCREEN_WIDTH - 300, 250.0f), ImGuiCond_Once);
+	ImGui::SetNextWindowSize(ImVec2(280, 380), ImGuiCond_Once);
+	ImGui::Begin("RenderStats");
+
+	// JOŏOIuWFNg
+	CScene* pScene = GetScene();
+	bool bCulling = pScene->IsCulling();
+	if (ImGui::Checkbox("Culling", &bCulling)) pScene->SetCulling(bCulling);
+	const CullStats& tCull = pScene->GetCullStats();
+	ImGui::Text("Test:%d  Visible:%d  Culled:%d", tCull.m_nTestNum, tCull.m_nVisibleNum, tCull.m_nCulledNum);
+
+	// 10̋E̔Ɋ|鎞Ԃv
+	if (ImGui::Button("CullBenchmark"))
+	{
+		m_tCullBenchmark = CFrustum::Benchmark(100000);
+	}
+	if (m_tCullBenchmark.m_nBoundsNum > 0)
+	{
+		ImGui::Text("Bounds:%d Visible:%d", m_tCullBenchmark.m_nBoundsNum, m_tCullBenchmark.m_nVisibleNum);
+		ImGui::Text("1:%.2fms  4:%.2fms", m_tCullBenchmark.m_dSingleMs, m_tCullBenchmark.m_dBatchMs);
+	}
+
+	// `L[(f)̕`搔ƏԕύX
+	const RenderQueueStats& tQueue = RenderQueue::GetStats();
+	ImGui::Text("Model Cmd:%d  Draw:%d", tQueue.m_nCommandNum, tQueue.m_nDrawNum);
+	ImGui::Text("State:%d  Skip:%d", tQueue.m_nStateChangeNum, tQueue.m_nStateSkipNum);
+
+	// f̃CX^X`
+	bool bInstancing = RenderQueue::IsInstancing();
+	if (ImGui::Checkbox("Instancing", &bInstancing)) RenderQueue::SetInstancing(bInstancing);
+	ImGui::Text("Instanced:%d  Objects:%d", tQueue.m_nInstancedDrawNum, tQueue.m_nInstanceNum);
+
+	// XvCĝ܂Ƃߕ`(܂Ƃ߂Ȃꍇ̓XvCg`施߂o)
+	const SpriteBatchStats& tSprite = SpriteBatch::GetStats();
+	ImGui::Text("Sprite:%d  Draw:%d  Upload:%d", tSprite.m_nSpriteNum, tSprite.m_nCommandNum, tSprite.m_nUploadNum);
+
+	// eNX`܂Ƃ߂AgX(y[W̃XvCg1̕`ɂ܂Ƃ܂)
+	const TextureAtlasStats& tAtlas = CTextureAtlas::GetInstance()->GetStats();
+	ImGui::Text("Atlas Page:%d  Image:%d  Use:%.1f%%", tAtlas.m_nPageNum, tAtlas.m_nImageNum, tAtlas.m_fUtilization * 100.0f);
+
+	// fobO\̐(1t[܂Ƃ߂ĕ`悷)
+	const LineStats& tLine = Geometory::GetLineStats();
+	ImGui::Text("Line:%d  Draw:%d  Cap:%u", tLine.m_nLineNum, tLine.m_nDrawNum, tLine.m_nCapacity);
+	ImGui::Checkbox("LineStress", &m_bLineStress);
+
+	// t[Ot(_[^[Qbg̐ݒ͏ݐ悪ςpXłs)
+	const CFrameGraph& tGraph = GetFrameGraph();
+	const FrameGraphStats& tGraphStats = tGraph.GetStats();
+	ImGui::Text("Pass:%d  Culled:%d  Bind:%d  Skip:%d", tGraphStats.m_nPassNum, tGraphStats.m_nCulledNum, tGraphStats.m_nBindNum, tGraphStats.m_nBindSkipNum);
+	ImGui::Text("Transient:%d  Physical:%d  Barrier:%d  Clear:%d", tGraphStats.m_nTransientNum, tGraphStats.m_nPhysicalNum, tGraphStats.m_nTransitionNum, tGraphStats.m_nClearNum);
+	if (ImGui::CollapsingHeader("[FrameGraph]"))
+	{
+		for (uint32_t i = 0; i < tGraph.GetPassNum(); i++)
+		{
+			ImGui::Text("%s%s", tGraph.GetPassName(i), tGraph.IsCulled(i) ? " (Culled)" : "");
+		}
+	}
+
+	// 萔obt@̏(Oɏ߂Ȃł̓VF[_[̃obt@XV)
+	const ConstantBufferStats& tCB = ConstantBufferRing::GetStats();
+	if (ConstantBufferRing::IsSupported())
+	{
+		bool bRing = ConstantBufferRing::IsEnable();
+		if (ImGui::Checkbox("CBRing", &bRing)) ConstantBufferRing::SetEnable(bRing);
+	}
+	else
+	{
+		ImGui::Text("CBRing: Not Supported");
+	}
+	ImGui::Text("Ring:%d  %uB  Wrap:%d", tCB.m_nRingWriteNum, tCB.m_nRingByte, tCB.m_nWrapNum);
+	ImGui::Text("Update:%d  %uB", tCB.m_nUpdateNum, tCB.m_nUpdateByte);
+
+	// ÑVF[_[ǂݍ(LbVɖRpCƋNxȂ)
+	const ShaderLoadStats& tShader = CShaderManager::GetInstance()->GetLoadStats();
+	ImGui::Text("Shader:%d  Hit:%d  Compile:%d  Fail:%d", tShader.m_nShaderNum, tShader.m_nHitNum, tShader.m_nCompileNum, tShader.m_nFailNum);
+	ImGui::Text("ShaderLoad:%.2fms", tShader.m_dLoadMs);
+
+	// t@C̃eNX`ǂݍ(ϊς݂DDS̓ubNkƃ~bṽ݂TCY)
+	// ؂ւ͂ȍ~ɓǂݍރeNX`甽f
+	const TextureLoadStats tTexture = Texture::GetLoadStats();
+	bool bCooked = Texture::IsUseCooked();
+	if (ImGui::Checkbox("CookedTexture", &bCooked)) Texture::SetUseCooked(bCooked);
+	ImGui::Text("Tex Src:%d %.1fKB %.2fms", tTexture.m_nSourceNum, tTexture.m_nSourceByte / 1024.0, tTexture.m_dSourceMs);
+	ImGui::Text("Tex Cooked:%d %.1fKB %.2fms  Fallback:%d  Fail:%d", tTexture.m_nCookedNum, tTexture.m_nCookedByte / 1024.0, tTexture.m_dCookedMs, tTexture.m_nCookedFallbackNum, tTexture.m_nFailNum);
+
+	// oHT(v͂܂Ƃ߂ăWuVXeŒTÃt[Ɍʂ𔽉f)
+	CPathService* pPathService = CPathService::GetInstance();
+	const PathServiceStats& tPath = pPathService->GetStats();
+	bool bJPS = pPathService->GetAlgorithm() == PathAlgorithm::JPS;
+	if (ImGui::Checkbox("PathJPS", &bJPS)) pPathService->SetAlgorithm(bJPS ? PathAlgorithm::JPS : PathAlgorithm::AStar);
+	ImGui::Text("Path Req:%d  Dispatch:%d  Pending:%d", tPath.m_nRequestNum, tPath.m_nDispatchNum, tPath.m_nPendingNum);
+	ImGui::Text("Path Solved:%d  Fail:%d  Expand:%d  %.2fms", tPath.m_nSolvedNum, tPath.m_nFailedNum, tPath.m_nExpandNum, tPath.m_dSearchMs);
+
+	// XL(XL͖ߗ̃C^v^ŎsAeƎs̃XL̓v[o)
+	CSkillEngine* pSkillEngine = CSkillEngine::GetInstance();
+	const SkillEngineStats& tSkill = pSkillEngine->GetStats();
+	ImGui::Text("Skill Cast:%d  Reject:%d  Run:%d  Proj:%d", tSkill.m_nCastNum, tSkill.m_nRejectNum, tSkill.m_nInstanceNum, tSkill.m_nProjectileNum);
+	ImGui::Text("Skill Hit:%d  Effect:%d  Op:%d  Drop:%d  %.3fms", tSkill.m_nHitNum, tSkill.m_nEffectNum, tSkill.m_nOpNum, tSkill.m_nDropNum, tSkill.m_dUpdateMs);
+	const ProjectileStats& tProjectile = pSkillEngine->GetProjectiles().GetStats();
+	ImGui::Text("Proj Spawn:%d  Hit:%d  Expire:%d  Test:%d  %.3fms", tProjectile.m_nSpawnNum, tProjectile.m_nHitNum, tProjectile.m_nExpireNum, tProjectile.m_nTestNum, tProjectile.m_dUpdateMs);
+
+	// QO̕s(ߖT̑gƏՓ˂\ĔgAdȂĂg̐ƁAǂ𕪂ƃWu̐)
+	const CrowdStats& tCrowd = CCrowdSystem::GetInstance()->GetStats();
+	ImGui::Text("Crowd Agent:%d  Neighbor:%d  Avoid:%d  Overlap:%d", tCrowd.m_nAgentNum, tCrowd.m_nNeighborNum, tCrowd.m_nAvoidNum, tCrowd.m_nOverlapNum);
+	ImGui::Text("Crowd Chunk:%d  Job:%d  Grid:%.3fms  Steer:%.3fms", tCrowd.m_nChunkNum, tCrowd.m_nJobNum, tCrowd.m_dGridMs, tCrowd.m_dSteerMs);
+
+	// rwCrAc[(i߂s҂Ƃǂm[hAĂlςƁAԂ̏𒴂Ď̃t[ɉ񂵂)
+	CBehaviorSystem* pBehavior = CBehaviorSystem::GetInstance();
+	const BehaviorStats& tBehavior = pBehavior->GetStats();
+	bool bFullTick = pBehavior->IsFullTick();
+	if (ImGui::Checkbox("AIFullTick", &bFullTick)) pBehavior->SetFullTick(bFullTick);
+	ImGui::Text("AI Agent:%d  Tick:%d  Node:%d  Action:%d", tBehavior.m_nAgentNum, tBehavior.m_nTickNum, tBehavior.m_nNodeNum, tBehavior.m_nActionNum);
+	ImGui::Text("AI Event:%d  Wake:%d  Pending:%d  Delay:%d  %.3f/%.2fms", tBehavior.m_nEventNum, tBehavior.m_nWakeNum, tBehavior.m_nPendingNum, tBehavior.m_nMaxDelay, tBehavior.m_dUpdateMs, pBehavior->GetBudget());
+
+	// 蔻̋Ԍ(Õt[̌񐔂ƏՓ˔̌̑g̐AIAABBc[̍XV\)
+	const SpatialQueryStats& tQuery = pScene->GetSpatialQuery().GetStats();
+	const AabbTreeStats& tTree = pScene->GetSpatialQuery().GetTreeStats();
+	ImGui::Text("Query Box:%d  Node:%d  Update:%.3fms", tQuery.m_nBoxNum, tQuery.m_nNodeNum, tQuery.m_dUpdateMs);
+	ImGui::Text("Query:%d  Visit:%d  Test:%d  Pair:%d  Filter:%d", tQuery.m_nQueryNum, tQuery.m_nNodeVisitNum, tQuery.m_nTestNum, tQuery.m_nPairNum, tQuery.m_nFilterNum);
+	ImGui::Text("Tree Height:%d  Move:%d  Reinsert:%d  Rotate:%d  Rebuild:%d  Area:%.1f",
+		tTree.m_nHeight, tTree.m_nMoveNum, tTree.m_nReinsertNum, tTree.m_nRotateNum, tTree.m_nRebuildNum, tTree.m_fAreaRatio);
+
+	// ڐGĂg(ڍׂȔsĝAGn߁EGꑱEꂽg̐)
+	const ContactStats& tContact = pScene->GetContactStats();
+	ImGui::Text("Contact:%d  Enter:%d  Stay:%d  Exit:%d", tContact.m_nContactNum, tContact.m_nEnterNum, tContact.m_nStayNum, tContact.m_nExitNum);
+
+	// ̃t[ŕ`L[sꂽĂяoL^ĕ\
+	if (ImGui::Button("Capture"))
+	{
+		RenderQueue::RequestCapture();
+	}
+	if (ImGui::CollapsingHeader("[Capture]"))
+	{
+		for (const CRenderRecorder::Call& tCall : RenderQueue::GetCapture())
+		{
+			ImGui::Text("%s %p %u %u x%u", CRenderRecorder::GetCallName(tCall.m_eKind), tCall.m_pTarget, tCall.m_nValue, tCall.m_nStart, tCall.m_nInstanceNum);
+		}
+	}
+
+	ImGui::End();
+}
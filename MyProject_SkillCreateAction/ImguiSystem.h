@@ -6,6 +6,7 @@
 *//**************************************************/
 #pragma once
 #include "GameObject.h"
+#include "ObjectLoad.h"
 #include "imgui.h"
 
 constexpr ImVec2 ce_f2InspecterSize = ImVec2(250, 30);
@@ -48,6 +49,10 @@ public:
 	// @brief XVǗtO̎擾
 	// @return true:XVs false:XV~߂
 	bool IsUpdate() { return m_bUpdate; }
+
+	// @brief fobO\p̐ς
+	// @note 蔻Ȃǂ̐A1t[̐܂Ƃ߂ĕ`悷Oɐς
+	void AddDebugLines();
 private:
 	// @brief Kw\
 	void DrawHierarchy();
@@ -64,6 +69,12 @@ private:
 	// @brief t[[g\
 	void DrawFPS();
 
+	// @brief AZbg̃gpʁERXg\
+	void DrawAssetRegistry();
+
+	// @brief `施ߐ̕\
+	void DrawRenderStats();
+
 private:
 	// @brief CX^X
 	static CImguiSystem* m_pInstance;
@@ -78,5 +89,14 @@ private:
 	// @brief 蔻̕\tO
 	// @note true:蔻\ false:蔻\Ȃ
 	bool m_bCollisionDraw;
+
+	// @brief ̕`敉׊mFp̐\tO
+	bool m_bLineStress;
+
+	// @brief fǂݍ݂̌v
+	ImportBenchmark m_tImportBenchmark;
+
+	// @brief JǑv
+	CullBenchmark m_tCullBenchmark;
 };
 
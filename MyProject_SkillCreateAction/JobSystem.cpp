@@ -0,0 +1,198 @@
+/**************************************************//*
+	@file	| JobSystem.cpp
+	@brief	| ジョブシステムクラスのcppファイル
+	@note	| ワーカースレッドでジョブを並列に実行する
+			| シングルトンパターンで作成
+*//**************************************************/
+#include "JobSystem.h"
+#include <Windows.h>
+#include <algorithm>
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CJobSystem::CJobSystem()
+	: m_ThreadVec{}
+	, m_JobQueue{}
+	, m_nPendingNum(0)
+	, m_bQuit(false)
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CJobSystem::~CJobSystem()
+{
+	Uninit();
+}
+
+/****************************************//*
+	@brief　	| ワーカースレッドの起動
+	@param　	| inThreadNum：ワーカースレッド数(0でCPUのスレッド数に合わせる)
+*//****************************************/
+void CJobSystem::Init(unsigned int inThreadNum)
+{
+	if (!m_ThreadVec.empty()) return;
+
+	// メインスレッドの分を除いたCPUのスレッド数
+	if (inThreadNum == 0)
+	{
+		unsigned int nHardware = std::thread::hardware_concurrency();
+		inThreadNum = (std::max)(1u, nHardware > 1 ? nHardware - 1 : 1u);
+	}
+
+	m_bQuit = false;
+	for (unsigned int i = 0; i < inThreadNum; i++)
+	{
+		m_ThreadVec.emplace_back(&CJobSystem::WorkerMain, this);
+	}
+}
+
+/****************************************//*
+	@brief　	| ワーカースレッドの終了
+	@note		| 積まれているジョブは全て実行してから終了する
+*//****************************************/
+void CJobSystem::Uninit()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_bQuit = true;
+	}
+	m_cvJob.notify_all();
+
+	for (std::thread& thread : m_ThreadVec)
+	{
+		if (thread.joinable()) thread.join();
+	}
+	m_ThreadVec.clear();
+}
+
+/****************************************//*
+	@brief　	| ワーカースレッド数を変更する
+	@param　	| inThreadNum：ワーカースレッド数(0でCPUのスレッド数に合わせる)
+*//****************************************/
+void CJobSystem::SetThreadNum(unsigned int inThreadNum)
+{
+	Uninit();
+	Init(inThreadNum);
+}
+
+/****************************************//*
+	@brief　	| ジョブを積む
+	@param　	| inJob：実行する処理
+	@note		| ワーカースレッドが無い場合はその場で実行する
+*//****************************************/
+void CJobSystem::Submit(Job inJob)
+{
+	if (m_ThreadVec.empty())
+	{
+		inJob();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_JobQueue.push_back(std::move(inJob));
+		m_nPendingNum++;
+	}
+	m_cvJob.notify_one();
+
+	// 全てのワーカースレッドがジョブの中で完了を待っている場合に備え、待っている側にも実行させる
+	m_cvDone.notify_all();
+}
+
+/****************************************//*
+	@brief　	| 完了を待つまとまりに加えてジョブを積む
+	@param　	| inJob：実行する処理
+	@param　	| ioCounter：まとまりの未完了数(積んだ時に増え、完了した時に減る)
+	@note		| ワーカースレッドが無い場合はその場で実行する
+*//****************************************/
+void CJobSystem::Submit(Job inJob, Counter& ioCounter)
+{
+	ioCounter.fetch_add(1, std::memory_order_relaxed);
+	Submit([this, job = std::move(inJob), &ioCounter]()
+		{
+			job();
+			if (ioCounter.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+			// 待っている側が判定してから眠るまでの間に通知が抜けないよう、ロックを取ってから通知する
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+			}
+			m_cvDone.notify_all();
+		});
+}
+
+/****************************************//*
+	@brief　	| 積んだ全てのジョブの完了を待つ
+	@note		| 他の処理が積んだジョブも待つため、ワーカースレッドのジョブの中からは呼ばない
+*//****************************************/
+void CJobSystem::WaitAll()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_cvDone.wait(lock, [this]() { return m_nPendingNum == 0; });
+}
+
+/****************************************//*
+	@brief　	| まとまりのジョブの完了を待つ
+	@param　	| inCounter：まとまりの未完了数
+	@note		| 待っている間は積まれているジョブを代わりに実行するため、
+				| ワーカースレッドのジョブの中から呼んでも全員が待ち続けることはない
+*//****************************************/
+void CJobSystem::Wait(Counter& inCounter)
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while (inCounter.load(std::memory_order_acquire) > 0)
+	{
+		if (!m_JobQueue.empty())
+		{
+			Job job = std::move(m_JobQueue.front());
+			m_JobQueue.pop_front();
+			RunJob(job, lock);
+			continue;
+		}
+
+		// 残りは他のスレッドが実行中なので、完了かジョブの追加を待つ
+		m_cvDone.wait(lock, [this, &inCounter]() { return inCounter.load(std::memory_order_acquire) == 0 || !m_JobQueue.empty(); });
+	}
+}
+
+/****************************************//*
+	@brief　	| ワーカースレッドの処理
+*//****************************************/
+void CJobSystem::WorkerMain()
+{
+	// テクスチャ読み込み(WIC)のためにスレッド毎にCOMを初期化する
+	HRESULT hrCom = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_cvJob.wait(lock, [this]() { return m_bQuit || !m_JobQueue.empty(); });
+
+		// 終了要求があっても積まれているジョブは実行する
+		if (m_JobQueue.empty()) break;
+
+		Job job = std::move(m_JobQueue.front());
+		m_JobQueue.pop_front();
+		RunJob(job, lock);
+	}
+
+	if (SUCCEEDED(hrCom)) CoUninitialize();
+}
+
+/****************************************//*
+	@brief　	| 取り出したジョブを実行して未完了数を減らす
+	@param　	| inJob：実行する処理
+	@param　	| lock：ジョブキューのロック(実行中は外す)
+*//****************************************/
+void CJobSystem::RunJob(Job& inJob, std::unique_lock<std::mutex>& lock)
+{
+	lock.unlock();
+	inJob();
+	lock.lock();
+
+	m_nPendingNum--;
+	if (m_nPendingNum == 0) m_cvDone.notify_all();
+}
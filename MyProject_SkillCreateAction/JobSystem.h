@@ -0,0 +1,102 @@
+/**************************************************//*
+	@file	| JobSystem.h
+	@brief	| ジョブシステムクラスのhファイル
+	@note	| ワーカースレッドでジョブを並列に実行する
+			| シングルトンパターンで作成
+*//**************************************************/
+#pragma once
+#include "Singleton.h"
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// @brief ジョブシステムクラス
+class CJobSystem : public ISingleton<CJobSystem>
+{
+public:
+	// @brief ジョブの処理
+	using Job = std::function<void()>;
+
+	// @brief まとめて完了を待つジョブの未完了数
+	using Counter = std::atomic<size_t>;
+
+private:
+	// @brief コンストラクタ
+	CJobSystem();
+
+	friend class ISingleton<CJobSystem>;
+public:
+	// @brief デストラクタ
+	~CJobSystem();
+
+	// @brief ワーカースレッドの起動
+	// @param inThreadNum：ワーカースレッド数(0でCPUのスレッド数に合わせる)
+	void Init(unsigned int inThreadNum = 0);
+
+	// @brief ワーカースレッドの終了
+	// @note 積まれているジョブは全て実行してから終了する
+	void Uninit();
+
+	// @brief ワーカースレッド数を変更する
+	// @param inThreadNum：ワーカースレッド数(0でCPUのスレッド数に合わせる)
+	void SetThreadNum(unsigned int inThreadNum);
+
+	// @brief ワーカースレッド数を取得
+	// @return ワーカースレッド数
+	unsigned int GetThreadNum() const { return static_cast<unsigned int>(m_ThreadVec.size()); }
+
+	// @brief ジョブを積む
+	// @param inJob：実行する処理
+	// @note ワーカースレッドが無い場合はその場で実行する
+	void Submit(Job inJob);
+
+	// @brief 完了を待つまとまりに加えてジョブを積む
+	// @param inJob：実行する処理
+	// @param ioCounter：まとまりの未完了数(積んだ時に増え、完了した時に減る)
+	// @note ワーカースレッドが無い場合はその場で実行する
+	void Submit(Job inJob, Counter& ioCounter);
+
+	// @brief 積んだ全てのジョブの完了を待つ
+	// @note 他の処理が積んだジョブも待つため、ワーカースレッドのジョブの中からは呼ばない
+	void WaitAll();
+
+	// @brief まとまりのジョブの完了を待つ
+	// @param inCounter：まとまりの未完了数
+	// @note 待っている間は積まれているジョブを代わりに実行するため、ワーカースレッドのジョブの中からも呼べる
+	void Wait(Counter& inCounter);
+
+private:
+	// @brief ワーカースレッドの処理
+	void WorkerMain();
+
+	// @brief 取り出したジョブを実行して未完了数を減らす
+	// @param inJob：実行する処理
+	// @param lock：ジョブキューのロック(実行中は外す)
+	void RunJob(Job& inJob, std::unique_lock<std::mutex>& lock);
+
+private:
+	// @brief ワーカースレッド
+	std::vector<std::thread> m_ThreadVec;
+
+	// @brief 実行待ちのジョブ
+	std::deque<Job> m_JobQueue;
+
+	// @brief ジョブキューの排他制御
+	std::mutex m_Mutex;
+
+	// @brief ジョブが積まれたことの通知
+	std::condition_variable m_cvJob;
+
+	// @brief 全てのジョブが完了したことの通知
+	std::condition_variable m_cvDone;
+
+	// @brief 未完了のジョブ数(実行中を含む)
+	size_t m_nPendingNum;
+
+	// @brief ワーカースレッドの終了要求
+	bool m_bQuit;
+};
@@ -6,14 +6,29 @@
 #include "DirectX.h"
 #include "Geometory.h"
 #include "Sprite.h"
+#include "SpriteBatch.h"
+#include "RenderQueue.h"
+#include "FrameGraph.h"
+#include "FrameGraphBackend.h"
+#include "ShaderManager.h"
+#include "ConstantBufferRing.h"
+#include "VertexFormat.h"
 #include "Input.h"
 #include "Transition.h"
 #include "Camera.h"
 #include "ObjectLoad.h"
 #include "ImguiSystem.h"
+#include "AssetRegistry.h"
+#include "JobSystem.h"
+#include "PathService.h"
+#include "SkillEngine.h"
+#include "CrowdSystem.h"
+#include "BehaviorSystem.h"
 
 const static int DEBUG_GRID_NUM = 20;			// グリッドの数
 const static float DEBUG_GRID_MARGIN = 1.0f;	// グリッドの間隔
+const static uint32_t IMPORT_BACK_BUFFER = 0;	// フレームグラフに取り込むバックバッファの番号
+const static uint32_t IMPORT_DEPTH = 1;			// フレームグラフに取り込む深度バッファの番号
 
 //-- グローバル変数
 
@@ -31,6 +46,10 @@ CameraKind g_ekind;
 bool g_bDebugMode = false;
 // シーン切り替え中フラグ
 bool g_bSceneChanging = false;
+// フレームグラフ
+CFrameGraph g_frameGraph;
+// フレームグラフの実行先
+CFrameGraphBackendDX* g_pFrameGraphBackend = nullptr;
 
 
 /*************************//*
@@ -51,14 +70,46 @@ HRESULT Init(HWND hWnd, UINT width, UINT height)
 	// Imgui初期化
 	CImguiSystem::GetInstance()->Init();
 
+	// 頂点フォーマット初期化
+	VertexFormat::Init();
+
+	// ジョブシステム初期化
+	CJobSystem::GetInstance()->Init();
+
 	// オブジェクトのロード
 	CObjectLoad::LoadAll();
 
+	// スキルの定義を全てコンパイルして登録(プレイヤーが1～4キーに割り当てるため最初のシーンより先に行う)
+	std::vector<std::string> tSkillErrorVec;
+	CSkillEngine::GetInstance()->LoadSkillDirectory(SKILL_PATH(""), tSkillErrorVec);
+	for (const std::string& sError : tSkillErrorVec)
+	{
+		MessageBox(NULL, sError.c_str(), "Error", MB_OK);
+	}
+
 	// ジオメトリ初期化
 	Geometory::Init();
 
-	// スプライト初期化
+	// シェーダーの読み込み(全てのバリエーションをキャッシュから読み込む)
+	CShaderManager::GetInstance()->LoadShaders();
+
+	// スプライト初期化(シェーダーマネージャーのシェーダーを使う)
 	Sprite::Init();
+	SpriteBatch::Init();
+
+	// 定数バッファのリング初期化
+	ConstantBufferRing::Init();
+
+	// 描画キュー初期化
+	RenderQueue::Init();
+
+	// フレームグラフの実行先初期化(バックバッファと深度バッファを取り込む)
+	g_pFrameGraphBackend = new(std::nothrow) CFrameGraphBackendDX();
+	if (g_pFrameGraphBackend)
+	{
+		g_pFrameGraphBackend->SetImport(IMPORT_BACK_BUFFER, GetDefaultRTV());
+		g_pFrameGraphBackend->SetImport(IMPORT_DEPTH, GetDefaultDSV());
+	}
 
 	// 入力初期化
 	InitInput();
@@ -96,7 +147,21 @@ void Uninit()
 	// 入力の終了処理
 	UninitInput();
 
+	// 描画キューの終了処理
+	RenderQueue::Uninit();
+
+	// フレームグラフの終了処理
+	g_frameGraph.Reset();
+	SAFE_DELETE(g_pFrameGraphBackend);
+
+	// 定数バッファのリングの終了処理
+	ConstantBufferRing::Uninit();
+
+	// シェーダーの解放
+	CShaderManager::ReleaseInstance();
+
 	// スプライトの終了処理
+	SpriteBatch::Uninit();
 	Sprite::Uninit();
 
 	// ジオメトリの終了処理
@@ -105,6 +170,24 @@ void Uninit()
 	// オブジェクトのアンロード
 	CObjectLoad::UnLoadAll();
 
+	// スキル実行の終了処理(使用者を持つシーンより後に行う)
+	CSkillEngine::ReleaseInstance();
+
+	// ビヘイビアツリーの終了処理(歩行者を持つシーンより後に行う)
+	CBehaviorSystem::ReleaseInstance();
+
+	// 群衆の歩行シミュレーションの終了処理(歩行者を持つシーンより後、塊を取り出すジョブの完了を待つためジョブシステムより先に行う)
+	CCrowdSystem::ReleaseInstance();
+
+	// 経路探索サービスの終了処理(探索中のジョブの完了を待つためジョブシステムより先に行う)
+	CPathService::ReleaseInstance();
+
+	// ジョブシステムの終了処理
+	CJobSystem::ReleaseInstance();
+
+	// 頂点フォーマットの終了処理
+	VertexFormat::Uninit();
+
 	// Imguiの終了処理
 	CImguiSystem::GetInstance()->Uninit();
 	CImguiSystem::ReleaseInstance();
@@ -138,6 +221,9 @@ void Update()
 		pCamera->Update();
 		g_pScene->Update();
 		g_pTransition->Update();
+
+		// 経路探索の結果の反映と、このフレームに要求された経路の探索の発行
+		CPathService::GetInstance()->Update();
 	}
 
 	if (IsKeyPress('U'))
@@ -157,6 +243,9 @@ void Update()
 		}
 	}
 
+	// アセット管理の更新(メモリ予算超過分の破棄)
+	CAssetRegistry::GetInstance()->Update();
+
 	// Imguiの更新
 	CImguiSystem::GetInstance()->Update();
 }
@@ -166,7 +255,7 @@ void Update()
 *//*************************/
 void Draw()
 {
-	BeginDrawDirectX();
+	ConstantBufferRing::BeginFrame();
 
 	// デバッグモード時はグリッドと軸を描画
 	if (g_bDebugMode)
@@ -197,17 +286,98 @@ void Draw()
 		Geometory::AddLine(DirectX::XMFLOAT3(0, 0, 0), DirectX::XMFLOAT3(0, 0, size), DirectX::XMFLOAT4(0, 0, 1, 1));
 		Geometory::AddLine(DirectX::XMFLOAT3(0, 0, 0), DirectX::XMFLOAT3(-size, 0, 0), DirectX::XMFLOAT4(0, 0, 0, 1));
 		Geometory::AddLine(DirectX::XMFLOAT3(0, 0, 0), DirectX::XMFLOAT3(0, 0, -size), DirectX::XMFLOAT4(0, 0, 0, 1));
-
-		Geometory::DrawLines();
 	}
 
 	g_pScene->Draw();
 	g_pTransition->Draw();
-	if (g_bDebugMode)CImguiSystem::GetInstance()->Draw();
+
+	// デバッグモード時は当たり判定などの線を積む
+	if (g_bDebugMode) CImguiSystem::GetInstance()->AddDebugLines();
+
+	// 積んだモデル、線、スプライトを描画の前に並べ替える
+	RenderQueue::Sort();
+	Geometory::PrepareLines();
+	SpriteBatch::Build();
+
+	// 描画するものがあるパスだけでフレームグラフを組み立てて実行
+	BuildFrameGraph();
+	g_frameGraph.Compile();
+	if (g_pFrameGraphBackend) g_frameGraph.Execute(*g_pFrameGraphBackend);
+
+	RenderQueue::Clear();
+	Geometory::ClearLines();
+	SpriteBatch::Clear();
 
 	EndDrawDirectX();
 }
 
+/*************************//*
+	@brief 	| フレームグラフの組み立て
+	@note	| 描画するものがあるパスだけを描画順に登録し、
+			| バックバッファと深度バッファはそれぞれ最初に書き込むパスでクリアする
+*//*************************/
+void BuildFrameGraph()
+{
+	g_frameGraph.Reset();
+
+	RenderTarget* pRTV = GetDefaultRTV();
+	FGTextureDesc tColorDesc = { pRTV->GetWidth(), pRTV->GetHeight(), DXGI_FORMAT_UNKNOWN, FGTargetKind::Color, { 0.8f, 0.9f, 1.0f, 1.0f } };
+	FGTextureDesc tDepthDesc = { pRTV->GetWidth(), pRTV->GetHeight(), DXGI_FORMAT_UNKNOWN, FGTargetKind::Depth, {} };
+	FGResource nBackBuffer = g_frameGraph.Import("BackBuffer", tColorDesc, IMPORT_BACK_BUFFER);
+	FGResource nDepth = g_frameGraph.Import("Depth", tDepthDesc, IMPORT_DEPTH);
+
+	bool bColorClear = true;
+	bool bDepthClear = true;
+	auto AddPass = [&](const char* inName, bool isDepth, std::function<void()> inFunc)
+	{
+		CFrameGraph::PassBuilder tBuilder = g_frameGraph.AddPass(inName, std::move(inFunc));
+		tBuilder.Write(nBackBuffer, bColorClear);
+		bColorClear = false;
+		if (isDepth)
+		{
+			tBuilder.Write(nDepth, bDepthClear);
+			bDepthClear = false;
+		}
+	};
+
+	// モデル
+	if (RenderQueue::HasPass(RenderPass::World))
+		AddPass("Model", true, [] { RenderQueue::Flush(RenderPass::World); });
+	if (RenderQueue::HasPass(RenderPass::WorldNoDepth))
+		AddPass("ModelNoDepth", false, [] { RenderQueue::Flush(RenderPass::WorldNoDepth); });
+
+	// 線
+	if (Geometory::HasLines(LineMode::Depth))
+		AddPass("Line", true, [] { Geometory::DrawLines(LineMode::Depth); });
+	if (Geometory::HasLines(LineMode::Overlay))
+		AddPass("LineOverlay", false, [] { Geometory::DrawLines(LineMode::Overlay); });
+
+	// スプライト
+	if (SpriteBatch::HasPass(SpritePass::World))
+		AddPass("Sprite", true, [] { SpriteBatch::Draw(SpritePass::World); });
+	if (SpriteBatch::HasPass(SpritePass::WorldNoDepth))
+		AddPass("SpriteNoDepth", false, [] { SpriteBatch::Draw(SpritePass::WorldNoDepth); });
+	if (SpriteBatch::HasPass(SpritePass::Screen))
+		AddPass("SpriteScreen", false, [] { SpriteBatch::Draw(SpritePass::Screen); });
+
+	// デバッグ表示
+	if (g_bDebugMode)
+		AddPass("ImGui", false, [] { CImguiSystem::GetInstance()->Draw(); });
+
+	// 何も描画しないフレームでも画面はクリアする
+	if (bColorClear)
+		AddPass("Clear", false, nullptr);
+}
+
+/*************************//*
+	@brief 	| フレームグラフ取得
+	@return	| フレームグラフ
+*//*************************/
+const CFrameGraph& GetFrameGraph()
+{
+	return g_frameGraph;
+}
+
 /*************************//*
 	@brief 	| シーン取得
 	@return	| シーンポインタ
@@ -8,6 +8,9 @@
 #include <string>
 #include "Scene.h"
 
+// 前方宣言
+class CFrameGraph;
+
 // @brief 初期化
 // @param[in]	hWnd	ウィンドウハンドル
 // @param[in] 	width 画面幅
@@ -23,6 +26,13 @@ void Update();
 // @brief 描画
 void Draw();
 
+// @brief フレームグラフの組み立て
+void BuildFrameGraph();
+
+// @brief フレームグラフ取得
+// @return 直前に実行したフレームグラフ
+const CFrameGraph& GetFrameGraph();
+
 // @brief アプリケーション終了処理
 void AppEnd();
 
@@ -65,8 +65,9 @@ HRESULT MeshBuffer::Create(const Description& desc)
 /*************************//*
 @brief		| bVobt@̕`
 @param[in]	| countF`悷钸_ACfbNX(0w肵ꍇ̓obt@̐)
+@param[in]	| startF`Jnʒu(CfbNXȂΒ_̈ʒu)
 *//*************************/
-void MeshBuffer::Draw(int count)
+void MeshBuffer::Draw(int count, int start)
 {
 	ID3D11DeviceContext* pContext = GetContext();
 	UINT stride = m_desc.vtxSize;
@@ -85,24 +86,47 @@ void MeshBuffer::Draw(int count)
 		case 2: format = DXGI_FORMAT_R16_UINT; break;
 		}
 		pContext->IASetIndexBuffer(m_pIdxBuffer, format, 0);
-		pContext->DrawIndexed(count ? count : m_desc.idxCount, 0, 0);
+		pContext->DrawIndexed(count ? count : m_desc.idxCount, start, 0);
 	}
 	else
 	{
 		// _obt@݂̂ŕ`
-		pContext->Draw(count ? count : m_desc.vtxCount, 0);
+		pContext->Draw(count ? count : m_desc.vtxCount, start);
 	}
 
 }
 
+/*************************//*
+@brief		| bVobt@̃CX^X`
+@param[in]	| instanceNumFCX^X
+@param[in]	| countF`悷CfbNX(0w肵ꍇ̓obt@̐)
+@param[in]	| startF`JnCfbNẌʒu
+*//*************************/
+void MeshBuffer::DrawInstanced(UINT instanceNum, int count, int start)
+{
+	// CX^X`̓CfbNXobt@bV̂
+	if (m_desc.idxCount == 0) { return; }
+
+	ID3D11DeviceContext* pContext = GetContext();
+	UINT stride = m_desc.vtxSize;
+	UINT offset = 0;
+
+	pContext->IASetPrimitiveTopology(m_desc.topology);
+	pContext->IASetVertexBuffers(0, 1, &m_pVtxBuffer, &stride, &offset);
+	pContext->IASetIndexBuffer(m_pIdxBuffer, m_desc.idxSize == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, 0);
+	pContext->DrawIndexedInstanced(count ? count : m_desc.idxCount, instanceNum, start, 0, 0);
+}
+
 /*************************//*
 @brief		| _obt@̏
 @param[in]	| pVtxF_f[^
+@param[in]	| countFޒ_(0w肵ꍇ̓obt@̒_)
 @return		| HRESULT(݂ɎsꍇE_FAIL)
 *//*************************/
-HRESULT MeshBuffer::Write(void* pVtx)
+HRESULT MeshBuffer::Write(void* pVtx, UINT count)
 {
 	if (!m_desc.isWrite) { return E_FAIL; }
+	if (count > m_desc.vtxCount) { return E_FAIL; }
 
 	HRESULT hr;
 	ID3D11Device* pDevice = GetDevice();
@@ -113,7 +137,7 @@ HRESULT MeshBuffer::Write(void* pVtx)
 	hr = pContext->Map(m_pVtxBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapResource);
 	if (SUCCEEDED(hr))
 	{
-		rsize_t size = m_desc.vtxCount * m_desc.vtxSize;
+		rsize_t size = (count ? count : m_desc.vtxCount) * m_desc.vtxSize;
 		memcpy_s(mapResource.pData, size, pVtx, size);
 		pContext->Unmap(m_pVtxBuffer, 0);
 	}
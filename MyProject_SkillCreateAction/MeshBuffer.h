@@ -35,12 +35,21 @@ public:
 
 	// @brief bVobt@̕`
 	// @param[in] count `悷钸_(0w肵ꍇ̓obt@ɐݒ肳Ă钸_)
-	void Draw(int count = 0);
+	// @param[in] start `Jnʒu(CfbNXȂΒ_̈ʒu)
+	void Draw(int count = 0, int start = 0);
+
+	// @brief bVobt@̃CX^X`
+	// @param[in] instanceNum CX^X
+	// @param[in] count `悷CfbNX(0w肵ꍇ̓obt@ɐݒ肳ĂCfbNX)
+	// @param[in] start `JnCfbNẌʒu
+	// @note CX^Xf[^̒_obt@͌ĂяoŐݒ肷
+	void DrawInstanced(UINT instanceNum, int count = 0, int start = 0);
 
 	// @brief _obt@̏
 	// @param[in] pVtx _f[^
+	// @param[in] count ޒ_(0w肵ꍇ̓obt@ɐݒ肳Ă钸_)
 	// @return HRESULT(݂ɎsꍇE_FAIL)
-	HRESULT Write(void* pVtx);
+	HRESULT Write(void* pVtx, UINT count = 0);
 
 	// @brief obt@̎擾
 	// @return obt@
@@ -0,0 +1,478 @@
+/**************************************************//*
+	@file	| MeshOptimizer.cpp
+	@brief	| メッシュ最適化クラスのcppファイル
+	@note	| モデル読み込み時に頂点・インデックスを並び替え、
+			| GPUの頂点キャッシュ効率と描画負荷を改善する
+*//**************************************************/
+#include "MeshOptimizer.h"
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+namespace
+{
+	// Forsyth法で使用するキャッシュサイズ
+	const int ce_nForsythCacheSize = 32;
+
+	// Forsyth法のスコア計算用パラメータ
+	const float ce_fCacheDecayPower = 1.5f;
+	const float ce_fLastTriScore = 0.75f;
+	const float ce_fValenceBoostScale = 2.0f;
+	const float ce_fValenceBoostPower = 0.5f;
+
+	/****************************************//*
+		@brief　	| Forsyth法の頂点スコアを計算
+		@param　	| cachePos：キャッシュ内の位置(-1でキャッシュ外)
+		@param　	| remainingTris：まだ出力されていない隣接三角形の数
+		@return　	| 頂点スコア
+	*//****************************************/
+	float CalcVertexScore(int cachePos, unsigned int remainingTris)
+	{
+		// 全ての三角形を出力済みの頂点は選ばない
+		if (remainingTris == 0) return -1.0f;
+
+		float fScore = 0.0f;
+		if (cachePos >= 0)
+		{
+			if (cachePos < 3)
+			{
+				// 直前の三角形で使用した頂点は一定のスコア
+				fScore = ce_fLastTriScore;
+			}
+			else
+			{
+				// キャッシュの奥にある頂点ほどスコアを下げる
+				const float fScaler = 1.0f / (ce_nForsythCacheSize - 3);
+				fScore = std::pow(1.0f - (cachePos - 3) * fScaler, ce_fCacheDecayPower);
+			}
+		}
+
+		// 残りの三角形が少ない頂点を優先して使い切る
+		fScore += ce_fValenceBoostScale * std::pow(static_cast<float>(remainingTris), -ce_fValenceBoostPower);
+		return fScore;
+	}
+
+	/****************************************//*
+		@brief　	| 頂点データから座標を取得
+		@param　	| pVtx：頂点データ
+		@param　	| vtxSize：頂点1つあたりのサイズ
+		@param　	| index：頂点番号
+		@param　	| out：座標の格納先
+	*//****************************************/
+	void GetPosition(const void* pVtx, size_t vtxSize, size_t index, float out[3])
+	{
+		std::memcpy(out, static_cast<const unsigned char*>(pVtx) + index * vtxSize, sizeof(float) * 3);
+	}
+}
+
+/****************************************//*
+	@brief　	| 全ての最適化をまとめて実行
+	@param　	| pVtx：頂点データ(最適化後の頂点で先頭から上書きされる)
+	@param　	| vtxSize：頂点1つあたりのサイズ
+	@param　	| vtxCount：頂点数
+	@param　	| indices：インデックス(三角形リスト)
+	@param　	| pRemap：元の頂点番号から最適化後の頂点番号への対応表(不要ならnullptr)
+	@param　	| pStats：最適化結果の格納先(不要ならnullptr)
+	@return　	| 最適化後の頂点数
+*//****************************************/
+size_t MeshOptimizer::Optimize(void* pVtx, size_t vtxSize, size_t vtxCount, Indices& indices, Remap* pRemap, MeshOptimizeStats* pStats)
+{
+	MeshOptimizeStats tStats{};
+	tStats.m_nVtxCountBefore = vtxCount;
+	tStats.m_fACMRBefore = CalcACMR(indices, vtxCount);
+	tStats.m_nVtxBytesBefore = vtxCount * vtxSize;
+	tStats.m_nIdxBytesBefore = indices.size() * sizeof(unsigned long);
+
+	// 重複頂点をまとめる
+	Remap dedupRemap;
+	size_t nCount = Deduplicate(pVtx, vtxSize, vtxCount, indices, dedupRemap);
+
+	// 三角形の並び替え
+	OptimizeVertexCache(indices, nCount);
+	OptimizeOverdraw(indices, pVtx, vtxSize, nCount);
+
+	// 頂点の並び替え
+	Remap fetchRemap;
+	nCount = OptimizeVertexFetch(pVtx, vtxSize, nCount, indices, fetchRemap);
+
+	// 元の頂点番号からの対応表を合成
+	if (pRemap)
+	{
+		pRemap->resize(vtxCount);
+		for (size_t i = 0; i < vtxCount; ++i)
+		{
+			unsigned int nDedup = dedupRemap[i];
+			(*pRemap)[i] = nDedup == REMAP_NONE ? REMAP_NONE : fetchRemap[nDedup];
+		}
+	}
+
+	tStats.m_nVtxCountAfter = nCount;
+	tStats.m_fACMRAfter = CalcACMR(indices, nCount);
+	tStats.m_nVtxBytesAfter = nCount * vtxSize;
+	tStats.m_nIdxBytesAfter = indices.size() * (CanUseIndex16(nCount) ? sizeof(unsigned short) : sizeof(unsigned long));
+	if (pStats) *pStats = tStats;
+
+	return nCount;
+}
+
+/****************************************//*
+	@brief　	| 同一の頂点をまとめる
+	@param　	| pVtx：頂点データ(重複を除いた頂点で先頭から上書きされる)
+	@param　	| vtxSize：頂点1つあたりのサイズ
+	@param　	| vtxCount：頂点数
+	@param　	| indices：インデックス(まとめた頂点番号に書き換えられる)
+	@param　	| outRemap：元の頂点番号からまとめた後の頂点番号への対応表
+	@return　	| 重複を除いた頂点数
+*//****************************************/
+size_t MeshOptimizer::Deduplicate(void* pVtx, size_t vtxSize, size_t vtxCount, Indices& indices, Remap& outRemap)
+{
+	unsigned char* pData = static_cast<unsigned char*>(pVtx);
+	outRemap.assign(vtxCount, REMAP_NONE);
+
+	// 頂点のバイト列のハッシュ値から同一頂点を探す
+	std::unordered_multimap<size_t, unsigned int> hashMap;
+	hashMap.reserve(vtxCount);
+
+	size_t nUnique = 0;
+	for (size_t i = 0; i < vtxCount; ++i)
+	{
+		const unsigned char* pSrc = pData + i * vtxSize;
+
+		// FNV-1a
+		size_t nHash = 14695981039346656037ull;
+		for (size_t b = 0; b < vtxSize; ++b)
+		{
+			nHash ^= pSrc[b];
+			nHash *= 1099511628211ull;
+		}
+
+		// 既に同じ頂点があればそちらを使う
+		unsigned int nFound = REMAP_NONE;
+		auto range = hashMap.equal_range(nHash);
+		for (auto itr = range.first; itr != range.second; ++itr)
+		{
+			if (std::memcmp(pData + itr->second * vtxSize, pSrc, vtxSize) == 0)
+			{
+				nFound = itr->second;
+				break;
+			}
+		}
+
+		if (nFound == REMAP_NONE)
+		{
+			// 新しい頂点として前詰めで保存する
+			nFound = static_cast<unsigned int>(nUnique++);
+			if (nFound != i) std::memmove(pData + nFound * vtxSize, pSrc, vtxSize);
+			hashMap.emplace(nHash, nFound);
+		}
+		outRemap[i] = nFound;
+	}
+
+	// インデックスを書き換える
+	for (auto& index : indices)
+	{
+		index = outRemap[index];
+	}
+
+	return nUnique;
+}
+
+/****************************************//*
+	@brief　	| 頂点キャッシュの効率が良くなるように三角形を並び替える(Forsyth法)
+	@param　	| indices：インデックス(三角形リスト)
+	@param　	| vtxCount：頂点数
+*//****************************************/
+void MeshOptimizer::OptimizeVertexCache(Indices& indices, size_t vtxCount)
+{
+	const size_t nTriCount = indices.size() / 3;
+	if (nTriCount == 0) return;
+
+	// 頂点毎の隣接三角形リストを作成
+	std::vector<unsigned int> triOffset(vtxCount + 1, 0);
+	for (size_t i = 0; i < nTriCount * 3; ++i) triOffset[indices[i] + 1]++;
+	for (size_t i = 0; i < vtxCount; ++i) triOffset[i + 1] += triOffset[i];
+
+	std::vector<unsigned int> adjacency(nTriCount * 3);
+	std::vector<unsigned int> remaining(vtxCount, 0);
+	for (size_t t = 0; t < nTriCount; ++t)
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			unsigned long v = indices[t * 3 + k];
+			adjacency[triOffset[v] + remaining[v]++] = static_cast<unsigned int>(t);
+		}
+	}
+
+	// 頂点と三角形のスコアを初期化
+	std::vector<int> cachePos(vtxCount, -1);
+	std::vector<float> vtxScore(vtxCount);
+	for (size_t v = 0; v < vtxCount; ++v) vtxScore[v] = CalcVertexScore(-1, remaining[v]);
+
+	std::vector<float> triScore(nTriCount);
+	std::vector<bool> triEmitted(nTriCount, false);
+	for (size_t t = 0; t < nTriCount; ++t)
+	{
+		triScore[t] = vtxScore[indices[t * 3]] + vtxScore[indices[t * 3 + 1]] + vtxScore[indices[t * 3 + 2]];
+	}
+
+	Indices result;
+	result.reserve(indices.size());
+
+	std::vector<unsigned int> cache, newCache;
+	cache.reserve(ce_nForsythCacheSize + 3);
+	newCache.reserve(ce_nForsythCacheSize + 3);
+
+	size_t nScanPos = 0;
+	unsigned int nBestTri = 0;
+	for (size_t t = 1; t < nTriCount; ++t)
+	{
+		if (triScore[t] > triScore[nBestTri]) nBestTri = static_cast<unsigned int>(t);
+	}
+
+	for (size_t nEmitted = 0; nEmitted < nTriCount; ++nEmitted)
+	{
+		// 候補が無ければ未出力の三角形から順に選ぶ
+		if (nBestTri == REMAP_NONE)
+		{
+			while (triEmitted[nScanPos]) ++nScanPos;
+			nBestTri = static_cast<unsigned int>(nScanPos);
+		}
+
+		// 三角形を出力
+		triEmitted[nBestTri] = true;
+		const unsigned long* pTri = &indices[nBestTri * 3];
+		result.insert(result.end(), pTri, pTri + 3);
+
+		// 出力した三角形を頂点の隣接リストから取り除く
+		for (int k = 0; k < 3; ++k)
+		{
+			unsigned long v = pTri[k];
+			unsigned int* pBegin = &adjacency[triOffset[v]];
+			unsigned int* pEnd = pBegin + remaining[v];
+			unsigned int* pFound = std::find(pBegin, pEnd, nBestTri);
+			*pFound = *(pEnd - 1);
+			remaining[v]--;
+		}
+
+		// キャッシュを更新(使用した頂点を先頭へ)
+		newCache.clear();
+		newCache.insert(newCache.end(), pTri, pTri + 3);
+		for (unsigned int v : cache)
+		{
+			if (v != pTri[0] && v != pTri[1] && v != pTri[2]) newCache.push_back(v);
+		}
+		std::swap(cache, newCache);
+
+		// キャッシュ内の頂点スコアと隣接三角形のスコアを更新
+		nBestTri = REMAP_NONE;
+		float fBestScore = -1.0f;
+		for (size_t i = 0; i < cache.size(); ++i)
+		{
+			unsigned int v = cache[i];
+			int nPos = i < static_cast<size_t>(ce_nForsythCacheSize) ? static_cast<int>(i) : -1;
+			cachePos[v] = nPos;
+
+			float fNewScore = CalcVertexScore(nPos, remaining[v]);
+			float fDiff = fNewScore - vtxScore[v];
+			vtxScore[v] = fNewScore;
+
+			for (unsigned int a = 0; a < remaining[v]; ++a)
+			{
+				unsigned int tri = adjacency[triOffset[v] + a];
+				triScore[tri] += fDiff;
+				if (triScore[tri] > fBestScore)
+				{
+					fBestScore = triScore[tri];
+					nBestTri = tri;
+				}
+			}
+		}
+
+		// キャッシュから溢れた頂点を取り除く
+		if (cache.size() > static_cast<size_t>(ce_nForsythCacheSize)) cache.resize(ce_nForsythCacheSize);
+	}
+
+	indices.swap(result);
+}
+
+/****************************************//*
+	@brief　	| 外側を向いた面から描画されるように三角形のまとまりを並び替える
+	@param　	| indices：頂点キャッシュ最適化済みのインデックス
+	@param　	| pVtx：頂点データ
+	@param　	| vtxSize：頂点1つあたりのサイズ
+	@param　	| vtxCount：頂点数
+	@param　	| threshold：許容するACMRの悪化率(1.05なら5%まで)
+	@note		| 頂点キャッシュが全て外れる位置でまとまりを区切り、
+				| メッシュの中心から見て外側を向いているまとまりほど先に描画する
+*//****************************************/
+void MeshOptimizer::OptimizeOverdraw(Indices& indices, const void* pVtx, size_t vtxSize, size_t vtxCount, float threshold)
+{
+	const size_t nTriCount = indices.size() / 3;
+	if (nTriCount < 2) return;
+
+	// キャッシュが全て外れる三角形でまとまりを区切る
+	std::vector<size_t> clusterStart;
+	{
+		std::vector<unsigned int> timestamp(vtxCount, 0);
+		unsigned int nTime = static_cast<unsigned int>(SIMULATE_CACHE_SIZE) + 1;
+		for (size_t t = 0; t < nTriCount; ++t)
+		{
+			int nMiss = 0;
+			for (int k = 0; k < 3; ++k)
+			{
+				unsigned long v = indices[t * 3 + k];
+				if (nTime - timestamp[v] > SIMULATE_CACHE_SIZE)
+				{
+					timestamp[v] = nTime++;
+					nMiss++;
+				}
+			}
+			if (t == 0 || nMiss == 3) clusterStart.push_back(t);
+		}
+	}
+	if (clusterStart.size() < 2) return;
+	clusterStart.push_back(nTriCount);
+
+	// メッシュ全体の中心を求める
+	float f3Center[3] = {};
+	for (size_t v = 0; v < vtxCount; ++v)
+	{
+		float pos[3];
+		GetPosition(pVtx, vtxSize, v, pos);
+		for (int k = 0; k < 3; ++k) f3Center[k] += pos[k];
+	}
+	for (int k = 0; k < 3; ++k) f3Center[k] /= static_cast<float>(vtxCount);
+
+	// まとまり毎に中心と向きから並び替えの値を計算する
+	const size_t nClusterCount = clusterStart.size() - 1;
+	std::vector<float> sortKey(nClusterCount);
+	for (size_t c = 0; c < nClusterCount; ++c)
+	{
+		float f3Centroid[3] = {};
+		float f3Normal[3] = {};
+		float fAreaSum = 0.0f;
+		for (size_t t = clusterStart[c]; t < clusterStart[c + 1]; ++t)
+		{
+			float p0[3], p1[3], p2[3];
+			GetPosition(pVtx, vtxSize, indices[t * 3 + 0], p0);
+			GetPosition(pVtx, vtxSize, indices[t * 3 + 1], p1);
+			GetPosition(pVtx, vtxSize, indices[t * 3 + 2], p2);
+
+			float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			float n[3] = {
+				e1[1] * e2[2] - e1[2] * e2[1],
+				e1[2] * e2[0] - e1[0] * e2[2],
+				e1[0] * e2[1] - e1[1] * e2[0],
+			};
+			float fArea = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+			for (int k = 0; k < 3; ++k)
+			{
+				f3Centroid[k] += (p0[k] + p1[k] + p2[k]) / 3.0f * fArea;
+				f3Normal[k] += n[k];
+			}
+			fAreaSum += fArea;
+		}
+
+		if (fAreaSum > 0.0f)
+		{
+			for (int k = 0; k < 3; ++k) f3Centroid[k] /= fAreaSum;
+		}
+		float fLen = std::sqrt(f3Normal[0] * f3Normal[0] + f3Normal[1] * f3Normal[1] + f3Normal[2] * f3Normal[2]);
+		if (fLen > 0.0f)
+		{
+			for (int k = 0; k < 3; ++k) f3Normal[k] /= fLen;
+		}
+
+		sortKey[c] =
+			(f3Centroid[0] - f3Center[0]) * f3Normal[0] +
+			(f3Centroid[1] - f3Center[1]) * f3Normal[1] +
+			(f3Centroid[2] - f3Center[2]) * f3Normal[2];
+	}
+
+	// 外側を向いているまとまりほど先に描画する
+	std::vector<size_t> order(nClusterCount);
+	for (size_t c = 0; c < nClusterCount; ++c) order[c] = c;
+	std::stable_sort(order.begin(), order.end(), [&sortKey](size_t a, size_t b)
+		{
+			return sortKey[a] > sortKey[b];
+		});
+
+	Indices result;
+	result.reserve(indices.size());
+	for (size_t c : order)
+	{
+		result.insert(result.end(), indices.begin() + clusterStart[c] * 3, indices.begin() + clusterStart[c + 1] * 3);
+	}
+
+	// 頂点キャッシュの効率が大きく落ちる場合は採用しない
+	if (CalcACMR(result, vtxCount) <= CalcACMR(indices, vtxCount) * threshold)
+	{
+		indices.swap(result);
+	}
+}
+
+/****************************************//*
+	@brief　	| インデックスから参照される順に頂点を並び替える
+	@param　	| pVtx：頂点データ(並び替え後の頂点で先頭から上書きされる)
+	@param　	| vtxSize：頂点1つあたりのサイズ
+	@param　	| vtxCount：頂点数
+	@param　	| indices：インデックス(並び替え後の頂点番号に書き換えられる)
+	@param　	| outRemap：元の頂点番号から並び替え後の頂点番号への対応表
+	@return　	| 参照されている頂点数
+*//****************************************/
+size_t MeshOptimizer::OptimizeVertexFetch(void* pVtx, size_t vtxSize, size_t vtxCount, Indices& indices, Remap& outRemap)
+{
+	outRemap.assign(vtxCount, REMAP_NONE);
+
+	// 初めて参照された順に番号を振り直す
+	unsigned int nNext = 0;
+	for (auto& index : indices)
+	{
+		unsigned int& nRemap = outRemap[index];
+		if (nRemap == REMAP_NONE) nRemap = nNext++;
+		index = nRemap;
+	}
+
+	// 新しい番号の位置に頂点を移す
+	unsigned char* pData = static_cast<unsigned char*>(pVtx);
+	std::vector<unsigned char> copy(pData, pData + vtxCount * vtxSize);
+	for (size_t i = 0; i < vtxCount; ++i)
+	{
+		if (outRemap[i] == REMAP_NONE) continue;
+		std::memcpy(pData + outRemap[i] * vtxSize, copy.data() + i * vtxSize, vtxSize);
+	}
+
+	return nNext;
+}
+
+/****************************************//*
+	@brief　	| ACMR(1三角形あたりの頂点キャッシュミス数)を計算する
+	@param　	| indices：インデックス(三角形リスト)
+	@param　	| vtxCount：頂点数
+	@param　	| cacheSize：FIFOキャッシュのサイズ
+	@return　	| ACMR(最良0.5～最悪3.0)
+*//****************************************/
+float MeshOptimizer::CalcACMR(const Indices& indices, size_t vtxCount, size_t cacheSize)
+{
+	const size_t nTriCount = indices.size() / 3;
+	if (nTriCount == 0) return 0.0f;
+
+	// FIFOキャッシュを時刻で再現する
+	std::vector<size_t> timestamp(vtxCount, 0);
+	size_t nTime = cacheSize + 1;
+	size_t nMiss = 0;
+	for (size_t i = 0; i < nTriCount * 3; ++i)
+	{
+		unsigned long v = indices[i];
+		if (nTime - timestamp[v] > cacheSize)
+		{
+			timestamp[v] = nTime++;
+			nMiss++;
+		}
+	}
+
+	return static_cast<float>(nMiss) / static_cast<float>(nTriCount);
+}
@@ -0,0 +1,109 @@
+/**************************************************//*
+	@file	| MeshOptimizer.h
+	@brief	| メッシュ最適化クラスのhファイル
+	@note	| モデル読み込み時に頂点・インデックスを並び替え、
+			| GPUの頂点キャッシュ効率と描画負荷を改善する
+*//**************************************************/
+#pragma once
+#include <vector>
+#include <cstddef>
+
+// @brief メッシュ最適化の結果
+struct MeshOptimizeStats
+{
+	// 最適化前の頂点数
+	size_t m_nVtxCountBefore;
+
+	// 最適化後の頂点数
+	size_t m_nVtxCountAfter;
+
+	// 最適化前のACMR(1三角形あたりの頂点キャッシュミス数)
+	float m_fACMRBefore;
+
+	// 最適化後のACMR
+	float m_fACMRAfter;
+
+	// 最適化前の頂点バッファサイズ(バイト)
+	size_t m_nVtxBytesBefore;
+
+	// 最適化後の頂点バッファサイズ(バイト)
+	size_t m_nVtxBytesAfter;
+
+	// 最適化前のインデックスバッファサイズ(バイト)
+	size_t m_nIdxBytesBefore;
+
+	// 最適化後のインデックスバッファサイズ(バイト)
+	size_t m_nIdxBytesAfter;
+};
+
+// @brief メッシュ最適化クラス
+// @note 頂点データは先頭にfloat3の座標を持つことを前提とする
+class MeshOptimizer
+{
+public:
+	using Indices = std::vector<unsigned long>;
+	using Remap = std::vector<unsigned int>;
+
+	// @brief 対応する頂点が無いことを表すリマップ値
+	static constexpr unsigned int REMAP_NONE = ~0u;
+
+	// @brief 16bitインデックスで扱える最大頂点数
+	static constexpr size_t MAX_INDEX16_VTX = 0xffff;
+
+	// @brief ACMR計測に使うFIFOキャッシュのサイズ
+	static constexpr size_t SIMULATE_CACHE_SIZE = 16;
+
+public:
+	// @brief 全ての最適化をまとめて実行
+	// @param pVtx：頂点データ(最適化後の頂点で先頭から上書きされる)
+	// @param vtxSize：頂点1つあたりのサイズ
+	// @param vtxCount：頂点数
+	// @param indices：インデックス(三角形リスト)
+	// @param pRemap：元の頂点番号から最適化後の頂点番号への対応表(不要ならnullptr)
+	// @param pStats：最適化結果の格納先(不要ならnullptr)
+	// @return 最適化後の頂点数
+	static size_t Optimize(void* pVtx, size_t vtxSize, size_t vtxCount, Indices& indices, Remap* pRemap = nullptr, MeshOptimizeStats* pStats = nullptr);
+
+	// @brief 同一の頂点をまとめる
+	// @param pVtx：頂点データ(重複を除いた頂点で先頭から上書きされる)
+	// @param vtxSize：頂点1つあたりのサイズ
+	// @param vtxCount：頂点数
+	// @param indices：インデックス(まとめた頂点番号に書き換えられる)
+	// @param outRemap：元の頂点番号からまとめた後の頂点番号への対応表
+	// @return 重複を除いた頂点数
+	static size_t Deduplicate(void* pVtx, size_t vtxSize, size_t vtxCount, Indices& indices, Remap& outRemap);
+
+	// @brief 頂点キャッシュの効率が良くなるように三角形を並び替える(Forsyth法)
+	// @param indices：インデックス(三角形リスト)
+	// @param vtxCount：頂点数
+	static void OptimizeVertexCache(Indices& indices, size_t vtxCount);
+
+	// @brief 外側を向いた面から描画されるように三角形のまとまりを並び替える
+	// @param indices：頂点キャッシュ最適化済みのインデックス
+	// @param pVtx：頂点データ
+	// @param vtxSize：頂点1つあたりのサイズ
+	// @param vtxCount：頂点数
+	// @param threshold：許容するACMRの悪化率(1.05なら5%まで)
+	static void OptimizeOverdraw(Indices& indices, const void* pVtx, size_t vtxSize, size_t vtxCount, float threshold = 1.05f);
+
+	// @brief インデックスから参照される順に頂点を並び替える
+	// @param pVtx：頂点データ(並び替え後の頂点で先頭から上書きされる)
+	// @param vtxSize：頂点1つあたりのサイズ
+	// @param vtxCount：頂点数
+	// @param indices：インデックス(並び替え後の頂点番号に書き換えられる)
+	// @param outRemap：元の頂点番号から並び替え後の頂点番号への対応表
+	// @return 参照されている頂点数
+	static size_t OptimizeVertexFetch(void* pVtx, size_t vtxSize, size_t vtxCount, Indices& indices, Remap& outRemap);
+
+	// @brief ACMR(1三角形あたりの頂点キャッシュミス数)を計算する
+	// @param indices：インデックス(三角形リスト)
+	// @param vtxCount：頂点数
+	// @param cacheSize：FIFOキャッシュのサイズ
+	// @return ACMR(最良0.5～最悪3.0)
+	static float CalcACMR(const Indices& indices, size_t vtxCount, size_t cacheSize = SIMULATE_CACHE_SIZE);
+
+	// @brief 16bitインデックスで扱えるかどうか
+	// @param vtxCount：頂点数
+	// @return true:16bitで扱える false:32bitが必要
+	static bool CanUseIndex16(size_t vtxCount) { return vtxCount <= MAX_INDEX16_VTX; }
+};
@@ -0,0 +1,381 @@
+/**************************************************//*
+	@file	| MeshSimplifier.cpp
+	@brief	| メッシュ簡略化クラスのcppファイル
+	@note	| 二次誤差(QEM)による辺の縮約でLOD用のインデックスを作成する
+			| 頂点バッファは元のメッシュと共有し、インデックスだけを減らす
+*//**************************************************/
+#include "MeshSimplifier.h"
+#include <unordered_map>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+
+namespace
+{
+	// 縮約で面の向きがこれ以上変わる場合は縮約しない(法線の内積)
+	const float ce_fFlipThreshold = 0.25f;
+
+	// 1回の走査で縮約できる辺が無くなった時に諦めるまでの最大走査回数
+	const int ce_nMaxPass = 100;
+
+	// @brief 二次誤差行列(対称行列なので10要素と重み)
+	struct Quadric
+	{
+		float a00, a11, a22;
+		float a10, a20, a21;
+		float b0, b1, b2;
+		float c;
+		float w;
+	};
+
+	// @brief 縮約の候補
+	struct Collapse
+	{
+		unsigned int v0;	// 消す頂点
+		unsigned int v1;	// 移動先の頂点
+		float cost;			// 縮約後の誤差
+	};
+
+	/****************************************//*
+		@brief　	| 頂点データから座標を取得
+		@param　	| pVtx：頂点データ
+		@param　	| vtxSize：頂点1つあたりのサイズ
+		@param　	| index：頂点番号
+		@param　	| out：座標の格納先
+	*//****************************************/
+	void GetPosition(const void* pVtx, size_t vtxSize, size_t index, float out[3])
+	{
+		std::memcpy(out, static_cast<const unsigned char*>(pVtx) + index * vtxSize, sizeof(float) * 3);
+	}
+
+	/****************************************//*
+		@brief　	| 三角形の法線(正規化しない)を計算
+		@param　	| p0,p1,p2：三角形の頂点座標
+		@param　	| out：法線の格納先
+	*//****************************************/
+	void CalcNormal(const float p0[3], const float p1[3], const float p2[3], float out[3])
+	{
+		float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+		float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+		out[0] = e1[1] * e2[2] - e1[2] * e2[1];
+		out[1] = e1[2] * e2[0] - e1[0] * e2[2];
+		out[2] = e1[0] * e2[1] - e1[1] * e2[0];
+	}
+
+	/****************************************//*
+		@brief　	| 三角形の平面から二次誤差行列を作成
+		@param　	| p0,p1,p2：三角形の頂点座標
+		@return　	| 面積で重み付けした二次誤差行列
+	*//****************************************/
+	Quadric MakePlaneQuadric(const float p0[3], const float p1[3], const float p2[3])
+	{
+		Quadric q = {};
+		float n[3];
+		CalcNormal(p0, p1, p2, n);
+		float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (len <= 0.0f) return q;
+
+		// 面積(外積の長さの半分)で重み付けする
+		float area = len * 0.5f;
+		n[0] /= len; n[1] /= len; n[2] /= len;
+		float d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+
+		q.a00 = n[0] * n[0] * area;
+		q.a11 = n[1] * n[1] * area;
+		q.a22 = n[2] * n[2] * area;
+		q.a10 = n[1] * n[0] * area;
+		q.a20 = n[2] * n[0] * area;
+		q.a21 = n[2] * n[1] * area;
+		q.b0 = n[0] * d * area;
+		q.b1 = n[1] * d * area;
+		q.b2 = n[2] * d * area;
+		q.c = d * d * area;
+		q.w = area;
+		return q;
+	}
+
+	/****************************************//*
+		@brief　	| 二次誤差行列を加算
+		@param　	| dst：加算先
+		@param　	| src：加算する行列
+	*//****************************************/
+	void AddQuadric(Quadric& dst, const Quadric& src)
+	{
+		dst.a00 += src.a00; dst.a11 += src.a11; dst.a22 += src.a22;
+		dst.a10 += src.a10; dst.a20 += src.a20; dst.a21 += src.a21;
+		dst.b0 += src.b0; dst.b1 += src.b1; dst.b2 += src.b2;
+		dst.c += src.c;
+		dst.w += src.w;
+	}
+
+	/****************************************//*
+		@brief　	| 座標での二次誤差を計算
+		@param　	| q：二次誤差行列
+		@param　	| p：座標
+		@return　	| 平面からの距離の二乗の重み付き平均
+	*//****************************************/
+	float EvalQuadric(const Quadric& q, const float p[3])
+	{
+		float x = p[0], y = p[1], z = p[2];
+		float r =
+			q.a00 * x * x + q.a11 * y * y + q.a22 * z * z +
+			2.0f * (q.a10 * x * y + q.a20 * x * z + q.a21 * y * z) +
+			2.0f * (q.b0 * x + q.b1 * y + q.b2 * z) +
+			q.c;
+		return q.w > 0.0f ? std::fabs(r) / q.w : 0.0f;
+	}
+
+	/****************************************//*
+		@brief　	| 辺をキーに変換する
+		@param　	| a,b：辺の両端の頂点番号
+		@return　	| 向きに依存しないキー
+	*//****************************************/
+	uint64_t MakeEdgeKey(unsigned int a, unsigned int b)
+	{
+		if (a > b) std::swap(a, b);
+		return (static_cast<uint64_t>(a) << 32) | b;
+	}
+}
+
+/****************************************//*
+	@brief　	| 二次誤差が小さい辺から順に縮約してインデックスを減らす
+	@param　	| pVtx：頂点データ
+	@param　	| vtxSize：頂点1つあたりのサイズ
+	@param　	| vtxCount：頂点数
+	@param　	| indices：簡略化するインデックス(三角形リスト)
+	@param　	| out：簡略化したインデックスの格納先
+	@param　	| targetIndexCount：目標のインデックス数
+	@param　	| targetError：許容する誤差(メッシュの大きさに対する割合)
+	@param　	| pResultError：実際の誤差の格納先(メッシュの大きさに対する割合、不要ならnullptr)
+	@return　	| 簡略化後のインデックス数
+*//****************************************/
+size_t MeshSimplifier::Simplify(const void* pVtx, size_t vtxSize, size_t vtxCount, const Indices& indices, Indices& out,
+	size_t targetIndexCount, float targetError, float* pResultError)
+{
+	out = indices;
+	if (pResultError) *pResultError = 0.0f;
+	if (out.size() <= targetIndexCount || vtxCount == 0) return out.size();
+
+	// 座標の取得
+	std::vector<float> position(vtxCount * 3);
+	for (size_t i = 0; i < vtxCount; ++i)
+	{
+		GetPosition(pVtx, vtxSize, i, &position[i * 3]);
+	}
+
+	// 同じ座標の頂点を1つの頂点として扱う(UVの継ぎ目などで分かれている頂点)
+	std::vector<unsigned int> weld(vtxCount);
+	std::vector<unsigned int> weldCount(vtxCount, 0);
+	{
+		std::unordered_map<std::string, unsigned int> posMap;
+		posMap.reserve(vtxCount);
+		for (size_t i = 0; i < vtxCount; ++i)
+		{
+			std::string key(reinterpret_cast<const char*>(&position[i * 3]), sizeof(float) * 3);
+			auto result = posMap.emplace(key, static_cast<unsigned int>(i));
+			weld[i] = result.first->second;
+			weldCount[weld[i]]++;
+		}
+	}
+
+	// 開いた辺・3枚以上の面が接する辺を探す
+	std::vector<bool> isLocked(vtxCount, false);
+	{
+		std::unordered_map<uint64_t, unsigned int> edgeCount;
+		edgeCount.reserve(out.size());
+		for (size_t i = 0; i < out.size(); i += 3)
+		{
+			for (int e = 0; e < 3; ++e)
+			{
+				unsigned int a = weld[out[i + e]];
+				unsigned int b = weld[out[i + (e + 1) % 3]];
+				if (a != b) edgeCount[MakeEdgeKey(a, b)]++;
+			}
+		}
+		for (const auto& itr : edgeCount)
+		{
+			if (itr.second == 2) continue;
+			isLocked[static_cast<unsigned int>(itr.first >> 32)] = true;
+			isLocked[static_cast<unsigned int>(itr.first & 0xffffffff)] = true;
+		}
+	}
+
+	// 継ぎ目・境界の頂点は動かさない
+	for (size_t i = 0; i < vtxCount; ++i)
+	{
+		if (weldCount[weld[i]] > 1 || isLocked[weld[i]]) isLocked[i] = true;
+	}
+
+	// 各頂点に接する面の二次誤差行列を集める(同じ座標の頂点はまとめる)
+	std::vector<Quadric> quadric(vtxCount, Quadric{});
+	for (size_t i = 0; i < out.size(); i += 3)
+	{
+		Quadric q = MakePlaneQuadric(&position[out[i] * 3], &position[out[i + 1] * 3], &position[out[i + 2] * 3]);
+		for (int e = 0; e < 3; ++e)
+		{
+			AddQuadric(quadric[weld[out[i + e]]], q);
+		}
+	}
+
+	// 誤差の上限(二乗)
+	float meshScale = CalcMeshScale(pVtx, vtxSize, vtxCount);
+	float errorLimit = targetError * meshScale;
+	errorLimit *= errorLimit;
+	float resultError = 0.0f;
+
+	std::vector<unsigned int> collapseRemap(vtxCount);
+	std::vector<bool> isTouched(vtxCount);
+	std::vector<unsigned int> adjOffset(vtxCount + 1);
+	std::vector<unsigned int> adjTriangle;
+	std::vector<Collapse> candidate;
+
+	for (int pass = 0; pass < ce_nMaxPass && out.size() > targetIndexCount; ++pass)
+	{
+		// 頂点に接する三角形の一覧を作成
+		std::fill(adjOffset.begin(), adjOffset.end(), 0);
+		for (unsigned long idx : out) adjOffset[idx + 1]++;
+		for (size_t i = 0; i < vtxCount; ++i) adjOffset[i + 1] += adjOffset[i];
+		adjTriangle.resize(out.size());
+		{
+			std::vector<unsigned int> fill(adjOffset.begin(), adjOffset.end() - 1);
+			for (size_t i = 0; i < out.size(); ++i)
+			{
+				adjTriangle[fill[out[i]]++] = static_cast<unsigned int>(i / 3);
+			}
+		}
+
+		// 頂点毎に最も誤差の小さい縮約先を選ぶ
+		candidate.clear();
+		std::vector<Collapse> best(vtxCount, Collapse{ 0, 0, -1.0f });
+		for (size_t i = 0; i < out.size(); i += 3)
+		{
+			for (int e = 0; e < 3; ++e)
+			{
+				for (int dir = 0; dir < 2; ++dir)
+				{
+					unsigned int v0 = out[i + (dir == 0 ? e : (e + 1) % 3)];
+					unsigned int v1 = out[i + (dir == 0 ? (e + 1) % 3 : e)];
+					if (isLocked[v0] || weld[v0] == weld[v1]) continue;
+
+					Quadric q = quadric[weld[v0]];
+					AddQuadric(q, quadric[weld[v1]]);
+					float cost = EvalQuadric(q, &position[v1 * 3]);
+					if (best[v0].cost < 0.0f || cost < best[v0].cost)
+					{
+						best[v0] = { v0, v1, cost };
+					}
+				}
+			}
+		}
+		for (const Collapse& c : best)
+		{
+			if (c.cost >= 0.0f && c.cost <= errorLimit) candidate.push_back(c);
+		}
+		if (candidate.empty()) break;
+
+		// 誤差の小さい順に縮約する
+		std::sort(candidate.begin(), candidate.end(), [](const Collapse& a, const Collapse& b)
+			{
+				return a.cost < b.cost;
+			});
+
+		for (size_t i = 0; i < vtxCount; ++i) collapseRemap[i] = static_cast<unsigned int>(i);
+		std::fill(isTouched.begin(), isTouched.end(), false);
+
+		size_t removeTarget = (out.size() - targetIndexCount) / 3;
+		size_t removed = 0;
+		for (const Collapse& c : candidate)
+		{
+			if (removed >= removeTarget) break;
+			if (isTouched[weld[c.v0]] || isTouched[weld[c.v1]]) continue;
+
+			// 縮約で裏返る三角形が無いか確認
+			bool isFlip = false;
+			size_t removeNum = 0;
+			for (unsigned int t = adjOffset[c.v0]; t < adjOffset[c.v0 + 1] && !isFlip; ++t)
+			{
+				size_t tri = adjTriangle[t] * 3;
+				unsigned int v[3] = { static_cast<unsigned int>(out[tri]), static_cast<unsigned int>(out[tri + 1]), static_cast<unsigned int>(out[tri + 2]) };
+				if (v[0] == c.v1 || v[1] == c.v1 || v[2] == c.v1)
+				{
+					// 縮約する辺を含む三角形は消える
+					removeNum++;
+					continue;
+				}
+
+				float before[3], after[3];
+				CalcNormal(&position[v[0] * 3], &position[v[1] * 3], &position[v[2] * 3], before);
+				for (int k = 0; k < 3; ++k) if (v[k] == c.v0) v[k] = c.v1;
+				CalcNormal(&position[v[0] * 3], &position[v[1] * 3], &position[v[2] * 3], after);
+
+				float dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+				float lenSq = (before[0] * before[0] + before[1] * before[1] + before[2] * before[2]) *
+					(after[0] * after[0] + after[1] * after[1] + after[2] * after[2]);
+				isFlip = dot <= 0.0f || dot * dot < ce_fFlipThreshold * ce_fFlipThreshold * lenSq;
+			}
+			if (isFlip) continue;
+
+			// 縮約の実行(周囲の三角形が変形するので、この走査では周囲の頂点を触らない)
+			collapseRemap[c.v0] = c.v1;
+			AddQuadric(quadric[weld[c.v1]], quadric[weld[c.v0]]);
+			for (unsigned int t = adjOffset[c.v0]; t < adjOffset[c.v0 + 1]; ++t)
+			{
+				size_t tri = adjTriangle[t] * 3;
+				for (int k = 0; k < 3; ++k) isTouched[weld[out[tri + k]]] = true;
+			}
+			resultError = std::max(resultError, c.cost);
+			removed += removeNum;
+		}
+		if (removed == 0) break;
+
+		// 縮約結果でインデックスを書き換え、潰れた三角形を消す
+		size_t write = 0;
+		for (size_t i = 0; i < out.size(); i += 3)
+		{
+			unsigned int a = collapseRemap[out[i]];
+			unsigned int b = collapseRemap[out[i + 1]];
+			unsigned int c = collapseRemap[out[i + 2]];
+			if (a == b || b == c || c == a) continue;
+			out[write++] = a;
+			out[write++] = b;
+			out[write++] = c;
+		}
+		out.resize(write);
+	}
+
+	if (pResultError && meshScale > 0.0f)
+	{
+		*pResultError = std::sqrt(resultError) / meshScale;
+	}
+	return out.size();
+}
+
+/****************************************//*
+	@brief　	| メッシュの大きさ(AABBの最大辺の長さ)を計算する
+	@param　	| pVtx：頂点データ
+	@param　	| vtxSize：頂点1つあたりのサイズ
+	@param　	| vtxCount：頂点数
+	@return　	| メッシュの大きさ
+*//****************************************/
+float MeshSimplifier::CalcMeshScale(const void* pVtx, size_t vtxSize, size_t vtxCount)
+{
+	if (vtxCount == 0) return 0.0f;
+
+	float minPos[3], maxPos[3];
+	GetPosition(pVtx, vtxSize, 0, minPos);
+	std::memcpy(maxPos, minPos, sizeof(minPos));
+	for (size_t i = 1; i < vtxCount; ++i)
+	{
+		float pos[3];
+		GetPosition(pVtx, vtxSize, i, pos);
+		for (int k = 0; k < 3; ++k)
+		{
+			minPos[k] = std::min(minPos[k], pos[k]);
+			maxPos[k] = std::max(maxPos[k], pos[k]);
+		}
+	}
+
+	return std::max(maxPos[0] - minPos[0], std::max(maxPos[1] - minPos[1], maxPos[2] - minPos[2]));
+}
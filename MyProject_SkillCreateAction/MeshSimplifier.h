@@ -0,0 +1,38 @@
+/**************************************************//*
+	@file	| MeshSimplifier.h
+	@brief	| メッシュ簡略化クラスのhファイル
+	@note	| 二次誤差(QEM)による辺の縮約でLOD用のインデックスを作成する
+			| 頂点バッファは元のメッシュと共有し、インデックスだけを減らす
+*//**************************************************/
+#pragma once
+#include "MeshOptimizer.h"
+
+// @brief メッシュ簡略化クラス
+// @note 頂点データは先頭にfloat3の座標を持つことを前提とする
+class MeshSimplifier
+{
+public:
+	using Indices = MeshOptimizer::Indices;
+
+public:
+	// @brief 二次誤差が小さい辺から順に縮約してインデックスを減らす
+	// @param pVtx：頂点データ
+	// @param vtxSize：頂点1つあたりのサイズ
+	// @param vtxCount：頂点数
+	// @param indices：簡略化するインデックス(三角形リスト)
+	// @param out：簡略化したインデックスの格納先
+	// @param targetIndexCount：目標のインデックス数
+	// @param targetError：許容する誤差(メッシュの大きさに対する割合)
+	// @param pResultError：実際の誤差の格納先(メッシュの大きさに対する割合、不要ならnullptr)
+	// @return 簡略化後のインデックス数
+	// @note UVの継ぎ目と開いた辺上の頂点は形が崩れないよう動かさない
+	static size_t Simplify(const void* pVtx, size_t vtxSize, size_t vtxCount, const Indices& indices, Indices& out,
+		size_t targetIndexCount, float targetError, float* pResultError = nullptr);
+
+	// @brief メッシュの大きさ(AABBの最大辺の長さ)を計算する
+	// @param pVtx：頂点データ
+	// @param vtxSize：頂点1つあたりのサイズ
+	// @param vtxCount：頂点数
+	// @return メッシュの大きさ
+	static float CalcMeshScale(const void* pVtx, size_t vtxSize, size_t vtxCount);
+};
@@ -4,7 +4,9 @@
 *//***********************************************************************************/
 #include "Model.h"
 #include "DirectXTex/TextureLoad.h"
+#include "MeshSimplifier.h"
 #include <algorithm>
+#include <mutex>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -34,9 +36,12 @@ VertexShader*	Model::m_pDefVS		= nullptr;
 PixelShader*	Model::m_pDefPS		= nullptr;
 unsigned int	Model::m_shaderRef	= 0;
 #ifdef _DEBUG
-std::string		Model::m_errorStr	= "";
+thread_local std::string Model::m_errorStr = "";
 #endif
 
+// ftHgVF[_[̎QƐ̔r(Xbhœɓǂݍނ
+std::mutex g_defShaderMutex;
+
 // vg^Cv錾
 DirectX::XMMATRIX GetMatrixFromAssimpMatrix(aiMatrix4x4 M);
 void MakeModelDefaultShader(VertexShader** vs, PixelShader** ps);
@@ -54,8 +59,13 @@ Model::Model()
 	, m_blendTime(0.0f)
 	, m_blendTotalTime(0.0f)
 	, m_parametricBlend(0.0f)
+	, m_optimizeStats{}
+	, m_vertexStats{}
+	, m_boundsMin{}
+	, m_boundsMax{}
 {
 	// ftHgVF[_[̓Kp
+	std::lock_guard<std::mutex> lock(g_defShaderMutex);
 	if (m_shaderRef == 0)
 	{
 		MakeModelDefaultShader(&m_pDefVS, &m_pDefPS);
@@ -71,6 +81,7 @@ Model::Model()
 Model::~Model()
 {
 	Reset();
+	std::lock_guard<std::mutex> lock(g_defShaderMutex);
 	--m_shaderRef;
 	if (m_shaderRef <= 0)
 	{
@@ -144,7 +155,8 @@ bool Model::Load(const char* file, float scale, Flip flip)
 	m_loadFlip = flip;
 
 	// Assimpœǂݍ݂s
-	const aiScene* pScene = static_cast<const aiScene*>(LoadAssimpScene(file));
+	Assimp::Importer importer;
+	const aiScene* pScene = static_cast<const aiScene*>(LoadAssimpScene(file, importer));
 	if (!pScene) { return false; }
 
 	// t[Y`FbN
@@ -179,8 +191,9 @@ void Model::Step(float tick)
 /*************************//*
 @brief		|`揈
 @param[in]	| meshNoF`惁bVԍ(-1łׂĕ\
+@param[in]	| lodF`悷LODԍ(bVLOD𒴂ꍇ͍łeLOD
 *//*************************/
-void Model::Draw(int meshNo)
+void Model::Draw(int meshNo, int lod)
 {
 	// VF[_[ݒ
 	m_pVS->Bind();
@@ -202,23 +215,36 @@ void Model::Draw(int meshNo)
 		if (isAutoTexture) {
 			m_pPS->SetTexture(0, m_materials[m_meshes[i].materialID].pTexture);
 		}
-		m_meshes[i].pMesh->Draw();
+		m_pVS->BindLayout(m_meshes[i].layout);
+
+		// LOD쐬Ă΃CfbNX͈̔͂؂ւĕ`
+		const MeshLods& lods = m_meshes[i].lods;
+		if (lods.empty())
+		{
+			m_meshes[i].pMesh->Draw();
+		}
+		else
+		{
+			const MeshLod& meshLod = lods[std::min(static_cast<size_t>(std::max(lod, 0)), lods.size() - 1)];
+			m_meshes[i].pMesh->Draw(meshLod.idxCount, meshLod.idxStart);
+		}
 	}
 }
 
 /*************************//*
 @brief		|Assimpł̓ǂݍݎs
 @param[in]	| fileFǂݍݐpX
+@param[in]	| importerFǂݍ݂ɎgpC|[^[(aiScenȅL
 @return		| aiSceneւ̃|C^
 *//*************************/
-const void* Model::LoadAssimpScene(const char* file)
+const void* Model::LoadAssimpScene(const char* file, Assimp::Importer& importer)
 {
 #ifdef _DEBUG
 	m_errorStr = "";
 #endif
 
 	// assimp̐ݒ
-	static Assimp::Importer importer;
+	// (C|[^[͌ĂяoŗpӂAXbhԂŋLȂ
 	int flag = 0;
 	flag |= aiProcess_Triangulate;
 	flag |= aiProcess_FlipUVs;
@@ -462,9 +488,15 @@ void MakeModelDefaultShader(VertexShader** vs, PixelShader** ps)
 	const char* ModelVS = R"EOT(
 struct VS_IN {
 	float3 pos : POSITION0;
-	float3 normal : NORMAL0;
+	float2 normal : NORMAL0;
 	float2 uv : TEXCOORD0;
 };
+float3 DecodeOctNormal(float2 e) {
+	float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+	float t = saturate(-n.z);
+	n.xy += n.xy >= 0.0f ? -t : t;
+	return normalize(n);
+}
 struct VS_OUT {
 	float4 pos : SV_POSITION;
 	float3 normal : NORMAL0;
@@ -475,7 +507,7 @@ VS_OUT main(VS_IN vin) {
 	vout.pos = float4(vin.pos, 1.0f);
 	vout.pos.z += 0.5f;
 	vout.pos.y -= 0.8f;
-	vout.normal = vin.normal;
+	vout.normal = DecodeOctNormal(vin.normal);
 	vout.uv = vin.uv;
 	return vout;
 })EOT";
@@ -512,6 +544,14 @@ void Model::MakeMesh(const void* ptr)
 	int idx1 = (m_loadFlip == Flip::XFlip || m_loadFlip == Flip::ZFlip) ? 2 : 1;
 	int idx2 = (m_loadFlip == Flip::XFlip || m_loadFlip == Flip::ZFlip) ? 1 : 2;
 
+	// œKOACMROp`ŏdݕtčv
+	m_optimizeStats = {};
+	m_vertexStats = {};
+	bool isFirstBounds = true;
+	float acmrBefore = 0.0f;
+	float acmrAfter = 0.0f;
+	size_t triTotal = 0;
+
 	// bV̍쐬
 	m_meshes.resize(pScene->mNumMeshes);
 	for (unsigned int i = 0; i < m_meshes.size(); ++i)
@@ -541,6 +581,16 @@ void Model::MakeMesh(const void* ptr)
 				DirectX::XMFLOAT2(uv.x, uv.y),
 				DirectX::XMFLOAT4(color.r, color.g, color.b, color.a)
 			};
+
+			// E{bNX̍XV
+			const DirectX::XMFLOAT3& vtxPos = mesh.vertices[j].pos;
+			if (isFirstBounds)
+			{
+				m_boundsMin = m_boundsMax = vtxPos;
+				isFirstBounds = false;
+			}
+			m_boundsMin = DirectX::XMFLOAT3(std::min(m_boundsMin.x, vtxPos.x), std::min(m_boundsMin.y, vtxPos.y), std::min(m_boundsMin.z, vtxPos.z));
+			m_boundsMax = DirectX::XMFLOAT3(std::max(m_boundsMax.x, vtxPos.x), std::max(m_boundsMax.y, vtxPos.y), std::max(m_boundsMax.z, vtxPos.z));
 		}
 
 		// {[
@@ -565,18 +615,146 @@ void Model::MakeMesh(const void* ptr)
 		// }eÅ蓖
 		mesh.materialID = assimpMesh->mMaterialIndex;
 
+		// bV̍œK(d_̍폜AOp`ƒ_̕ёւ)
+		// [t܂ރbV͒_̑ΉȂ悤œKȂ
+		MeshOptimizeStats stats = {};
+		if (assimpMesh->mNumAnimMeshes == 0)
+		{
+			size_t vtxNum = MeshOptimizer::Optimize(mesh.vertices.data(), sizeof(Vertex), mesh.vertices.size(), mesh.indices, &mesh.remap, &stats);
+			mesh.vertices.resize(vtxNum);
+		}
+		else
+		{
+			stats.m_nVtxCountBefore = stats.m_nVtxCountAfter = mesh.vertices.size();
+			stats.m_fACMRBefore = stats.m_fACMRAfter = MeshOptimizer::CalcACMR(mesh.indices, mesh.vertices.size());
+			stats.m_nVtxBytesBefore = stats.m_nVtxBytesAfter = mesh.vertices.size() * sizeof(Vertex);
+			stats.m_nIdxBytesBefore = stats.m_nIdxBytesAfter = mesh.indices.size() * sizeof(unsigned long);
+		}
+		size_t triNum = mesh.indices.size() / 3;
+		acmrBefore += stats.m_fACMRBefore * triNum;
+		acmrAfter += stats.m_fACMRAfter * triNum;
+		triTotal += triNum;
+		m_optimizeStats.m_nVtxCountBefore += stats.m_nVtxCountBefore;
+		m_optimizeStats.m_nVtxCountAfter += stats.m_nVtxCountAfter;
+		m_optimizeStats.m_nVtxBytesBefore += stats.m_nVtxBytesBefore;
+		m_optimizeStats.m_nVtxBytesAfter += stats.m_nVtxBytesAfter;
+		m_optimizeStats.m_nIdxBytesBefore += stats.m_nIdxBytesBefore;
+
+		// LOD̍쐬(̃CfbNX̌ɊȗCfbNXA)
+		// [t܂ރbV͏ݎɃCfbNX蒼̂LOD쐬Ȃ
+		Indices lodIndices = mesh.indices;
+		mesh.lods = { { 0, static_cast<UINT>(mesh.indices.size()), 0.0f } };
+		if (assimpMesh->mNumAnimMeshes == 0)
+		{
+			MakeLod(mesh, lodIndices);
+		}
+
+		// _Ȃ16bitCfbNXgp
+		std::vector<unsigned short> indices16;
+		const void* pIdx = lodIndices.data();
+		UINT idxSize = sizeof(unsigned long);
+		if (assimpMesh->mNumAnimMeshes == 0 && MeshOptimizer::CanUseIndex16(mesh.vertices.size()))
+		{
+			indices16.assign(lodIndices.begin(), lodIndices.end());
+			pIdx = indices16.data();
+			idxSize = sizeof(unsigned short);
+		}
+		m_optimizeStats.m_nIdxBytesAfter += mesh.indices.size() * idxSize;
+
+		// Kvȗvf̌`IĒ_k
+		// _J[SĔ̏ꍇ͐FȂ`ɂ
+		bool isColor = false;
+		if (assimpMesh->HasVertexColors(0))
+		{
+			isColor = std::any_of(mesh.vertices.begin(), mesh.vertices.end(), [](const Vertex& vtx)
+				{
+					return vtx.color.x < 1.0f || vtx.color.y < 1.0f || vtx.color.z < 1.0f || vtx.color.w < 1.0f;
+				});
+		}
+		if (!mesh.bones.empty())
+			mesh.layout = isColor ? VertexLayout::SkinnedColor : VertexLayout::Skinned;
+		else
+			mesh.layout = isColor ? VertexLayout::StaticColor : VertexLayout::Static;
+		std::vector<unsigned char> packed;
+		PackVertices(mesh.layout, mesh.vertices, packed);
+		CheckPackError(mesh.layout, mesh.vertices, packed);
+		UINT stride = VertexFormat::GetInfo(mesh.layout).m_nStride;
+		m_vertexStats.m_nFullBytes += mesh.vertices.size() * sizeof(Vertex);
+		m_vertexStats.m_nPackedBytes += mesh.vertices.size() * stride;
+		m_vertexStats.m_nLayoutCount[(int)mesh.layout]++;
+
 		// bVɒ_obt@쐬
 		MeshBuffer::Description desc = {};
-		desc.pVtx = mesh.vertices.data();
-		desc.vtxSize = sizeof(Vertex);
+		desc.pVtx = packed.data();
+		desc.vtxSize = stride;
 		desc.vtxCount = static_cast<int>(mesh.vertices.size());
-		desc.pIdx = mesh.indices.data();
-		desc.idxSize = sizeof(unsigned long);
-		desc.idxCount = static_cast<int>(mesh.indices.size());
+		desc.pIdx = pIdx;
+		desc.idxSize = idxSize;
+		desc.idxCount = static_cast<int>(lodIndices.size());
 		desc.topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
 		mesh.pMesh = new MeshBuffer();
 		mesh.pMesh->Create(desc);
 	}
+
+	if (triTotal > 0)
+	{
+		m_optimizeStats.m_fACMRBefore = acmrBefore / triTotal;
+		m_optimizeStats.m_fACMRAfter = acmrAfter / triTotal;
+	}
+}
+
+/*************************//*
+@brief		| LOD̍쐬
+@param[in]	| meshFLOD쐬郁bV(lodsɍ쐬LODǉ)
+@param[out]	| outFȗCfbNXA
+*//*************************/
+void Model::MakeLod(Mesh& mesh, Indices& out)
+{
+	float meshScale = MeshSimplifier::CalcMeshScale(mesh.vertices.data(), sizeof(Vertex), mesh.vertices.size());
+	size_t prevCount = mesh.indices.size();
+	for (UINT i = 1; i < MAX_LOD; ++i)
+	{
+		// ̃bVڕW̎Op`܂Ŋȗ
+		size_t target = static_cast<size_t>(mesh.indices.size() / 3 * LOD_TRIANGLE_RATIO[i]) * 3;
+		Indices simplified;
+		float error = 0.0f;
+		MeshSimplifier::Simplify(mesh.vertices.data(), sizeof(Vertex), mesh.vertices.size(), mesh.indices, simplified, target, LOD_MAX_ERROR, &error);
+
+		// قƂǌȂΈȍ~LOD͍쐬Ȃ
+		if (simplified.empty() || simplified.size() > prevCount * LOD_MIN_REDUCTION) { break; }
+		prevCount = simplified.size();
+
+		// ȗCfbNX_LbVɍ킹ĕёւ
+		MeshOptimizer::OptimizeVertexCache(simplified, mesh.vertices.size());
+
+		mesh.lods.push_back({ static_cast<UINT>(out.size()), static_cast<UINT>(simplified.size()), error * meshScale });
+		out.insert(out.end(), simplified.begin(), simplified.end());
+	}
+}
+
+/*************************//*
+@brief		| _̈k
+@param[in]	| layoutFk`
+@param[in]	| verticesFkO̒_
+@param[out]	| outFk_̊i[
+*//*************************/
+void Model::PackVertices(VertexLayout layout, const Vertices& vertices, std::vector<unsigned char>& out)
+{
+	UINT stride = VertexFormat::GetInfo(layout).m_nStride;
+	out.resize(vertices.size() * stride);
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		const Vertex& vtx = vertices[i];
+		VertexAttribute attr = {
+			{ vtx.pos.x, vtx.pos.y, vtx.pos.z },
+			{ vtx.normal.x, vtx.normal.y, vtx.normal.z },
+			{ vtx.uv.x, vtx.uv.y },
+			{ vtx.color.x, vtx.color.y, vtx.color.z, vtx.color.w },
+			{ vtx.weight[0], vtx.weight[1], vtx.weight[2], vtx.weight[3] },
+			{ vtx.index[0], vtx.index[1], vtx.index[2], vtx.index[3] },
+		};
+		VertexFormat::Pack(layout, attr, out.data() + i * stride);
+	}
 }
 
 /*************************//*
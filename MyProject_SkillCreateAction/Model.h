@@ -7,8 +7,13 @@
 #include <vector>
 #include "Shader.h"
 #include "MeshBuffer.h"
+#include "MeshOptimizer.h"
+#include "VertexFormat.h"
 #include <functional>
 
+// O錾
+namespace Assimp { class Importer; }
+
 #ifdef _DEBUG
 #define MODEL_FORCE_ERROR (1) // G[bZ[W\
 #else
@@ -50,6 +55,7 @@ public:
 	static const MorphNo	MORPH_NONE			= -1;	// Y[tȂ
 	static const AnimeNo	ANIME_NONE			= -1;	// YAj[VȂ
 	static const AnimeNo	PARAMETRIC_ANIME	= -2;	// Aj[V
+	static const UINT		MAX_LOD				= 4;	// PbV̍őLOD(LOD0͌̃bV
 
 private:
 	// ^`
@@ -59,6 +65,9 @@ private:
 	// 萔`
 	static const UINT	MAX_BONE	= 200;	// PbV̍ő{[(ύXꍇ.hlsl̒`ύX
 	static const UINT	MAX_WEIGHT	= 4;	// P_Ɋ蓖Ăő{[
+	static constexpr float	LOD_TRIANGLE_RATIO[MAX_LOD] = { 1.0f, 0.5f, 0.25f, 0.125f };	// LOD̖ڕWOp`(̃bVɑ΂銄
+	static constexpr float	LOD_MAX_ERROR		= 0.05f;	// e덷(bV̑傫ɑ΂銄
+	static constexpr float	LOD_MIN_REDUCTION	= 0.9f;		// OLOD炱̊܂łȂ΍쐬߂
 
 	// Kw
 	struct Node
@@ -168,6 +177,15 @@ public:
 	};
 	using Bones = std::vector<Bone>;
 
+	// LOD(_obt@͋LACfbNXobt@͈̔͂Ő؂ւ
+	struct MeshLod
+	{
+		UINT	idxStart;	// CfbNX̊Jnʒu
+		UINT	idxCount;	// CfbNX
+		float	error;		// ̃bV̌덷(fԂł̋
+	};
+	using MeshLods = std::vector<MeshLod>;
+
 	// bV
 	struct Mesh
 	{
@@ -177,6 +195,9 @@ public:
 		unsigned int	materialID;	// gp}eA
 		Bones			bones;		// bVɕRÂĂ{[
 		MeshBuffer*		pMesh;		// `f[^
+		MeshOptimizer::Remap remap;	// ǂݍݎ̒_ԍœK̒_ԍւ̑Ή\(œKĂȂ΋
+		VertexLayout	layout;		// _obt@̈k`
+		MeshLods		lods;		// LOD(擪̃bV
 	};
 	using Meshes = std::vector<Mesh>;
 
@@ -233,8 +254,9 @@ public:
 	/*
 	* @brief `揈
 	* @param[in] meshNo `惁bVԍ(-1łׂĕ\
+	* @param[in] lod `悷LODԍ(bVLOD𒴂ꍇ͍łeLOD
 	*/
-	void Draw(int meshNo = -1);
+	void Draw(int meshNo = -1, int lod = 0);
 
 
 	//========================================
@@ -364,6 +386,13 @@ public:
 	*/
 	const Material* GetMaterial(unsigned int index);
 
+	/*
+	* @brief fԂł̋E{bNX擾
+	* @param[out] outMin ŏW
+	* @param[out] outMax őW
+	*/
+	void GetBounds(DirectX::XMFLOAT3& outMin, DirectX::XMFLOAT3& outMax);
+
 	/*
 	* @brief Aj[V̕ϊs擾
 	* @param[in] index {[ԍ
@@ -396,12 +425,41 @@ public:
 	*/
 	const AnimePlayInfo* GetPlayAnimeInfo();
 
+	/*
+	* @brief ǂݍݎ̃bVœKʂ擾
+	* @return SbV̍œKʂ̍v
+	*/
+	const MeshOptimizeStats& GetOptimizeStats();
+
+	/*
+	* @brief ǂݍݎ̒_kʂ擾
+	* @return SbV̒_kʂ̍v
+	*/
+	const VertexPackStats& GetVertexPackStats();
+
+
+	//========================================
+	//     v
+	//========================================
+	/*
+	* @brief ǂݍݎ̃bVœKmFp̃bVƃftH_̑St@CɍsAʂo
+	* @param[in] inReportPath ot@C̃pX
+	* @return 0: 1:s(ǂݍ߂Ȃt@CAOp`ςAACMR)
+	*/
+	static int MeasureOptimize(const char* inReportPath);
+	/*
+	* @brief mFp̃bVƃftH_̑St@CLOD쐬ALOD̎Op`ƌ덷o
+	* @param[in] inReportPath ot@C̃pX
+	* @return 0: 1:s(ǂݍ߂Ȃt@CAOp`E덷̕тsA덷el𒴂)
+	*/
+	static int MeasureLod(const char* inReportPath);
+
 private:
 	//========================================
 	//     {
 	//========================================
-	// assimpŃf[^ǂݍ
-	const void* LoadAssimpScene(const char* file);
+	// assimpŃf[^ǂݍ(ǂݍ񂾃f[^importerj܂ŗL)
+	const void* LoadAssimpScene(const char* file, Assimp::Importer& importer);
 	// Kw̍\z
 	void MakeNodes(const void* ptr);
 	// bV̍쐬
@@ -414,6 +472,10 @@ private:
 	void MakeVertexWeightHasBone(const void* ptr, Mesh& mesh);
 	// eq֌WƂɒ_uh쐬
 	void MakeVertexWeightFromNode(const void* scene, const void* ptr, Mesh& mesh);
+	// LOD̍쐬
+	static void MakeLod(Mesh& mesh, Indices& out);
+	// _̈k
+	void PackVertices(VertexLayout layout, const Vertices& vertices, std::vector<unsigned char>& out);
 
 	//========================================
 	//     `FbN
@@ -432,6 +494,8 @@ private:
 	bool CheckMeshFreeze(const void* ptr);
 	// Aj[Vԍ̃`FbN
 	bool CheckAnimeNo(AnimeNo no);
+	// _kɂ덷̃`FbN
+	void CheckPackError(VertexLayout layout, const Vertices& vertices, const std::vector<unsigned char>& packed);
 
 
 	//========================================
@@ -472,12 +536,18 @@ private:
 	// fBNg̎擾
 	std::string GetDirectory(const char* file);
 
+	//========================================
+	//     v
+	//========================================
+	// vp̃bVW߂(œKO̒_ƃCfbNX̂
+	static bool MakeReportMeshes(std::vector<std::string>& outNames, Meshes& outMeshes, std::string& outError);
+
 private:
 	static VertexShader*	m_pDefVS;		// ftHg_VF[_[
 	static PixelShader*		m_pDefPS;		// ftHgsNZVF[_[
 	static unsigned int		m_shaderRef;	// VF[_[QƐ
 #ifdef _DEBUG
-	static std::string m_errorStr;	
+	static thread_local std::string m_errorStr;	// ǂݍ݂̓XbhɍŝŃG[Xbhɕێ
 #endif
 
 private:
@@ -488,6 +558,10 @@ private:
 	Nodes			m_nodes;		// Kw
 	Meshes			m_meshes;		// bVz
 	Materials		m_materials;	// }eAz
+	MeshOptimizeStats m_optimizeStats;	// bVœK
+	VertexPackStats m_vertexStats;		// _k
+	DirectX::XMFLOAT3 m_boundsMin;		// E{bNX̍ŏW
+	DirectX::XMFLOAT3 m_boundsMax;		// E{bNX̍őW
 	
 	AnimeTransforms	m_animeTransform[MAX_ANIMEPATTERN];	// Aj[VĐ@ʕό`
 	Animations		m_animes;			// Ajz
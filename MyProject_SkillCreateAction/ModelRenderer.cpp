@@ -6,6 +6,12 @@
 *//**************************************************/
 #include "ModelRenderer.h"
 #include "Camera.h"
+#include "RenderQueue.h"
+#include "ShaderManager.h"
+#include <algorithm>
+
+// LODを切り替える基準の初期値(画面上で許容する誤差のピクセル数)
+const float ce_fDefaultLodPixelError = 1.0f;
 
 /*****************************************//*
     @brief　	| デストラクタ
@@ -22,6 +28,13 @@ void CModelRenderer::Init()
 {
     // デフォルトでは深度バッファを有効にする
     m_bIsDepth = true;
+
+    m_fLodPixelError = ce_fDefaultLodPixelError;
+    m_nLod = 0;
+
+    // デフォルトのシェーダー(機能を使う場合はSetVertexShader等で差し替える)
+    m_pVS = CShaderManager::GetInstance()->GetVertexShader(VSType::Object);
+    m_pPS = CShaderManager::GetInstance()->GetPixelShader(PSType::TexColor);
 }
 
 /*****************************************//*
@@ -30,79 +43,110 @@ void CModelRenderer::Init()
 void CModelRenderer::Draw()
 {
     // キーが設定されていない時は描画しない
-    if (m_sKey.empty()) return;
-
-    // フラグによって深度バッファを使用するか決める
-    RenderTarget* pRTV = GetDefaultRTV();
-    DepthStencil* pDSV = GetDefaultDSV();
-
-	// レンダーターゲットとデプスステンシルのセット
-    if (m_bIsDepth) SetRenderTargets(1, &pRTV, pDSV);
-    else SetRenderTargets(1, &pRTV, nullptr);
-
-    // カリングのセットアップ用
-    SetCullingMode(m_tParam.m_eCulling);
-
-    // カメラ情報の取得
-    CCamera* pCamera = CCamera::GetInstance();
+    const RendererObject* pObject = GetRendererObject();
+    if (!pObject || !m_pVS || !m_pPS) return;
 
-    // 行列計算
-    DirectX::XMFLOAT4X4 wvp[3];
+    // 描画パス(フラグによって深度バッファを使用するか決める)
+    RenderPass ePass = m_bIsDepth ? RenderPass::World : RenderPass::WorldNoDepth;
 
     // ワールド行列
     DirectX::XMMATRIX world =
         DirectX::XMMatrixScaling(m_tParam.m_f3Size.x, m_tParam.m_f3Size.y, m_tParam.m_f3Size.z) *
         DirectX::XMMatrixRotationRollPitchYaw(m_tParam.m_f3Rotate.x, m_tParam.m_f3Rotate.y, m_tParam.m_f3Rotate.z) *
         DirectX::XMMatrixTranslation(m_tParam.m_f3Pos.x, m_tParam.m_f3Pos.y, m_tParam.m_f3Pos.z);
-    world = DirectX::XMMatrixTranspose(world);
-    DirectX::XMStoreFloat4x4(&wvp[0], world);
 
-    // 頂点シェーダーに情報を渡す
-    switch (m_pVS->m_eType)
-    {
-    case VSType::Object:
-    {
+    // 描画するモデルの取得
+    Model* pModel = std::get<ModelParam>(pObject->m_Data).m_pModel;
 
-    // ビュー行列
-    wvp[1] = pCamera->GetViewMatrix();
+    // LOD選択用に画面上の大きさを計算
+    float fPixelPerUnit = CalcPixelPerUnit(pModel, world);
 
-    // プロジェクション行列
-    wvp[2] = pCamera->GetProjectionMatrix();
+    // 描画順の並べ替え用にカメラからの距離を計算
+    DirectX::XMFLOAT3 f3CamPos = CCamera::GetInstance()->GetPos();
+    float fDepth = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(
+        DirectX::XMLoadFloat3(&m_tParam.m_f3Pos), DirectX::XMLoadFloat3(&f3CamPos))));
 
-    // シェーダーに行列を渡す
-	m_pVS->WriteBuffer(0, wvp);
-    }
-    break;
-    }
+    // ワールド行列と色は描画キューにまとめて積む(同じモデルはインスタンス描画にまとめられる)
+    DirectX::XMFLOAT4X4 f4x4World;
+    DirectX::XMStoreFloat4x4(&f4x4World, world);
+    UINT nTransform = RenderQueue::PushTransform(f4x4World, m_tParam.m_f4Color);
 
-    // ピクセルシェーダーに情報を渡す
-    switch (m_pPS->m_eType)
-    {
-    case PSType::TexColor:
+    // メッシュ毎に描画命令を積む(状態の設定と描画はRenderQueue::Flushで行う)
+    m_nLod = 0;
+    for (unsigned int i = 0; i < pModel->GetMeshNum(); i++)
     {
-
-    }
-    break;
+        const Model::Mesh& Mesh = *pModel->GetMesh(i);
+        const Model::Material& material = *pModel->GetMaterial(Mesh.materialID);
+
+        // メッシュ毎に画面上の誤差が基準以下になるLODで描画
+        int nLod = SelectLod(Mesh, fPixelPerUnit);
+        m_nLod = (std::max)(m_nLod, nLod);
+
+        RenderItem tItem = {};
+        tItem.m_pMesh = Mesh.pMesh;
+        tItem.m_eLayout = Mesh.layout;
+        if (!Mesh.lods.empty())
+        {
+            const Model::MeshLod& tLod = Mesh.lods[(std::min)(static_cast<size_t>(nLod), Mesh.lods.size() - 1)];
+            tItem.m_nIdxStart = tLod.idxStart;
+            tItem.m_nIdxCount = tLod.idxCount;
+        }
+        tItem.m_pVS = m_pVS;
+        tItem.m_pPS = m_pPS;
+        tItem.m_pTexture = material.pTexture;
+        tItem.m_eCulling = m_tParam.m_eCulling;
+        tItem.m_ePass = ePass;
+        tItem.m_nTransform = nTransform;
+
+        // マテリアルの透明度で半透明として扱うか決める
+        RenderQueue::Submit(tItem, fDepth, material.diffuse.w < 1.0f);
     }
+}
 
-    // モデルにシェーダーをセット
-    Model* pModel = std::get<ModelParam>(m_RendererObjectMap.find(m_sKey.c_str())->second.m_Data).m_pModel;
+/*****************************************//*
+    @brief　	| モデル空間の長さ1が画面上で何ピクセルになるかを計算
+    @param　	| pModel：描画するモデル
+    @param　	| world：ワールド行列(転置していない)
+    @return　	| 画面上のピクセル数(カメラが境界球の中にある場合は0未満)
+*//****************************************/
+float CModelRenderer::CalcPixelPerUnit(Model* pModel, const DirectX::XMMATRIX& world)
+{
+    CCamera* pCamera = CCamera::GetInstance();
 
-    pModel->SetVertexShader(m_pVS);
+    // 境界ボックスを囲む球をワールド空間に変換
+    DirectX::XMFLOAT3 f3Min, f3Max;
+    pModel->GetBounds(f3Min, f3Max);
+    DirectX::XMVECTOR vMin = DirectX::XMLoadFloat3(&f3Min);
+    DirectX::XMVECTOR vMax = DirectX::XMLoadFloat3(&f3Max);
+    float fScale = (std::max)(fabsf(m_tParam.m_f3Size.x), (std::max)(fabsf(m_tParam.m_f3Size.y), fabsf(m_tParam.m_f3Size.z)));
+    float fRadius = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(vMax, vMin))) * 0.5f * fScale;
+    DirectX::XMVECTOR vCenter = DirectX::XMVector3TransformCoord(DirectX::XMVectorScale(DirectX::XMVectorAdd(vMin, vMax), 0.5f), world);
+
+    // カメラから境界球の表面までの距離
+    DirectX::XMFLOAT3 f3CamPos = pCamera->GetPos();
+    float fDistance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&f3CamPos), vCenter))) - fRadius;
+    if (fDistance <= 0.0f) return -1.0f;
+
+    // 投影行列の縦方向の拡大率から画面上の大きさを求める
+    DirectX::XMFLOAT4X4 proj = pCamera->GetProjectionMatrix(false);
+    return fScale * proj._22 * (SCREEN_HEIGHT * 0.5f) / fDistance;
+}
 
-    pModel->SetPixelShader(m_pPS);
+/*****************************************//*
+    @brief　	| 画面上の誤差が基準以下になる最も粗いLODを選択
+    @param　	| tMesh：描画するメッシュ
+    @param　	| fPixelPerUnit：モデル空間の長さ1の画面上のピクセル数
+    @return　	| LOD番号
+*//****************************************/
+int CModelRenderer::SelectLod(const Model::Mesh& tMesh, float fPixelPerUnit)
+{
+    if (fPixelPerUnit < 0.0f) return 0;
 
-    // モデルの描画
-    for (unsigned int i = 0; i < pModel->GetMeshNum(); i++)
+    for (int i = static_cast<int>(tMesh.lods.size()) - 1; i > 0; --i)
     {
-        Model::Mesh Mesh = *pModel->GetMesh(i);
-        Model::Material material = *pModel->GetMaterial(Mesh.materialID);
-
-		m_pVS->SetTexture(0, material.pTexture);
-		m_pPS->SetTexture(0, material.pTexture);
-
-        if (pModel) pModel->Draw(i);
+        if (tMesh.lods[i].error * fPixelPerUnit <= m_fLodPixelError) return i;
     }
+    return 0;
 }
 
 /*****************************************//*
@@ -111,5 +155,7 @@ void CModelRenderer::Draw()
 *//****************************************/
 std::vector<Model::Mesh> CModelRenderer::GetMesh()
 {
-    return std::get<ModelParam>(m_RendererObjectMap.find(m_sKey)->second.m_Data).m_tMeshVec;
+    const RendererObject* pObject = GetRendererObject();
+    if (!pObject) return {};
+    return std::get<ModelParam>(pObject->m_Data).m_tMeshVec;
 }
@@ -41,6 +41,27 @@ public:
 	// @param pPS：ピクセルシェーダーのポインタ
 	void SetPixelShader(PixelShader* pPS) { m_pPS = pPS; }
 
+	// @brief LODを切り替える基準の設定
+	// @param fPixelError：画面上で許容する誤差(ピクセル)
+	void SetLodPixelError(float fPixelError) { m_fLodPixelError = fPixelError; }
+
+	// @brief 直前の描画で選択された最も粗いLOD番号を取得
+	// @return LOD番号(0が元のメッシュ)
+	int GetLod() const { return m_nLod; }
+
+private:
+	// @brief モデル空間の長さ1が画面上で何ピクセルになるかを計算
+	// @param pModel：描画するモデル
+	// @param world：ワールド行列(転置していない)
+	// @return 画面上のピクセル数(カメラが境界球の中にある場合は0未満)
+	float CalcPixelPerUnit(Model* pModel, const DirectX::XMMATRIX& world);
+
+	// @brief 画面上の誤差が基準以下になる最も粗いLODを選択
+	// @param tMesh：描画するメッシュ
+	// @param fPixelPerUnit：モデル空間の長さ1の画面上のピクセル数
+	// @return LOD番号
+	int SelectLod(const Model::Mesh& tMesh, float fPixelPerUnit);
+
 private:
 	// @brief 深度バッファを使用するかどうか
 	bool m_bIsDepth;
@@ -51,4 +72,10 @@ private:
 	// @brief ピクセルシェーダー
 	PixelShader* m_pPS;
 
+	// @brief LODを切り替える基準(画面上で許容する誤差のピクセル数)
+	float m_fLodPixelError;
+
+	// @brief 直前の描画で選択された最も粗いLOD番号
+	int m_nLod;
+
 };
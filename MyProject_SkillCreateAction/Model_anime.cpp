@@ -15,7 +15,8 @@
 Model::AnimeNo Model::AddAnimation(const char* file)
 {
 	// Assimpœǂݍ݂s
-	const aiScene* pScene = static_cast<const aiScene*>(LoadAssimpScene(file));
+	Assimp::Importer importer;
+	const aiScene* pScene = static_cast<const aiScene*>(LoadAssimpScene(file, importer));
 	if (!pScene)
 	{
 #if MODEL_FORCE_ERROR
@@ -3,6 +3,8 @@
 	@brief		| ff[^̋ʏ
 *//***********************************************************************************/
 #include "Model.h"
+#include <algorithm>
+#include <cmath>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -51,7 +53,6 @@ void Model::DrawBone(DirectX::XMMATRIX world)
 
 	// `s
 	FuncDrawBone(0, DirectX::XMFLOAT3());
-	Geometory::DrawLines();
 #endif
 }
 
@@ -191,4 +192,41 @@ bool Model::CheckAnimeNo(AnimeNo no)
 
 	// ȂAj[Vԍǂ
 	return 0 <= no && no < m_animes.size();
-}
\ No newline at end of file
+}
+
+/*************************//*
+@brief		| _kɂ덷̃`FbN
+@param[in]	| layoutFk`
+@param[in]	| verticesFkO̒_
+@param[in]	| packedFk_
+*//*************************/
+void Model::CheckPackError(VertexLayout layout, const Vertices& vertices, const std::vector<unsigned char>& packed)
+{
+	const VertexLayoutInfo& info = VertexFormat::GetInfo(layout);
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		const Vertex& vtx = vertices[i];
+		VertexAttribute attr;
+		VertexFormat::Unpack(layout, packed.data() + i * info.m_nStride, attr);
+
+		// @͊px̍Ŕr(0̖@͑ΏۊO)
+		DirectX::XMVECTOR vSrc = DirectX::XMLoadFloat3(&vtx.normal);
+		if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(vSrc)) > FLT_EPSILON)
+		{
+			DirectX::XMVECTOR vDst = DirectX::XMVectorSet(attr.m_fNormal[0], attr.m_fNormal[1], attr.m_fNormal[2], 0.0f);
+			float angle = DirectX::XMVectorGetX(DirectX::XMVector3AngleBetweenNormals(DirectX::XMVector3Normalize(vSrc), vDst));
+			m_vertexStats.m_fMaxNormalError = std::max(m_vertexStats.m_fMaxNormalError, DirectX::XMConvertToDegrees(angle));
+		}
+
+		// UV
+		m_vertexStats.m_fMaxUVError = std::max(m_vertexStats.m_fMaxUVError, fabsf(vtx.uv.x - attr.m_fUV[0]));
+		m_vertexStats.m_fMaxUVError = std::max(m_vertexStats.m_fMaxUVError, fabsf(vtx.uv.y - attr.m_fUV[1]));
+
+		// EFCg
+		if (info.m_nWeightOffset < 0) { continue; }
+		for (int j = 0; j < MAX_WEIGHT; ++j)
+		{
+			m_vertexStats.m_fMaxWeightError = std::max(m_vertexStats.m_fMaxWeightError, fabsf(vtx.weight[j] - attr.m_fWeight[j]));
+		}
+	}
+}
@@ -49,6 +49,17 @@ const Model::Material* Model::GetMaterial(unsigned int index)
 	return nullptr;
 }
 
+/*************************//*
+@brief		| fԂł̋E{bNX擾
+@param[out]	| outMinFŏW
+@param[out]	| outMaxFőW
+*//*************************/
+void Model::GetBounds(DirectX::XMFLOAT3& outMin, DirectX::XMFLOAT3& outMax)
+{
+	outMin = m_boundsMin;
+	outMax = m_boundsMax;
+}
+
 /*************************//*
 @brief		| {[̕ϊs擾
 @param[in]	| indexF擾{[ԍ
@@ -119,6 +130,24 @@ const Model::AnimePlayInfo* Model::GetPlayAnimeInfo()
 	return &m_animes[no].info;
 }
 
+/*************************//*
+@brief  | ǂݍݎ̃bVœKʂ擾
+@return | SbV̍œKʂ̍v
+*//*************************/
+const MeshOptimizeStats& Model::GetOptimizeStats()
+{
+	return m_optimizeStats;
+}
+
+/*************************//*
+@brief  | ǂݍݎ̒_kʂ擾
+@return | SbV̒_kʂ̍v
+*//*************************/
+const VertexPackStats& Model::GetVertexPackStats()
+{
+	return m_vertexStats;
+}
+
 /*************************//*
 @brief		| fBNg̎擾
 @param[in]	| fileFt@CpX
@@ -16,7 +16,8 @@
 bool Model::AddMorph(const char* file, Indices* out)
 {
 	// Assimpœǂݍ݂s
-	const aiScene* pScene = static_cast<const aiScene*>(LoadAssimpScene(file));
+	Assimp::Importer importer;
+	const aiScene* pScene = static_cast<const aiScene*>(LoadAssimpScene(file, importer));
 	if (!pScene)
 	{
 #if MODEL_FORCE_ERROR
@@ -64,7 +65,8 @@ void Model::SetMorphWeight(MorphNo no, float weight)
 Model::AnimeNo Model::AddMorphAnime(const char* file)
 {
 	// Assimpœǂݍ݂s
-	const aiScene* pScene = static_cast<const aiScene*>(LoadAssimpScene(file));
+	Assimp::Importer importer;
+	const aiScene* pScene = static_cast<const aiScene*>(LoadAssimpScene(file, importer));
 	if (!pScene)
 	{
 #if MODEL_FORCE_ERROR
@@ -206,8 +208,11 @@ void Model::MakeMorphMesh(const void* ptr, int meshIndex, Indices* out)
 	MeshBuffer* mesh = m_meshes[meshIndex].pMesh;
 	MeshBuffer::Description desc = mesh->GetDesc();
 	if (!desc.isWrite) {
-		desc.pVtx = m_meshes[meshIndex].vertices.data();
+		std::vector<unsigned char> packed;
+		PackVertices(m_meshes[meshIndex].layout, m_meshes[meshIndex].vertices, packed);
+		desc.pVtx = packed.data();
 		desc.pIdx = m_meshes[meshIndex].indices.data();
+		desc.idxSize = sizeof(unsigned long);
 		desc.isWrite = true;
 		mesh->Create(desc);
 	}
@@ -218,8 +223,11 @@ void Model::MakeMorphMesh(const void* ptr, int meshIndex, Indices* out)
 		const aiAnimMesh* animeMesh = asmpMesh->mAnimMeshes[i];
 
 		// _vĂ邩mF
+		// (ǂݍݎɍœKĂꍇ͍œKO̒_Ɣr
 		unsigned int vtxNum = animeMesh->mNumVertices;
-		if (vtxNum != m_meshes[meshIndex].vertices.size())
+		const MeshOptimizer::Remap& remap = m_meshes[meshIndex].remap;
+		size_t baseVtxNum = remap.empty() ? m_meshes[meshIndex].vertices.size() : remap.size();
+		if (vtxNum != baseVtxNum)
 		{
 			std::string msg;
 			msg += "no match morph vtxNum. [";
@@ -246,6 +254,18 @@ void Model::MakeMorphMesh(const void* ptr, int meshIndex, Indices* out)
 		morph.weight	= animeMesh->mWeight;
 		MakeMorphVertices(morph.vertices, animeMesh);
 
+		// œKŒ_ёւĂꍇ͑Ή\ɍ킹ĕёւ
+		if (!remap.empty())
+		{
+			MorphVertices sorted(m_meshes[meshIndex].vertices.size());
+			for (size_t j = 0; j < remap.size(); ++j)
+			{
+				if (remap[j] != MeshOptimizer::REMAP_NONE)
+					sorted[remap[j]] = morph.vertices[j];
+			}
+			morph.vertices.swap(sorted);
+		}
+
 		// [t̃CfbNX쐬
 		if (out) {
 			out->push_back(static_cast<unsigned long>(m_morphes.size() - 1));
@@ -444,8 +464,10 @@ void Model::UpdateMorph()
 			++idxIt;
 		}
 
-		// [t̍ʂ
-		meshIt->pMesh->Write(vtx.data());
+		// [t̍ʂkď
+		std::vector<unsigned char> packed;
+		PackVertices(meshIt->layout, vtx, packed);
+		meshIt->pMesh->Write(packed.data());
 	}
 }
 
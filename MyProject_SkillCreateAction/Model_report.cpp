@@ -0,0 +1,444 @@
+/**********************************************************************************//*
+	@file		| Model_report.cpp
+	@brief		| ff[^̓ǂݍݎ̌v
+	@note		| foCX炸ɁAǂݍݎ̃bVmFp̃bV
+				| ftH_̑St@CɍsČʂt@Cɏo
+*//***********************************************************************************/
+#include "Model.h"
+#include "Defines.h"
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <fstream>
+#include <filesystem>
+#include <cmath>
+#include <cstring>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+// mFpbV̒萔
+const int REPORT_GRID_DIV = 64;			// N̂nʂ̕
+const int REPORT_SPHERE_SEGMENT = 48;	// ̌ox̕
+const int REPORT_SPHERE_RING = 32;		// ̈ܓx̕
+const int REPORT_TORUS_SEGMENT = 48;	// g[X̗ւ̕
+const int REPORT_TORUS_SIDE = 24;		// g[X̒fʂ̕
+const int REPORT_CYLINDER_SEGMENT = 32;	// ~̎̕
+const int REPORT_CYLINDER_RING = 8;		// ~̍̕
+const unsigned int REPORT_SEED = 27;	// Op`̕т̎
+
+namespace
+{
+	/*************************//*
+	@brief		| mFp̒_쐬
+	@param[in]	| posFW
+	@param[in]	| normalF@
+	@param[in]	| u,vFUV
+	@return		| _(F͔AEFCgȂ
+	*//*************************/
+	Model::Vertex MakeReportVertex(DirectX::XMFLOAT3 pos, DirectX::XMFLOAT3 normal, float u, float v)
+	{
+		Model::Vertex vtx = {};
+		vtx.pos = pos;
+		vtx.normal = normal;
+		vtx.uv = DirectX::XMFLOAT2(u, v);
+		vtx.color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+		return vtx;
+	}
+
+	/*************************//*
+	@brief		| iqɒ_ׂʂ쐬
+	@param[in]	| divU,divVF
+	@param[in]	| funcFUV(0`1)璸_߂鏈
+	@param[out]	| verticesF_̒ǉ
+	@param[out]	| indicesFCfbNX̒ǉ
+	@note		| ɂ̂悤1_ɒׂOp`͍Ȃ
+	*//*************************/
+	void AddReportSurface(int divU, int divV, const std::function<Model::Vertex(float, float)>& func,
+		Model::Vertices& vertices, Model::Indices& indices)
+	{
+		unsigned long base = static_cast<unsigned long>(vertices.size());
+		for (int v = 0; v <= divV; ++v)
+			for (int u = 0; u <= divU; ++u)
+				vertices.push_back(func(static_cast<float>(u) / divU, static_cast<float>(v) / divV));
+
+		auto AddTriangle = [&](unsigned long a, unsigned long b, unsigned long c)
+		{
+			const DirectX::XMFLOAT3& pa = vertices[a].pos;
+			const DirectX::XMFLOAT3& pb = vertices[b].pos;
+			const DirectX::XMFLOAT3& pc = vertices[c].pos;
+			auto IsSame = [](const DirectX::XMFLOAT3& p, const DirectX::XMFLOAT3& q) { return p.x == q.x && p.y == q.y && p.z == q.z; };
+			if (IsSame(pa, pb) || IsSame(pb, pc) || IsSame(pc, pa)) { return; }
+			indices.insert(indices.end(), { a, b, c });
+		};
+		for (int v = 0; v < divV; ++v)
+		{
+			for (int u = 0; u < divU; ++u)
+			{
+				unsigned long i0 = base + v * (divU + 1) + u;
+				unsigned long i1 = i0 + 1;
+				unsigned long i2 = i0 + divU + 1;
+				unsigned long i3 = i2 + 1;
+				AddTriangle(i0, i2, i1);
+				AddTriangle(i1, i2, i3);
+			}
+		}
+	}
+
+	/*************************//*
+	@brief		| mFpbVOp`ɒ_`ɓWJĒǉ
+	@param[in]	| nameFbV
+	@param[in]	| verticesF_
+	@param[in]	| indicesFCfbNX
+	@param[in]	| randFOp`̕т
+	@param[out]	| outNamesFbV̒ǉ
+	@param[out]	| outMeshesFbV̒ǉ
+	@note		| assimpŒ_̌s킸ɓǂݍ񂾏ꍇƓAOp`̊pɒ_
+	*//*************************/
+	void AddReportSoup(const char* name, const Model::Vertices& vertices, const Model::Indices& indices, std::mt19937& rand,
+		std::vector<std::string>& outNames, Model::Meshes& outMeshes)
+	{
+		std::vector<size_t> order(indices.size() / 3);
+		std::iota(order.begin(), order.end(), 0);
+		std::shuffle(order.begin(), order.end(), rand);
+
+		Model::Mesh mesh = {};
+		for (size_t tri : order)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				mesh.indices.push_back(static_cast<unsigned long>(mesh.vertices.size()));
+				mesh.vertices.push_back(vertices[indices[tri * 3 + k]]);
+			}
+		}
+		outNames.push_back(name);
+		outMeshes.push_back(std::move(mesh));
+	}
+
+	/*************************//*
+	@brief		| Op`𒸓_̓eŔׂ`ɕׂ
+	@param[in]	| verticesF_
+	@param[in]	| indicesFCfbNX
+	@return		| Op`̒_̓e(̌ۂ܂ܐ擪𑵂AŜבւ
+	@note		| œK̑OŎOp`̏WςĂȂ̊mFɎg
+	*//*************************/
+	std::vector<std::string> MakeTriangleKeys(const Model::Vertices& vertices, const Model::Indices& indices)
+	{
+		std::vector<std::string> keys(indices.size() / 3);
+		for (size_t i = 0; i < keys.size(); ++i)
+		{
+			const char* corner[3];
+			for (int k = 0; k < 3; ++k)
+				corner[k] = reinterpret_cast<const char*>(&vertices[indices[i * 3 + k]]);
+
+			// eł_n߂
+			int first = 0;
+			for (int k = 1; k < 3; ++k)
+				if (std::memcmp(corner[k], corner[first], sizeof(Model::Vertex)) < 0) { first = k; }
+
+			std::string& key = keys[i];
+			for (int k = 0; k < 3; ++k)
+				key.append(corner[(first + k) % 3], sizeof(Model::Vertex));
+		}
+		std::sort(keys.begin(), keys.end());
+		return keys;
+	}
+}
+
+/*************************//*
+@brief		| ǂݍݎ̃bVœKmFp̃bVƃftH_̑St@CɍsAʂo
+@param[in]	| inReportPathFot@C̃pX
+@return		| 0: 1:s(ǂݍ߂Ȃt@CAOp`ςAACMR)
+*//*************************/
+int Model::MeasureOptimize(const char* inReportPath)
+{
+	std::ofstream report(inReportPath);
+	if (!report) { return 1; }
+
+	std::vector<std::string> names;
+	Meshes meshes;
+	std::string error;
+	bool isSuccess = MakeReportMeshes(names, meshes, error);
+	report << error;
+
+	char line[256];
+	report << "mesh                          tri     vtx before->after   ACMR before->after  VB KB before->after  IB KB before->after  check\n";
+
+	MeshOptimizeStats total = {};
+	float acmrBefore = 0.0f;
+	float acmrAfter = 0.0f;
+	size_t triTotal = 0;
+	for (size_t i = 0; i < meshes.size(); ++i)
+	{
+		Mesh& mesh = meshes[i];
+		std::vector<std::string> before = MakeTriangleKeys(mesh.vertices, mesh.indices);
+
+		// ǂݍݎƓœK
+		MeshOptimizeStats stats = {};
+		size_t vtxNum = MeshOptimizer::Optimize(mesh.vertices.data(), sizeof(Vertex), mesh.vertices.size(), mesh.indices, nullptr, &stats);
+		mesh.vertices.resize(vtxNum);
+
+		// Op`̏Wς炸A_̎QƂ͈͓ŁAACMRĂȂ
+		bool isValid = std::all_of(mesh.indices.begin(), mesh.indices.end(), [vtxNum](unsigned long idx) { return idx < vtxNum; });
+		isValid = isValid && MakeTriangleKeys(mesh.vertices, mesh.indices) == before;
+		isValid = isValid && stats.m_fACMRAfter <= stats.m_fACMRBefore && stats.m_nVtxCountAfter <= stats.m_nVtxCountBefore;
+		isSuccess &= isValid;
+
+		size_t triNum = mesh.indices.size() / 3;
+		sprintf_s(line, "%-28s %6zu  %7zu -> %-7zu  %5.3f -> %5.3f      %6zu -> %-6zu      %6zu -> %-6zu   %s\n",
+			names[i].c_str(), triNum, stats.m_nVtxCountBefore, stats.m_nVtxCountAfter, stats.m_fACMRBefore, stats.m_fACMRAfter,
+			stats.m_nVtxBytesBefore / 1024, stats.m_nVtxBytesAfter / 1024, stats.m_nIdxBytesBefore / 1024, stats.m_nIdxBytesAfter / 1024,
+			isValid ? "ok" : "FAILED");
+		report << line;
+
+		acmrBefore += stats.m_fACMRBefore * triNum;
+		acmrAfter += stats.m_fACMRAfter * triNum;
+		triTotal += triNum;
+		total.m_nVtxCountBefore += stats.m_nVtxCountBefore;
+		total.m_nVtxCountAfter += stats.m_nVtxCountAfter;
+		total.m_nVtxBytesBefore += stats.m_nVtxBytesBefore;
+		total.m_nVtxBytesAfter += stats.m_nVtxBytesAfter;
+		total.m_nIdxBytesBefore += stats.m_nIdxBytesBefore;
+		total.m_nIdxBytesAfter += stats.m_nIdxBytesAfter;
+	}
+
+	// ACMR͎Op`ŏdݕt
+	if (triTotal > 0)
+	{
+		acmrBefore /= triTotal;
+		acmrAfter /= triTotal;
+	}
+	sprintf_s(line, "%-28s %6zu  %7zu -> %-7zu  %5.3f -> %5.3f      %6zu -> %-6zu      %6zu -> %-6zu   %s\n",
+		"total", triTotal, total.m_nVtxCountBefore, total.m_nVtxCountAfter, acmrBefore, acmrAfter,
+		total.m_nVtxBytesBefore / 1024, total.m_nVtxBytesAfter / 1024, total.m_nIdxBytesBefore / 1024, total.m_nIdxBytesAfter / 1024,
+		isSuccess ? "ok" : "FAILED");
+	report << line;
+
+	return isSuccess ? 0 : 1;
+}
+
+/*************************//*
+@brief		| mFp̃bVƃftH_̑St@CLOD쐬ALOD̎Op`ƌ덷o
+@param[in]	| inReportPathFot@C̃pX
+@return		| 0: 1:s(ǂݍ߂Ȃt@CAOp`E덷̕тsA덷el𒴂)
+@note		| ǂݍݎƓœK̃bVLOD쐬
+*//*************************/
+int Model::MeasureLod(const char* inReportPath)
+{
+	std::ofstream report(inReportPath);
+	if (!report) { return 1; }
+
+	std::vector<std::string> names;
+	Meshes meshes;
+	std::string error;
+	bool isSuccess = MakeReportMeshes(names, meshes, error);
+	report << error;
+
+	char line[256];
+	sprintf_s(line, "target ratio %.3f %.3f %.3f %.3f  max error %.3f  min reduction %.2f\n",
+		LOD_TRIANGLE_RATIO[0], LOD_TRIANGLE_RATIO[1], LOD_TRIANGLE_RATIO[2], LOD_TRIANGLE_RATIO[3], LOD_MAX_ERROR, LOD_MIN_REDUCTION);
+	report << line;
+	report << "mesh                         lod     tri   ratio      error   rel error  check\n";
+
+	size_t lodTri[MAX_LOD] = {};
+	int lodNum[MAX_LOD] = {};
+	for (size_t i = 0; i < meshes.size(); ++i)
+	{
+		Mesh& mesh = meshes[i];
+
+		// ǂݍݎƓœKĂLOD쐬
+		size_t vtxNum = MeshOptimizer::Optimize(mesh.vertices.data(), sizeof(Vertex), mesh.vertices.size(), mesh.indices);
+		mesh.vertices.resize(vtxNum);
+		Indices lodIndices = mesh.indices;
+		mesh.lods = { { 0, static_cast<UINT>(mesh.indices.size()), 0.0f } };
+		MakeLod(mesh, lodIndices);
+
+		float meshScale = MeshSimplifier::CalcMeshScale(mesh.vertices.data(), sizeof(Vertex), mesh.vertices.size());
+		size_t baseTri = mesh.indices.size() / 3;
+		for (size_t lod = 0; lod < mesh.lods.size(); ++lod)
+		{
+			const MeshLod& info = mesh.lods[lod];
+			float relError = meshScale > 0.0f ? info.error / meshScale : 0.0f;
+
+			// LOD0͌덷ȂAȍ~͎Op`A덷͌炸Aelȓ
+			bool isValid = info.idxCount % 3 == 0 && info.idxStart + info.idxCount <= lodIndices.size();
+			if (lod == 0)
+			{
+				isValid = isValid && info.error == 0.0f && info.idxCount == mesh.indices.size();
+			}
+			else
+			{
+				const MeshLod& prev = mesh.lods[lod - 1];
+				isValid = isValid && info.idxCount < prev.idxCount && info.error >= prev.error && relError <= LOD_MAX_ERROR;
+			}
+
+			// _̎QƂ͈͓ŁAׂꂽOp`
+			for (UINT j = 0; isValid && j + 2 < info.idxCount; j += 3)
+			{
+				const unsigned long* tri = &lodIndices[info.idxStart + j];
+				isValid = tri[0] < vtxNum && tri[1] < vtxNum && tri[2] < vtxNum && tri[0] != tri[1] && tri[1] != tri[2] && tri[2] != tri[0];
+			}
+			isSuccess &= isValid;
+
+			size_t triNum = info.idxCount / 3;
+			sprintf_s(line, "%-28s %4zu  %6zu  %6.3f  %9.5f  %9.5f  %s\n",
+				lod == 0 ? names[i].c_str() : "", lod, triNum, baseTri > 0 ? static_cast<float>(triNum) / baseTri : 0.0f,
+				info.error, relError, isValid ? "ok" : "FAILED");
+			report << line;
+
+			lodTri[lod] += triNum;
+			lodNum[lod]++;
+		}
+	}
+
+	// LOD̍v(LODbV̂
+	for (UINT lod = 0; lod < MAX_LOD; ++lod)
+	{
+		sprintf_s(line, "total lod %u  meshes %4d  tri %8zu  ratio %6.3f\n",
+			lod, lodNum[lod], lodTri[lod], lodTri[0] > 0 ? static_cast<float>(lodTri[lod]) / lodTri[0] : 0.0f);
+		report << line;
+	}
+	report << (isSuccess ? "ok\n" : "FAILED\n");
+
+	return isSuccess ? 0 : 1;
+}
+
+/*************************//*
+@brief		| vp̃bVW߂
+@param[out]	| outNamesFbV
+@param[out]	| outMeshesFbV(œKO̒_ƃCfbNX̂
+@param[out]	| outErrorFǂݍ߂Ȃt@C
+@return		| true:Sēǂݍ߂ false:ǂݍ߂Ȃt@C
+@note		| ftH_łʂo悤AN̂nʁEEg[XE~擪ɉ
+*//*************************/
+bool Model::MakeReportMeshes(std::vector<std::string>& outNames, Meshes& outMeshes, std::string& outError)
+{
+	const float pi = DirectX::XM_PI;
+	std::mt19937 rand(REPORT_SEED);
+	Vertices vertices;
+	Indices indices;
+
+	// N̂n
+	AddReportSurface(REPORT_GRID_DIV, REPORT_GRID_DIV, [](float u, float v)
+		{
+			float x = (u - 0.5f) * 20.0f;
+			float z = (v - 0.5f) * 20.0f;
+			float y = 0.5f * sinf(x * 0.6f) * cosf(z * 0.45f);
+			DirectX::XMFLOAT3 normal(-0.3f * cosf(x * 0.6f) * cosf(z * 0.45f), 1.0f, 0.225f * sinf(x * 0.6f) * sinf(z * 0.45f));
+			float len = sqrtf(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+			return MakeReportVertex(DirectX::XMFLOAT3(x, y, z), DirectX::XMFLOAT3(normal.x / len, normal.y / len, normal.z / len), u * 8.0f, v * 8.0f);
+		}, vertices, indices);
+	AddReportSoup("[grid]", vertices, indices, rand, outNames, outMeshes);
+
+	// (ox01̌pڂŒ_)
+	vertices.clear();
+	indices.clear();
+	AddReportSurface(REPORT_SPHERE_SEGMENT, REPORT_SPHERE_RING, [pi](float u, float v)
+		{
+			float theta = u * 2.0f * pi;
+			float phi = v * pi;
+			DirectX::XMFLOAT3 normal(sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta));
+			return MakeReportVertex(normal, normal, u, v);
+		}, vertices, indices);
+	AddReportSoup("[sphere]", vertices, indices, rand, outNames, outMeshes);
+
+	// g[X
+	vertices.clear();
+	indices.clear();
+	AddReportSurface(REPORT_TORUS_SEGMENT, REPORT_TORUS_SIDE, [pi](float u, float v)
+		{
+			float theta = u * 2.0f * pi;
+			float phi = v * 2.0f * pi;
+			DirectX::XMFLOAT3 normal(cosf(phi) * cosf(theta), sinf(phi), cosf(phi) * sinf(theta));
+			DirectX::XMFLOAT3 pos((1.0f + 0.35f * cosf(phi)) * cosf(theta), 0.35f * sinf(phi), (1.0f + 0.35f * cosf(phi)) * sinf(theta));
+			return MakeReportVertex(pos, normal, u * 4.0f, v);
+		}, vertices, indices);
+	AddReportSoup("[torus]", vertices, indices, rand, outNames, outMeshes);
+
+	// ~(ʂƏ㉺̊WŖ@)
+	vertices.clear();
+	indices.clear();
+	AddReportSurface(REPORT_CYLINDER_SEGMENT, REPORT_CYLINDER_RING, [pi](float u, float v)
+		{
+			float theta = u * 2.0f * pi;
+			DirectX::XMFLOAT3 normal(cosf(theta), 0.0f, sinf(theta));
+			return MakeReportVertex(DirectX::XMFLOAT3(normal.x * 0.5f, v * 2.0f, normal.z * 0.5f), normal, u, v);
+		}, vertices, indices);
+	for (int cap = 0; cap < 2; ++cap)
+	{
+		float y = cap == 0 ? 0.0f : 2.0f;
+		DirectX::XMFLOAT3 normal(0.0f, cap == 0 ? -1.0f : 1.0f, 0.0f);
+		unsigned long center = static_cast<unsigned long>(vertices.size());
+		vertices.push_back(MakeReportVertex(DirectX::XMFLOAT3(0.0f, y, 0.0f), normal, 0.5f, 0.5f));
+		for (int i = 0; i < REPORT_CYLINDER_SEGMENT; ++i)
+		{
+			float theta = static_cast<float>(i) / REPORT_CYLINDER_SEGMENT * 2.0f * pi;
+			vertices.push_back(MakeReportVertex(DirectX::XMFLOAT3(cosf(theta) * 0.5f, y, sinf(theta) * 0.5f), normal, 0.5f + cosf(theta) * 0.5f, 0.5f + sinf(theta) * 0.5f));
+		}
+		for (int i = 0; i < REPORT_CYLINDER_SEGMENT; ++i)
+		{
+			unsigned long a = center + 1 + i;
+			unsigned long b = center + 1 + (i + 1) % REPORT_CYLINDER_SEGMENT;
+			if (cap == 0)
+				indices.insert(indices.end(), { center, a, b });
+			else
+				indices.insert(indices.end(), { center, b, a });
+		}
+	}
+	AddReportSoup("[cylinder]", vertices, indices, rand, outNames, outMeshes);
+
+	// ftH_̑St@C(ǂݍݎƓݒassimpʂ
+	bool isSuccess = true;
+	std::error_code ec;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(MODEL_PATH(""), ec))
+	{
+		if (!entry.is_regular_file()) { continue; }
+
+		std::string ext = entry.path().extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+		if (ext != ".fbx" && ext != ".obj" && ext != ".gltf" && ext != ".glb" && ext != ".dae") { continue; }
+
+		std::string path = entry.path().string();
+		Assimp::Importer importer;
+		const aiScene* pScene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
+		if (!pScene)
+		{
+			outError += "load failed: " + path + " " + importer.GetErrorString() + "\n";
+			isSuccess = false;
+			continue;
+		}
+
+		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i)
+		{
+			// [t܂ރbV͓ǂݍݎɂœKȂ
+			const aiMesh* assimpMesh = pScene->mMeshes[i];
+			if (assimpMesh->mNumAnimMeshes > 0) { continue; }
+
+			Mesh mesh = {};
+			mesh.vertices.resize(assimpMesh->mNumVertices);
+			for (unsigned int j = 0; j < assimpMesh->mNumVertices; ++j)
+			{
+				aiVector3D pos = assimpMesh->mVertices[j];
+				aiVector3D normal = assimpMesh->HasNormals() ? assimpMesh->mNormals[j] : aiVector3D(0.0f, 0.0f, 0.0f);
+				aiVector3D uv = assimpMesh->HasTextureCoords(0) ? assimpMesh->mTextureCoords[0][j] : aiVector3D(0.0f, 0.0f, 0.0f);
+				mesh.vertices[j] = MakeReportVertex(DirectX::XMFLOAT3(pos.x, pos.y, pos.z), DirectX::XMFLOAT3(normal.x, normal.y, normal.z), uv.x, uv.y);
+				if (assimpMesh->HasVertexColors(0))
+				{
+					aiColor4D color = assimpMesh->mColors[0][j];
+					mesh.vertices[j].color = DirectX::XMFLOAT4(color.r, color.g, color.b, color.a);
+				}
+			}
+			for (unsigned int j = 0; j < assimpMesh->mNumFaces; ++j)
+			{
+				const aiFace& face = assimpMesh->mFaces[j];
+				if (face.mNumIndices != 3) { continue; }
+				mesh.indices.insert(mesh.indices.end(), { face.mIndices[0], face.mIndices[1], face.mIndices[2] });
+			}
+			outNames.push_back(entry.path().filename().string() + ":" + assimpMesh->mName.C_Str());
+			outMeshes.push_back(std::move(mesh));
+		}
+	}
+	return isSuccess;
+}
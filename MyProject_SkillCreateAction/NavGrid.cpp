@@ -0,0 +1,282 @@
+/**************************************************//*
+	@file	| NavGrid.cpp
+	@brief	| ナビゲーショングリッドクラスのcppファイル
+	@note	| フィールドの平面(XZ)を正方形のセルに分割し、
+			| 静的なコリジョンが占めるセルを通れないセルとして記録する
+			| 経路探索はCPathFinderで行い、このクラスは通れるかどうかの判定だけを持つ
+*//**************************************************/
+#include "NavGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CNavGrid::CNavGrid()
+	: m_fMinX(0.0f)
+	, m_fMinZ(0.0f)
+	, m_fCellSize(1.0f)
+	, m_nWidth(0)
+	, m_nHeight(0)
+	, m_nBlockedNum(0)
+	, m_nRegionNum(0)
+{
+}
+
+/****************************************//*
+	@brief　	| 全てのセルを通れる状態で初期化する
+	@param　	| inMinX：左端のX座標
+	@param　	| inMinZ：手前のZ座標
+	@param　	| inWidth：X方向のセル数
+	@param　	| inHeight：Z方向のセル数
+	@param　	| inCellSize：セル1つの大きさ
+*//****************************************/
+void CNavGrid::Init(float inMinX, float inMinZ, uint32_t inWidth, uint32_t inHeight, float inCellSize)
+{
+	m_fMinX = inMinX;
+	m_fMinZ = inMinZ;
+	m_fCellSize = inCellSize;
+	m_nWidth = inWidth;
+	m_nHeight = inHeight;
+	m_nBlockedNum = 0;
+
+	// 外周だけを通れないセルにする
+	m_BlockedVec.assign(static_cast<size_t>(inWidth + 2) * (inHeight + 2), 1);
+	for (uint32_t y = 0; y < inHeight; y++)
+	{
+		std::fill_n(m_BlockedVec.begin() + GetPaddedIndex(0, static_cast<int>(y)), inWidth, static_cast<uint8_t>(0));
+	}
+
+	// 障害物が無ければ全体で1つの領域
+	m_nRegionNum = (inWidth * inHeight > 0) ? 1 : 0;
+	m_RegionVec.assign(static_cast<size_t>(inWidth) * inHeight, 0);
+}
+
+/****************************************//*
+	@brief　	| 障害物を書き込む
+	@param　	| inCenter：中心座標
+	@param　	| inHalfSize：XZそれぞれの半分の大きさ
+	@param　	| inYaw：Y軸回転(ラジアン)
+	@param　	| inMargin：広げる幅(移動するキャラクターの半径)
+*//****************************************/
+void CNavGrid::AddObstacle(const NavPoint& inCenter, const NavPoint& inHalfSize, float inYaw, float inMargin)
+{
+	if (m_nWidth == 0 || m_nHeight == 0) return;
+
+	float fHalfX = inHalfSize.m_fX + inMargin;
+	float fHalfZ = inHalfSize.m_fZ + inMargin;
+	float fCos = cosf(inYaw);
+	float fSin = sinf(inYaw);
+
+	// 回転した箱を囲むAABBの範囲のセルだけを調べる
+	float fExtentX = fabsf(fCos) * fHalfX + fabsf(fSin) * fHalfZ;
+	float fExtentZ = fabsf(fSin) * fHalfX + fabsf(fCos) * fHalfZ;
+	int nMinX, nMinY, nMaxX, nMaxY;
+	WorldToCell({ inCenter.m_fX - fExtentX, inCenter.m_fZ - fExtentZ }, nMinX, nMinY);
+	WorldToCell({ inCenter.m_fX + fExtentX, inCenter.m_fZ + fExtentZ }, nMaxX, nMaxY);
+
+	for (int y = nMinY; y <= nMaxY; y++)
+	{
+		for (int x = nMinX; x <= nMaxX; x++)
+		{
+			// セルの中心を箱のローカル座標に直して内外を判定する(XMMatrixRotationYと同じ向き)
+			NavPoint tPos = CellToWorld(x, y);
+			float fDx = tPos.m_fX - inCenter.m_fX;
+			float fDz = tPos.m_fZ - inCenter.m_fZ;
+			float fLocalX = fDx * fCos - fDz * fSin;
+			float fLocalZ = fDx * fSin + fDz * fCos;
+			if (fabsf(fLocalX) > fHalfX || fabsf(fLocalZ) > fHalfZ) continue;
+
+			SetBlocked(static_cast<uint32_t>(x), static_cast<uint32_t>(y), true);
+		}
+	}
+}
+
+/****************************************//*
+	@brief　	| セルの通れるかどうかを設定する
+	@param　	| inX：X方向のセル番号
+	@param　	| inY：Z方向のセル番号
+	@param　	| isBlocked：true:通れない false:通れる
+*//****************************************/
+void CNavGrid::SetBlocked(uint32_t inX, uint32_t inY, bool isBlocked)
+{
+	if (inX >= m_nWidth || inY >= m_nHeight) return;
+
+	uint8_t& nCell = m_BlockedVec[GetPaddedIndex(static_cast<int>(inX), static_cast<int>(inY))];
+	if (nCell == (isBlocked ? 1 : 0)) return;
+
+	nCell = isBlocked ? 1 : 0;
+	if (isBlocked) m_nBlockedNum++;
+	else m_nBlockedNum--;
+}
+
+/****************************************//*
+	@brief　	| 繋がっているセル同士に同じ領域番号を振る
+*//****************************************/
+void CNavGrid::BuildRegions()
+{
+	m_RegionVec.assign(static_cast<size_t>(m_nWidth) * m_nHeight, ce_nNoRegion);
+	m_nRegionNum = 0;
+
+	// 斜め移動は隣接する上下左右が通れる場合だけなので、上下左右で繋がっていれば到達できる
+	std::vector<uint32_t> tStack;
+	for (size_t i = 0; i < m_RegionVec.size(); i++)
+	{
+		int nStartX = static_cast<int>(i % m_nWidth);
+		int nStartY = static_cast<int>(i / m_nWidth);
+		if (!IsWalkable(nStartX, nStartY) || m_RegionVec[i] != ce_nNoRegion) continue;
+
+		m_RegionVec[i] = m_nRegionNum;
+		tStack.push_back(static_cast<uint32_t>(i));
+		while (!tStack.empty())
+		{
+			uint32_t nCell = tStack.back();
+			tStack.pop_back();
+			int nX = static_cast<int>(nCell % m_nWidth);
+			int nY = static_cast<int>(nCell / m_nWidth);
+
+			static const int ce_nOffset[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+			for (const auto& tOffset : ce_nOffset)
+			{
+				int nNextX = nX + tOffset[0];
+				int nNextY = nY + tOffset[1];
+				if (!IsWalkable(nNextX, nNextY)) continue;
+
+				size_t nNext = static_cast<size_t>(nNextY) * m_nWidth + nNextX;
+				if (m_RegionVec[nNext] != ce_nNoRegion) continue;
+				m_RegionVec[nNext] = m_nRegionNum;
+				tStack.push_back(static_cast<uint32_t>(nNext));
+			}
+		}
+		m_nRegionNum++;
+	}
+}
+
+/****************************************//*
+	@brief　	| セルの領域番号の取得
+	@param　	| inX：X方向のセル番号
+	@param　	| inY：Z方向のセル番号
+	@return		| 領域番号(通れないセルはce_nNoRegion)
+*//****************************************/
+uint32_t CNavGrid::GetRegion(int inX, int inY) const
+{
+	if (!IsWalkable(inX, inY)) return ce_nNoRegion;
+	return m_RegionVec[static_cast<size_t>(inY) * m_nWidth + inX];
+}
+
+/****************************************//*
+	@brief　	| 座標からセル番号を求める
+	@param　	| inPos：座標
+	@param　	| outX：X方向のセル番号
+	@param　	| outY：Z方向のセル番号
+	@return		| true:グリッドの範囲内 false:範囲外(範囲内に丸めた番号を返す)
+*//****************************************/
+bool CNavGrid::WorldToCell(const NavPoint& inPos, int& outX, int& outY) const
+{
+	int nX = static_cast<int>(floorf((inPos.m_fX - m_fMinX) / m_fCellSize));
+	int nY = static_cast<int>(floorf((inPos.m_fZ - m_fMinZ) / m_fCellSize));
+	bool bInside = nX >= 0 && nY >= 0 && nX < static_cast<int>(m_nWidth) && nY < static_cast<int>(m_nHeight);
+
+	outX = (std::max)(0, (std::min)(nX, static_cast<int>(m_nWidth) - 1));
+	outY = (std::max)(0, (std::min)(nY, static_cast<int>(m_nHeight) - 1));
+	return bInside;
+}
+
+/****************************************//*
+	@brief　	| セルの中心座標を求める
+	@param　	| inX：X方向のセル番号
+	@param　	| inY：Z方向のセル番号
+	@return		| 中心座標
+*//****************************************/
+NavPoint CNavGrid::CellToWorld(int inX, int inY) const
+{
+	return { m_fMinX + (static_cast<float>(inX) + 0.5f) * m_fCellSize,
+		m_fMinZ + (static_cast<float>(inY) + 0.5f) * m_fCellSize };
+}
+
+/****************************************//*
+	@brief　	| 最も近い通れるセルを探す
+	@param　	| ioX：X方向のセル番号(見つかったセルで上書きする)
+	@param　	| ioY：Z方向のセル番号(見つかったセルで上書きする)
+	@param　	| inMaxRadius：探す範囲(セル数)
+	@return		| true:見つかった false:範囲内に無い
+*//****************************************/
+bool CNavGrid::FindNearestWalkable(int& ioX, int& ioY, int inMaxRadius) const
+{
+	if (IsWalkable(ioX, ioY)) return true;
+
+	// 内側の輪から順に調べ、最初に見つかった輪の中で一番近いセルを選ぶ
+	for (int nRadius = 1; nRadius <= inMaxRadius; nRadius++)
+	{
+		int nBestX = 0, nBestY = 0, nBestDist = INT32_MAX;
+		for (int y = -nRadius; y <= nRadius; y++)
+		{
+			// 輪の上下の辺は全て、それ以外は左右の端だけを調べる
+			int nStep = (y == -nRadius || y == nRadius) ? 1 : nRadius * 2;
+			for (int x = -nRadius; x <= nRadius; x += nStep)
+			{
+				if (!IsWalkable(ioX + x, ioY + y)) continue;
+				int nDist = x * x + y * y;
+				if (nDist >= nBestDist) continue;
+				nBestDist = nDist;
+				nBestX = ioX + x;
+				nBestY = ioY + y;
+			}
+		}
+		if (nBestDist != INT32_MAX)
+		{
+			ioX = nBestX;
+			ioY = nBestY;
+			return true;
+		}
+	}
+	return false;
+}
+
+/****************************************//*
+	@brief　	| 2つのセルの中心を結ぶ線分が通れないセルを横切らないか
+	@param　	| inX0：始点のX方向のセル番号
+	@param　	| inY0：始点のZ方向のセル番号
+	@param　	| inX1：終点のX方向のセル番号
+	@param　	| inY1：終点のZ方向のセル番号
+	@return		| true:横切らない false:横切る
+*//****************************************/
+bool CNavGrid::HasLineOfSight(int inX0, int inY0, int inX1, int inY1) const
+{
+	if (!IsWalkable(inX0, inY0)) return false;
+
+	int nDx = std::abs(inX1 - inX0);
+	int nDy = std::abs(inY1 - inY0);
+	int nStepX = (inX1 > inX0) ? 1 : -1;
+	int nStepY = (inY1 > inY0) ? 1 : -1;
+	int nX = inX0, nY = inY0;
+
+	// 線分が次に横切るのが縦の境界か横の境界かを整数で判定しながら、通るセルを全て辿る
+	for (int nIx = 0, nIy = 0; nIx < nDx || nIy < nDy;)
+	{
+		int nDecision = (1 + 2 * nIx) * nDy - (1 + 2 * nIy) * nDx;
+		if (nDecision == 0)
+		{
+			// 格子点をちょうど通る場合は両側のセルが通れないと角をすり抜けることになる
+			if (!IsWalkable(nX + nStepX, nY) || !IsWalkable(nX, nY + nStepY)) return false;
+			nX += nStepX;
+			nY += nStepY;
+			nIx++;
+			nIy++;
+		}
+		else if (nDecision < 0)
+		{
+			nX += nStepX;
+			nIx++;
+		}
+		else
+		{
+			nY += nStepY;
+			nIy++;
+		}
+
+		if (!IsWalkable(nX, nY)) return false;
+	}
+	return true;
+}
@@ -0,0 +1,165 @@
+/**************************************************//*
+	@file	| NavGrid.h
+	@brief	| ナビゲーショングリッドクラスのhファイル
+	@note	| フィールドの平面(XZ)を正方形のセルに分割し、
+			| 静的なコリジョンが占めるセルを通れないセルとして記録する
+			| 経路探索はCPathFinderで行い、このクラスは通れるかどうかの判定だけを持つ
+*//**************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// @brief 平面上の座標
+struct NavPoint
+{
+	// X座標
+	float m_fX;
+
+	// Z座標
+	float m_fZ;
+};
+
+// @brief ナビゲーショングリッドクラス
+class CNavGrid
+{
+public:
+	// @brief 到達できる領域が無いセルの領域番号
+	static constexpr uint32_t ce_nNoRegion = UINT32_MAX;
+
+public:
+	// @brief コンストラクタ
+	CNavGrid();
+
+	// @brief 全てのセルを通れる状態で初期化する
+	// @param inMinX：左端のX座標
+	// @param inMinZ：手前のZ座標
+	// @param inWidth：X方向のセル数
+	// @param inHeight：Z方向のセル数
+	// @param inCellSize：セル1つの大きさ
+	void Init(float inMinX, float inMinZ, uint32_t inWidth, uint32_t inHeight, float inCellSize);
+
+	// @brief 障害物を書き込む
+	// @param inCenter：中心座標
+	// @param inHalfSize：XZそれぞれの半分の大きさ
+	// @param inYaw：Y軸回転(ラジアン)
+	// @param inMargin：広げる幅(移動するキャラクターの半径)
+	// @note 中心が障害物の内側に入るセルを通れないセルにする
+	void AddObstacle(const NavPoint& inCenter, const NavPoint& inHalfSize, float inYaw, float inMargin);
+
+	// @brief セルの通れるかどうかを設定する
+	// @param inX：X方向のセル番号
+	// @param inY：Z方向のセル番号
+	// @param isBlocked：true:通れない false:通れる
+	void SetBlocked(uint32_t inX, uint32_t inY, bool isBlocked);
+
+	// @brief 繋がっているセル同士に同じ領域番号を振る
+	// @note 障害物を書き込み終えた後に1回呼ぶ
+	//       領域番号が異なるセル同士は探索せずに到達できないと判定できる
+	void BuildRegions();
+
+	// @brief セルが通れるか
+	// @param inX：X方向のセル番号
+	// @param inY：Z方向のセル番号
+	// @return true:通れる false:通れない、または範囲外
+	bool IsWalkable(int inX, int inY) const
+	{
+		if (inX < 0 || inY < 0 || inX >= static_cast<int>(m_nWidth) || inY >= static_cast<int>(m_nHeight)) return false;
+		return m_BlockedVec[GetPaddedIndex(inX, inY)] == 0;
+	}
+
+	// @brief 外周に通れないセルを1列足したセル配列の取得
+	// @return セル毎の通れないかどうか(1:通れない)
+	// @note 範囲内のセルから1つ隣までは範囲を確かめずに読めるため、直線の走査に使う
+	const uint8_t* GetPaddedCells() const { return m_BlockedVec.data(); }
+
+	// @brief 外周を含めた1行分の要素数の取得
+	int GetPaddedStride() const { return static_cast<int>(m_nWidth) + 2; }
+
+	// @brief 外周を含めたセル配列の番号を求める
+	// @param inX：X方向のセル番号(-1～横幅)
+	// @param inY：Z方向のセル番号(-1～縦幅)
+	// @return セル配列の番号
+	size_t GetPaddedIndex(int inX, int inY) const
+	{
+		return static_cast<size_t>(inY + 1) * (m_nWidth + 2) + static_cast<size_t>(inX + 1);
+	}
+
+	// @brief セルの領域番号の取得
+	// @param inX：X方向のセル番号
+	// @param inY：Z方向のセル番号
+	// @return 領域番号(通れないセルはce_nNoRegion)
+	uint32_t GetRegion(int inX, int inY) const;
+
+	// @brief 座標からセル番号を求める
+	// @param inPos：座標
+	// @param outX：X方向のセル番号
+	// @param outY：Z方向のセル番号
+	// @return true:グリッドの範囲内 false:範囲外(範囲内に丸めた番号を返す)
+	bool WorldToCell(const NavPoint& inPos, int& outX, int& outY) const;
+
+	// @brief セルの中心座標を求める
+	// @param inX：X方向のセル番号
+	// @param inY：Z方向のセル番号
+	// @return 中心座標
+	NavPoint CellToWorld(int inX, int inY) const;
+
+	// @brief 最も近い通れるセルを探す
+	// @param ioX：X方向のセル番号(見つかったセルで上書きする)
+	// @param ioY：Z方向のセル番号(見つかったセルで上書きする)
+	// @param inMaxRadius：探す範囲(セル数)
+	// @return true:見つかった false:範囲内に無い
+	bool FindNearestWalkable(int& ioX, int& ioY, int inMaxRadius) const;
+
+	// @brief 2つのセルの中心を結ぶ線分が通れないセルを横切らないか
+	// @param inX0：始点のX方向のセル番号
+	// @param inY0：始点のZ方向のセル番号
+	// @param inX1：終点のX方向のセル番号
+	// @param inY1：終点のZ方向のセル番号
+	// @return true:横切らない false:横切る
+	// @note 線分が格子点を通る場合は、角をすり抜けないよう両側のセルを調べる
+	bool HasLineOfSight(int inX0, int inY0, int inX1, int inY1) const;
+
+	// @brief X方向のセル数の取得
+	uint32_t GetWidth() const { return m_nWidth; }
+
+	// @brief Z方向のセル数の取得
+	uint32_t GetHeight() const { return m_nHeight; }
+
+	// @brief セル1つの大きさの取得
+	float GetCellSize() const { return m_fCellSize; }
+
+	// @brief 通れないセルの数の取得
+	uint32_t GetBlockedNum() const { return m_nBlockedNum; }
+
+	// @brief 領域の数の取得
+	uint32_t GetRegionNum() const { return m_nRegionNum; }
+
+private:
+	// @brief 左端のX座標
+	float m_fMinX;
+
+	// @brief 手前のZ座標
+	float m_fMinZ;
+
+	// @brief セル1つの大きさ
+	float m_fCellSize;
+
+	// @brief X方向のセル数
+	uint32_t m_nWidth;
+
+	// @brief Z方向のセル数
+	uint32_t m_nHeight;
+
+	// @brief 通れないセルの数
+	uint32_t m_nBlockedNum;
+
+	// @brief 領域の数
+	uint32_t m_nRegionNum;
+
+	// @brief セル毎の通れないかどうか(1:通れない、外周に通れないセルを1列足す)
+	std::vector<uint8_t> m_BlockedVec;
+
+	// @brief セル毎の領域番号
+	std::vector<uint32_t> m_RegionVec;
+};
@@ -5,19 +5,30 @@
 *//**************************************************/
 #include "ObjectLoad.h"
 #include "RendererComponent.h"
+#include "AssetRegistry.h"
+#include "JobSystem.h"
 #include "Defines.h"
+#include <filesystem>
+#include <algorithm>
+#include <fstream>
 
 /*****************************************//*
 	@brief@	| SẴIuWFNg[h
 *//****************************************/
 void CObjectLoad::LoadAll()
 {
-	// tF[hpeNX`̃[h
-    CRendererComponent::Load(RendererKind::Texture, TEXTURE_PATH("Fade.png"), "Fade");
-	// nʗpeNX`̃[h
-	CRendererComponent::Load(RendererKind::Texture, TEXTURE_PATH("Field.png"), "Field");
-	// vC[peNX`̃[h
-	CRendererComponent::Load(RendererKind::Texture, TEXTURE_PATH("Player.png"), "Player");
+	std::vector<AssetRequest> tRequestVec =
+	{
+		// tF[hpeNX`̃[h
+		{ RendererKind::Texture, TEXTURE_PATH("Fade.png"), "Fade", 1.0f, Model::Flip::None },
+		// nʗpeNX`̃[h
+		{ RendererKind::Texture, TEXTURE_PATH("Field.png"), "Field", 1.0f, Model::Flip::None },
+		// vC[peNX`̃[h
+		{ RendererKind::Texture, TEXTURE_PATH("Player.png"), "Player", 1.0f, Model::Flip::None },
+	};
+
+	// t@Cɕœǂݍ
+	CAssetRegistry::GetInstance()->RegisterAll(tRequestVec);
 }
 
 
@@ -28,3 +39,116 @@ void CObjectLoad::UnLoadAll()
 {
     CRendererComponent::UnLoad();
 }
+
+/*****************************************//*
+	@brief@	| ftH_̑St@C1XbhƑSXbhœǂݍ݁A|Ԃv
+	@return@	| v
+*//****************************************/
+ImportBenchmark CObjectLoad::BenchmarkImport()
+{
+	ImportBenchmark tResult{};
+
+	// ftH_̓ǂݍ߂t@CW߂
+	std::vector<std::string> sPathVec;
+	std::error_code ec;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(MODEL_PATH(""), ec))
+	{
+		if (!entry.is_regular_file()) continue;
+
+		std::string sExt = entry.path().extension().string();
+		std::transform(sExt.begin(), sExt.end(), sExt.begin(), [](char c) { return static_cast<char>(tolower(c)); });
+		if (sExt == ".fbx" || sExt == ".obj" || sExt == ".gltf" || sExt == ".glb" || sExt == ".dae")
+		{
+			sPathVec.push_back(entry.path().string());
+		}
+	}
+	tResult.m_nFileNum = static_cast<int>(sPathVec.size());
+	if (sPathVec.empty()) return tResult;
+
+	// 1XbhƑSXbhŌvÃXbhɖ߂
+	CJobSystem* pJobSystem = CJobSystem::GetInstance();
+	unsigned int nOriginThreadNum = pJobSystem->GetThreadNum();
+	int nSingleFail = 0;
+	int nMultiFail = 0;
+	tResult.m_dSingleMs = MeasureImport(sPathVec, 1, nSingleFail);
+	tResult.m_dMultiMs = MeasureImport(sPathVec, 0, nMultiFail);
+	tResult.m_nFailNum = (std::max)(nSingleFail, nMultiFail);
+	tResult.m_nThreadNum = pJobSystem->GetThreadNum();
+	pJobSystem->SetThreadNum(nOriginThreadNum);
+
+	return tResult;
+}
+
+/*****************************************//*
+	@brief@	| ftH_̃t@Cǂݍ݁A|Ԃv
+	@param@	| inPathVecFǂݍރt@C̃pX
+	@param@	| inThreadNumFgp郏[J[Xbh(0CPŨXbh)
+	@param@	| outFailNumFǂݍ݂Ɏst@C
+	@return@	| ǂݍݎ(~b)
+*//****************************************/
+double CObjectLoad::MeasureImport(const std::vector<std::string>& inPathVec, unsigned int inThreadNum, int& outFailNum)
+{
+	CJobSystem* pJobSystem = CJobSystem::GetInstance();
+	pJobSystem->SetThreadNum(inThreadNum);
+
+	LARGE_INTEGER freq, start, end;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&start);
+
+	// vpɓǂݍ񂾃f͓o^ɂj
+	std::vector<Model*> pModelVec(inPathVec.size(), nullptr);
+	std::vector<char> bResultVec(inPathVec.size(), 0);
+	for (size_t i = 0; i < inPathVec.size(); i++)
+	{
+		pJobSystem->Submit([&inPathVec, &pModelVec, &bResultVec, i]()
+			{
+				pModelVec[i] = new(std::nothrow) Model();
+				bResultVec[i] = (pModelVec[i] && pModelVec[i]->Load(inPathVec[i].c_str())) ? 1 : 0;
+			});
+	}
+	pJobSystem->WaitAll();
+
+	QueryPerformanceCounter(&end);
+
+	outFailNum = static_cast<int>(std::count(bResultVec.begin(), bResultVec.end(), 0));
+
+	for (Model* pModel : pModelVec)
+	{
+		SAFE_DELETE(pModel);
+	}
+
+	return static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(freq.QuadPart);
+}
+
+/*****************************************//*
+	@brief@	| BenchmarkImporťʂt@Cɏo
+	@param@	| inReportPathFot@C̃pX
+	@return@	| 0:SẴt@Cǂݍ߂ 1:ǂݍ߂Ȃt@C
+	@note		| f̓ǂݍ݂ɃfoCXKvȂ߁AɌĂ
+*//****************************************/
+int CObjectLoad::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	ImportBenchmark tResult = BenchmarkImport();
+	char szLine[256];
+	if (tResult.m_nFileNum == 0)
+	{
+		sprintf_s(szLine, "no model files in %s\n", MODEL_PATH(""));
+		tReport << szLine;
+		return 0;
+	}
+
+	sprintf_s(szLine, "files %d  failed %d\n", tResult.m_nFileNum, tResult.m_nFailNum);
+	tReport << szLine;
+	sprintf_s(szLine, "1 thread   %9.1f ms\n", tResult.m_dSingleMs);
+	tReport << szLine;
+	sprintf_s(szLine, "%-2u threads %9.1f ms  x%.2f\n", tResult.m_nThreadNum, tResult.m_dMultiMs,
+		tResult.m_dMultiMs > 0.0 ? tResult.m_dSingleMs / tResult.m_dMultiMs : 0.0);
+	tReport << szLine;
+
+	bool bSuccess = tResult.m_nFailNum == 0;
+	tReport << (bSuccess ? "ok\n" : "FAILED\n");
+	return bSuccess ? 0 : 1;
+}
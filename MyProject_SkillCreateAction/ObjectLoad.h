@@ -4,15 +4,55 @@
 	@note	| IuWFNg̃[hAA[hs
 *//**************************************************/
 #pragma once
+#include <vector>
+#include <string>
+
+// @brief fǂݍ݂̌v
+struct ImportBenchmark
+{
+	// ǂݍ񂾃t@C
+	int m_nFileNum;
+
+	// ǂݍ݂̃Xbh
+	unsigned int m_nThreadNum;
+
+	// 1Xbhł̓ǂݍݎ(~b)
+	double m_dSingleMs;
+
+	// ł̓ǂݍݎ(~b)
+	double m_dMultiMs;
+
+	// ǂݍ݂Ɏst@C
+	int m_nFailNum;
+};
 
 // @brief IuWFNg[hNX
 class CObjectLoad
 {
 public:
 	// @brief SẴIuWFNg[h
+	// @note WuVXeŕɓǂݍ
     static void LoadAll();
 
 	// @brief SẴIuWFNgA[h
     static void UnLoadAll();
 
+	// @brief ftH_̑St@C1XbhƑSXbhœǂݍ݁A|Ԃv
+	// @return v
+	static ImportBenchmark BenchmarkImport();
+
+	// @brief BenchmarkImporťʂt@Cɏo
+	// @param inReportPathFot@C̃pX
+	// @return 0:SẴt@Cǂݍ߂ 1:ǂݍ߂Ȃt@C
+	// @note f̓ǂݍ݂ɃfoCXKvȂ߁AɌĂ
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief ftH_̃t@Cǂݍ݁A|Ԃv
+	// @param inPathVecFǂݍރt@C̃pX
+	// @param inThreadNumFgp郏[J[Xbh
+	// @param outFailNumFǂݍ݂Ɏst@C
+	// @return ǂݍݎ(~b)
+	static double MeasureImport(const std::vector<std::string>& inPathVec, unsigned int inThreadNum, int& outFailNum);
+
 };
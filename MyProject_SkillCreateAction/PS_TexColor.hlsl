@@ -1,3 +1,11 @@
+// 機能の定義(シェーダーキャッシュがバリエーション毎に0か1を指定する)
+#ifndef ALPHA_TEST
+#define ALPHA_TEST 0
+#endif
+
+// 切り抜くアルファ値の基準
+#define ALPHA_REF 0.5f
+
 struct PS_IN
 {
     float4 pos : SV_POSITION;
@@ -11,5 +19,9 @@ SamplerState samp : register(s0);
 
 float4 main(PS_IN pin) : SV_TARGET
 {
-    return tex.Sample(samp, pin.uv);
+    float4 color = tex.Sample(samp, pin.uv);
+#if ALPHA_TEST
+    clip(color.a - ALPHA_REF);
+#endif
+    return color;
 }
@@ -0,0 +1,405 @@
+/**************************************************//*
+	@file	| PathFinder.cpp
+	@brief	| 経路探索クラスのcppファイル
+	@note	| ナビゲーショングリッド上でA*、またはJPS(Jump Point Search)により経路を求め、
+			| 見通しの通る経由点を省いて滑らかにする
+			| 探索に使うノードとオープンリストは探索の度に確保し直さず使い回すため、
+			| 1つのインスタンスを同時に複数のスレッドから使ってはいけない
+*//**************************************************/
+#include "PathFinder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+
+namespace
+{
+	// @brief 斜め移動のコスト
+	constexpr float ce_fDiagonalCost = 1.41421356f;
+
+	// @brief オープンリストの比較(推定コストが小さい方を先頭にする)
+	struct OpenGreater
+	{
+		template<class T>
+		bool operator()(const T& inA, const T& inB) const
+		{
+			if (inA.m_fF != inB.m_fF) return inA.m_fF > inB.m_fF;
+			return inA.m_fH > inB.m_fH;
+		}
+	};
+
+	// @brief 符号
+	int Sign(int inValue)
+	{
+		return (inValue > 0) - (inValue < 0);
+	}
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CPathFinder::CPathFinder()
+	: m_nStamp(0)
+	, m_nWidth(0)
+	, m_nGoal(ce_nInvalid)
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| 経路を求める
+	@param　	| inGrid：ナビゲーショングリッド(BuildRegions済み)
+	@param　	| inStart：始点
+	@param　	| inGoal：終点
+	@param　	| outPath：経由点(始点と終点を含む)
+	@param　	| inAlgorithm：アルゴリズム
+	@param　	| isSmooth：見通しの通る経由点を省くか
+	@return		| true:経路が見つかった false:到達できない
+*//****************************************/
+bool CPathFinder::FindPath(const CNavGrid& inGrid, const NavPoint& inStart, const NavPoint& inGoal,
+	std::vector<NavPoint>& outPath, PathAlgorithm inAlgorithm, bool isSmooth)
+{
+	outPath.clear();
+	m_tStats = {};
+	if (inGrid.GetWidth() == 0 || inGrid.GetHeight() == 0) return false;
+
+	// 始点と終点が障害物の中にある場合は最寄りの通れるセルから探す
+	int nStartX, nStartY, nGoalX, nGoalY;
+	inGrid.WorldToCell(inStart, nStartX, nStartY);
+	bool bGoalInside = inGrid.WorldToCell(inGoal, nGoalX, nGoalY);
+	bool bGoalWalkable = bGoalInside && inGrid.IsWalkable(nGoalX, nGoalY);
+	if (!inGrid.FindNearestWalkable(nStartX, nStartY, ce_nSnapRadius)) return false;
+	if (!inGrid.FindNearestWalkable(nGoalX, nGoalY, ce_nSnapRadius)) return false;
+
+	// 繋がっていない領域同士は探索するまでもなく到達できない
+	if (inGrid.GetRegion(nStartX, nStartY) != inGrid.GetRegion(nGoalX, nGoalY)) return false;
+
+	m_nWidth = static_cast<int>(inGrid.GetWidth());
+	uint32_t nStart = static_cast<uint32_t>(nStartY * m_nWidth + nStartX);
+	uint32_t nGoal = static_cast<uint32_t>(nGoalY * m_nWidth + nGoalX);
+	if (nStart == nGoal)
+	{
+		m_CellPathVec.assign(1, nStart);
+	}
+	else if (!Search(inGrid, nStart, nGoal, inAlgorithm))
+	{
+		return false;
+	}
+	m_tStats.m_nRawPointNum = static_cast<int>(m_CellPathVec.size());
+
+	if (isSmooth) Smooth(inGrid);
+
+	// セル番号を座標に直し、両端は実際の始点と終点に置き換える
+	outPath.reserve(m_CellPathVec.size() + 1);
+	outPath.push_back(inStart);
+	for (size_t i = 1; i < m_CellPathVec.size(); i++)
+	{
+		int nCell = static_cast<int>(m_CellPathVec[i]);
+		outPath.push_back(inGrid.CellToWorld(nCell % m_nWidth, nCell / m_nWidth));
+	}
+	if (bGoalWalkable)
+	{
+		if (outPath.size() > 1) outPath.back() = inGoal;
+		else outPath.push_back(inGoal);
+	}
+	else if (outPath.size() == 1)
+	{
+		outPath.push_back(inGrid.CellToWorld(nGoalX, nGoalY));
+	}
+	m_tStats.m_nPointNum = static_cast<int>(outPath.size());
+	return true;
+}
+
+/****************************************//*
+	@brief　	| セル同士の推定コスト(8方向移動の距離)
+	@param　	| inDx：X方向の差
+	@param　	| inDy：Z方向の差
+	@return		| 推定コスト
+*//****************************************/
+float CPathFinder::Octile(int inDx, int inDy)
+{
+	int nDx = std::abs(inDx);
+	int nDy = std::abs(inDy);
+	int nMin = (std::min)(nDx, nDy);
+	int nMax = (std::max)(nDx, nDy);
+	return static_cast<float>(nMax - nMin) + ce_fDiagonalCost * static_cast<float>(nMin);
+}
+
+/****************************************//*
+	@brief　	| 始点のセルから終点のセルまで探索する
+	@param　	| inGrid：ナビゲーショングリッド
+	@param　	| inStart：始点のセル番号
+	@param　	| inGoal：終点のセル番号
+	@param　	| inAlgorithm：アルゴリズム
+	@return		| true:見つかった false:見つからない
+*//****************************************/
+bool CPathFinder::Search(const CNavGrid& inGrid, uint32_t inStart, uint32_t inGoal, PathAlgorithm inAlgorithm)
+{
+	// グリッドの大きさが変わった時だけ確保し直す
+	size_t nCellNum = static_cast<size_t>(inGrid.GetWidth()) * inGrid.GetHeight();
+	if (m_NodeVec.size() != nCellNum)
+	{
+		m_NodeVec.assign(nCellNum, Node{ 0.0f, ce_nInvalid, 0 });
+		m_nStamp = 0;
+	}
+
+	// 世代を進めることで前回の探索結果を消さずに無効にする
+	if (m_nStamp >= UINT32_MAX - 4)
+	{
+		for (Node& tNode : m_NodeVec) tNode.m_nStamp = 0;
+		m_nStamp = 0;
+	}
+	m_nStamp += 2;
+	const uint32_t nClosed = m_nStamp + 1;
+	m_nGoal = inGoal;
+	m_OpenVec.clear();
+	m_CellPathVec.clear();
+
+	int nGoalX = static_cast<int>(inGoal) % m_nWidth;
+	int nGoalY = static_cast<int>(inGoal) / m_nWidth;
+
+	Node& tStart = m_NodeVec[inStart];
+	tStart.m_fG = 0.0f;
+	tStart.m_nParent = ce_nInvalid;
+	tStart.m_nStamp = m_nStamp;
+	int nStartX = static_cast<int>(inStart) % m_nWidth;
+	int nStartY = static_cast<int>(inStart) / m_nWidth;
+	float fStartH = Octile(nGoalX - nStartX, nGoalY - nStartY);
+	m_OpenVec.push_back({ fStartH, fStartH, inStart });
+
+	while (!m_OpenVec.empty())
+	{
+		std::pop_heap(m_OpenVec.begin(), m_OpenVec.end(), OpenGreater());
+		uint32_t nCurrent = m_OpenVec.back().m_nNode;
+		m_OpenVec.pop_back();
+
+		// 同じノードが古いコストで残っている場合は読み飛ばす
+		Node& tCurrent = m_NodeVec[nCurrent];
+		if (tCurrent.m_nStamp == nClosed) continue;
+		tCurrent.m_nStamp = nClosed;
+		m_tStats.m_nExpandNum++;
+
+		if (nCurrent == inGoal)
+		{
+			for (uint32_t nNode = inGoal; nNode != ce_nInvalid; nNode = m_NodeVec[nNode].m_nParent)
+			{
+				m_CellPathVec.push_back(nNode);
+			}
+			std::reverse(m_CellPathVec.begin(), m_CellPathVec.end());
+			return true;
+		}
+
+		int nX = static_cast<int>(nCurrent) % m_nWidth;
+		int nY = static_cast<int>(nCurrent) / m_nWidth;
+
+		if (inAlgorithm == PathAlgorithm::AStar)
+		{
+			// 8方向の隣(斜めは角をすり抜けないよう上下左右の両方が通れる場合だけ)
+			for (int nDy = -1; nDy <= 1; nDy++)
+			{
+				for (int nDx = -1; nDx <= 1; nDx++)
+				{
+					if (nDx == 0 && nDy == 0) continue;
+					if (!inGrid.IsWalkable(nX + nDx, nY + nDy)) continue;
+					if (nDx != 0 && nDy != 0 && (!inGrid.IsWalkable(nX + nDx, nY) || !inGrid.IsWalkable(nX, nY + nDy))) continue;
+
+					uint32_t nNext = nCurrent + nDy * m_nWidth + nDx;
+					Relax(nCurrent, nNext, (nDx != 0 && nDy != 0) ? ce_fDiagonalCost : 1.0f,
+						Octile(nGoalX - nX - nDx, nGoalY - nY - nDy));
+				}
+			}
+			continue;
+		}
+
+		// JPS：進んできた向きから調べる必要のある向きだけに絞る
+		int nDirection[8][2];
+		int nDirectionNum = 0;
+		auto AddDirection = [&](int inDx, int inDy)
+		{
+			nDirection[nDirectionNum][0] = inDx;
+			nDirection[nDirectionNum][1] = inDy;
+			nDirectionNum++;
+		};
+
+		if (tCurrent.m_nParent == ce_nInvalid)
+		{
+			for (int nDy = -1; nDy <= 1; nDy++)
+			{
+				for (int nDx = -1; nDx <= 1; nDx++)
+				{
+					if (nDx == 0 && nDy == 0) continue;
+					if (!inGrid.IsWalkable(nX + nDx, nY + nDy)) continue;
+					if (nDx != 0 && nDy != 0 && (!inGrid.IsWalkable(nX + nDx, nY) || !inGrid.IsWalkable(nX, nY + nDy))) continue;
+					AddDirection(nDx, nDy);
+				}
+			}
+		}
+		else
+		{
+			int nParentX = static_cast<int>(tCurrent.m_nParent) % m_nWidth;
+			int nParentY = static_cast<int>(tCurrent.m_nParent) / m_nWidth;
+			int nDx = Sign(nX - nParentX);
+			int nDy = Sign(nY - nParentY);
+
+			if (nDx != 0 && nDy != 0)
+			{
+				bool bVertical = inGrid.IsWalkable(nX, nY + nDy);
+				bool bHorizontal = inGrid.IsWalkable(nX + nDx, nY);
+				if (bVertical) AddDirection(0, nDy);
+				if (bHorizontal) AddDirection(nDx, 0);
+				if (bVertical && bHorizontal) AddDirection(nDx, nDy);
+			}
+			else if (nDx != 0)
+			{
+				bool bNext = inGrid.IsWalkable(nX + nDx, nY);
+				bool bUp = inGrid.IsWalkable(nX, nY + 1);
+				bool bDown = inGrid.IsWalkable(nX, nY - 1);
+				if (bNext)
+				{
+					AddDirection(nDx, 0);
+					if (bUp) AddDirection(nDx, 1);
+					if (bDown) AddDirection(nDx, -1);
+				}
+				if (bUp) AddDirection(0, 1);
+				if (bDown) AddDirection(0, -1);
+			}
+			else
+			{
+				bool bNext = inGrid.IsWalkable(nX, nY + nDy);
+				bool bRight = inGrid.IsWalkable(nX + 1, nY);
+				bool bLeft = inGrid.IsWalkable(nX - 1, nY);
+				if (bNext)
+				{
+					AddDirection(0, nDy);
+					if (bRight) AddDirection(1, nDy);
+					if (bLeft) AddDirection(-1, nDy);
+				}
+				if (bRight) AddDirection(1, 0);
+				if (bLeft) AddDirection(-1, 0);
+			}
+		}
+
+		for (int i = 0; i < nDirectionNum; i++)
+		{
+			int nDx = nDirection[i][0];
+			int nDy = nDirection[i][1];
+			uint32_t nJump = (nDx != 0 && nDy != 0)
+				? JumpDiagonal(inGrid, nX + nDx, nY + nDy, nDx, nDy)
+				: JumpStraight(inGrid, nX + nDx, nY + nDy, nDx, nDy);
+			if (nJump == ce_nInvalid) continue;
+
+			int nJumpX = static_cast<int>(nJump) % m_nWidth;
+			int nJumpY = static_cast<int>(nJump) / m_nWidth;
+			Relax(nCurrent, nJump, Octile(nJumpX - nX, nJumpY - nY), Octile(nGoalX - nJumpX, nGoalY - nJumpY));
+		}
+	}
+	return false;
+}
+
+/****************************************//*
+	@brief　	| 隣のノードをオープンリストに入れる
+	@param　	| inCurrent：展開中のノードの番号
+	@param　	| inNext：隣のノードの番号
+	@param　	| inCost：移動コスト
+	@param　	| inH：終点までの推定コスト
+*//****************************************/
+void CPathFinder::Relax(uint32_t inCurrent, uint32_t inNext, float inCost, float inH)
+{
+	Node& tNext = m_NodeVec[inNext];
+	if (tNext.m_nStamp == m_nStamp + 1) return;
+
+	float fG = m_NodeVec[inCurrent].m_fG + inCost;
+	if (tNext.m_nStamp == m_nStamp && fG >= tNext.m_fG) return;
+
+	// 既にオープンリストにある場合も古い要素は消さずに追加し、取り出した時に読み飛ばす
+	tNext.m_fG = fG;
+	tNext.m_nParent = inCurrent;
+	tNext.m_nStamp = m_nStamp;
+	m_OpenVec.push_back({ fG + inH, inH, inNext });
+	std::push_heap(m_OpenVec.begin(), m_OpenVec.end(), OpenGreater());
+}
+
+/****************************************//*
+	@brief　	| 上下左右にジャンプポイントを探す
+	@param　	| inGrid：ナビゲーショングリッド
+	@param　	| inX：探し始めるX方向のセル番号
+	@param　	| inY：探し始めるZ方向のセル番号
+	@param　	| inDx：X方向の向き
+	@param　	| inDy：Z方向の向き
+	@return		| ジャンプポイントのノードの番号(無ければce_nInvalid)
+*//****************************************/
+uint32_t CPathFinder::JumpStraight(const CNavGrid& inGrid, int inX, int inY, int inDx, int inDy) const
+{
+	// 外周付きのセル配列を直接辿り、範囲の確認を省く(外周は通れないので必ず止まる)
+	const uint8_t* pCells = inGrid.GetPaddedCells();
+	const int nStride = inGrid.GetPaddedStride();
+	const ptrdiff_t nStep = static_cast<ptrdiff_t>(inDy) * nStride + inDx;
+	const ptrdiff_t nSide = (inDx != 0) ? nStride : 1;
+	const int nCellStep = inDy * m_nWidth + inDx;
+
+	size_t nIndex = inGrid.GetPaddedIndex(inX, inY);
+	for (int nCell = inY * m_nWidth + inX;; nIndex += nStep, nCell += nCellStep)
+	{
+		if (pCells[nIndex] != 0) return ce_nInvalid;
+		if (static_cast<uint32_t>(nCell) == m_nGoal) return static_cast<uint32_t>(nCell);
+
+		// 横の障害物が途切れた所は、そこで曲がらないと最短にならないためジャンプポイントにする
+		if ((pCells[nIndex - nSide] == 0 && pCells[nIndex - nSide - nStep] != 0) ||
+			(pCells[nIndex + nSide] == 0 && pCells[nIndex + nSide - nStep] != 0)) return static_cast<uint32_t>(nCell);
+	}
+}
+
+/****************************************//*
+	@brief　	| 斜めにジャンプポイントを探す
+	@param　	| inGrid：ナビゲーショングリッド
+	@param　	| inX：探し始めるX方向のセル番号
+	@param　	| inY：探し始めるZ方向のセル番号
+	@param　	| inDx：X方向の向き
+	@param　	| inDy：Z方向の向き
+	@return		| ジャンプポイントのノードの番号(無ければce_nInvalid)
+*//****************************************/
+uint32_t CPathFinder::JumpDiagonal(const CNavGrid& inGrid, int inX, int inY, int inDx, int inDy) const
+{
+	for (int nX = inX, nY = inY;; nX += inDx, nY += inDy)
+	{
+		if (!inGrid.IsWalkable(nX, nY)) return ce_nInvalid;
+
+		uint32_t nCell = static_cast<uint32_t>(nY * m_nWidth + nX);
+		if (nCell == m_nGoal) return nCell;
+
+		// 斜めに進む途中で上下左右にジャンプポイントが見つかれば、ここで曲がる
+		if (JumpStraight(inGrid, nX + inDx, nY, inDx, 0) != ce_nInvalid ||
+			JumpStraight(inGrid, nX, nY + inDy, 0, inDy) != ce_nInvalid) return nCell;
+
+		// 角をすり抜けないよう上下左右の両方が通れる場合だけ次に進む
+		if (!inGrid.IsWalkable(nX + inDx, nY) || !inGrid.IsWalkable(nX, nY + inDy)) return ce_nInvalid;
+	}
+}
+
+/****************************************//*
+	@brief　	| 見通しの通る経由点を省く
+	@param　	| inGrid：ナビゲーショングリッド
+*//****************************************/
+void CPathFinder::Smooth(const CNavGrid& inGrid)
+{
+	if (m_CellPathVec.size() <= 2) return;
+
+	// 最後に残した経由点から見通しが通らなくなる直前の経由点だけを残す
+	m_SmoothVec.clear();
+	m_SmoothVec.push_back(m_CellPathVec.front());
+	int nAnchorX = static_cast<int>(m_CellPathVec.front()) % m_nWidth;
+	int nAnchorY = static_cast<int>(m_CellPathVec.front()) / m_nWidth;
+	for (size_t i = 2; i < m_CellPathVec.size(); i++)
+	{
+		int nX = static_cast<int>(m_CellPathVec[i]) % m_nWidth;
+		int nY = static_cast<int>(m_CellPathVec[i]) / m_nWidth;
+		if (inGrid.HasLineOfSight(nAnchorX, nAnchorY, nX, nY)) continue;
+
+		uint32_t nKeep = m_CellPathVec[i - 1];
+		m_SmoothVec.push_back(nKeep);
+		nAnchorX = static_cast<int>(nKeep) % m_nWidth;
+		nAnchorY = static_cast<int>(nKeep) / m_nWidth;
+	}
+	m_SmoothVec.push_back(m_CellPathVec.back());
+	m_CellPathVec.swap(m_SmoothVec);
+}
@@ -0,0 +1,161 @@
+/**************************************************//*
+	@file	| PathFinder.h
+	@brief	| 経路探索クラスのhファイル
+	@note	| ナビゲーショングリッド上でA*、またはJPS(Jump Point Search)により経路を求め、
+			| 見通しの通る経由点を省いて滑らかにする
+			| 探索に使うノードとオープンリストは探索の度に確保し直さず使い回すため、
+			| 1つのインスタンスを同時に複数のスレッドから使ってはいけない
+*//**************************************************/
+#pragma once
+#include "NavGrid.h"
+#include <cstdint>
+#include <vector>
+
+// @brief 経路探索のアルゴリズム
+enum class PathAlgorithm
+{
+	// 8方向のA*
+	AStar,
+
+	// ジャンプポイントサーチ(A*と同じ長さの経路を、より少ない展開数で求める)
+	JPS,
+};
+
+// @brief 直前の探索の統計情報
+struct PathSearchStats
+{
+	// 展開したノードの数
+	int m_nExpandNum;
+
+	// 滑らかにする前の経由点の数
+	int m_nRawPointNum;
+
+	// 返した経由点の数
+	int m_nPointNum;
+};
+
+// @brief 経路探索クラス
+class CPathFinder
+{
+public:
+	// @brief 通れないセルから最寄りの通れるセルを探す範囲(セル数)
+	static constexpr int ce_nSnapRadius = 8;
+
+public:
+	// @brief コンストラクタ
+	CPathFinder();
+
+	// @brief 経路を求める
+	// @param inGrid：ナビゲーショングリッド(BuildRegions済み)
+	// @param inStart：始点
+	// @param inGoal：終点
+	// @param outPath：経由点(始点と終点を含む)
+	// @param inAlgorithm：アルゴリズム
+	// @param isSmooth：見通しの通る経由点を省くか
+	// @return true:経路が見つかった false:到達できない
+	// @note 始点や終点が通れないセルにある場合は最寄りの通れるセルに置き換える
+	bool FindPath(const CNavGrid& inGrid, const NavPoint& inStart, const NavPoint& inGoal,
+		std::vector<NavPoint>& outPath, PathAlgorithm inAlgorithm = PathAlgorithm::JPS, bool isSmooth = true);
+
+	// @brief 直前の探索の統計情報の取得
+	// @return 統計情報
+	const PathSearchStats& GetStats() const { return m_tStats; }
+
+private:
+	// @brief ノード1つ分の情報
+	struct Node
+	{
+		// 始点からのコスト
+		float m_fG;
+
+		// 1つ前のノードの番号
+		uint32_t m_nParent;
+
+		// 探索の世代(オープンリストに入っている世代か、閉じた世代か)
+		uint32_t m_nStamp;
+	};
+
+	// @brief オープンリストの要素
+	struct OpenEntry
+	{
+		// 推定コスト(g + h)
+		float m_fF;
+
+		// 終点までの推定コスト(同じ推定コストなら終点に近い方を先に展開する)
+		float m_fH;
+
+		// ノードの番号
+		uint32_t m_nNode;
+	};
+
+	// @brief セル同士の推定コスト(8方向移動の距離)
+	// @param inDx：X方向の差
+	// @param inDy：Z方向の差
+	// @return 推定コスト
+	static float Octile(int inDx, int inDy);
+
+	// @brief 始点のセルから終点のセルまで探索する
+	// @param inGrid：ナビゲーショングリッド
+	// @param inStart：始点のセル番号
+	// @param inGoal：終点のセル番号
+	// @param inAlgorithm：アルゴリズム
+	// @return true:見つかった false:見つからない
+	bool Search(const CNavGrid& inGrid, uint32_t inStart, uint32_t inGoal, PathAlgorithm inAlgorithm);
+
+	// @brief 隣のノードをオープンリストに入れる
+	// @param inCurrent：展開中のノードの番号
+	// @param inNext：隣のノードの番号
+	// @param inCost：移動コスト
+	// @param inH：終点までの推定コスト
+	void Relax(uint32_t inCurrent, uint32_t inNext, float inCost, float inH);
+
+	// @brief 上下左右にジャンプポイントを探す
+	// @param inGrid：ナビゲーショングリッド
+	// @param inX：探し始めるX方向のセル番号
+	// @param inY：探し始めるZ方向のセル番号
+	// @param inDx：X方向の向き
+	// @param inDy：Z方向の向き
+	// @return ジャンプポイントのノードの番号(無ければce_nInvalid)
+	uint32_t JumpStraight(const CNavGrid& inGrid, int inX, int inY, int inDx, int inDy) const;
+
+	// @brief 斜めにジャンプポイントを探す
+	// @param inGrid：ナビゲーショングリッド
+	// @param inX：探し始めるX方向のセル番号
+	// @param inY：探し始めるZ方向のセル番号
+	// @param inDx：X方向の向き
+	// @param inDy：Z方向の向き
+	// @return ジャンプポイントのノードの番号(無ければce_nInvalid)
+	uint32_t JumpDiagonal(const CNavGrid& inGrid, int inX, int inY, int inDx, int inDy) const;
+
+	// @brief 見通しの通る経由点を省く
+	// @param inGrid：ナビゲーショングリッド
+	void Smooth(const CNavGrid& inGrid);
+
+private:
+	// @brief 無効なノードの番号
+	static constexpr uint32_t ce_nInvalid = UINT32_MAX;
+
+	// @brief セル毎のノード(グリッドの大きさが変わるまで使い回す)
+	std::vector<Node> m_NodeVec;
+
+	// @brief オープンリスト(二分ヒープ)
+	std::vector<OpenEntry> m_OpenVec;
+
+	// @brief 見つかった経路のセル番号
+	std::vector<uint32_t> m_CellPathVec;
+
+	// @brief 滑らかにする作業用のセル番号
+	std::vector<uint32_t> m_SmoothVec;
+
+	// @brief 今回の探索の世代(オープンはこの値、クローズは+1)
+	uint32_t m_nStamp;
+
+	// @brief 探索中のグリッドの横幅
+	int m_nWidth;
+
+	// @brief 探索中の終点のセル番号
+	uint32_t m_nGoal;
+
+	// @brief 直前の探索の統計情報
+	PathSearchStats m_tStats;
+};
@@ -0,0 +1,370 @@
+/**************************************************//*
+	@file	| PathService.cpp
+	@brief	| 経路探索サービスクラスのcppファイル
+	@note	| 経路の要求を受け付け、まとめてジョブシステムで探索し、
+			| 1～2フレーム後に結果を受け取れるようにする
+			| 探索結果の反映と次の要求の発行はメインスレッドのUpdateで行う
+			| シングルトンパターンで作成
+*//**************************************************/
+#include "PathService.h"
+#include "JobSystem.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+namespace
+{
+	// @brief 1つのジョブにまとめる最小の要求の数(少ない要求を細かく分けすぎないため)
+	constexpr size_t ce_nMinChunkTask = 16;
+
+	// @brief 経由点を結んだ長さ
+	// @param inPath：経由点
+	// @return 長さ
+	float GetPathLength(const std::vector<NavPoint>& inPath)
+	{
+		float fLength = 0.0f;
+		for (size_t i = 1; i < inPath.size(); i++)
+		{
+			float fDx = inPath[i].m_fX - inPath[i - 1].m_fX;
+			float fDz = inPath[i].m_fZ - inPath[i - 1].m_fZ;
+			fLength += sqrtf(fDx * fDx + fDz * fDz);
+		}
+		return fLength;
+	}
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CPathService::CPathService()
+	: m_nRunningNum(0)
+	, m_nNextHandle(ce_nInvalidHandle)
+	, m_nRequestCount(0)
+	, m_nBudget(ce_nDefaultBudget)
+	, m_eAlgorithm(PathAlgorithm::JPS)
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CPathService::~CPathService()
+{
+	WaitRunning();
+}
+
+/****************************************//*
+	@brief　	| ナビゲーショングリッドを差し替える
+	@param　	| inGrid：ナビゲーショングリッド(BuildRegions済み)
+*//****************************************/
+void CPathService::SetGrid(CNavGrid&& inGrid)
+{
+	// 探索中のジョブが古いグリッドを読んでいるため、終わるまで待つ
+	WaitRunning();
+	Publish();
+	m_Grid = std::move(inGrid);
+}
+
+/****************************************//*
+	@brief　	| 経路を要求する
+	@param　	| inStart：始点
+	@param　	| inGoal：終点
+	@return		| 要求の番号(結果を受け取ったらReleaseで解放する)
+*//****************************************/
+PathHandle CPathService::RequestPath(const NavPoint& inStart, const NavPoint& inGoal)
+{
+	if (++m_nNextHandle == ce_nInvalidHandle) ++m_nNextHandle;
+	PathHandle nHandle = m_nNextHandle;
+
+	Request& tRequest = m_RequestMap[nHandle];
+	tRequest.m_eState = PathState::Pending;
+	tRequest.m_PathVec.clear();
+
+	// 始点と終点はタスクに詰める時に使うため、要求の経由点に仮置きする
+	tRequest.m_PathVec.push_back(inStart);
+	tRequest.m_PathVec.push_back(inGoal);
+	m_PendingQueue.push_back(nHandle);
+	m_nRequestCount++;
+	return nHandle;
+}
+
+/****************************************//*
+	@brief　	| 経路を受け取る
+	@param　	| inHandle：要求の番号
+	@param　	| outPath：経由点(Readyの場合のみ書き込む)
+	@return		| 要求の状態
+*//****************************************/
+PathState CPathService::GetPath(PathHandle inHandle, std::vector<NavPoint>& outPath) const
+{
+	auto itRequest = m_RequestMap.find(inHandle);
+	if (itRequest == m_RequestMap.end()) return PathState::None;
+
+	const Request& tRequest = itRequest->second;
+	if (tRequest.m_eState == PathState::Ready) outPath = tRequest.m_PathVec;
+	return tRequest.m_eState;
+}
+
+/****************************************//*
+	@brief　	| 要求を解放する
+	@param　	| inHandle：要求の番号
+*//****************************************/
+void CPathService::Release(PathHandle inHandle)
+{
+	// 探索待ちのキューや探索中のタスクに残っていても、反映時に要求が無ければ読み飛ばす
+	m_RequestMap.erase(inHandle);
+}
+
+/****************************************//*
+	@brief　	| 更新
+*//****************************************/
+void CPathService::Update()
+{
+	m_tStats.m_nRequestNum = m_nRequestCount;
+	m_nRequestCount = 0;
+
+	// 探索中なら次のフレームに持ち越す
+	if (m_nRunningNum.load(std::memory_order_acquire) > 0)
+	{
+		m_tStats.m_nDispatchNum = 0;
+		m_tStats.m_nPendingNum = static_cast<int>(m_PendingQueue.size() + m_TaskVec.size());
+		return;
+	}
+
+	Publish();
+	Dispatch();
+	m_tStats.m_nPendingNum = static_cast<int>(m_PendingQueue.size() + m_TaskVec.size());
+}
+
+/****************************************//*
+	@brief　	| 探索中のジョブの完了を待つ
+*//****************************************/
+void CPathService::WaitRunning()
+{
+	while (m_nRunningNum.load(std::memory_order_acquire) > 0)
+	{
+		CJobSystem::GetInstance()->WaitAll();
+	}
+}
+
+/****************************************//*
+	@brief　	| 探索が終わった結果を要求に反映する
+*//****************************************/
+void CPathService::Publish()
+{
+	if (m_TaskVec.empty()) return;
+
+	m_tStats.m_nSolvedNum = 0;
+	m_tStats.m_nFailedNum = 0;
+	for (Task& tTask : m_TaskVec)
+	{
+		if (tTask.m_bFound) m_tStats.m_nSolvedNum++;
+		else m_tStats.m_nFailedNum++;
+
+		auto itRequest = m_RequestMap.find(tTask.m_nHandle);
+		if (itRequest == m_RequestMap.end()) continue;
+		itRequest->second.m_eState = tTask.m_bFound ? PathState::Ready : PathState::Failed;
+		itRequest->second.m_PathVec.swap(tTask.m_PathVec);
+	}
+	m_TaskVec.clear();
+
+	m_tStats.m_nExpandNum = 0;
+	m_tStats.m_dSearchMs = 0.0;
+	for (const ChunkStats& tChunk : m_ChunkVec)
+	{
+		m_tStats.m_nExpandNum += tChunk.m_nExpandNum;
+		m_tStats.m_dSearchMs += tChunk.m_dMs;
+	}
+}
+
+/****************************************//*
+	@brief　	| 探索待ちの要求をジョブとして発行する
+*//****************************************/
+void CPathService::Dispatch()
+{
+	m_tStats.m_nDispatchNum = 0;
+
+	// 1フレームに探索する数を超えた分は次のフレームに回す
+	while (!m_PendingQueue.empty() && m_TaskVec.size() < static_cast<size_t>(m_nBudget))
+	{
+		PathHandle nHandle = m_PendingQueue.front();
+		m_PendingQueue.pop_front();
+
+		auto itRequest = m_RequestMap.find(nHandle);
+		if (itRequest == m_RequestMap.end()) continue;
+
+		const std::vector<NavPoint>& tEnds = itRequest->second.m_PathVec;
+		m_TaskVec.push_back({ nHandle, tEnds[0], tEnds[1], false, {} });
+	}
+	if (m_TaskVec.empty()) return;
+	m_tStats.m_nDispatchNum = static_cast<int>(m_TaskVec.size());
+
+	// ワーカースレッド毎に1つのジョブにまとめる(探索クラスをジョブ毎に使い回す)
+	CJobSystem* pJobSystem = CJobSystem::GetInstance();
+	size_t nThreadNum = (std::max)(static_cast<size_t>(pJobSystem->GetThreadNum()), static_cast<size_t>(1));
+	size_t nChunkNum = (std::min)(nThreadNum, (m_TaskVec.size() + ce_nMinChunkTask - 1) / ce_nMinChunkTask);
+	while (m_FinderVec.size() < nChunkNum) m_FinderVec.push_back(std::make_unique<CPathFinder>());
+	m_ChunkVec.assign(nChunkNum, ChunkStats{ 0, 0.0 });
+
+	size_t nChunkSize = (m_TaskVec.size() + nChunkNum - 1) / nChunkNum;
+	m_nRunningNum.store(static_cast<int>(nChunkNum), std::memory_order_release);
+	for (size_t nChunk = 0; nChunk < nChunkNum; nChunk++)
+	{
+		size_t nBegin = nChunk * nChunkSize;
+		size_t nEnd = (std::min)(nBegin + nChunkSize, m_TaskVec.size());
+		pJobSystem->Submit([this, nChunk, nBegin, nEnd]()
+		{
+			auto tStart = std::chrono::high_resolution_clock::now();
+			CPathFinder& tFinder = *m_FinderVec[nChunk];
+			ChunkStats& tChunk = m_ChunkVec[nChunk];
+			for (size_t i = nBegin; i < nEnd; i++)
+			{
+				Task& tTask = m_TaskVec[i];
+				tTask.m_bFound = tFinder.FindPath(m_Grid, tTask.m_tStart, tTask.m_tGoal, tTask.m_PathVec, m_eAlgorithm);
+				tChunk.m_nExpandNum += tFinder.GetStats().m_nExpandNum;
+			}
+			tChunk.m_dMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+			m_nRunningNum.fetch_sub(1, std::memory_order_release);
+		});
+	}
+}
+
+/****************************************//*
+	@brief　	| 大きなマップで1000件の経路探索を計測して書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CPathService::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr uint32_t ce_nMapSize = 1024;
+	static constexpr int ce_nObstacleNum = 1500;
+	static constexpr int ce_nRequestNum = 1000;
+
+	// 固定のシードで回転した箱を散らばらせたマップを作る
+	CNavGrid tGrid;
+	tGrid.Init(0.0f, 0.0f, ce_nMapSize, ce_nMapSize, 1.0f);
+	std::mt19937 tRandom(20261019);
+	std::uniform_real_distribution<float> tPos(0.0f, static_cast<float>(ce_nMapSize));
+	std::uniform_real_distribution<float> tHalf(1.0f, 8.0f);
+	std::uniform_real_distribution<float> tYaw(0.0f, 3.14159265f);
+	for (int i = 0; i < ce_nObstacleNum; i++)
+	{
+		tGrid.AddObstacle({ tPos(tRandom), tPos(tRandom) }, { tHalf(tRandom), tHalf(tRandom) }, tYaw(tRandom), 0.5f);
+	}
+	tGrid.BuildRegions();
+
+	// 同じ領域にある通れるセル同士を始点と終点にする
+	std::vector<NavPoint> tStartVec, tGoalVec;
+	std::uniform_int_distribution<int> tCell(0, static_cast<int>(ce_nMapSize) - 1);
+	while (static_cast<int>(tStartVec.size()) < ce_nRequestNum)
+	{
+		int nStartX = tCell(tRandom), nStartY = tCell(tRandom);
+		int nGoalX = tCell(tRandom), nGoalY = tCell(tRandom);
+		uint32_t nRegion = tGrid.GetRegion(nStartX, nStartY);
+		if (nRegion == CNavGrid::ce_nNoRegion || nRegion != tGrid.GetRegion(nGoalX, nGoalY)) continue;
+		tStartVec.push_back(tGrid.CellToWorld(nStartX, nStartY));
+		tGoalVec.push_back(tGrid.CellToWorld(nGoalX, nGoalY));
+	}
+
+	char szLine[256];
+	sprintf_s(szLine, "map %ux%u  blocked %.1f%%  region %u  request %d\n", ce_nMapSize, ce_nMapSize,
+		100.0 * tGrid.GetBlockedNum() / (ce_nMapSize * ce_nMapSize), tGrid.GetRegionNum(), ce_nRequestNum);
+	tReport << szLine;
+
+	// 1スレッドでA*とJPSを比べる(経路の長さが一致することも確かめる)
+	CPathFinder tFinder;
+	std::vector<NavPoint> tPath;
+	std::vector<float> tLengthVec(ce_nRequestNum);
+	for (PathAlgorithm eAlgorithm : { PathAlgorithm::AStar, PathAlgorithm::JPS })
+	{
+		long long nExpandNum = 0;
+		int nFoundNum = 0, nMismatchNum = 0;
+		auto tStart = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < ce_nRequestNum; i++)
+		{
+			if (!tFinder.FindPath(tGrid, tStartVec[i], tGoalVec[i], tPath, eAlgorithm, false)) continue;
+			nFoundNum++;
+			nExpandNum += tFinder.GetStats().m_nExpandNum;
+
+			float fLength = GetPathLength(tPath);
+			if (eAlgorithm == PathAlgorithm::AStar) tLengthVec[i] = fLength;
+			else if (fabsf(fLength - tLengthVec[i]) > 1e-3f * (std::max)(fLength, 1.0f)) nMismatchNum++;
+		}
+		double dMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		sprintf_s(szLine, "%-5s 1 thread  %8.1f ms  %6.1f us/path  expand %8.0f/path  found %d  length mismatch %d\n",
+			eAlgorithm == PathAlgorithm::AStar ? "A*" : "JPS", dMs, dMs * 1000.0 / ce_nRequestNum,
+			static_cast<double>(nExpandNum) / (std::max)(nFoundNum, 1), nFoundNum, nMismatchNum);
+		tReport << szLine;
+	}
+
+	// 見通しの通る経由点を省いた場合の経由点の数と長さ
+	{
+		long long nRawNum = 0, nSmoothNum = 0;
+		double dRawLength = 0.0, dSmoothLength = 0.0;
+		auto tStart = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < ce_nRequestNum; i++)
+		{
+			if (!tFinder.FindPath(tGrid, tStartVec[i], tGoalVec[i], tPath, PathAlgorithm::JPS, true)) continue;
+			nRawNum += tFinder.GetStats().m_nRawPointNum;
+			nSmoothNum += tFinder.GetStats().m_nPointNum;
+			dRawLength += tLengthVec[i];
+			dSmoothLength += GetPathLength(tPath);
+		}
+		double dMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		sprintf_s(szLine, "smooth 1 thread  %8.1f ms  point %.1f -> %.1f/path  length %.1f%%\n", dMs,
+			static_cast<double>(nRawNum) / ce_nRequestNum, static_cast<double>(nSmoothNum) / ce_nRequestNum,
+			100.0 * dSmoothLength / dRawLength);
+		tReport << szLine;
+	}
+
+	// サービス経由：1フレーム毎にUpdateを呼び、残りのフレーム時間でジョブが終わるものとして計る
+	CJobSystem* pJobSystem = CJobSystem::GetInstance();
+	bool bStartJob = pJobSystem->GetThreadNum() == 0;
+	if (bStartJob) pJobSystem->Init();
+
+	for (int nBudget : { ce_nDefaultBudget, ce_nRequestNum })
+	{
+		CPathService tService;
+		tService.SetGrid(CNavGrid(tGrid));
+		tService.SetBudget(nBudget);
+
+		std::vector<PathHandle> tHandleVec;
+		for (int i = 0; i < ce_nRequestNum; i++) tHandleVec.push_back(tService.RequestPath(tStartVec[i], tGoalVec[i]));
+
+		int nFrame = 0, nReadyNum = 0;
+		double dUpdateMs = 0.0, dMaxUpdateMs = 0.0;
+		auto tStart = std::chrono::high_resolution_clock::now();
+		while (nReadyNum < ce_nRequestNum)
+		{
+			auto tUpdate = std::chrono::high_resolution_clock::now();
+			tService.Update();
+			double dMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tUpdate).count();
+			dUpdateMs += dMs;
+			dMaxUpdateMs = (std::max)(dMaxUpdateMs, dMs);
+			tService.WaitRunning();
+			nFrame++;
+
+			nReadyNum = 0;
+			for (PathHandle nHandle : tHandleVec)
+			{
+				PathState eState = tService.m_RequestMap[nHandle].m_eState;
+				if (eState == PathState::Ready || eState == PathState::Failed) nReadyNum++;
+			}
+		}
+		double dMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		sprintf_s(szLine, "service %u threads  budget %4d  %8.1f ms  frame %d  update %.3f ms (max %.3f ms)\n",
+			pJobSystem->GetThreadNum(), nBudget, dMs, nFrame, dUpdateMs, dMaxUpdateMs);
+		tReport << szLine;
+	}
+
+	if (bStartJob) pJobSystem->Uninit();
+	return 0;
+}
@@ -0,0 +1,222 @@
+/**************************************************//*
+	@file	| PathService.h
+	@brief	| 経路探索サービスクラスのhファイル
+	@note	| 経路の要求を受け付け、まとめてジョブシステムで探索し、
+			| 1～2フレーム後に結果を受け取れるようにする
+			| 探索結果の反映と次の要求の発行はメインスレッドのUpdateで行う
+			| シングルトンパターンで作成
+*//**************************************************/
+#pragma once
+#include "Singleton.h"
+#include "NavGrid.h"
+#include "PathFinder.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// @brief 経路の要求の番号(0は無効)
+using PathHandle = uint32_t;
+
+// @brief 経路の要求の状態
+enum class PathState
+{
+	// 要求が無い(解放済みを含む)
+	None,
+
+	// 探索待ち、または探索中
+	Pending,
+
+	// 経路が見つかった
+	Ready,
+
+	// 到達できない
+	Failed,
+};
+
+// @brief 経路探索サービスの統計情報
+struct PathServiceStats
+{
+	// 直前のフレームに受け付けた要求の数
+	int m_nRequestNum;
+
+	// 直前のフレームに探索に回した要求の数
+	int m_nDispatchNum;
+
+	// 探索待ちの要求の数
+	int m_nPendingNum;
+
+	// 直前に反映した結果のうち経路が見つかった数
+	int m_nSolvedNum;
+
+	// 直前に反映した結果のうち到達できなかった数
+	int m_nFailedNum;
+
+	// 直前に反映した探索で展開したノードの数
+	int m_nExpandNum;
+
+	// 直前に反映した探索にかかった時間の合計(ワーカースレッド毎の合計)
+	double m_dSearchMs;
+};
+
+// @brief 経路探索サービスクラス
+class CPathService : public ISingleton<CPathService>
+{
+public:
+	// @brief 無効な要求の番号
+	static constexpr PathHandle ce_nInvalidHandle = 0;
+
+	// @brief 1フレームに探索に回す要求の数の初期値
+	static constexpr int ce_nDefaultBudget = 256;
+
+private:
+	// @brief コンストラクタ
+	CPathService();
+
+	friend class ISingleton<CPathService>;
+public:
+	// @brief デストラクタ
+	// @note 探索中のジョブの完了を待つ
+	~CPathService();
+
+	// @brief ナビゲーショングリッドを差し替える
+	// @param inGrid：ナビゲーショングリッド(BuildRegions済み)
+	// @note 探索中のジョブの完了を待ってから差し替え、探索待ちの要求は新しいグリッドで探索する
+	void SetGrid(CNavGrid&& inGrid);
+
+	// @brief ナビゲーショングリッドの取得
+	// @return ナビゲーショングリッド
+	const CNavGrid& GetGrid() const { return m_Grid; }
+
+	// @brief 経路を要求する
+	// @param inStart：始点
+	// @param inGoal：終点
+	// @return 要求の番号(結果を受け取ったらReleaseで解放する)
+	PathHandle RequestPath(const NavPoint& inStart, const NavPoint& inGoal);
+
+	// @brief 経路を受け取る
+	// @param inHandle：要求の番号
+	// @param outPath：経由点(Readyの場合のみ書き込む)
+	// @return 要求の状態
+	PathState GetPath(PathHandle inHandle, std::vector<NavPoint>& outPath) const;
+
+	// @brief 要求を解放する
+	// @param inHandle：要求の番号
+	// @note 探索中に解放した場合は結果を捨てる
+	void Release(PathHandle inHandle);
+
+	// @brief 更新
+	// @note 探索が終わっていれば結果を反映し、探索待ちの要求を次のジョブとして発行する
+	//       探索中の場合は何もせず、次のフレームに持ち越す
+	void Update();
+
+	// @brief 探索のアルゴリズムを設定する
+	// @param inAlgorithm：アルゴリズム
+	void SetAlgorithm(PathAlgorithm inAlgorithm) { m_eAlgorithm = inAlgorithm; }
+
+	// @brief 探索のアルゴリズムの取得
+	// @return アルゴリズム
+	PathAlgorithm GetAlgorithm() const { return m_eAlgorithm; }
+
+	// @brief 1フレームに探索に回す要求の数を設定する
+	// @param inBudget：要求の数(1以上)
+	void SetBudget(int inBudget) { m_nBudget = (std::max)(inBudget, 1); }
+
+	// @brief 統計情報の取得
+	// @return 統計情報
+	const PathServiceStats& GetStats() const { return m_tStats; }
+
+	// @brief 大きなマップで1000件の経路探索を計測して書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief 要求1件分の情報
+	struct Request
+	{
+		// 状態
+		PathState m_eState;
+
+		// 経由点
+		std::vector<NavPoint> m_PathVec;
+	};
+
+	// @brief 探索1件分の情報(ワーカースレッドが書き込む)
+	struct Task
+	{
+		// 要求の番号
+		PathHandle m_nHandle;
+
+		// 始点
+		NavPoint m_tStart;
+
+		// 終点
+		NavPoint m_tGoal;
+
+		// 経路が見つかったか
+		bool m_bFound;
+
+		// 経由点
+		std::vector<NavPoint> m_PathVec;
+	};
+
+	// @brief ジョブ1つ分の集計(ワーカースレッドが書き込む)
+	struct ChunkStats
+	{
+		// 展開したノードの数
+		int m_nExpandNum;
+
+		// 探索にかかった時間(ミリ秒)
+		double m_dMs;
+	};
+
+	// @brief 探索中のジョブの完了を待つ
+	void WaitRunning();
+
+	// @brief 探索が終わった結果を要求に反映する
+	void Publish();
+
+	// @brief 探索待ちの要求をジョブとして発行する
+	void Dispatch();
+
+private:
+	// @brief ナビゲーショングリッド
+	CNavGrid m_Grid;
+
+	// @brief 要求の番号毎の情報
+	std::unordered_map<PathHandle, Request> m_RequestMap;
+
+	// @brief 探索待ちの要求の番号
+	std::deque<PathHandle> m_PendingQueue;
+
+	// @brief 探索中の要求
+	std::vector<Task> m_TaskVec;
+
+	// @brief ジョブ毎の探索クラス(ノードとオープンリストを使い回す)
+	std::vector<std::unique_ptr<CPathFinder>> m_FinderVec;
+
+	// @brief ジョブ毎の集計
+	std::vector<ChunkStats> m_ChunkVec;
+
+	// @brief 実行中のジョブの数
+	std::atomic<int> m_nRunningNum;
+
+	// @brief 次に発行する要求の番号
+	PathHandle m_nNextHandle;
+
+	// @brief 前回の更新から受け付けた要求の数
+	int m_nRequestCount;
+
+	// @brief 1フレームに探索に回す要求の数
+	int m_nBudget;
+
+	// @brief 探索のアルゴリズム
+	PathAlgorithm m_eAlgorithm;
+
+	// @brief 統計情報
+	PathServiceStats m_tStats;
+};
@@ -13,9 +13,22 @@
 #include "Main.h"
 #include "Field.h"
 #include "Geometory.h"
+#include <algorithm>
 
 constexpr float ce_fMoveSpeed = 0.2f;
 
+// ڕWʒuɒƂ݂Ȃ
+constexpr float ce_fArriveDist = 0.5f;
+
+// XL̃RXg̏
+constexpr float ce_fSkillResourceMax = 100.0f;
+
+// 1b̃XL̃RXg̉񕜗
+constexpr float ce_fSkillRegen = 20.0f;
+
+// XL蓖ĂL[̐
+constexpr int ce_nSkillKeyNum = 4;
+
 /*****************************************//*
 	@brief@	| RXgN^
 *//*****************************************/
@@ -23,6 +36,13 @@ CPlayer::CPlayer()
 	: CEntity()
 	, m_f3TargetPos(StructMath::FtoF3(0.0f))
 	, m_bIsMove(false)
+	, m_nPathHandle(CPathService::ce_nInvalidHandle)
+	, m_PathVec{}
+	, m_nPathIndex(0)
+	, m_nCasterId(CSkillEngine::ce_nInvalidId)
+	, m_fSlowTime(0.0f)
+	, m_fSlowRate(0.0f)
+	, m_fStunTime(0.0f)
 {
 	// r{[h_[̒ǉ
 	AddComponent<CBillboardRenderer>();
@@ -36,6 +56,17 @@ CPlayer::CPlayer()
 *//*****************************************/
 CPlayer::~CPlayer()
 {
+	// 󂯎ĂȂoH̗v
+	if (m_nPathHandle != CPathService::ce_nInvalidHandle)
+	{
+		CPathService::GetInstance()->Release(m_nPathHandle);
+	}
+
+	// ς݂̃XL͍Ō܂Ŏs
+	if (m_nCasterId != CSkillEngine::ce_nInvalidId)
+	{
+		CSkillEngine::GetInstance()->DestroyCaster(m_nCasterId);
+	}
 }
 
 /*****************************************//*
@@ -56,8 +87,12 @@ void CPlayer::Init()
 	// 蔻̐ݒ
 	CCollisionObb* pCollision = GetComponent<CCollisionObb>();
 	pCollision->SetTag("Player");
+	pCollision->SetLayer(CollisionLayer::Player);
 	pCollision->SetCenter(m_tParam.m_f3Pos);
 	pCollision->SetSize(m_tParam.m_f3Size);
+
+	// XL̎gp҂̓o^
+	m_nCasterId = CSkillEngine::GetInstance()->CreateCaster(GetEntityId(), ce_fSkillResourceMax, ce_fSkillRegen);
 }
 
 /*****************************************//*
@@ -68,6 +103,9 @@ void CPlayer::Update()
 	// ړ
 	Move();
 
+	// XL̔
+	CastSkill();
+
 	// NX̍XV
 	CEntity::Update();
 
@@ -80,11 +118,16 @@ void CPlayer::Update()
 *//*****************************************/
 void CPlayer::Draw()
 {
-	// ڕWʒu܂ł̐`
+	// čoR_Ԑ`(`̓t[̍Ōɂ܂Ƃ߂čs)
 	if (m_bIsMove)
 	{
-		Geometory::AddLine(m_tParam.m_f3Pos, m_f3TargetPos, DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f));
-		Geometory::DrawLines();
+		DirectX::XMFLOAT3 f3From = m_tParam.m_f3Pos;
+		for (size_t i = m_nPathIndex; i < m_PathVec.size(); i++)
+		{
+			DirectX::XMFLOAT3 f3To = { m_PathVec[i].m_fX, m_tParam.m_f3Pos.y, m_PathVec[i].m_fZ };
+			Geometory::AddLine(f3From, f3To, DirectX::XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f));
+			f3From = f3To;
+		}
 	}
 
 	// NX̕`揈
@@ -109,19 +152,31 @@ void CPlayer::Move()
 
 		// ^[QbǵuʂŎwtB[h_XZv̗pAY̓vC[Œ
 		m_f3TargetPos = hitOnField;
-		m_bIsMove = true;
+
+		// QoHvAʂo܂ł͎~܂đ҂(1`2t[ɓ͂)
+		CPathService* pPathService = CPathService::GetInstance();
+		if (m_nPathHandle != CPathService::ce_nInvalidHandle) pPathService->Release(m_nPathHandle);
+		m_nPathHandle = pPathService->RequestPath({ m_tParam.m_f3Pos.x, m_tParam.m_f3Pos.z }, { m_f3TargetPos.x, m_f3TargetPos.z });
+		m_bIsMove = false;
 	}
 
+	// voH̎󂯎
+	ReceivePath();
+
 	if (m_bIsMove)
 	{
 		// XZʂŋiY͌Ȃj
-		const float dx = m_f3TargetPos.x - m_tParam.m_f3Pos.x;
-		const float dz = m_f3TargetPos.z - m_tParam.m_f3Pos.z;
+		const NavPoint& tWaypoint = m_PathVec[m_nPathIndex];
+		const float dx = tWaypoint.m_fX - m_tParam.m_f3Pos.x;
+		const float dz = tWaypoint.m_fZ - m_tParam.m_f3Pos.z;
 		const float distXZ = sqrtf(dx * dx + dz * dz);
 
-		if (distXZ < 0.5f)
+		// řoR_͏Q̊pȂ悤A1t[̈ړʂ܂ŋ߂ÂĂ玟Ɍ
+		const bool isLast = m_nPathIndex + 1 >= m_PathVec.size();
+		if (distXZ < (isLast ? ce_fArriveDist : ce_fMoveSpeed))
 		{
-			m_bIsMove = false;
+			m_nPathIndex++;
+			m_bIsMove = !isLast;
 		}
 		else
 		{
@@ -134,9 +189,96 @@ void CPlayer::Move()
 	// xxNg̐K
 	m_f3Velocity = StructMath::Normalize(m_f3Velocity);
 
+	// XĽƍss\(oH͂̂܂܎cA瑱i)
+	float fSpeed = ce_fMoveSpeed;
+	if (m_fSlowTime > 0.0f)
+	{
+		m_fSlowTime -= fDeltaTime;
+		fSpeed *= 1.0f - m_fSlowRate;
+	}
+	if (m_fStunTime > 0.0f)
+	{
+		m_fStunTime -= fDeltaTime;
+		fSpeed = 0.0f;
+	}
+
 	// ʒu̍XViXZړj
-	m_tParam.m_f3Pos += m_f3Velocity * ce_fMoveSpeed;
+	m_tParam.m_f3Pos += m_f3Velocity * fSpeed;
 
 	// ÔYŒiŕςĂ߂j
 	m_tParam.m_f3Pos.y = m_f3OldPos.y;
+}
+
+/*****************************************//*
+	@brief@	| voH̎󂯎
+*//*****************************************/
+void CPlayer::ReceivePath()
+{
+	if (m_nPathHandle == CPathService::ce_nInvalidHandle) return;
+
+	CPathService* pPathService = CPathService::GetInstance();
+	PathState eState = pPathService->GetPath(m_nPathHandle, m_PathVec);
+	if (eState == PathState::Pending) return;
+
+	// oR_̐擪݈͌ʒuȂ̂Ŏ̓_
+	// BłȂꍇ͂̏Ŏ~܂
+	m_bIsMove = eState == PathState::Ready && m_PathVec.size() > 1;
+	m_nPathIndex = 1;
+	pPathService->Release(m_nPathHandle);
+	m_nPathHandle = CPathService::ce_nInvalidHandle;
+}
+
+/*****************************************//*
+	@brief@	| XL̔
+*//*****************************************/
+void CPlayer::CastSkill()
+{
+	if (m_fStunTime > 0.0f) return;
+
+	CSkillEngine* pEngine = CSkillEngine::GetInstance();
+	int nSkillNum = (std::min)(static_cast<int>(pEngine->GetSkillNum()), ce_nSkillKeyNum);
+	for (int i = 0; i < nSkillNum; i++)
+	{
+		// ɍ킹ăL[̏Ԃ(ĂԂ̓N[^Cɔ)
+		const SkillProgram& tSkill = pEngine->GetSkill(static_cast<SkillId>(i));
+		BYTE nKey = static_cast<BYTE>('1' + i);
+		bool bCast = false;
+		switch (tSkill.m_eTrigger)
+		{
+		case SkillTrigger::Press:	bCast = IsKeyTrigger(nKey); break;
+		case SkillTrigger::Hold:	bCast = IsKeyPress(nKey); break;
+		case SkillTrigger::Release:	bCast = IsKeyRelease(nKey); break;
+		}
+		if (!bCast) continue;
+
+		// }EXŎwtB[ḧʒuɌĔ
+		const DirectX::XMFLOAT3 hitOnField = GetScene()->GetGameObject<CField>()->GetMovePos();
+		pEngine->Cast(m_nCasterId, static_cast<SkillId>(i), { m_tParam.m_f3Pos.x, m_tParam.m_f3Pos.z },
+			{ hitOnField.x - m_tParam.m_f3Pos.x, hitOnField.z - m_tParam.m_f3Pos.z });
+	}
+}
+
+/*****************************************//*
+	@brief@	| XĽʂ󂯂̏
+	@param@	| inEventF
+*//*****************************************/
+void CPlayer::OnSkillEffect(const SkillEffectEvent& inEvent)
+{
+	// ̗͂Ȃ߁A_[WƉ񕜂͎󂯂Ȃ
+	switch (inEvent.m_eType)
+	{
+	case SkillEffectType::Knockback:
+		m_tParam.m_f3Pos.x += inEvent.m_tDirection.m_fX * inEvent.m_fValue;
+		m_tParam.m_f3Pos.z += inEvent.m_tDirection.m_fZ * inEvent.m_fValue;
+		break;
+	case SkillEffectType::Slow:
+		m_fSlowTime = (std::max)(m_fSlowTime, inEvent.m_fDuration);
+		m_fSlowRate = (std::min)((std::max)(inEvent.m_fValue, 0.0f), 1.0f);
+		break;
+	case SkillEffectType::Stun:
+		m_fStunTime = (std::max)(m_fStunTime, inEvent.m_fDuration);
+		break;
+	default:
+		break;
+	}
 }
\ No newline at end of file
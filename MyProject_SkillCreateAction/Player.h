@@ -5,6 +5,9 @@
 *//**************************************************/
 #pragma once
 #include "Entity.h"
+#include "PathService.h"
+#include "SkillEngine.h"
+#include <vector>
 
 // @brief vC[NX
 class CPlayer final:  public CEntity
@@ -26,12 +29,45 @@ public:
 	// @brief `揈
 	virtual void Draw() override;
 
+	// @brief XĽʂ󂯂̏
+	// @param inEventF
+	virtual void OnSkillEffect(const SkillEffectEvent& inEvent) override;
+
 private:
 	// @brief ړ
 	void Move();
 
+	// @brief voH̎󂯎
+	// @note oHTT[rX̌ʂo܂ł͈ړȂ
+	void ReceivePath();
+
+	// @brief XL̔
+	// @note 1`4L[ɓǂݍݏ̃XL蓖āAɍ킹ĉEĂԁEɔ
+	void CastSkill();
+
 private:
 	DirectX::XMFLOAT3 m_f3TargetPos;
 	bool m_bIsMove;
+
+	// @brief v̌oH̔ԍ
+	PathHandle m_nPathHandle;
+
+	// @brief ڕWʒu܂ł̌oR_
+	std::vector<NavPoint> m_PathVec;
+
+	// @brief ɌoR_̔ԍ
+	size_t m_nPathIndex;
+
+	// @brief XL̎gp҂̔ԍ
+	SkillCasterId m_nCasterId;
+
+	// @brief ̎c莞
+	float m_fSlowTime;
+
+	// @brief ̊
+	float m_fSlowRate;
+
+	// @brief ss\̎c莞
+	float m_fStunTime;
 };
 
@@ -0,0 +1,584 @@
+/**************************************************//*
+	@file	| ProjectileSystem.cpp
+	@brief	| 弾の一括シミュレーションクラスのcppファイル
+	@note	| 弾の位置・速度・寿命・半径を要素毎の配列(SoA)で持ち、
+			| 移動と寿命の更新を単純なループでまとめて行う
+			| 当たり判定は登録された箱をグリッドに振り分けた上で、
+			| 1フレームの移動を球を掃引して調べる(速い弾もすり抜けない)
+			| 弾の生成と破棄は空き番号のリストと末尾との入れ替えでO(1)
+*//**************************************************/
+#include "ProjectileSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+namespace
+{
+	// @brief 番号の枠の部分のビット数
+	constexpr uint32_t ce_nSlotBits = 20;
+
+	// @brief 番号の枠の部分のマスク
+	constexpr uint32_t ce_nSlotMask = (1u << ce_nSlotBits) - 1;
+
+	// @brief 空いている枠の並びの番号
+	constexpr uint32_t ce_nFreeIndex = ce_nSlotMask;
+
+	// @brief グリッドのバケットの数(2のべき乗)
+	constexpr uint32_t ce_nBucketNum = 16384;
+
+	// @brief これより多くのセルに跨る箱はグリッドに入れずに全ての弾で調べる
+	constexpr int ce_nMaxColliderCell = 64;
+
+	// @brief 移動しないとみなす速度
+	constexpr float ce_fEpsilon = 1e-8f;
+
+	// @brief 線分を半径だけ広げた箱に対して掃引判定する
+	// @param inStart：始点(XYZ)
+	// @param inMove：移動量(XYZ)
+	// @param inRadius：半径
+	// @param inCollider：箱
+	// @param ioT：これまでに見つかった一番早い時刻(より早く当たった場合に上書きする)
+	// @return true:より早く当たった false:当たらない
+	// @note 箱の角は丸めずに半径だけ広げるため、角の近くは少し早めに当たる
+	bool SweepBox(const float* inStart, const float* inMove, float inRadius, const ProjectileCollider& inCollider, float& ioT)
+	{
+		float fEnter = 0.0f;
+		float fExit = ioT;
+		for (int i = 0; i < 3; i++)
+		{
+			float fMin = inCollider.m_fMin[i] - inRadius;
+			float fMax = inCollider.m_fMax[i] + inRadius;
+			if (fabsf(inMove[i]) < ce_fEpsilon)
+			{
+				// この軸に動かない場合は始点が範囲内かどうかだけ
+				if (inStart[i] < fMin || inStart[i] > fMax) return false;
+				continue;
+			}
+
+			float fInv = 1.0f / inMove[i];
+			float fT0 = (fMin - inStart[i]) * fInv;
+			float fT1 = (fMax - inStart[i]) * fInv;
+			if (fT0 > fT1) std::swap(fT0, fT1);
+			fEnter = (std::max)(fEnter, fT0);
+			fExit = (std::min)(fExit, fT1);
+			if (fEnter > fExit) return false;
+		}
+
+		if (fEnter >= ioT) return false;
+		ioT = fEnter;
+		return true;
+	}
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CProjectileSystem::CProjectileSystem()
+	: m_nNum(0)
+	, m_fCellSize(ce_fDefaultCellSize)
+	, m_bGridDirty(true)
+	, m_tCount{}
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CProjectileSystem::~CProjectileSystem()
+{
+}
+
+/****************************************//*
+	@brief　	| 弾の配列を確保する
+	@param　	| inCapacity：同時に飛ばせる弾の数
+*//****************************************/
+void CProjectileSystem::Init(uint32_t inCapacity)
+{
+	// 空きを表す並びの番号と重ならないよう、枠の部分で表せる数より1つ少なくする
+	inCapacity = (std::min)(inCapacity, ce_nMaxCapacity - 1);
+
+	for (std::vector<float>* pVec : { &m_PosXVec, &m_PosYVec, &m_PosZVec, &m_VelXVec, &m_VelYVec, &m_VelZVec, &m_LifeVec, &m_RadiusVec, &m_MoveVec })
+	{
+		pVec->assign(inCapacity, 0.0f);
+	}
+	m_OwnerVec.assign(inCapacity, 0);
+	m_UserDataVec.assign(inCapacity, 0);
+	m_SlotOfVec.assign(inCapacity, 0);
+	m_SlotVec.assign(inCapacity, ce_nFreeIndex);
+
+	// 若い枠から取り出せるように逆順に積む
+	m_FreeSlotVec.resize(inCapacity);
+	for (uint32_t i = 0; i < inCapacity; i++) m_FreeSlotVec[i] = inCapacity - 1 - i;
+
+	// 命中は1回の更新で最大で全ての弾
+	m_HitVec.clear();
+	m_HitVec.reserve(inCapacity);
+	m_nNum = 0;
+}
+
+/****************************************//*
+	@brief　	| 弾を生成する
+	@param　	| inDesc：生成情報
+	@return		| 弾の番号(上限に達していればce_nInvalidHandle)
+*//****************************************/
+ProjectileHandle CProjectileSystem::Spawn(const ProjectileDesc& inDesc)
+{
+	if (m_FreeSlotVec.empty()) return ce_nInvalidHandle;
+
+	uint32_t nSlot = m_FreeSlotVec.back();
+	m_FreeSlotVec.pop_back();
+
+	// 末尾に詰めて追加する
+	uint32_t nIndex = m_nNum++;
+	m_PosXVec[nIndex] = inDesc.m_fPos[0];
+	m_PosYVec[nIndex] = inDesc.m_fPos[1];
+	m_PosZVec[nIndex] = inDesc.m_fPos[2];
+	m_VelXVec[nIndex] = inDesc.m_fVelocity[0];
+	m_VelYVec[nIndex] = inDesc.m_fVelocity[1];
+	m_VelZVec[nIndex] = inDesc.m_fVelocity[2];
+	m_LifeVec[nIndex] = inDesc.m_fLife;
+	m_RadiusVec[nIndex] = inDesc.m_fRadius;
+	m_OwnerVec[nIndex] = inDesc.m_nOwner;
+	m_UserDataVec[nIndex] = inDesc.m_nUserData;
+	m_SlotOfVec[nIndex] = nSlot;
+
+	uint32_t nGeneration = m_SlotVec[nSlot] & ~ce_nSlotMask;
+	m_SlotVec[nSlot] = nGeneration | nIndex;
+	m_tCount.m_nSpawnNum++;
+	return nGeneration | nSlot;
+}
+
+/****************************************//*
+	@brief　	| 弾を破棄する
+	@param　	| inHandle：弾の番号
+	@return		| true:破棄した false:既に無い
+*//****************************************/
+bool CProjectileSystem::Despawn(ProjectileHandle inHandle)
+{
+	if (!IsAlive(inHandle)) return false;
+
+	RemoveAt(m_SlotVec[inHandle & ce_nSlotMask] & ce_nSlotMask);
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 全ての弾を破棄する
+*//****************************************/
+void CProjectileSystem::Clear()
+{
+	while (m_nNum > 0) RemoveAt(m_nNum - 1);
+}
+
+/****************************************//*
+	@brief　	| 弾が飛んでいるか
+	@param　	| inHandle：弾の番号
+	@return		| true:飛んでいる false:破棄済み
+*//****************************************/
+bool CProjectileSystem::IsAlive(ProjectileHandle inHandle) const
+{
+	uint32_t nSlot = inHandle & ce_nSlotMask;
+	if (nSlot >= m_SlotVec.size()) return false;
+
+	uint32_t nEntry = m_SlotVec[nSlot];
+	return (nEntry & ce_nSlotMask) != ce_nFreeIndex && (nEntry & ~ce_nSlotMask) == (inHandle & ~ce_nSlotMask);
+}
+
+/****************************************//*
+	@brief　	| 登録した箱を全て外す
+*//****************************************/
+void CProjectileSystem::ClearColliders()
+{
+	m_ColliderVec.clear();
+	m_bGridDirty = true;
+}
+
+/****************************************//*
+	@brief　	| 箱を登録する
+	@param　	| inCollider：箱
+*//****************************************/
+void CProjectileSystem::AddCollider(const ProjectileCollider& inCollider)
+{
+	m_ColliderVec.push_back(inCollider);
+	m_bGridDirty = true;
+}
+
+/****************************************//*
+	@brief　	| 箱を振り分けるグリッドのセルの大きさを設定
+	@param　	| inCellSize：セルの大きさ
+*//****************************************/
+void CProjectileSystem::SetCellSize(float inCellSize)
+{
+	m_fCellSize = (std::max)(inCellSize, 0.01f);
+	m_bGridDirty = true;
+}
+
+/****************************************//*
+	@brief　	| 更新
+	@param　	| inDeltaTime：経過時間(秒)
+*//****************************************/
+void CProjectileSystem::Update(float inDeltaTime)
+{
+	auto tStart = std::chrono::high_resolution_clock::now();
+	m_HitVec.clear();
+	if (m_bGridDirty) BuildGrid();
+
+	const uint32_t nNum = m_nNum;
+
+	// 当たり判定：箱が無ければ全ての弾が最後まで進む
+	float* pMove = m_MoveVec.data();
+	std::fill_n(pMove, nNum, 1.0f);
+	if (!m_ColliderVec.empty())
+	{
+		for (uint32_t i = 0; i < nNum; i++)
+		{
+			float fT;
+			uint32_t nCollider;
+			if (!Sweep(i, inDeltaTime, fT, nCollider)) continue;
+
+			pMove[i] = fT;
+			ProjectileHit tHit;
+			tHit.m_nHandle = (m_SlotVec[m_SlotOfVec[i]] & ~ce_nSlotMask) | m_SlotOfVec[i];
+			tHit.m_nColliderId = m_ColliderVec[nCollider].m_nId;
+			tHit.m_nColliderIndex = nCollider;
+			tHit.m_nOwner = m_OwnerVec[i];
+			tHit.m_nUserData = m_UserDataVec[i];
+			tHit.m_fPos[0] = m_PosXVec[i] + m_VelXVec[i] * inDeltaTime * fT;
+			tHit.m_fPos[1] = m_PosYVec[i] + m_VelYVec[i] * inDeltaTime * fT;
+			tHit.m_fPos[2] = m_PosZVec[i] + m_VelZVec[i] * inDeltaTime * fT;
+			tHit.m_fVelocity[0] = m_VelXVec[i];
+			tHit.m_fVelocity[1] = m_VelYVec[i];
+			tHit.m_fVelocity[2] = m_VelZVec[i];
+			m_HitVec.push_back(tHit);
+		}
+	}
+
+	// 移動と寿命：要素毎の配列を分岐なしで回し、コンパイラのベクトル化に任せる
+	{
+		float* __restrict pPosX = m_PosXVec.data();
+		float* __restrict pPosY = m_PosYVec.data();
+		float* __restrict pPosZ = m_PosZVec.data();
+		const float* __restrict pVelX = m_VelXVec.data();
+		const float* __restrict pVelY = m_VelYVec.data();
+		const float* __restrict pVelZ = m_VelZVec.data();
+		float* __restrict pLife = m_LifeVec.data();
+		const float* __restrict pStep = pMove;
+		for (uint32_t i = 0; i < nNum; i++)
+		{
+			float fStep = pStep[i] * inDeltaTime;
+			pPosX[i] += pVelX[i] * fStep;
+			pPosY[i] += pVelY[i] * fStep;
+			pPosZ[i] += pVelZ[i] * fStep;
+			pLife[i] -= inDeltaTime;
+		}
+	}
+
+	// 当たった弾と寿命が尽きた弾を破棄する(後ろから見るため、入れ替えで来た弾は確認済み)
+	int nExpireNum = 0;
+	for (uint32_t i = nNum; i-- > 0;)
+	{
+		if (pMove[i] < 1.0f)
+		{
+			RemoveAt(i);
+		}
+		else if (m_LifeVec[i] <= 0.0f)
+		{
+			RemoveAt(i);
+			nExpireNum++;
+		}
+	}
+
+	m_tCount.m_nActiveNum = static_cast<int>(m_nNum);
+	m_tCount.m_nHitNum = static_cast<int>(m_HitVec.size());
+	m_tCount.m_nExpireNum = nExpireNum;
+	m_tCount.m_dUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+	m_tStats = m_tCount;
+	m_tCount = {};
+}
+
+/****************************************//*
+	@brief　	| 箱をグリッドに振り分ける
+*//****************************************/
+void CProjectileSystem::BuildGrid()
+{
+	m_bGridDirty = false;
+	m_LargeColliderVec.clear();
+	m_BucketStartVec.assign(ce_nBucketNum + 1, 0);
+
+	// 1回目で箱が入るバケット毎の数を数え、2回目で詰める
+	for (int nPass = 0; nPass < 2; nPass++)
+	{
+		if (nPass == 1)
+		{
+			for (uint32_t i = 1; i <= ce_nBucketNum; i++) m_BucketStartVec[i] += m_BucketStartVec[i - 1];
+			m_BucketEntryVec.resize(m_BucketStartVec[ce_nBucketNum]);
+			m_BucketColliderVec.resize(m_BucketStartVec[ce_nBucketNum]);
+		}
+
+		for (uint32_t i = 0; i < m_ColliderVec.size(); i++)
+		{
+			const ProjectileCollider& tCollider = m_ColliderVec[i];
+			int nMinX = ToCell(tCollider.m_fMin[0]), nMaxX = ToCell(tCollider.m_fMax[0]);
+			int nMinZ = ToCell(tCollider.m_fMin[2]), nMaxZ = ToCell(tCollider.m_fMax[2]);
+			if ((nMaxX - nMinX + 1) * (nMaxZ - nMinZ + 1) > ce_nMaxColliderCell)
+			{
+				if (nPass == 0) m_LargeColliderVec.push_back(i);
+				continue;
+			}
+
+			for (int z = nMinZ; z <= nMaxZ; z++)
+			{
+				for (int x = nMinX; x <= nMaxX; x++)
+				{
+					// 2回目は各バケットの末尾から詰めていき、終わると先頭の位置になる
+					uint32_t nBucket = GetBucket(x, z);
+					if (nPass == 0)
+					{
+						m_BucketStartVec[nBucket + 1]++;
+						continue;
+					}
+					uint32_t nEntry = --m_BucketStartVec[nBucket + 1];
+					m_BucketEntryVec[nEntry] = i;
+					m_BucketColliderVec[nEntry] = tCollider;
+				}
+			}
+		}
+	}
+
+	// 末尾から詰めたため、1つ後ろのバケットの位置が先頭になっている
+	for (uint32_t i = 0; i < ce_nBucketNum; i++) m_BucketStartVec[i] = m_BucketStartVec[i + 1];
+	m_BucketStartVec[ce_nBucketNum] = static_cast<uint32_t>(m_BucketEntryVec.size());
+}
+
+/****************************************//*
+	@brief　	| 1発分の移動を箱と掃引判定する
+	@param　	| inIndex：弾の並びの番号
+	@param　	| inDeltaTime：経過時間(秒)
+	@param　	| outT：当たった時刻(移動量に対する割合)
+	@param　	| outCollider：当たった箱の登録順の番号
+	@return		| true:当たった false:当たらない
+*//****************************************/
+bool CProjectileSystem::Sweep(uint32_t inIndex, float inDeltaTime, float& outT, uint32_t& outCollider)
+{
+	const float fStart[3] = { m_PosXVec[inIndex], m_PosYVec[inIndex], m_PosZVec[inIndex] };
+	const float fMove[3] = { m_VelXVec[inIndex] * inDeltaTime, m_VelYVec[inIndex] * inDeltaTime, m_VelZVec[inIndex] * inDeltaTime };
+	const float fRadius = m_RadiusVec[inIndex];
+	const uint32_t nOwner = m_OwnerVec[inIndex];
+
+	// 1を超えた時刻は当たらなかったことを表す
+	float fT = 1.0f + ce_fEpsilon;
+	uint32_t nHit = UINT32_MAX;
+	auto Test = [&](const ProjectileCollider& inCollider, uint32_t inIndex)
+	{
+		if (inCollider.m_nId == nOwner) return;
+		m_tCount.m_nTestNum++;
+		if (SweepBox(fStart, fMove, fRadius, inCollider, fT)) nHit = inIndex;
+	};
+
+	for (uint32_t nCollider : m_LargeColliderVec) Test(m_ColliderVec[nCollider], nCollider);
+
+	// 移動の範囲を半径だけ広げたセルを調べる(別のセルの箱が同じバケットに入っていても判定で除かれる)
+	int nMinX = ToCell((std::min)(fStart[0], fStart[0] + fMove[0]) - fRadius);
+	int nMaxX = ToCell((std::max)(fStart[0], fStart[0] + fMove[0]) + fRadius);
+	int nMinZ = ToCell((std::min)(fStart[2], fStart[2] + fMove[2]) - fRadius);
+	int nMaxZ = ToCell((std::max)(fStart[2], fStart[2] + fMove[2]) + fRadius);
+	for (int z = nMinZ; z <= nMaxZ; z++)
+	{
+		for (int x = nMinX; x <= nMaxX; x++)
+		{
+			uint32_t nBucket = GetBucket(x, z);
+			for (uint32_t i = m_BucketStartVec[nBucket]; i < m_BucketStartVec[nBucket + 1]; i++) Test(m_BucketColliderVec[i], m_BucketEntryVec[i]);
+		}
+	}
+
+	if (nHit == UINT32_MAX) return false;
+	outT = (std::min)(fT, 1.0f - ce_fEpsilon);
+	outCollider = nHit;
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 並びの番号の弾を末尾の弾と入れ替えて破棄する
+	@param　	| inIndex：弾の並びの番号
+*//****************************************/
+void CProjectileSystem::RemoveAt(uint32_t inIndex)
+{
+	uint32_t nSlot = m_SlotOfVec[inIndex];
+	uint32_t nLast = --m_nNum;
+	if (inIndex != nLast)
+	{
+		m_PosXVec[inIndex] = m_PosXVec[nLast];
+		m_PosYVec[inIndex] = m_PosYVec[nLast];
+		m_PosZVec[inIndex] = m_PosZVec[nLast];
+		m_VelXVec[inIndex] = m_VelXVec[nLast];
+		m_VelYVec[inIndex] = m_VelYVec[nLast];
+		m_VelZVec[inIndex] = m_VelZVec[nLast];
+		m_LifeVec[inIndex] = m_LifeVec[nLast];
+		m_RadiusVec[inIndex] = m_RadiusVec[nLast];
+		m_MoveVec[inIndex] = m_MoveVec[nLast];
+		m_OwnerVec[inIndex] = m_OwnerVec[nLast];
+		m_UserDataVec[inIndex] = m_UserDataVec[nLast];
+
+		uint32_t nMovedSlot = m_SlotOfVec[nLast];
+		m_SlotOfVec[inIndex] = nMovedSlot;
+		m_SlotVec[nMovedSlot] = (m_SlotVec[nMovedSlot] & ~ce_nSlotMask) | inIndex;
+	}
+
+	// 世代を進めて古い番号を無効にする
+	uint32_t nGeneration = (m_SlotVec[nSlot] & ~ce_nSlotMask) + (1u << ce_nSlotBits);
+	m_SlotVec[nSlot] = nGeneration | ce_nFreeIndex;
+	m_FreeSlotVec.push_back(nSlot);
+}
+
+/****************************************//*
+	@brief　	| セル座標からバケットの番号を求める
+	@param　	| inX：X方向のセル座標
+	@param　	| inZ：Z方向のセル座標
+	@return		| バケットの番号
+*//****************************************/
+uint32_t CProjectileSystem::GetBucket(int inX, int inZ) const
+{
+	// 範囲の決まっていないグリッドを固定数のバケットに畳み込む
+	uint32_t nHash = static_cast<uint32_t>(inX) * 73856093u ^ static_cast<uint32_t>(inZ) * 19349663u;
+	return nHash & (ce_nBucketNum - 1);
+}
+
+/****************************************//*
+	@brief　	| 座標をセル座標に直す
+	@param　	| inPos：座標
+	@return		| セル座標
+*//****************************************/
+int CProjectileSystem::ToCell(float inPos) const
+{
+	return static_cast<int>(floorf(inPos / m_fCellSize));
+}
+
+/****************************************//*
+	@brief　	| 5万発の弾を飛ばし続けて計測して書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CProjectileSystem::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr uint32_t ce_nProjectileNum = 50000;
+	static constexpr uint32_t ce_nColliderNum = 2000;
+	static constexpr int ce_nFrameNum = 300;
+	static constexpr float ce_fMapSize = 1024.0f;
+	static constexpr float ce_fDeltaTime = 1.0f / 60.0f;
+	char szLine[256];
+	bool bSuccess = true;
+
+	// 速い弾が薄い壁をすり抜けないこと、持ち主の箱には当たらないことを確かめる
+	{
+		CProjectileSystem tSystem;
+		tSystem.Init(4);
+		tSystem.AddCollider({ { 9.0f, -1.0f, -1.0f }, { 9.05f, 1.0f, 1.0f }, 1 });
+		tSystem.AddCollider({ { 20.0f, -1.0f, -1.0f }, { 20.05f, 1.0f, 1.0f }, 2 });
+		tSystem.AddCollider({ { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f }, 7 });
+		ProjectileHandle nHandle = tSystem.Spawn({ { 0.0f, 0.0f, 0.0f }, { 3000.0f, 0.0f, 0.0f }, 1.0f, 0.25f, 7, 42 });
+		tSystem.Update(ce_fDeltaTime);
+
+		const std::vector<ProjectileHit>& tHitVec = tSystem.GetHits();
+		bool bHit = tHitVec.size() == 1 && tHitVec[0].m_nColliderId == 1 && tHitVec[0].m_nUserData == 42
+			&& fabsf(tHitVec[0].m_fPos[0] - 8.75f) < 1e-3f && !tSystem.IsAlive(nHandle) && tSystem.GetNum() == 0;
+		sprintf_s(szLine, "sweep check (50 units/frame vs 0.05 wall, owner skip)  %s\n", bHit ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bHit;
+	}
+
+	std::mt19937 tRandom(20261019);
+	std::uniform_real_distribution<float> tPos(0.0f, ce_fMapSize);
+	std::uniform_real_distribution<float> tHeight(0.5f, 3.5f);
+	std::uniform_real_distribution<float> tAngle(0.0f, 6.2831853f);
+	std::uniform_real_distribution<float> tSpeed(10.0f, 60.0f);
+	std::uniform_real_distribution<float> tLife(0.5f, 3.0f);
+	std::uniform_real_distribution<float> tRadius(0.1f, 0.5f);
+	std::uniform_real_distribution<float> tHalf(0.5f, 3.0f);
+
+	// 生成情報は計測の外で先に作る(足りなくなったら先頭から使い回す)
+	std::vector<ProjectileDesc> tDescVec(ce_nProjectileNum * 2);
+	for (ProjectileDesc& tDesc : tDescVec)
+	{
+		float fAngle = tAngle(tRandom), fSpeed = tSpeed(tRandom);
+		tDesc = { { tPos(tRandom), tHeight(tRandom), tPos(tRandom) }, { cosf(fAngle) * fSpeed, 0.0f, sinf(fAngle) * fSpeed },
+			tLife(tRandom), tRadius(tRandom), UINT32_MAX, 0 };
+	}
+	std::vector<ProjectileCollider> tColliderVec(ce_nColliderNum);
+	for (uint32_t i = 0; i < ce_nColliderNum; i++)
+	{
+		float fX = tPos(tRandom), fZ = tPos(tRandom), fHalfX = tHalf(tRandom), fHalfZ = tHalf(tRandom);
+		tColliderVec[i] = { { fX - fHalfX, 0.0f, fZ - fHalfZ }, { fX + fHalfX, 4.0f, fZ + fHalfZ }, i };
+	}
+
+	// 生成と破棄：全て生成してから順番をばらばらにして全て破棄する
+	{
+		CProjectileSystem tSystem;
+		tSystem.Init(ce_nProjectileNum);
+		std::vector<ProjectileHandle> tHandleVec(ce_nProjectileNum);
+		auto tStart = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < ce_nProjectileNum; i++) tHandleVec[i] = tSystem.Spawn(tDescVec[i]);
+		double dSpawnMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		std::shuffle(tHandleVec.begin(), tHandleVec.end(), tRandom);
+		tStart = std::chrono::high_resolution_clock::now();
+		uint32_t nDespawnNum = 0;
+		for (ProjectileHandle nHandle : tHandleVec) nDespawnNum += tSystem.Despawn(nHandle) ? 1 : 0;
+		double dDespawnMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		bool bCheck = nDespawnNum == ce_nProjectileNum && tSystem.GetNum() == 0 && !tSystem.Despawn(tHandleVec[0]);
+		sprintf_s(szLine, "spawn %u  %.1f ns/spawn  despawn (random order) %.1f ns/despawn  stale handle check %s\n",
+			ce_nProjectileNum, dSpawnMs * 1e6 / ce_nProjectileNum, dDespawnMs * 1e6 / ce_nProjectileNum, bCheck ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bCheck;
+	}
+
+	// 箱なし(移動と寿命だけ)と箱あり(掃引判定込み)で、消えた分を毎フレーム補充して5万発を保つ
+	for (bool isCollide : { false, true })
+	{
+		CProjectileSystem tSystem;
+		tSystem.Init(ce_nProjectileNum);
+		if (isCollide)
+		{
+			for (const ProjectileCollider& tCollider : tColliderVec) tSystem.AddCollider(tCollider);
+		}
+
+		size_t nNextDesc = 0;
+		long long nHitNum = 0, nExpireNum = 0, nTestNum = 0, nSpawnNum = 0;
+		double dUpdateMs = 0.0, dMaxUpdateMs = 0.0, dSpawnMs = 0.0;
+		for (int nFrame = 0; nFrame < ce_nFrameNum; nFrame++)
+		{
+			auto tStart = std::chrono::high_resolution_clock::now();
+			while (tSystem.GetNum() < ce_nProjectileNum)
+			{
+				tSystem.Spawn(tDescVec[nNextDesc]);
+				nNextDesc = (nNextDesc + 1) % tDescVec.size();
+			}
+			dSpawnMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+			tSystem.Update(ce_fDeltaTime);
+			const ProjectileStats& tStats = tSystem.GetStats();
+			dUpdateMs += tStats.m_dUpdateMs;
+			dMaxUpdateMs = (std::max)(dMaxUpdateMs, tStats.m_dUpdateMs);
+			nHitNum += tStats.m_nHitNum;
+			nExpireNum += tStats.m_nExpireNum;
+			nTestNum += tStats.m_nTestNum;
+			nSpawnNum += tStats.m_nSpawnNum;
+		}
+
+		sprintf_s(szLine, "%-9s active %u  frame %d  update %.3f ms/frame (max %.3f, %.1f ns/projectile)  refill %.3f ms/frame (%lld)\n",
+			isCollide ? "collide" : "move", ce_nProjectileNum, ce_nFrameNum, dUpdateMs / ce_nFrameNum, dMaxUpdateMs,
+			dUpdateMs * 1e6 / (static_cast<double>(ce_nProjectileNum) * ce_nFrameNum), dSpawnMs / ce_nFrameNum, nSpawnNum);
+		tReport << szLine;
+		sprintf_s(szLine, "          collider %u  hit %lld  expire %lld  box test %.2f/projectile\n",
+			isCollide ? ce_nColliderNum : 0, nHitNum, nExpireNum, static_cast<double>(nTestNum) / (static_cast<double>(ce_nProjectileNum) * ce_nFrameNum));
+		tReport << szLine;
+	}
+
+	return bSuccess ? 0 : 1;
+}
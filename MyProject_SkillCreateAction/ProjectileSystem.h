@@ -0,0 +1,282 @@
+/**************************************************//*
+	@file	| ProjectileSystem.h
+	@brief	| 弾の一括シミュレーションクラスのhファイル
+	@note	| 弾の位置・速度・寿命・半径を要素毎の配列(SoA)で持ち、
+			| 移動と寿命の更新を単純なループでまとめて行う
+			| 当たり判定は登録された箱をグリッドに振り分けた上で、
+			| 1フレームの移動を球を掃引して調べる(速い弾もすり抜けない)
+			| 弾の生成と破棄は空き番号のリストと末尾との入れ替えでO(1)
+*//**************************************************/
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// @brief 弾の番号(下位20bit:枠 上位12bit:世代)
+using ProjectileHandle = uint32_t;
+
+// @brief 弾が当たる箱
+struct ProjectileCollider
+{
+	// 最小の座標(XYZ)
+	float m_fMin[3];
+
+	// 最大の座標(XYZ)
+	float m_fMax[3];
+
+	// 番号(弾の持ち主と同じ番号には当たらない)
+	uint32_t m_nId;
+};
+
+// @brief 弾の生成情報
+struct ProjectileDesc
+{
+	// 位置(XYZ)
+	float m_fPos[3];
+
+	// 速度(XYZ、1秒あたり)
+	float m_fVelocity[3];
+
+	// 寿命(秒)
+	float m_fLife;
+
+	// 当たりの半径
+	float m_fRadius;
+
+	// 持ち主の番号(同じ番号の箱には当たらない)
+	uint32_t m_nOwner;
+
+	// 使う側が自由に使う値(命中時にそのまま返す)
+	uint64_t m_nUserData;
+};
+
+// @brief 弾が当たった情報
+struct ProjectileHit
+{
+	// 当たった弾の番号(既に破棄されている)
+	ProjectileHandle m_nHandle;
+
+	// 当たった箱の番号
+	uint32_t m_nColliderId;
+
+	// 当たった箱の登録順の番号
+	uint32_t m_nColliderIndex;
+
+	// 持ち主の番号
+	uint32_t m_nOwner;
+
+	// 使う側が自由に使う値
+	uint64_t m_nUserData;
+
+	// 当たった時の弾の中心(XYZ)
+	float m_fPos[3];
+
+	// 速度(XYZ)
+	float m_fVelocity[3];
+};
+
+// @brief 弾の一括シミュレーションの統計情報(直前の更新1回分)
+struct ProjectileStats
+{
+	// 飛んでいる弾の数
+	int m_nActiveNum;
+
+	// 生成した数
+	int m_nSpawnNum;
+
+	// 当たった数
+	int m_nHitNum;
+
+	// 寿命で消えた数
+	int m_nExpireNum;
+
+	// 箱との掃引判定の回数
+	int m_nTestNum;
+
+	// 更新にかかった時間(ミリ秒)
+	double m_dUpdateMs;
+};
+
+// @brief 弾の一括シミュレーションクラス
+class CProjectileSystem
+{
+public:
+	// @brief 無効な番号
+	static constexpr ProjectileHandle ce_nInvalidHandle = UINT32_MAX;
+
+	// @brief 同時に飛ばせる弾の上限(番号の枠の部分で表せる数)
+	static constexpr uint32_t ce_nMaxCapacity = 1u << 20;
+
+	// @brief 箱を振り分けるグリッドのセルの大きさの初期値
+	static constexpr float ce_fDefaultCellSize = 4.0f;
+
+public:
+	// @brief コンストラクタ
+	CProjectileSystem();
+
+	// @brief デストラクタ
+	~CProjectileSystem();
+
+	// @brief 弾の配列を確保する
+	// @param inCapacity：同時に飛ばせる弾の数
+	// @note 飛んでいる弾は全て破棄される
+	void Init(uint32_t inCapacity);
+
+	// @brief 弾を生成する
+	// @param inDesc：生成情報
+	// @return 弾の番号(上限に達していればce_nInvalidHandle)
+	ProjectileHandle Spawn(const ProjectileDesc& inDesc);
+
+	// @brief 弾を破棄する
+	// @param inHandle：弾の番号
+	// @return true:破棄した false:既に無い
+	bool Despawn(ProjectileHandle inHandle);
+
+	// @brief 全ての弾を破棄する
+	void Clear();
+
+	// @brief 弾が飛んでいるか
+	// @param inHandle：弾の番号
+	bool IsAlive(ProjectileHandle inHandle) const;
+
+	// @brief 登録した箱を全て外す
+	void ClearColliders();
+
+	// @brief 箱を登録する
+	// @param inCollider：箱
+	// @note 次の更新で振り分け直す
+	void AddCollider(const ProjectileCollider& inCollider);
+
+	// @brief 箱を振り分けるグリッドのセルの大きさを設定
+	// @param inCellSize：セルの大きさ
+	void SetCellSize(float inCellSize);
+
+	// @brief 更新
+	// @param inDeltaTime：経過時間(秒)
+	// @note 当たった弾と寿命が尽きた弾は破棄され、当たった弾はGetHitsで受け取れる
+	void Update(float inDeltaTime);
+
+	// @brief 直前の更新で当たった弾の取得
+	const std::vector<ProjectileHit>& GetHits() const { return m_HitVec; }
+
+	// @brief 登録した箱の取得
+	// @param inIndex：登録順の番号
+	const ProjectileCollider& GetCollider(uint32_t inIndex) const { return m_ColliderVec[inIndex]; }
+
+	// @brief 飛んでいる弾の数の取得
+	uint32_t GetNum() const { return m_nNum; }
+
+	// @brief 同時に飛ばせる弾の数の取得
+	uint32_t GetCapacity() const { return static_cast<uint32_t>(m_SlotVec.size()); }
+
+	// @brief 弾の位置の取得(GetNumまでが飛んでいる弾、順番は生成や破棄で入れ替わる)
+	const float* GetPosX() const { return m_PosXVec.data(); }
+	const float* GetPosY() const { return m_PosYVec.data(); }
+	const float* GetPosZ() const { return m_PosZVec.data(); }
+
+	// @brief 弾の速度の取得(GetPosXと同じ並び)
+	const float* GetVelocityX() const { return m_VelXVec.data(); }
+	const float* GetVelocityY() const { return m_VelYVec.data(); }
+	const float* GetVelocityZ() const { return m_VelZVec.data(); }
+
+	// @brief 弾の半径の取得(GetPosXと同じ並び)
+	const float* GetRadius() const { return m_RadiusVec.data(); }
+
+	// @brief 統計情報の取得
+	// @return 直前の更新の統計情報
+	const ProjectileStats& GetStats() const { return m_tStats; }
+
+	// @brief 5万発の弾を飛ばし続けて計測して書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief 箱をグリッドに振り分ける
+	void BuildGrid();
+
+	// @brief 1発分の移動を箱と掃引判定する
+	// @param inIndex：弾の並びの番号
+	// @param inDeltaTime：経過時間(秒)
+	// @param outT：当たった時刻(移動量に対する割合)
+	// @param outCollider：当たった箱の登録順の番号
+	// @return true:当たった false:当たらない
+	bool Sweep(uint32_t inIndex, float inDeltaTime, float& outT, uint32_t& outCollider);
+
+	// @brief 並びの番号の弾を末尾の弾と入れ替えて破棄する
+	// @param inIndex：弾の並びの番号
+	void RemoveAt(uint32_t inIndex);
+
+	// @brief セル座標からバケットの番号を求める
+	uint32_t GetBucket(int inX, int inZ) const;
+
+	// @brief 座標をセル座標に直す
+	int ToCell(float inPos) const;
+
+private:
+	// @brief 飛んでいる弾の数
+	uint32_t m_nNum;
+
+	// @brief 位置
+	std::vector<float> m_PosXVec;
+	std::vector<float> m_PosYVec;
+	std::vector<float> m_PosZVec;
+
+	// @brief 速度
+	std::vector<float> m_VelXVec;
+	std::vector<float> m_VelYVec;
+	std::vector<float> m_VelZVec;
+
+	// @brief 残りの寿命
+	std::vector<float> m_LifeVec;
+
+	// @brief 当たりの半径
+	std::vector<float> m_RadiusVec;
+
+	// @brief 今回の移動で進む割合(当たった弾は1未満)
+	std::vector<float> m_MoveVec;
+
+	// @brief 持ち主の番号
+	std::vector<uint32_t> m_OwnerVec;
+
+	// @brief 使う側が自由に使う値
+	std::vector<uint64_t> m_UserDataVec;
+
+	// @brief 並びの番号から枠の番号
+	std::vector<uint32_t> m_SlotOfVec;
+
+	// @brief 枠の番号から並びの番号(下位20bit)と世代(上位12bit)
+	std::vector<uint32_t> m_SlotVec;
+
+	// @brief 空いている枠の番号
+	std::vector<uint32_t> m_FreeSlotVec;
+
+	// @brief 登録された箱
+	std::vector<ProjectileCollider> m_ColliderVec;
+
+	// @brief グリッドに収まらない大きな箱の番号(全ての弾で調べる)
+	std::vector<uint32_t> m_LargeColliderVec;
+
+	// @brief バケット毎の先頭の位置
+	std::vector<uint32_t> m_BucketStartVec;
+
+	// @brief バケット順に並べた箱の番号(箱の中身も複製して並べ、判定中に登録順の配列を読みに行かない)
+	std::vector<uint32_t> m_BucketEntryVec;
+
+	// @brief バケット順に並べた箱
+	std::vector<ProjectileCollider> m_BucketColliderVec;
+
+	// @brief グリッドのセルの大きさ
+	float m_fCellSize;
+
+	// @brief 箱を振り分け直す必要があるか
+	bool m_bGridDirty;
+
+	// @brief 直前の更新で当たった弾
+	std::vector<ProjectileHit> m_HitVec;
+
+	// @brief 集計中の統計情報
+	ProjectileStats m_tCount;
+
+	// @brief 直前の更新の統計情報
+	ProjectileStats m_tStats;
+};
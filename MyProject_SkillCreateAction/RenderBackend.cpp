@@ -0,0 +1,289 @@
+/**************************************************//*
+	@file	| RenderBackend.cpp
+	@brief	| 描画命令の実行先クラスのcppファイル
+	@note	| 描画キューはこのインターフェースを通して状態設定と描画を行う
+			| DirectX11で実行するものと、呼び出しを記録するものを用意する
+*//**************************************************/
+#include "RenderBackend.h"
+#include "ShaderManager.h"
+#include <algorithm>
+
+/****************************************//*
+	@brief　	| コンストラクタ
+	@note		| インスタンスデータ用の頂点バッファを作成する
+*//****************************************/
+CRenderBackendDX::CRenderBackendDX()
+	: m_tObjectBuffer{}
+	, m_pInstanceBuffer(nullptr)
+	, m_pVS(nullptr)
+	, m_pPS(nullptr)
+{
+	D3D11_BUFFER_DESC bufDesc = {};
+	bufDesc.ByteWidth = sizeof(RenderInstance) * ce_nMaxInstanceNum;
+	bufDesc.Usage = D3D11_USAGE_DYNAMIC;
+	bufDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	bufDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	if (FAILED(GetDevice()->CreateBuffer(&bufDesc, nullptr, &m_pInstanceBuffer)))
+	{
+		m_pInstanceBuffer = nullptr;
+	}
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CRenderBackendDX::~CRenderBackendDX()
+{
+	SAFE_RELEASE(m_pInstanceBuffer);
+}
+
+/****************************************//*
+	@brief　	| ビュー行列とプロジェクション行列の設定
+	@param　	| inView：ビュー行列(転置済み)
+	@param　	| inProj：プロジェクション行列(転置済み)
+*//****************************************/
+void CRenderBackendDX::SetViewProj(const DirectX::XMFLOAT4X4& inView, const DirectX::XMFLOAT4X4& inProj)
+{
+	m_tObjectBuffer.m_f4x4WVP[1] = inView;
+	m_tObjectBuffer.m_f4x4WVP[2] = inProj;
+}
+
+/****************************************//*
+	@brief　	| 描画パスの設定
+	@param　	| inPass：描画パス
+	@note		| レンダーターゲットはパス毎にフレームグラフが設定するので何もしない
+*//****************************************/
+void CRenderBackendDX::SetPass(RenderPass inPass)
+{
+}
+
+/****************************************//*
+	@brief　	| カリングモードの設定
+	@param　	| inCulling：カリングモード
+*//****************************************/
+void CRenderBackendDX::SetCulling(D3D11_CULL_MODE inCulling)
+{
+	SetCullingMode(inCulling);
+}
+
+/****************************************//*
+	@brief　	| シェーダーの設定
+	@param　	| pVS：頂点シェーダー
+	@param　	| pPS：ピクセルシェーダー
+*//****************************************/
+void CRenderBackendDX::SetShader(VertexShader* pVS, PixelShader* pPS)
+{
+	m_pVS = pVS;
+	m_pPS = pPS;
+	m_pVS->Bind();
+	m_pPS->Bind();
+}
+
+/****************************************//*
+	@brief　	| テクスチャの設定
+	@param　	| pTexture：テクスチャ
+*//****************************************/
+void CRenderBackendDX::SetTexture(Texture* pTexture)
+{
+	m_pVS->SetTexture(0, pTexture);
+	m_pPS->SetTexture(0, pTexture);
+}
+
+/****************************************//*
+	@brief　	| ワールド行列と色の設定
+	@param　	| inInstance：オブジェクトの描画情報
+*//****************************************/
+void CRenderBackendDX::SetTransform(const RenderInstance& inInstance)
+{
+	DirectX::XMStoreFloat4x4(&m_tObjectBuffer.m_f4x4WVP[0],
+		DirectX::XMMatrixTranspose(DirectX::XMLoadFloat4x4(&inInstance.m_f4x4World)));
+	m_tObjectBuffer.m_f4Color = inInstance.m_f4Color;
+
+	// 行列を受け取る頂点シェーダーにだけ渡す
+	if (m_pVS->m_eType == VSType::Object) m_pVS->WriteBuffer(0, &m_tObjectBuffer);
+}
+
+/****************************************//*
+	@brief　	| インデックス付きの描画
+	@param　	| pMesh：描画するメッシュ
+	@param　	| inLayout：頂点レイアウト
+	@param　	| inCount：インデックス数
+	@param　	| inStart：開始インデックス
+*//****************************************/
+void CRenderBackendDX::DrawIndexed(MeshBuffer* pMesh, VertexLayout inLayout, UINT inCount, UINT inStart)
+{
+	m_pVS->BindLayout(inLayout);
+	pMesh->Draw(inCount, inStart);
+}
+
+/****************************************//*
+	@brief　	| インスタンス描画
+	@param　	| pMesh：描画するメッシュ
+	@param　	| inLayout：頂点レイアウト
+	@param　	| inCount：インデックス数
+	@param　	| inStart：開始インデックス
+	@param　	| pInstances：インスタンス毎の描画情報
+	@param　	| inInstanceNum：インスタンス数
+*//****************************************/
+void CRenderBackendDX::DrawIndexedInstanced(MeshBuffer* pMesh, VertexLayout inLayout, UINT inCount, UINT inStart,
+	const RenderInstance* pInstances, UINT inInstanceNum)
+{
+	VertexShader* pInstanceVS = CShaderManager::GetInstance()->GetVertexShader(m_pVS->m_eType, m_pVS->m_nFeatures | SHADER_FEATURE_INSTANCING);
+
+	// インスタンス描画ができない場合は1つずつ描画する
+	if (!pInstanceVS || !m_pInstanceBuffer)
+	{
+		for (UINT i = 0; i < inInstanceNum; i++)
+		{
+			SetTransform(pInstances[i]);
+			DrawIndexed(pMesh, inLayout, inCount, inStart);
+		}
+		return;
+	}
+
+	// ビュー行列とプロジェクション行列はVS_Objectと同じ値を使う
+	pInstanceVS->WriteBuffer(0, &m_tObjectBuffer.m_f4x4WVP[1]);
+	pInstanceVS->Bind();
+	pInstanceVS->BindLayout(inLayout);
+
+	ID3D11DeviceContext* pContext = GetContext();
+	UINT stride = sizeof(RenderInstance);
+	UINT offset = 0;
+	for (UINT nFirst = 0; nFirst < inInstanceNum; nFirst += ce_nMaxInstanceNum)
+	{
+		// インスタンスデータ用の頂点バッファに収まる分ずつ書き込む
+		UINT nNum = (std::min)(ce_nMaxInstanceNum, inInstanceNum - nFirst);
+		D3D11_MAPPED_SUBRESOURCE mapResource;
+		if (FAILED(pContext->Map(m_pInstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapResource))) break;
+		memcpy_s(mapResource.pData, sizeof(RenderInstance) * ce_nMaxInstanceNum, pInstances + nFirst, sizeof(RenderInstance) * nNum);
+		pContext->Unmap(m_pInstanceBuffer, 0);
+
+		pContext->IASetVertexBuffers(ce_nInstanceSlot, 1, &m_pInstanceBuffer, &stride, &offset);
+		pMesh->DrawInstanced(nNum, inCount, inStart);
+	}
+
+	// 通常の描画に戻す
+	m_pVS->Bind();
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+	@param　	| pForward：記録した呼び出しの転送先(nullptrなら記録のみ)
+*//****************************************/
+CRenderRecorder::CRenderRecorder(IRenderBackend* pForward)
+	: m_CallVec{}
+	, m_pForward(pForward)
+{
+}
+
+/****************************************//*
+	@brief　	| ビュー行列とプロジェクション行列の設定
+	@param　	| inView：ビュー行列(転置済み)
+	@param　	| inProj：プロジェクション行列(転置済み)
+*//****************************************/
+void CRenderRecorder::SetViewProj(const DirectX::XMFLOAT4X4& inView, const DirectX::XMFLOAT4X4& inProj)
+{
+	m_CallVec.push_back({ CallKind::ViewProj, nullptr, 0, 0, 0 });
+	if (m_pForward) m_pForward->SetViewProj(inView, inProj);
+}
+
+/****************************************//*
+	@brief　	| 描画パスの設定
+	@param　	| inPass：描画パス
+*//****************************************/
+void CRenderRecorder::SetPass(RenderPass inPass)
+{
+	m_CallVec.push_back({ CallKind::Pass, nullptr, static_cast<UINT>(inPass), 0, 0 });
+	if (m_pForward) m_pForward->SetPass(inPass);
+}
+
+/****************************************//*
+	@brief　	| カリングモードの設定
+	@param　	| inCulling：カリングモード
+*//****************************************/
+void CRenderRecorder::SetCulling(D3D11_CULL_MODE inCulling)
+{
+	m_CallVec.push_back({ CallKind::Culling, nullptr, static_cast<UINT>(inCulling), 0, 0 });
+	if (m_pForward) m_pForward->SetCulling(inCulling);
+}
+
+/****************************************//*
+	@brief　	| シェーダーの設定
+	@param　	| pVS：頂点シェーダー
+	@param　	| pPS：ピクセルシェーダー
+*//****************************************/
+void CRenderRecorder::SetShader(VertexShader* pVS, PixelShader* pPS)
+{
+	m_CallVec.push_back({ CallKind::Shader, pPS, 0, 0, 0 });
+	if (m_pForward) m_pForward->SetShader(pVS, pPS);
+}
+
+/****************************************//*
+	@brief　	| テクスチャの設定
+	@param　	| pTexture：テクスチャ
+*//****************************************/
+void CRenderRecorder::SetTexture(Texture* pTexture)
+{
+	m_CallVec.push_back({ CallKind::Texture, pTexture, 0, 0, 0 });
+	if (m_pForward) m_pForward->SetTexture(pTexture);
+}
+
+/****************************************//*
+	@brief　	| ワールド行列と色の設定
+	@param　	| inInstance：オブジェクトの描画情報
+*//****************************************/
+void CRenderRecorder::SetTransform(const RenderInstance& inInstance)
+{
+	m_CallVec.push_back({ CallKind::Transform, nullptr, 0, 0, 0 });
+	if (m_pForward) m_pForward->SetTransform(inInstance);
+}
+
+/****************************************//*
+	@brief　	| インデックス付きの描画
+	@param　	| pMesh：描画するメッシュ
+	@param　	| inLayout：頂点レイアウト
+	@param　	| inCount：インデックス数
+	@param　	| inStart：開始インデックス
+*//****************************************/
+void CRenderRecorder::DrawIndexed(MeshBuffer* pMesh, VertexLayout inLayout, UINT inCount, UINT inStart)
+{
+	m_CallVec.push_back({ CallKind::Draw, pMesh, inCount, inStart, 1 });
+	if (m_pForward) m_pForward->DrawIndexed(pMesh, inLayout, inCount, inStart);
+}
+
+/****************************************//*
+	@brief　	| インスタンス描画
+	@param　	| pMesh：描画するメッシュ
+	@param　	| inLayout：頂点レイアウト
+	@param　	| inCount：インデックス数
+	@param　	| inStart：開始インデックス
+	@param　	| pInstances：インスタンス毎の描画情報
+	@param　	| inInstanceNum：インスタンス数
+*//****************************************/
+void CRenderRecorder::DrawIndexedInstanced(MeshBuffer* pMesh, VertexLayout inLayout, UINT inCount, UINT inStart,
+	const RenderInstance* pInstances, UINT inInstanceNum)
+{
+	m_CallVec.push_back({ CallKind::DrawInstanced, pMesh, inCount, inStart, inInstanceNum });
+	if (m_pForward) m_pForward->DrawIndexedInstanced(pMesh, inLayout, inCount, inStart, pInstances, inInstanceNum);
+}
+
+/****************************************//*
+	@brief　	| 呼び出しの種類の名前を取得
+	@param　	| inKind：呼び出しの種類
+	@return		| 名前
+*//****************************************/
+const char* CRenderRecorder::GetCallName(CallKind inKind)
+{
+	switch (inKind)
+	{
+	case CallKind::ViewProj:	return "ViewProj";
+	case CallKind::Pass:		return "Pass";
+	case CallKind::Culling:		return "Culling";
+	case CallKind::Shader:		return "Shader";
+	case CallKind::Texture:		return "Texture";
+	case CallKind::Transform:	return "Transform";
+	case CallKind::Draw:		return "Draw";
+	case CallKind::DrawInstanced:	return "DrawInstanced";
+	default:					return "Unknown";
+	}
+}
@@ -0,0 +1,207 @@
+/**************************************************//*
+	@file	| RenderBackend.h
+	@brief	| 描画命令の実行先クラスのhファイル
+	@note	| 描画キューはこのインターフェースを通して状態設定と描画を行う
+			| DirectX11で実行するものと、呼び出しを記録するものを用意する
+*//**************************************************/
+#pragma once
+#include "Shader.h"
+#include "MeshBuffer.h"
+#include "Texture.h"
+#include "VertexFormat.h"
+#include <DirectXMath.h>
+#include <vector>
+
+// @brief 描画パス
+// @note 値の小さい順に描画する
+enum class RenderPass
+{
+	// 深度バッファを使う
+	World,
+
+	// 深度バッファを使わない
+	WorldNoDepth,
+
+	Max
+};
+
+// @brief オブジェクト1つ分の描画情報(インスタンスデータとしてそのまま転送する)
+struct RenderInstance
+{
+	// ワールド行列(転置していない)
+	DirectX::XMFLOAT4X4 m_f4x4World;
+
+	// 色
+	DirectX::XMFLOAT4 m_f4Color;
+};
+
+// @brief 描画命令の実行先のインターフェース
+class IRenderBackend
+{
+public:
+	// @brief デストラクタ
+	virtual ~IRenderBackend() {}
+
+	// @brief ビュー行列とプロジェクション行列の設定(フレームの先頭で1回)
+	// @param inView：ビュー行列(転置済み)
+	// @param inProj：プロジェクション行列(転置済み)
+	virtual void SetViewProj(const DirectX::XMFLOAT4X4& inView, const DirectX::XMFLOAT4X4& inProj) = 0;
+
+	// @brief 描画パスの設定
+	// @param inPass：描画パス
+	virtual void SetPass(RenderPass inPass) = 0;
+
+	// @brief カリングモードの設定
+	// @param inCulling：カリングモード
+	virtual void SetCulling(D3D11_CULL_MODE inCulling) = 0;
+
+	// @brief シェーダーの設定
+	// @param pVS：頂点シェーダー
+	// @param pPS：ピクセルシェーダー
+	virtual void SetShader(VertexShader* pVS, PixelShader* pPS) = 0;
+
+	// @brief テクスチャの設定
+	// @param pTexture：テクスチャ
+	virtual void SetTexture(Texture* pTexture) = 0;
+
+	// @brief ワールド行列と色の設定
+	// @param inInstance：オブジェクトの描画情報
+	virtual void SetTransform(const RenderInstance& inInstance) = 0;
+
+	// @brief インデックス付きの描画
+	// @param pMesh：描画するメッシュ
+	// @param inLayout：頂点レイアウト
+	// @param inCount：インデックス数
+	// @param inStart：開始インデックス
+	virtual void DrawIndexed(MeshBuffer* pMesh, VertexLayout inLayout, UINT inCount, UINT inStart) = 0;
+
+	// @brief インスタンス描画
+	// @param pMesh：描画するメッシュ
+	// @param inLayout：頂点レイアウト
+	// @param inCount：インデックス数
+	// @param inStart：開始インデックス
+	// @param pInstances：インスタンス毎の描画情報
+	// @param inInstanceNum：インスタンス数
+	virtual void DrawIndexedInstanced(MeshBuffer* pMesh, VertexLayout inLayout, UINT inCount, UINT inStart,
+		const RenderInstance* pInstances, UINT inInstanceNum) = 0;
+};
+
+// @brief DirectX11で描画命令を実行するクラス
+class CRenderBackendDX : public IRenderBackend
+{
+public:
+	// @brief コンストラクタ
+	// @note インスタンスデータ用の頂点バッファを作成する
+	CRenderBackendDX();
+
+	// @brief デストラクタ
+	~CRenderBackendDX();
+
+	void SetViewProj(const DirectX::XMFLOAT4X4& inView, const DirectX::XMFLOAT4X4& inProj) override;
+	void SetPass(RenderPass inPass) override;
+	void SetCulling(D3D11_CULL_MODE inCulling) override;
+	void SetShader(VertexShader* pVS, PixelShader* pPS) override;
+	void SetTexture(Texture* pTexture) override;
+	void SetTransform(const RenderInstance& inInstance) override;
+	void DrawIndexed(MeshBuffer* pMesh, VertexLayout inLayout, UINT inCount, UINT inStart) override;
+	void DrawIndexedInstanced(MeshBuffer* pMesh, VertexLayout inLayout, UINT inCount, UINT inStart,
+		const RenderInstance* pInstances, UINT inInstanceNum) override;
+
+private:
+	// @brief VS_Objectの定数バッファ
+	struct ObjectBuffer
+	{
+		// ワールド、ビュー、プロジェクション行列(転置済み)
+		DirectX::XMFLOAT4X4 m_f4x4WVP[3];
+
+		// 色
+		DirectX::XMFLOAT4 m_f4Color;
+	};
+
+	// @brief インスタンスデータ用の頂点バッファのスロット
+	static constexpr UINT ce_nInstanceSlot = 2;
+
+	// @brief 一度に書き込めるインスタンス数
+	static constexpr UINT ce_nMaxInstanceNum = 1024;
+
+	// @brief VS_Objectの定数バッファの内容
+	ObjectBuffer m_tObjectBuffer;
+
+	// @brief インスタンスデータ用の頂点バッファ
+	ID3D11Buffer* m_pInstanceBuffer;
+
+	// @brief 設定中の頂点シェーダー
+	VertexShader* m_pVS;
+
+	// @brief 設定中のピクセルシェーダー
+	PixelShader* m_pPS;
+};
+
+// @brief 描画命令の呼び出しを記録するクラス
+// @note 実行先を指定すると記録しながらそのまま転送する
+class CRenderRecorder : public IRenderBackend
+{
+public:
+	// @brief 記録する呼び出しの種類
+	enum class CallKind
+	{
+		ViewProj,
+		Pass,
+		Culling,
+		Shader,
+		Texture,
+		Transform,
+		Draw,
+		DrawInstanced,
+	};
+
+	// @brief 記録した呼び出し1回分
+	struct Call
+	{
+		// 呼び出しの種類
+		CallKind m_eKind;
+
+		// 対象(シェーダー、テクスチャ、メッシュ)
+		const void* m_pTarget;
+
+		// 値(パス、カリングモード、インデックス数)
+		UINT m_nValue;
+
+		// 開始インデックス
+		UINT m_nStart;
+
+		// インスタンス数
+		UINT m_nInstanceNum;
+	};
+
+public:
+	// @brief コンストラクタ
+	// @param pForward：記録した呼び出しの転送先(nullptrなら記録のみ)
+	CRenderRecorder(IRenderBackend* pForward = nullptr);
+
+	void SetViewProj(const DirectX::XMFLOAT4X4& inView, const DirectX::XMFLOAT4X4& inProj) override;
+	void SetPass(RenderPass inPass) override;
+	void SetCulling(D3D11_CULL_MODE inCulling) override;
+	void SetShader(VertexShader* pVS, PixelShader* pPS) override;
+	void SetTexture(Texture* pTexture) override;
+	void SetTransform(const RenderInstance& inInstance) override;
+	void DrawIndexed(MeshBuffer* pMesh, VertexLayout inLayout, UINT inCount, UINT inStart) override;
+	void DrawIndexedInstanced(MeshBuffer* pMesh, VertexLayout inLayout, UINT inCount, UINT inStart,
+		const RenderInstance* pInstances, UINT inInstanceNum) override;
+
+	// @brief 記録した呼び出しの取得
+	// @return 呼び出しの配列
+	const std::vector<Call>& GetCalls() const { return m_CallVec; }
+
+	// @brief 呼び出しの種類の名前を取得
+	// @param inKind：呼び出しの種類
+	// @return 名前
+	static const char* GetCallName(CallKind inKind);
+
+private:
+	// @brief 記録した呼び出し
+	std::vector<Call> m_CallVec;
+
+	// @brief 転送先
+	IRenderBackend* m_pForward;
+};
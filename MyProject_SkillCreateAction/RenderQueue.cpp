@@ -0,0 +1,656 @@
+/**************************************************//*
+	@file	| RenderQueue.cpp
+	@brief	| 描画キュークラスのcppファイル
+	@note	| レンダラーは描画命令を積むだけにして、フレームの最後に
+			| 64bitのソートキーで基数ソートしてから状態の重複を除いて実行する
+*//**************************************************/
+#include "RenderQueue.h"
+#include "Camera.h"
+#include <algorithm>
+#include <numeric>
+#include <climits>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <set>
+#include <tuple>
+
+//--- 静的メンバ変数の実体定義
+std::vector<RenderItem> RenderQueue::m_ItemVec;
+std::vector<UINT64> RenderQueue::m_KeyVec;
+std::vector<UINT> RenderQueue::m_OrderVec;
+size_t RenderQueue::m_nPassStart[static_cast<int>(RenderPass::Max)] = {};
+size_t RenderQueue::m_nPassCount[static_cast<int>(RenderPass::Max)] = {};
+std::vector<UINT> RenderQueue::m_SortWorkVec;
+std::vector<RenderInstance> RenderQueue::m_TransformVec;
+std::vector<RenderInstance> RenderQueue::m_InstanceVec;
+bool RenderQueue::m_bInstancing = true;
+CRenderBackendDX* RenderQueue::m_pBackend = nullptr;
+std::unordered_map<const void*, UINT> RenderQueue::m_ShaderIdMap;
+std::unordered_map<const void*, UINT> RenderQueue::m_TextureIdMap;
+std::unordered_map<const void*, UINT> RenderQueue::m_MeshIdMap;
+bool RenderQueue::m_bCaptureRequest = false;
+bool RenderQueue::m_bCapturing = false;
+std::vector<CRenderRecorder::Call> RenderQueue::m_CaptureVec;
+RenderQueueStats RenderQueue::m_tStats = {};
+
+/****************************************//*
+	@brief　	| 初期化
+*//****************************************/
+void RenderQueue::Init()
+{
+	m_pBackend = new(std::nothrow) CRenderBackendDX();
+}
+
+/****************************************//*
+	@brief　	| 終了
+*//****************************************/
+void RenderQueue::Uninit()
+{
+	Clear();
+	SAFE_DELETE(m_pBackend);
+}
+
+/****************************************//*
+	@brief　	| ワールド行列と色を積む
+	@param　	| inWorld：ワールド行列(転置していない)
+	@param　	| inColor：色
+	@return		| ワールド行列と色の番号
+*//****************************************/
+UINT RenderQueue::PushTransform(const DirectX::XMFLOAT4X4& inWorld, const DirectX::XMFLOAT4& inColor)
+{
+	m_TransformVec.push_back({ inWorld, inColor });
+	return static_cast<UINT>(m_TransformVec.size() - 1);
+}
+
+/****************************************//*
+	@brief　	| 描画命令を積む
+	@param　	| inItem：描画命令の内容
+	@param　	| inDepth：カメラからの距離
+	@param　	| isTranslucent：半透明かどうか(半透明は奥から順に描画する)
+*//****************************************/
+void RenderQueue::Submit(const RenderItem& inItem, float inDepth, bool isTranslucent)
+{
+	// 頂点シェーダーとピクセルシェーダーの組み合わせを1つの番号にまとめる
+	UINT nShader = ((GetSortId(m_ShaderIdMap, inItem.m_pVS) & 0xf) << 4) | (GetSortId(m_ShaderIdMap, inItem.m_pPS) & 0xf);
+	UINT nTexture = GetSortId(m_TextureIdMap, inItem.m_pTexture);
+	UINT nMesh = GetSortId(m_MeshIdMap, inItem.m_pMesh);
+
+	m_ItemVec.push_back(inItem);
+	m_KeyVec.push_back(MakeSortKey(inItem.m_ePass, isTranslucent, nShader, nTexture, nMesh, inDepth));
+}
+
+/****************************************//*
+	@brief　	| 積んだ描画命令をソートキーの順に並べ替える
+	@note		| 描画パスはソートキーの最上位にあるので、パス毎の範囲もここで求める
+*//****************************************/
+void RenderQueue::Sort()
+{
+	RadixSort();
+
+	for (int i = 0; i < static_cast<int>(RenderPass::Max); i++) m_nPassCount[i] = 0;
+	for (UINT nIndex : m_OrderVec) m_nPassCount[static_cast<int>(m_ItemVec[nIndex].m_ePass)]++;
+	size_t nStart = 0;
+	for (int i = 0; i < static_cast<int>(RenderPass::Max); i++)
+	{
+		m_nPassStart[i] = nStart;
+		nStart += m_nPassCount[i];
+	}
+
+	// 統計情報はパス毎の実行で足していく
+	m_tStats = {};
+	m_tStats.m_nCommandNum = static_cast<int>(m_OrderVec.size());
+
+	// 要求があったフレームは全てのパスの呼び出しを記録する
+	m_bCapturing = m_bCaptureRequest;
+	m_bCaptureRequest = false;
+	if (m_bCapturing) m_CaptureVec.clear();
+}
+
+/****************************************//*
+	@brief　	| 並べ替えた描画命令のうち、指定したパスの命令を実行する
+	@param　	| inBackend：実行先
+	@param　	| inPass：描画パス
+	@note		| 直前と同じ状態の設定は実行先に渡さない
+				| 同じメッシュを同じ状態で描画する命令が続く場合はインスタンス描画にまとめる
+*//****************************************/
+void RenderQueue::Execute(IRenderBackend& inBackend, RenderPass inPass)
+{
+	if (!HasPass(inPass)) return;
+
+	CCamera* pCamera = CCamera::GetInstance();
+	inBackend.SetViewProj(pCamera->GetViewMatrix(), pCamera->GetProjectionMatrix());
+
+	// 直前に設定した状態
+	RenderPass ePass = RenderPass::Max;
+	D3D11_CULL_MODE eCulling = static_cast<D3D11_CULL_MODE>(0);
+	VertexShader* pVS = nullptr;
+	PixelShader* pPS = nullptr;
+	Texture* pTexture = nullptr;
+	bool bTexture = false;
+	UINT nTransform = UINT_MAX;
+
+	size_t nNum = m_nPassStart[static_cast<int>(inPass)] + m_nPassCount[static_cast<int>(inPass)];
+	for (size_t i = m_nPassStart[static_cast<int>(inPass)]; i < nNum;)
+	{
+		const RenderItem& tItem = m_ItemVec[m_OrderVec[i]];
+
+		if (tItem.m_ePass != ePass)
+		{
+			ePass = tItem.m_ePass;
+			inBackend.SetPass(ePass);
+			m_tStats.m_nStateChangeNum++;
+		}
+		else m_tStats.m_nStateSkipNum++;
+
+		if (tItem.m_eCulling != eCulling)
+		{
+			eCulling = tItem.m_eCulling;
+			inBackend.SetCulling(eCulling);
+			m_tStats.m_nStateChangeNum++;
+		}
+		else m_tStats.m_nStateSkipNum++;
+
+		// シェーダーを切り替えるとテクスチャと定数バッファも設定し直す
+		if (tItem.m_pVS != pVS || tItem.m_pPS != pPS)
+		{
+			pVS = tItem.m_pVS;
+			pPS = tItem.m_pPS;
+			inBackend.SetShader(pVS, pPS);
+			m_tStats.m_nStateChangeNum++;
+			bTexture = false;
+			nTransform = UINT_MAX;
+		}
+		else m_tStats.m_nStateSkipNum++;
+
+		if (!bTexture || tItem.m_pTexture != pTexture)
+		{
+			pTexture = tItem.m_pTexture;
+			bTexture = true;
+			inBackend.SetTexture(pTexture);
+			m_tStats.m_nStateChangeNum++;
+		}
+		else m_tStats.m_nStateSkipNum++;
+
+		// 同じメッシュを同じ状態で描画する命令がどこまで続くか
+		size_t nEnd = i + 1;
+		// (スキニングやモーフはオブジェクト毎の定数を使うのでまとめない)
+		if (m_bInstancing && tItem.m_pVS->m_eType == VSType::Object && tItem.m_pVS->m_nFeatures == SHADER_FEATURE_NONE)
+		{
+			while (nEnd < nNum && CanInstance(tItem, m_ItemVec[m_OrderVec[nEnd]])) nEnd++;
+		}
+
+		if (nEnd - i >= ce_nMinInstanceNum)
+		{
+			// ワールド行列と色をインスタンスデータにまとめて1回で描画
+			m_InstanceVec.clear();
+			for (size_t j = i; j < nEnd; j++)
+			{
+				m_InstanceVec.push_back(m_TransformVec[m_ItemVec[m_OrderVec[j]].m_nTransform]);
+			}
+			inBackend.DrawIndexedInstanced(tItem.m_pMesh, tItem.m_eLayout, tItem.m_nIdxCount, tItem.m_nIdxStart,
+				m_InstanceVec.data(), static_cast<UINT>(m_InstanceVec.size()));
+			m_tStats.m_nInstancedDrawNum++;
+			m_tStats.m_nInstanceNum += static_cast<int>(m_InstanceVec.size());
+		}
+		else
+		{
+			if (tItem.m_nTransform != nTransform)
+			{
+				nTransform = tItem.m_nTransform;
+				inBackend.SetTransform(m_TransformVec[nTransform]);
+				m_tStats.m_nStateChangeNum++;
+			}
+			else m_tStats.m_nStateSkipNum++;
+
+			inBackend.DrawIndexed(tItem.m_pMesh, tItem.m_eLayout, tItem.m_nIdxCount, tItem.m_nIdxStart);
+		}
+		m_tStats.m_nDrawNum++;
+		i = nEnd;
+	}
+}
+
+/****************************************//*
+	@brief　	| 並べ替えた描画命令のうち、指定したパスの命令を描画する
+	@param　	| inPass：描画パス
+	@note		| レンダーターゲットはフレームグラフが設定する
+				| 積んだ描画命令はフレームの最後にClearで破棄する
+*//****************************************/
+void RenderQueue::Flush(RenderPass inPass)
+{
+	if (!m_pBackend) return;
+
+	if (m_bCapturing)
+	{
+		// DirectXに転送しながら呼び出しを記録し、パス毎の記録を繋げる
+		CRenderRecorder tRecorder(m_pBackend);
+		Execute(tRecorder, inPass);
+		m_CaptureVec.insert(m_CaptureVec.end(), tRecorder.GetCalls().begin(), tRecorder.GetCalls().end());
+	}
+	else
+	{
+		Execute(*m_pBackend, inPass);
+	}
+}
+
+/****************************************//*
+	@brief　	| 積んだ描画命令を破棄する
+*//****************************************/
+void RenderQueue::Clear()
+{
+	m_ItemVec.clear();
+	m_KeyVec.clear();
+	m_OrderVec.clear();
+	for (int i = 0; i < static_cast<int>(RenderPass::Max); i++) m_nPassCount[i] = 0;
+	m_TransformVec.clear();
+	m_ShaderIdMap.clear();
+	m_TextureIdMap.clear();
+	m_MeshIdMap.clear();
+}
+
+/****************************************//*
+	@brief　	| ソートキーを作成する
+	@param　	| inPass：描画パス
+	@param　	| isTranslucent：半透明かどうか
+	@param　	| inShader：シェーダーの番号(8bit)
+	@param　	| inTexture：テクスチャの番号(12bit)
+	@param　	| inMesh：メッシュの番号(12bit)
+	@param　	| inDepth：カメラからの距離
+	@return		| ソートキー
+*//****************************************/
+UINT64 RenderQueue::MakeSortKey(RenderPass inPass, bool isTranslucent, UINT inShader, UINT inTexture, UINT inMesh, float inDepth)
+{
+	// 正の浮動小数はビット列のまま比較しても大小関係が変わらないので上位24bitを使う
+	float fDepth = (std::max)(inDepth, 0.0f);
+	UINT nBits;
+	memcpy(&nBits, &fDepth, sizeof(nBits));
+	UINT64 ulDepth = (nBits >> 7) & 0xffffff;
+
+	UINT64 ulShader = (std::min)(inShader, 0xffu);
+	UINT64 ulTexture = (std::min)(inTexture, 0xfffu);
+	UINT64 ulMesh = (std::min)(inMesh, 0xfffu);
+
+	UINT64 ulKey = static_cast<UINT64>(inPass) << 62;
+	if (!isTranslucent)
+	{
+		// 状態の切り替えが少なくなる順に並べ、同じ状態の中では手前から描画する
+		ulKey |= ulShader << 53;
+		ulKey |= ulTexture << 41;
+		ulKey |= ulMesh << 29;
+		ulKey |= ulDepth << 5;
+	}
+	else
+	{
+		// 重なりが正しくなるよう奥から描画する
+		ulKey |= 1ull << 61;
+		ulKey |= (~ulDepth & 0xffffff) << 37;
+		ulKey |= ulShader << 29;
+		ulKey |= ulTexture << 17;
+		ulKey |= ulMesh << 5;
+	}
+	return ulKey;
+}
+
+/****************************************//*
+	@brief　	| ソートキーの基数ソート(8bitずつ、安定)
+*//****************************************/
+void RenderQueue::RadixSort()
+{
+	size_t nNum = m_KeyVec.size();
+	m_OrderVec.resize(nNum);
+	std::iota(m_OrderVec.begin(), m_OrderVec.end(), 0u);
+	m_SortWorkVec.resize(nNum);
+
+	for (int nShift = 0; nNum > 1 && nShift < 64; nShift += 8)
+	{
+		size_t nCount[256] = {};
+		for (UINT nIndex : m_OrderVec)
+		{
+			nCount[(m_KeyVec[nIndex] >> nShift) & 0xff]++;
+		}
+
+		// 全て同じ値の桁は並びが変わらないので飛ばす
+		if (nCount[(m_KeyVec[m_OrderVec[0]] >> nShift) & 0xff] == nNum) continue;
+
+		size_t nOffset[256];
+		size_t nSum = 0;
+		for (int i = 0; i < 256; i++)
+		{
+			nOffset[i] = nSum;
+			nSum += nCount[i];
+		}
+		for (UINT nIndex : m_OrderVec)
+		{
+			m_SortWorkVec[nOffset[(m_KeyVec[nIndex] >> nShift) & 0xff]++] = nIndex;
+		}
+		m_OrderVec.swap(m_SortWorkVec);
+	}
+}
+
+/****************************************//*
+	@brief　	| 2つの描画命令を1回のインスタンス描画にまとめられるか
+	@param　	| inA：描画命令
+	@param　	| inB：描画命令
+	@return		| true:まとめられる false:まとめられない
+*//****************************************/
+bool RenderQueue::CanInstance(const RenderItem& inA, const RenderItem& inB)
+{
+	// ワールド行列と色以外が全て同じならまとめられる
+	return
+		inA.m_pMesh == inB.m_pMesh &&
+		inA.m_eLayout == inB.m_eLayout &&
+		inA.m_nIdxStart == inB.m_nIdxStart &&
+		inA.m_nIdxCount == inB.m_nIdxCount &&
+		inA.m_pVS == inB.m_pVS &&
+		inA.m_pPS == inB.m_pPS &&
+		inA.m_pTexture == inB.m_pTexture &&
+		inA.m_eCulling == inB.m_eCulling &&
+		inA.m_ePass == inB.m_ePass;
+}
+
+/****************************************//*
+	@brief　	| ポインタを並べ替え用の番号に変換する
+	@param　	| inIdMap：変換表
+	@param　	| pPtr：変換するポインタ
+	@return		| 並べ替え用の番号(フレーム内で最初に出てきた順)
+*//****************************************/
+UINT RenderQueue::GetSortId(std::unordered_map<const void*, UINT>& inIdMap, const void* pPtr)
+{
+	auto itr = inIdMap.find(pPtr);
+	if (itr != inIdMap.end()) return itr->second;
+
+	UINT nId = static_cast<UINT>(inIdMap.size());
+	inIdMap.emplace(pPtr, nId);
+	return nId;
+}
+
+/****************************************//*
+	@brief　	| 合成した描画命令を並べ替えて記録用の実行先で実行し、並び順・状態変更数・描画数とインスタンス描画へのまとめ方を確認してファイルに書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗(並び順が崩れた、状態変更数・描画数・インスタンス数が合わない)
+	@note		| デバイスを使わないので初期化前に呼べる。積んでいる描画命令は破棄する
+*//****************************************/
+int RenderQueue::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr UINT ce_nItemNum = 4000;
+	static constexpr int ce_nMeshNum = 32;
+	static constexpr int ce_nTextureNum = 8;
+	static constexpr UINT ce_nDepthStep = 800;
+	char szLine[256];
+	bool bSuccess = true;
+	bool bOriginInstancing = m_bInstancing;
+
+	// 並べ替えと実行は比べるだけなので、デバイスを使わずに作れるシェーダー・テクスチャ・メッシュを使う
+	VertexShader tObjectVS(VSType::Object);
+	VertexShader tSkinVS(VSType::Object, SHADER_FEATURE_SKINNING);
+	PixelShader tColorPS(PSType::TexColor);
+	PixelShader tAlphaTestPS(PSType::TexColor, SHADER_FEATURE_ALPHA_TEST);
+	VertexShader* pVSList[] = { &tObjectVS, &tSkinVS };
+	PixelShader* pPSList[] = { &tColorPS, &tAlphaTestPS };
+	std::vector<Texture> tTextureVec(ce_nTextureNum);
+	std::vector<MeshBuffer> tMeshVec(ce_nMeshNum);
+
+	//--- 並び順と状態変更数
+	// 状態変更の数え方はExecuteと同じ(シェーダーを切り替えるとテクスチャと行列も設定し直す)
+	// 1つずつ描画するので行列は描画毎に変わる
+	auto CountStateChange = [](const std::vector<RenderItem>& inItemVec, const std::vector<UINT>& inOrderVec, RenderPass inPass)
+		{
+			int nChange = 0;
+			const RenderItem* pPrev = nullptr;
+			for (UINT nIndex : inOrderVec)
+			{
+				const RenderItem& tItem = inItemVec[nIndex];
+				if (tItem.m_ePass != inPass) continue;
+
+				bool bShader = !pPrev || tItem.m_pVS != pPrev->m_pVS || tItem.m_pPS != pPrev->m_pPS;
+				nChange += !pPrev ? 1 : 0;
+				nChange += (!pPrev || tItem.m_eCulling != pPrev->m_eCulling) ? 1 : 0;
+				nChange += bShader ? 1 : 0;
+				nChange += (bShader || tItem.m_pTexture != pPrev->m_pTexture) ? 1 : 0;
+				nChange += 1;
+				pPrev = &tItem;
+			}
+			return nChange;
+		};
+
+	Clear();
+	SetInstancing(false);
+	std::mt19937 tRandom(32);
+	std::vector<float> fDepthVec(ce_nItemNum);
+	std::vector<char> bTranslucentVec(ce_nItemNum);
+	for (UINT i = 0; i < ce_nItemNum; i++)
+	{
+		DirectX::XMFLOAT4X4 tWorld;
+		DirectX::XMStoreFloat4x4(&tWorld, DirectX::XMMatrixTranslation(static_cast<float>(i), 0.0f, 0.0f));
+
+		RenderItem tItem = {};
+		tItem.m_pMesh = &tMeshVec[tRandom() % ce_nMeshNum];
+		tItem.m_eLayout = VertexLayout::Static;
+		tItem.m_nIdxCount = 36;
+		tItem.m_pVS = pVSList[tRandom() % 2];
+		tItem.m_pPS = pPSList[tRandom() % 2];
+		tItem.m_pTexture = &tTextureVec[tRandom() % ce_nTextureNum];
+		tItem.m_eCulling = (tRandom() % 4 == 0) ? D3D11_CULL_NONE : D3D11_CULL_BACK;
+		tItem.m_ePass = (tRandom() % 5 == 0) ? RenderPass::WorldNoDepth : RenderPass::World;
+		tItem.m_nTransform = PushTransform(tWorld, DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+		// 距離はソートキーの精度で割り切れる刻みにして、同じ距離は同じキーになるようにする
+		fDepthVec[i] = (tRandom() % ce_nDepthStep) * 0.25f;
+		bTranslucentVec[i] = tRandom() % 4 == 0;
+		Submit(tItem, fDepthVec[i], bTranslucentVec[i] != 0);
+	}
+
+	auto tStart = std::chrono::high_resolution_clock::now();
+	Sort();
+	double dSortMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+	// 基数ソートが同じキーの安定ソートと同じ並びになるか
+	std::vector<UINT> tExpectVec(m_KeyVec.size());
+	std::iota(tExpectVec.begin(), tExpectVec.end(), 0u);
+	std::stable_sort(tExpectVec.begin(), tExpectVec.end(), [](UINT a, UINT b) { return m_KeyVec[a] < m_KeyVec[b]; });
+	bool bOrder = tExpectVec == m_OrderVec;
+
+	// パス順、パス内は不透明が先、不透明は同じ状態がまとまって手前から、半透明は奥から
+	using Group = std::tuple<int, const void*, const void*, const void*, const void*>;
+	std::set<Group> tGroupSet;
+	for (size_t i = 1; bOrder && i < m_OrderVec.size(); i++)
+	{
+		UINT a = m_OrderVec[i - 1];
+		UINT b = m_OrderVec[i];
+		const RenderItem& tA = m_ItemVec[a];
+		const RenderItem& tB = m_ItemVec[b];
+		if (tA.m_ePass != tB.m_ePass)
+		{
+			bOrder = tA.m_ePass < tB.m_ePass;
+			continue;
+		}
+		if (bTranslucentVec[a] != bTranslucentVec[b])
+		{
+			bOrder = !bTranslucentVec[a];
+			continue;
+		}
+		if (bTranslucentVec[a])
+		{
+			bOrder = fDepthVec[a] >= fDepthVec[b];
+			continue;
+		}
+
+		Group tGroupA(static_cast<int>(tA.m_ePass), tA.m_pVS, tA.m_pPS, tA.m_pTexture, tA.m_pMesh);
+		Group tGroupB(static_cast<int>(tB.m_ePass), tB.m_pVS, tB.m_pPS, tB.m_pTexture, tB.m_pMesh);
+		if (tGroupA == tGroupB)
+		{
+			bOrder = fDepthVec[a] <= fDepthVec[b];
+			continue;
+		}
+
+		// 一度終わった状態の組み合わせが後から再び出てこない
+		tGroupSet.insert(tGroupA);
+		bOrder = tGroupSet.count(tGroupB) == 0;
+	}
+	bSuccess &= bOrder;
+	sprintf_s(szLine, "sort  items %u  sort ms %.3f  %s\n", ce_nItemNum, dSortMs, bOrder ? "ok" : "FAILED");
+	tReport << szLine;
+
+	// 記録用の実行先で全パスを実行する
+	CRenderRecorder tRecorder(nullptr);
+	for (int nPass = 0; nPass < static_cast<int>(RenderPass::Max); nPass++)
+	{
+		Execute(tRecorder, static_cast<RenderPass>(nPass));
+	}
+	RenderQueueStats tStats = m_tStats;
+
+	// 描画は並べ替えた順に1つずつで、記録した状態変更が統計と一致するか
+	std::vector<UINT> tSubmitVec(m_ItemVec.size());
+	std::iota(tSubmitVec.begin(), tSubmitVec.end(), 0u);
+	int nExpectChange = 0;
+	int nUnsortedChange = 0;
+	for (int nPass = 0; nPass < static_cast<int>(RenderPass::Max); nPass++)
+	{
+		nExpectChange += CountStateChange(m_ItemVec, m_OrderVec, static_cast<RenderPass>(nPass));
+		nUnsortedChange += CountStateChange(m_ItemVec, tSubmitVec, static_cast<RenderPass>(nPass));
+	}
+
+	int nRecordChange = 0;
+	size_t nDraw = 0;
+	bool bDraw = true;
+	for (const CRenderRecorder::Call& tCall : tRecorder.GetCalls())
+	{
+		switch (tCall.m_eKind)
+		{
+		case CRenderRecorder::CallKind::Pass:
+		case CRenderRecorder::CallKind::Culling:
+		case CRenderRecorder::CallKind::Shader:
+		case CRenderRecorder::CallKind::Texture:
+		case CRenderRecorder::CallKind::Transform:
+			nRecordChange++;
+			break;
+		case CRenderRecorder::CallKind::Draw:
+		{
+			const RenderItem& tItem = m_ItemVec[m_OrderVec[(std::min)(nDraw, m_OrderVec.size() - 1)]];
+			bDraw = bDraw && nDraw < m_OrderVec.size() && tCall.m_pTarget == tItem.m_pMesh &&
+				tCall.m_nValue == tItem.m_nIdxCount && tCall.m_nStart == tItem.m_nIdxStart;
+			nDraw++;
+			break;
+		}
+		case CRenderRecorder::CallKind::DrawInstanced:
+			bDraw = false;
+			break;
+		default:
+			break;
+		}
+	}
+	bool bValid = bDraw && nDraw == ce_nItemNum && tStats.m_nDrawNum == static_cast<int>(ce_nItemNum) && tStats.m_nInstancedDrawNum == 0 &&
+		nRecordChange == tStats.m_nStateChangeNum && nRecordChange == nExpectChange && nExpectChange < nUnsortedChange;
+	bSuccess &= bValid;
+
+	sprintf_s(szLine, "execute  draws %d  state changes %d (submit order %d)  skipped %d  %s\n",
+		tStats.m_nDrawNum, tStats.m_nStateChangeNum, nUnsortedChange, tStats.m_nStateSkipNum, bValid ? "ok" : "FAILED");
+	tReport << szLine;
+
+	//--- インスタンス描画
+	// 同じメッシュを同じ状態で描画する命令がce_nMinInstanceNum以上続く時だけ1回にまとめ、それ以外は1つずつ描画する
+	tReport << "instancing case          items  draws  instanced  instances  check\n";
+	auto RunInstanceCase = [&](const char* szName, bool isInstancing, const std::vector<RenderItem>& inItemVec,
+		int nExpectDraw, int nExpectInstanced, int nExpectInstanceNum)
+		{
+			Clear();
+			SetInstancing(isInstancing);
+			for (size_t i = 0; i < inItemVec.size(); i++)
+			{
+				DirectX::XMFLOAT4X4 tWorld;
+				DirectX::XMStoreFloat4x4(&tWorld, DirectX::XMMatrixTranslation(static_cast<float>(i), 0.0f, 0.0f));
+				RenderItem tItem = inItemVec[i];
+				tItem.m_nTransform = PushTransform(tWorld, DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f));
+				Submit(tItem, static_cast<float>(i), false);
+			}
+			Sort();
+
+			CRenderRecorder tCaseRecorder(nullptr);
+			for (int nPass = 0; nPass < static_cast<int>(RenderPass::Max); nPass++)
+			{
+				Execute(tCaseRecorder, static_cast<RenderPass>(nPass));
+			}
+
+			// 記録した呼び出しと統計の両方で数える
+			int nSingle = 0;
+			int nInstanced = 0;
+			int nInstanceNum = 0;
+			bool bValid = true;
+			for (const CRenderRecorder::Call& tCall : tCaseRecorder.GetCalls())
+			{
+				if (tCall.m_eKind == CRenderRecorder::CallKind::Draw) nSingle++;
+				if (tCall.m_eKind != CRenderRecorder::CallKind::DrawInstanced) continue;
+				nInstanced++;
+				nInstanceNum += static_cast<int>(tCall.m_nInstanceNum);
+				bValid = bValid && tCall.m_nInstanceNum >= ce_nMinInstanceNum;
+			}
+			bValid = bValid && nSingle == nExpectDraw && nInstanced == nExpectInstanced && nInstanceNum == nExpectInstanceNum &&
+				m_tStats.m_nDrawNum == nSingle + nInstanced && m_tStats.m_nInstancedDrawNum == nInstanced && m_tStats.m_nInstanceNum == nInstanceNum;
+			bSuccess &= bValid;
+
+			sprintf_s(szLine, "%-22s  %5zu  %5d  %9d  %9d  %s\n", szName, inItemVec.size(), nSingle, nInstanced, nInstanceNum, bValid ? "ok" : "FAILED");
+			tReport << szLine;
+		};
+
+	static constexpr int ce_nSameNum = 64;
+	static constexpr int ce_nRunMeshNum = 16;
+	const int nShortRun = static_cast<int>(ce_nMinInstanceNum) - 1;
+	const int nMinRun = static_cast<int>(ce_nMinInstanceNum);
+	std::vector<Texture> tMaterialVec(ce_nSameNum);
+	RenderItem tModel = {};
+	tModel.m_pMesh = &tMeshVec[0];
+	tModel.m_eLayout = VertexLayout::Static;
+	tModel.m_nIdxCount = 36;
+	tModel.m_pVS = &tObjectVS;
+	tModel.m_pPS = &tColorPS;
+	tModel.m_pTexture = &tTextureVec[0];
+	tModel.m_eCulling = D3D11_CULL_BACK;
+	tModel.m_ePass = RenderPass::World;
+
+	// 同じモデルのキーがN個なら、N個のインスタンスを1回で描画する
+	std::vector<RenderItem> tCaseVec(ce_nSameNum, tModel);
+	RunInstanceCase("same model", true, tCaseVec, 0, 1, ce_nSameNum);
+
+	// インスタンス描画を止めている場合は1つずつ
+	RunInstanceCase("same model, disabled", false, tCaseVec, ce_nSameNum, 0, 0);
+
+	// スキニングはオブジェクト毎の定数を使うので1つずつ
+	for (RenderItem& tItem : tCaseVec) tItem.m_pVS = &tSkinVS;
+	RunInstanceCase("same model, skinned", true, tCaseVec, ce_nSameNum, 0, 0);
+
+	// マテリアル(テクスチャ)が全て違えばまとめられない
+	for (int i = 0; i < ce_nSameNum; i++)
+	{
+		tCaseVec[i] = tModel;
+		tCaseVec[i].m_pTexture = &tMaterialVec[i];
+	}
+	RunInstanceCase("mixed materials", true, tCaseVec, ce_nSameNum, 0, 0);
+
+	// 同じメッシュの続く数がce_nMinInstanceNumに届かなければ1つずつ、届けばまとめる
+	tCaseVec.clear();
+	for (int nMesh = 0; nMesh < ce_nRunMeshNum; nMesh++)
+	{
+		tModel.m_pMesh = &tMeshVec[nMesh];
+		tCaseVec.insert(tCaseVec.end(), nShortRun, tModel);
+	}
+	RunInstanceCase("runs below minimum", true, tCaseVec, ce_nRunMeshNum * nShortRun, 0, 0);
+
+	tCaseVec.clear();
+	for (int nMesh = 0; nMesh < ce_nRunMeshNum; nMesh++)
+	{
+		tModel.m_pMesh = &tMeshVec[nMesh];
+		tCaseVec.insert(tCaseVec.end(), nMinRun, tModel);
+	}
+	RunInstanceCase("runs at minimum", true, tCaseVec, 0, ce_nRunMeshNum, ce_nRunMeshNum * nMinRun);
+
+	// 確認用のシェーダーなどを指したまま残さない
+	Clear();
+	m_tStats = {};
+	SetInstancing(bOriginInstancing);
+
+	tReport << (bSuccess ? "ok\n" : "FAILED\n");
+	return bSuccess ? 0 : 1;
+}
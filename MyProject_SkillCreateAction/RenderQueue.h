@@ -0,0 +1,222 @@
+/**************************************************//*
+	@file	| RenderQueue.h
+	@brief	| 描画キュークラスのhファイル
+	@note	| レンダラーは描画命令を積むだけにして、フレームの最後に
+			| 64bitのソートキーで基数ソートしてから状態の重複を除いて実行する
+*//**************************************************/
+#pragma once
+#include "RenderBackend.h"
+#include <vector>
+#include <unordered_map>
+
+// @brief 描画命令1回分の内容
+struct RenderItem
+{
+	// 描画するメッシュ
+	MeshBuffer* m_pMesh;
+
+	// 頂点レイアウト
+	VertexLayout m_eLayout;
+
+	// 開始インデックス
+	UINT m_nIdxStart;
+
+	// インデックス数
+	UINT m_nIdxCount;
+
+	// 頂点シェーダー
+	VertexShader* m_pVS;
+
+	// ピクセルシェーダー
+	PixelShader* m_pPS;
+
+	// テクスチャ
+	Texture* m_pTexture;
+
+	// カリングモード
+	D3D11_CULL_MODE m_eCulling;
+
+	// 描画パス
+	RenderPass m_ePass;
+
+	// ワールド行列と色の番号(RenderQueue::PushTransformの戻り値)
+	UINT m_nTransform;
+};
+
+// @brief 描画キューの統計情報
+struct RenderQueueStats
+{
+	// 積まれた描画命令数
+	int m_nCommandNum;
+
+	// 実際に行った描画数(インスタンス描画を含む)
+	int m_nDrawNum;
+
+	// インスタンス描画の回数
+	int m_nInstancedDrawNum;
+
+	// インスタンス描画でまとめたオブジェクト数
+	int m_nInstanceNum;
+
+	// 実際に行った状態変更の数
+	int m_nStateChangeNum;
+
+	// 重複していたため省いた状態変更の数
+	int m_nStateSkipNum;
+};
+
+// @brief 描画キュークラス
+class RenderQueue
+{
+public:
+	// @brief 初期化
+	static void Init();
+
+	// @brief 終了
+	static void Uninit();
+
+	// @brief ワールド行列と色を積む
+	// @param inWorld：ワールド行列(転置していない)
+	// @param inColor：色
+	// @return ワールド行列と色の番号
+	static UINT PushTransform(const DirectX::XMFLOAT4X4& inWorld, const DirectX::XMFLOAT4& inColor);
+
+	// @brief 描画命令を積む
+	// @param inItem：描画命令の内容
+	// @param inDepth：カメラからの距離
+	// @param isTranslucent：半透明かどうか(半透明は奥から順に描画する)
+	static void Submit(const RenderItem& inItem, float inDepth, bool isTranslucent);
+
+	// @brief 積んだ描画命令をソートキーの順に並べ替える
+	// @note 描画パスはソートキーの最上位にあるので、パス毎の範囲もここで求める
+	static void Sort();
+
+	// @brief 並べ替えた描画命令のうち、指定したパスの命令を実行する
+	// @param inBackend：実行先
+	// @param inPass：描画パス
+	// @note 直前と同じ状態の設定は実行先に渡さない
+	//       同じメッシュを同じ状態で描画する命令が続く場合はインスタンス描画にまとめる
+	static void Execute(IRenderBackend& inBackend, RenderPass inPass);
+
+	// @brief 並べ替えた描画命令に指定したパスの命令があるか
+	// @param inPass：描画パス
+	// @return true:ある false:無い
+	static bool HasPass(RenderPass inPass) { return m_nPassCount[static_cast<int>(inPass)] > 0; }
+
+	// @brief インスタンス描画にまとめるかどうかの設定
+	// @param isInstancing：true:まとめる false:1つずつ描画する
+	static void SetInstancing(bool isInstancing) { m_bInstancing = isInstancing; }
+
+	// @brief インスタンス描画にまとめるかどうかの取得
+	// @return true:まとめる false:1つずつ描画する
+	static bool IsInstancing() { return m_bInstancing; }
+
+	// @brief 並べ替えた描画命令のうち、指定したパスの命令を描画する
+	// @param inPass：描画パス
+	// @note レンダーターゲットはフレームグラフが設定する
+	//       積んだ描画命令はフレームの最後にClearで破棄する
+	static void Flush(RenderPass inPass);
+
+	// @brief 積んだ描画命令を破棄する
+	static void Clear();
+
+	// @brief 次のフレームで実行先への呼び出しを記録する
+	static void RequestCapture() { m_bCaptureRequest = true; }
+
+	// @brief 記録した呼び出しの取得
+	// @return 呼び出しの配列
+	static const std::vector<CRenderRecorder::Call>& GetCapture() { return m_CaptureVec; }
+
+	// @brief 直前に描画したフレームの統計情報の取得
+	// @return 統計情報
+	static const RenderQueueStats& GetStats() { return m_tStats; }
+
+	// @brief ソートキーを作成する
+	// @param inPass：描画パス
+	// @param isTranslucent：半透明かどうか
+	// @param inShader：シェーダーの番号(8bit)
+	// @param inTexture：テクスチャの番号(12bit)
+	// @param inMesh：メッシュの番号(12bit)
+	// @param inDepth：カメラからの距離
+	// @return ソートキー
+	// @note 不透明：パス|0|シェーダー|テクスチャ|メッシュ|距離(手前から)
+	//       半透明：パス|1|距離(奥から)|シェーダー|テクスチャ|メッシュ
+	static UINT64 MakeSortKey(RenderPass inPass, bool isTranslucent, UINT inShader, UINT inTexture, UINT inMesh, float inDepth);
+
+	// @brief 合成した描画命令を並べ替えて記録用の実行先で実行し、並び順・状態変更数・描画数とインスタンス描画へのまとめ方を確認してファイルに書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗(並び順が崩れた、状態変更数・描画数・インスタンス数が合わない)
+	// @note デバイスを使わないので初期化前に呼べる。積んでいる描画命令は破棄する
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief ソートキーの基数ソート(8bitずつ、安定)
+	static void RadixSort();
+
+	// @brief 2つの描画命令を1回のインスタンス描画にまとめられるか
+	// @param inA：描画命令
+	// @param inB：描画命令
+	// @return true:まとめられる false:まとめられない
+	static bool CanInstance(const RenderItem& inA, const RenderItem& inB);
+
+	// @brief ポインタを並べ替え用の番号に変換する
+	// @param inIdMap：変換表
+	// @param pPtr：変換するポインタ
+	// @return 並べ替え用の番号(フレーム内で最初に出てきた順)
+	static UINT GetSortId(std::unordered_map<const void*, UINT>& inIdMap, const void* pPtr);
+
+private:
+	// @brief 積まれた描画命令
+	static std::vector<RenderItem> m_ItemVec;
+
+	// @brief 描画命令毎のソートキー
+	static std::vector<UINT64> m_KeyVec;
+
+	// @brief 並べ替え後の描画命令の番号
+	static std::vector<UINT> m_OrderVec;
+
+	// @brief 並べ替え後のパス毎の先頭の位置
+	static size_t m_nPassStart[static_cast<int>(RenderPass::Max)];
+
+	// @brief 並べ替え後のパス毎の描画命令数
+	static size_t m_nPassCount[static_cast<int>(RenderPass::Max)];
+
+	// @brief 基数ソートの作業領域
+	static std::vector<UINT> m_SortWorkVec;
+
+	// @brief 積まれたワールド行列と色
+	static std::vector<RenderInstance> m_TransformVec;
+
+	// @brief インスタンス描画に渡すデータの作業領域
+	static std::vector<RenderInstance> m_InstanceVec;
+
+	// @brief インスタンス描画にまとめる最小のオブジェクト数
+	static constexpr size_t ce_nMinInstanceNum = 2;
+
+	// @brief インスタンス描画にまとめるかどうか
+	static bool m_bInstancing;
+
+	// @brief DirectX11の実行先
+	static CRenderBackendDX* m_pBackend;
+
+	// @brief シェーダーの並べ替え用の番号
+	static std::unordered_map<const void*, UINT> m_ShaderIdMap;
+
+	// @brief テクスチャの並べ替え用の番号
+	static std::unordered_map<const void*, UINT> m_TextureIdMap;
+
+	// @brief メッシュの並べ替え用の番号
+	static std::unordered_map<const void*, UINT> m_MeshIdMap;
+
+	// @brief 呼び出しを記録する要求
+	static bool m_bCaptureRequest;
+
+	// @brief 現在のフレームで呼び出しを記録しているか
+	static bool m_bCapturing;
+
+	// @brief 記録した呼び出し
+	static std::vector<CRenderRecorder::Call> m_CaptureVec;
+
+	// @brief 統計情報
+	static RenderQueueStats m_tStats;
+};
@@ -3,16 +3,16 @@
 	@brief	| レンダラー用の仲介コンポーネントクラス
 *//**************************************************/
 #include "RendererComponent.h"
-
-// 静的変数の初期化
-std::map<std::string, RendererObject> CRendererComponent::m_RendererObjectMap = {};
+#include "AssetRegistry.h"
+#include <algorithm>
 
 /****************************************//*
 	@brief　	| デストラクタ
 *//****************************************/
 CRendererComponent::~CRendererComponent()
 {
-
+	// 参照していたアセットを手放す
+	if (m_pAsset) CAssetRegistry::GetInstance()->Release(m_pAsset->m_nID);
 }
 
 /****************************************//*
@@ -135,21 +135,85 @@ RendererParam CRendererComponent::GetRendererParam()
 /****************************************//*
 	@brief　	| 描画に使用するオブジェクトのキーをセット
 	@param　	| inKey：ロードする際に同時に登録したキー
+	@note		| キーはここで一度だけ解決し、描画時には検索しない
 *//****************************************/
 void CRendererComponent::SetKey(std::string inKey)
 {
-	// Map内から引数のキーが存在しているかチェック
-	if (m_RendererObjectMap.find(inKey.c_str()) != m_RendererObjectMap.end())
-	{
-		// 存在していたらそのキーを設定する
-		m_sKey = inKey;
-	}
-	else
+	CAssetRegistry* pRegistry = CAssetRegistry::GetInstance();
+
+	// 登録済みのキーかチェック
+	AssetID nID = pRegistry->Find(inKey);
+	if (nID == ce_nInvalidAssetID)
 	{
 		// 存在していなかったらエラーメッセージを送信する
 		inKey = "NotFind:" + inKey;
 		MessageBox(NULL, inKey.c_str(), "Error", MB_OK);
+		return;
 	}
+
+	// 同じアセットなら何もしない
+	if (m_pAsset && m_pAsset->m_nID == nID) return;
+
+	// 新しいアセットを参照してから古いアセットを手放す
+	AssetEntry* pAsset = pRegistry->Acquire(nID);
+	if (!pAsset) return;
+	if (m_pAsset) pRegistry->Release(m_pAsset->m_nID);
+
+	m_pAsset = pAsset;
+	m_sKey = inKey;
+}
+
+/****************************************//*
+	@brief　	| ワールド空間の境界球を取得
+	@param　	| outSphere：境界球の書き込み先
+	@return　	| true:取得できた false:視錐台カリングの対象外
+*//****************************************/
+bool CRendererComponent::GetWorldBounds(BoundingSphere& outSphere)
+{
+	// キーが設定されていない時は描画もしないので判定しない
+	if (!m_pAsset) return false;
+
+	const BoundingSphere& tLocal = m_pAsset->m_tObject.m_tBounds;
+	DirectX::XMMATRIX world =
+		DirectX::XMMatrixScaling(m_tParam.m_f3Size.x, m_tParam.m_f3Size.y, m_tParam.m_f3Size.z) *
+		DirectX::XMMatrixRotationRollPitchYaw(m_tParam.m_f3Rotate.x, m_tParam.m_f3Rotate.y, m_tParam.m_f3Rotate.z) *
+		DirectX::XMMatrixTranslation(m_tParam.m_f3Pos.x, m_tParam.m_f3Pos.y, m_tParam.m_f3Pos.z);
+	DirectX::XMStoreFloat3(&outSphere.m_f3Center, DirectX::XMVector3TransformCoord(DirectX::XMLoadFloat3(&tLocal.m_f3Center), world));
+
+	// 回転しても収まるように一番大きい軸の拡大率を使う
+	float fScale = (std::max)(fabsf(m_tParam.m_f3Size.x), (std::max)(fabsf(m_tParam.m_f3Size.y), fabsf(m_tParam.m_f3Size.z)));
+	outSphere.m_fRadius = tLocal.m_fRadius * fScale;
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 描画に使用するオブジェクトの取得
+	@return　	| 描画するオブジェクトの情報(キー未設定の場合はnullptr)
+*//****************************************/
+const RendererObject* CRendererComponent::GetRendererObject()
+{
+	if (!m_pAsset) return nullptr;
+
+	// LRU用に使用フレームを記録する
+	CAssetRegistry::GetInstance()->Touch(m_pAsset);
+	return &m_pAsset->m_tObject;
+}
+
+/****************************************//*
+	@brief　	| 描画用のパラメータをテクスチャの使用範囲に合わせて取得
+	@param　	| inObject：描画するオブジェクト
+	@return　	| UVを使用範囲内に変換したパラメータ
+	@note		| アトラスに入っていても、UVは元のテクスチャに対する値のまま設定できる
+*//****************************************/
+RendererParam CRendererComponent::GetDrawParam(const RendererObject& inObject) const
+{
+	RendererParam tParam = m_tParam;
+	const DirectX::XMFLOAT4& f4Rect = inObject.m_f4UVRect;
+	tParam.m_f2UVPos.x = f4Rect.x + m_tParam.m_f2UVPos.x * f4Rect.z;
+	tParam.m_f2UVPos.y = f4Rect.y + m_tParam.m_f2UVPos.y * f4Rect.w;
+	tParam.m_f2UVSize.x = m_tParam.m_f2UVSize.x * f4Rect.z;
+	tParam.m_f2UVSize.y = m_tParam.m_f2UVSize.y * f4Rect.w;
+	return tParam;
 }
 
 /****************************************//*
@@ -162,61 +226,7 @@ void CRendererComponent::SetKey(std::string inKey)
 *//****************************************/
 void CRendererComponent::Load(const RendererKind inKind, const char* inPath, std::string inKey, const float scale, const Model::Flip flip)
 {
-	// そのキー位置に既にオブジェクトがロード済みかをチェックする
-	auto itr = m_RendererObjectMap.find(inKey.c_str());
-	if (itr != m_RendererObjectMap.end())
-	{
-		// ロード済みなら処理を飛ばす
-		return;
-	}
-
-	RendererObject tObject{};   // マップに登録するオブジェクトのデータ
-	tObject.m_eKind = inKind;   // オブジェクトの種類をセット
-
-	Texture* pTexture = nullptr;    // 読み込み用テクスチャクラスポインタ
-	Model* pModel = nullptr;        // 読み込み用モデルクラスポインタ
-
-	switch (tObject.m_eKind)
-	{
-	case RendererKind::Texture:
-        // テクスチャの読み込み
-		pTexture = new(std::nothrow) Texture();
-		if (FAILED(pTexture->Create(inPath)))
-		{
-			MessageBox(NULL, inPath, "Error", MB_OK);
-			return;
-		}
-        // 読み込んだらデータをセットする
-		tObject.m_Data = pTexture;
-		break;
-	case RendererKind::Model:
-        // モデルの読み込み
-		pModel = new Model();
-		if (!pModel->Load(inPath, scale, flip))
-		{
-			MessageBox(NULL, inPath, "Error", MB_OK);
-			return;
-		}
-        // Mesh情報の取得
-		std::vector<Model::Mesh> meshVec;
-		for (unsigned int i = 0; i < pModel->GetMeshNum(); i++)
-		{
-			Model::Mesh Mesh = *pModel->GetMesh(i);
-			meshVec.push_back(Mesh);
-		}
-
-        // モデル用パラメータに一旦移す
-		ModelParam tModel;
-		tModel.m_pModel = pModel;
-		tModel.m_tMeshVec = meshVec;
-
-        // 移したらそのデータをセットする
-		tObject.m_Data = tModel;
-		break;
-	}
-
-    // セットされたデータをキーと共に登録する
-	m_RendererObjectMap.emplace(inKey, tObject);
+	CAssetRegistry::GetInstance()->Register(inKind, inPath, inKey, scale, flip);
 }
 
 /****************************************//*
@@ -224,19 +234,7 @@ void CRendererComponent::Load(const RendererKind inKind, const char* inPath, std
 *//****************************************/
 void CRendererComponent::UnLoad()
 {
-    // マップから全てのオブジェクト情報を取得
-	for (auto& itr : m_RendererObjectMap)
-	{
-		switch (itr.second.m_eKind)
-		{
-		case RendererKind::Texture:
-            // テクスチャならばテクスチャのdeleteをする
-			SAFE_DELETE(std::get<Texture*>(itr.second.m_Data));
-			break;
-		case RendererKind::Model:
-            // モデルならばモデルのdeleteをする
-			SAFE_DELETE(std::get<ModelParam>(itr.second.m_Data).m_pModel);
-			break;
-		}
-	}
+	CAssetRegistry::GetInstance()->UnLoadAll();
+	CAssetRegistry::ReleaseInstance();
+	CTextureAtlas::ReleaseInstance();
 }
@@ -6,6 +6,7 @@
 #include "Component.h"
 #include "Texture.h"
 #include "Model.h"
+#include "Frustum.h"
 #include <variant>
 
 // @brief 描画するオブジェクトの種類
@@ -61,8 +62,17 @@ struct RendererObject
 
 	// オブジェクトのデータ(テクスチャorモデルパラメータ)
     std::variant<Texture*, ModelParam> m_Data;
+
+	// ローカル空間の境界球(読み込み時に計算する)
+	BoundingSphere m_tBounds;
+
+	// テクスチャ内の使用範囲(xyが左上、zwが大きさ。アトラスに入っている場合はページ内の範囲)
+	DirectX::XMFLOAT4 m_f4UVRect;
 };
 
+// 前方宣言
+struct AssetEntry;
+
 // @brief レンダラー用の仲介コンポーネントクラス
 class CRendererComponent : public CComponent
 {
@@ -139,15 +149,32 @@ public:
 
 	// @brief 描画に使用するオブジェクトのキーをセット
 	// @param inKey：ロードする際に同時に登録したキー
+	// @note キーはここで一度だけ解決し、描画時には検索しない
 	void SetKey(std::string inKey);
 
+	// @brief ワールド空間の境界球を取得
+	// @param outSphere：境界球の書き込み先
+	// @return true:取得できた false:視錐台カリングの対象外
+	virtual bool GetWorldBounds(BoundingSphere& outSphere);
+
+protected:
+	// @brief 描画に使用するオブジェクトの取得
+	// @return 描画するオブジェクトの情報(キー未設定の場合はnullptr)
+	const RendererObject* GetRendererObject();
+
+	// @brief 描画用のパラメータをテクスチャの使用範囲に合わせて取得
+	// @param inObject：描画するオブジェクト
+	// @return UVを使用範囲内に変換したパラメータ
+	// @note アトラスに入っていても、UVは元のテクスチャに対する値のまま設定できる
+	RendererParam GetDrawParam(const RendererObject& inObject) const;
+
 protected:
 
 	// @brief レンダラーの統合パラメータ
 	RendererParam m_tParam;
-	
-	// @brief 読み込んだオブジェクトをキー位置に保存するマップ
-	static std::map<std::string, RendererObject> m_RendererObjectMap;
+
+	// @brief 参照しているアセット
+	AssetEntry* m_pAsset = nullptr;
 
 	// @brief 呼び出し用のキー
 	std::string m_sKey;
@@ -0,0 +1,218 @@
+/**************************************************//*
+	@file	| RingAllocator.cpp
+	@brief	| リング割り当てクラスのcppファイル
+	@note	| 大きなバッファの先頭から順に領域を切り出し、末尾に入らなくなったら先頭に戻る
+			| 位置の計算だけを行い、デバイスには触れない
+*//**************************************************/
+#include "RingAllocator.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+/****************************************//*
+	@brief　	| コンストラクタ
+	@param　	| inCapacity：バッファのサイズ(バイト)
+	@param　	| inAlignment：割り当ての境界(バイト、2のべき乗)
+*//****************************************/
+CRingAllocator::CRingAllocator(uint32_t inCapacity, uint32_t inAlignment)
+	: m_nCapacity(0)
+	, m_nAlignment(1)
+	, m_nHead(0)
+	, m_bNewFrame(true)
+	, m_nGeneration(0)
+	, m_tStats{}
+{
+	Reset(inCapacity, inAlignment);
+}
+
+/****************************************//*
+	@brief　	| バッファのサイズと境界を設定し直す
+	@param　	| inCapacity：バッファのサイズ(バイト)
+	@param　	| inAlignment：割り当ての境界(バイト、2のべき乗)
+*//****************************************/
+void CRingAllocator::Reset(uint32_t inCapacity, uint32_t inAlignment)
+{
+	m_nCapacity = inCapacity;
+	m_nAlignment = inAlignment > 0 ? inAlignment : 1;
+	m_nHead = 0;
+	m_bNewFrame = true;
+	m_nGeneration++;
+	m_tStats = {};
+}
+
+/****************************************//*
+	@brief　	| フレームの開始
+	@note		| 次の割り当てはバッファの内容を破棄して先頭から行う
+*//****************************************/
+void CRingAllocator::BeginFrame()
+{
+	m_bNewFrame = true;
+	m_tStats = {};
+}
+
+/****************************************//*
+	@brief　	| 領域を割り当てる
+	@param　	| inSize：必要なサイズ(バイト)
+	@return		| 割り当ての結果
+*//****************************************/
+RingAllocation CRingAllocator::Allocate(uint32_t inSize)
+{
+	RingAllocation tResult = {};
+
+	// 境界に合わせて切り上げる
+	uint32_t nSize = (inSize + m_nAlignment - 1) & ~(m_nAlignment - 1);
+	if (nSize == 0 || nSize > m_nCapacity)
+	{
+		m_tStats.m_nFailNum++;
+		return tResult;
+	}
+
+	// フレームの最初と、末尾に入らない場合は先頭から
+	// (内容を破棄して書き込むので、GPUが使用中の領域を上書きすることは無い)
+	if (m_bNewFrame || m_nHead + nSize > m_nCapacity)
+	{
+		if (!m_bNewFrame) m_tStats.m_nWrapNum++;
+		m_bNewFrame = false;
+		m_nHead = 0;
+		m_nGeneration++;
+		tResult.m_bDiscard = true;
+	}
+
+	tResult.m_nOffset = m_nHead;
+	tResult.m_nSize = nSize;
+	tResult.m_bValid = true;
+	m_nHead += nSize;
+
+	m_tStats.m_nAllocNum++;
+	m_tStats.m_nAllocByte += nSize;
+	return tResult;
+}
+
+/****************************************//*
+	@brief　	| 境界合わせ、先頭に戻る処理、フレーム毎の破棄、世代、入らない割り当てを確認して結果を書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:全て想定通り 1:想定と異なる結果があった
+*//****************************************/
+int CRingAllocator::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr uint32_t ce_nCapacity = 4096;
+	static constexpr uint32_t ce_nAlignment = 256;
+	char szLine[256];
+	bool bSuccess = true;
+
+	// 割り当ての結果を期待値と比べて1行書き出す
+	auto Check = [&](const char* inName, const RingAllocation& inAlloc, bool inValid, uint32_t inOffset, uint32_t inSize, bool inDiscard)
+	{
+		bool bOk = inAlloc.m_bValid == inValid;
+		if (inValid) bOk = bOk && inAlloc.m_nOffset == inOffset && inAlloc.m_nSize == inSize && inAlloc.m_bDiscard == inDiscard;
+		sprintf_s(szLine, "%-28s valid %d offset %5u size %5u discard %d  %s\n",
+			inName, inAlloc.m_bValid ? 1 : 0, inAlloc.m_nOffset, inAlloc.m_nSize, inAlloc.m_bDiscard ? 1 : 0, bOk ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess = bSuccess && bOk;
+	};
+
+	CRingAllocator tRing(ce_nCapacity, ce_nAlignment);
+
+	// 境界合わせ：どのサイズも256バイト単位に切り上げ、続けて並べる
+	Check("align 1", tRing.Allocate(1), true, 0, 256, true);
+	Check("align 64", tRing.Allocate(64), true, 256, 256, false);
+	Check("align 256", tRing.Allocate(256), true, 512, 256, false);
+	Check("align 257", tRing.Allocate(257), true, 768, 512, false);
+	Check("align 300", tRing.Allocate(300), true, 1280, 512, false);
+
+	// 残りにちょうど入る割り当ては先頭に戻らない
+	Check("fit remaining 2304", tRing.Allocate(2304), true, 1792, 2304, false);
+
+	// 残りより大きい割り当ては先頭に戻って破棄する
+	Check("wrap 256", tRing.Allocate(256), true, 0, 256, true);
+	Check("after wrap 1000", tRing.Allocate(1000), true, 256, 1024, false);
+	Check("larger than remaining 3072", tRing.Allocate(3072), true, 0, 3072, true);
+
+	// バッファより大きい割り当てと0バイトは失敗し、位置は変わらない
+	Check("larger than capacity 4097", tRing.Allocate(4097), false, 0, 0, false);
+	Check("zero 0", tRing.Allocate(0), false, 0, 0, false);
+	Check("after fail 512", tRing.Allocate(512), true, 3072, 512, false);
+
+	const RingAllocatorStats& tStats = tRing.GetStats();
+	bool bStatsOk = tStats.m_nAllocNum == 10 && tStats.m_nAllocByte == 8960 && tStats.m_nWrapNum == 2 && tStats.m_nFailNum == 2;
+	sprintf_s(szLine, "stats alloc %d byte %u wrap %d fail %d  %s\n",
+		tStats.m_nAllocNum, tStats.m_nAllocByte, tStats.m_nWrapNum, tStats.m_nFailNum, bStatsOk ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess = bSuccess && bStatsOk;
+
+	// フレームの境目：統計情報を戻し、先頭から破棄して使い直す(先頭に戻った回数には数えない)
+	tRing.BeginFrame();
+	Check("new frame 100", tRing.Allocate(100), true, 0, 256, true);
+	Check("new frame 100", tRing.Allocate(100), true, 256, 256, false);
+	bStatsOk = tRing.GetStats().m_nAllocNum == 2 && tRing.GetStats().m_nWrapNum == 0;
+	sprintf_s(szLine, "new frame stats alloc %d wrap %d  %s\n",
+		tRing.GetStats().m_nAllocNum, tRing.GetStats().m_nWrapNum, bStatsOk ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess = bSuccess && bStatsOk;
+
+	// フレームの途中で先頭に戻った時：世代が進み、戻る前に書き込んだ領域だけが無効になる
+	// (シェーダーは書き込んだ時の世代を覚え、世代が変わっていたら定数を送り直す)
+	tRing.BeginFrame();
+	RingAllocation tBefore0 = tRing.Allocate(1024);
+	uint32_t nBefore0 = tRing.GetGeneration();
+	RingAllocation tBefore1 = tRing.Allocate(2048);
+	uint32_t nBefore1 = tRing.GetGeneration();
+	RingAllocation tWrap = tRing.Allocate(2048);
+	uint32_t nWrap = tRing.GetGeneration();
+	RingAllocation tAfter = tRing.Allocate(1024);
+	uint32_t nAfter = tRing.GetGeneration();
+	Check("mid-frame before 1024", tBefore0, true, 0, 1024, true);
+	Check("mid-frame before 2048", tBefore1, true, 1024, 2048, false);
+	Check("mid-frame wrap 2048", tWrap, true, 0, 2048, true);
+	Check("mid-frame after wrap 1024", tAfter, true, 2048, 1024, false);
+	bool bGenerationOk = nBefore0 == nBefore1 && nWrap != nBefore1 && nAfter == nWrap && tRing.GetStats().m_nWrapNum == 1;
+	sprintf_s(szLine, "mid-frame generation before %u wrap %u after %u  %s\n",
+		nBefore1, nWrap, nAfter, bGenerationOk ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess = bSuccess && bGenerationOk;
+
+	// フレームの境目：最初の割り当てまでは前の内容が残るので世代は変わらず、最初の割り当てで進む
+	tRing.BeginFrame();
+	uint32_t nBeginFrame = tRing.GetGeneration();
+	tRing.Allocate(256);
+	bGenerationOk = nBeginFrame == nAfter && tRing.GetGeneration() != nAfter;
+	sprintf_s(szLine, "new frame generation begin %u first alloc %u  %s\n",
+		nBeginFrame, tRing.GetGeneration(), bGenerationOk ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess = bSuccess && bGenerationOk;
+
+	// ランダムなサイズで、境界とバッファの範囲を守り、破棄するまで前の領域と重ならないことを確かめる
+	std::mt19937 tRandom(36);
+	int nErrorNum = 0;
+	int nWrapNum = 0;
+	for (int nFrame = 0; nFrame < 100; nFrame++)
+	{
+		tRing.BeginFrame();
+		uint32_t nEnd = 0;
+		for (int i = 0; i < 200; i++)
+		{
+			uint32_t nSize = tRandom() % (ce_nCapacity + 512);
+			RingAllocation tAlloc = tRing.Allocate(nSize);
+			if (!tAlloc.m_bValid)
+			{
+				if (nSize > 0 && nSize <= ce_nCapacity) nErrorNum++;
+				continue;
+			}
+			if (tAlloc.m_nOffset % ce_nAlignment != 0 || tAlloc.m_nSize < nSize || tAlloc.m_nOffset + tAlloc.m_nSize > ce_nCapacity) nErrorNum++;
+			if (tAlloc.m_bDiscard ? tAlloc.m_nOffset != 0 : tAlloc.m_nOffset != nEnd) nErrorNum++;
+			if (i == 0 && !tAlloc.m_bDiscard) nErrorNum++;
+			nEnd = tAlloc.m_nOffset + tAlloc.m_nSize;
+		}
+		nWrapNum += tRing.GetStats().m_nWrapNum;
+	}
+	bool bRandomOk = nErrorNum == 0 && nWrapNum > 0;
+	sprintf_s(szLine, "random 100 frames x 200 wrap %d error %d  %s\n", nWrapNum, nErrorNum, bRandomOk ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess = bSuccess && bRandomOk;
+
+	tReport << (bSuccess ? "ok\n" : "FAILED\n");
+	return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+/**************************************************//*
+	@file	| RingAllocator.h
+	@brief	| リング割り当てクラスのhファイル
+	@note	| 大きなバッファの先頭から順に領域を切り出し、末尾に入らなくなったら先頭に戻る
+			| 位置の計算だけを行い、デバイスには触れない
+*//**************************************************/
+#pragma once
+#include <cstdint>
+
+// @brief リング割り当ての結果
+struct RingAllocation
+{
+	// バッファ先頭からの位置(バイト)
+	uint32_t m_nOffset;
+
+	// 割り当てたサイズ(境界に合わせて切り上げたバイト数)
+	uint32_t m_nSize;
+
+	// バッファの内容を破棄して書き込む必要があるか(フレームの最初と、先頭に戻った時)
+	bool m_bDiscard;
+
+	// 割り当てられたか(バッファより大きい場合は失敗する)
+	bool m_bValid;
+};
+
+// @brief リング割り当ての統計情報
+struct RingAllocatorStats
+{
+	// 割り当てた回数
+	int m_nAllocNum;
+
+	// 割り当てたバイト数
+	uint32_t m_nAllocByte;
+
+	// 末尾に入らず先頭に戻った回数
+	int m_nWrapNum;
+
+	// 割り当てられなかった回数
+	int m_nFailNum;
+};
+
+// @brief リング割り当てクラス
+class CRingAllocator
+{
+public:
+	// @brief コンストラクタ
+	// @param inCapacity：バッファのサイズ(バイト)
+	// @param inAlignment：割り当ての境界(バイト、2のべき乗)
+	CRingAllocator(uint32_t inCapacity = 0, uint32_t inAlignment = 256);
+
+	// @brief バッファのサイズと境界を設定し直す
+	// @param inCapacity：バッファのサイズ(バイト)
+	// @param inAlignment：割り当ての境界(バイト、2のべき乗)
+	void Reset(uint32_t inCapacity, uint32_t inAlignment);
+
+	// @brief フレームの開始
+	// @note 次の割り当てはバッファの内容を破棄して先頭から行う
+	void BeginFrame();
+
+	// @brief 領域を割り当てる
+	// @param inSize：必要なサイズ(バイト)
+	// @return 割り当ての結果
+	RingAllocation Allocate(uint32_t inSize);
+
+	// @brief 現在のフレームの統計情報の取得
+	// @return 統計情報
+	const RingAllocatorStats& GetStats() const { return m_tStats; }
+
+	// @brief バッファのサイズの取得
+	// @return バッファのサイズ(バイト)
+	uint32_t GetCapacity() const { return m_nCapacity; }
+
+	// @brief 世代の取得
+	// @return 内容を破棄する割り当ての度に増える番号(割り当てた時と同じ間だけ内容が有効)
+	uint32_t GetGeneration() const { return m_nGeneration; }
+
+	// @brief 境界合わせ、先頭に戻る処理、フレーム毎の破棄、世代、入らない割り当てを確認して結果を書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:全て想定通り 1:想定と異なる結果があった
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief バッファのサイズ(バイト)
+	uint32_t m_nCapacity;
+
+	// @brief 割り当ての境界(バイト)
+	uint32_t m_nAlignment;
+
+	// @brief 次に割り当てる位置(バイト)
+	uint32_t m_nHead;
+
+	// @brief フレームの最初の割り当てかどうか
+	bool m_bNewFrame;
+
+	// @brief 内容を破棄する割り当ての度に増える番号
+	uint32_t m_nGeneration;
+
+	// @brief 現在のフレームの統計情報
+	RingAllocatorStats m_tStats;
+};
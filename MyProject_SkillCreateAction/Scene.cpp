@@ -7,6 +7,7 @@
 #include "Scene.h"
 #include "Camera.h"
 #include "Geometory.h"
+#include "CollisionBase.h"
 
 
 /****************************************//*
@@ -55,6 +56,9 @@ void CScene::Uninit()
 
 	// Փ˔pR|[lgXg̃NA
      m_pCollisionVec.clear();
+     m_pSyncCollisionVec.clear();
+     m_tSpatialQuery.Clear();
+     m_tContactCache.Clear();
 }
 
 /****************************************//*
@@ -62,7 +66,7 @@ void CScene::Uninit()
 *//****************************************/
 void CScene::Update()
 {
-	// Q[IuWFNg̍XV
+	// Q[IuWFNg̍XV(XV̌͑Õt[̏Փ˔̈ʒuōs)
     for (auto& list : m_pGameObject_List)
     {
 		// Xg̑SẴQ[IuWFNgXV
@@ -73,33 +77,55 @@ void CScene::Update()
         }
     }
 
-    // Փ˔菈
-    for (int i = 0; i < m_pCollisionVec.size(); i++)
+    // Փ˔菈(ԌAABBdȂg𒲂ׂAȂ蔻蓯mƃC[ŏgׂ͒Ȃ)
+	// Ԍɍ킹̂̓t[1񂾂AXVɏuԈړ蔻͈ړ|Ȃ
+    SyncSpatialQuery();
+    SyncPendingCollisions();
+    m_tSpatialQuery.FindPairs(m_tPairVec);
+    for (const SpatialPair& tPair : m_tPairVec)
     {
-        CCollisionBase* pCollisionA = m_pCollisionVec[i];
-        if (!pCollisionA->GetActive()) continue;
-        for (int j = i + 1; j < m_pCollisionVec.size(); j++)
+        CCollisionBase* pCollisionA = tPair.m_pCollisionA;
+        CCollisionBase* pCollisionB = tPair.m_pCollisionB;
+        // `͋Ԍɔf鎞ɍ蒼Ă̂ŁÂ܂܌`̑g̔֐Œׂ
+        // ȓ蔻܂ޑǵAÖʒüړ|Ēʂ߂Ƃ肷
+        float fTime;
+        const bool bHit = (pCollisionA->IsFast() || pCollisionB->IsFast())
+            ? CCollisionDispatch::Sweep(pCollisionA->GetVolume(), pCollisionA->GetMove(), pCollisionB->GetVolume(), pCollisionB->GetMove(), fTime)
+            : CCollisionDispatch::Test(pCollisionA->GetVolume(), pCollisionB->GetVolume());
+        if (!bHit) continue;
+
+        // Õt[GĂŐGn߂ƐGꑱ𕪂
+        CGameObject* pObjA = pCollisionA->GetGameObject();
+        CGameObject* pObjB = pCollisionB->GetGameObject();
+        if (m_tContactCache.Touch(tPair.m_nIndexA, tPair.m_nIndexB, pCollisionA, pCollisionB))
         {
-            CCollisionBase* pCollisionB = m_pCollisionVec[j];
-            if (!pCollisionB->GetActive()) continue;
-            
-            if (pCollisionA->IsHit(pCollisionB))
-            {
-                CGameObject* pObjA = pCollisionA->GetGameObject();
-                CGameObject* pObjB = pCollisionB->GetGameObject();
-                pObjA->OnColliderHit(pCollisionB, pCollisionA->GetTag());
-                pObjB->OnColliderHit(pCollisionA, pCollisionB->GetTag());
-            }
+            pObjA->OnCollisionEnter(pCollisionB, pCollisionA);
+            pObjB->OnCollisionEnter(pCollisionA, pCollisionB);
+        }
+        else
+        {
+            pObjA->OnCollisionStay(pCollisionB, pCollisionA);
+            pObjB->OnCollisionStay(pCollisionA, pCollisionB);
         }
     }
 
+	// ̃t[ɐGȂg͗ꂽ
+    m_tContactCache.Update(NotifyContactExit);
+
+	// Փˎ̏ŒǉEuԈړ蔻肾𔽉fA̍XV̌Ɋ܂߂
+    SyncPendingCollisions();
+
+	// Ԍ̃c[̎m߁Ãt[̓vm肷
+    m_tSpatialQuery.Update();
+
 	// j\̃IuWFNg̍폜
     for (auto itr = m_pCollisionVec.begin(); itr != m_pCollisionVec.end();)
     {
 		// Փ˔pR|[lgRtĂQ[IuWFNgj\肩mF
         if ((*itr)->GetGameObject()->IsDestroy())
         {
-			// j\̏ꍇ̓Xg폜
+			// j\̏ꍇ͋ԌƃXg폜
+            RemoveFromSpatialQuery(*itr);
             itr = m_pCollisionVec.erase(itr);
         }
         else
@@ -156,17 +182,169 @@ void CScene::Draw()
     Geometory::SetView(pCamera->GetViewMatrix());
     Geometory::SetProjection(pCamera->GetProjectionMatrix());
 
+	// J̎쐬
+    CFrustum tFrustum;
+    tFrustum.Build(pCamera->GetViewMatrix(false), pCamera->GetProjectionMatrix(false));
+    m_tCullStats = {};
+
 	// Q[IuWFNg̕`
     for (auto& list : m_pGameObject_List)
     {
-		// Xg̑SẴQ[IuWFNg`
+		// ̊OɂIuWFNg̓XgPʂł܂Ƃ߂ďO
+        CullGameObjects(tFrustum, list);
+
+		// XǧĂQ[IuWFNg`
+        size_t nIdx = 0;
         for (auto obj : list)
         {
-            obj->Draw();
+            if (m_bDrawVec[nIdx++]) obj->Draw();
         }
     }
 }
 
+/****************************************//*
+    @brief@	| Xg̃IuWFNg̋E܂Ƃ߂ĎƔ肷
+    @param      | inFrustumFJ̎
+    @param      | inListF肷Q[IuWFNgXg
+    @note       | ʂm_bDrawVecɃXg̏ŏ
+*//****************************************/
+void CScene::CullGameObjects(const CFrustum& inFrustum, const std::list<CGameObject*>& inList)
+{
+	// EȂIuWFNg͏ɕ`悷
+    m_bDrawVec.assign(inList.size(), 1);
+    if (!m_bCulling) return;
+
+	// EIuWFNgAzɏW߂
+    m_nCullIdxVec.clear();
+    m_tBoundsVec.clear();
+    size_t nIdx = 0;
+    for (auto obj : inList)
+    {
+        BoundingSphere tSphere;
+        if (obj->GetCullBounds(tSphere))
+        {
+            m_nCullIdxVec.push_back(nIdx);
+            m_tBoundsVec.push_back(tSphere);
+        }
+        nIdx++;
+    }
+    if (m_tBoundsVec.empty()) return;
+
+	// ܂Ƃ߂Ĕ肵AʂXg̏ɖ߂
+    m_bVisibleVec.resize(m_tBoundsVec.size());
+    int nVisible = inFrustum.Cull(m_tBoundsVec.data(), m_tBoundsVec.size(), m_bVisibleVec.data());
+    for (size_t i = 0; i < m_nCullIdxVec.size(); i++)
+    {
+        m_bDrawVec[m_nCullIdxVec[i]] = m_bVisibleVec[i];
+    }
+
+    m_tCullStats.m_nTestNum += static_cast<int>(m_tBoundsVec.size());
+    m_tCullStats.m_nVisibleNum += nVisible;
+    m_tCullStats.m_nCulledNum += static_cast<int>(m_tBoundsVec.size()) - nVisible;
+}
+
+/****************************************//*
+    @brief@	| 蔻̔̈ʒuԌɍ킹
+    @note       | 蔻̌`蒼A`ތƂēo^
+                | Ȃ蔻͓o^͓Ȃ(`o^̂̂g)
+                | ȓ蔻͑O蒼Ă̈ړ|͈͂œo^
+*//****************************************/
+void CScene::SyncSpatialQuery()
+{
+    for (CCollisionBase* pCollision : m_pCollisionVec)
+    {
+        SyncCollision(pCollision, true);
+    }
+}
+
+/****************************************//*
+    @brief@	| 1̓蔻̔̈ʒuԌɍ킹
+    @param      | inCollisionF蔻
+    @param      | isSweepFtrue:ȓ蔻͑O񂩂̈ړ| false:ړ0ɂč̈ʒuœo^
+*//****************************************/
+void CScene::SyncCollision(CCollisionBase* inCollision, bool isSweep)
+{
+    const uint32_t nIndex = inCollision->GetQueryIndex();
+    if (!inCollision->GetActive())
+    {
+        // ANeBułȂȂ蔻͊O
+        RemoveFromSpatialQuery(inCollision);
+        return;
+    }
+    if (nIndex != CSpatialQuery::ce_nInvalid)
+    {
+        // C[ƃ}XN͓Ȃ蔻łς̂Ŗ񔽉f
+        m_tSpatialQuery.SetFilter(nIndex, CollisionLayerBit(inCollision->GetLayer()), inCollision->GetMask());
+        if (inCollision->IsStatic()) return;
+    }
+
+    // `蒼A`ތԌɔf
+    inCollision->SyncVolume();
+    if (!isSweep) inCollision->ResetMove();
+    const CollisionVolume& tVolume = inCollision->GetVolume();
+    if (tVolume.m_eShape == CollisionShape::Max) return;
+
+    SpatialBox tBox;
+    for (int k = 0; k < 3; k++)
+    {
+        tBox.m_fCenter[k] = tVolume.m_fCenter[k];
+        tBox.m_fHalfSize[k] = tVolume.m_fHalfSize[k];
+        for (int j = 0; j < 3; j++) tBox.m_fAxis[k][j] = tVolume.m_fAxis[k][j];
+    }
+    if (nIndex == CSpatialQuery::ce_nInvalid)
+    {
+        const uint32_t nNewIndex = m_tSpatialQuery.Add(tBox, m_tSpatialQuery.GetTagMask(inCollision->GetTag()), inCollision, inCollision->IsStatic());
+        m_tSpatialQuery.SetFilter(nNewIndex, CollisionLayerBit(inCollision->GetLayer()), inCollision->GetMask());
+        inCollision->SetQueryIndex(nNewIndex);
+        inCollision->ResetMove();
+    }
+    else
+    {
+        // ȓ蔻͓Öʒu܂ōL͈͂őgW߂
+        m_tSpatialQuery.Move(nIndex, tBox, (isSweep && inCollision->IsFast()) ? inCollision->GetMove() : nullptr);
+    }
+}
+
+/****************************************//*
+    @brief@	| ǉEuԈړ蔻肾Ԍɍ킹
+    @note       | ܂Ƃ߂č킹ɌĂԂƁAXVɏuԈړ蔻̈ړ0ɂ
+                | ꂽ̏ŒǉEuԈړ蔻ĂяoŔf
+*//****************************************/
+void CScene::SyncPendingCollisions()
+{
+    for (size_t i = 0; i < m_pSyncCollisionVec.size(); i++)
+    {
+        SyncCollision(m_pSyncCollisionVec[i], false);
+    }
+    m_pSyncCollisionVec.clear();
+}
+
+/****************************************//*
+    @brief@	| 蔻ԌO
+    @param      | inCollisionF蔻
+    @note       | o^̔ԍ͎ɓo^铖蔻肪g񂷂߁AGĂgꏏɊO
+*//****************************************/
+void CScene::RemoveFromSpatialQuery(CCollisionBase* inCollision)
+{
+    const uint32_t nIndex = inCollision->GetQueryIndex();
+    if (nIndex == CSpatialQuery::ce_nInvalid) return;
+
+    m_tContactCache.Remove(nIndex, NotifyContactExit);
+    m_tSpatialQuery.Remove(nIndex);
+    inCollision->SetQueryIndex(CSpatialQuery::ce_nInvalid);
+}
+
+/****************************************//*
+    @brief@	| ꂽg̗̃IuWFNgɗꂽ̏Ă
+    @param      | inCollisionAF蔻A
+    @param      | inCollisionBF蔻B
+*//****************************************/
+void CScene::NotifyContactExit(CCollisionBase* inCollisionA, CCollisionBase* inCollisionB)
+{
+    inCollisionA->GetGameObject()->OnCollisionExit(inCollisionB, inCollisionA);
+    inCollisionB->GetGameObject()->OnCollisionExit(inCollisionA, inCollisionB);
+}
+
 /****************************************//*
     @brief@	| IuWFNgIDXg̎擾
     @return     | IuWFNgIDXg̎Q
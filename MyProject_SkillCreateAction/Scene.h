@@ -8,6 +8,8 @@
 #include <array>
 #include <list>
 #include "CollisionBase.h"
+#include "SpatialQuery.h"
+#include "ContactCache.h"
 
 // @brief シーンベースクラス
 class CScene
@@ -81,6 +83,9 @@ public:
         {
 			// シーンの衝突判定用コンポーネントリストに追加
             m_pCollisionVec.push_back(itr);
+
+			// 衝突判定の後に追加された場合も次の更新を待たずに空間検索へ登録する
+            m_pSyncCollisionVec.push_back(itr);
         }
 
 		// 追加したゲームオブジェクトを返す
@@ -176,6 +181,25 @@ public:
 	// @return 衝突判定用コンポーネントリストのベクター
     std::vector<CCollisionBase*> GetCollisionVec() { return m_pCollisionVec; }
 
+	// @brief 当たり判定の空間検索の取得
+	// @return 空間検索(衝突判定の前に当たり判定の位置に合わせ、その後に追加・瞬間移動した当たり判定はその場で反映する)
+    const CSpatialQuery& GetSpatialQuery() { return m_tSpatialQuery; }
+
+	// @brief 当たり判定を瞬間移動させたことを知らせる
+	// @param inCollision：当たり判定
+	// @note 衝突判定の処理中に動かした場合も次の更新を待たずに空間検索へ反映し、移動は掃引しない
+	//       動かない当たり判定は反映しない
+    void NotifyTeleport(CCollisionBase* inCollision) { m_pSyncCollisionVec.push_back(inCollision); }
+
+	// @brief 空間検索のタグのビットの取得
+	// @param inTag：当たり判定の識別用タグ
+	// @return タグのビット
+    uint32_t GetQueryTagMask(const std::string& inTag) { return m_tSpatialQuery.GetTagMask(inTag); }
+
+	// @brief 接触の統計情報の取得
+	// @return 直前のフレームの触れ始め・触れ続け・離れた組の数
+    const ContactStats& GetContactStats() { return m_tContactCache.GetStats(); }
+
 	// @brief フェード中かどうかの設定・取得
 	// @param isFade：フェード中かどうか
     void SetIsFade(bool isFade) { m_bFade = isFade; }
@@ -184,6 +208,18 @@ public:
 	// @return フェード中かどうか
     bool GetIsFade() { return m_bFade; }
 
+	// @brief 視錐台カリングを行うかどうかの設定
+	// @param isCulling：true:行う false:全て描画する
+    void SetCulling(bool isCulling) { m_bCulling = isCulling; }
+
+	// @brief 視錐台カリングを行うかどうかの取得
+	// @return true:行う false:全て描画する
+    bool IsCulling() { return m_bCulling; }
+
+	// @brief 直前に描画したフレームの視錐台カリングの統計情報の取得
+	// @return 統計情報
+    const CullStats& GetCullStats() { return m_tCullStats; }
+
 protected:
 	// @brief シーン内のゲームオブジェクトリスト
     std::array<std::list<CGameObject*>,(int)Tag::Max> m_pGameObject_List;
@@ -192,12 +228,71 @@ protected:
     std::vector<CCollisionBase*> m_pCollisionVec;
 
 private:
+	// @brief リスト内のオブジェクトの境界球をまとめて視錐台と判定する
+	// @param inFrustum：カメラの視錐台
+	// @param inList：判定するゲームオブジェクトリスト
+	// @note 結果はm_bDrawVecにリストの順で書き込む
+    void CullGameObjects(const CFrustum& inFrustum, const std::list<CGameObject*>& inList);
+
+	// @brief 当たり判定の箱の位置を空間検索に合わせる
+	// @note 新しい当たり判定は登録し、アクティブでない当たり判定は外す
+	//       レイヤーとマスクは毎回反映する
+    void SyncSpatialQuery();
+
+	// @brief 1つの当たり判定の箱の位置を空間検索に合わせる
+	// @param inCollision：当たり判定
+	// @param isSweep：true:高速な当たり判定は前回からの移動を掃引する false:移動を0にして今の位置だけで登録する
+    void SyncCollision(CCollisionBase* inCollision, bool isSweep);
+
+	// @brief 追加・瞬間移動した当たり判定だけを空間検索に合わせる
+    void SyncPendingCollisions();
+
+	// @brief 当たり判定を空間検索から外す
+	// @param inCollision：当たり判定
+	// @note 触れていた組には離れた時の処理を呼ぶ
+    void RemoveFromSpatialQuery(CCollisionBase* inCollision);
+
+	// @brief 離れた組の両方のオブジェクトに離れた時の処理を呼ぶ
+	// @param inCollisionA：当たり判定A
+	// @param inCollisionB：当たり判定B
+    static void NotifyContactExit(CCollisionBase* inCollisionA, CCollisionBase* inCollisionB);
+
 	// @brief シーン内の全てのオブジェクトIDリスト
     std::vector<ObjectID> m_tIDVec;
 
 	// @brief フェード中かどうかのフラグ
     bool m_bFade = false;
 
+	// @brief 視錐台カリングを行うかどうか
+    bool m_bCulling = true;
+
+	// @brief 当たり判定の空間検索
+    CSpatialQuery m_tSpatialQuery;
+
+	// @brief 追加・瞬間移動して、まとめて合わせる前に空間検索へ反映する当たり判定
+    std::vector<CCollisionBase*> m_pSyncCollisionVec;
+
+	// @brief 衝突判定の候補の組(毎フレーム使い回す)
+    std::vector<SpatialPair> m_tPairVec;
+
+	// @brief 前のフレームから触れている当たり判定の組
+    CContactCache m_tContactCache;
+
+	// @brief 視錐台カリングの統計情報
+    CullStats m_tCullStats = {};
+
+	// @brief リスト内の各オブジェクトを描画するかどうか(1:描画する 0:しない)
+    std::vector<uint8_t> m_bDrawVec;
+
+	// @brief 境界球を持つオブジェクトのリスト内での番号
+    std::vector<size_t> m_nCullIdxVec;
+
+	// @brief 境界球を持つオブジェクトの境界球
+    std::vector<BoundingSphere> m_tBoundsVec;
+
+	// @brief 境界球毎の判定結果
+    std::vector<uint8_t> m_bVisibleVec;
+
 };
 
 
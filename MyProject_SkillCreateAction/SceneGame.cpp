@@ -5,7 +5,9 @@
 			| CScenep
 *//**************************************************/
 #include "SceneGame.h"
+#include "BehaviorSystem.h"
 #include "Camera.h"
+#include "CrowdSystem.h"
 #include "Field.h"
 #include "Player.h"
 
@@ -41,6 +43,9 @@ void CSceneGame::Init()
 
 	// vC[̒ǉ
 	AddGameObject<CPlayer>(Tag::GameObject, "Player");
+
+	// Ȃ蔻肩irQ[VObh쐬(IuWFNgSĒǉɍs)
+	GetGameObject<CField>()->BakeNavigation(GetCollisionVec());
 }
 
 /****************************************//*
@@ -50,6 +55,16 @@ void CSceneGame::Update()
 {
 	// NX̍XV
 	CScene::Update();
+
+	// G̃rwCrAc[i߂(g鎞Ԃ𒴂͎̃t[ɉ񂷁AsŔXLƌQO̖ڕW͂̌̍XVŔf)
+	CBehaviorSystem::GetInstance()->Update(fDeltaTime);
+
+	// ̃t[ɔꂽXLƎs̃XLi߂(jꂽIuWFNgɏWߒ)
+	m_tSkillWorld.Refresh(this);
+	CSkillEngine::GetInstance()->Update(fDeltaTime, m_tSkillWorld);
+
+	// QO̕s҂𑀑ǂē(GeBeB͂̃t[ɐݒ肵ڕWŎ̃t[Ɉʒu󂯎)
+	CCrowdSystem::GetInstance()->Update(fDeltaTime);
 }
 
 /****************************************//*
@@ -57,6 +72,10 @@ void CSceneGame::Update()
 *//****************************************/
 void CSceneGame::Draw()
 {
+	// łevC[̍ɕ`
+	CPlayer* pPlayer = GetGameObject<CPlayer>();
+	if (pPlayer) m_tSkillWorld.Draw(pPlayer->GetPos().y);
+
 	// NX̕`揈
 	CScene::Draw();
 }
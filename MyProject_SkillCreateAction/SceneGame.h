@@ -6,6 +6,7 @@
 *//**************************************************/
 #pragma once
 #include "Scene.h"
+#include "SkillWorld.h"
 
 // @brief Q[V[NX
 class CSceneGame : public CScene
@@ -25,5 +26,9 @@ public:
 
 	// @brief `揈
 	void Draw() override;
+
+private:
+	// @brief XL̑ΏېE(V[̃GeBeB)
+	CSkillWorld m_tSkillWorld;
 };
 
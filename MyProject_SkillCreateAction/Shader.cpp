@@ -3,11 +3,14 @@
 	@brief		| VF[_[NX
 *//***********************************************************************************/
 #include "Shader.h"
+#include "ConstantBufferRing.h"
 #include <d3dcompiler.h>
 #include <stdio.h>
 
 #pragma comment(lib, "d3dcompiler.lib")
 
+Shader* Shader::m_pBound[2] = {};
+
 /*************************//*
 @brief		| VF[_[NX
 @param[in]	| kind VF[_[
@@ -22,6 +25,7 @@ Shader::Shader(Kind kind)
 *//*************************/
 Shader::~Shader()
 {
+	if (m_pBound[m_kind] == this) { m_pBound[m_kind] = nullptr; }
 	std::vector<ID3D11Buffer*>::iterator it = m_pBuffers.begin();
 	while (it != m_pBuffers.end())
 	{
@@ -91,6 +95,17 @@ HRESULT Shader::Compile(const char *pCode)
 	return hr;
 }
 
+/*************************//*
+@brief		| RpCς݂̃VF[_[f[^쐬
+@param[in]	| pData VF[_[f[^
+@param[in]	| size f[^TCY
+@return		| HRESULT
+*//*************************/
+HRESULT Shader::Create(const void* pData, UINT size)
+{
+	return Make(const_cast<void*>(pData), size);
+}
+
 /*************************//*
 @brief		| 萔obt@փf[^
 @param[in]	| slot Xbgԍ
@@ -98,8 +113,92 @@ HRESULT Shader::Compile(const char *pCode)
 *//*************************/
 void Shader::WriteBuffer(UINT slot, void* pData)
 {
-	if(slot < m_pBuffers.size())
-		GetContext()->UpdateSubresource(m_pBuffers[slot], 0, nullptr, pData, 0, 0);
+	if (slot >= m_pBuffers.size()) { return; }
+	memcpy(m_bufferData[slot].data(), pData, m_bufferData[slot].size());
+	UploadBuffer(slot);
+
+	// gp̃VF[_[̓Öʒuς̂Őݒ肵
+	if (m_pBound[m_kind] == this) { BindBuffer(slot); }
+}
+
+/*************************//*
+@brief		| ێĂ萔GPU֑
+@param[in]	| slot Xbgԍ
+*//*************************/
+void Shader::UploadBuffer(UINT slot)
+{
+	std::vector<char>& data = m_bufferData[slot];
+	RingSlot& ring = m_ringSlots[slot];
+	UINT generation = ConstantBufferRing::GetGeneration();
+	if (ConstantBufferRing::Write(data.data(), (UINT)data.size(), ring.first, ring.num))
+	{
+		ring.generation = ConstantBufferRing::GetGeneration();
+
+		// t[̓rł擪ɖ߂ƃOĵŁAgp̃VF[_[̒萔蒼
+		if (ring.generation != generation) { RebindBound(); }
+		return;
+	}
+
+	// OgȂꍇ̓VF[_[̒萔obt@ɏ
+	GetContext()->UpdateSubresource(m_pBuffers[slot], 0, nullptr, data.data(), 0, 0);
+	ConstantBufferRing::CountUpdate((UINT)data.size());
+	ring.num = 0;
+}
+
+/*************************//*
+@brief		| 萔obt@Xbgɐݒ
+@param[in]	| slot Xbgԍ
+*//*************************/
+void Shader::BindBuffer(UINT slot)
+{
+	RingSlot& ring = m_ringSlots[slot];
+
+	// OjOɏ񂾒萔͎cĂȂ̂ő蒼
+	if (ring.num > 0 && (!ConstantBufferRing::IsEnable() || ring.generation != ConstantBufferRing::GetGeneration()))
+	{
+		UploadBuffer(slot);
+	}
+
+	ID3D11DeviceContext* pContext = GetContext();
+	if (ring.num == 0)
+	{
+		switch (m_kind)
+		{
+		case Vertex:	pContext->VSSetConstantBuffers(slot, 1, &m_pBuffers[slot]); break;
+		case Pixel:		pContext->PSSetConstantBuffers(slot, 1, &m_pBuffers[slot]); break;
+		}
+		return;
+	}
+
+	// obt@ʒuςĐݒ肷Ɩ̂ŁAxOĂݒ肷
+	ID3D11DeviceContext1* pContext1 = ConstantBufferRing::GetContext1();
+	ID3D11Buffer* pBuffer = ConstantBufferRing::GetBuffer();
+	ID3D11Buffer* pNull = nullptr;
+	switch (m_kind)
+	{
+	case Vertex:
+		pContext1->VSSetConstantBuffers(slot, 1, &pNull);
+		pContext1->VSSetConstantBuffers1(slot, 1, &pBuffer, &ring.first, &ring.num);
+		break;
+	case Pixel:
+		pContext1->PSSetConstantBuffers(slot, 1, &pNull);
+		pContext1->PSSetConstantBuffers1(slot, 1, &pBuffer, &ring.first, &ring.num);
+		break;
+	}
+}
+
+/*************************//*
+@brief		| gp̃VF[_[̒萔obt@ݒ肵
+@note		| Ojꂽ́AjOɏ񂾒萔𑗂蒼
+*//*************************/
+void Shader::RebindBound()
+{
+	for (Shader* pShader : m_pBound)
+	{
+		if (!pShader) { continue; }
+		for (UINT i = 0; i < pShader->m_pBuffers.size(); ++i)
+			pShader->BindBuffer(i);
+	}
 }
 
 /*************************//*
@@ -154,6 +253,8 @@ HRESULT Shader::Make(void* pData, UINT size)
 	D3D11_SHADER_DESC shaderDesc;
 	pReflection->GetDesc(&shaderDesc);
 	m_pBuffers.resize(shaderDesc.ConstantBuffers, nullptr);
+	m_bufferData.resize(shaderDesc.ConstantBuffers);
+	m_ringSlots.resize(shaderDesc.ConstantBuffers, RingSlot{});
 	for (UINT i = 0; i < shaderDesc.ConstantBuffers; ++i)
 	{
 		// VF[_[̒萔obt@̏擾
@@ -170,6 +271,7 @@ HRESULT Shader::Make(void* pData, UINT size)
 		// obt@̍쐬
 		hr = pDevice->CreateBuffer(&bufDesc, nullptr, &m_pBuffers[i]);
 		if (FAILED(hr)) { return hr; }
+		m_bufferData[i].resize(shaderBufDesc.Size, 0);
 	}
 	// eNX`̈쐬
 	m_pTextures.resize(shaderDesc.TextureNormalInstructions, nullptr);
@@ -178,13 +280,17 @@ HRESULT Shader::Make(void* pData, UINT size)
 }
 
 /*************************//*
-@brief  | RXgN^
+@brief		| RXgN^
+@param[in]	| In_eType 
+@param[in]	| In_nFeatures Lȋ@\
 *//*************************/
-VertexShader::VertexShader(VSType In_eType)
+VertexShader::VertexShader(VSType In_eType, UINT In_nFeatures)
 	: Shader(Shader::Vertex)
 	, m_pVS(nullptr)
 	, m_pInputLayout(nullptr)
+	, m_pPackedLayout{}
 	, m_eType(In_eType)
+	, m_nFeatures(In_nFeatures)
 {
 }
 
@@ -193,6 +299,8 @@ VertexShader::VertexShader(VSType In_eType)
 *//*************************/
 VertexShader::~VertexShader()
 {
+	for (int i = 0; i < (int)VertexLayout::MAX; ++i)
+		SAFE_RELEASE(m_pPackedLayout[i]);
 	SAFE_RELEASE(m_pInputLayout);
 	SAFE_RELEASE(m_pVS);
 }
@@ -205,12 +313,39 @@ void VertexShader::Bind(void)
 	ID3D11DeviceContext* pContext =	GetContext();
 	pContext->VSSetShader(m_pVS, NULL, 0);
 	pContext->IASetInputLayout(m_pInputLayout);
+	m_pBound[Shader::Vertex] = this;
 	for (int i = 0; i < m_pBuffers.size(); ++i)
-		pContext->VSSetConstantBuffers(i, 1, &m_pBuffers[i]);
+		BindBuffer(i);
 	for (int i = 0; i < m_pTextures.size(); ++i)
 		pContext->VSSetShaderResources(i, 1, &m_pTextures[i]);
 }
 
+/*************************//*
+@brief		| k_CAEgp̓̓CAEgݒ
+@param[in]	| layout _CAEg
+*//*************************/
+void VertexShader::BindLayout(VertexLayout layout)
+{
+	ID3D11InputLayout*& pLayout = m_pPackedLayout[(int)layout];
+
+	// gpɍ쐬
+	if (!pLayout && !m_byteCode.empty())
+	{
+		std::vector<D3D11_INPUT_ELEMENT_DESC> elements;
+		VertexFormat::GetInputElements(layout, elements, (m_nFeatures & SHADER_FEATURE_INSTANCING) != 0);
+		if (FAILED(GetDevice()->CreateInputLayout(
+			elements.data(), (UINT)elements.size(),
+			m_byteCode.data(), m_byteCode.size(), &pLayout)))
+		{
+			pLayout = nullptr;
+		}
+	}
+
+	// 쐬łȂꍇ̓tNV쐬̂g
+	GetContext()->IASetInputLayout(pLayout ? pLayout : m_pInputLayout);
+	VertexFormat::BindColorStream(layout);
+}
+
 /*************************//*
 @brief		| VF[_[쐬
 @param[in]	| pData VF[_[f[^
@@ -226,6 +361,9 @@ HRESULT VertexShader::MakeShader(void* pData, UINT size)
 	hr = pDevice->CreateVertexShader(pData, size, NULL, &m_pVS);
 	if(FAILED(hr)) { return hr; }
 
+	// k_CAEgpɃVF[_[f[^ێ
+	m_byteCode.assign(static_cast<char*>(pData), static_cast<char*>(pData) + size);
+
 	/*
 	VF[_쐬ɃVF[_tNVʂăCvbgCAEg擾
 	Z}eBNX̔zuȂǂ环ʎq쐬
@@ -302,12 +440,15 @@ HRESULT VertexShader::MakeShader(void* pData, UINT size)
 }
 
 /*************************//*
-@brief  | RXgN^
+@brief		| RXgN^
+@param[in]	| In_eType 
+@param[in]	| In_nFeatures Lȋ@\
 *//*************************/
-PixelShader::PixelShader(PSType In_eType)
+PixelShader::PixelShader(PSType In_eType, UINT In_nFeatures)
 	: Shader(Shader::Pixel)
 	, m_pPS(nullptr)
 	, m_eType(In_eType)
+	, m_nFeatures(In_nFeatures)
 {
 }
 
@@ -326,8 +467,9 @@ void PixelShader::Bind(void)
 {
 	ID3D11DeviceContext* pContext = GetContext();
 	pContext->PSSetShader(m_pPS, nullptr, 0);
+	m_pBound[Shader::Pixel] = this;
 	for (int i = 0; i < m_pBuffers.size(); ++i)
-		pContext->PSSetConstantBuffers(i, 1, &m_pBuffers[i]);
+		BindBuffer(i);
 	for (int i = 0; i < m_pTextures.size(); ++i)
 		pContext->PSSetShaderResources(i, 1, &m_pTextures[i]);
 }
@@ -5,6 +5,7 @@
 #pragma once
 #include "DirectX.h"
 #include "Texture.h"
+#include "VertexFormat.h"
 #include <string>
 #include <map>
 #include <vector>
@@ -17,6 +18,7 @@ enum class VSType
 	None,
 	Object,
 	Sprite,
+	SpriteBatch,
 	MAX
 };
 
@@ -31,6 +33,22 @@ enum class PSType
 	MAX
 };
 
+/*************************//*
+@brief		|VF[_[̋@\
+@note		|rbggݍ킹ăVF[_[̃oG[Vw肷
+*//*************************/
+enum ShaderFeature : UINT
+{
+	SHADER_FEATURE_NONE			= 0,
+	SHADER_FEATURE_SKINNING		= 1 << 0,	// {[sɂό`
+	SHADER_FEATURE_MORPH		= 1 << 1,	// [t^[Qbgɂό`
+	SHADER_FEATURE_INSTANCING	= 1 << 2,	// CX^X̃[hsƐF
+	SHADER_FEATURE_ALPHA_TEST	= 1 << 3,	// ̐؂蔲
+};
+
+// @brief VF[_[̋@\̐
+constexpr UINT ce_nShaderFeatureNum = 4;
+
 // @brief VF[_[̊{NX
 class Shader
 {
@@ -59,6 +77,12 @@ public:
 	// @return 
 	HRESULT Compile(const char* pCode);
 
+	// @brief RpCς݂̃VF[_[f[^쐬
+	// @param[in] pData VF[_[f[^
+	// @param[in] size f[^TCY
+	// @return 
+	HRESULT Create(const void* pData, UINT size);
+
 	// @brief 萔̏
 	// @param[in] slot 萔obt@̃Xbg
 	// @param[in] pData ރf[^
@@ -77,7 +101,22 @@ public:
 	// @brief VF[_[`Ɏgp
 	virtual void Bind(void) = 0;
 
+protected:
+	// @brief 萔obt@Xbgɐݒ
+	// @param[in] slot 萔obt@̃Xbg
+	// @note Oɏ񂾒萔͈ʒuw肵Đݒ肷
+	void BindBuffer(UINT slot);
+
 private:
+	// @brief ێĂ萔GPU֑
+	// @param[in] slot 萔obt@̃Xbg
+	// @note OgȂꍇ̓VF[_[̒萔obt@ɏ
+	void UploadBuffer(UINT slot);
+
+	// @brief gp̃VF[_[̒萔obt@ݒ肵
+	// @note Ojꂽ́AjOɏ񂾒萔𑗂蒼
+	static void RebindBound();
+
 	// @brief VF[_[t@Cǂݍ񂾌AVF[_[̎ޕʂɏs
 	// @param[in] pData VF[_[f[^
 	// @param[in] size f[^TCY
@@ -90,12 +129,26 @@ protected:
 	// @return 
 	virtual HRESULT MakeShader(void* pData, UINT size) = 0;
 
+private:
+	// @brief Oɏ񂾒萔̈ʒu
+	struct RingSlot
+	{
+		UINT first;	// 񂾈ʒu(16oCgP)
+		UINT num;	// 傫(16oCgPʁA0̏ꍇ̓VF[_[̒萔obt@g)
+		UINT generation;	// 񂾎̃O̐
+	};
 private:
 	// VF[_[̎
 	Kind m_kind;
 protected:
+	// ޖɕ`Ɏgp̃VF[_[
+	static Shader* m_pBound[2];
 	// 萔obt@
 	std::vector<ID3D11Buffer*> m_pBuffers;
+	// 萔obt@̏񂾒萔(O̓e̓t[ׂƔj邽ߕێĂ)
+	std::vector<std::vector<char>> m_bufferData;
+	// 萔obt@̃Oɏ񂾈ʒu
+	std::vector<RingSlot> m_ringSlots;
 	std::vector<ID3D11ShaderResourceView*> m_pTextures;
 };
 
@@ -104,13 +157,20 @@ class VertexShader : public Shader
 {
 public:
 	// @brief RXgN^
-	VertexShader(VSType In_eType = VSType::None);
+	// @param[in] In_eType 
+	// @param[in] In_nFeatures Lȋ@\(ShaderFeaturȇgݍ킹)
+	VertexShader(VSType In_eType = VSType::None, UINT In_nFeatures = SHADER_FEATURE_NONE);
 
 	// @brief fXgN^
 	~VertexShader();
 
 	// @brief VF[_[`Ɏgp
 	void Bind(void);
+
+	// @brief k_CAEgp̓̓CAEgݒ
+	// @param[in] layout _CAEg
+	// @note ̓CAEg̓CAEgɏgpɍ쐬ăLbV
+	void BindLayout(VertexLayout layout);
 protected:
 	// @brief VF[_[t@Cǂݍ񂾌A_VF[_p̏s
 	// @param[in] pData VF[_[f[^
@@ -123,9 +183,15 @@ private:
 	ID3D11VertexShader* m_pVS;
 	// @brief ̓CAEg
 	ID3D11InputLayout* m_pInputLayout;
+	// @brief k_CAEg̓̓CAEg
+	ID3D11InputLayout* m_pPackedLayout[(int)VertexLayout::MAX];
+	// @brief ̓CAEg쐬p̃VF[_[f[^
+	std::vector<char> m_byteCode;
 public:
 	// @brief 
 	VSType m_eType;
+	// @brief Lȋ@\
+	UINT m_nFeatures;
 };
 
 // @brief sNZVF[_
@@ -133,7 +199,9 @@ class PixelShader : public Shader
 {
 public:
 	// @brief RXgN^
-	PixelShader(PSType In_eType = PSType::None);
+	// @param[in] In_eType 
+	// @param[in] In_nFeatures Lȋ@\(ShaderFeaturȇgݍ킹)
+	PixelShader(PSType In_eType = PSType::None, UINT In_nFeatures = SHADER_FEATURE_NONE);
 
 	// @brief fXgN^
 	~PixelShader();
@@ -152,4 +220,6 @@ private:
 public:
 	// @brief 
 	PSType m_eType;
+	// @brief Lȋ@\
+	UINT m_nFeatures;
 };
@@ -0,0 +1,257 @@
+/**************************************************//*
+	@file	| ShaderCache.cpp
+	@brief	| シェーダーキャッシュクラスのcppファイル
+	@note	| HLSLソースを機能の組み合わせ(バリエーション)毎にコンパイルし、
+			| ソースの内容から計算したハッシュ値をファイル名にして保存する
+			| ソースが無い環境では対応表(Manifest.txt)からファイルを探す
+*//**************************************************/
+#include "ShaderCache.h"
+#include "Shader.h"
+#include <d3dcompiler.h>
+#include <stdio.h>
+
+// 機能毎のHLSLでの定義名(ShaderFeatureのビット順)
+static const char* ce_pFeatureDefine[ce_nShaderFeatureNum] =
+{
+	"SKINNING",
+	"MORPH",
+	"INSTANCING",
+	"ALPHA_TEST",
+};
+
+// キャッシュ用のコンパイル設定(変更するとキーが変わり全て作り直される)
+static const UINT ce_nCompileFlag = D3DCOMPILE_OPTIMIZATION_LEVEL3;
+
+/****************************************//*
+	@brief　	| コンストラクタ
+	@note		| 対応表を読み込む
+*//****************************************/
+CShaderCache::CShaderCache()
+	: m_bManifestDirty(false)
+{
+	FILE* fp = nullptr;
+	fopen_s(&fp, SHADER_CACHE_PATH("Manifest.txt"), "r");
+	if (!fp) return;
+
+	// 1行に「ソースのファイル名 機能 キー」を並べる
+	char szSource[MAX_PATH];
+	UINT nFeatures;
+	unsigned long long ulKey;
+	while (fscanf_s(fp, "%s %x %llx", szSource, (unsigned)_countof(szSource), &nFeatures, &ulKey) == 3)
+	{
+		m_ManifestMap[MakeManifestKey(szSource, nFeatures)] = ulKey;
+	}
+	fclose(fp);
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+	@note		| 対応表が変わっていれば保存する
+*//****************************************/
+CShaderCache::~CShaderCache()
+{
+	if (m_bManifestDirty) SaveManifest();
+}
+
+/****************************************//*
+	@brief　	| コンパイル済みのシェーダーデータを取得
+	@param　	| pSource：HLSLソースのファイル名
+	@param　	| pTarget：シェーダーモデル("vs_5_0"など)
+	@param　	| inFeatures：有効にする機能(ShaderFeatureの組み合わせ)
+	@param　	| isCompile：キャッシュに無い場合にコンパイルするかどうか
+	@param　	| outData：シェーダーデータの格納先
+	@return		| 読み込み結果
+*//****************************************/
+ShaderCacheResult CShaderCache::Load(const char* pSource, const char* pTarget, UINT inFeatures, bool isCompile, std::vector<char>& outData)
+{
+	outData.clear();
+	m_sError.clear();
+	std::string sManifestKey = MakeManifestKey(pSource, inFeatures);
+
+	// ソースがあればその内容からキーを計算する(ソースを変更すると別のファイルになる)
+	std::string sCode;
+	uint64_t ulKey = 0;
+	bool bHasKey = false;
+	FILE* fp = nullptr;
+	fopen_s(&fp, pSource, "rb");
+	if (fp)
+	{
+		fseek(fp, 0, SEEK_END);
+		long nSize = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		sCode.resize(nSize > 0 ? nSize : 0);
+		if (nSize > 0) fread(&sCode[0], nSize, 1, fp);
+		fclose(fp);
+		ulKey = MakeKey(sCode, pTarget, inFeatures);
+		bHasKey = true;
+	}
+	else
+	{
+		// ソースが無い場合は対応表から探す
+		auto it = m_ManifestMap.find(sManifestKey);
+		if (it != m_ManifestMap.end())
+		{
+			ulKey = it->second;
+			bHasKey = true;
+		}
+	}
+
+	// キャッシュから読み込む
+	if (bHasKey)
+	{
+		std::string sPath = MakeCachePath(ulKey);
+		fopen_s(&fp, sPath.c_str(), "rb");
+		if (fp)
+		{
+			fseek(fp, 0, SEEK_END);
+			long nSize = ftell(fp);
+			fseek(fp, 0, SEEK_SET);
+			outData.resize(nSize > 0 ? nSize : 0);
+			size_t nRead = nSize > 0 ? fread(outData.data(), nSize, 1, fp) : 0;
+			fclose(fp);
+			if (nRead == 1)
+			{
+				// ソースから計算したキーが対応表と違えば対応表を更新する
+				auto it = m_ManifestMap.find(sManifestKey);
+				if (it == m_ManifestMap.end() || it->second != ulKey)
+				{
+					m_ManifestMap[sManifestKey] = ulKey;
+					m_bManifestDirty = true;
+				}
+				return ShaderCacheResult::Hit;
+			}
+			outData.clear();
+		}
+	}
+
+	if (!isCompile || sCode.empty())
+	{
+		m_sError = std::string("Shader cache not found : ") + pSource;
+		return ShaderCacheResult::Failed;
+	}
+
+	// コンパイルしてキャッシュに保存する
+	if (!Compile(sCode, pSource, pTarget, inFeatures, outData)) return ShaderCacheResult::Failed;
+
+	CreateDirectoryA(SHADER_CACHE_PATH(""), nullptr);
+	fopen_s(&fp, MakeCachePath(ulKey).c_str(), "wb");
+	if (fp)
+	{
+		fwrite(outData.data(), outData.size(), 1, fp);
+		fclose(fp);
+		m_ManifestMap[sManifestKey] = ulKey;
+		m_bManifestDirty = true;
+	}
+	return ShaderCacheResult::Compiled;
+}
+
+/****************************************//*
+	@brief　	| 対応表の保存
+	@return		| true:成功 false:失敗
+*//****************************************/
+bool CShaderCache::SaveManifest()
+{
+	CreateDirectoryA(SHADER_CACHE_PATH(""), nullptr);
+
+	FILE* fp = nullptr;
+	fopen_s(&fp, SHADER_CACHE_PATH("Manifest.txt"), "w");
+	if (!fp) return false;
+
+	for (const auto& entry : m_ManifestMap)
+	{
+		fprintf(fp, "%s %016llx\n", entry.first.c_str(), static_cast<unsigned long long>(entry.second));
+	}
+	fclose(fp);
+	m_bManifestDirty = false;
+	return true;
+}
+
+/****************************************//*
+	@brief　	| ソースと機能からキャッシュのキーを計算(FNV-1a)
+	@param　	| inCode：HLSLソース
+	@param　	| pTarget：シェーダーモデル
+	@param　	| inFeatures：有効にする機能
+	@return		| キー
+	@note		| インクルードしたファイルの内容は含まないので、インクルードを使う場合は注意
+*//****************************************/
+uint64_t CShaderCache::MakeKey(const std::string& inCode, const char* pTarget, UINT inFeatures)
+{
+	uint64_t ulHash = 14695981039346656037ull;
+	auto Mix = [&ulHash](const void* pData, size_t inSize)
+	{
+		const uint8_t* p = static_cast<const uint8_t*>(pData);
+		for (size_t i = 0; i < inSize; i++)
+		{
+			ulHash ^= p[i];
+			ulHash *= 1099511628211ull;
+		}
+	};
+	Mix(inCode.data(), inCode.size());
+	Mix(pTarget, strlen(pTarget));
+	Mix(&inFeatures, sizeof(inFeatures));
+	Mix(&ce_nCompileFlag, sizeof(ce_nCompileFlag));
+	return ulHash;
+}
+
+/****************************************//*
+	@brief　	| キーからファイル名を作成
+	@param　	| inKey：キー
+	@return		| ファイル名
+*//****************************************/
+std::string CShaderCache::MakeCachePath(uint64_t inKey)
+{
+	char szName[32];
+	sprintf_s(szName, "%016llx.cso", static_cast<unsigned long long>(inKey));
+	return std::string(SHADER_CACHE_PATH("")) + szName;
+}
+
+/****************************************//*
+	@brief　	| 機能の定義を付けてコンパイル
+	@param　	| inCode：HLSLソース
+	@param　	| pSource：HLSLソースのファイル名(インクルードの基準)
+	@param　	| pTarget：シェーダーモデル
+	@param　	| inFeatures：有効にする機能
+	@param　	| outData：シェーダーデータの格納先
+	@return		| true:成功 false:失敗
+*//****************************************/
+bool CShaderCache::Compile(const std::string& inCode, const char* pSource, const char* pTarget, UINT inFeatures, std::vector<char>& outData)
+{
+	// 有効な機能を「名前 1」、無効な機能を「名前 0」で定義する
+	D3D_SHADER_MACRO tMacro[ce_nShaderFeatureNum + 1] = {};
+	for (UINT i = 0; i < ce_nShaderFeatureNum; i++)
+	{
+		tMacro[i].Name = ce_pFeatureDefine[i];
+		tMacro[i].Definition = (inFeatures & (1u << i)) ? "1" : "0";
+	}
+
+	ID3DBlob* pBlob = nullptr;
+	ID3DBlob* pError = nullptr;
+	HRESULT hr = D3DCompile(inCode.data(), inCode.size(), pSource, tMacro, D3D_COMPILE_STANDARD_FILE_INCLUDE,
+		"main", pTarget, ce_nCompileFlag, 0, &pBlob, &pError);
+	if (FAILED(hr))
+	{
+		m_sError = pError ? static_cast<const char*>(pError->GetBufferPointer()) : pSource;
+		SAFE_RELEASE(pError);
+		SAFE_RELEASE(pBlob);
+		return false;
+	}
+
+	const char* pData = static_cast<const char*>(pBlob->GetBufferPointer());
+	outData.assign(pData, pData + pBlob->GetBufferSize());
+	SAFE_RELEASE(pError);
+	SAFE_RELEASE(pBlob);
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 対応表のキー文字列を作成
+	@param　	| pSource：HLSLソースのファイル名
+	@param　	| inFeatures：有効にする機能
+	@return		| キー文字列
+*//****************************************/
+std::string CShaderCache::MakeManifestKey(const char* pSource, UINT inFeatures)
+{
+	char szFeatures[16];
+	sprintf_s(szFeatures, " %x", inFeatures);
+	return std::string(pSource) + szFeatures;
+}
@@ -0,0 +1,92 @@
+/**************************************************//*
+	@file	| ShaderCache.h
+	@brief	| シェーダーキャッシュクラスのhファイル
+	@note	| HLSLソースを機能の組み合わせ(バリエーション)毎にコンパイルし、
+			| ソースの内容から計算したハッシュ値をファイル名にして保存する
+			| ソースが無い環境では対応表(Manifest.txt)からファイルを探す
+*//**************************************************/
+#pragma once
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+// @brief キャッシュの保存先
+#define SHADER_CACHE_PATH(path) ("Assets/Shader/Cache/" path)
+
+// @brief キャッシュからの読み込み結果
+enum class ShaderCacheResult
+{
+	Hit,		// キャッシュから読み込んだ
+	Compiled,	// キャッシュに無いのでコンパイルして保存した
+	Failed,		// 読み込めなかった
+};
+
+// @brief シェーダーキャッシュクラス
+class CShaderCache
+{
+public:
+	// @brief コンストラクタ
+	// @note 対応表を読み込む
+	CShaderCache();
+
+	// @brief デストラクタ
+	// @note 対応表が変わっていれば保存する
+	~CShaderCache();
+
+	// @brief コンパイル済みのシェーダーデータを取得
+	// @param pSource：HLSLソースのファイル名
+	// @param pTarget：シェーダーモデル("vs_5_0"など)
+	// @param inFeatures：有効にする機能(ShaderFeatureの組み合わせ)
+	// @param isCompile：キャッシュに無い場合にコンパイルするかどうか
+	// @param outData：シェーダーデータの格納先
+	// @return 読み込み結果
+	ShaderCacheResult Load(const char* pSource, const char* pTarget, UINT inFeatures, bool isCompile, std::vector<char>& outData);
+
+	// @brief 対応表の保存
+	// @return true:成功 false:失敗
+	bool SaveManifest();
+
+	// @brief 最後に失敗した時のエラーメッセージの取得
+	// @return エラーメッセージ
+	const std::string& GetError() const { return m_sError; }
+
+private:
+	// @brief ソースと機能からキャッシュのキーを計算(FNV-1a)
+	// @param inCode：HLSLソース
+	// @param pTarget：シェーダーモデル
+	// @param inFeatures：有効にする機能
+	// @return キー
+	static uint64_t MakeKey(const std::string& inCode, const char* pTarget, UINT inFeatures);
+
+	// @brief キーからファイル名を作成
+	// @param inKey：キー
+	// @return ファイル名
+	static std::string MakeCachePath(uint64_t inKey);
+
+	// @brief 機能の定義を付けてコンパイル
+	// @param inCode：HLSLソース
+	// @param pSource：HLSLソースのファイル名(インクルードの基準)
+	// @param pTarget：シェーダーモデル
+	// @param inFeatures：有効にする機能
+	// @param outData：シェーダーデータの格納先
+	// @return true:成功 false:失敗
+	bool Compile(const std::string& inCode, const char* pSource, const char* pTarget, UINT inFeatures, std::vector<char>& outData);
+
+	// @brief 対応表のキー文字列を作成
+	// @param pSource：HLSLソースのファイル名
+	// @param inFeatures：有効にする機能
+	// @return キー文字列
+	static std::string MakeManifestKey(const char* pSource, UINT inFeatures);
+
+private:
+	// @brief ソースと機能の組み合わせからキャッシュのキーへの対応表
+	std::map<std::string, uint64_t> m_ManifestMap;
+
+	// @brief 対応表が変わったかどうか
+	bool m_bManifestDirty;
+
+	// @brief 最後に失敗した時のエラーメッセージ
+	std::string m_sError;
+};
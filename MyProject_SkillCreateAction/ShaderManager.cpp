@@ -5,11 +5,60 @@
 			| VOgp^[ō쐬
 *//**************************************************/
 #include "ShaderManager.h"
+#include "ShaderCache.h"
+#include <stdio.h>
+
+// @brief VF[_[̃oG[V̒`
+struct ShaderPermutationDesc
+{
+	// _VF[_[ǂ
+	bool m_bVertex;
+
+	// (VSType܂PSType)
+	int m_nType;
+
+	// HLSL\[X̃t@C
+	const char* m_pSource;
+
+	// gݍ킹@\(SĂ̑gݍ킹쐬)
+	UINT m_nFeatureMask;
+};
+
+// 쐬VF[_[̈ꗗ
+static const ShaderPermutationDesc ce_tPermutation[] =
+{
+	{ true,  static_cast<int>(VSType::Object),		"VS_Object.hlsl",	SHADER_FEATURE_SKINNING | SHADER_FEATURE_MORPH | SHADER_FEATURE_INSTANCING },
+	{ true,  static_cast<int>(VSType::Sprite),		"VS_Sprite.hlsl",	SHADER_FEATURE_NONE },
+	{ true,  static_cast<int>(VSType::SpriteBatch),	"VS_SpriteBatch.hlsl",	SHADER_FEATURE_NONE },
+	{ false, static_cast<int>(PSType::TexColor),	"PS_TexColor.hlsl",	SHADER_FEATURE_ALPHA_TEST },
+	{ false, static_cast<int>(PSType::Sprite),		"PS_Sprite.hlsl",	SHADER_FEATURE_NONE },
+};
+
+/*****************************************//*
+	@brief@	| SẴoG[Vɑ΂ďs
+	@param@	| funcF(`Ƌ@\̑gݍ킹󂯎)
+*//*****************************************/
+template<class Func>
+static void ForEachPermutation(Func func)
+{
+	for (const ShaderPermutationDesc& desc : ce_tPermutation)
+	{
+		// @\̑gݍ킹̕WSė񋓂
+		UINT features = desc.m_nFeatureMask;
+		while (true)
+		{
+			func(desc, features);
+			if (features == 0) break;
+			features = (features - 1) & desc.m_nFeatureMask;
+		}
+	}
+}
 
 /*****************************************//*
 	@brief@	| RXgN^
 *//*****************************************/
 CShaderManager::CShaderManager()
+	: m_tLoadStats{}
 {
 }
 
@@ -34,63 +83,121 @@ CShaderManager::~CShaderManager()
 
 /*****************************************//*
 	@brief@	| VF[_[̓ǂݍ
+	@note		| SẴoG[VVF[_[LbVǂݍ
+				| iłŃLbVɖꍇ́A\[X΂̏ŃRpCăOɎc
 *//*****************************************/
 void CShaderManager::LoadShaders()
 {
+	LARGE_INTEGER freq, start, end;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&start);
 
-	//== _VF[_[̓ǂݍ
+	m_tLoadStats = {};
+	CShaderCache tCache;
+	std::vector<char> data;
 
-	// VS_Object
-	VertexShader* pVSObj = new(std::nothrow) VertexShader(VSType::Object);
-	if (pVSObj != nullptr)
+#ifdef _DEBUG
+	// J̓\[XύX炻̏ŃRpCăLbVXV
+	const bool isCompile = true;
+#else
+	// ił̓ItCō쐬LbV(rh-buildshadersō쐬)g
+	const bool isCompile = false;
+#endif
+
+	ForEachPermutation([&](const ShaderPermutationDesc& desc, UINT features)
 	{
-		if (!pVSObj->Load(SHADER_PATH("VS_Object.cso")))
+		const char* pTarget = desc.m_bVertex ? "vs_5_0" : "ps_5_0";
+		ShaderCacheResult eResult = tCache.Load(desc.m_pSource, pTarget, features, isCompile, data);
+		if (eResult == ShaderCacheResult::Failed && !isCompile)
 		{
-			m_VSMap[VSType::Object] = pVSObj;
+			// LbV쐬ĂȂꍇ́A`łȂȂȂ悤ɃRpC
+			char szLog[MAX_PATH + 64];
+			sprintf_s(szLog, "Shader cache miss : %s %x (compile at runtime)\n", desc.m_pSource, features);
+			OutputDebugStringA(szLog);
+			eResult = tCache.Load(desc.m_pSource, pTarget, features, true, data);
 		}
-	}
-
-	// VS_Sprite
-	VertexShader* pVSSprite = new(std::nothrow) VertexShader(VSType::Sprite);
-	if (pVSSprite != nullptr)
-	{
-		if (!pVSSprite->Load(SHADER_PATH("VS_Sprite.cso")))
+		if (eResult == ShaderCacheResult::Failed)
 		{
-			m_VSMap[VSType::Sprite] = pVSSprite;
+			OutputDebugStringA((tCache.GetError() + "\n").c_str());
+			m_tLoadStats.m_nFailNum++;
+			return;
 		}
-	}
-	
-	//== sNZVF[_[̓ǂݍ
+		if (eResult == ShaderCacheResult::Hit) m_tLoadStats.m_nHitNum++;
+		else m_tLoadStats.m_nCompileNum++;
 
-	// PS_TexColor
-	PixelShader* pPSTexColor = new(std::nothrow) PixelShader(PSType::TexColor);
-	if (pPSTexColor != nullptr)
-	{
-		if (!pPSTexColor->Load(SHADER_PATH("PS_TexColor.cso")))
+		if (desc.m_bVertex)
 		{
-			m_PSMap[PSType::TexColor] = pPSTexColor;
+			VSType eType = static_cast<VSType>(desc.m_nType);
+			VertexShader* pVS = new(std::nothrow) VertexShader(eType, features);
+			if (pVS != nullptr && SUCCEEDED(pVS->Create(data.data(), static_cast<UINT>(data.size()))))
+			{
+				m_VSMap[std::make_pair(eType, features)] = pVS;
+				m_tLoadStats.m_nShaderNum++;
+				return;
+			}
+			SAFE_DELETE(pVS);
 		}
-	}
+		else
+		{
+			PSType eType = static_cast<PSType>(desc.m_nType);
+			PixelShader* pPS = new(std::nothrow) PixelShader(eType, features);
+			if (pPS != nullptr && SUCCEEDED(pPS->Create(data.data(), static_cast<UINT>(data.size()))))
+			{
+				m_PSMap[std::make_pair(eType, features)] = pPS;
+				m_tLoadStats.m_nShaderNum++;
+				return;
+			}
+			SAFE_DELETE(pPS);
+		}
+		m_tLoadStats.m_nFailNum++;
+	});
+
+	QueryPerformanceCounter(&end);
+	m_tLoadStats.m_dLoadMs = static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(freq.QuadPart);
+}
 
-	// PS_Sprite
-	PixelShader* pPSSprite = new(std::nothrow) PixelShader(PSType::Sprite);
-	if (pPSSprite != nullptr)
+/*****************************************//*
+	@brief@	| VF[_[LbV̍쐬(ItCŎs)
+	@return		| 쐬łȂVF[_[̐
+	@note		| foCXg킸ɑSẴoG[VRpCALbVƑΉ\ۑ
+				| rh̏ŎŝŁAG[̓_CAOoɕWG[o͂֏o
+*//*****************************************/
+int CShaderManager::BuildShaderCache()
+{
+	CShaderCache tCache;
+	std::vector<char> data;
+	std::string sError;
+	int nFailNum = 0;
+
+	ForEachPermutation([&](const ShaderPermutationDesc& desc, UINT features)
 	{
-		if (!pPSSprite->Load(SHADER_PATH("PS_Sprite.cso")))
+		if (tCache.Load(desc.m_pSource, desc.m_bVertex ? "vs_5_0" : "ps_5_0", features, true, data) == ShaderCacheResult::Failed)
 		{
-			m_PSMap[PSType::Sprite] = pPSSprite;
+			sError += tCache.GetError() + "\n";
+			nFailNum++;
 		}
+	});
+
+	if (!tCache.SaveManifest())
+	{
+		sError += "Failed to save Manifest.txt\n";
+		nFailNum++;
+	}
+	if (nFailNum > 0)
+	{
+		fprintf(stderr, "Error:ShaderManager.cpp\n%s", sError.c_str());
 	}
+	return nFailNum;
 }
 
-
 /*****************************************//*
 	@brief@	| _VF[_[̎擾
 	@param[in]	| typeF_VF[_[̎
+	@param[in]	| featuresFLȋ@\
 *//*****************************************/
-VertexShader* CShaderManager::GetVertexShader(VSType type)
+VertexShader* CShaderManager::GetVertexShader(VSType type, UINT features)
 {
-	auto it = m_VSMap.find(type);
+	auto it = m_VSMap.find(std::make_pair(type, features));
 	if (it != m_VSMap.end())
 	{
 		return it->second;
@@ -101,10 +208,11 @@ VertexShader* CShaderManager::GetVertexShader(VSType type)
 /*****************************************//*
 	@brief@	| sNZVF[_[̎擾
 	@param[in]	| typeFsNZVF[_[̎
+	@param[in]	| featuresFLȋ@\
 *//*****************************************/
-PixelShader* CShaderManager::GetPixelShader(PSType type)
+PixelShader* CShaderManager::GetPixelShader(PSType type, UINT features)
 {
-	auto it = m_PSMap.find(type);
+	auto it = m_PSMap.find(std::make_pair(type, features));
 	if (it != m_PSMap.end())
 	{
 		return it->second;
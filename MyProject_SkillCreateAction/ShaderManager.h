@@ -7,6 +7,26 @@
 #pragma once
 #include "Singleton.h"
 #include "Shader.h"
+#include <utility>
+
+// @brief VF[_[ǂݍ݂̓v
+struct ShaderLoadStats
+{
+	// 쐬VF[_[̐
+	int m_nShaderNum;
+
+	// LbVǂݍ񂾐
+	int m_nHitNum;
+
+	// LbVɖRpC
+	int m_nCompileNum;
+
+	// ǂݍ߂Ȃ
+	int m_nFailNum;
+
+	// ǂݍ݂Ɋ|(~b)
+	double m_dLoadMs;
+};
 
 // @brief VF[_[}l[W[NX
 class CShaderManager : public ISingleton<CShaderManager>
@@ -21,22 +41,35 @@ public:
 	~CShaderManager();
 	
 	// @brief VF[_[̓ǂݍ
+	// @note SẴoG[VVF[_[LbVǂݍ
 	void LoadShaders();
 
+	// @brief VF[_[LbV̍쐬(ItCŎs)
+	// @return 쐬łȂVF[_[̐
+	// @note foCXg킸ɑSẴoG[VRpCALbVƑΉ\ۑ
+	static int BuildShaderCache();
+
 	// @brief _VF[_[̎擾
 	// @param[in] typeF_VF[_[̎
-	VertexShader* GetVertexShader(VSType type);
+	// @param[in] featuresFLȋ@\(ShaderFeaturȇgݍ킹)
+	VertexShader* GetVertexShader(VSType type, UINT features = SHADER_FEATURE_NONE);
 
 	// @brief sNZVF[_[̎擾
 	// @param[in] typeFsNZVF[_[̎
-	PixelShader* GetPixelShader(PSType type);
+	// @param[in] featuresFLȋ@\(ShaderFeaturȇgݍ킹)
+	PixelShader* GetPixelShader(PSType type, UINT features = SHADER_FEATURE_NONE);
 
+	// @brief VF[_[ǂݍ݂̓v̎擾
+	// @return v
+	const ShaderLoadStats& GetLoadStats() const { return m_tLoadStats; }
 
 private:
 
-	// @brief _VF[_[i[p}bv
-	std::map<VSType, VertexShader*> m_VSMap;
-	// @brief sNZVF[_[i[p}bv
-	std::map<PSType, PixelShader*> m_PSMap;
+	// @brief _VF[_[i[p}bv(ނƋ@\̑gݍ킹)
+	std::map<std::pair<VSType, UINT>, VertexShader*> m_VSMap;
+	// @brief sNZVF[_[i[p}bv(ނƋ@\̑gݍ킹)
+	std::map<std::pair<PSType, UINT>, PixelShader*> m_PSMap;
+	// @brief VF[_[ǂݍ݂̓v
+	ShaderLoadStats m_tLoadStats;
 };
 
@@ -0,0 +1,809 @@
+/**************************************************//*
+	@file	| SkillEngine.cpp
+	@brief	| スキル実行クラスのcppファイル
+	@note	| コンパイル済みのスキルを使用者毎のクールタイムとコストで管理し、
+			| 発動したスキルを命令列のインタプリタで毎フレーム進める
+			| スキルの実行中の状態と弾は初期化時に確保したプールから取り出し、
+			| 発動の度にメモリを確保しない
+			| シングルトンパターンで作成
+*//**************************************************/
+#include "SkillEngine.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace
+{
+	// @brief 向きを正規化する
+	// @param inX：X成分
+	// @param inZ：Z成分
+	// @param inDefault：長さが0の場合の向き
+	// @return 正規化した向き
+	SkillVector Normalize(float inX, float inZ, const SkillVector& inDefault)
+	{
+		float fLength = sqrtf(inX * inX + inZ * inZ);
+		if (fLength <= 1e-6f) return inDefault;
+		return { inX / fLength, inZ / fLength };
+	}
+
+	// @brief 負荷試験用の対象を並べた世界
+	// @note 対象を一様グリッドに振り分けて円の検索を近くのセルだけで行う
+	class CStressWorld : public ISkillWorld
+	{
+	public:
+		// @brief 世界の広さ
+		static constexpr float ce_fSize = 256.0f;
+
+		// @brief セル1つの大きさ
+		static constexpr float ce_fCellSize = 4.0f;
+
+		// @brief 1辺のセル数
+		static constexpr int ce_nCellNum = static_cast<int>(ce_fSize / ce_fCellSize);
+
+		// @brief 弾が当たる対象の大きさの半分
+		static constexpr float ce_fTargetHalfSize = 0.5f;
+
+		// @brief 対象を並べる
+		// @param inTargetNum：対象の数
+		// @param ioRandom：乱数
+		void Init(uint32_t inTargetNum, std::mt19937& ioRandom)
+		{
+			std::uniform_real_distribution<float> tPos(0.0f, ce_fSize);
+			m_TargetVec.resize(inTargetNum);
+			for (uint32_t i = 0; i < inTargetNum; i++) m_TargetVec[i] = { i, { tPos(ioRandom), tPos(ioRandom) } };
+			m_SortedVec.resize(inTargetNum);
+			m_CellStartVec.resize(ce_nCellNum * ce_nCellNum + 1);
+			m_EffectNum.fill(0);
+			Build();
+		}
+
+		// @brief 対象をセル順に並べ直す
+		void Build()
+		{
+			std::fill(m_CellStartVec.begin(), m_CellStartVec.end(), 0u);
+			for (const SkillTarget& tTarget : m_TargetVec) m_CellStartVec[GetCell(tTarget.m_tPos) + 1]++;
+			for (size_t i = 1; i < m_CellStartVec.size(); i++) m_CellStartVec[i] += m_CellStartVec[i - 1];
+
+			// 各セルの書き込み位置を先頭からずらしながら詰め、最後に1つ戻す
+			for (const SkillTarget& tTarget : m_TargetVec) m_SortedVec[m_CellStartVec[GetCell(tTarget.m_tPos)]++] = tTarget;
+			for (size_t i = m_CellStartVec.size() - 1; i > 0; i--) m_CellStartVec[i] = m_CellStartVec[i - 1];
+			m_CellStartVec[0] = 0;
+		}
+
+		uint32_t QueryCircle(const SkillVector& inCenter, float inRadius, SkillTarget* outTargets, uint32_t inMaxNum) override
+		{
+			int nMinX = ClampCell(inCenter.m_fX - inRadius), nMaxX = ClampCell(inCenter.m_fX + inRadius);
+			int nMinY = ClampCell(inCenter.m_fZ - inRadius), nMaxY = ClampCell(inCenter.m_fZ + inRadius);
+			float fRadiusSq = inRadius * inRadius;
+
+			uint32_t nNum = 0;
+			for (int y = nMinY; y <= nMaxY; y++)
+			{
+				for (int x = nMinX; x <= nMaxX; x++)
+				{
+					int nCell = y * ce_nCellNum + x;
+					for (uint32_t i = m_CellStartVec[nCell]; i < m_CellStartVec[nCell + 1]; i++)
+					{
+						const SkillTarget& tTarget = m_SortedVec[i];
+						float fDx = tTarget.m_tPos.m_fX - inCenter.m_fX;
+						float fDz = tTarget.m_tPos.m_fZ - inCenter.m_fZ;
+						if (fDx * fDx + fDz * fDz > fRadiusSq) continue;
+						outTargets[nNum++] = tTarget;
+						if (nNum == inMaxNum) return nNum;
+					}
+				}
+			}
+			return nNum;
+		}
+
+		void ApplyEffect(const SkillEffectEvent& inEvent) override
+		{
+			m_EffectNum[static_cast<size_t>(inEvent.m_eType)]++;
+			if (inEvent.m_eType != SkillEffectType::Knockback) return;
+
+			// 吹き飛ばしだけは位置を動かし、次のフレームの検索に反映する
+			SkillVector& tPos = m_TargetVec[inEvent.m_nTarget].m_tPos;
+			tPos.m_fX = (std::min)((std::max)(tPos.m_fX + inEvent.m_tDirection.m_fX * inEvent.m_fValue, 0.0f), ce_fSize - 0.01f);
+			tPos.m_fZ = (std::min)((std::max)(tPos.m_fZ + inEvent.m_tDirection.m_fZ * inEvent.m_fValue, 0.0f), ce_fSize - 0.01f);
+		}
+
+		void SubmitColliders(CProjectileSystem& outSystem) override
+		{
+			for (const SkillTarget& tTarget : m_TargetVec)
+			{
+				outSystem.AddCollider({ { tTarget.m_tPos.m_fX - ce_fTargetHalfSize, -1.0f, tTarget.m_tPos.m_fZ - ce_fTargetHalfSize },
+					{ tTarget.m_tPos.m_fX + ce_fTargetHalfSize, 1.0f, tTarget.m_tPos.m_fZ + ce_fTargetHalfSize }, tTarget.m_nId });
+			}
+		}
+
+		// @brief 対象の位置の取得
+		const SkillVector& GetPos(uint32_t inId) const { return m_TargetVec[inId].m_tPos; }
+
+		// @brief 種類毎の効果の数の取得
+		const std::array<long long, 5>& GetEffectNum() const { return m_EffectNum; }
+
+	private:
+		// @brief 座標をセル番号に直す
+		int ClampCell(float inPos) const
+		{
+			return (std::max)(0, (std::min)(static_cast<int>(inPos / ce_fCellSize), ce_nCellNum - 1));
+		}
+
+		// @brief 座標が含まれるセル
+		int GetCell(const SkillVector& inPos) const
+		{
+			return ClampCell(inPos.m_fZ) * ce_nCellNum + ClampCell(inPos.m_fX);
+		}
+
+	private:
+		// @brief 対象(番号順)
+		std::vector<SkillTarget> m_TargetVec;
+
+		// @brief 対象(セル順)
+		std::vector<SkillTarget> m_SortedVec;
+
+		// @brief セル毎の先頭の位置
+		std::vector<uint32_t> m_CellStartVec;
+
+		// @brief 種類毎の効果の数
+		std::array<long long, 5> m_EffectNum;
+	};
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CSkillEngine::CSkillEngine()
+	: m_tProjectiles()
+	, m_tQueryBuffer{}
+	, m_tCount{}
+	, m_tStats{}
+{
+	Init();
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CSkillEngine::~CSkillEngine()
+{
+}
+
+/****************************************//*
+	@brief　	| プールの確保
+	@param　	| inInstanceNum：同時に実行できるスキルの数
+	@param　	| inProjectileNum：同時に飛ばせる弾の数
+*//****************************************/
+void CSkillEngine::Init(uint32_t inInstanceNum, uint32_t inProjectileNum)
+{
+	m_InstanceVec.assign(inInstanceNum, Instance{});
+	m_ActiveInstanceVec.clear();
+	m_ActiveInstanceVec.reserve(inInstanceNum);
+
+	// 若い番号から取り出せるように逆順に積む
+	m_FreeInstanceVec.resize(inInstanceNum);
+	for (uint32_t i = 0; i < inInstanceNum; i++) m_FreeInstanceVec[i] = inInstanceNum - 1 - i;
+
+	m_tProjectiles.Init(inProjectileNum);
+}
+
+/****************************************//*
+	@brief　	| コンパイル済みのスキルを登録する
+	@param　	| inProgram：コンパイル済みのスキル
+	@return		| スキルの番号
+*//****************************************/
+SkillId CSkillEngine::AddSkill(SkillProgram&& inProgram)
+{
+	m_SkillVec.push_back(std::move(inProgram));
+	for (Caster& tCaster : m_CasterVec) tCaster.m_CooldownVec.resize(m_SkillVec.size(), 0.0f);
+	return static_cast<SkillId>(m_SkillVec.size() - 1);
+}
+
+/****************************************//*
+	@brief　	| フォルダ内のスキルの定義(.json)を名前順に全て読み込む
+	@param　	| inDirectory：フォルダのパス
+	@param　	| outErrors：読み込めなかったファイルと理由
+	@return		| 読み込んだ数
+*//****************************************/
+int CSkillEngine::LoadSkillDirectory(const char* inDirectory, std::vector<std::string>& outErrors)
+{
+	// 読み込む順番でスキルの番号が決まるため、ファイル名順に並べる
+	std::vector<std::filesystem::path> tPathVec;
+	std::error_code ec;
+	for (const auto& entry : std::filesystem::directory_iterator(inDirectory, ec))
+	{
+		if (!entry.is_regular_file() || entry.path().extension() != ".json") continue;
+		tPathVec.push_back(entry.path());
+	}
+	std::sort(tPathVec.begin(), tPathVec.end());
+
+	int nLoadNum = 0;
+	for (const std::filesystem::path& tPath : tPathVec)
+	{
+		SkillProgram tProgram;
+		std::string sError;
+		if (!CSkillCompiler::CompileFile(tPath.string().c_str(), tProgram, sError))
+		{
+			outErrors.push_back(tPath.filename().string() + ": " + sError);
+			continue;
+		}
+
+		// 名前が無ければファイル名を名前にする
+		if (tProgram.m_sName.empty()) tProgram.m_sName = tPath.stem().string();
+		AddSkill(std::move(tProgram));
+		nLoadNum++;
+	}
+	return nLoadNum;
+}
+
+/****************************************//*
+	@brief　	| 名前からスキルを探す
+	@param　	| inName：名前
+	@return		| スキルの番号(無ければce_nInvalidId)
+*//****************************************/
+SkillId CSkillEngine::FindSkill(const std::string& inName) const
+{
+	for (size_t i = 0; i < m_SkillVec.size(); i++)
+	{
+		if (m_SkillVec[i].m_sName == inName) return static_cast<SkillId>(i);
+	}
+	return ce_nInvalidId;
+}
+
+/****************************************//*
+	@brief　	| 使用者を作成する
+	@param　	| inSource：使用者自身の対象の番号
+	@param　	| inResourceMax：コストの上限
+	@param　	| inRegen：1秒あたりのコストの回復量
+	@return		| 使用者の番号
+*//****************************************/
+SkillCasterId CSkillEngine::CreateCaster(uint32_t inSource, float inResourceMax, float inRegen)
+{
+	SkillCasterId nCaster;
+	if (!m_FreeCasterVec.empty())
+	{
+		nCaster = m_FreeCasterVec.back();
+		m_FreeCasterVec.pop_back();
+	}
+	else
+	{
+		nCaster = static_cast<SkillCasterId>(m_CasterVec.size());
+		m_CasterVec.emplace_back();
+	}
+
+	Caster& tCaster = m_CasterVec[nCaster];
+	tCaster.m_nSource = inSource;
+	tCaster.m_fResource = inResourceMax;
+	tCaster.m_fResourceMax = inResourceMax;
+	tCaster.m_fRegen = inRegen;
+	tCaster.m_bActive = true;
+	tCaster.m_CooldownVec.assign(m_SkillVec.size(), 0.0f);
+	return nCaster;
+}
+
+/****************************************//*
+	@brief　	| 使用者を破棄する
+	@param　	| inCaster：使用者の番号
+*//****************************************/
+void CSkillEngine::DestroyCaster(SkillCasterId inCaster)
+{
+	if (inCaster >= m_CasterVec.size() || !m_CasterVec[inCaster].m_bActive) return;
+
+	m_CasterVec[inCaster].m_bActive = false;
+	m_FreeCasterVec.push_back(inCaster);
+}
+
+/****************************************//*
+	@brief　	| 残りのコストの取得
+	@param　	| inCaster：使用者の番号
+	@return		| 残りのコスト
+*//****************************************/
+float CSkillEngine::GetResource(SkillCasterId inCaster) const
+{
+	if (inCaster >= m_CasterVec.size()) return 0.0f;
+	return m_CasterVec[inCaster].m_fResource;
+}
+
+/****************************************//*
+	@brief　	| 残りのクールタイムの取得
+	@param　	| inCaster：使用者の番号
+	@param　	| inSkill：スキルの番号
+	@return		| 残りのクールタイム(秒)
+*//****************************************/
+float CSkillEngine::GetCooldown(SkillCasterId inCaster, SkillId inSkill) const
+{
+	if (inCaster >= m_CasterVec.size() || inSkill >= m_SkillVec.size()) return 0.0f;
+	return m_CasterVec[inCaster].m_CooldownVec[inSkill];
+}
+
+/****************************************//*
+	@brief　	| スキルを発動する
+	@param　	| inCaster：使用者の番号
+	@param　	| inSkill：スキルの番号
+	@param　	| inOrigin：発動位置
+	@param　	| inDirection：向き(正規化しなくてよい)
+	@return		| 発動の結果
+*//****************************************/
+SkillCastResult CSkillEngine::Cast(SkillCasterId inCaster, SkillId inSkill, const SkillVector& inOrigin, const SkillVector& inDirection)
+{
+	SkillCastResult eResult = SkillCastResult::Success;
+	if (inCaster >= m_CasterVec.size() || !m_CasterVec[inCaster].m_bActive || inSkill >= m_SkillVec.size())
+	{
+		eResult = SkillCastResult::Invalid;
+	}
+	else
+	{
+		Caster& tCaster = m_CasterVec[inCaster];
+		const SkillProgram& tProgram = m_SkillVec[inSkill];
+		if (tCaster.m_CooldownVec[inSkill] > 0.0f) eResult = SkillCastResult::Cooldown;
+		else if (tCaster.m_fResource < tProgram.m_fCost) eResult = SkillCastResult::Resource;
+		else if (!SpawnInstance(inSkill, tCaster.m_nSource, 0, inOrigin, Normalize(inDirection.m_fX, inDirection.m_fZ, { 0.0f, 1.0f })))
+		{
+			eResult = SkillCastResult::PoolFull;
+		}
+		else
+		{
+			tCaster.m_fResource -= tProgram.m_fCost;
+			tCaster.m_CooldownVec[inSkill] = tProgram.m_fCooldown;
+		}
+	}
+
+	if (eResult == SkillCastResult::Success) m_tCount.m_nCastNum++;
+	else m_tCount.m_nRejectNum++;
+	return eResult;
+}
+
+/****************************************//*
+	@brief　	| 更新
+	@param　	| inDeltaTime：経過時間(秒)
+	@param　	| inWorld：対象を探し、効果を与える先
+*//****************************************/
+void CSkillEngine::Update(float inDeltaTime, ISkillWorld& inWorld)
+{
+	auto tStart = std::chrono::high_resolution_clock::now();
+
+	// コストの回復とクールタイムを進める
+	for (Caster& tCaster : m_CasterVec)
+	{
+		if (!tCaster.m_bActive) continue;
+		tCaster.m_fResource = (std::min)(tCaster.m_fResource + tCaster.m_fRegen * inDeltaTime, tCaster.m_fResourceMax);
+		for (float& fCooldown : tCaster.m_CooldownVec) fCooldown = (std::max)(fCooldown - inDeltaTime, 0.0f);
+	}
+
+	// 弾を先に動かし、命中時の命令を同じフレームで実行する
+	UpdateProjectiles(inDeltaTime, inWorld);
+
+	// 待ちが明けたスキルを実行し、終わったものをプールに戻す
+	for (size_t i = 0; i < m_ActiveInstanceVec.size();)
+	{
+		uint32_t nIndex = m_ActiveInstanceVec[i];
+		Instance& tInstance = m_InstanceVec[nIndex];
+		if (tInstance.m_fWait > 0.0f) tInstance.m_fWait -= inDeltaTime;
+		if (tInstance.m_fWait > 0.0f || !Run(tInstance, inWorld))
+		{
+			i++;
+			continue;
+		}
+
+		m_ActiveInstanceVec[i] = m_ActiveInstanceVec.back();
+		m_ActiveInstanceVec.pop_back();
+		m_FreeInstanceVec.push_back(nIndex);
+	}
+
+	m_tCount.m_nInstanceNum = static_cast<int>(m_ActiveInstanceVec.size());
+	m_tCount.m_nProjectileNum = static_cast<int>(m_tProjectiles.GetNum());
+	m_tCount.m_dUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+	m_tStats = m_tCount;
+	m_tCount = {};
+}
+
+/****************************************//*
+	@brief　	| 実行中のスキルをプールから取り出して登録する
+	@param　	| inSkill：スキルの番号
+	@param　	| inSource：使用者自身の対象の番号
+	@param　	| inPc：最初に実行する命令位置
+	@param　	| inOrigin：発生位置
+	@param　	| inDirection：向き(正規化済み)
+	@return		| 実行中のスキル(プールが空ならnullptr)
+*//****************************************/
+CSkillEngine::Instance* CSkillEngine::SpawnInstance(SkillId inSkill, uint32_t inSource, uint32_t inPc, const SkillVector& inOrigin, const SkillVector& inDirection)
+{
+	if (m_FreeInstanceVec.empty()) return nullptr;
+
+	uint32_t nIndex = m_FreeInstanceVec.back();
+	m_FreeInstanceVec.pop_back();
+	m_ActiveInstanceVec.push_back(nIndex);
+
+	Instance& tInstance = m_InstanceVec[nIndex];
+	tInstance.m_nSkill = inSkill;
+	tInstance.m_nSource = inSource;
+	tInstance.m_nPc = inPc;
+	tInstance.m_fWait = 0.0f;
+	tInstance.m_tOrigin = inOrigin;
+	tInstance.m_tDirection = inDirection;
+	tInstance.m_tHit = { ce_nInvalidId, inOrigin };
+	tInstance.m_nLoopDepth = 0;
+	tInstance.m_nTargetNum = 0;
+	return &tInstance;
+}
+
+/****************************************//*
+	@brief　	| 命令を待ちか終了まで実行する
+	@param　	| ioInstance：実行中のスキル
+	@param　	| inWorld：対象を探し、効果を与える先
+	@return		| true:終了した false:待ち
+*//****************************************/
+bool CSkillEngine::Run(Instance& ioInstance, ISkillWorld& inWorld)
+{
+	const uint32_t* pCode = m_SkillVec[ioInstance.m_nSkill].m_CodeVec.data();
+	uint32_t nPc = ioInstance.m_nPc;
+
+	// 命令数に上限を設け、待ちの無い長い繰り返しで1フレームが止まらないようにする
+	for (uint32_t nBudget = ce_nOpBudget; nBudget > 0; nBudget--)
+	{
+		m_tCount.m_nOpNum++;
+		switch (static_cast<SkillOp>(pCode[nPc]))
+		{
+		case SkillOp::End:
+			return true;
+
+		case SkillOp::Wait:
+			// 前の待ちで過ぎた分を差し引き、フレームの区切りで時間がずれないようにする
+			ioInstance.m_fWait += SkillCodeToFloat(pCode[nPc + 1]);
+			nPc += 2;
+			if (ioInstance.m_fWait > 0.0f)
+			{
+				ioInstance.m_nPc = nPc;
+				return false;
+			}
+			break;
+
+		case SkillOp::Query:
+			Query(ioInstance, static_cast<SkillShape>(pCode[nPc + 1]), SkillCodeToFloat(pCode[nPc + 2]),
+				SkillCodeToFloat(pCode[nPc + 3]), SkillCodeToFloat(pCode[nPc + 4]), inWorld);
+			nPc += 5;
+			break;
+
+		case SkillOp::Effect:
+		{
+			SkillEffectEvent tEvent;
+			tEvent.m_nSource = ioInstance.m_nSource;
+			tEvent.m_eType = static_cast<SkillEffectType>(pCode[nPc + 1]);
+			tEvent.m_fValue = SkillCodeToFloat(pCode[nPc + 2]);
+			tEvent.m_fDuration = SkillCodeToFloat(pCode[nPc + 3]);
+			for (uint32_t i = 0; i < ioInstance.m_nTargetNum; i++)
+			{
+				const SkillTarget& tTarget = ioInstance.m_tTargets[i];
+				tEvent.m_nTarget = tTarget.m_nId;
+				tEvent.m_tDirection = Normalize(tTarget.m_tPos.m_fX - ioInstance.m_tOrigin.m_fX,
+					tTarget.m_tPos.m_fZ - ioInstance.m_tOrigin.m_fZ, ioInstance.m_tDirection);
+				inWorld.ApplyEffect(tEvent);
+			}
+			m_tCount.m_nEffectNum += static_cast<int>(ioInstance.m_nTargetNum);
+			nPc += 4;
+			break;
+		}
+
+		case SkillOp::Projectile:
+			SpawnProjectiles(ioInstance, pCode + nPc + 1);
+			nPc += 7;
+			break;
+
+		case SkillOp::Loop:
+			ioInstance.m_nLoopCount[ioInstance.m_nLoopDepth++] = pCode[nPc + 1];
+			nPc += 2;
+			break;
+
+		case SkillOp::Next:
+			if (--ioInstance.m_nLoopCount[ioInstance.m_nLoopDepth - 1] > 0)
+			{
+				nPc = pCode[nPc + 1];
+			}
+			else
+			{
+				ioInstance.m_nLoopDepth--;
+				nPc += 2;
+			}
+			break;
+
+		default:
+			return true;
+		}
+	}
+
+	ioInstance.m_nPc = nPc;
+	return false;
+}
+
+/****************************************//*
+	@brief　	| 対象を集める
+	@param　	| ioInstance：実行中のスキル
+	@param　	| inShape：形状
+	@param　	| inRange：距離
+	@param　	| inRadius：半径
+	@param　	| inCosHalfAngle：扇形の半角のcos
+	@param　	| inWorld：対象を探す先
+*//****************************************/
+void CSkillEngine::Query(Instance& ioInstance, SkillShape inShape, float inRange, float inRadius, float inCosHalfAngle, ISkillWorld& inWorld)
+{
+	const SkillVector& tOrigin = ioInstance.m_tOrigin;
+	const SkillVector& tDirection = ioInstance.m_tDirection;
+	ioInstance.m_nTargetNum = 0;
+
+	switch (inShape)
+	{
+	case SkillShape::Self:
+		ioInstance.m_tTargets[0] = { ioInstance.m_nSource, tOrigin };
+		ioInstance.m_nTargetNum = 1;
+		return;
+
+	case SkillShape::Hit:
+		if (ioInstance.m_tHit.m_nId == ce_nInvalidId) return;
+		ioInstance.m_tTargets[0] = ioInstance.m_tHit;
+		ioInstance.m_nTargetNum = 1;
+		return;
+
+	default:
+		break;
+	}
+
+	// 形状を囲む円で集めてから形状で絞り込む
+	SkillVector tCenter = tOrigin;
+	float fQueryRadius = inRange;
+	if (inShape == SkillShape::Circle)
+	{
+		tCenter = { tOrigin.m_fX + tDirection.m_fX * inRange, tOrigin.m_fZ + tDirection.m_fZ * inRange };
+		fQueryRadius = inRadius;
+	}
+	else if (inShape == SkillShape::Line)
+	{
+		float fHalf = inRange * 0.5f;
+		tCenter = { tOrigin.m_fX + tDirection.m_fX * fHalf, tOrigin.m_fZ + tDirection.m_fZ * fHalf };
+		fQueryRadius = sqrtf(fHalf * fHalf + inRadius * inRadius);
+	}
+	uint32_t nFoundNum = inWorld.QueryCircle(tCenter, fQueryRadius, m_tQueryBuffer, ce_nMaxQuery);
+
+	for (uint32_t i = 0; i < nFoundNum && ioInstance.m_nTargetNum < ce_nMaxTarget; i++)
+	{
+		const SkillTarget& tTarget = m_tQueryBuffer[i];
+		if (tTarget.m_nId == ioInstance.m_nSource) continue;
+
+		float fDx = tTarget.m_tPos.m_fX - tOrigin.m_fX;
+		float fDz = tTarget.m_tPos.m_fZ - tOrigin.m_fZ;
+		if (inShape == SkillShape::Sector)
+		{
+			// 向きとの角度を比べる(発生位置に重なる対象は含める)
+			float fLength = sqrtf(fDx * fDx + fDz * fDz);
+			if (fLength > 1e-6f && (fDx * tDirection.m_fX + fDz * tDirection.m_fZ) < inCosHalfAngle * fLength) continue;
+		}
+		else if (inShape == SkillShape::Line)
+		{
+			// 向きに沿った距離と、横方向の距離で帯の内外を判定する
+			float fAlong = fDx * tDirection.m_fX + fDz * tDirection.m_fZ;
+			float fSide = fDx * tDirection.m_fZ - fDz * tDirection.m_fX;
+			if (fAlong < 0.0f || fAlong > inRange || fabsf(fSide) > inRadius) continue;
+		}
+		ioInstance.m_tTargets[ioInstance.m_nTargetNum++] = tTarget;
+	}
+}
+
+/****************************************//*
+	@brief　	| 弾を撃つ
+	@param　	| inInstance：撃つスキル
+	@param　	| inCode：弾の命令の引数[数, 広がり, 速さ, 寿命, 半径, 命中時の命令位置]
+*//****************************************/
+void CSkillEngine::SpawnProjectiles(const Instance& inInstance, const uint32_t* inCode)
+{
+	uint32_t nCount = inCode[0];
+	float fSpread = SkillCodeToFloat(inCode[1]);
+
+	// 広がりの範囲に等間隔で並べる(1発なら正面)
+	float fStep = (nCount > 1) ? fSpread / static_cast<float>(nCount - 1) : 0.0f;
+	float fAngle = (nCount > 1) ? -fSpread * 0.5f : 0.0f;
+	float fSpeed = SkillCodeToFloat(inCode[2]);
+
+	// 命中時にスキルと命令位置を取り出せるよう、弾の自由な値に詰めておく
+	ProjectileDesc tDesc;
+	tDesc.m_fPos[0] = inInstance.m_tOrigin.m_fX;
+	tDesc.m_fPos[1] = 0.0f;
+	tDesc.m_fPos[2] = inInstance.m_tOrigin.m_fZ;
+	tDesc.m_fLife = SkillCodeToFloat(inCode[3]);
+	tDesc.m_fRadius = SkillCodeToFloat(inCode[4]);
+	tDesc.m_nOwner = inInstance.m_nSource;
+	tDesc.m_nUserData = (static_cast<uint64_t>(inInstance.m_nSkill) << 32) | inCode[5];
+	for (uint32_t i = 0; i < nCount; i++, fAngle += fStep)
+	{
+		float fCos = cosf(fAngle);
+		float fSin = sinf(fAngle);
+		tDesc.m_fVelocity[0] = (inInstance.m_tDirection.m_fX * fCos - inInstance.m_tDirection.m_fZ * fSin) * fSpeed;
+		tDesc.m_fVelocity[1] = 0.0f;
+		tDesc.m_fVelocity[2] = (inInstance.m_tDirection.m_fX * fSin + inInstance.m_tDirection.m_fZ * fCos) * fSpeed;
+		if (m_tProjectiles.Spawn(tDesc) == CProjectileSystem::ce_nInvalidHandle)
+		{
+			m_tCount.m_nDropNum += static_cast<int>(nCount - i);
+			return;
+		}
+	}
+}
+
+/****************************************//*
+	@brief　	| 弾を動かし、当たったら命中時の命令を登録する
+	@param　	| inDeltaTime：経過時間(秒)
+	@param　	| inWorld：対象を探し、効果を与える先
+*//****************************************/
+void CSkillEngine::UpdateProjectiles(float inDeltaTime, ISkillWorld& inWorld)
+{
+	// 対象が動くため、当たる箱は毎フレーム登録し直す
+	m_tProjectiles.ClearColliders();
+	inWorld.SubmitColliders(m_tProjectiles);
+	m_tProjectiles.Update(inDeltaTime);
+
+	for (const ProjectileHit& tHit : m_tProjectiles.GetHits())
+	{
+		// 壁に当たった弾は消えるだけ
+		m_tCount.m_nHitNum++;
+		if (tHit.m_nColliderId == ce_nInvalidId) continue;
+
+		const ProjectileCollider& tCollider = m_tProjectiles.GetCollider(tHit.m_nColliderIndex);
+		SkillTarget tTarget = { tHit.m_nColliderId,
+			{ (tCollider.m_fMin[0] + tCollider.m_fMax[0]) * 0.5f, (tCollider.m_fMin[2] + tCollider.m_fMax[2]) * 0.5f } };
+		SkillVector tDirection = Normalize(tHit.m_fVelocity[0], tHit.m_fVelocity[2], { 0.0f, 1.0f });
+
+		Instance* pInstance = SpawnInstance(static_cast<SkillId>(tHit.m_nUserData >> 32), tHit.m_nOwner,
+			static_cast<uint32_t>(tHit.m_nUserData), { tHit.m_fPos[0], tHit.m_fPos[2] }, tDirection);
+		if (pInstance) pInstance->m_tHit = tTarget;
+		else m_tCount.m_nDropNum++;
+	}
+}
+
+/****************************************//*
+	@brief　	| 大量のスキルを発動し続けて計測して書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CSkillEngine::StressTest(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr uint32_t ce_nTargetNum = 4000;
+	static constexpr uint32_t ce_nCasterNum = 1000;
+	static constexpr int ce_nFrameNum = 600;
+	static constexpr float ce_fCastRate = 0.25f;
+
+	// 書き方の違いと全ての命令を含むスキル
+	static const char* const ce_pSkills[] =
+	{
+		R"({ "name": "slash", "cooldown": 0.5, "cost": 5,
+			"targeting": { "shape": "sector", "range": 3, "angle": 120 },
+			"effects": [ { "type": "damage", "value": 10 } ] })",
+		R"({ "name": "fireball", "cooldown": 1.0, "cost": 15, "castTime": 0.2,
+			"projectile": { "speed": 15, "life": 1.5, "radius": 0.5 },
+			"targeting": { "shape": "circle", "radius": 2 },
+			"effects": [ { "type": "damage", "value": 20 }, { "type": "knockback", "value": 2 } ] })",
+		R"({ "name": "heal", "cooldown": 2.0, "cost": 10,
+			"effects": [ { "type": "heal", "value": 15 } ] })",
+		R"({ "name": "meteor", "cooldown": 3.0, "cost": 30, "steps": [
+			{ "op": "wait", "time": 0.5 },
+			{ "op": "repeat", "count": 5, "interval": 0.2, "steps": [
+				{ "op": "query", "shape": "circle", "range": 6, "radius": 3 },
+				{ "op": "effect", "type": "damage", "value": 5 } ] } ] })",
+		R"({ "name": "multishot", "cooldown": 1.5, "cost": 20, "steps": [
+			{ "op": "projectile", "count": 5, "spread": 40, "speed": 20, "life": 1.0, "radius": 0.4, "onHit": [
+				{ "op": "query", "shape": "hit" },
+				{ "op": "effect", "type": "damage", "value": 8 },
+				{ "op": "effect", "type": "slow", "value": 0.5, "duration": 1.0 } ] } ] })",
+		R"({ "name": "shockwave", "cooldown": 2.5, "cost": 25,
+			"targeting": { "shape": "line", "range": 8, "radius": 1 },
+			"effects": [ { "type": "stun", "value": 1, "duration": 1.0 } ] })",
+	};
+
+	// 他のシーンの状態を壊さないようにシングルトンとは別に作る
+	CSkillEngine tEngine;
+	tEngine.Init(4096, 8192);
+	for (const char* pSkill : ce_pSkills)
+	{
+		SkillProgram tProgram;
+		std::string sError;
+		if (!CSkillCompiler::Compile(pSkill, tProgram, sError))
+		{
+			tReport << "compile error: " << sError << "\n";
+			return 1;
+		}
+		tEngine.AddSkill(std::move(tProgram));
+	}
+
+	std::mt19937 tRandom(20261019);
+	CStressWorld tWorld;
+	tWorld.Init(ce_nTargetNum, tRandom);
+
+	// 対象の先頭から使用者にする
+	std::vector<SkillCasterId> tCasterVec;
+	for (uint32_t i = 0; i < ce_nCasterNum; i++) tCasterVec.push_back(tEngine.CreateCaster(i, 100.0f, 20.0f));
+
+	// 発動の度にプールが広がっていないかを確かめるため、確保済みの領域を覚えておく
+	const Instance* pInstanceData = tEngine.m_InstanceVec.data();
+	size_t nActiveCapacity = tEngine.m_ActiveInstanceVec.capacity();
+	size_t nFreeCapacity = tEngine.m_FreeInstanceVec.capacity();
+
+	// 乱数は計測の外で先に作る
+	std::uniform_real_distribution<float> tRate(0.0f, 1.0f);
+	std::uniform_int_distribution<uint32_t> tSkill(0, tEngine.GetSkillNum() - 1);
+	std::uniform_real_distribution<float> tAngle(0.0f, 6.2831853f);
+	struct CastOrder { SkillCasterId m_nCaster; SkillId m_nSkill; float m_fAngle; };
+	std::vector<CastOrder> tOrderVec;
+	tOrderVec.reserve(ce_nCasterNum);
+
+	long long nCastNum = 0, nRejectNum = 0, nHitNum = 0, nEffectNum = 0, nOpNum = 0, nDropNum = 0;
+	long long nResultNum[5] = {};
+	int nMaxCastNum = 0, nMaxInstanceNum = 0, nMaxProjectileNum = 0;
+	double dCastMs = 0.0, dUpdateMs = 0.0, dMaxFrameMs = 0.0;
+	for (int nFrame = 0; nFrame < ce_nFrameNum; nFrame++)
+	{
+		tOrderVec.clear();
+		for (SkillCasterId nCaster : tCasterVec)
+		{
+			if (tRate(tRandom) < ce_fCastRate) tOrderVec.push_back({ nCaster, tSkill(tRandom), tAngle(tRandom) });
+		}
+
+		auto tStart = std::chrono::high_resolution_clock::now();
+		for (const CastOrder& tOrder : tOrderVec)
+		{
+			SkillCastResult eResult = tEngine.Cast(tOrder.m_nCaster, tOrder.m_nSkill, tWorld.GetPos(tOrder.m_nCaster),
+				{ cosf(tOrder.m_fAngle), sinf(tOrder.m_fAngle) });
+			nResultNum[static_cast<int>(eResult)]++;
+		}
+		auto tCastEnd = std::chrono::high_resolution_clock::now();
+		tEngine.Update(1.0f / 60.0f, tWorld);
+		auto tEnd = std::chrono::high_resolution_clock::now();
+		tWorld.Build();
+
+		double dCast = std::chrono::duration<double, std::milli>(tCastEnd - tStart).count();
+		double dUpdate = std::chrono::duration<double, std::milli>(tEnd - tCastEnd).count();
+		dCastMs += dCast;
+		dUpdateMs += dUpdate;
+		dMaxFrameMs = (std::max)(dMaxFrameMs, dCast + dUpdate);
+
+		const SkillEngineStats& tStats = tEngine.GetStats();
+		nCastNum += tStats.m_nCastNum;
+		nRejectNum += tStats.m_nRejectNum;
+		nHitNum += tStats.m_nHitNum;
+		nEffectNum += tStats.m_nEffectNum;
+		nOpNum += tStats.m_nOpNum;
+		nDropNum += tStats.m_nDropNum;
+		nMaxCastNum = (std::max)(nMaxCastNum, tStats.m_nCastNum);
+		nMaxInstanceNum = (std::max)(nMaxInstanceNum, tStats.m_nInstanceNum);
+		nMaxProjectileNum = (std::max)(nMaxProjectileNum, tStats.m_nProjectileNum);
+	}
+
+	bool bReallocated = pInstanceData != tEngine.m_InstanceVec.data()
+		|| nActiveCapacity != tEngine.m_ActiveInstanceVec.capacity() || nFreeCapacity != tEngine.m_FreeInstanceVec.capacity();
+	double dSeconds = ce_nFrameNum / 60.0;
+
+	char szLine[256];
+	sprintf_s(szLine, "skill %u  target %u  caster %u  frame %d (%.1f s)\n", tEngine.GetSkillNum(), ce_nTargetNum, ce_nCasterNum, ce_nFrameNum, dSeconds);
+	tReport << szLine;
+	sprintf_s(szLine, "cast %lld (%.0f/s, max %d/frame)  reject cooldown %lld  resource %lld  pool %lld\n",
+		nCastNum, nCastNum / dSeconds, nMaxCastNum, nResultNum[static_cast<int>(SkillCastResult::Cooldown)],
+		nResultNum[static_cast<int>(SkillCastResult::Resource)], nResultNum[static_cast<int>(SkillCastResult::PoolFull)]);
+	tReport << szLine;
+	sprintf_s(szLine, "instance max %d/%zu  projectile max %d/%zu  drop %lld  pool reallocated %s\n",
+		nMaxInstanceNum, tEngine.m_InstanceVec.size(), nMaxProjectileNum, static_cast<size_t>(tEngine.m_tProjectiles.GetCapacity()), nDropNum, bReallocated ? "yes" : "no");
+	tReport << szLine;
+
+	const std::array<long long, 5>& tEffectNum = tWorld.GetEffectNum();
+	sprintf_s(szLine, "hit %lld  effect %lld (damage %lld heal %lld knockback %lld slow %lld stun %lld)  op %lld\n",
+		nHitNum, nEffectNum, tEffectNum[0], tEffectNum[1], tEffectNum[2], tEffectNum[3], tEffectNum[4], nOpNum);
+	tReport << szLine;
+	sprintf_s(szLine, "cast %.3f ms/frame  update %.3f ms/frame  max %.3f ms/frame  %.0f ns/cast  %.1f ns/op\n",
+		dCastMs / ce_nFrameNum, dUpdateMs / ce_nFrameNum, dMaxFrameMs,
+		dCastMs * 1e6 / (std::max)(nCastNum + nRejectNum, 1LL), dUpdateMs * 1e6 / (std::max)(nOpNum, 1LL));
+	tReport << szLine;
+
+	return (nCastNum == 0 || bReallocated) ? 1 : 0;
+}
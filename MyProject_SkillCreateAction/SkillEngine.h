@@ -0,0 +1,375 @@
+/**************************************************//*
+	@file	| SkillEngine.h
+	@brief	| スキル実行クラスのhファイル
+	@note	| コンパイル済みのスキルを使用者毎のクールタイムとコストで管理し、
+			| 発動したスキルを命令列のインタプリタで毎フレーム進める
+			| スキルの実行中の状態と弾は初期化時に確保したプールから取り出し、
+			| 発動の度にメモリを確保しない
+			| 対象の検索と効果の適用はISkillWorldを通して行い、ゲームオブジェクトには触れない
+			| シングルトンパターンで作成
+*//**************************************************/
+#pragma once
+#include "Singleton.h"
+#include "SkillProgram.h"
+#include "ProjectileSystem.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// @brief スキルの番号
+using SkillId = uint32_t;
+
+// @brief 使用者の番号
+using SkillCasterId = uint32_t;
+
+// @brief 平面上の座標、向き
+struct SkillVector
+{
+	// X成分
+	float m_fX;
+
+	// Z成分
+	float m_fZ;
+};
+
+// @brief スキルの対象
+struct SkillTarget
+{
+	// 対象の番号(ゲーム側で決める)
+	uint32_t m_nId;
+
+	// 位置
+	SkillVector m_tPos;
+};
+
+// @brief 対象に与える効果
+struct SkillEffectEvent
+{
+	// 使用者の対象の番号
+	uint32_t m_nSource;
+
+	// 効果を受ける対象の番号
+	uint32_t m_nTarget;
+
+	// 効果の種類
+	SkillEffectType m_eType;
+
+	// 値
+	float m_fValue;
+
+	// 効果時間
+	float m_fDuration;
+
+	// 発生位置から対象への向き(吹き飛ばしに使う)
+	SkillVector m_tDirection;
+};
+
+// @brief 発動の結果
+enum class SkillCastResult
+{
+	// 発動した
+	Success,
+
+	// クールタイム中
+	Cooldown,
+
+	// コスト不足
+	Resource,
+
+	// 実行中のスキルが多すぎる
+	PoolFull,
+
+	// 番号が無効
+	Invalid,
+};
+
+// @brief スキル実行クラスの統計情報(直前の更新1回分)
+struct SkillEngineStats
+{
+	// 発動した数
+	int m_nCastNum;
+
+	// 発動できなかった数
+	int m_nRejectNum;
+
+	// 実行中のスキルの数
+	int m_nInstanceNum;
+
+	// 飛んでいる弾の数
+	int m_nProjectileNum;
+
+	// 弾が当たった数
+	int m_nHitNum;
+
+	// 与えた効果の数
+	int m_nEffectNum;
+
+	// プールが足りず撃てなかった弾の数
+	int m_nDropNum;
+
+	// 実行した命令の数
+	int m_nOpNum;
+
+	// 更新にかかった時間(ミリ秒)
+	double m_dUpdateMs;
+};
+
+// @brief スキルが対象を探し、効果を与える先のインターフェース
+class ISkillWorld
+{
+public:
+	// @brief デストラクタ
+	virtual ~ISkillWorld() {}
+
+	// @brief 円の中にいる対象を集める
+	// @param inCenter：中心
+	// @param inRadius：半径
+	// @param outTargets：対象を書き込む配列
+	// @param inMaxNum：書き込める最大数
+	// @return 書き込んだ数
+	virtual uint32_t QueryCircle(const SkillVector& inCenter, float inRadius, SkillTarget* outTargets, uint32_t inMaxNum) = 0;
+
+	// @brief 効果を与える
+	// @param inEvent：効果
+	virtual void ApplyEffect(const SkillEffectEvent& inEvent) = 0;
+
+	// @brief 弾が当たる箱を登録する
+	// @param outSystem：登録先
+	// @note スキルは平面(XZ)で扱い、弾の高さは0で飛ぶ
+	//       箱の番号は対象の番号、CSkillEngine::ce_nInvalidIdは効果を受けない壁
+	virtual void SubmitColliders(CProjectileSystem& outSystem) = 0;
+};
+
+// @brief スキル実行クラス
+class CSkillEngine : public ISingleton<CSkillEngine>
+{
+public:
+	// @brief 無効な番号
+	static constexpr uint32_t ce_nInvalidId = UINT32_MAX;
+
+	// @brief 1回の対象検索で集める最大数
+	static constexpr uint32_t ce_nMaxTarget = 32;
+
+	// @brief 実行中のスキルの数の初期値
+	static constexpr uint32_t ce_nDefaultInstanceNum = 1024;
+
+	// @brief 弾の数の初期値
+	static constexpr uint32_t ce_nDefaultProjectileNum = 2048;
+
+	// @brief 1回の実行で進める命令の上限(終わらなければ次の更新で続きから実行する)
+	static constexpr uint32_t ce_nOpBudget = 256;
+
+	// @brief 形状で絞り込む前に集める最大数
+	static constexpr uint32_t ce_nMaxQuery = 256;
+
+private:
+	// @brief コンストラクタ
+	CSkillEngine();
+
+	friend class ISingleton<CSkillEngine>;
+public:
+	// @brief デストラクタ
+	~CSkillEngine();
+
+	// @brief プールの確保
+	// @param inInstanceNum：同時に実行できるスキルの数
+	// @param inProjectileNum：同時に飛ばせる弾の数
+	// @note 実行中のスキルと弾は破棄される
+	void Init(uint32_t inInstanceNum = ce_nDefaultInstanceNum, uint32_t inProjectileNum = ce_nDefaultProjectileNum);
+
+	// @brief コンパイル済みのスキルを登録する
+	// @param inProgram：コンパイル済みのスキル
+	// @return スキルの番号
+	SkillId AddSkill(SkillProgram&& inProgram);
+
+	// @brief フォルダ内のスキルの定義(.json)を名前順に全て読み込む
+	// @param inDirectory：フォルダのパス
+	// @param outErrors：読み込めなかったファイルと理由
+	// @return 読み込んだ数
+	int LoadSkillDirectory(const char* inDirectory, std::vector<std::string>& outErrors);
+
+	// @brief 名前からスキルを探す
+	// @param inName：名前
+	// @return スキルの番号(無ければce_nInvalidId)
+	SkillId FindSkill(const std::string& inName) const;
+
+	// @brief スキルの数の取得
+	uint32_t GetSkillNum() const { return static_cast<uint32_t>(m_SkillVec.size()); }
+
+	// @brief スキルの取得
+	// @param inSkill：スキルの番号
+	const SkillProgram& GetSkill(SkillId inSkill) const { return m_SkillVec[inSkill]; }
+
+	// @brief 使用者を作成する
+	// @param inSource：使用者自身の対象の番号(自分の弾や範囲に当たらないようにする)
+	// @param inResourceMax：コストの上限
+	// @param inRegen：1秒あたりのコストの回復量
+	// @return 使用者の番号
+	SkillCasterId CreateCaster(uint32_t inSource, float inResourceMax, float inRegen);
+
+	// @brief 使用者を破棄する
+	// @param inCaster：使用者の番号
+	// @note 発動済みのスキルと弾は最後まで実行する
+	void DestroyCaster(SkillCasterId inCaster);
+
+	// @brief 残りのコストの取得
+	// @param inCaster：使用者の番号
+	float GetResource(SkillCasterId inCaster) const;
+
+	// @brief 残りのクールタイムの取得
+	// @param inCaster：使用者の番号
+	// @param inSkill：スキルの番号
+	float GetCooldown(SkillCasterId inCaster, SkillId inSkill) const;
+
+	// @brief スキルを発動する
+	// @param inCaster：使用者の番号
+	// @param inSkill：スキルの番号
+	// @param inOrigin：発動位置
+	// @param inDirection：向き(正規化しなくてよい)
+	// @return 発動の結果
+	// @note 命令は次の更新から実行する
+	SkillCastResult Cast(SkillCasterId inCaster, SkillId inSkill, const SkillVector& inOrigin, const SkillVector& inDirection);
+
+	// @brief 更新
+	// @param inDeltaTime：経過時間(秒)
+	// @param inWorld：対象を探し、効果を与える先
+	void Update(float inDeltaTime, ISkillWorld& inWorld);
+
+	// @brief 弾の取得
+	// @return 飛んでいる弾
+	const CProjectileSystem& GetProjectiles() const { return m_tProjectiles; }
+
+	// @brief 統計情報の取得
+	// @return 直前の更新の統計情報
+	const SkillEngineStats& GetStats() const { return m_tStats; }
+
+	// @brief 大量のスキルを発動し続けて計測して書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int StressTest(const char* inReportPath);
+
+private:
+	// @brief 使用者1人分の情報
+	struct Caster
+	{
+		// 使用者自身の対象の番号
+		uint32_t m_nSource;
+
+		// 残りのコスト
+		float m_fResource;
+
+		// コストの上限
+		float m_fResourceMax;
+
+		// 1秒あたりのコストの回復量
+		float m_fRegen;
+
+		// 使用中かどうか
+		bool m_bActive;
+
+		// スキル毎の残りのクールタイム
+		std::vector<float> m_CooldownVec;
+	};
+
+	// @brief 実行中のスキル1つ分の情報
+	struct Instance
+	{
+		// スキルの番号
+		SkillId m_nSkill;
+
+		// 使用者自身の対象の番号
+		uint32_t m_nSource;
+
+		// 次に実行する命令位置
+		uint32_t m_nPc;
+
+		// 残りの待ち時間
+		float m_fWait;
+
+		// 発生位置
+		SkillVector m_tOrigin;
+
+		// 向き(正規化済み)
+		SkillVector m_tDirection;
+
+		// 弾が当たった対象
+		SkillTarget m_tHit;
+
+		// 繰り返しの深さ
+		uint32_t m_nLoopDepth;
+
+		// 繰り返しの残り回数
+		uint32_t m_nLoopCount[CSkillCompiler::ce_nMaxLoopDepth];
+
+		// 集めた対象の数
+		uint32_t m_nTargetNum;
+
+		// 集めた対象
+		SkillTarget m_tTargets[ce_nMaxTarget];
+	};
+
+	// @brief 実行中のスキルをプールから取り出して登録する
+	// @param inSkill：スキルの番号
+	// @param inSource：使用者自身の対象の番号
+	// @param inPc：最初に実行する命令位置
+	// @param inOrigin：発生位置
+	// @param inDirection：向き(正規化済み)
+	// @return 実行中のスキル(プールが空ならnullptr)
+	Instance* SpawnInstance(SkillId inSkill, uint32_t inSource, uint32_t inPc, const SkillVector& inOrigin, const SkillVector& inDirection);
+
+	// @brief 弾を撃つ
+	// @param inInstance：撃つスキル
+	// @param inCode：弾の命令の引数
+	void SpawnProjectiles(const Instance& inInstance, const uint32_t* inCode);
+
+	// @brief 命令を待ちか終了まで実行する
+	// @param ioInstance：実行中のスキル
+	// @param inWorld：対象を探し、効果を与える先
+	// @return true:終了した false:待ち
+	bool Run(Instance& ioInstance, ISkillWorld& inWorld);
+
+	// @brief 対象を集める
+	// @param ioInstance：実行中のスキル
+	// @param inShape：形状
+	// @param inRange：距離
+	// @param inRadius：半径
+	// @param inCosHalfAngle：扇形の半角のcos
+	// @param inWorld：対象を探す先
+	void Query(Instance& ioInstance, SkillShape inShape, float inRange, float inRadius, float inCosHalfAngle, ISkillWorld& inWorld);
+
+	// @brief 弾を動かし、当たったら命中時の命令を登録する
+	// @param inDeltaTime：経過時間(秒)
+	// @param inWorld：対象を探し、効果を与える先
+	void UpdateProjectiles(float inDeltaTime, ISkillWorld& inWorld);
+
+private:
+	// @brief スキル
+	std::vector<SkillProgram> m_SkillVec;
+
+	// @brief 使用者
+	std::vector<Caster> m_CasterVec;
+
+	// @brief 空いている使用者の番号
+	std::vector<SkillCasterId> m_FreeCasterVec;
+
+	// @brief 実行中のスキルのプール
+	std::vector<Instance> m_InstanceVec;
+
+	// @brief 空いている実行中のスキルの番号
+	std::vector<uint32_t> m_FreeInstanceVec;
+
+	// @brief 実行中のスキルの番号
+	std::vector<uint32_t> m_ActiveInstanceVec;
+
+	// @brief 弾
+	CProjectileSystem m_tProjectiles;
+
+	// @brief 形状で絞り込む前の対象
+	SkillTarget m_tQueryBuffer[ce_nMaxQuery];
+
+	// @brief 集計中の統計情報
+	SkillEngineStats m_tCount;
+
+	// @brief 直前の更新の統計情報
+	SkillEngineStats m_tStats;
+};
@@ -0,0 +1,374 @@
+/**************************************************//*
+	@file	| SkillProgram.cpp
+	@brief	| スキルのバイトコードとコンパイラクラスのcppファイル
+	@note	| スキルの定義(JSON)を、発動条件・クールタイム・コストのヘッダーと
+			| CSkillEngineが解釈する32bit単位の命令列に変換する
+			| 小数の引数は命令列にビットのまま埋め込む
+*//**************************************************/
+#include "SkillProgram.h"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+	using Json = nlohmann::json;
+
+	// @brief 円周率
+	constexpr float ce_fPi = 3.14159265f;
+
+	// @brief コンパイル中の情報
+	struct CompileContext
+	{
+		// 命令列
+		std::vector<uint32_t>* m_pCode;
+
+		// 失敗した理由
+		std::string* m_pError;
+
+		// 後ろに置く命中時の命令(命令位置を書き込む場所と命令の定義)
+		std::vector<std::pair<size_t, const Json*>> m_HitVec;
+
+		// 繰り返しの深さ
+		uint32_t m_nLoopDepth;
+	};
+
+	// @brief 命令を積む
+	void PushOp(CompileContext& ioContext, SkillOp inOp)
+	{
+		ioContext.m_pCode->push_back(static_cast<uint32_t>(inOp));
+	}
+
+	// @brief 整数の引数を積む
+	void PushUint(CompileContext& ioContext, uint32_t inValue)
+	{
+		ioContext.m_pCode->push_back(inValue);
+	}
+
+	// @brief 小数の引数を積む
+	void PushFloat(CompileContext& ioContext, float inValue)
+	{
+		uint32_t nCode;
+		std::memcpy(&nCode, &inValue, sizeof(nCode));
+		ioContext.m_pCode->push_back(nCode);
+	}
+
+	// @brief 数値の項目を読む
+	// @param inObject：JSONのオブジェクト
+	// @param inKey：項目名
+	// @param inDefault：項目が無い場合の値
+	// @param outValue：読んだ値
+	// @param ioContext：コンパイル中の情報
+	// @return true:成功 false:数値ではない
+	bool ReadNumber(const Json& inObject, const char* inKey, float inDefault, float& outValue, CompileContext& ioContext)
+	{
+		auto itValue = inObject.find(inKey);
+		if (itValue == inObject.end())
+		{
+			outValue = inDefault;
+			return true;
+		}
+		if (!itValue->is_number())
+		{
+			*ioContext.m_pError = std::string("\"") + inKey + "\" must be a number";
+			return false;
+		}
+		outValue = itValue->get<float>();
+		return true;
+	}
+
+	// @brief 名前の項目を列挙型の値に変換する
+	// @param inObject：JSONのオブジェクト
+	// @param inKey：項目名
+	// @param inNames：列挙型の値の順に並べた名前
+	// @param inNameNum：名前の数
+	// @param outIndex：見つかった名前の番号
+	// @param ioContext：コンパイル中の情報
+	// @return true:成功 false:項目が無い、または知らない名前
+	bool ReadName(const Json& inObject, const char* inKey, const char* const* inNames, uint32_t inNameNum, uint32_t& outIndex, CompileContext& ioContext)
+	{
+		auto itValue = inObject.find(inKey);
+		if (itValue == inObject.end() || !itValue->is_string())
+		{
+			*ioContext.m_pError = std::string("\"") + inKey + "\" must be a string";
+			return false;
+		}
+
+		const std::string& sName = itValue->get_ref<const std::string&>();
+		for (uint32_t i = 0; i < inNameNum; i++)
+		{
+			if (sName == inNames[i])
+			{
+				outIndex = i;
+				return true;
+			}
+		}
+		*ioContext.m_pError = std::string("unknown ") + inKey + " \"" + sName + "\"";
+		return false;
+	}
+
+	// @brief 命令の並びをコンパイルする
+	// @param inSteps：命令の定義の配列
+	// @param isHit：弾の命中時の命令か
+	// @param isHasTarget：既に対象を集めているか(繰り返しの中は外側で集めた対象を使える)
+	// @param ioContext：コンパイル中の情報
+	// @return true:成功 false:失敗
+	bool CompileSteps(const Json& inSteps, bool isHit, bool isHasTarget, CompileContext& ioContext)
+	{
+		static const char* const ce_pOpNames[] = { "wait", "query", "effect", "projectile", "repeat" };
+		static const char* const ce_pShapeNames[] = { "self", "circle", "sector", "line", "hit" };
+		static const char* const ce_pEffectNames[] = { "damage", "heal", "knockback", "slow", "stun" };
+
+		if (!inSteps.is_array())
+		{
+			*ioContext.m_pError = "\"steps\" must be an array";
+			return false;
+		}
+
+		// 対象を集める前に効果を与えることはできない
+		bool bHasTarget = isHasTarget;
+		for (const Json& tStep : inSteps)
+		{
+			if (!tStep.is_object())
+			{
+				*ioContext.m_pError = "step must be an object";
+				return false;
+			}
+
+			uint32_t nOp = 0;
+			if (!ReadName(tStep, "op", ce_pOpNames, 5, nOp, ioContext)) return false;
+			switch (nOp)
+			{
+			case 0:	// wait
+			{
+				float fTime;
+				if (!ReadNumber(tStep, "time", 0.0f, fTime, ioContext)) return false;
+				PushOp(ioContext, SkillOp::Wait);
+				PushFloat(ioContext, fTime);
+				break;
+			}
+			case 1:	// query
+			{
+				uint32_t nShape = 0;
+				float fRange, fRadius, fAngle;
+				if (!ReadName(tStep, "shape", ce_pShapeNames, 5, nShape, ioContext)) return false;
+				if (!ReadNumber(tStep, "range", 0.0f, fRange, ioContext)) return false;
+				if (!ReadNumber(tStep, "radius", 1.0f, fRadius, ioContext)) return false;
+				if (!ReadNumber(tStep, "angle", 90.0f, fAngle, ioContext)) return false;
+				if (static_cast<SkillShape>(nShape) == SkillShape::Hit && !isHit)
+				{
+					*ioContext.m_pError = "shape \"hit\" is only allowed in \"onHit\"";
+					return false;
+				}
+
+				PushOp(ioContext, SkillOp::Query);
+				PushUint(ioContext, nShape);
+				PushFloat(ioContext, fRange);
+				PushFloat(ioContext, fRadius);
+				PushFloat(ioContext, cosf(fAngle * 0.5f * ce_fPi / 180.0f));
+				bHasTarget = true;
+				break;
+			}
+			case 2:	// effect
+			{
+				uint32_t nType = 0;
+				float fValue, fDuration;
+				if (!ReadName(tStep, "type", ce_pEffectNames, 5, nType, ioContext)) return false;
+				if (!ReadNumber(tStep, "value", 0.0f, fValue, ioContext)) return false;
+				if (!ReadNumber(tStep, "duration", 0.0f, fDuration, ioContext)) return false;
+				if (!bHasTarget)
+				{
+					*ioContext.m_pError = "\"effect\" needs a \"query\" before it";
+					return false;
+				}
+
+				PushOp(ioContext, SkillOp::Effect);
+				PushUint(ioContext, nType);
+				PushFloat(ioContext, fValue);
+				PushFloat(ioContext, fDuration);
+				break;
+			}
+			case 3:	// projectile
+			{
+				float fCount, fSpread, fSpeed, fLife, fRadius;
+				if (!ReadNumber(tStep, "count", 1.0f, fCount, ioContext)) return false;
+				if (!ReadNumber(tStep, "spread", 0.0f, fSpread, ioContext)) return false;
+				if (!ReadNumber(tStep, "speed", 10.0f, fSpeed, ioContext)) return false;
+				if (!ReadNumber(tStep, "life", 1.0f, fLife, ioContext)) return false;
+				if (!ReadNumber(tStep, "radius", 0.5f, fRadius, ioContext)) return false;
+				auto itHit = tStep.find("onHit");
+				if (itHit == tStep.end())
+				{
+					*ioContext.m_pError = "\"projectile\" needs \"onHit\"";
+					return false;
+				}
+
+				PushOp(ioContext, SkillOp::Projectile);
+				PushUint(ioContext, static_cast<uint32_t>((std::max)(fCount, 1.0f)));
+				PushFloat(ioContext, fSpread * ce_fPi / 180.0f);
+				PushFloat(ioContext, fSpeed);
+				PushFloat(ioContext, fLife);
+				PushFloat(ioContext, fRadius);
+
+				// 命中時の命令は本体の後ろに置くため、位置は後で書き込む
+				ioContext.m_HitVec.emplace_back(ioContext.m_pCode->size(), &*itHit);
+				PushUint(ioContext, 0);
+				break;
+			}
+			case 4:	// repeat
+			{
+				float fCount, fInterval;
+				if (!ReadNumber(tStep, "count", 1.0f, fCount, ioContext)) return false;
+				if (!ReadNumber(tStep, "interval", 0.0f, fInterval, ioContext)) return false;
+				auto itSteps = tStep.find("steps");
+				if (itSteps == tStep.end())
+				{
+					*ioContext.m_pError = "\"repeat\" needs \"steps\"";
+					return false;
+				}
+				if (ioContext.m_nLoopDepth >= CSkillCompiler::ce_nMaxLoopDepth)
+				{
+					*ioContext.m_pError = "\"repeat\" is nested too deeply";
+					return false;
+				}
+
+				PushOp(ioContext, SkillOp::Loop);
+				PushUint(ioContext, static_cast<uint32_t>((std::max)(fCount, 1.0f)));
+				uint32_t nBody = static_cast<uint32_t>(ioContext.m_pCode->size());
+
+				ioContext.m_nLoopDepth++;
+				if (!CompileSteps(*itSteps, isHit, bHasTarget, ioContext)) return false;
+				ioContext.m_nLoopDepth--;
+
+				if (fInterval > 0.0f)
+				{
+					PushOp(ioContext, SkillOp::Wait);
+					PushFloat(ioContext, fInterval);
+				}
+				PushOp(ioContext, SkillOp::Next);
+				PushUint(ioContext, nBody);
+				break;
+			}
+			}
+		}
+		return true;
+	}
+
+	// @brief "targeting"/"projectile"/"effects"を並べた書き方を"steps"の書き方に直す
+	// @param inSkill：スキルの定義
+	// @return 命令の定義の配列
+	Json ExpandShorthand(const Json& inSkill)
+	{
+		Json tEffects = Json::array();
+		auto itEffects = inSkill.find("effects");
+		if (itEffects != inSkill.end() && itEffects->is_array())
+		{
+			for (const Json& tEffect : *itEffects)
+			{
+				Json tStep = tEffect;
+				tStep["op"] = "effect";
+				tEffects.push_back(tStep);
+			}
+		}
+
+		// 弾が無い場合は使用者の位置から、ある場合は命中した位置から対象を集める
+		Json tQuery = inSkill.contains("targeting") ? inSkill["targeting"] : Json::object();
+		tQuery["op"] = "query";
+		auto itProjectile = inSkill.find("projectile");
+		if (itProjectile != inSkill.end() && !tQuery.contains("shape")) tQuery["shape"] = "hit";
+		else if (!tQuery.contains("shape")) tQuery["shape"] = "self";
+
+		Json tBody = Json::array();
+		tBody.push_back(tQuery);
+		for (const Json& tEffect : tEffects) tBody.push_back(tEffect);
+
+		Json tSteps = Json::array();
+		auto itCastTime = inSkill.find("castTime");
+		if (itCastTime != inSkill.end()) tSteps.push_back({ { "op", "wait" }, { "time", *itCastTime } });
+
+		if (itProjectile != inSkill.end())
+		{
+			Json tStep = *itProjectile;
+			tStep["op"] = "projectile";
+			tStep["onHit"] = tBody;
+			tSteps.push_back(tStep);
+		}
+		else
+		{
+			for (const Json& tStep : tBody) tSteps.push_back(tStep);
+		}
+		return tSteps;
+	}
+}
+
+/****************************************//*
+	@brief　	| JSONで書かれたスキルの定義をコンパイルする
+	@param　	| inText：JSONの文字列
+	@param　	| outProgram：コンパイル済みのスキル
+	@param　	| outError：失敗した理由
+	@return		| true:成功 false:失敗
+*//****************************************/
+bool CSkillCompiler::Compile(const std::string& inText, SkillProgram& outProgram, std::string& outError)
+{
+	// 例外は使わず、読めなかった場合は破棄された値を受け取る
+	Json tSkill = Json::parse(inText, nullptr, false);
+	if (tSkill.is_discarded() || !tSkill.is_object())
+	{
+		outError = "invalid json";
+		return false;
+	}
+
+	std::vector<uint32_t> tCode;
+	CompileContext tContext = { &tCode, &outError, {}, 0 };
+
+	static const char* const ce_pTriggerNames[] = { "press", "hold", "release" };
+	uint32_t nTrigger = 0;
+	float fCooldown, fCost;
+	if (tSkill.contains("trigger") && !ReadName(tSkill, "trigger", ce_pTriggerNames, 3, nTrigger, tContext)) return false;
+	if (!ReadNumber(tSkill, "cooldown", 0.0f, fCooldown, tContext)) return false;
+	if (!ReadNumber(tSkill, "cost", 0.0f, fCost, tContext)) return false;
+
+	auto itSteps = tSkill.find("steps");
+	Json tSteps = (itSteps != tSkill.end()) ? *itSteps : ExpandShorthand(tSkill);
+	if (!CompileSteps(tSteps, false, false, tContext)) return false;
+	PushOp(tContext, SkillOp::End);
+
+	// 命中時の命令を後ろに並べる(命中時の命令の中の弾もここで追加される)
+	for (size_t i = 0; i < tContext.m_HitVec.size(); i++)
+	{
+		tCode[tContext.m_HitVec[i].first] = static_cast<uint32_t>(tCode.size());
+		if (!CompileSteps(*tContext.m_HitVec[i].second, true, false, tContext)) return false;
+		PushOp(tContext, SkillOp::End);
+	}
+
+	auto itName = tSkill.find("name");
+	outProgram.m_sName = (itName != tSkill.end() && itName->is_string()) ? itName->get<std::string>() : std::string();
+	outProgram.m_eTrigger = static_cast<SkillTrigger>(nTrigger);
+	outProgram.m_fCooldown = (std::max)(fCooldown, 0.0f);
+	outProgram.m_fCost = (std::max)(fCost, 0.0f);
+	outProgram.m_CodeVec.swap(tCode);
+	return true;
+}
+
+/****************************************//*
+	@brief　	| ファイルを読み込んでコンパイルする
+	@param　	| inPath：ファイルのパス
+	@param　	| outProgram：コンパイル済みのスキル
+	@param　	| outError：失敗した理由
+	@return		| true:成功 false:失敗
+*//****************************************/
+bool CSkillCompiler::CompileFile(const char* inPath, SkillProgram& outProgram, std::string& outError)
+{
+	std::ifstream tFile(inPath, std::ios::binary);
+	if (!tFile)
+	{
+		outError = "cannot open file";
+		return false;
+	}
+
+	std::stringstream tText;
+	tText << tFile.rdbuf();
+	return Compile(tText.str(), outProgram, outError);
+}
@@ -0,0 +1,140 @@
+/**************************************************//*
+	@file	| SkillProgram.h
+	@brief	| スキルのバイトコードとコンパイラクラスのhファイル
+	@note	| スキルの定義(JSON)を、発動条件・クールタイム・コストのヘッダーと
+			| CSkillEngineが解釈する32bit単位の命令列に変換する
+			| 小数の引数は命令列にビットのまま埋め込む
+*//**************************************************/
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// @brief スキルの命令
+enum class SkillOp : uint32_t
+{
+	// 終了
+	End,
+
+	// 待つ [時間]
+	Wait,
+
+	// 対象を集める [形状, 距離, 半径, 半角のcos]
+	Query,
+
+	// 集めた対象に効果を与える [種類, 値, 効果時間]
+	Effect,
+
+	// 弾を撃つ [数, 広がり(ラジアン), 速さ, 寿命, 半径, 命中時の命令位置]
+	Projectile,
+
+	// 繰り返しの開始 [回数]
+	Loop,
+
+	// 繰り返しの終端 [戻る命令位置]
+	Next,
+};
+
+// @brief 対象を集める形状
+enum class SkillShape : uint32_t
+{
+	// 使用者自身
+	Self,
+
+	// 正面に距離だけ離れた点を中心とする円
+	Circle,
+
+	// 使用者を中心とする扇形
+	Sector,
+
+	// 使用者から正面に伸びる帯
+	Line,
+
+	// 弾が当たった相手(命中時の命令でのみ使う)
+	Hit,
+};
+
+// @brief 効果の種類
+enum class SkillEffectType : uint32_t
+{
+	// ダメージ
+	Damage,
+
+	// 回復
+	Heal,
+
+	// 吹き飛ばし
+	Knockback,
+
+	// 減速
+	Slow,
+
+	// 行動不能
+	Stun,
+};
+
+// @brief 発動条件
+enum class SkillTrigger
+{
+	// 押した時
+	Press,
+
+	// 押している間(クールタイム毎)
+	Hold,
+
+	// 離した時
+	Release,
+};
+
+// @brief コンパイル済みのスキル
+struct SkillProgram
+{
+	// 名前
+	std::string m_sName;
+
+	// 発動条件
+	SkillTrigger m_eTrigger;
+
+	// クールタイム(秒)
+	float m_fCooldown;
+
+	// 消費するコスト
+	float m_fCost;
+
+	// 命令列
+	std::vector<uint32_t> m_CodeVec;
+};
+
+// @brief 命令列に埋め込んだ小数を取り出す
+// @param inCode：命令列の1要素
+// @return 小数
+inline float SkillCodeToFloat(uint32_t inCode)
+{
+	float fValue;
+	std::memcpy(&fValue, &inCode, sizeof(fValue));
+	return fValue;
+}
+
+// @brief スキルのコンパイラクラス
+class CSkillCompiler
+{
+public:
+	// @brief 繰り返しを入れ子にできる深さ
+	static constexpr uint32_t ce_nMaxLoopDepth = 4;
+
+	// @brief JSONで書かれたスキルの定義をコンパイルする
+	// @param inText：JSONの文字列
+	// @param outProgram：コンパイル済みのスキル
+	// @param outError：失敗した理由
+	// @return true:成功 false:失敗
+	// @note "steps"に命令を並べる書き方と、"targeting"/"projectile"/"effects"を並べる書き方のどちらでも書ける
+	static bool Compile(const std::string& inText, SkillProgram& outProgram, std::string& outError);
+
+	// @brief ファイルを読み込んでコンパイルする
+	// @param inPath：ファイルのパス
+	// @param outProgram：コンパイル済みのスキル
+	// @param outError：失敗した理由
+	// @return true:成功 false:失敗
+	static bool CompileFile(const char* inPath, SkillProgram& outProgram, std::string& outError);
+};
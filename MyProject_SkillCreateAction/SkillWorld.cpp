@@ -0,0 +1,154 @@
+/**************************************************//*
+	@file	| SkillWorld.cpp
+	@brief	| スキルの対象世界クラスのcppファイル
+	@note	| シーン内のエンティティをスキルの対象として集め、
+			| CSkillEngineからの検索と効果をエンティティに届ける
+			| ISkillWorldを継承
+*//**************************************************/
+#include "SkillWorld.h"
+#include "Scene.h"
+#include "Entity.h"
+#include "Geometory.h"
+#include "CollisionObb.h"
+#include <cmath>
+
+// 弾を描画する線の長さ(弾の半径に対する倍率)
+constexpr float ce_fProjectileLineScale = 2.0f;
+
+// 弾が当たる箱の高さの半分(スキルは平面で扱うため、高さ0の弾が必ず通る厚みにする)
+constexpr float ce_fColliderHalfHeight = 1.0f;
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CSkillWorld::CSkillWorld()
+	: m_TargetVec{}
+	, m_EntityMap{}
+	, m_ColliderVec{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CSkillWorld::~CSkillWorld()
+{
+}
+
+/****************************************//*
+	@brief　	| シーン内のエンティティを集め直す
+	@param　	| inScene：シーン
+*//****************************************/
+void CSkillWorld::Refresh(CScene* inScene)
+{
+	m_TargetVec.clear();
+	m_EntityMap.clear();
+	m_ColliderVec.clear();
+
+	for (const auto& list : inScene->GetGameObjectList())
+	{
+		for (CGameObject* obj : list)
+		{
+			// スキルの効果を受けるのはエンティティだけ
+			CEntity* pEntity = dynamic_cast<CEntity*>(obj);
+			if (pEntity == nullptr || pEntity->IsDestroy()) continue;
+
+			DirectX::XMFLOAT3 f3Pos = pEntity->GetPos();
+			m_TargetVec.push_back({ pEntity->GetEntityId(), { f3Pos.x, f3Pos.z } });
+			m_EntityMap[pEntity->GetEntityId()] = pEntity;
+
+			DirectX::XMFLOAT3 f3Half = pEntity->GetSize();
+			f3Half.x *= 0.5f;
+			f3Half.z *= 0.5f;
+			m_ColliderVec.push_back({ { f3Pos.x - f3Half.x, -ce_fColliderHalfHeight, f3Pos.z - f3Half.z },
+				{ f3Pos.x + f3Half.x, ce_fColliderHalfHeight, f3Pos.z + f3Half.z }, pEntity->GetEntityId() });
+		}
+	}
+
+	// 動かない当たり判定は弾を止める壁にする(Y軸回転した箱を囲むAABB)
+	for (CCollisionBase* pCollision : inScene->GetCollisionVec())
+	{
+		if (!pCollision->GetActive() || !pCollision->IsStatic()) continue;
+
+		CCollisionObb* pObb = dynamic_cast<CCollisionObb*>(pCollision);
+		if (!pObb) continue;
+
+		const DirectX::XMFLOAT3 f3Center = pObb->GetCenter();
+		const DirectX::XMFLOAT3 f3Size = pObb->GetSize();
+		const float fYaw = pObb->GetGameObject()->GetRotate().y;
+		const float fExtentX = (fabsf(cosf(fYaw)) * f3Size.x + fabsf(sinf(fYaw)) * f3Size.z) * 0.5f;
+		const float fExtentZ = (fabsf(sinf(fYaw)) * f3Size.x + fabsf(cosf(fYaw)) * f3Size.z) * 0.5f;
+		m_ColliderVec.push_back({ { f3Center.x - fExtentX, -ce_fColliderHalfHeight, f3Center.z - fExtentZ },
+			{ f3Center.x + fExtentX, ce_fColliderHalfHeight, f3Center.z + fExtentZ }, CSkillEngine::ce_nInvalidId });
+	}
+}
+
+/****************************************//*
+	@brief　	| 円の中にいる対象を集める
+	@param　	| inCenter：中心
+	@param　	| inRadius：半径
+	@param　	| outTargets：対象を書き込む配列
+	@param　	| inMaxNum：書き込める最大数
+	@return		| 書き込んだ数
+*//****************************************/
+uint32_t CSkillWorld::QueryCircle(const SkillVector& inCenter, float inRadius, SkillTarget* outTargets, uint32_t inMaxNum)
+{
+	// シーン内のエンティティは少ないため全て調べる
+	float fRadiusSq = inRadius * inRadius;
+	uint32_t nNum = 0;
+	for (const SkillTarget& tTarget : m_TargetVec)
+	{
+		float fDx = tTarget.m_tPos.m_fX - inCenter.m_fX;
+		float fDz = tTarget.m_tPos.m_fZ - inCenter.m_fZ;
+		if (fDx * fDx + fDz * fDz > fRadiusSq) continue;
+
+		outTargets[nNum++] = tTarget;
+		if (nNum == inMaxNum) break;
+	}
+	return nNum;
+}
+
+/****************************************//*
+	@brief　	| 効果をエンティティに届ける
+	@param　	| inEvent：効果
+*//****************************************/
+void CSkillWorld::ApplyEffect(const SkillEffectEvent& inEvent)
+{
+	auto itEntity = m_EntityMap.find(inEvent.m_nTarget);
+	if (itEntity == m_EntityMap.end()) return;
+
+	itEntity->second->OnSkillEffect(inEvent);
+}
+
+/****************************************//*
+	@brief　	| エンティティと動かない当たり判定を弾が当たる箱として登録する
+	@param　	| outSystem：登録先
+*//****************************************/
+void CSkillWorld::SubmitColliders(CProjectileSystem& outSystem)
+{
+	for (const ProjectileCollider& tCollider : m_ColliderVec) outSystem.AddCollider(tCollider);
+}
+
+/****************************************//*
+	@brief　	| 飛んでいる弾の描画
+	@param　	| inHeight：描画する高さ
+*//****************************************/
+void CSkillWorld::Draw(float inHeight)
+{
+	const CProjectileSystem& tProjectiles = CSkillEngine::GetInstance()->GetProjectiles();
+	const float* pPosX = tProjectiles.GetPosX();
+	const float* pPosZ = tProjectiles.GetPosZ();
+	const float* pVelX = tProjectiles.GetVelocityX();
+	const float* pVelZ = tProjectiles.GetVelocityZ();
+	const float* pRadius = tProjectiles.GetRadius();
+
+	// 弾を進む向きの線で描画(描画はフレームの最後にまとめて行う)
+	for (uint32_t i = 0; i < tProjectiles.GetNum(); i++)
+	{
+		float fSpeed = sqrtf(pVelX[i] * pVelX[i] + pVelZ[i] * pVelZ[i]);
+		float fLength = (fSpeed > 0.0f) ? pRadius[i] * ce_fProjectileLineScale / fSpeed : 0.0f;
+		DirectX::XMFLOAT3 f3From = { pPosX[i], inHeight, pPosZ[i] };
+		DirectX::XMFLOAT3 f3To = { f3From.x + pVelX[i] * fLength, inHeight, f3From.z + pVelZ[i] * fLength };
+		Geometory::AddLine(f3From, f3To, DirectX::XMFLOAT4(1.0f, 0.5f, 0.0f, 1.0f));
+	}
+}
@@ -0,0 +1,61 @@
+/**************************************************//*
+	@file	| SkillWorld.h
+	@brief	| スキルの対象世界クラスのhファイル
+	@note	| シーン内のエンティティをスキルの対象として集め、
+			| CSkillEngineからの検索と効果をエンティティに届ける
+			| ISkillWorldを継承
+*//**************************************************/
+#pragma once
+#include "SkillEngine.h"
+#include <unordered_map>
+#include <vector>
+
+// @brief 前方宣言
+class CScene;
+class CEntity;
+
+// @brief スキルの対象世界クラス
+class CSkillWorld : public ISkillWorld
+{
+public:
+	// @brief コンストラクタ
+	CSkillWorld();
+
+	// @brief デストラクタ
+	~CSkillWorld();
+
+	// @brief シーン内のエンティティを集め直す
+	// @param inScene：シーン
+	// @note シーンの更新の後、CSkillEngineの更新の前に呼ぶ
+	void Refresh(CScene* inScene);
+
+	// @brief 円の中にいる対象を集める
+	// @param inCenter：中心
+	// @param inRadius：半径
+	// @param outTargets：対象を書き込む配列
+	// @param inMaxNum：書き込める最大数
+	// @return 書き込んだ数
+	uint32_t QueryCircle(const SkillVector& inCenter, float inRadius, SkillTarget* outTargets, uint32_t inMaxNum) override;
+
+	// @brief 効果をエンティティに届ける
+	// @param inEvent：効果
+	void ApplyEffect(const SkillEffectEvent& inEvent) override;
+
+	// @brief エンティティと動かない当たり判定を弾が当たる箱として登録する
+	// @param outSystem：登録先
+	void SubmitColliders(CProjectileSystem& outSystem) override;
+
+	// @brief 飛んでいる弾の描画
+	// @param inHeight：描画する高さ
+	void Draw(float inHeight);
+
+private:
+	// @brief 対象
+	std::vector<SkillTarget> m_TargetVec;
+
+	// @brief 対象の番号とエンティティ
+	std::unordered_map<uint32_t, CEntity*> m_EntityMap;
+
+	// @brief 弾が当たる箱(エンティティと壁)
+	std::vector<ProjectileCollider> m_ColliderVec;
+};
@@ -0,0 +1,1211 @@
+/**************************************************//*
+	@file	| SpatialQuery.cpp
+	@brief	| 空間検索クラスのcppファイル
+	@note	| 当たり判定の箱(OBB)を包むAABBを動的AABBツリーに登録し、
+			| レイキャスト、球の掃引、球・箱との重なり、近い順のk件の検索、重なる組の列挙を行う
+			| 箱は登録したまま動かし、ツリーは広げた範囲から出た箱だけを入れ直す
+			| 箱は識別用タグ毎のビットで絞り込み、結果は呼び出し側の配列に書き込む
+			| 重なる組は当たり判定のレイヤーとマスクで、詳細な判定の前に絞り込む
+			| 検索中にメモリを確保しない
+			| 検索は統計を集計するため、複数のスレッドから同時に呼ばない
+*//**************************************************/
+#include "SpatialQuery.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+namespace
+{
+	// @brief 辿る時のスタックの大きさ
+	constexpr int ce_nStackSize = CDynamicAabbTree::ce_nStackSize;
+
+	// @brief 掃引で当たったとみなす距離
+	constexpr float ce_fContactEpsilon = 1e-4f;
+
+	// @brief 掃引で距離を詰める最大の回数
+	constexpr int ce_nMaxSweepStep = 16;
+
+	// @brief 向きや距離が無いとみなす値
+	constexpr float ce_fEpsilon = 1e-8f;
+
+	// @brief 向きが無い軸の逆数の代わりに使う値
+	constexpr float ce_fLargeInverse = 1e30f;
+
+	// @brief 内積
+	float Dot(const float* inA, const float* inB)
+	{
+		return inA[0] * inB[0] + inA[1] * inB[1] + inA[2] * inB[2];
+	}
+
+	// @brief 点とAABBの距離の2乗
+	float DistanceSqAabb(const float* inPoint, const float* inMin, const float* inMax)
+	{
+		float fDistSq = 0.0f;
+		for (int i = 0; i < 3; i++)
+		{
+			float fOver = (std::max)((std::max)(inMin[i] - inPoint[i], inPoint[i] - inMax[i]), 0.0f);
+			fDistSq += fOver * fOver;
+		}
+		return fDistSq;
+	}
+
+	// @brief 線分と半径だけ広げたAABBのスラブ判定
+	// @param inOrigin：始点(XYZ)
+	// @param inInverse：向きの逆数(XYZ)
+	// @param inMin：最小(XYZ)
+	// @param inMax：最大(XYZ)
+	// @param inRadius：広げる半径
+	// @param inMaxT：最大の距離
+	// @param outEnter：入る距離
+	// @return true:当たった false:当たらない
+	bool CastAabb(const float* inOrigin, const float* inInverse, const float* inMin, const float* inMax, float inRadius, float inMaxT, float& outEnter)
+	{
+		float fEnter = 0.0f;
+		float fExit = inMaxT;
+		for (int i = 0; i < 3; i++)
+		{
+			float fT0 = (inMin[i] - inRadius - inOrigin[i]) * inInverse[i];
+			float fT1 = (inMax[i] + inRadius - inOrigin[i]) * inInverse[i];
+			if (fT0 > fT1) std::swap(fT0, fT1);
+			fEnter = (std::max)(fEnter, fT0);
+			fExit = (std::min)(fExit, fT1);
+		}
+		outEnter = fEnter;
+		return fEnter <= fExit;
+	}
+
+	// @brief 点を箱のローカル座標に直す
+	void ToLocal(const SpatialBox& inBox, const float* inPoint, float* outLocal)
+	{
+		float fOffset[3] = { inPoint[0] - inBox.m_fCenter[0], inPoint[1] - inBox.m_fCenter[1], inPoint[2] - inBox.m_fCenter[2] };
+		for (int i = 0; i < 3; i++) outLocal[i] = Dot(fOffset, inBox.m_fAxis[i]);
+	}
+
+	// @brief 箱の上で点に一番近い位置を求める
+	// @param inBox：箱
+	// @param inPoint：点(XYZ)
+	// @param outPos：一番近い位置(XYZ)
+	// @return 距離の2乗(点が箱の中なら0)
+	float ClosestPoint(const SpatialBox& inBox, const float* inPoint, float* outPos)
+	{
+		float fLocal[3];
+		ToLocal(inBox, inPoint, fLocal);
+
+		float fDistSq = 0.0f;
+		for (int k = 0; k < 3; k++) outPos[k] = inBox.m_fCenter[k];
+		for (int i = 0; i < 3; i++)
+		{
+			float fClamp = (std::min)((std::max)(fLocal[i], -inBox.m_fHalfSize[i]), inBox.m_fHalfSize[i]);
+			float fOver = fLocal[i] - fClamp;
+			fDistSq += fOver * fOver;
+			for (int k = 0; k < 3; k++) outPos[k] += inBox.m_fAxis[i][k] * fClamp;
+		}
+		return fDistSq;
+	}
+
+	// @brief ローカル座標の線分と箱のスラブ判定
+	// @param inLocalOrigin：始点(ローカル座標)
+	// @param inLocalDirection：向き(ローカル座標)
+	// @param inHalfSize：大きさの半分
+	// @param inMaxT：最大の距離
+	// @param outEnter：入る距離(始点が中なら0)
+	// @param outExit：出る距離
+	// @param outAxis：入った面の軸(始点が中なら-1)
+	// @return true:当たった false:当たらない
+	bool LocalSlab(const float* inLocalOrigin, const float* inLocalDirection, const float* inHalfSize, float inMaxT,
+		float& outEnter, float& outExit, int& outAxis)
+	{
+		float fEnter = 0.0f;
+		float fExit = inMaxT;
+		outAxis = -1;
+		for (int i = 0; i < 3; i++)
+		{
+			if (fabsf(inLocalDirection[i]) < ce_fEpsilon)
+			{
+				// この軸に進まない場合は始点が範囲内かどうかだけ
+				if (fabsf(inLocalOrigin[i]) > inHalfSize[i]) return false;
+				continue;
+			}
+
+			float fInv = 1.0f / inLocalDirection[i];
+			float fT0 = (-inHalfSize[i] - inLocalOrigin[i]) * fInv;
+			float fT1 = (inHalfSize[i] - inLocalOrigin[i]) * fInv;
+			if (fT0 > fT1) std::swap(fT0, fT1);
+			if (fT0 > fEnter)
+			{
+				fEnter = fT0;
+				outAxis = i;
+			}
+			fExit = (std::min)(fExit, fT1);
+			if (fEnter > fExit) return false;
+		}
+		outEnter = fEnter;
+		outExit = fExit;
+		return true;
+	}
+
+	// @brief レイと箱の判定
+	// @param inBox：箱
+	// @param inOrigin：始点(XYZ)
+	// @param inDirection：向き(XYZ、正規化済み)
+	// @param inMaxT：最大の距離
+	// @param outT：当たった距離
+	// @param outNormal：当たった面の法線(XYZ)
+	// @return true:当たった false:当たらない
+	bool RayBox(const SpatialBox& inBox, const float* inOrigin, const float* inDirection, float inMaxT, float& outT, float* outNormal)
+	{
+		float fLocalOrigin[3], fLocalDirection[3];
+		ToLocal(inBox, inOrigin, fLocalOrigin);
+		for (int i = 0; i < 3; i++) fLocalDirection[i] = Dot(inDirection, inBox.m_fAxis[i]);
+
+		float fEnter, fExit;
+		int nAxis;
+		if (!LocalSlab(fLocalOrigin, fLocalDirection, inBox.m_fHalfSize, inMaxT, fEnter, fExit, nAxis)) return false;
+
+		outT = fEnter;
+		if (nAxis < 0)
+		{
+			for (int k = 0; k < 3; k++) outNormal[k] = -inDirection[k];
+		}
+		else
+		{
+			// 入った面は進む向きと逆を向いている
+			float fSign = (fLocalDirection[nAxis] > 0.0f) ? -1.0f : 1.0f;
+			for (int k = 0; k < 3; k++) outNormal[k] = inBox.m_fAxis[nAxis][k] * fSign;
+		}
+		return true;
+	}
+
+	// @brief 球の掃引と箱の判定
+	// @param inBox：箱
+	// @param inOrigin：球の中心の始点(XYZ)
+	// @param inDirection：向き(XYZ、正規化済み)
+	// @param inRadius：球の半径
+	// @param inMaxT：最大の距離
+	// @param outT：当たった距離
+	// @param outPos：箱の上の当たった位置(XYZ)
+	// @param outNormal：当たった面の法線(XYZ)
+	// @return true:当たった false:当たらない
+	// @note 半径だけ広げた箱に入る距離から、箱との距離が半径になるまで距離を詰める
+	//       (角の丸みも正しく扱える、広げた箱に入らなければ詰めずに外れる)
+	bool SweepBox(const SpatialBox& inBox, const float* inOrigin, const float* inDirection, float inRadius, float inMaxT,
+		float& outT, float* outPos, float* outNormal)
+	{
+		float fLocalOrigin[3], fLocalDirection[3], fHalfSize[3];
+		ToLocal(inBox, inOrigin, fLocalOrigin);
+		for (int i = 0; i < 3; i++)
+		{
+			fLocalDirection[i] = Dot(inDirection, inBox.m_fAxis[i]);
+			fHalfSize[i] = inBox.m_fHalfSize[i] + inRadius;
+		}
+
+		float fEnter, fExit;
+		int nAxis;
+		if (!LocalSlab(fLocalOrigin, fLocalDirection, fHalfSize, inMaxT, fEnter, fExit, nAxis)) return false;
+
+		// 箱との距離は進む距離に対して下に凸のため、接線が半径に届く距離まで進めても通り過ぎない(ニュートン法)
+		// (遠くの座標でも誤差が出ないよう、箱のローカル座標で詰める)
+		float fT = fEnter;
+		for (int nStep = 0; nStep < ce_nMaxSweepStep; nStep++)
+		{
+			float fOver[3], fDistSq = 0.0f;
+			for (int i = 0; i < 3; i++)
+			{
+				float fLocal = fLocalOrigin[i] + fLocalDirection[i] * fT;
+				float fClamp = (std::min)((std::max)(fLocal, -inBox.m_fHalfSize[i]), inBox.m_fHalfSize[i]);
+				fOver[i] = fLocal - fClamp;
+				fDistSq += fOver[i] * fOver[i];
+			}
+			float fDistance = sqrtf(fDistSq);
+			if (fDistance <= inRadius + ce_fContactEpsilon)
+			{
+				outT = fT;
+				for (int k = 0; k < 3; k++)
+				{
+					outPos[k] = inOrigin[k] + inDirection[k] * fT;
+					outNormal[k] = -inDirection[k];
+				}
+				if (fT > 0.0f && fDistance >= ce_fContactEpsilon)
+				{
+					// 球の中心から法線の逆向きに箱までの距離だけ戻した位置が箱の上の当たった位置
+					for (int k = 0; k < 3; k++)
+					{
+						outNormal[k] = (inBox.m_fAxis[0][k] * fOver[0] + inBox.m_fAxis[1][k] * fOver[1] + inBox.m_fAxis[2][k] * fOver[2]) / fDistance;
+						outPos[k] -= outNormal[k] * fDistance;
+					}
+				}
+				return true;
+			}
+
+			// 遠ざかり始めていれば、これ以上近づかない
+			float fSlope = (fLocalDirection[0] * fOver[0] + fLocalDirection[1] * fOver[1] + fLocalDirection[2] * fOver[2]) / fDistance;
+			if (fSlope > -ce_fEpsilon) return false;
+
+			fT += (fDistance - inRadius) / -fSlope;
+			if (fT > fExit) return false;
+		}
+		return false;
+	}
+
+	// @brief 箱と箱の分離軸判定
+	// @param inA：箱
+	// @param inB：箱
+	// @return true:重なっている false:重なっていない
+	bool OverlapObb(const SpatialBox& inA, const SpatialBox& inB)
+	{
+		// Bの軸をAの軸で表した回転と、その絶対値(平行な辺の外積が0になる分を少し足す)
+		float fR[3][3], fAbsR[3][3];
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				fR[i][j] = Dot(inA.m_fAxis[i], inB.m_fAxis[j]);
+				fAbsR[i][j] = fabsf(fR[i][j]) + 1e-6f;
+			}
+		}
+
+		float fOffset[3] = { inB.m_fCenter[0] - inA.m_fCenter[0], inB.m_fCenter[1] - inA.m_fCenter[1], inB.m_fCenter[2] - inA.m_fCenter[2] };
+		float fT[3] = { Dot(fOffset, inA.m_fAxis[0]), Dot(fOffset, inA.m_fAxis[1]), Dot(fOffset, inA.m_fAxis[2]) };
+		const float* pA = inA.m_fHalfSize;
+		const float* pB = inB.m_fHalfSize;
+
+		// Aの軸
+		for (int i = 0; i < 3; i++)
+		{
+			float fRB = pB[0] * fAbsR[i][0] + pB[1] * fAbsR[i][1] + pB[2] * fAbsR[i][2];
+			if (fabsf(fT[i]) > pA[i] + fRB) return false;
+		}
+
+		// Bの軸
+		for (int j = 0; j < 3; j++)
+		{
+			float fRA = pA[0] * fAbsR[0][j] + pA[1] * fAbsR[1][j] + pA[2] * fAbsR[2][j];
+			float fD = fT[0] * fR[0][j] + fT[1] * fR[1][j] + fT[2] * fR[2][j];
+			if (fabsf(fD) > fRA + pB[j]) return false;
+		}
+
+		// 辺同士の外積
+		for (int i = 0; i < 3; i++)
+		{
+			int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+			for (int j = 0; j < 3; j++)
+			{
+				int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+				float fRA = pA[i1] * fAbsR[i2][j] + pA[i2] * fAbsR[i1][j];
+				float fRB = pB[j1] * fAbsR[i][j2] + pB[j2] * fAbsR[i][j1];
+				float fD = fT[i2] * fR[i1][j] - fT[i1] * fR[i2][j];
+				if (fabsf(fD) > fRA + fRB) return false;
+			}
+		}
+		return true;
+	}
+
+	// @brief 箱を包むAABBを求める
+	void BoxBounds(const SpatialBox& inBox, float* outMin, float* outMax)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			float fExtent = fabsf(inBox.m_fAxis[0][k]) * inBox.m_fHalfSize[0]
+				+ fabsf(inBox.m_fAxis[1][k]) * inBox.m_fHalfSize[1]
+				+ fabsf(inBox.m_fAxis[2][k]) * inBox.m_fHalfSize[2];
+			outMin[k] = inBox.m_fCenter[k] - fExtent;
+			outMax[k] = inBox.m_fCenter[k] + fExtent;
+		}
+	}
+
+	// @brief Y軸回転の後にローカルX軸回りに傾けた箱を作る
+	SpatialBox MakeBox(float inX, float inY, float inZ, float inHalfX, float inHalfY, float inHalfZ, float inYaw, float inPitch)
+	{
+		float fCosY = cosf(inYaw), fSinY = sinf(inYaw), fCosP = cosf(inPitch), fSinP = sinf(inPitch);
+		SpatialBox tBox = { { inX, inY, inZ }, { inHalfX, inHalfY, inHalfZ },
+			{ { fCosY, 0.0f, -fSinY }, { fSinY * fSinP, fCosP, fCosY * fSinP }, { fSinY * fCosP, -fSinP, fCosY * fCosP } } };
+		return tBox;
+	}
+
+	// @brief 近い順の検索で、結果の配列を遠いものが先頭のヒープとして扱う比較
+	bool CompareDistance(const SpatialHit& inA, const SpatialHit& inB)
+	{
+		return inA.m_fDistance < inB.m_fDistance;
+	}
+}
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CSpatialQuery::CSpatialQuery()
+	: m_BoxVec{}
+	, m_FreeVec{}
+	, m_tTree{}
+	, m_TagVec{}
+	, m_tCount{}
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CSpatialQuery::~CSpatialQuery()
+{
+}
+
+/****************************************//*
+	@brief　	| 識別用タグのビットの取得
+	@param　	| inTag：識別用タグ
+	@return		| タグのビット
+*//****************************************/
+uint32_t CSpatialQuery::GetTagMask(const std::string& inTag)
+{
+	for (uint32_t i = 0; i < m_TagVec.size(); i++)
+	{
+		if (m_TagVec[i] == inTag) return 1u << i;
+	}
+
+	// 区別できる数を超えたタグは最後のビットを共有する
+	if (m_TagVec.size() == ce_nMaxTag) return 1u << (ce_nMaxTag - 1);
+
+	m_TagVec.push_back(inTag);
+	return 1u << (m_TagVec.size() - 1);
+}
+
+/****************************************//*
+	@brief　	| 登録した箱を全て外す
+*//****************************************/
+void CSpatialQuery::Clear()
+{
+	m_BoxVec.clear();
+	m_FreeVec.clear();
+	m_tTree.Clear();
+}
+
+/****************************************//*
+	@brief　	| 箱を登録する
+	@param　	| inBox：箱
+	@param　	| inTagMask：タグのビット
+	@param　	| inCollision：検索結果で返す当たり判定
+	@param　	| isStatic：true:動かない false:動く
+	@return		| 登録時の番号
+*//****************************************/
+uint32_t CSpatialQuery::Add(const SpatialBox& inBox, uint32_t inTagMask, CCollisionBase* inCollision, bool isStatic)
+{
+	uint32_t nIndex;
+	if (m_FreeVec.empty())
+	{
+		nIndex = static_cast<uint32_t>(m_BoxVec.size());
+		m_BoxVec.push_back({});
+	}
+	else
+	{
+		nIndex = m_FreeVec.back();
+		m_FreeVec.pop_back();
+	}
+
+	Item& tItem = m_BoxVec[nIndex];
+	tItem.m_tBox = inBox;
+	BoxBounds(inBox, tItem.m_fMin, tItem.m_fMax);
+	tItem.m_nTagMask = inTagMask;
+	tItem.m_nLayerBit = UINT32_MAX;
+	tItem.m_nMask = UINT32_MAX;
+	tItem.m_nProxy = m_tTree.CreateProxy(tItem.m_fMin, tItem.m_fMax, nIndex);
+	tItem.m_bStatic = isStatic;
+	tItem.m_pCollision = inCollision;
+	return nIndex;
+}
+
+/****************************************//*
+	@brief　	| 登録した箱を動かす
+	@param　	| inIndex：登録時の番号
+	@param　	| inBox：動いた後の箱
+	@param　	| inSweep：掃引する移動量(XYZ、nullptrなら動いた後の箱だけ)
+	@note		| 中心の移動量をツリーに渡し、動いている向きに範囲を広げておく
+*//****************************************/
+void CSpatialQuery::Move(uint32_t inIndex, const SpatialBox& inBox, const float* inSweep)
+{
+	Item& tItem = m_BoxVec[inIndex];
+	float fDisplacement[3];
+	for (int k = 0; k < 3; k++) fDisplacement[k] = inBox.m_fCenter[k] - tItem.m_tBox.m_fCenter[k];
+
+	tItem.m_tBox = inBox;
+	BoxBounds(inBox, tItem.m_fMin, tItem.m_fMax);
+	if (inSweep)
+	{
+		// 動く前の位置の箱も包む
+		for (int k = 0; k < 3; k++)
+		{
+			tItem.m_fMin[k] -= (std::max)(inSweep[k], 0.0f);
+			tItem.m_fMax[k] -= (std::min)(inSweep[k], 0.0f);
+		}
+	}
+	m_tTree.MoveProxy(tItem.m_nProxy, tItem.m_fMin, tItem.m_fMax, fDisplacement);
+}
+
+/****************************************//*
+	@brief　	| 登録した箱を外す
+	@param　	| inIndex：登録時の番号
+*//****************************************/
+void CSpatialQuery::Remove(uint32_t inIndex)
+{
+	Item& tItem = m_BoxVec[inIndex];
+	m_tTree.DestroyProxy(tItem.m_nProxy);
+	tItem.m_nProxy = CDynamicAabbTree::ce_nNull;
+	tItem.m_pCollision = nullptr;
+	m_FreeVec.push_back(inIndex);
+}
+
+/****************************************//*
+	@brief　	| 重なる組を集める時に使うレイヤーとマスクを設定
+	@param　	| inIndex：登録時の番号
+	@param　	| inLayerBit：自分のレイヤーのビット
+	@param　	| inMask：組にする相手のレイヤーのビット
+*//****************************************/
+void CSpatialQuery::SetFilter(uint32_t inIndex, uint32_t inLayerBit, uint32_t inMask)
+{
+	Item& tItem = m_BoxVec[inIndex];
+	tItem.m_nLayerBit = inLayerBit;
+	tItem.m_nMask = inMask;
+	m_tTree.SetProxyLayer(tItem.m_nProxy, inLayerBit);
+}
+
+/****************************************//*
+	@brief　	| 更新
+*//****************************************/
+void CSpatialQuery::Update()
+{
+	auto tStart = std::chrono::high_resolution_clock::now();
+	m_tTree.Update();
+
+	// 前回の更新からの検索の集計を確定する
+	m_tStats = m_tCount;
+	m_tStats.m_nBoxNum = static_cast<int>(m_tTree.GetProxyNum());
+	m_tStats.m_nNodeNum = (std::max)(static_cast<int>(m_tTree.GetProxyNum()) * 2 - 1, 0);
+	m_tStats.m_dUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+	m_tCount = {};
+}
+
+/****************************************//*
+	@brief　	| レイに一番最初に当たる箱を探す
+	@param　	| inOrigin：始点(XYZ)
+	@param　	| inDirection：向き(XYZ、正規化済み)
+	@param　	| inMaxDistance：最大の距離
+	@param　	| inTagMask：対象のタグのビット
+	@param　	| outHit：当たった箱
+	@return		| true:当たった false:当たらない
+*//****************************************/
+bool CSpatialQuery::Raycast(const float* inOrigin, const float* inDirection, float inMaxDistance, uint32_t inTagMask, SpatialHit& outHit) const
+{
+	return Cast(inOrigin, inDirection, 0.0f, inMaxDistance, inTagMask, outHit);
+}
+
+/****************************************//*
+	@brief　	| 球を動かして一番最初に当たる箱を探す
+	@param　	| inOrigin：球の中心の始点(XYZ)
+	@param　	| inDirection：向き(XYZ、正規化済み)
+	@param　	| inRadius：球の半径
+	@param　	| inMaxDistance：最大の距離
+	@param　	| inTagMask：対象のタグのビット
+	@param　	| outHit：当たった箱
+	@return		| true:当たった false:当たらない
+*//****************************************/
+bool CSpatialQuery::SphereCast(const float* inOrigin, const float* inDirection, float inRadius, float inMaxDistance, uint32_t inTagMask, SpatialHit& outHit) const
+{
+	return Cast(inOrigin, inDirection, (std::max)(inRadius, 0.0f), inMaxDistance, inTagMask, outHit);
+}
+
+/****************************************//*
+	@brief　	| 線分を球の半径だけ広げたツリーで辿り、一番最初に当たる箱を探す
+	@param　	| inOrigin：始点(XYZ)
+	@param　	| inDirection：向き(XYZ、正規化済み)
+	@param　	| inRadius：球の半径(0ならレイ)
+	@param　	| inMaxDistance：最大の距離
+	@param　	| inTagMask：対象のタグのビット
+	@param　	| outHit：当たった箱
+	@return		| true:当たった false:当たらない
+	@note		| 近い方の子から辿り、見つかった距離より遠いノードは調べない
+*//****************************************/
+bool CSpatialQuery::Cast(const float* inOrigin, const float* inDirection, float inRadius, float inMaxDistance, uint32_t inTagMask, SpatialHit& outHit) const
+{
+	m_tCount.m_nQueryNum++;
+	const uint32_t nRoot = m_tTree.GetRoot();
+	if (nRoot == CDynamicAabbTree::ce_nNull) return false;
+
+	float fInverse[3];
+	for (int k = 0; k < 3; k++)
+	{
+		fInverse[k] = (fabsf(inDirection[k]) < ce_fEpsilon) ? (inDirection[k] < 0.0f ? -ce_fLargeInverse : ce_fLargeInverse) : 1.0f / inDirection[k];
+	}
+
+	float fBest = inMaxDistance;
+	bool bHit = false;
+	float fEnter;
+	const AabbTreeNode& tRoot = m_tTree.GetNode(nRoot);
+	if (!CastAabb(inOrigin, fInverse, tRoot.m_fMin, tRoot.m_fMax, inRadius, fBest, fEnter)) return false;
+
+	uint32_t nStack[ce_nStackSize];
+	float fStackEnter[ce_nStackSize];
+	int nTop = 0;
+	nStack[nTop] = nRoot;
+	fStackEnter[nTop++] = fEnter;
+	while (nTop > 0)
+	{
+		nTop--;
+		if (fStackEnter[nTop] > fBest) continue;
+		const AabbTreeNode& tNode = m_tTree.GetNode(nStack[nTop]);
+		m_tCount.m_nNodeVisitNum++;
+
+		if (tNode.IsLeaf())
+		{
+			const Item& tItem = m_BoxVec[tNode.m_nUserData];
+			if (!(tItem.m_nTagMask & inTagMask)) continue;
+
+			m_tCount.m_nTestNum++;
+			float fT, fPos[3], fNormal[3];
+			if (inRadius > 0.0f)
+			{
+				if (!SweepBox(tItem.m_tBox, inOrigin, inDirection, inRadius, fBest, fT, fPos, fNormal)) continue;
+			}
+			else
+			{
+				if (!RayBox(tItem.m_tBox, inOrigin, inDirection, fBest, fT, fNormal)) continue;
+				for (int k = 0; k < 3; k++) fPos[k] = inOrigin[k] + inDirection[k] * fT;
+			}
+			if (fT > fBest || (bHit && fT == fBest && tNode.m_nUserData > outHit.m_nIndex)) continue;
+
+			fBest = fT;
+			outHit = MakeHit(tNode.m_nUserData, fT, fPos, fNormal);
+			bHit = true;
+			continue;
+		}
+
+		// 遠い方の子を先に積み、近い方から調べる
+		float fEnterL, fEnterR;
+		const uint32_t nLeft = tNode.m_nChild[0];
+		const uint32_t nRight = tNode.m_nChild[1];
+		const AabbTreeNode& tLeft = m_tTree.GetNode(nLeft);
+		const AabbTreeNode& tRight = m_tTree.GetNode(nRight);
+		bool bLeft = CastAabb(inOrigin, fInverse, tLeft.m_fMin, tLeft.m_fMax, inRadius, fBest, fEnterL);
+		bool bRight = CastAabb(inOrigin, fInverse, tRight.m_fMin, tRight.m_fMax, inRadius, fBest, fEnterR);
+		if (bLeft && bRight && fEnterL < fEnterR)
+		{
+			nStack[nTop] = nRight;
+			fStackEnter[nTop++] = fEnterR;
+			nStack[nTop] = nLeft;
+			fStackEnter[nTop++] = fEnterL;
+			continue;
+		}
+		if (bLeft)
+		{
+			nStack[nTop] = nLeft;
+			fStackEnter[nTop++] = fEnterL;
+		}
+		if (bRight)
+		{
+			nStack[nTop] = nRight;
+			fStackEnter[nTop++] = fEnterR;
+		}
+	}
+	return bHit;
+}
+
+/****************************************//*
+	@brief　	| 球と重なる箱を集める
+	@param　	| inCenter：中心(XYZ)
+	@param　	| inRadius：半径
+	@param　	| inTagMask：対象のタグのビット
+	@param　	| outHits：結果を書き込む配列
+	@param　	| inMaxNum：書き込める最大数
+	@return		| 書き込んだ数
+*//****************************************/
+uint32_t CSpatialQuery::OverlapSphere(const float* inCenter, float inRadius, uint32_t inTagMask, SpatialHit* outHits, uint32_t inMaxNum) const
+{
+	m_tCount.m_nQueryNum++;
+	if (m_tTree.GetRoot() == CDynamicAabbTree::ce_nNull || inMaxNum == 0) return 0;
+
+	const float fRadiusSq = inRadius * inRadius;
+	uint32_t nNum = 0;
+	uint32_t nStack[ce_nStackSize];
+	int nTop = 0;
+	nStack[nTop++] = m_tTree.GetRoot();
+	while (nTop > 0)
+	{
+		const AabbTreeNode& tNode = m_tTree.GetNode(nStack[--nTop]);
+		m_tCount.m_nNodeVisitNum++;
+		if (DistanceSqAabb(inCenter, tNode.m_fMin, tNode.m_fMax) > fRadiusSq) continue;
+
+		if (!tNode.IsLeaf())
+		{
+			nStack[nTop++] = tNode.m_nChild[0];
+			nStack[nTop++] = tNode.m_nChild[1];
+			continue;
+		}
+
+		const Item& tItem = m_BoxVec[tNode.m_nUserData];
+		if (!(tItem.m_nTagMask & inTagMask)) continue;
+
+		m_tCount.m_nTestNum++;
+		float fPos[3];
+		float fDistSq = ClosestPoint(tItem.m_tBox, inCenter, fPos);
+		if (fDistSq > fRadiusSq) continue;
+
+		outHits[nNum++] = MakeHit(tNode.m_nUserData, sqrtf(fDistSq), fPos, nullptr);
+		if (nNum == inMaxNum) return nNum;
+	}
+	return nNum;
+}
+
+/****************************************//*
+	@brief　	| 箱と重なる箱を集める
+	@param　	| inBox：箱
+	@param　	| inTagMask：対象のタグのビット
+	@param　	| outHits：結果を書き込む配列
+	@param　	| inMaxNum：書き込める最大数
+	@return		| 書き込んだ数
+*//****************************************/
+uint32_t CSpatialQuery::OverlapBox(const SpatialBox& inBox, uint32_t inTagMask, SpatialHit* outHits, uint32_t inMaxNum) const
+{
+	m_tCount.m_nQueryNum++;
+	if (m_tTree.GetRoot() == CDynamicAabbTree::ce_nNull || inMaxNum == 0) return 0;
+
+	// 検索する箱を包むAABBで辿り、箱同士は分離軸で調べる
+	float fMin[3], fMax[3];
+	BoxBounds(inBox, fMin, fMax);
+
+	uint32_t nNum = 0;
+	uint32_t nStack[ce_nStackSize];
+	int nTop = 0;
+	nStack[nTop++] = m_tTree.GetRoot();
+	while (nTop > 0)
+	{
+		const AabbTreeNode& tNode = m_tTree.GetNode(nStack[--nTop]);
+		m_tCount.m_nNodeVisitNum++;
+		if (tNode.m_fMin[0] > fMax[0] || tNode.m_fMax[0] < fMin[0] ||
+			tNode.m_fMin[1] > fMax[1] || tNode.m_fMax[1] < fMin[1] ||
+			tNode.m_fMin[2] > fMax[2] || tNode.m_fMax[2] < fMin[2]) continue;
+
+		if (!tNode.IsLeaf())
+		{
+			nStack[nTop++] = tNode.m_nChild[0];
+			nStack[nTop++] = tNode.m_nChild[1];
+			continue;
+		}
+
+		// 葉の範囲は広げてあるため、実際の箱を包むAABBでも確かめる
+		const Item& tItem = m_BoxVec[tNode.m_nUserData];
+		if (!(tItem.m_nTagMask & inTagMask)) continue;
+		if (tItem.m_fMin[0] > fMax[0] || tItem.m_fMax[0] < fMin[0] ||
+			tItem.m_fMin[1] > fMax[1] || tItem.m_fMax[1] < fMin[1] ||
+			tItem.m_fMin[2] > fMax[2] || tItem.m_fMax[2] < fMin[2]) continue;
+
+		m_tCount.m_nTestNum++;
+		if (!OverlapObb(inBox, tItem.m_tBox)) continue;
+
+		float fPos[3];
+		float fDistSq = ClosestPoint(tItem.m_tBox, inBox.m_fCenter, fPos);
+		outHits[nNum++] = MakeHit(tNode.m_nUserData, sqrtf(fDistSq), fPos, nullptr);
+		if (nNum == inMaxNum) return nNum;
+	}
+	return nNum;
+}
+
+/****************************************//*
+	@brief　	| 点に近い順に箱を集める
+	@param　	| inPoint：点(XYZ)
+	@param　	| inMaxDistance：最大の距離
+	@param　	| inTagMask：対象のタグのビット
+	@param　	| outHits：結果を書き込む配列
+	@param　	| inMaxNum：集める数
+	@return		| 書き込んだ数
+	@note		| 結果の配列を遠いものが先頭のヒープとして使い、
+				| 集まった後は一番遠いものより遠いノードを調べない
+*//****************************************/
+uint32_t CSpatialQuery::Nearest(const float* inPoint, float inMaxDistance, uint32_t inTagMask, SpatialHit* outHits, uint32_t inMaxNum) const
+{
+	m_tCount.m_nQueryNum++;
+	const uint32_t nRoot = m_tTree.GetRoot();
+	if (nRoot == CDynamicAabbTree::ce_nNull || inMaxNum == 0) return 0;
+
+	float fBoundSq = inMaxDistance * inMaxDistance;
+	uint32_t nNum = 0;
+	uint32_t nStack[ce_nStackSize];
+	float fStackDistSq[ce_nStackSize];
+	int nTop = 0;
+	nStack[nTop] = nRoot;
+	fStackDistSq[nTop++] = DistanceSqAabb(inPoint, m_tTree.GetNode(nRoot).m_fMin, m_tTree.GetNode(nRoot).m_fMax);
+	while (nTop > 0)
+	{
+		nTop--;
+		if (fStackDistSq[nTop] > fBoundSq) continue;
+		const AabbTreeNode& tNode = m_tTree.GetNode(nStack[nTop]);
+		m_tCount.m_nNodeVisitNum++;
+
+		if (tNode.IsLeaf())
+		{
+			const Item& tItem = m_BoxVec[tNode.m_nUserData];
+			if (!(tItem.m_nTagMask & inTagMask)) continue;
+
+			m_tCount.m_nTestNum++;
+			float fPos[3];
+			float fDistSq = ClosestPoint(tItem.m_tBox, inPoint, fPos);
+			if (fDistSq > fBoundSq) continue;
+
+			SpatialHit tHit = MakeHit(tNode.m_nUserData, sqrtf(fDistSq), fPos, nullptr);
+			if (nNum < inMaxNum)
+			{
+				outHits[nNum++] = tHit;
+				std::push_heap(outHits, outHits + nNum, CompareDistance);
+			}
+			else
+			{
+				std::pop_heap(outHits, outHits + nNum, CompareDistance);
+				outHits[nNum - 1] = tHit;
+				std::push_heap(outHits, outHits + nNum, CompareDistance);
+			}
+
+			// 集まった後は一番遠いものより近いものだけを探す
+			if (nNum == inMaxNum) fBoundSq = outHits[0].m_fDistance * outHits[0].m_fDistance;
+			continue;
+		}
+
+		// 遠い方の子を先に積み、近い方から調べる
+		uint32_t nNear = tNode.m_nChild[0], nFar = tNode.m_nChild[1];
+		float fNearSq = DistanceSqAabb(inPoint, m_tTree.GetNode(nNear).m_fMin, m_tTree.GetNode(nNear).m_fMax);
+		float fFarSq = DistanceSqAabb(inPoint, m_tTree.GetNode(nFar).m_fMin, m_tTree.GetNode(nFar).m_fMax);
+		if (fFarSq < fNearSq)
+		{
+			std::swap(nNear, nFar);
+			std::swap(fNearSq, fFarSq);
+		}
+		if (fFarSq <= fBoundSq)
+		{
+			nStack[nTop] = nFar;
+			fStackDistSq[nTop++] = fFarSq;
+		}
+		if (fNearSq <= fBoundSq)
+		{
+			nStack[nTop] = nNear;
+			fStackDistSq[nTop++] = fNearSq;
+		}
+	}
+
+	std::sort_heap(outHits, outHits + nNum, CompareDistance);
+	return nNum;
+}
+
+/****************************************//*
+	@brief　	| AABBが重なる箱の組を集める
+	@param　	| outPairs：結果を書き込む配列
+	@note		| 動く箱同士の組は番号が小さい方からの検索だけで集め、
+				| 動く箱と動かない箱の組は動く箱からの検索で集める
+*//****************************************/
+void CSpatialQuery::FindPairs(std::vector<SpatialPair>& outPairs) const
+{
+	outPairs.clear();
+	for (uint32_t i = 0; i < m_BoxVec.size(); i++)
+	{
+		const Item& tItem = m_BoxVec[i];
+		if (tItem.m_nProxy == CDynamicAabbTree::ce_nNull || tItem.m_bStatic) continue;
+
+		m_tCount.m_nQueryNum++;
+		// 自分のマスクに含まれないレイヤーだけの枝はツリーを辿る時に除く
+		m_tTree.QueryAabb(tItem.m_fMin, tItem.m_fMax, tItem.m_nMask, [&](uint32_t inProxy)
+			{
+				const uint32_t nOther = m_tTree.GetUserData(inProxy);
+				const Item& tOther = m_BoxVec[nOther];
+				m_tCount.m_nNodeVisitNum++;
+				if (nOther == i || (!tOther.m_bStatic && nOther < i)) return true;
+
+				// 相手が自分のレイヤーを対象にしていない組は、箱を比べる前に除く
+				if (!(tItem.m_nLayerBit & tOther.m_nMask))
+				{
+					m_tCount.m_nFilterNum++;
+					return true;
+				}
+
+				// 葉の範囲は広げてあるため、実際の箱を包むAABB同士で確かめる
+				m_tCount.m_nTestNum++;
+				if (tItem.m_fMin[0] > tOther.m_fMax[0] || tItem.m_fMax[0] < tOther.m_fMin[0] ||
+					tItem.m_fMin[1] > tOther.m_fMax[1] || tItem.m_fMax[1] < tOther.m_fMin[1] ||
+					tItem.m_fMin[2] > tOther.m_fMax[2] || tItem.m_fMax[2] < tOther.m_fMin[2]) return true;
+
+				if (nOther < i) outPairs.push_back({ nOther, i, tOther.m_pCollision, tItem.m_pCollision });
+				else outPairs.push_back({ i, nOther, tItem.m_pCollision, tOther.m_pCollision });
+				return true;
+			});
+	}
+
+	// ツリーの形に左右されない順にする
+	std::sort(outPairs.begin(), outPairs.end(), [](const SpatialPair& inA, const SpatialPair& inB)
+		{
+			return (inA.m_nIndexA != inB.m_nIndexA) ? inA.m_nIndexA < inB.m_nIndexA : inA.m_nIndexB < inB.m_nIndexB;
+		});
+	m_tCount.m_nPairNum += static_cast<int>(outPairs.size());
+}
+
+/****************************************//*
+	@brief　	| 箱と検索結果を作る
+	@param　	| inIndex：登録時の番号
+	@param　	| inDistance：距離
+	@param　	| inPos：位置
+	@param　	| inNormal：法線(nullptrなら0)
+	@return		| 検索結果
+*//****************************************/
+SpatialHit CSpatialQuery::MakeHit(uint32_t inIndex, float inDistance, const float* inPos, const float* inNormal) const
+{
+	SpatialHit tHit;
+	tHit.m_pCollision = m_BoxVec[inIndex].m_pCollision;
+	tHit.m_nIndex = inIndex;
+	tHit.m_fDistance = inDistance;
+	for (int k = 0; k < 3; k++)
+	{
+		tHit.m_fPos[k] = inPos[k];
+		tHit.m_fNormal[k] = inNormal ? inNormal[k] : 0.0f;
+	}
+	return tHit;
+}
+
+/****************************************//*
+	@brief　	| 大量の箱で検索の結果を総当たりと比べ、検索の速さを計測して書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+*//****************************************/
+int CSpatialQuery::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr uint32_t ce_nBoxNum = 20000;
+	static constexpr uint32_t ce_nQueryNum = 20000;
+	static constexpr uint32_t ce_nBruteNum = 500;
+	static constexpr uint32_t ce_nMaxResult = 256;
+	static constexpr uint32_t ce_nNearestNum = 8;
+	static constexpr int ce_nFrameNum = 120;
+	static constexpr float ce_fMoveSpeed = 6.0f / 60.0f;
+	static constexpr float ce_fMapSize = 1024.0f;
+	static constexpr float ce_fCastDistance = 64.0f;
+	static constexpr float ce_fTolerance = 1e-3f;
+	char szLine[256];
+	bool bSuccess = true;
+	SpatialHit tHit;
+	SpatialHit tHits[ce_nMaxResult];
+
+	// 決まった配置で結果を確かめる
+	{
+		CSpatialQuery tQuery;
+		const uint32_t nWall = tQuery.GetTagMask("Wall");
+		const uint32_t nEnemy = tQuery.GetTagMask("Enemy");
+		const float fOrigin[3] = { 0.0f, 0.0f, 0.0f };
+		const float fRight[3] = { 1.0f, 0.0f, 0.0f };
+		const float fForward[3] = { 0.0f, 0.0f, 1.0f };
+		const float fAbove[3] = { 0.0f, 1.3f, 0.0f };
+
+		// +Xの壁、+Zの45度回した敵、-Xの敵
+		tQuery.Add(MakeBox(10.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f), nWall, nullptr, true);
+		tQuery.Add(MakeBox(0.0f, 0.0f, 10.0f, 1.0f, 1.0f, 1.0f, 0.78539816f, 0.0f), nEnemy, nullptr, false);
+		tQuery.Add(MakeBox(-10.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f), nEnemy, nullptr, false);
+		tQuery.Update();
+
+		bool bCheck = true;
+		// 壁の面に当たり、法線は手前を向く
+		bCheck &= tQuery.Raycast(fOrigin, fRight, 100.0f, ce_nAllTag, tHit) && tHit.m_nIndex == 0
+			&& fabsf(tHit.m_fDistance - 9.0f) < ce_fTolerance && fabsf(tHit.m_fNormal[0] + 1.0f) < ce_fTolerance;
+		// タグで壁を除くと当たらない、距離が足りなければ当たらない
+		bCheck &= !tQuery.Raycast(fOrigin, fRight, 100.0f, nEnemy, tHit);
+		bCheck &= !tQuery.Raycast(fOrigin, fRight, 8.9f, ce_nAllTag, tHit);
+		// 回した箱は角が手前に来る
+		bCheck &= tQuery.Raycast(fOrigin, fForward, 100.0f, ce_nAllTag, tHit) && tHit.m_nIndex == 1
+			&& fabsf(tHit.m_fDistance - (10.0f - 1.41421356f)) < ce_fTolerance;
+		// 球の掃引は面なら半径の手前、上の辺をかすめる時は角の丸みの分だけ奥で当たる
+		bCheck &= tQuery.SphereCast(fOrigin, fRight, 0.5f, 100.0f, ce_nAllTag, tHit) && fabsf(tHit.m_fDistance - 8.5f) < ce_fTolerance;
+		bCheck &= tQuery.SphereCast(fAbove, fRight, 0.5f, 100.0f, ce_nAllTag, tHit) && fabsf(tHit.m_fDistance - 8.6f) < ce_fTolerance
+			&& fabsf(tHit.m_fPos[0] - 9.0f) < ce_fTolerance && fabsf(tHit.m_fPos[1] - 1.0f) < ce_fTolerance;
+		// 球の重なりは箱の表面までの距離で決まる
+		bCheck &= tQuery.OverlapSphere(fOrigin, 8.5f, ce_nAllTag, tHits, ce_nMaxResult) == 0;
+		bCheck &= tQuery.OverlapSphere(fOrigin, 8.7f, ce_nAllTag, tHits, ce_nMaxResult) == 1 && tHits[0].m_nIndex == 1;
+		bCheck &= tQuery.OverlapSphere(fOrigin, 9.05f, ce_nAllTag, tHits, ce_nMaxResult) == 3;
+		bCheck &= tQuery.OverlapSphere(fOrigin, 9.05f, nWall, tHits, ce_nMaxResult) == 1 && tHits[0].m_nIndex == 0;
+		// 回した箱を包むAABBには入るが、箱には重ならない
+		bCheck &= tQuery.OverlapBox(MakeBox(1.2f, 0.0f, 8.6f, 0.3f, 0.3f, 0.3f, 0.0f, 0.0f), ce_nAllTag, tHits, ce_nMaxResult) == 0;
+		bCheck &= tQuery.OverlapBox(MakeBox(0.0f, 0.0f, 8.4f, 0.5f, 0.5f, 0.5f, 0.0f, 0.0f), ce_nAllTag, tHits, ce_nMaxResult) == 1;
+		// 近い順
+		bCheck &= tQuery.Nearest(fOrigin, 100.0f, ce_nAllTag, tHits, 2) == 2 && tHits[0].m_nIndex == 1 && fabsf(tHits[1].m_fDistance - 9.0f) < ce_fTolerance;
+		bCheck &= tQuery.Nearest(fOrigin, 100.0f, nEnemy, tHits, 3) == 2 && tHits[0].m_nIndex == 1 && tHits[1].m_nIndex == 2;
+		bCheck &= tQuery.Nearest(fOrigin, 8.0f, ce_nAllTag, tHits, 3) == 0;
+
+		sprintf_s(szLine, "fixed cases (ray/sphere cast/overlap/nearest, tag filter, rounded edge)  %s\n", bCheck ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bCheck;
+	}
+
+	// 大きなマップに向きと傾きがばらばらの箱を置く(4種類のタグ、壁は動かない)
+	std::mt19937 tRandom(20261019);
+	std::uniform_real_distribution<float> tPos(0.0f, ce_fMapSize);
+	std::uniform_real_distribution<float> tHeight(0.0f, 8.0f);
+	std::uniform_real_distribution<float> tHalf(0.5f, 3.0f);
+	std::uniform_real_distribution<float> tAngle(0.0f, 6.2831853f);
+	std::uniform_real_distribution<float> tTilt(-0.5f, 0.5f);
+	std::uniform_real_distribution<float> tUnit(0.0f, 1.0f);
+
+	CSpatialQuery tQuery;
+	uint32_t nTagMask[4] = { tQuery.GetTagMask("Wall"), tQuery.GetTagMask("Enemy"), tQuery.GetTagMask("Player"), tQuery.GetTagMask("Item") };
+	std::vector<SpatialBox> tBoxVec(ce_nBoxNum);
+	std::vector<float> tHeadingVec(ce_nBoxNum);
+	for (uint32_t i = 0; i < ce_nBoxNum; i++)
+	{
+		float fPitch = (tUnit(tRandom) < 0.25f) ? tTilt(tRandom) : 0.0f;
+		tBoxVec[i] = MakeBox(tPos(tRandom), tHeight(tRandom), tPos(tRandom), tHalf(tRandom), tHalf(tRandom), tHalf(tRandom), tAngle(tRandom), fPitch);
+		tHeadingVec[i] = tAngle(tRandom);
+	}
+
+	auto tStart = std::chrono::high_resolution_clock::now();
+	for (uint32_t i = 0; i < ce_nBoxNum; i++) tQuery.Add(tBoxVec[i], nTagMask[i % 4], nullptr, i % 4 == 0);
+	double dAddMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+	tQuery.Update();
+	sprintf_s(szLine, "box %u  node %d  add all %.3f ms\n", ce_nBoxNum, tQuery.m_tStats.m_nNodeNum, dAddMs);
+	tReport << szLine;
+
+	// 壁以外の箱を動かしながら更新する(以降の検索は動かした後の配置で確かめる)
+	{
+		double dMoveMs = 0.0;
+		int nReinsertNum = 0, nRebuildNum = 0;
+		for (int nFrame = 0; nFrame < ce_nFrameNum; nFrame++)
+		{
+			tStart = std::chrono::high_resolution_clock::now();
+			for (uint32_t i = 0; i < ce_nBoxNum; i++)
+			{
+				if (i % 4 == 0) continue;
+				tBoxVec[i].m_fCenter[0] += cosf(tHeadingVec[i]) * ce_fMoveSpeed;
+				tBoxVec[i].m_fCenter[2] += sinf(tHeadingVec[i]) * ce_fMoveSpeed;
+				tQuery.Move(i, tBoxVec[i]);
+			}
+			tQuery.Update();
+			dMoveMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+			nReinsertNum += tQuery.GetTreeStats().m_nReinsertNum;
+			nRebuildNum += tQuery.GetTreeStats().m_nRebuildNum;
+		}
+		sprintf_s(szLine, "move %u boxes  %.3f ms/frame  reinsert %.1f/frame  rebuild %d  height %d  area ratio %.1f\n",
+			ce_nBoxNum - ce_nBoxNum / 4, dMoveMs / ce_nFrameNum, static_cast<double>(nReinsertNum) / ce_nFrameNum, nRebuildNum,
+			tQuery.GetTreeStats().m_nHeight, tQuery.GetTreeStats().m_fAreaRatio);
+		tReport << szLine;
+	}
+
+	// 重なる組を総当たりと比べる
+	{
+		std::vector<SpatialPair> tPairVec;
+		tStart = std::chrono::high_resolution_clock::now();
+		tQuery.FindPairs(tPairVec);
+		double dPairMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		std::vector<SpatialPair> tBruteVec;
+		tStart = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < ce_nBoxNum; i++)
+		{
+			const Item& tA = tQuery.m_BoxVec[i];
+			for (uint32_t j = i + 1; j < ce_nBoxNum; j++)
+			{
+				const Item& tB = tQuery.m_BoxVec[j];
+				if (tA.m_bStatic && tB.m_bStatic) continue;
+				if (tA.m_fMin[0] > tB.m_fMax[0] || tA.m_fMax[0] < tB.m_fMin[0] ||
+					tA.m_fMin[1] > tB.m_fMax[1] || tA.m_fMax[1] < tB.m_fMin[1] ||
+					tA.m_fMin[2] > tB.m_fMax[2] || tA.m_fMax[2] < tB.m_fMin[2]) continue;
+				tBruteVec.push_back({ i, j, nullptr, nullptr });
+			}
+		}
+		double dBruteMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		bool bCheck = tPairVec.size() == tBruteVec.size() && std::equal(tPairVec.begin(), tPairVec.end(), tBruteVec.begin(),
+			[](const SpatialPair& inA, const SpatialPair& inB) { return inA.m_nIndexA == inB.m_nIndexA && inA.m_nIndexB == inB.m_nIndexB; });
+		sprintf_s(szLine, "pairs %zu  find %.3f ms  brute %.1f ms (x%.0f)  %s\n",
+			tPairVec.size(), dPairMs, dBruteMs, dBruteMs / dPairMs, bCheck ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bCheck;
+	}
+
+	// 検索の条件は計測の外で先に作る(半分は全てのタグ、半分は1種類のタグ)
+	struct Request
+	{
+		float m_fPos[3];
+		float m_fDirection[3];
+		float m_fRadius;
+		uint32_t m_nTagMask;
+		SpatialBox m_tBox;
+	};
+	std::vector<Request> tRequestVec(ce_nQueryNum);
+	for (uint32_t i = 0; i < ce_nQueryNum; i++)
+	{
+		Request& tRequest = tRequestVec[i];
+		float fYaw = tAngle(tRandom), fSlope = tTilt(tRandom) * 0.2f;
+		tRequest.m_fPos[0] = tPos(tRandom);
+		tRequest.m_fPos[1] = tHeight(tRandom);
+		tRequest.m_fPos[2] = tPos(tRandom);
+		float fLength = sqrtf(1.0f + fSlope * fSlope);
+		tRequest.m_fDirection[0] = cosf(fYaw) / fLength;
+		tRequest.m_fDirection[1] = fSlope / fLength;
+		tRequest.m_fDirection[2] = sinf(fYaw) / fLength;
+		tRequest.m_fRadius = 4.0f + tUnit(tRandom) * 12.0f;
+		tRequest.m_nTagMask = (i % 2) ? nTagMask[i % 4] : ce_nAllTag;
+		tRequest.m_tBox = MakeBox(tRequest.m_fPos[0], tRequest.m_fPos[1], tRequest.m_fPos[2],
+			2.0f + tUnit(tRandom) * 6.0f, 1.0f + tUnit(tRandom) * 2.0f, 2.0f + tUnit(tRandom) * 6.0f, fYaw, 0.0f);
+	}
+
+	// 総当たりの検索(BVHと同じ詳細な判定で、全ての箱を調べる)
+	auto BruteCast = [&](const Request& inRequest, float inRadius, SpatialHit& outHit)
+		{
+			float fBest = ce_fCastDistance;
+			bool bHit = false;
+			for (uint32_t i = 0; i < tQuery.m_BoxVec.size(); i++)
+			{
+				const Item& tItem = tQuery.m_BoxVec[i];
+				if (!(tItem.m_nTagMask & inRequest.m_nTagMask)) continue;
+				float fT, fPos[3], fNormal[3];
+				bool bItemHit = (inRadius > 0.0f)
+					? SweepBox(tItem.m_tBox, inRequest.m_fPos, inRequest.m_fDirection, inRadius, fBest, fT, fPos, fNormal)
+					: RayBox(tItem.m_tBox, inRequest.m_fPos, inRequest.m_fDirection, fBest, fT, fNormal);
+				if (!bItemHit || fT > fBest) continue;
+				if (inRadius <= 0.0f)
+				{
+					for (int k = 0; k < 3; k++) fPos[k] = inRequest.m_fPos[k] + inRequest.m_fDirection[k] * fT;
+				}
+				fBest = fT;
+				outHit = tQuery.MakeHit(i, fT, fPos, fNormal);
+				bHit = true;
+			}
+			return bHit;
+		};
+	auto BruteOverlap = [&](const Request& inRequest, bool isBox, uint32_t* outIndex)
+		{
+			uint32_t nNum = 0;
+			for (uint32_t i = 0; i < tQuery.m_BoxVec.size(); i++)
+			{
+				const Item& tItem = tQuery.m_BoxVec[i];
+				if (!(tItem.m_nTagMask & inRequest.m_nTagMask)) continue;
+				float fPos[3];
+				bool bOverlap = isBox ? OverlapObb(inRequest.m_tBox, tItem.m_tBox)
+					: ClosestPoint(tItem.m_tBox, inRequest.m_fPos, fPos) <= inRequest.m_fRadius * inRequest.m_fRadius;
+				if (bOverlap && nNum < ce_nMaxResult) outIndex[nNum++] = i;
+			}
+			std::sort(outIndex, outIndex + nNum);
+			return nNum;
+		};
+	auto BruteNearest = [&](const Request& inRequest, float* outDistance)
+		{
+			uint32_t nNum = 0;
+			for (const Item& tItem : tQuery.m_BoxVec)
+			{
+				if (!(tItem.m_nTagMask & inRequest.m_nTagMask)) continue;
+				float fPos[3];
+				float fDistance = sqrtf(ClosestPoint(tItem.m_tBox, inRequest.m_fPos, fPos));
+				if (fDistance > ce_fCastDistance) continue;
+				if (nNum < ce_nNearestNum) outDistance[nNum++] = fDistance;
+				else if (fDistance < outDistance[ce_nNearestNum - 1]) outDistance[ce_nNearestNum - 1] = fDistance;
+				else continue;
+				std::sort(outDistance, outDistance + nNum);
+			}
+			return nNum;
+		};
+
+	// 総当たりと結果を比べる(掃引は当たった位置で箱との距離が半径になっていることも確かめる)
+	{
+		int nMismatch[5] = {};
+		uint32_t nIndexA[ce_nMaxResult], nIndexB[ce_nMaxResult];
+		float fDistA[ce_nNearestNum], fDistB[ce_nNearestNum];
+		for (uint32_t i = 0; i < ce_nBruteNum; i++)
+		{
+			const Request& tRequest = tRequestVec[i];
+			for (int nCast = 0; nCast < 2; nCast++)
+			{
+				float fRadius = nCast ? tRequest.m_fRadius * 0.1f : 0.0f;
+				SpatialHit tBrute;
+				bool bHit = tQuery.Cast(tRequest.m_fPos, tRequest.m_fDirection, fRadius, ce_fCastDistance, tRequest.m_nTagMask, tHit);
+				bool bBrute = BruteCast(tRequest, fRadius, tBrute);
+				bool bMatch = (bHit == bBrute) && (!bHit || fabsf(tHit.m_fDistance - tBrute.m_fDistance) < ce_fTolerance);
+				if (bMatch && bHit)
+				{
+					// 当たった距離まで進めた位置で、箱との距離が半径(レイは0)になっている
+					float fCenter[3], fPos[3];
+					for (int k = 0; k < 3; k++) fCenter[k] = tRequest.m_fPos[k] + tRequest.m_fDirection[k] * tHit.m_fDistance;
+					float fDistance = sqrtf(ClosestPoint(tQuery.m_BoxVec[tHit.m_nIndex].m_tBox, fCenter, fPos));
+					bMatch = tHit.m_fDistance == 0.0f || fabsf(fDistance - fRadius) < ce_fTolerance;
+				}
+				nMismatch[nCast] += bMatch ? 0 : 1;
+			}
+
+			for (int nBox = 0; nBox < 2; nBox++)
+			{
+				uint32_t nNum = nBox ? tQuery.OverlapBox(tRequest.m_tBox, tRequest.m_nTagMask, tHits, ce_nMaxResult)
+					: tQuery.OverlapSphere(tRequest.m_fPos, tRequest.m_fRadius, tRequest.m_nTagMask, tHits, ce_nMaxResult);
+				for (uint32_t j = 0; j < nNum; j++) nIndexA[j] = tHits[j].m_nIndex;
+				std::sort(nIndexA, nIndexA + nNum);
+				uint32_t nBruteNum = BruteOverlap(tRequest, nBox != 0, nIndexB);
+				bool bMatch = nNum == nBruteNum && std::equal(nIndexA, nIndexA + nNum, nIndexB);
+				nMismatch[2 + nBox] += bMatch ? 0 : 1;
+			}
+
+			uint32_t nNum = tQuery.Nearest(tRequest.m_fPos, ce_fCastDistance, tRequest.m_nTagMask, tHits, ce_nNearestNum);
+			for (uint32_t j = 0; j < nNum; j++) fDistA[j] = tHits[j].m_fDistance;
+			uint32_t nBruteNum = BruteNearest(tRequest, fDistB);
+			bool bMatch = nNum == nBruteNum;
+			for (uint32_t j = 0; bMatch && j < nNum; j++) bMatch = fabsf(fDistA[j] - fDistB[j]) < ce_fTolerance;
+			nMismatch[4] += bMatch ? 0 : 1;
+		}
+
+		bool bCheck = nMismatch[0] == 0 && nMismatch[1] == 0 && nMismatch[2] == 0 && nMismatch[3] == 0 && nMismatch[4] == 0;
+		sprintf_s(szLine, "brute force check %u queries  mismatch ray %d sphere cast %d overlap sphere %d overlap box %d nearest %d  %s\n",
+			ce_nBruteNum, nMismatch[0], nMismatch[1], nMismatch[2], nMismatch[3], nMismatch[4], bCheck ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bCheck;
+	}
+
+	// 検索の種類毎の速さ(BVHと総当たり)
+	const char* pName[5] = { "raycast", "spherecast", "overlap sphere", "overlap box", "nearest 8" };
+	for (int nType = 0; nType < 5; nType++)
+	{
+		tQuery.m_tCount.m_nNodeVisitNum = 0;
+		tQuery.m_tCount.m_nTestNum = 0;
+		long long nResultNum = 0;
+		tStart = std::chrono::high_resolution_clock::now();
+		for (const Request& tRequest : tRequestVec)
+		{
+			switch (nType)
+			{
+			case 0: nResultNum += tQuery.Raycast(tRequest.m_fPos, tRequest.m_fDirection, ce_fCastDistance, tRequest.m_nTagMask, tHit) ? 1 : 0; break;
+			case 1: nResultNum += tQuery.SphereCast(tRequest.m_fPos, tRequest.m_fDirection, tRequest.m_fRadius * 0.1f, ce_fCastDistance, tRequest.m_nTagMask, tHit) ? 1 : 0; break;
+			case 2: nResultNum += tQuery.OverlapSphere(tRequest.m_fPos, tRequest.m_fRadius, tRequest.m_nTagMask, tHits, ce_nMaxResult); break;
+			case 3: nResultNum += tQuery.OverlapBox(tRequest.m_tBox, tRequest.m_nTagMask, tHits, ce_nMaxResult); break;
+			default: nResultNum += tQuery.Nearest(tRequest.m_fPos, ce_fCastDistance, tRequest.m_nTagMask, tHits, ce_nNearestNum); break;
+			}
+		}
+		double dMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		// 総当たりは数を減らして計測する
+		uint32_t nIndex[ce_nMaxResult];
+		float fDistance[ce_nNearestNum];
+		long long nBruteResult = 0;
+		tStart = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < ce_nBruteNum; i++)
+		{
+			const Request& tRequest = tRequestVec[i];
+			switch (nType)
+			{
+			case 0: nBruteResult += BruteCast(tRequest, 0.0f, tHit) ? 1 : 0; break;
+			case 1: nBruteResult += BruteCast(tRequest, tRequest.m_fRadius * 0.1f, tHit) ? 1 : 0; break;
+			case 2: nBruteResult += BruteOverlap(tRequest, false, nIndex); break;
+			case 3: nBruteResult += BruteOverlap(tRequest, true, nIndex); break;
+			default: nBruteResult += BruteNearest(tRequest, fDistance); break;
+			}
+		}
+		double dBruteMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		double dUs = dMs * 1e3 / ce_nQueryNum;
+		double dBruteUs = dBruteMs * 1e3 / ce_nBruteNum;
+		sprintf_s(szLine, "%-14s %.2f us/query (%.0f query/s)  node %.1f  test %.1f  result %.2f/query  brute %.1f us/query (x%.0f)\n",
+			pName[nType], dUs, 1e6 / dUs, static_cast<double>(tQuery.m_tCount.m_nNodeVisitNum) / ce_nQueryNum,
+			static_cast<double>(tQuery.m_tCount.m_nTestNum) / ce_nQueryNum, static_cast<double>(nResultNum) / ce_nQueryNum,
+			dBruteUs, dBruteUs / dUs);
+		tReport << szLine;
+	}
+
+	return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+/**************************************************//*
+	@file	| SpatialQuery.h
+	@brief	| 空間検索クラスのhファイル
+	@note	| 当たり判定の箱(OBB)を包むAABBを動的AABBツリーに登録し、
+			| レイキャスト、球の掃引、球・箱との重なり、近い順のk件の検索、重なる組の列挙を行う
+			| 箱は登録したまま動かし、ツリーは広げた範囲から出た箱だけを入れ直す
+			| 箱は識別用タグ毎のビットで絞り込み、結果は呼び出し側の配列に書き込む
+			| 重なる組は当たり判定のレイヤーとマスクで、詳細な判定の前に絞り込む
+			| 検索中にメモリを確保しない
+			| 検索は統計を集計するため、複数のスレッドから同時に呼ばない
+*//**************************************************/
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "DynamicAabbTree.h"
+
+// @brief 前方宣言
+class CCollisionBase;
+
+// @brief 検索対象の向きを持った箱
+struct SpatialBox
+{
+	// 中心(XYZ)
+	float m_fCenter[3];
+
+	// 大きさの半分(XYZ)
+	float m_fHalfSize[3];
+
+	// 箱のローカル軸(正規化済み、[軸][XYZ])
+	float m_fAxis[3][3];
+};
+
+// @brief 検索結果
+struct SpatialHit
+{
+	// 当たった当たり判定(登録時に渡したもの)
+	CCollisionBase* m_pCollision;
+
+	// 登録時の番号(Addの戻り値)
+	uint32_t m_nIndex;
+
+	// 距離(レイ・掃引:始点から当たるまで 近い順:点から箱まで 重なり:中心から箱まで)
+	float m_fDistance;
+
+	// 位置(レイ・掃引:当たった位置 近い順・重なり:箱の上で一番近い位置)
+	float m_fPos[3];
+
+	// 当たった面の法線(レイ・掃引のみ、始めから重なっている場合は進む向きの逆)
+	float m_fNormal[3];
+};
+
+// @brief AABBが重なる箱の組
+struct SpatialPair
+{
+	// 登録時の番号(小さい方)
+	uint32_t m_nIndexA;
+
+	// 登録時の番号(大きい方)
+	uint32_t m_nIndexB;
+
+	// 番号がm_nIndexAの当たり判定
+	CCollisionBase* m_pCollisionA;
+
+	// 番号がm_nIndexBの当たり判定
+	CCollisionBase* m_pCollisionB;
+};
+
+// @brief 空間検索の統計情報(直前の更新から次の更新まで)
+struct SpatialQueryStats
+{
+	// 箱の数
+	int m_nBoxNum;
+
+	// ツリーのノードの数
+	int m_nNodeNum;
+
+	// 検索の回数
+	int m_nQueryNum;
+
+	// 調べたノードの数
+	int m_nNodeVisitNum;
+
+	// 箱との詳細な判定の回数
+	int m_nTestNum;
+
+	// 重なる組の数
+	int m_nPairNum;
+
+	// 相手のマスクで除いた組の数(自分のマスクで除いた枝はツリーを辿る時に除くので含まない)
+	int m_nFilterNum;
+
+	// ツリーの更新にかかった時間(ミリ秒)
+	double m_dUpdateMs;
+};
+
+// @brief 空間検索クラス
+class CSpatialQuery
+{
+public:
+	// @brief 全てのタグ
+	static constexpr uint32_t ce_nAllTag = UINT32_MAX;
+
+	// @brief 区別できるタグの数
+	static constexpr uint32_t ce_nMaxTag = 32;
+
+	// @brief 無効な登録時の番号
+	static constexpr uint32_t ce_nInvalid = UINT32_MAX;
+
+public:
+	// @brief コンストラクタ
+	CSpatialQuery();
+
+	// @brief デストラクタ
+	~CSpatialQuery();
+
+	// @brief 識別用タグのビットの取得
+	// @param inTag：識別用タグ
+	// @return タグのビット(初めてのタグには空いているビットを割り当てる、溢れたタグは全て最後のビット)
+	uint32_t GetTagMask(const std::string& inTag);
+
+	// @brief 登録した箱を全て外す
+	// @note タグのビットの割り当てはそのまま
+	void Clear();
+
+	// @brief 箱を登録する
+	// @param inBox：箱
+	// @param inTagMask：タグのビット
+	// @param inCollision：検索結果で返す当たり判定
+	// @param isStatic：true:動かない(動かない箱同士は組にしない) false:動く
+	// @return 登録時の番号(外した箱の番号は次に登録する箱で使い回す)
+	uint32_t Add(const SpatialBox& inBox, uint32_t inTagMask, CCollisionBase* inCollision, bool isStatic);
+
+	// @brief 登録した箱を動かす
+	// @param inIndex：登録時の番号
+	// @param inBox：動いた後の箱
+	// @param inSweep：掃引する移動量(XYZ、nullptrなら動いた後の箱だけ)
+	// @note 掃引する箱はAABBを動く前の位置まで広げ、重なる組を集める時に通り過ぎた相手も候補に入れる
+	void Move(uint32_t inIndex, const SpatialBox& inBox, const float* inSweep = nullptr);
+
+	// @brief 登録した箱を外す
+	// @param inIndex：登録時の番号
+	void Remove(uint32_t inIndex);
+
+	// @brief 重なる組を集める時に使うレイヤーとマスクを設定
+	// @param inIndex：登録時の番号
+	// @param inLayerBit：自分のレイヤーのビット
+	// @param inMask：組にする相手のレイヤーのビット
+	// @note 登録した直後はどのレイヤーとも組になる
+	void SetFilter(uint32_t inIndex, uint32_t inLayerBit, uint32_t inMask);
+
+	// @brief 更新
+	// @note ツリーの質を確かめて必要なら作り直し、直前の更新からの統計情報を確定する
+	void Update();
+
+	// @brief レイに一番最初に当たる箱を探す
+	// @param inOrigin：始点(XYZ)
+	// @param inDirection：向き(XYZ、正規化済み)
+	// @param inMaxDistance：最大の距離
+	// @param inTagMask：対象のタグのビット
+	// @param outHit：当たった箱
+	// @return true:当たった false:当たらない
+	bool Raycast(const float* inOrigin, const float* inDirection, float inMaxDistance, uint32_t inTagMask, SpatialHit& outHit) const;
+
+	// @brief 球を動かして一番最初に当たる箱を探す
+	// @param inOrigin：球の中心の始点(XYZ)
+	// @param inDirection：向き(XYZ、正規化済み)
+	// @param inRadius：球の半径
+	// @param inMaxDistance：最大の距離
+	// @param inTagMask：対象のタグのビット
+	// @param outHit：当たった箱
+	// @return true:当たった false:当たらない
+	bool SphereCast(const float* inOrigin, const float* inDirection, float inRadius, float inMaxDistance, uint32_t inTagMask, SpatialHit& outHit) const;
+
+	// @brief 球と重なる箱を集める
+	// @param inCenter：中心(XYZ)
+	// @param inRadius：半径
+	// @param inTagMask：対象のタグのビット
+	// @param outHits：結果を書き込む配列
+	// @param inMaxNum：書き込める最大数
+	// @return 書き込んだ数(順番は決まっていない)
+	uint32_t OverlapSphere(const float* inCenter, float inRadius, uint32_t inTagMask, SpatialHit* outHits, uint32_t inMaxNum) const;
+
+	// @brief 箱と重なる箱を集める
+	// @param inBox：箱
+	// @param inTagMask：対象のタグのビット
+	// @param outHits：結果を書き込む配列
+	// @param inMaxNum：書き込める最大数
+	// @return 書き込んだ数(順番は決まっていない)
+	uint32_t OverlapBox(const SpatialBox& inBox, uint32_t inTagMask, SpatialHit* outHits, uint32_t inMaxNum) const;
+
+	// @brief 点に近い順に箱を集める
+	// @param inPoint：点(XYZ)
+	// @param inMaxDistance：最大の距離
+	// @param inTagMask：対象のタグのビット
+	// @param outHits：結果を書き込む配列
+	// @param inMaxNum：集める数
+	// @return 書き込んだ数(近い順)
+	uint32_t Nearest(const float* inPoint, float inMaxDistance, uint32_t inTagMask, SpatialHit* outHits, uint32_t inMaxNum) const;
+
+	// @brief AABBが重なる箱の組を集める
+	// @param outPairs：結果を書き込む配列(中身は消してから書き込む)
+	// @note 動く箱のAABBでツリーを検索し、動かない箱同士の組は集めない
+	//       互いのレイヤーがもう一方のマスクに含まれない組は、AABBを比べる前に除く
+	//       組は登録時の番号の順に並べる
+	void FindPairs(std::vector<SpatialPair>& outPairs) const;
+
+	// @brief 登録した箱の数の取得
+	uint32_t GetBoxNum() const { return m_tTree.GetProxyNum(); }
+
+	// @brief 統計情報の取得
+	// @return 直前の更新から次の更新までの統計情報
+	const SpatialQueryStats& GetStats() const { return m_tStats; }
+
+	// @brief ツリーの統計情報の取得
+	// @return 直前の更新から次の更新までの統計情報
+	const AabbTreeStats& GetTreeStats() const { return m_tTree.GetStats(); }
+
+	// @brief 大量の箱で検索の結果を総当たりと比べ、検索の速さを計測して書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief 登録した箱
+	struct Item
+	{
+		// 箱
+		SpatialBox m_tBox;
+
+		// 箱を包むAABBの最小(XYZ)
+		float m_fMin[3];
+
+		// 箱を包むAABBの最大(XYZ)
+		float m_fMax[3];
+
+		// タグのビット
+		uint32_t m_nTagMask;
+
+		// 自分のレイヤーのビット
+		uint32_t m_nLayerBit;
+
+		// 組にする相手のレイヤーのビット
+		uint32_t m_nMask;
+
+		// ツリーの葉のノードの番号(外した箱はCDynamicAabbTree::ce_nNull)
+		uint32_t m_nProxy;
+
+		// 動かない箱かどうか
+		bool m_bStatic;
+
+		// 当たり判定
+		CCollisionBase* m_pCollision;
+	};
+
+	// @brief 線分を球の半径だけ広げたツリーで辿り、一番最初に当たる箱を探す
+	// @param inOrigin：始点(XYZ)
+	// @param inDirection：向き(XYZ、正規化済み)
+	// @param inRadius：球の半径(0ならレイ)
+	// @param inMaxDistance：最大の距離
+	// @param inTagMask：対象のタグのビット
+	// @param outHit：当たった箱
+	// @return true:当たった false:当たらない
+	bool Cast(const float* inOrigin, const float* inDirection, float inRadius, float inMaxDistance, uint32_t inTagMask, SpatialHit& outHit) const;
+
+	// @brief 箱と検索結果を作る
+	// @param inIndex：登録時の番号
+	// @param inDistance：距離
+	// @param inPos：位置
+	// @param inNormal：法線
+	SpatialHit MakeHit(uint32_t inIndex, float inDistance, const float* inPos, const float* inNormal) const;
+
+private:
+	// @brief 登録時の番号毎の箱
+	std::vector<Item> m_BoxVec;
+
+	// @brief 外した箱の登録時の番号
+	std::vector<uint32_t> m_FreeVec;
+
+	// @brief 箱を包むAABBの動的AABBツリー(葉の値は登録時の番号)
+	CDynamicAabbTree m_tTree;
+
+	// @brief タグのビット毎の識別用タグ
+	std::vector<std::string> m_TagVec;
+
+	// @brief 集計中の統計情報
+	mutable SpatialQueryStats m_tCount;
+
+	// @brief 直前の更新から次の更新までの統計情報
+	SpatialQueryStats m_tStats;
+};
@@ -5,11 +5,12 @@
 #include "Sprite.h"
 #include "Defines.h"
 #include "Camera.h"
+#include "ShaderManager.h"
 
 //--- 静的メンバ変数の実体定義
 Sprite::Data Sprite::m_data;
-std::shared_ptr<VertexShader> Sprite::m_defVS;
-std::shared_ptr<PixelShader> Sprite::m_defPS;
+VertexShader* Sprite::m_defVS = nullptr;
+PixelShader* Sprite::m_defPS = nullptr;
 
 /*************************//*
 @brief  | 初期化
@@ -44,15 +45,13 @@ void Sprite::Init()
 	DirectX::XMStoreFloat4x4(&m_data.matrix[1], DirectX::XMMatrixIdentity());
 	DirectX::XMStoreFloat4x4(&m_data.matrix[2], DirectX::XMMatrixIdentity());
 
-	// シェーダー
-	m_defVS = std::make_shared<VertexShader>();
-    HRESULT hr = m_defVS->Load(SHADER_PATH("VS_Sprite.cso"));
-    if (FAILED(hr)) MessageBox(NULL, "LoadFailed:VS_Sprite", "Error:Sprite.cpp", MB_OK);
-	m_data.vs = m_defVS.get();
-	m_defPS = std::make_shared <PixelShader>();
-	hr = m_defPS->Load(SHADER_PATH("PS_Sprite.cso"));
-    if (FAILED(hr)) MessageBox(NULL, "LoadFailed:PS_Sprite", "Error:Sprite.cpp", MB_OK);
-	m_data.ps = m_defPS.get();
+	// シェーダー(シェーダーマネージャーで読み込んだものを使う)
+	m_defVS = CShaderManager::GetInstance()->GetVertexShader(VSType::Sprite);
+    if (!m_defVS) MessageBox(NULL, "LoadFailed:VS_Sprite", "Error:Sprite.cpp", MB_OK);
+	m_data.vs = m_defVS;
+	m_defPS = CShaderManager::GetInstance()->GetPixelShader(PSType::Sprite);
+    if (!m_defPS) MessageBox(NULL, "LoadFailed:PS_Sprite", "Error:Sprite.cpp", MB_OK);
+	m_data.ps = m_defPS;
 }
 
 /*************************//*
@@ -60,7 +59,11 @@ void Sprite::Init()
 *//*************************/
 void Sprite::Uninit()
 {
-
+	// シェーダーはシェーダーマネージャーが解放する
+	m_defVS = nullptr;
+	m_defPS = nullptr;
+	m_data.vs = nullptr;
+	m_data.ps = nullptr;
 }
 
 /*************************//*
@@ -68,6 +71,9 @@ void Sprite::Uninit()
 *//*************************/
 void Sprite::Draw()
 {
+	// シェーダーが読み込めていない時は描画しない
+	if (!m_data.vs || !m_data.ps) return;
+
 	m_data.vs->WriteBuffer(0, m_data.matrix);
 	m_data.vs->WriteBuffer(1, m_data.param);
 	m_data.vs->Bind();
@@ -170,7 +176,7 @@ void Sprite::SetVertexShader(Shader* vs)
 	if (vs && typeid(VertexShader) == typeid(*vs))
 		m_data.vs = vs;
 	else
-		m_data.vs = m_defVS.get();
+		m_data.vs = m_defVS;
 }
 
 /*************************//*
@@ -182,7 +188,7 @@ void Sprite::SetPixelShader(Shader* ps)
 	if (ps && typeid(PixelShader) == typeid(*ps))
 		m_data.ps = ps;
 	else
-		m_data.ps = m_defPS.get();
+		m_data.ps = m_defPS;
 }
 
 void Sprite::SetParam(RendererParam param, SpriteKind inKind)
@@ -108,9 +108,9 @@ private:
 	};
     // スプライト描画用データ
 	static Data m_data;
-    // デフォルト頂点シェーダー
-	static std::shared_ptr<VertexShader> m_defVS;
-    // デフォルトピクセルシェーダー
-	static std::shared_ptr<PixelShader> m_defPS;
+    // デフォルト頂点シェーダー(シェーダーマネージャーが管理する)
+	static VertexShader* m_defVS;
+    // デフォルトピクセルシェーダー(シェーダーマネージャーが管理する)
+	static PixelShader* m_defPS;
 
 };
@@ -4,7 +4,7 @@
 	@note	| CRendererComponentを継承
 *//**************************************************/
 #include "Sprite3DRenderer.h"
-#include "Sprite.h"
+#include "SpriteBatch.h"
 #include "DirectX.h"
 
 /****************************************//*
@@ -30,23 +30,9 @@ void CSprite3DRenderer::Init()
 void CSprite3DRenderer::Draw()
 {
     // キーが設定されていない時は描画しない
-    if (m_sKey.empty()) return;
+    const RendererObject* pObject = GetRendererObject();
+    if (!pObject) return;
 
-    // フラグによって深度バッファを使用するか決める
-    RenderTarget* pRTV = GetDefaultRTV();
-    DepthStencil* pDSV = GetDefaultDSV();
-    if (m_bIsDepth) SetRenderTargets(1, &pRTV, pDSV);
-    else SetRenderTargets(1, &pRTV, nullptr);
-
-    // カリングのセット
-    SetCullingMode(m_tParam.m_eCulling);
-
-    // 描画用パラメータのセット
-    Sprite::SetParam(m_tParam, SpriteKind::World);
-
-    // テクスチャのセット
-    Sprite::SetTexture(std::get<Texture*>(m_RendererObjectMap.find(m_sKey.c_str())->second.m_Data));
-
-    // 描画
-    Sprite::Draw();
+    // まとめ描画に追加(フラグによって深度バッファを使用するか決める)
+    SpriteBatch::Add(GetDrawParam(*pObject), SpriteKind::World, std::get<Texture*>(pObject->m_Data), m_bIsDepth);
 }
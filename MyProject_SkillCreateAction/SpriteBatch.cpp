@@ -0,0 +1,565 @@
+/**************************************************//*
+	@file	| SpriteBatch.cpp
+	@brief	| スプライトのまとめ描画クラスのcppファイル
+	@note	| 1フレーム分のスプライトを頂点バッファに溜め、
+			| 描画状態(パス・ブレンド・シェーダー・テクスチャ)ごとにまとめて描画する
+*//**************************************************/
+#include "SpriteBatch.h"
+#include "Defines.h"
+#include "Camera.h"
+#include "ShaderManager.h"
+#include <algorithm>
+#include <numeric>
+#include <climits>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <set>
+#include <tuple>
+
+//--- 静的メンバ変数の実体定義
+std::vector<SpriteBatch::Quad> SpriteBatch::m_QuadVec;
+std::vector<UINT> SpriteBatch::m_OrderVec;
+std::vector<SpriteBatch::Vertex> SpriteBatch::m_VertexVec;
+std::vector<SpriteBatchCommand> SpriteBatch::m_CommandVec;
+UINT SpriteBatch::m_nWriteChunk = UINT_MAX;
+std::unordered_map<const void*, UINT> SpriteBatch::m_ShaderIdMap;
+std::unordered_map<const void*, UINT> SpriteBatch::m_TextureIdMap;
+std::shared_ptr<MeshBuffer> SpriteBatch::m_pMesh;
+VertexShader* SpriteBatch::m_pVS = nullptr;
+PixelShader* SpriteBatch::m_pPS = nullptr;
+SpriteBatchStats SpriteBatch::m_tStats = {};
+
+/****************************************//*
+	@brief　	| 初期化
+*//****************************************/
+void SpriteBatch::Init()
+{
+	// 四角形ごとに2枚の三角形を作るインデックス
+	std::vector<unsigned short> indices(ce_nMaxQuadNum * 6);
+	for (UINT i = 0; i < ce_nMaxQuadNum; i++)
+	{
+		unsigned short nBase = static_cast<unsigned short>(i * 4);
+		indices[i * 6 + 0] = nBase + 0;
+		indices[i * 6 + 1] = nBase + 1;
+		indices[i * 6 + 2] = nBase + 2;
+		indices[i * 6 + 3] = nBase + 2;
+		indices[i * 6 + 4] = nBase + 1;
+		indices[i * 6 + 5] = nBase + 3;
+	}
+	std::vector<Vertex> vertices(ce_nMaxQuadNum * 4, Vertex{});
+
+	// 毎フレーム書き換える頂点バッファ
+	MeshBuffer::Description desc = {};
+	desc.pVtx = vertices.data();
+	desc.vtxSize = sizeof(Vertex);
+	desc.vtxCount = static_cast<UINT>(vertices.size());
+	desc.isWrite = true;
+	desc.pIdx = indices.data();
+	desc.idxSize = sizeof(unsigned short);
+	desc.idxCount = static_cast<UINT>(indices.size());
+	desc.topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+	m_pMesh = std::make_shared<MeshBuffer>();
+	if (FAILED(m_pMesh->Create(desc))) MessageBox(NULL, "CreateFailed:SpriteBatch", "Error:SpriteBatch.cpp", MB_OK);
+
+	// シェーダー(シェーダーマネージャーで読み込んだものを使う)
+	m_pVS = CShaderManager::GetInstance()->GetVertexShader(VSType::SpriteBatch);
+	if (!m_pVS) MessageBox(NULL, "LoadFailed:VS_SpriteBatch", "Error:SpriteBatch.cpp", MB_OK);
+	m_pPS = CShaderManager::GetInstance()->GetPixelShader(PSType::Sprite);
+	if (!m_pPS) MessageBox(NULL, "LoadFailed:PS_Sprite", "Error:SpriteBatch.cpp", MB_OK);
+
+	m_QuadVec.reserve(ce_nMaxQuadNum);
+	m_VertexVec.reserve(ce_nMaxQuadNum * 4);
+}
+
+/****************************************//*
+	@brief　	| 終了
+*//****************************************/
+void SpriteBatch::Uninit()
+{
+	Clear();
+	m_CommandVec.clear();
+	m_pPS = nullptr;
+	m_pVS = nullptr;
+	m_pMesh.reset();
+}
+
+/****************************************//*
+	@brief　	| スプライトを追加する
+	@param　	| inParam：レンダラー用パラメーター
+	@param　	| inKind：スプライトの種類
+	@param　	| pTexture：テクスチャ
+	@param　	| isDepth：深度バッファを使うか(2Dスプライトは常に使わない)
+	@param　	| inBlend：ブレンドモード
+	@param　	| pPS：ピクセルシェーダー(nullptrでデフォルト)
+*//****************************************/
+void SpriteBatch::Add(const RendererParam& inParam, SpriteKind inKind, Texture* pTexture,
+	bool isDepth, BlendMode inBlend, Shader* pPS)
+{
+	CCamera* pCamera = CCamera::GetInstance();
+
+	// Sprite::SetParamと同じ行列をCPU側で掛け合わせる
+	DirectX::XMMATRIX mWorld = DirectX::XMMatrixIdentity();
+	DirectX::XMFLOAT4X4 view, proj;
+	switch (inKind)
+	{
+	case SpriteKind::Screen:
+		mWorld =
+			DirectX::XMMatrixScaling(1.0f, -1.0f, 1.0f) *
+			DirectX::XMMatrixRotationRollPitchYawFromVector(DirectX::XMLoadFloat3(&inParam.m_f3Rotate)) *
+			DirectX::XMMatrixTranslation(inParam.m_f3Pos.x + SCREEN_WIDTH * 0.5f, inParam.m_f3Pos.y + SCREEN_HEIGHT * 0.5f, inParam.m_f3Pos.z);
+		view = pCamera->Get2DViewMatrix(false);
+		proj = pCamera->Get2DProjectionMatrix(false);
+		break;
+	case SpriteKind::World:
+		mWorld =
+			DirectX::XMMatrixRotationRollPitchYaw(inParam.m_f3Rotate.x, inParam.m_f3Rotate.y, inParam.m_f3Rotate.z) *
+			DirectX::XMMatrixTranslation(inParam.m_f3Pos.x, inParam.m_f3Pos.y, inParam.m_f3Pos.z);
+		view = pCamera->GetViewMatrix(false);
+		proj = pCamera->GetProjectionMatrix(false);
+		break;
+	case SpriteKind::Billboard:
+	{
+		DirectX::XMFLOAT4X4 world = pCamera->GetBillboardWolrdMatrix(inParam.m_f3Pos, false);
+		mWorld = DirectX::XMLoadFloat4x4(&world);
+		view = pCamera->GetViewMatrix(false);
+		proj = pCamera->GetProjectionMatrix(false);
+		break;
+	}
+	default:
+		return;
+	}
+	DirectX::XMMATRIX mWVP = mWorld * DirectX::XMLoadFloat4x4(&view) * DirectX::XMLoadFloat4x4(&proj);
+
+	Quad tQuad = {};
+	tQuad.m_ePass = inKind == SpriteKind::Screen ? SpritePass::Screen : (isDepth ? SpritePass::World : SpritePass::WorldNoDepth);
+	tQuad.m_eCulling = inParam.m_eCulling;
+	tQuad.m_eBlend = inBlend;
+	tQuad.m_pPS = (pPS && typeid(PixelShader) == typeid(*pPS)) ? pPS : m_pPS;
+	tQuad.m_pTexture = pTexture;
+
+	// Sprite::Initの四角形と同じ並び(左上、右上、左下、右下)
+	const float fLocal[4][4] = {
+		{-0.5f, 0.5f, 0.0f, 0.0f},
+		{ 0.5f, 0.5f, 1.0f, 0.0f},
+		{-0.5f,-0.5f, 0.0f, 1.0f},
+		{ 0.5f,-0.5f, 1.0f, 1.0f},
+	};
+	for (int i = 0; i < 4; i++)
+	{
+		Vertex& vtx = tQuad.m_tVtx[i];
+		DirectX::XMVECTOR vPos = DirectX::XMVectorSet(fLocal[i][0] * inParam.m_f3Size.x, fLocal[i][1] * inParam.m_f3Size.y, 0.0f, 1.0f);
+		DirectX::XMStoreFloat4(reinterpret_cast<DirectX::XMFLOAT4*>(vtx.pos), DirectX::XMVector4Transform(vPos, mWVP));
+		vtx.uv[0] = fLocal[i][2] * inParam.m_f2UVSize.x + inParam.m_f2UVPos.x;
+		vtx.uv[1] = fLocal[i][3] * inParam.m_f2UVSize.y + inParam.m_f2UVPos.y;
+		vtx.color[0] = inParam.m_f4Color.x;
+		vtx.color[1] = inParam.m_f4Color.y;
+		vtx.color[2] = inParam.m_f4Color.z;
+		vtx.color[3] = inParam.m_f4Color.w;
+	}
+
+	// 透視投影ではクリップ空間のWがビュー空間のZなので、四角形の中心を変換したWを距離にする
+	if (inKind != SpriteKind::Screen)
+	{
+		tQuad.m_fDepth = DirectX::XMVectorGetW(DirectX::XMVector4Transform(DirectX::XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), mWVP));
+	}
+	m_QuadVec.push_back(tQuad);
+}
+
+/****************************************//*
+	@brief　	| 溜めたスプライトを並べ替えて描画命令を作成する
+	@note		| GPUには触れないので描画命令の中身だけを確認できる
+*//****************************************/
+void SpriteBatch::Build()
+{
+	m_VertexVec.clear();
+	m_CommandVec.clear();
+	m_nWriteChunk = UINT_MAX;
+	m_ShaderIdMap.clear();
+	m_TextureIdMap.clear();
+
+	// 並べ替え用のキーを作成して安定ソート(同じキー同士は登録順のまま)
+	std::vector<UINT64> keys(m_QuadVec.size());
+	for (size_t i = 0; i < m_QuadVec.size(); i++)
+	{
+		keys[i] = MakeSortKey(i);
+	}
+	m_OrderVec.resize(m_QuadVec.size());
+	std::iota(m_OrderVec.begin(), m_OrderVec.end(), 0u);
+	std::stable_sort(m_OrderVec.begin(), m_OrderVec.end(),
+		[&keys](UINT a, UINT b) { return keys[a] < keys[b]; });
+
+	// 同じ描画状態が続く間は1つの描画命令にまとめる
+	for (UINT i = 0; i < m_OrderVec.size(); i++)
+	{
+		const Quad& tQuad = m_QuadVec[m_OrderVec[i]];
+		m_VertexVec.insert(m_VertexVec.end(), tQuad.m_tVtx, tQuad.m_tVtx + 4);
+
+		bool bMerge = false;
+		if (!m_CommandVec.empty() && i % ce_nMaxQuadNum != 0)
+		{
+			const SpriteBatchCommand& tPrev = m_CommandVec.back();
+			bMerge =
+				tPrev.m_ePass == tQuad.m_ePass &&
+				tPrev.m_eCulling == tQuad.m_eCulling &&
+				tPrev.m_eBlend == tQuad.m_eBlend &&
+				tPrev.m_pPS == tQuad.m_pPS &&
+				tPrev.m_pTexture == tQuad.m_pTexture;
+		}
+
+		if (bMerge)
+		{
+			m_CommandVec.back().m_nCount++;
+		}
+		else
+		{
+			m_CommandVec.push_back({ tQuad.m_ePass, tQuad.m_eCulling, tQuad.m_eBlend, tQuad.m_pPS, tQuad.m_pTexture, i, 1 });
+		}
+	}
+
+	m_tStats.m_nSpriteNum = static_cast<int>(m_QuadVec.size());
+	m_tStats.m_nCommandNum = static_cast<int>(m_CommandVec.size());
+	m_tStats.m_nUploadNum = static_cast<int>((m_QuadVec.size() + ce_nMaxQuadNum - 1) / ce_nMaxQuadNum);
+}
+
+/****************************************//*
+	@brief　	| 作成した描画命令に指定したパスの命令があるか
+	@param　	| inPass：描画パス
+	@return		| true:ある false:無い
+*//****************************************/
+bool SpriteBatch::HasPass(SpritePass inPass)
+{
+	for (const SpriteBatchCommand& tCommand : m_CommandVec)
+	{
+		if (tCommand.m_ePass == inPass) return true;
+	}
+	return false;
+}
+
+/****************************************//*
+	@brief　	| 溜めたスプライトを破棄する
+*//****************************************/
+void SpriteBatch::Clear()
+{
+	m_QuadVec.clear();
+}
+
+/****************************************//*
+	@brief　	| 作成した描画命令のうち、指定したパスの命令を描画する
+	@param　	| inPass：描画パス
+	@note		| Buildの後に呼ぶ。レンダーターゲットはフレームグラフが設定する
+*//****************************************/
+void SpriteBatch::Draw(SpritePass inPass)
+{
+	// シェーダーが読み込めていない時は描画しない
+	if (!m_pMesh || !m_pVS || !m_pPS) return;
+
+	bool bBind = false;
+	for (const SpriteBatchCommand& tCommand : m_CommandVec)
+	{
+		if (tCommand.m_ePass != inPass) continue;
+		if (!bBind)
+		{
+			m_pVS->Bind();
+			bBind = true;
+		}
+
+		// 頂点バッファに収まる分ずつ書き込む
+		UINT nChunk = tCommand.m_nStart / ce_nMaxQuadNum;
+		if (nChunk != m_nWriteChunk)
+		{
+			m_nWriteChunk = nChunk;
+			UINT nFirst = nChunk * ce_nMaxQuadNum;
+			UINT nQuadNum = (std::min)(ce_nMaxQuadNum, static_cast<UINT>(m_OrderVec.size()) - nFirst);
+			m_pMesh->Write(&m_VertexVec[nFirst * 4], nQuadNum * 4);
+		}
+
+		SetCullingMode(tCommand.m_eCulling);
+		SetBlendMode(tCommand.m_eBlend);
+		tCommand.m_pPS->SetTexture(0, tCommand.m_pTexture);
+		tCommand.m_pPS->Bind();
+		m_pMesh->Draw(tCommand.m_nCount * 6, (tCommand.m_nStart - nChunk * ce_nMaxQuadNum) * 6);
+	}
+
+	// 他の描画に影響しないよう元に戻す
+	if (bBind) SetBlendMode(BLEND_ALPHA);
+}
+
+/****************************************//*
+	@brief　	| 描画状態の並べ替え用のキーを作成する
+	@param　	| inIndex：四角形の番号
+	@return		| 並べ替え用のキー
+*//****************************************/
+UINT64 SpriteBatch::MakeSortKey(size_t inIndex)
+{
+	const Quad& tQuad = m_QuadVec[inIndex];
+
+	// 上位2bit：描画パス
+	UINT64 ulKey = static_cast<UINT64>(tQuad.m_ePass) << 62;
+
+	// 2Dスプライトと深度バッファを使わない3Dスプライトは、重なり順を崩さないようパスだけで並べる(登録順になる)
+	if (tQuad.m_ePass != SpritePass::World) return ulKey;
+
+	UINT64 ulBlend = tQuad.m_eBlend & 0x7;
+	UINT64 ulCulling = tQuad.m_eCulling & 0x3;
+	UINT64 ulShader = (std::min)(GetSortId(m_ShaderIdMap, tQuad.m_pPS), 0xffu);
+	UINT64 ulTexture = (std::min)(GetSortId(m_TextureIdMap, tQuad.m_pTexture), 0xffffu);
+	if (tQuad.m_eBlend == BLEND_NONE)
+	{
+		// 不透明はブレンド(3bit)、カリング(2bit)、シェーダー(8bit)、テクスチャ(16bit)の順に並べる
+		ulKey |= ulBlend << 59;
+		ulKey |= ulCulling << 57;
+		ulKey |= ulShader << 49;
+		ulKey |= ulTexture << 33;
+	}
+	else
+	{
+		// 半透明は不透明の後に、重なりが正しくなるよう奥から描画する(同じ距離の中では描画状態で並べる)
+		ulKey |= 1ull << 61;
+		ulKey |= (~MakeDepthKey(tQuad.m_fDepth) & 0xffffff) << 37;
+		ulKey |= ulBlend << 34;
+		ulKey |= ulCulling << 32;
+		ulKey |= ulShader << 24;
+		ulKey |= ulTexture << 8;
+	}
+	return ulKey;
+}
+
+/****************************************//*
+	@brief　	| カメラからの距離を並べ替え用の24bitの値に変換する
+	@param　	| inDepth：カメラからの距離
+	@return		| 距離が遠いほど大きくなる値
+*//****************************************/
+UINT64 SpriteBatch::MakeDepthKey(float inDepth)
+{
+	// 正の浮動小数はビット列のまま比較しても大小関係が変わらないので上位24bitを使う
+	float fDepth = (std::max)(inDepth, 0.0f);
+	UINT nBits;
+	memcpy(&nBits, &fDepth, sizeof(nBits));
+	return (nBits >> 7) & 0xffffff;
+}
+
+/****************************************//*
+	@brief　	| ポインタを並べ替え用の番号に変換する
+	@param　	| inIdMap：変換表
+	@param　	| pPtr：変換するポインタ
+	@return		| 並べ替え用の番号(フレーム内で最初に出てきた順)
+*//****************************************/
+UINT SpriteBatch::GetSortId(std::unordered_map<const void*, UINT>& inIdMap, const void* pPtr)
+{
+	auto itr = inIdMap.find(pPtr);
+	if (itr != inIdMap.end()) return itr->second;
+
+	UINT nId = static_cast<UINT>(inIdMap.size());
+	inIdMap.emplace(pPtr, nId);
+	return nId;
+}
+
+/****************************************//*
+	@brief　	| テクスチャ・シェーダー・ブレンドの混ざったスプライトをBuildし、並び順とまとめ方を確認してファイルに書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return		| 0:成功 1:失敗(並び順が崩れた、まとめられる描画命令が分かれた)
+	@note		| デバイスを使わないので初期化前に呼べる。溜めているスプライトは破棄する
+*//****************************************/
+int SpriteBatch::Benchmark(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr int ce_nTextureNum = 8;
+	static constexpr int ce_nShaderNum = 3;
+	const BlendMode ce_eBlend[] = { BLEND_NONE, BLEND_ALPHA, BLEND_ADD };
+	const D3D11_CULL_MODE ce_eCulling[] = { D3D11_CULL_NONE, D3D11_CULL_BACK };
+	const UINT ce_nSpriteNum[] = { 3000, 10000 };
+	char szLine[256];
+	bool bSuccess = true;
+
+	// 並べ替えとまとめは比べるだけなので、デバイスを使わずに作れるシェーダーとテクスチャを使う
+	std::vector<PixelShader> tShaderVec(ce_nShaderNum);
+	std::vector<Texture> tTextureVec(ce_nTextureNum);
+	using State = std::tuple<SpritePass, D3D11_CULL_MODE, BlendMode, Shader*, Texture*>;
+	auto StateOf = [](const Quad& tQuad) { return State(tQuad.m_ePass, tQuad.m_eCulling, tQuad.m_eBlend, tQuad.m_pPS, tQuad.m_pTexture); };
+
+	tReport << "sprites  world  screen  draws  min draws  upload  build ms  check\n";
+	for (UINT nSpriteNum : ce_nSpriteNum)
+	{
+		std::mt19937 tRandom(31);
+		std::uniform_real_distribution<float> tPos(-10.0f, 10.0f);
+		Clear();
+
+		// 3D(深度あり・なし)とビルボードと2Dを混ぜ、登録した番号を色に入れて並べ替え後に辿れるようにする
+		for (UINT i = 0; i < nSpriteNum; i++)
+		{
+			RendererParam tParam = {};
+			tParam.m_f3Pos = { tPos(tRandom), tPos(tRandom), tPos(tRandom) };
+			tParam.m_f3Size = { 1.0f, 1.0f, 1.0f };
+			tParam.m_f4Color = { 1.0f, static_cast<float>(i), 1.0f, 1.0f };
+			tParam.m_f2UVSize = { 1.0f, 1.0f };
+			tParam.m_eCulling = ce_eCulling[tRandom() % 2];
+
+			SpriteKind eKind = static_cast<SpriteKind>(tRandom() % static_cast<UINT>(SpriteKind::Max));
+			bool isDepth = tRandom() % 4 != 0;
+
+			// 2Dは重なり順のまま描くので、同じ状態が続きやすいよう種類を絞る
+			bool isScreen = eKind == SpriteKind::Screen;
+			Texture* pTexture = &tTextureVec[tRandom() % (isScreen ? 2 : ce_nTextureNum)];
+			PixelShader* pPS = &tShaderVec[isScreen ? 0 : tRandom() % ce_nShaderNum];
+			BlendMode eBlend = isScreen ? BLEND_ALPHA : ce_eBlend[tRandom() % 3];
+			if (isScreen) tParam.m_eCulling = D3D11_CULL_NONE;
+			Add(tParam, eKind, pTexture, isDepth, eBlend, pPS);
+		}
+
+		auto tStart = std::chrono::high_resolution_clock::now();
+		Build();
+		double dBuildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+		// 最少の描画命令数
+		// 不透明の3Dは描画状態の種類の数、半透明の3Dは奥から並べて同じ距離の中で描画状態ごとにまとめた時の切り替わりの数、
+		// 深度バッファを使わない3Dと2Dは登録順で描画状態が変わる回数
+		std::set<State> tOpaqueStateSet;
+		std::vector<std::pair<UINT64, State>> tTranslucentVec;
+		int nOrderedRun = 0;
+		int nScreenNum = 0;
+		const Quad* pPrevOrdered[static_cast<int>(SpritePass::Max)] = {};
+		for (const Quad& tQuad : m_QuadVec)
+		{
+			if (tQuad.m_ePass == SpritePass::Screen) nScreenNum++;
+			if (tQuad.m_ePass == SpritePass::World)
+			{
+				if (tQuad.m_eBlend == BLEND_NONE) tOpaqueStateSet.insert(StateOf(tQuad));
+				else tTranslucentVec.emplace_back(~MakeDepthKey(tQuad.m_fDepth) & 0xffffff, StateOf(tQuad));
+				continue;
+			}
+			const Quad*& pPrev = pPrevOrdered[static_cast<int>(tQuad.m_ePass)];
+			if (!pPrev || StateOf(*pPrev) != StateOf(tQuad)) nOrderedRun++;
+			pPrev = &tQuad;
+		}
+		std::sort(tTranslucentVec.begin(), tTranslucentVec.end());
+		int nTranslucentRun = 0;
+		for (size_t i = 0; i < tTranslucentVec.size(); i++)
+		{
+			if (i == 0 || tTranslucentVec[i - 1].second != tTranslucentVec[i].second) nTranslucentRun++;
+		}
+		int nMinCommand = static_cast<int>(tOpaqueStateSet.size()) + nTranslucentRun + nOrderedRun;
+
+		// 頂点バッファの区切りをまたぐ描画はできないので、区切り毎に1つまで増えてよい
+		int nBoundaryNum = static_cast<int>((nSpriteNum - 1) / ce_nMaxQuadNum);
+
+		// 描画命令が四角形を隙間なく順に覆い、区切りをまたがないか
+		bool bValid = true;
+		UINT nNext = 0;
+		for (const SpriteBatchCommand& tCommand : m_CommandVec)
+		{
+			bValid = bValid && tCommand.m_nStart == nNext && tCommand.m_nCount > 0 &&
+				tCommand.m_nStart / ce_nMaxQuadNum == (tCommand.m_nStart + tCommand.m_nCount - 1) / ce_nMaxQuadNum;
+			nNext = tCommand.m_nStart + tCommand.m_nCount;
+		}
+		bValid = bValid && nNext == nSpriteNum;
+
+		// パスの順に並び、命令内の四角形が全て命令と同じ描画状態で、頂点が並べ替え後の順になっているか
+		// 3Dの半透明は不透明の後に奥から、深度バッファを使わない3Dと2Dは登録順のまま
+		SpritePass ePrevPass = SpritePass::World;
+		bool bPrevTranslucent = false;
+		UINT64 ulPrevDepth = 0;
+		UINT nPrevQuad = 0;
+		for (size_t c = 0; bValid && c < m_CommandVec.size(); c++)
+		{
+			const SpriteBatchCommand& tCommand = m_CommandVec[c];
+			bValid = tCommand.m_ePass >= ePrevPass;
+			if (tCommand.m_ePass != ePrevPass) nPrevQuad = 0;
+			ePrevPass = tCommand.m_ePass;
+
+			const State tCommandState(tCommand.m_ePass, tCommand.m_eCulling, tCommand.m_eBlend, tCommand.m_pPS, tCommand.m_pTexture);
+			for (UINT i = tCommand.m_nStart; bValid && i < tCommand.m_nStart + tCommand.m_nCount; i++)
+			{
+				UINT nQuad = m_OrderVec[i];
+				const Quad& tQuad = m_QuadVec[nQuad];
+				bValid = StateOf(tQuad) == tCommandState && m_VertexVec[i * 4].color[1] == static_cast<float>(nQuad);
+				if (!bValid) break;
+				if (tCommand.m_ePass == SpritePass::World)
+				{
+					bool bTranslucent = tQuad.m_eBlend != BLEND_NONE;
+					UINT64 ulDepth = MakeDepthKey(tQuad.m_fDepth);
+					bValid = !(bPrevTranslucent && !bTranslucent) && !(bPrevTranslucent && ulDepth > ulPrevDepth);
+					bPrevTranslucent = bTranslucent;
+					ulPrevDepth = ulDepth;
+				}
+				else
+				{
+					bValid = nPrevQuad == 0 || nQuad > nPrevQuad;
+					nPrevQuad = nQuad;
+				}
+			}
+		}
+
+		// 並べ替えで同じ描画状態が1つにまとまっているか
+		int nCommandNum = static_cast<int>(m_CommandVec.size());
+		bValid = bValid && nCommandNum >= nMinCommand && nCommandNum <= nMinCommand + nBoundaryNum;
+		bSuccess &= bValid;
+
+		sprintf_s(szLine, "%7u  %5d  %6d  %5d  %9d  %6d  %8.3f  %s\n", nSpriteNum, static_cast<int>(nSpriteNum) - nScreenNum, nScreenNum,
+			nCommandNum, nMinCommand, m_tStats.m_nUploadNum, dBuildMs, bValid ? "ok" : "FAILED");
+		tReport << szLine;
+	}
+
+	// 同じ位置に重ねたスプライトの描画順
+	// 深度バッファを使わない3Dはテクスチャが交互でも登録順、半透明の3Dは登録順に関わらず奥から、不透明の3Dは距離に関わらずまとめる
+	struct OverlapCase
+	{
+		const char* m_pName;
+		bool m_bDepth;
+		BlendMode m_eBlend;
+		float m_fZ[4];
+		int m_nTexture[4];
+		int m_nExpectOrder[4];
+		int m_nExpectCommand;
+	};
+	const OverlapCase ce_tOverlapCase[] = {
+		{ "no depth, alternating",  false, BLEND_ALPHA, { 0.0f, 0.0f, 0.0f, 0.0f }, { 0, 1, 0, 1 }, { 0, 1, 2, 3 }, 4 },
+		{ "translucent, near first", true, BLEND_ALPHA, { -4.0f, 6.0f, 2.0f, -8.0f }, { 0, 1, 0, 1 }, { 1, 2, 0, 3 }, 3 },
+		{ "opaque, mixed depth",     true, BLEND_NONE,  { -4.0f, 6.0f, 2.0f, -8.0f }, { 0, 1, 0, 1 }, { 0, 2, 1, 3 }, 2 },
+	};
+	tReport << "overlap case             order    draws  check\n";
+	for (const OverlapCase& tCase : ce_tOverlapCase)
+	{
+		Clear();
+		for (int i = 0; i < 4; i++)
+		{
+			RendererParam tParam = {};
+			tParam.m_f3Pos = { 0.0f, 0.0f, tCase.m_fZ[i] };
+			tParam.m_f3Size = { 4.0f, 4.0f, 1.0f };
+			tParam.m_f4Color = { 1.0f, static_cast<float>(i), 1.0f, 1.0f };
+			tParam.m_f2UVSize = { 1.0f, 1.0f };
+			tParam.m_eCulling = D3D11_CULL_NONE;
+			Add(tParam, SpriteKind::World, &tTextureVec[tCase.m_nTexture[i]], tCase.m_bDepth, tCase.m_eBlend, &tShaderVec[0]);
+		}
+		Build();
+
+		char szOrder[16] = {};
+		bool bValid = static_cast<int>(m_CommandVec.size()) == tCase.m_nExpectCommand;
+		for (int i = 0; i < 4; i++)
+		{
+			szOrder[i] = static_cast<char>('0' + m_OrderVec[i]);
+			bValid = bValid && static_cast<int>(m_OrderVec[i]) == tCase.m_nExpectOrder[i];
+		}
+		for (const SpriteBatchCommand& tCommand : m_CommandVec)
+		{
+			bValid = bValid && tCommand.m_pTexture == m_QuadVec[m_OrderVec[tCommand.m_nStart]].m_pTexture;
+		}
+		bSuccess &= bValid;
+
+		sprintf_s(szLine, "%-23s  %-7s  %5d  %s\n", tCase.m_pName, szOrder, static_cast<int>(m_CommandVec.size()), bValid ? "ok" : "FAILED");
+		tReport << szLine;
+	}
+
+	// 確認用のシェーダーとテクスチャを指したまま残さない
+	Clear();
+	m_VertexVec.clear();
+	m_OrderVec.clear();
+	m_CommandVec.clear();
+	m_tStats = {};
+
+	tReport << (bSuccess ? "ok\n" : "FAILED\n");
+	return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+/**************************************************//*
+	@file	| SpriteBatch.h
+	@brief	| スプライトのまとめ描画クラスのhファイル
+	@note	| 1フレーム分のスプライトを頂点バッファに溜め、
+			| 描画状態(パス・ブレンド・シェーダー・テクスチャ)ごとにまとめて描画する
+*//**************************************************/
+#pragma once
+#include "Sprite.h"
+#include <vector>
+#include <unordered_map>
+
+// @brief スプライトの描画パス
+// @note 値の小さい順に描画する
+enum class SpritePass
+{
+	// 深度バッファを使う3Dスプライト
+	World,
+
+	// 深度バッファを使わない3Dスプライト(登録順に描画する)
+	WorldNoDepth,
+
+	// 2Dスプライト(登録順に描画する)
+	Screen,
+
+	Max
+};
+
+// @brief まとめ描画の1回分の描画命令
+struct SpriteBatchCommand
+{
+	// 描画パス
+	SpritePass m_ePass;
+
+	// カリングモード
+	D3D11_CULL_MODE m_eCulling;
+
+	// ブレンドモード
+	BlendMode m_eBlend;
+
+	// ピクセルシェーダー
+	Shader* m_pPS;
+
+	// テクスチャ
+	Texture* m_pTexture;
+
+	// 先頭の四角形の番号
+	UINT m_nStart;
+
+	// 四角形の数
+	UINT m_nCount;
+};
+
+// @brief まとめ描画の統計情報
+struct SpriteBatchStats
+{
+	// 登録されたスプライト数(まとめない場合の描画命令数)
+	int m_nSpriteNum;
+
+	// まとめた後の描画命令数
+	int m_nCommandNum;
+
+	// 頂点バッファの書き込み回数
+	int m_nUploadNum;
+};
+
+// @brief スプライトのまとめ描画クラス
+class SpriteBatch
+{
+public:
+	// @brief まとめ描画用頂点
+	// @note 座標は変換済み(クリップ空間)
+	struct Vertex
+	{
+		float pos[4];
+		float uv[2];
+		float color[4];
+	};
+
+public:
+	// @brief 初期化
+	static void Init();
+
+	// @brief 終了
+	static void Uninit();
+
+	// @brief スプライトを追加する
+	// @param inParam：レンダラー用パラメーター
+	// @param inKind：スプライトの種類
+	// @param pTexture：テクスチャ
+	// @param isDepth：深度バッファを使うか(2Dスプライトは常に使わない)
+	// @param inBlend：ブレンドモード
+	// @param pPS：ピクセルシェーダー(nullptrでデフォルト)
+	static void Add(const RendererParam& inParam, SpriteKind inKind, Texture* pTexture,
+		bool isDepth = true, BlendMode inBlend = BLEND_ALPHA, Shader* pPS = nullptr);
+
+	// @brief 溜めたスプライトを並べ替えて描画命令を作成する
+	// @note GPUには触れないので描画命令の中身だけを確認できる
+	static void Build();
+
+	// @brief 作成した描画命令のうち、指定したパスの命令を描画する
+	// @param inPass：描画パス
+	// @note Buildの後に呼ぶ。レンダーターゲットはフレームグラフが設定する
+	static void Draw(SpritePass inPass);
+
+	// @brief 作成した描画命令に指定したパスの命令があるか
+	// @param inPass：描画パス
+	// @return true:ある false:無い
+	static bool HasPass(SpritePass inPass);
+
+	// @brief 溜めたスプライトを破棄する
+	static void Clear();
+
+	// @brief 作成した描画命令の取得
+	// @return 描画命令の配列
+	static const std::vector<SpriteBatchCommand>& GetCommands() { return m_CommandVec; }
+
+	// @brief 直前に描画したフレームの統計情報の取得
+	// @return 統計情報
+	static const SpriteBatchStats& GetStats() { return m_tStats; }
+
+	// @brief テクスチャ・シェーダー・ブレンドの混ざったスプライトをBuildし、並び順とまとめ方を確認してファイルに書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:成功 1:失敗(並び順が崩れた、まとめられる描画命令が分かれた)
+	// @note デバイスを使わないので初期化前に呼べる。溜めているスプライトは破棄する
+	static int Benchmark(const char* inReportPath);
+
+private:
+	// @brief 描画状態の並べ替え用のキーを作成する
+	// @param inIndex：四角形の番号
+	// @return 並べ替え用のキー
+	static UINT64 MakeSortKey(size_t inIndex);
+
+	// @brief カメラからの距離を並べ替え用の24bitの値に変換する
+	// @param inDepth：カメラからの距離
+	// @return 距離が遠いほど大きくなる値
+	static UINT64 MakeDepthKey(float inDepth);
+
+	// @brief ポインタを並べ替え用の番号に変換する
+	// @param inIdMap：変換表
+	// @param pPtr：変換するポインタ
+	// @return 並べ替え用の番号(フレーム内で最初に出てきた順)
+	static UINT GetSortId(std::unordered_map<const void*, UINT>& inIdMap, const void* pPtr);
+
+private:
+	// @brief 溜めている四角形1つ分の情報
+	struct Quad
+	{
+		// 描画パス
+		SpritePass m_ePass;
+
+		// カリングモード
+		D3D11_CULL_MODE m_eCulling;
+
+		// ブレンドモード
+		BlendMode m_eBlend;
+
+		// ピクセルシェーダー
+		Shader* m_pPS;
+
+		// テクスチャ
+		Texture* m_pTexture;
+
+		// カメラからの距離(ビュー空間のZ、2Dは0)
+		float m_fDepth;
+
+		// 変換済みの頂点
+		Vertex m_tVtx[4];
+	};
+
+	// @brief 一度に頂点バッファへ書き込める四角形の数
+	static constexpr UINT ce_nMaxQuadNum = 4096;
+
+	// @brief 溜めている四角形
+	static std::vector<Quad> m_QuadVec;
+
+	// @brief 並べ替え後の四角形の番号
+	static std::vector<UINT> m_OrderVec;
+
+	// @brief 並べ替え後の頂点
+	static std::vector<Vertex> m_VertexVec;
+
+	// @brief 描画命令
+	static std::vector<SpriteBatchCommand> m_CommandVec;
+
+	// @brief 頂点バッファに書き込んである頂点の区切りの番号(パスをまたいで同じなら書き直さない)
+	static UINT m_nWriteChunk;
+
+	// @brief シェーダーの並べ替え用の番号
+	static std::unordered_map<const void*, UINT> m_ShaderIdMap;
+
+	// @brief テクスチャの並べ替え用の番号
+	static std::unordered_map<const void*, UINT> m_TextureIdMap;
+
+	// @brief 頂点バッファ(書き込み可能)とインデックスバッファ
+	static std::shared_ptr<MeshBuffer> m_pMesh;
+
+	// @brief 変換済み頂点をそのまま出力する頂点シェーダー(シェーダーマネージャーが管理する)
+	static VertexShader* m_pVS;
+
+	// @brief デフォルトピクセルシェーダー(シェーダーマネージャーが管理する)
+	static PixelShader* m_pPS;
+
+	// @brief 統計情報
+	static SpriteBatchStats m_tStats;
+};
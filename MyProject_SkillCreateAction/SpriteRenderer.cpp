@@ -4,7 +4,7 @@
 	@note   | CRendererComponentを継承
 *//**************************************************/
 #include "SpriteRenderer.h"
-#include "Sprite.h"
+#include "SpriteBatch.h"
 #include "DirectX.h"
 
 /****************************************//*
@@ -21,21 +21,9 @@ CSpriteRenderer::~CSpriteRenderer()
 void CSpriteRenderer::Draw()
 {
     // キーが設定されていない時は描画しない
-    if (m_sKey.empty()) return;
+    const RendererObject* pObject = GetRendererObject();
+    if (!pObject) return;
 
-    // 深度バッファを無効にする 
-    RenderTarget* pRTV = GetDefaultRTV();
-    SetRenderTargets(1, &pRTV, nullptr);
-
-    // カリングのセット
-    SetCullingMode(m_tParam.m_eCulling);
-
-    // 描画用パラメータのセット
-    Sprite::SetParam(m_tParam, SpriteKind::Screen);
-
-    // テクスチャのセット
-    Sprite::SetTexture(std::get<Texture*>(m_RendererObjectMap.find(m_sKey.c_str())->second.m_Data));
-
-    // 描画
-    Sprite::Draw();
+    // まとめ描画に追加(深度バッファは使わずに登録順で描画される)
+    SpriteBatch::Add(GetDrawParam(*pObject), SpriteKind::Screen, std::get<Texture*>(pObject->m_Data), false);
 }
@@ -18,5 +18,10 @@ public:
 
 	// @brief 描画処理
 	void Draw() override;
+
+	// @brief ワールド空間の境界球を取得
+	// @param outSphere：境界球の書き込み先
+	// @return 画面に直接描画するので常にfalse(視錐台カリングの対象外)
+	bool GetWorldBounds(BoundingSphere& outSphere) override { return false; }
 };
 
@@ -9,6 +9,25 @@
 #include <stdio.h>
 #include <crtdbg.h>
 #include "Defines.h"
+#include "ShaderManager.h"
+#include "TextureAtlas.h"
+#include "FrameGraph.h"
+#include "PathService.h"
+#include "SkillEngine.h"
+#include "ProjectileSystem.h"
+#include "SpatialQuery.h"
+#include "DynamicAabbTree.h"
+#include "CollisionDispatch.h"
+#include "ContactCache.h"
+#include "CrowdSystem.h"
+#include "BehaviorSystem.h"
+#include "Model.h"
+#include "VertexFormat.h"
+#include "ObjectLoad.h"
+#include "SpriteBatch.h"
+#include "RenderQueue.h"
+#include "Frustum.h"
+#include "RingAllocator.h"
 #include "imgui_impl_win32.h"
 
 // timeGetTime周りの使用
@@ -36,6 +55,126 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 	//_CrtSetBreakAlloc(235);
 
+	// シェーダーキャッシュの作成だけを行って終了する(ビルド後のオフライン処理用)
+	if (strstr(lpCmdLine, "-buildshaders"))
+	{
+		return CShaderManager::BuildShaderCache() == 0 ? 0 : 1;
+	}
+
+	// テクスチャアトラスのページ使用率を計測して終了する(配置の計算だけなのでデバイスは作らない)
+	if (strstr(lpCmdLine, "-packatlas"))
+	{
+		return CTextureAtlas::MeasurePacking("AtlasReport.txt");
+	}
+
+	// フレームグラフのコンパイル結果(除外したパス、実体の使い回し、設定の回数)を計測して終了する
+	if (strstr(lpCmdLine, "-framegraph"))
+	{
+		return CFrameGraph::MeasureCompile("FrameGraphReport.txt");
+	}
+
+	// 大きなマップで1000件の経路探索(A*とJPS、1スレッドとジョブシステム経由)を計測して終了する
+	if (strstr(lpCmdLine, "-pathbench"))
+	{
+		return CPathService::Benchmark("PathReport.txt");
+	}
+
+	// 4000体の対象と1000人の使用者で10秒間スキルを発動し続けて計測して終了する
+	if (strstr(lpCmdLine, "-skillstress"))
+	{
+		return CSkillEngine::StressTest("SkillReport.txt");
+	}
+
+	// 5万発の弾を箱なしと箱ありで飛ばし続けて計測して終了する
+	if (strstr(lpCmdLine, "-projbench"))
+	{
+		return CProjectileSystem::Benchmark("ProjectileReport.txt");
+	}
+
+	// 2万個の箱で空間検索の結果を総当たりと比べ、検索の種類毎の速さを計測して終了する
+	if (strstr(lpCmdLine, "-querybench"))
+	{
+		return CSpatialQuery::Benchmark("SpatialQueryReport.txt");
+	}
+
+	// 2万個の箱を動かす割合を変えて動的AABBツリーの更新の負荷を計測して終了する
+	if (strstr(lpCmdLine, "-treebench"))
+	{
+		return CDynamicAabbTree::Benchmark("AabbTreeReport.txt");
+	}
+
+	// 形状の組毎の判定を確かめ、全てOBBで判定する場合と速さを比べて終了する
+	if (strstr(lpCmdLine, "-shapebench"))
+	{
+		return CCollisionDispatch::Benchmark("CollisionShapeReport.txt");
+	}
+
+	// 6000個の物をレイヤーの絞り込み無し・有りで動かし、接触の変化を集合で求めた結果と比べて終了する
+	if (strstr(lpCmdLine, "-contactbench"))
+	{
+		return CContactCache::Benchmark("ContactReport.txt");
+	}
+
+	// 薄い壁を高速に通り抜ける物を含む配置で、掃引の判定とすり抜けの数・負荷を計測して終了する
+	if (strstr(lpCmdLine, "-ccdbench"))
+	{
+		return CCollisionDispatch::SweepBenchmark("CcdReport.txt");
+	}
+
+	// 2500人ずつの群れを正面からすれ違わせ、重なりと60Hzでの更新の負荷(1スレッドとジョブシステム経由)を計測して終了する
+	if (strstr(lpCmdLine, "-crowdbench"))
+	{
+		return CCrowdSystem::Benchmark("CrowdReport.txt");
+	}
+
+	// 1万人の敵のビヘイビアツリーを、毎フレーム評価し直す場合・値が変わった時だけの場合・時間の上限付きで計測して終了する
+	if (strstr(lpCmdLine, "-aibench"))
+	{
+		return CBehaviorSystem::Benchmark("BehaviorReport.txt");
+	}
+
+	// 確認用のメッシュとモデルフォルダ内の全ファイルに読み込み時のメッシュ最適化を行い、ACMRと頂点数の変化を書き出して終了する
+	if (strstr(lpCmdLine, "-meshopt"))
+	{
+		return Model::MeasureOptimize("MeshOptimizeReport.txt");
+	}
+
+	// 確認用のメッシュとモデルフォルダ内の全ファイルにLODを作成し、LOD毎の三角形数と誤差を書き出して終了する
+	if (strstr(lpCmdLine, "-lodreport"))
+	{
+		return Model::MeasureLod("LodReport.txt");
+	}
+
+	// 頂点圧縮(法線の八面体エンコード・UVの半精度・ウェイトの量子化)の往復の誤差を書き出して終了する
+	if (strstr(lpCmdLine, "-vtxpack"))
+	{
+		return VertexFormat::MeasureAccuracy("VertexPackReport.txt");
+	}
+
+	// テクスチャ・シェーダー・ブレンドの混ざったスプライトのまとめ描画の並び順と描画命令数を確認して終了する
+	if (strstr(lpCmdLine, "-spritebatch"))
+	{
+		return SpriteBatch::Benchmark("SpriteBatchReport.txt");
+	}
+
+	// 合成した描画命令を描画キューで並べ替えて記録用の実行先で実行し、並び順・状態変更数・描画数とインスタンス描画へのまとめ方を確認して終了する
+	if (strstr(lpCmdLine, "-renderqueue"))
+	{
+		return RenderQueue::Benchmark("RenderQueueReport.txt");
+	}
+
+	// 10万個の境界球の視錐台カリングを1つずつと4つずつで計測して書き出して終了する
+	if (strstr(lpCmdLine, "-cullbench"))
+	{
+		return CFrustum::Benchmark("CullReport.txt");
+	}
+
+	// 定数バッファのリング割り当ての境界合わせ、先頭に戻る処理、フレーム毎の破棄を確認して書き出して終了する
+	if (strstr(lpCmdLine, "-cbring"))
+	{
+		return CRingAllocator::Benchmark("ConstantBufferRingReport.txt");
+	}
+
 	//--- 変数宣言
 	WNDCLASSEX wcex;
 	MSG message;
@@ -86,6 +225,16 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		return 0;
 	}
 
+	// モデルフォルダ内の全ファイルを1スレッドと全スレッドで読み込み、掛かった時間を書き出して終了する
+	// (モデルの読み込みでバッファとテクスチャを作るため、他と違いデバイスの初期化後に行う)
+	if (strstr(lpCmdLine, "-importbench"))
+	{
+		int nResult = CObjectLoad::Benchmark("ImportReport.txt");
+		Uninit();
+		UnregisterClass(wcex.lpszClassName, hInstance);
+		return nResult;
+	}
+
 	//--- FPS制御
 	timeBeginPeriod(1);
 	DWORD countStartTime = timeGetTime();
@@ -4,6 +4,17 @@
 *//***********************************************************************************/
 #include "Texture.h"
 #include "DirectXTex/TextureLoad.h"
+#include <string>
+#include <mutex>
+
+bool Texture::m_useCooked = true;
+
+// t@C̓ǂݍ݂̓v(Xbhœɓǂݍނߔr䂷
+TextureLoadStats g_textureLoadStats = {};
+std::mutex g_textureLoadMutex;
+
+// vg^Cv錾
+bool GetCookedTexturePath(const char* fileName, std::string& outPath);
 
 /*************************//*
 @brief  | RXgN^
@@ -12,6 +23,7 @@ Texture::Texture()
 	: m_width(0), m_height(0)
 	, m_pTex(nullptr)
 	, m_pSRV(nullptr)
+	, m_memorySize(0)
 {
 }
 
@@ -28,35 +40,86 @@ Texture::~Texture()
 @brief		| t@CeNX`𐶐
 @param[in]	| fileNameFt@C
 @return		| S_OK
+@note		| ϊς݂DDSgȂꍇ͌̉摜ǂݍ
 *//*************************/
 HRESULT Texture::Create(const char* fileName)
 {
 	HRESULT hr = S_OK;
 
-	// ϊ
-	wchar_t wPath[MAX_PATH];
-	size_t wLen = 0;
-	MultiByteToWideChar(0, 0, fileName, -1, wPath, MAX_PATH);
+	LARGE_INTEGER freq, start, end;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&start);
+
+	// ϊς݂DDS΂ǂݍ(~bvƃubNkς)
+	std::string cookedPath;
+	bool isCooked = m_useCooked && GetCookedTexturePath(fileName, cookedPath);
+	bool isFallback = false;
 
-	// t@Cʓǂݍ
 	DirectX::TexMetadata mdata;
 	DirectX::ScratchImage image;
-	if (strstr(fileName, ".tga"))
-		hr = DirectX::LoadFromTGAFile(wPath, &mdata, image);
-	else
-		hr = DirectX::LoadFromWICFile(wPath, DirectX::WIC_FLAGS::WIC_FLAGS_NONE, &mdata, image);
-	if (FAILED(hr)) {
-		return E_FAIL;
+	while (true)
+	{
+		// ϊ
+		wchar_t wPath[MAX_PATH];
+		MultiByteToWideChar(0, 0, isCooked ? cookedPath.c_str() : fileName, -1, wPath, MAX_PATH);
+
+		// t@Cʓǂݍ
+		if (isCooked)
+			hr = DirectX::LoadFromDDSFile(wPath, DirectX::DDS_FLAGS_NONE, &mdata, image);
+		else if (strstr(fileName, ".tga"))
+			hr = DirectX::LoadFromTGAFile(wPath, &mdata, image);
+		else
+			hr = DirectX::LoadFromWICFile(wPath, DirectX::WIC_FLAGS::WIC_FLAGS_NONE, &mdata, image);
+
+		// VF[_\[X
+		if (SUCCEEDED(hr))
+		{
+			hr = CreateShaderResourceView(GetDevice(), image.GetImages(), image.GetImageCount(), mdata, &m_pSRV);
+		}
+		if (SUCCEEDED(hr) || !isCooked) break;
+
+		// DDSĂAÂ`A4̔{łȂubNkȂǂŎgȂꍇ͌̉摜ǂݍݒ
+		std::string log = "Cooked texture rejected : " + cookedPath + "\n";
+		OutputDebugStringA(log.c_str());
+		SAFE_RELEASE(m_pSRV);
+		image.Release();
+		isCooked = false;
+		isFallback = true;
 	}
-
-	// VF[_\[X
-	hr = CreateShaderResourceView(GetDevice(), image.GetImages(), image.GetImageCount(), mdata, &m_pSRV);
 	if (SUCCEEDED(hr))
 	{
 		m_width = (UINT)mdata.width;
 		m_height = (UINT)mdata.height;
+		m_memorySize = image.GetPixelsSize();
 	}
-	return hr;
+
+	// vɋL^
+	QueryPerformanceCounter(&end);
+	double ms = static_cast<double>(end.QuadPart - start.QuadPart) * 1000.0 / static_cast<double>(freq.QuadPart);
+	{
+		std::lock_guard<std::mutex> lock(g_textureLoadMutex);
+		if (isFallback)
+		{
+			g_textureLoadStats.m_nCookedFallbackNum++;
+		}
+		if (FAILED(hr))
+		{
+			g_textureLoadStats.m_nFailNum++;
+		}
+		else if (isCooked)
+		{
+			g_textureLoadStats.m_nCookedNum++;
+			g_textureLoadStats.m_nCookedByte += m_memorySize;
+			g_textureLoadStats.m_dCookedMs += ms;
+		}
+		else
+		{
+			g_textureLoadStats.m_nSourceNum++;
+			g_textureLoadStats.m_nSourceByte += m_memorySize;
+			g_textureLoadStats.m_dSourceMs += ms;
+		}
+	}
+	return FAILED(hr) ? E_FAIL : hr;
 }
 
 /*************************//*
@@ -100,6 +163,43 @@ ID3D11ShaderResourceView* Texture::GetResource() const
 	return m_pSRV;
 }
 
+/*************************//*
+@brief  | eNX`̃ʂ擾
+@return | (oCgA~bv܂)
+*//*************************/
+size_t Texture::GetMemorySize() const
+{
+	return m_memorySize;
+}
+
+/*************************//*
+@brief		| ϊς݂DDSD悵ēǂݍނ̐ݒ
+@param[in]	| isUseFtrue:D悷 false:Ɍ̉摜ǂݍ
+*//*************************/
+void Texture::SetUseCooked(bool isUse)
+{
+	m_useCooked = isUse;
+}
+
+/*************************//*
+@brief  | ϊς݂DDSD悵ēǂݍނ
+@return | true:D悷 false:Ɍ̉摜ǂݍ
+*//*************************/
+bool Texture::IsUseCooked()
+{
+	return m_useCooked;
+}
+
+/*************************//*
+@brief  | t@C̃eNX`ǂݍ݂̓v擾
+@return | v(NĂ̗݌v)
+*//*************************/
+TextureLoadStats Texture::GetLoadStats()
+{
+	std::lock_guard<std::mutex> lock(g_textureLoadMutex);
+	return g_textureLoadStats;
+}
+
 /*************************//*
 @brief		| eNX`Lqq𐶐
 @param[in]	| formatFsNZtH[}bg
@@ -153,10 +253,34 @@ HRESULT Texture::CreateResource(D3D11_TEXTURE2D_DESC& desc, const void* pData)
 	{
 		m_width = desc.Width;
 		m_height = desc.Height;
+		m_memorySize = DirectX::BitsPerPixel(desc.Format) * desc.Width * desc.Height / 8;
 	}
 	return hr;
 }
 
+/*************************//*
+@brief		| ϊς݂DDS̃pX擾
+@param[in]	| fileNameF̉摜̃t@C
+@param[out]	| outPathFtH_Cooked/<O>.dds
+@return		| ̉摜VDDStrue
+@note		| DDSTools/TextureCookerō쐬
+*//*************************/
+bool GetCookedTexturePath(const char* fileName, std::string& outPath)
+{
+	std::string path = fileName;
+	size_t slash = path.find_last_of("/\\");
+	size_t nameTop = (slash == std::string::npos) ? 0 : slash + 1;
+	size_t dot = path.find_last_of('.');
+	if (dot == std::string::npos || dot < nameTop) dot = path.size();
+	outPath = path.substr(0, nameTop) + "Cooked/" + path.substr(nameTop, dot - nameTop) + ".dds";
+
+	// ̉摜XVĂDDS͌Â̂ŎgȂ
+	WIN32_FILE_ATTRIBUTE_DATA cooked, source;
+	if (!GetFileAttributesExA(outPath.c_str(), GetFileExInfoStandard, &cooked)) return false;
+	if (!GetFileAttributesExA(fileName, GetFileExInfoStandard, &source)) return true;
+	return CompareFileTime(&cooked.ftLastWriteTime, &source.ftLastWriteTime) >= 0;
+}
+
 /*************************//*
 @brief	| RXgN^
 *//*************************/
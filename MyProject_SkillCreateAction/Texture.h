@@ -5,6 +5,34 @@
 #pragma once
 #include "DirectX.h"
 
+// @brief t@C̃eNX`ǂݍ݂̓v
+struct TextureLoadStats
+{
+	// ̉摜(PNG)ǂݍ񂾐
+	int m_nSourceNum;
+
+	// ϊς݂DDSǂݍ񂾐
+	int m_nCookedNum;
+
+	// ǂݍ݂Ɏs
+	int m_nFailNum;
+
+	// ϊς݂DDSǂݍ߂Ả摜ǂݍݒ
+	int m_nCookedFallbackNum;
+
+	// ̉摜ǂݍ񂾃eNX`̃(oCg)
+	size_t m_nSourceByte;
+
+	// ϊς݂DDSǂݍ񂾃eNX`̃(oCgA~bv܂)
+	size_t m_nCookedByte;
+
+	// ̉摜̓ǂݍ݂ɂԂ̍v(~b)
+	double m_dSourceMs;
+
+	// ϊς݂DDS̓ǂݍ݂ɂԂ̍v(~b)
+	double m_dCookedMs;
+};
+
 // @brief eNX`NX
 class Texture
 {
@@ -18,6 +46,8 @@ public:
 	// @brief t@CeNX`𐶐
 	// @param[in] fileName t@C
 	// @return S_OK
+	// @note tH_Cooked/<O>.dds̉摜V΂ǂݍ
+	// (DDSǂݍ߂Ȃꍇ͌̉摜ǂݍ)
 	HRESULT Create(const char* fileName);
 
 	// @brief ̃eNX`𐶐
@@ -40,6 +70,22 @@ public:
 	// @return VF[_\[Xr[
 	ID3D11ShaderResourceView* GetResource() const;
 
+	// @brief eNX`̃ʂ擾
+	// @return (oCgA~bv܂)
+	size_t GetMemorySize() const;
+
+	// @brief ϊς݂DDSD悵ēǂݍނ̐ݒ
+	// @param[in] isUse true:D悷 false:Ɍ̉摜ǂݍ
+	static void SetUseCooked(bool isUse);
+
+	// @brief ϊς݂DDSD悵ēǂݍނ
+	// @return true:D悷 false:Ɍ̉摜ǂݍ
+	static bool IsUseCooked();
+
+	// @brief t@C̃eNX`ǂݍ݂̓v擾
+	// @return v(NĂ̗݌v)
+	static TextureLoadStats GetLoadStats();
+
 protected:
 	// @brief eNX`Lqq𐶐
 	// @param[in] format sNZtH[}bg
@@ -60,6 +106,12 @@ protected:
 	UINT m_height;
 	ID3D11ShaderResourceView *m_pSRV;
 	ID3D11Texture2D* m_pTex;
+
+	// eNX`̃(oCg)
+	size_t m_memorySize;
+
+	// ϊς݂DDSD悵ēǂݍނ
+	static bool m_useCooked;
 };
 
 // @brief _[^[Qbg
@@ -0,0 +1,286 @@
+/**************************************************//*
+	@file	| TextureAtlas.cpp
+	@brief	| テクスチャアトラスクラスのcppファイル
+	@note	| 小さいテクスチャを共有のページにまとめ、スプライト毎のテクスチャの切り替えを無くす
+			| 配置はCAtlasPackerで行い、ページの空き領域に後から追加できる
+			| シングルトンパターンで作成
+*//**************************************************/
+#include "TextureAtlas.h"
+#include "DirectXTex/TextureLoad.h"
+#include "Defines.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+/****************************************//*
+	@brief　	| コンストラクタ
+*//****************************************/
+CTextureAtlas::CTextureAtlas()
+	: m_tPacker(ce_nPageSize, ce_nPadding)
+	, m_pPageVec{}
+	, m_RegionMap{}
+	, m_tStats{}
+{
+}
+
+/****************************************//*
+	@brief　	| デストラクタ
+*//****************************************/
+CTextureAtlas::~CTextureAtlas()
+{
+	Clear();
+}
+
+/****************************************//*
+	@brief　	| アトラスに入れる大きさかどうか
+	@param　	| inWidth：横幅
+	@param　	| inHeight：縦幅
+	@return		| true:アトラスに入れる false:単独のテクスチャにする
+*//****************************************/
+bool CTextureAtlas::IsTarget(UINT inWidth, UINT inHeight)
+{
+	return inWidth > 0 && inHeight > 0 && inWidth <= ce_nMaxImageSize && inHeight <= ce_nMaxImageSize;
+}
+
+/****************************************//*
+	@brief　	| アトラスに入れる画像なら画素を読み込む
+	@param　	| inPath：画像ファイルのパス
+	@param　	| outImage：読み込んだ画像の格納先
+	@return		| true:読み込んだ false:アトラスの対象外か読み込めなかった
+	@note		| デバイスには触れないのでワーカースレッドから呼び出せる
+*//****************************************/
+bool CTextureAtlas::LoadPixels(const char* inPath, AtlasImage& outImage)
+{
+	// WICで読める画像だけを対象にする(tgaと変換済みのddsは単独のテクスチャにする)
+	if (strstr(inPath, ".tga") || strstr(inPath, ".dds")) return false;
+
+	wchar_t wPath[MAX_PATH];
+	MultiByteToWideChar(0, 0, inPath, -1, wPath, MAX_PATH);
+
+	// 先にヘッダーだけを読んで大きさを確認する
+	DirectX::TexMetadata tMeta;
+	if (FAILED(DirectX::GetMetadataFromWICFile(wPath, DirectX::WIC_FLAGS_IGNORE_SRGB, tMeta))) return false;
+	if (!IsTarget(static_cast<UINT>(tMeta.width), static_cast<UINT>(tMeta.height))) return false;
+
+	DirectX::ScratchImage tImage;
+	if (FAILED(DirectX::LoadFromWICFile(wPath, DirectX::WIC_FLAGS_IGNORE_SRGB, &tMeta, tImage))) return false;
+
+	// ページと同じ形式に揃える
+	const DirectX::Image* pImage = tImage.GetImage(0, 0, 0);
+	DirectX::ScratchImage tConvert;
+	if (tMeta.format != DXGI_FORMAT_R8G8B8A8_UNORM)
+	{
+		if (FAILED(DirectX::Convert(*pImage, DXGI_FORMAT_R8G8B8A8_UNORM, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, tConvert))) return false;
+		pImage = tConvert.GetImage(0, 0, 0);
+	}
+
+	outImage.m_nWidth = static_cast<UINT>(pImage->width);
+	outImage.m_nHeight = static_cast<UINT>(pImage->height);
+	outImage.m_PixelVec.resize(static_cast<size_t>(outImage.m_nWidth) * outImage.m_nHeight * 4);
+	for (UINT y = 0; y < outImage.m_nHeight; y++)
+	{
+		memcpy(&outImage.m_PixelVec[static_cast<size_t>(y) * outImage.m_nWidth * 4], pImage->pixels + y * pImage->rowPitch, outImage.m_nWidth * 4);
+	}
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 複数の画像をまとめてページに追加する
+	@param　	| inImageVec：追加する画像
+	@param　	| outRegionVec：追加した領域(inImageVecと同じ順)
+	@return		| 追加できた数
+	@note		| 同じキーが追加済みならその領域を返す
+*//****************************************/
+int CTextureAtlas::Add(const std::vector<const AtlasImage*>& inImageVec, std::vector<AtlasRegion>& outRegionVec)
+{
+	outRegionVec.assign(inImageVec.size(), AtlasRegion{ nullptr, DirectX::XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f) });
+
+	// 追加済みのものを除いて配置する(まとめて配置した方が高さ順に並べられるので詰まる)
+	int nAddNum = 0;
+	std::vector<size_t> nPackIndexVec;
+	std::vector<std::pair<uint32_t, uint32_t>> tSizeVec;
+	for (size_t i = 0; i < inImageVec.size(); i++)
+	{
+		if (Find(inImageVec[i]->m_sKey, outRegionVec[i]))
+		{
+			nAddNum++;
+			continue;
+		}
+		nPackIndexVec.push_back(i);
+		tSizeVec.push_back({ inImageVec[i]->m_nWidth, inImageVec[i]->m_nHeight });
+	}
+	if (tSizeVec.empty()) return nAddNum;
+
+	std::vector<AtlasPlacement> tPlacementVec;
+	m_tPacker.Pack(tSizeVec, tPlacementVec);
+
+	for (size_t i = 0; i < tPlacementVec.size(); i++)
+	{
+		const AtlasPlacement& tPlacement = tPlacementVec[i];
+		if (!tPlacement.m_bValid) continue;
+
+		// 配置に合わせてページを作成する
+		while (static_cast<int>(m_pPageVec.size()) <= tPlacement.m_nPage)
+		{
+			AtlasPage* pPage = new(std::nothrow) AtlasPage();
+			if (!pPage || FAILED(pPage->Create(DXGI_FORMAT_R8G8B8A8_UNORM, ce_nPageSize, ce_nPageSize)))
+			{
+				SAFE_DELETE(pPage);
+				MessageBox(NULL, "CreateFailed:AtlasPage", "Error:TextureAtlas.cpp", MB_OK);
+				return nAddNum;
+			}
+			m_pPageVec.push_back(pPage);
+			m_tStats.m_nMemorySize += pPage->GetMemorySize();
+		}
+
+		const AtlasImage& tImage = *inImageVec[nPackIndexVec[i]];
+		AtlasPage* pPage = m_pPageVec[tPlacement.m_nPage];
+		Upload(pPage, tImage, tPlacement.m_nX, tPlacement.m_nY);
+
+		AtlasRegion tRegion;
+		tRegion.m_pPage = pPage;
+		tRegion.m_f4UVRect = DirectX::XMFLOAT4(
+			static_cast<float>(tPlacement.m_nX) / ce_nPageSize, static_cast<float>(tPlacement.m_nY) / ce_nPageSize,
+			static_cast<float>(tImage.m_nWidth) / ce_nPageSize, static_cast<float>(tImage.m_nHeight) / ce_nPageSize);
+		m_RegionMap.emplace(tImage.m_sKey, tRegion);
+		outRegionVec[nPackIndexVec[i]] = tRegion;
+		nAddNum++;
+	}
+
+	m_tStats.m_nPageNum = static_cast<int>(m_pPageVec.size());
+	m_tStats.m_nImageNum = static_cast<int>(m_RegionMap.size());
+	m_tStats.m_fUtilization = m_tPacker.GetUtilization();
+	return nAddNum;
+}
+
+/****************************************//*
+	@brief　	| 追加済みの領域を検索する
+	@param　	| inKey：登録キー
+	@param　	| outRegion：領域の格納先
+	@return		| true:見つかった false:追加されていない
+*//****************************************/
+bool CTextureAtlas::Find(const std::string& inKey, AtlasRegion& outRegion) const
+{
+	auto itr = m_RegionMap.find(inKey);
+	if (itr == m_RegionMap.end()) return false;
+
+	outRegion = itr->second;
+	return true;
+}
+
+/****************************************//*
+	@brief　	| 全てのページを破棄する
+*//****************************************/
+void CTextureAtlas::Clear()
+{
+	for (AtlasPage* pPage : m_pPageVec)
+	{
+		SAFE_DELETE(pPage);
+	}
+	m_pPageVec.clear();
+	m_RegionMap.clear();
+	m_tPacker.Clear();
+	m_tStats = {};
+}
+
+/****************************************//*
+	@brief　	| テクスチャフォルダの画像でページの使用率を計測する
+	@param　	| inReportPath：結果を書き出すファイルのパス
+	@return		| 0:成功 1:失敗
+	@note		| 配置の計算だけを行うのでデバイスを作成せずに実行できる
+*//****************************************/
+int CTextureAtlas::MeasurePacking(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport)
+	{
+		MessageBox(NULL, inReportPath, "Error:TextureAtlas.cpp", MB_OK);
+		return 1;
+	}
+
+	// 計測結果を1行書き出す
+	auto Write = [&tReport](const char* inName, const CAtlasPacker& inPacker)
+	{
+		const AtlasPackerStats& tStats = inPacker.GetStats();
+		char szLine[256];
+		sprintf_s(szLine, "%s: rect %d  fail %d  page %d  utilization %.2f%%  (padded %.2f%%)\n",
+			inName, tStats.m_nRectNum, tStats.m_nFailNum, tStats.m_nPageNum, inPacker.GetUtilization() * 100.0f,
+			tStats.m_nPageNum > 0 ? 100.0 * tStats.m_ulPaddedArea / (static_cast<double>(inPacker.GetPageSize()) * inPacker.GetPageSize() * tStats.m_nPageNum) : 0.0);
+		tReport << szLine;
+	};
+
+	// テクスチャフォルダの画像(ヘッダーだけを読んで大きさを集める)
+	std::vector<std::pair<uint32_t, uint32_t>> tSizeVec;
+	std::error_code ec;
+	for (const auto& entry : std::filesystem::directory_iterator(TEXTURE_PATH(""), ec))
+	{
+		if (!entry.is_regular_file()) continue;
+
+		DirectX::TexMetadata tMeta;
+		if (FAILED(DirectX::GetMetadataFromWICFile(entry.path().wstring().c_str(), DirectX::WIC_FLAGS_NONE, tMeta))) continue;
+		if (!IsTarget(static_cast<UINT>(tMeta.width), static_cast<UINT>(tMeta.height))) continue;
+		tSizeVec.push_back({ static_cast<uint32_t>(tMeta.width), static_cast<uint32_t>(tMeta.height) });
+	}
+	CAtlasPacker tTexturePacker(ce_nPageSize, ce_nPadding);
+	std::vector<AtlasPlacement> tPlacementVec;
+	tTexturePacker.Pack(tSizeVec, tPlacementVec);
+	Write("Texture", tTexturePacker);
+
+	// UIが増えた場合の想定(16～128ピクセルの矩形256個、乱数は固定)
+	std::mt19937 tRandom(1234);
+	std::uniform_int_distribution<uint32_t> tDist(16, 128);
+	tSizeVec.clear();
+	for (int i = 0; i < 256; i++) tSizeVec.push_back({ tDist(tRandom), tDist(tRandom) });
+
+	CAtlasPacker tBatchPacker(ce_nPageSize, ce_nPadding);
+	tBatchPacker.Pack(tSizeVec, tPlacementVec);
+	Write("Synthetic(batch)", tBatchPacker);
+
+	// 実行中に1つずつ追加した場合(並べ替えられない分だけ詰まりが悪くなる)
+	CAtlasPacker tRuntimePacker(ce_nPageSize, ce_nPadding);
+	for (const auto& tSize : tSizeVec) tRuntimePacker.Pack(tSize.first, tSize.second);
+	Write("Synthetic(runtime)", tRuntimePacker);
+
+	return 0;
+}
+
+/****************************************//*
+	@brief　	| 余白を端の画素で埋めてページに書き込む
+	@param　	| pPage：書き込むページ
+	@param　	| inImage：画像
+	@param　	| inX：画像の左上のX座標(余白を除く)
+	@param　	| inY：画像の左上のY座標(余白を除く)
+*//****************************************/
+void CTextureAtlas::Upload(AtlasPage* pPage, const AtlasImage& inImage, UINT inX, UINT inY)
+{
+	UINT nWidth = inImage.m_nWidth + ce_nPadding * 2;
+	UINT nHeight = inImage.m_nHeight + ce_nPadding * 2;
+	std::vector<uint8_t> tPixelVec(static_cast<size_t>(nWidth) * nHeight * 4);
+	for (UINT y = 0; y < nHeight; y++)
+	{
+		UINT nSrcY = static_cast<UINT>((std::min)((std::max)(static_cast<int>(y) - static_cast<int>(ce_nPadding), 0), static_cast<int>(inImage.m_nHeight) - 1));
+		for (UINT x = 0; x < nWidth; x++)
+		{
+			UINT nSrcX = static_cast<UINT>((std::min)((std::max)(static_cast<int>(x) - static_cast<int>(ce_nPadding), 0), static_cast<int>(inImage.m_nWidth) - 1));
+			memcpy(&tPixelVec[(static_cast<size_t>(y) * nWidth + x) * 4], &inImage.m_PixelVec[(static_cast<size_t>(nSrcY) * inImage.m_nWidth + nSrcX) * 4], 4);
+		}
+	}
+
+	pPage->Update(inX - ce_nPadding, inY - ce_nPadding, nWidth, nHeight, tPixelVec.data());
+	m_tStats.m_nUploadNum++;
+}
+
+/****************************************//*
+	@brief　	| 領域に画素を書き込む
+	@param　	| inX：左上のX座標
+	@param　	| inY：左上のY座標
+	@param　	| inWidth：横幅
+	@param　	| inHeight：縦幅
+	@param　	| pPixel：画素(R8G8B8A8)
+*//****************************************/
+void CTextureAtlas::AtlasPage::Update(UINT inX, UINT inY, UINT inWidth, UINT inHeight, const void* pPixel)
+{
+	D3D11_BOX tBox = { inX, inY, 0, inX + inWidth, inY + inHeight, 1 };
+	GetContext()->UpdateSubresource(m_pTex, 0, &tBox, pPixel, inWidth * 4, 0);
+}
@@ -0,0 +1,154 @@
+/**************************************************//*
+	@file	| TextureAtlas.h
+	@brief	| テクスチャアトラスクラスのhファイル
+	@note	| 小さいテクスチャを共有のページにまとめ、スプライト毎のテクスチャの切り替えを無くす
+			| 配置はCAtlasPackerで行い、ページの空き領域に後から追加できる
+			| シングルトンパターンで作成
+*//**************************************************/
+#pragma once
+#include "Singleton.h"
+#include "AtlasPacker.h"
+#include "Texture.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// @brief アトラスに追加する画像
+struct AtlasImage
+{
+	// 登録キー
+	std::string m_sKey;
+
+	// 横幅
+	UINT m_nWidth;
+
+	// 縦幅
+	UINT m_nHeight;
+
+	// 画素(R8G8B8A8、左上から行単位)
+	std::vector<uint8_t> m_PixelVec;
+};
+
+// @brief アトラス内の領域
+struct AtlasRegion
+{
+	// 領域のあるページのテクスチャ(追加できなかった場合はnullptr)
+	Texture* m_pPage;
+
+	// ページ内のUV(xyが左上、zwが大きさ)
+	DirectX::XMFLOAT4 m_f4UVRect;
+};
+
+// @brief テクスチャアトラスの統計情報
+struct TextureAtlasStats
+{
+	// ページ数
+	int m_nPageNum;
+
+	// 追加した画像の数
+	int m_nImageNum;
+
+	// ページへの書き込み回数
+	int m_nUploadNum;
+
+	// ページの使用率(余白を除いた画像の面積÷ページの面積の合計)
+	float m_fUtilization;
+
+	// ページのメモリ量(バイト)
+	size_t m_nMemorySize;
+};
+
+// @brief テクスチャアトラスクラス
+class CTextureAtlas : public ISingleton<CTextureAtlas>
+{
+private:
+	// @brief コンストラクタ
+	CTextureAtlas();
+
+	friend class ISingleton<CTextureAtlas>;
+public:
+	// @brief デストラクタ
+	~CTextureAtlas();
+
+	// @brief アトラスに入れる大きさかどうか
+	// @param inWidth：横幅
+	// @param inHeight：縦幅
+	// @return true:アトラスに入れる false:単独のテクスチャにする
+	static bool IsTarget(UINT inWidth, UINT inHeight);
+
+	// @brief アトラスに入れる画像なら画素を読み込む
+	// @param inPath：画像ファイルのパス
+	// @param outImage：読み込んだ画像の格納先
+	// @return true:読み込んだ false:アトラスの対象外か読み込めなかった
+	// @note デバイスには触れないのでワーカースレッドから呼び出せる
+	static bool LoadPixels(const char* inPath, AtlasImage& outImage);
+
+	// @brief 複数の画像をまとめてページに追加する
+	// @param inImageVec：追加する画像
+	// @param outRegionVec：追加した領域(inImageVecと同じ順)
+	// @return 追加できた数
+	// @note 同じキーが追加済みならその領域を返す
+	int Add(const std::vector<const AtlasImage*>& inImageVec, std::vector<AtlasRegion>& outRegionVec);
+
+	// @brief 追加済みの領域を検索する
+	// @param inKey：登録キー
+	// @param outRegion：領域の格納先
+	// @return true:見つかった false:追加されていない
+	bool Find(const std::string& inKey, AtlasRegion& outRegion) const;
+
+	// @brief 全てのページを破棄する
+	void Clear();
+
+	// @brief 統計情報の取得
+	// @return 統計情報
+	const TextureAtlasStats& GetStats() const { return m_tStats; }
+
+	// @brief テクスチャフォルダの画像でページの使用率を計測する
+	// @param inReportPath：結果を書き出すファイルのパス
+	// @return 0:成功 1:失敗
+	// @note 配置の計算だけを行うのでデバイスを作成せずに実行できる
+	static int MeasurePacking(const char* inReportPath);
+
+private:
+	// @brief ページ用のテクスチャ
+	class AtlasPage : public Texture
+	{
+	public:
+		// @brief 領域に画素を書き込む
+		// @param inX：左上のX座標
+		// @param inY：左上のY座標
+		// @param inWidth：横幅
+		// @param inHeight：縦幅
+		// @param pPixel：画素(R8G8B8A8)
+		void Update(UINT inX, UINT inY, UINT inWidth, UINT inHeight, const void* pPixel);
+	};
+
+	// @brief 余白を端の画素で埋めてページに書き込む
+	// @param pPage：書き込むページ
+	// @param inImage：画像
+	// @param inX：画像の左上のX座標(余白を除く)
+	// @param inY：画像の左上のY座標(余白を除く)
+	void Upload(AtlasPage* pPage, const AtlasImage& inImage, UINT inX, UINT inY);
+
+private:
+	// @brief ページの1辺の大きさ(ピクセル)
+	static constexpr UINT ce_nPageSize = 1024;
+
+	// @brief アトラスに入れる画像の1辺の最大(ピクセル)
+	static constexpr UINT ce_nMaxImageSize = 256;
+
+	// @brief 画像の周囲の余白(線形補間で隣の画像がにじまないように端の画素で埋める)
+	static constexpr UINT ce_nPadding = 2;
+
+	// @brief 矩形の配置
+	CAtlasPacker m_tPacker;
+
+	// @brief ページ
+	std::vector<AtlasPage*> m_pPageVec;
+
+	// @brief 登録キーをキーにした領域のマップ
+	std::unordered_map<std::string, AtlasRegion> m_RegionMap;
+
+	// @brief 統計情報
+	TextureAtlasStats m_tStats;
+};
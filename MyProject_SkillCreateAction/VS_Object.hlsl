@@ -1,9 +1,39 @@
+// 機能の定義(シェーダーキャッシュがバリエーション毎に0か1を指定する)
+#ifndef SKINNING
+#define SKINNING 0
+#endif
+#ifndef MORPH
+#define MORPH 0
+#endif
+#ifndef INSTANCING
+#define INSTANCING 0
+#endif
+
+// ボーンの最大数
+#define MAX_BONE 64
+
 struct VS_IN
 {
     float3 pos : POSITION;
-    float3 normal : NORMAL0;
+    float2 normal : NORMAL0; // 八面体エンコードされた法線
     float2 uv : TEXCOORD0;
     float4 color : COLOR0;
+#if SKINNING
+    uint4 boneIndex : BLENDINDICES0;
+    float4 boneWeight : BLENDWEIGHT0;
+#endif
+#if MORPH
+    float3 morphPos : POSITION1; // モーフターゲットとの座標の差分
+    float3 morphNormal : NORMAL1; // モーフターゲットとの法線の差分
+#endif
+#if INSTANCING
+    // インスタンス毎のワールド行列(各行)と色
+    float4 world0 : WORLD0;
+    float4 world1 : WORLD1;
+    float4 world2 : WORLD2;
+    float4 world3 : WORLD3;
+    float4 instColor : COLOR1;
+#endif
 };
 struct VS_OUT
 {
@@ -13,22 +43,70 @@ struct VS_OUT
     float4 color : COLOR0;
     float4 wPos : POSITION0;
 };
+#if INSTANCING
+cbuffer VP : register(b0)
+{
+    float4x4 view;
+    float4x4 proj;
+};
+#else
 cbuffer WVP : register(b0)
 {
     float4x4 world;
     float4x4 view;
     float4x4 proj;
+    float4 objColor;
 };
+#endif
+#if SKINNING
+cbuffer Bone : register(b1)
+{
+    float4x4 bone[MAX_BONE];
+};
+#endif
+#if MORPH
+cbuffer Morph : register(b2)
+{
+    float4 morphWeight; // xにモーフターゲットの重み
+};
+#endif
+// 八面体エンコードされた法線を展開する
+float3 DecodeOctNormal(float2 e)
+{
+    float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += n.xy >= 0.0f ? -t : t;
+    return normalize(n);
+}
 VS_OUT main(VS_IN vin)
 {
     VS_OUT vout;
-    vout.pos = float4(vin.pos, 1.0f);
+#if INSTANCING
+    float4x4 world = float4x4(vin.world0, vin.world1, vin.world2, vin.world3);
+    float4 objColor = vin.instColor;
+#endif
+    float3 localPos = vin.pos;
+    float3 localNormal = DecodeOctNormal(vin.normal);
+#if MORPH
+    localPos += vin.morphPos * morphWeight.x;
+    localNormal = normalize(localNormal + vin.morphNormal * morphWeight.x);
+#endif
+#if SKINNING
+    float4x4 skin =
+        bone[vin.boneIndex.x] * vin.boneWeight.x +
+        bone[vin.boneIndex.y] * vin.boneWeight.y +
+        bone[vin.boneIndex.z] * vin.boneWeight.z +
+        bone[vin.boneIndex.w] * vin.boneWeight.w;
+    localPos = mul(float4(localPos, 1.0f), skin).xyz;
+    localNormal = mul(localNormal, (float3x3) skin);
+#endif
+    vout.pos = float4(localPos, 1.0f);
     vout.pos = mul(vout.pos, world);
     vout.wPos = vout.pos;
     vout.pos = mul(vout.pos, view);
     vout.pos = mul(vout.pos, proj);
-    vout.normal = mul(vin.normal, (float3x3) world);
+    vout.normal = mul(localNormal, (float3x3) world);
     vout.uv = vin.uv;
-    vout.color = vin.color;
+    vout.color = vin.color * objColor;
     return vout;
 }
@@ -0,0 +1,25 @@
+struct VS_IN
+{
+    float4 pos : POSITION0;
+    float2 uv : TEXCOORD0;
+    float4 color : COLOR0;
+};
+
+struct VS_OUT
+{
+    float4 pos : SV_POSITION;
+    float3 normal : NORMAL0;
+    float2 uv : TEXCOORD0;
+    float4 color : COLOR0;
+};
+
+// 座標変換はCPU側(SpriteBatch)で済ませているのでそのまま出力する
+VS_OUT main(VS_IN vin)
+{
+    VS_OUT vout;
+    vout.pos = vin.pos;
+    vout.normal = float3(0.0f, 0.0f, -1.0f);
+    vout.uv = vin.uv;
+    vout.color = vin.color;
+    return vout;
+}
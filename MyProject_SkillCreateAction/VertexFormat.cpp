@@ -0,0 +1,587 @@
+/**************************************************//*
+	@file	| VertexFormat.cpp
+	@brief	| 圧縮頂点フォーマットのcppファイル
+	@note	| モデルの頂点をメッシュ毎に必要な要素だけの量子化した形式で扱う
+*//**************************************************/
+#include "VertexFormat.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include <fstream>
+
+// 静的変数の初期化
+ID3D11Buffer* VertexFormat::m_pWhiteColor = nullptr;
+
+namespace
+{
+	// 座標・法線・UVのオフセット(全レイアウト共通)
+	const UINT ce_nPosOffset = 0;
+	const UINT ce_nNormalOffset = 12;
+	const UINT ce_nUVOffset = 16;
+
+	// レイアウト毎の情報
+	const VertexLayoutInfo ce_tLayoutInfo[(int)VertexLayout::MAX] =
+	{
+		{ 20, -1, -1, -1 },	// Static
+		{ 24, 20, -1, -1 },	// StaticColor
+		{ 28, -1, 20, 24 },	// Skinned
+		{ 32, 20, 24, 28 },	// SkinnedColor
+	};
+
+	/****************************************//*
+		@brief　	| 0～1の値を8bitに量子化
+		@param　	| value：量子化する値
+		@return　	| 量子化結果
+	*//****************************************/
+	uint8_t EncodeUnorm8(float value)
+	{
+		value = (std::min)((std::max)(value, 0.0f), 1.0f);
+		return static_cast<uint8_t>(value * 255.0f + 0.5f);
+	}
+
+	/****************************************//*
+		@brief　	| -1～1の値を16bitに量子化
+		@param　	| value：量子化する値
+		@return　	| 量子化結果
+	*//****************************************/
+	int16_t EncodeSnorm16(float value)
+	{
+		value = (std::min)((std::max)(value, -1.0f), 1.0f);
+		return static_cast<int16_t>(std::lround(value * 32767.0f));
+	}
+}
+
+/****************************************//*
+	@brief　	| 初期化
+	@note		| 色を持たないレイアウト用の白色ストリームを作成する
+*//****************************************/
+void VertexFormat::Init()
+{
+	const uint32_t nWhite = 0xffffffff;
+
+	D3D11_BUFFER_DESC bufDesc = {};
+	bufDesc.ByteWidth = sizeof(nWhite);
+	bufDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	bufDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+	D3D11_SUBRESOURCE_DATA subResource = {};
+	subResource.pSysMem = &nWhite;
+
+	GetDevice()->CreateBuffer(&bufDesc, &subResource, &m_pWhiteColor);
+}
+
+/****************************************//*
+	@brief　	| 終了
+*//****************************************/
+void VertexFormat::Uninit()
+{
+	SAFE_RELEASE(m_pWhiteColor);
+}
+
+/****************************************//*
+	@brief　	| レイアウトの情報を取得
+	@param　	| layout：頂点レイアウト
+	@return　	| レイアウトの情報
+*//****************************************/
+const VertexLayoutInfo& VertexFormat::GetInfo(VertexLayout layout)
+{
+	return ce_tLayoutInfo[(int)layout];
+}
+
+/****************************************//*
+	@brief　	| 入力レイアウトの要素を取得
+	@param　	| layout：頂点レイアウト
+	@param　	| out：要素の格納先
+	@param　	| isInstanced：インスタンス毎のワールド行列と色(スロット2)を追加するか
+*//****************************************/
+void VertexFormat::GetInputElements(VertexLayout layout, std::vector<D3D11_INPUT_ELEMENT_DESC>& out, bool isInstanced)
+{
+	const VertexLayoutInfo& info = GetInfo(layout);
+
+	out.clear();
+	out.push_back({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, ce_nPosOffset, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+	out.push_back({ "NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, ce_nNormalOffset, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+	out.push_back({ "TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, ce_nUVOffset, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+
+	// 色を持たない場合はストライド0の白色ストリーム(スロット1)から読む
+	if (info.m_nColorOffset >= 0)
+		out.push_back({ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, (UINT)info.m_nColorOffset, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+	else
+		out.push_back({ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+
+	if (info.m_nWeightOffset >= 0)
+		out.push_back({ "BLENDWEIGHT", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, (UINT)info.m_nWeightOffset, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+	if (info.m_nIndexOffset >= 0)
+		out.push_back({ "BLENDINDICES", 0, DXGI_FORMAT_R8G8B8A8_UINT, 0, (UINT)info.m_nIndexOffset, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+
+	// インスタンス描画ではワールド行列の各行と色をスロット2からインスタンス毎に読む
+	if (isInstanced)
+	{
+		for (UINT i = 0; i < 4; ++i)
+			out.push_back({ "WORLD", i, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, i * 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 });
+		out.push_back({ "COLOR", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, 64, D3D11_INPUT_PER_INSTANCE_DATA, 1 });
+	}
+}
+
+/****************************************//*
+	@brief　	| 色を持たないレイアウトのために白色ストリームを設定
+	@param　	| layout：頂点レイアウト
+*//****************************************/
+void VertexFormat::BindColorStream(VertexLayout layout)
+{
+	if (GetInfo(layout).m_nColorOffset >= 0) return;
+
+	UINT stride = 0;
+	UINT offset = 0;
+	GetContext()->IASetVertexBuffers(1, 1, &m_pWhiteColor, &stride, &offset);
+}
+
+/****************************************//*
+	@brief　	| 頂点を圧縮して書き込む
+	@param　	| layout：頂点レイアウト
+	@param　	| in：圧縮前の頂点要素
+	@param　	| pDst：書き込み先(レイアウトのストライド分の領域)
+*//****************************************/
+void VertexFormat::Pack(VertexLayout layout, const VertexAttribute& in, void* pDst)
+{
+	const VertexLayoutInfo& info = GetInfo(layout);
+	uint8_t* pData = static_cast<uint8_t*>(pDst);
+
+	// 座標はそのまま
+	std::memcpy(pData + ce_nPosOffset, in.m_fPos, sizeof(float) * 3);
+
+	// 法線
+	int16_t normal[2];
+	EncodeOctNormal(in.m_fNormal, normal);
+	std::memcpy(pData + ce_nNormalOffset, normal, sizeof(normal));
+
+	// UV
+	uint16_t uv[2] = { FloatToHalf(in.m_fUV[0]), FloatToHalf(in.m_fUV[1]) };
+	std::memcpy(pData + ce_nUVOffset, uv, sizeof(uv));
+
+	// 色
+	if (info.m_nColorOffset >= 0)
+	{
+		for (int i = 0; i < 4; ++i) pData[info.m_nColorOffset + i] = EncodeUnorm8(in.m_fColor[i]);
+	}
+
+	// ウェイト
+	if (info.m_nWeightOffset >= 0)
+	{
+		EncodeWeights(in.m_fWeight, pData + info.m_nWeightOffset);
+	}
+
+	// ボーン番号
+	if (info.m_nIndexOffset >= 0)
+	{
+		for (int i = 0; i < 4; ++i) pData[info.m_nIndexOffset + i] = static_cast<uint8_t>((std::min)(in.m_nIndex[i], 255u));
+	}
+}
+
+/****************************************//*
+	@brief　	| 圧縮された頂点を展開する
+	@param　	| layout：頂点レイアウト
+	@param　	| pSrc：圧縮された頂点
+	@param　	| out：展開先(レイアウトに無い要素は既定値)
+*//****************************************/
+void VertexFormat::Unpack(VertexLayout layout, const void* pSrc, VertexAttribute& out)
+{
+	const VertexLayoutInfo& info = GetInfo(layout);
+	const uint8_t* pData = static_cast<const uint8_t*>(pSrc);
+
+	out = {};
+	std::memcpy(out.m_fPos, pData + ce_nPosOffset, sizeof(float) * 3);
+
+	int16_t normal[2];
+	std::memcpy(normal, pData + ce_nNormalOffset, sizeof(normal));
+	DecodeOctNormal(normal, out.m_fNormal);
+
+	uint16_t uv[2];
+	std::memcpy(uv, pData + ce_nUVOffset, sizeof(uv));
+	out.m_fUV[0] = HalfToFloat(uv[0]);
+	out.m_fUV[1] = HalfToFloat(uv[1]);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		out.m_fColor[i] = info.m_nColorOffset >= 0 ? pData[info.m_nColorOffset + i] / 255.0f : 1.0f;
+		out.m_fWeight[i] = info.m_nWeightOffset >= 0 ? pData[info.m_nWeightOffset + i] / 255.0f : 0.0f;
+		out.m_nIndex[i] = info.m_nIndexOffset >= 0 ? pData[info.m_nIndexOffset + i] : 0;
+	}
+}
+
+/****************************************//*
+	@brief　	| 法線を八面体エンコードする
+	@param　	| normal：正規化された法線
+	@param　	| out：エンコード結果(snorm16)
+*//****************************************/
+void VertexFormat::EncodeOctNormal(const float normal[3], int16_t out[2])
+{
+	float fLen = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+	if (fLen <= 0.0f)
+	{
+		// 法線が無い場合は+Z方向とする
+		out[0] = out[1] = 0;
+		return;
+	}
+
+	// 八面体へ投影
+	float x = normal[0] / fLen;
+	float y = normal[1] / fLen;
+
+	// 下半分は折り返す
+	if (normal[2] < 0.0f)
+	{
+		float fx = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		float fy = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+		x = fx;
+		y = fy;
+	}
+
+	out[0] = EncodeSnorm16(x);
+	out[1] = EncodeSnorm16(y);
+}
+
+/****************************************//*
+	@brief　	| 八面体エンコードされた法線を展開する
+	@param　	| in：エンコードされた法線(snorm16)
+	@param　	| out：正規化された法線
+	@note		| VS_Object.hlslのDecodeOctNormalと同じ計算
+*//****************************************/
+void VertexFormat::DecodeOctNormal(const int16_t in[2], float out[3])
+{
+	float x = (std::max)(in[0] / 32767.0f, -1.0f);
+	float y = (std::max)(in[1] / 32767.0f, -1.0f);
+	float z = 1.0f - std::fabs(x) - std::fabs(y);
+
+	// 折り返した下半分を戻す
+	float t = (std::max)(-z, 0.0f);
+	x += x >= 0.0f ? -t : t;
+	y += y >= 0.0f ? -t : t;
+
+	float fLen = std::sqrt(x * x + y * y + z * z);
+	out[0] = x / fLen;
+	out[1] = y / fLen;
+	out[2] = z / fLen;
+}
+
+/****************************************//*
+	@brief　	| 単精度浮動小数を半精度に変換
+	@param　	| value：変換する値
+	@return　	| 半精度浮動小数のビット列
+*//****************************************/
+uint16_t VertexFormat::FloatToHalf(float value)
+{
+	uint32_t nBits;
+	std::memcpy(&nBits, &value, sizeof(nBits));
+
+	uint32_t nSign = (nBits >> 16) & 0x8000;
+	uint32_t nAbs = nBits & 0x7fffffff;
+
+	// NaN・無限大
+	if (nAbs >= 0x7f800000)
+	{
+		return static_cast<uint16_t>(nSign | 0x7c00 | (nAbs > 0x7f800000 ? 0x200 : 0));
+	}
+
+	// 半精度の最大値を超える場合は無限大
+	if (nAbs >= 0x477ff000)
+	{
+		return static_cast<uint16_t>(nSign | 0x7c00);
+	}
+
+	// 非正規化数
+	if (nAbs < 0x38800000)
+	{
+		uint32_t nMantissa = (nAbs & 0x007fffff) | 0x00800000;
+		int nShift = 126 - static_cast<int>(nAbs >> 23);
+		if (nShift > 24) return static_cast<uint16_t>(nSign);
+
+		uint32_t nHalf = nMantissa >> nShift;
+		uint32_t nRound = nMantissa & ((1u << nShift) - 1);
+		uint32_t nHalfway = 1u << (nShift - 1);
+		if (nRound > nHalfway || (nRound == nHalfway && (nHalf & 1))) ++nHalf;
+		return static_cast<uint16_t>(nSign | nHalf);
+	}
+
+	// 正規化数(最近接偶数丸め)
+	uint32_t nHalf = ((nAbs - 0x38000000) >> 13);
+	uint32_t nRound = nAbs & 0x1fff;
+	if (nRound > 0x1000 || (nRound == 0x1000 && (nHalf & 1))) ++nHalf;
+	return static_cast<uint16_t>(nSign | nHalf);
+}
+
+/****************************************//*
+	@brief　	| 半精度浮動小数を単精度に変換
+	@param　	| value：半精度浮動小数のビット列
+	@return　	| 変換した値
+*//****************************************/
+float VertexFormat::HalfToFloat(uint16_t value)
+{
+	uint32_t nSign = static_cast<uint32_t>(value & 0x8000) << 16;
+	uint32_t nExp = (value >> 10) & 0x1f;
+	uint32_t nMantissa = value & 0x3ff;
+
+	uint32_t nBits;
+	if (nExp == 0)
+	{
+		if (nMantissa == 0)
+		{
+			// ゼロ
+			nBits = nSign;
+		}
+		else
+		{
+			// 非正規化数を正規化する
+			int e = -1;
+			do { ++e; nMantissa <<= 1; } while ((nMantissa & 0x400) == 0);
+			nBits = nSign | ((112 - e) << 23) | ((nMantissa & 0x3ff) << 13);
+		}
+	}
+	else if (nExp == 0x1f)
+	{
+		// NaN・無限大
+		nBits = nSign | 0x7f800000 | (nMantissa << 13);
+	}
+	else
+	{
+		nBits = nSign | ((nExp + 112) << 23) | (nMantissa << 13);
+	}
+
+	float fResult;
+	std::memcpy(&fResult, &nBits, sizeof(fResult));
+	return fResult;
+}
+
+/****************************************//*
+	@brief　	| ウェイトを合計が255になるよう8bitに量子化する
+	@param　	| weight：ウェイト
+	@param　	| out：量子化結果
+*//****************************************/
+void VertexFormat::EncodeWeights(const float weight[4], uint8_t out[4])
+{
+	int nSum = 0;
+	int nMax = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		out[i] = EncodeUnorm8(weight[i]);
+		nSum += out[i];
+		if (out[i] > out[nMax]) nMax = i;
+	}
+
+	// 丸め誤差は一番大きいウェイトで吸収する
+	if (nSum > 0 && nSum != 255)
+	{
+		out[nMax] = static_cast<uint8_t>((std::min)((std::max)(out[nMax] + 255 - nSum, 0), 255));
+	}
+}
+
+/****************************************//*
+	@brief　	| 圧縮・展開の精度を計測してファイルに書き出す
+	@param　	| inReportPath：書き出すファイルのパス
+	@return　	| 0:全ての精度が許容範囲内 1:範囲外の項目がある
+	@note		| 法線：球面上に均等に並べた方向と、軸・折り返しの境目を往復させた角度の誤差
+				| UV：全ての半精度の値が往復で変わらないことと、-2～4の相対誤差
+				| ウェイト・ボーン番号・色：全レイアウトでのPack/Unpackの往復
+*//****************************************/
+int VertexFormat::MeasureAccuracy(const char* inReportPath)
+{
+	std::ofstream tReport(inReportPath);
+	if (!tReport) return 1;
+
+	static constexpr int ce_nNormalNum = 100000;
+	static constexpr int ce_nUVNum = 100000;
+	static constexpr int ce_nVertexNum = 20000;
+	static constexpr float ce_fMaxNormalDegree = 0.01f;
+	static constexpr float ce_fMaxUVRelative = 1.0f / 2048.0f;
+	static constexpr float ce_fMinHalfStep = 1.0f / 16777216.0f;
+	static constexpr float ce_fMaxWeightError = 2.5f / 255.0f;
+	static constexpr float ce_fMaxColorError = 0.5f / 255.0f + 1e-6f;
+	char szLine[256];
+	bool bSuccess = true;
+
+	// 2つの方向のなす角(度)
+	// 1に近い内積のacosはfloatでは0.02度程度の誤差が出るため、外積の長さとの比から倍精度で求める
+	auto AngleDegree = [](const float a[3], const float b[3])
+		{
+			double dCross[3] =
+			{
+				(double)a[1] * b[2] - (double)a[2] * b[1],
+				(double)a[2] * b[0] - (double)a[0] * b[2],
+				(double)a[0] * b[1] - (double)a[1] * b[0],
+			};
+			double dDot = (double)a[0] * b[0] + (double)a[1] * b[1] + (double)a[2] * b[2];
+			double dSin = std::sqrt(dCross[0] * dCross[0] + dCross[1] * dCross[1] + dCross[2] * dCross[2]);
+			return static_cast<float>(std::atan2(dSin, dDot) * 180.0 / 3.14159265358979);
+		};
+
+	// 法線を往復させた角度の誤差(度)
+	auto NormalError = [&](const float normal[3])
+		{
+			int16_t encoded[2];
+			float decoded[3];
+			EncodeOctNormal(normal, encoded);
+			DecodeOctNormal(encoded, decoded);
+			return AngleDegree(normal, decoded);
+		};
+
+	//--- 法線
+	// 球面上に均等に並べた方向
+	float fSphereError = 0.0f;
+	double dSphereSum = 0.0;
+	for (int i = 0; i < ce_nNormalNum; ++i)
+	{
+		float z = 1.0f - 2.0f * (i + 0.5f) / ce_nNormalNum;
+		float r = std::sqrt((std::max)(1.0f - z * z, 0.0f));
+		float fAngle = i * 2.39996323f;
+		const float normal[3] = { r * std::cos(fAngle), r * std::sin(fAngle), z };
+		float fError = NormalError(normal);
+		fSphereError = (std::max)(fSphereError, fError);
+		dSphereSum += fError;
+	}
+	bool bNormal = fSphereError <= ce_fMaxNormalDegree;
+	sprintf_s(szLine, "normal sphere  %d dirs  max %.5f deg  avg %.5f deg  %s\n", ce_nNormalNum, fSphereError, dSphereSum / ce_nNormalNum, bNormal ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess &= bNormal;
+
+	// 軸方向と、八面体の折り返しの境目(z=0付近)
+	float fEdgeError = 0.0f;
+	for (int nAxis = 0; nAxis < 6; ++nAxis)
+	{
+		float normal[3] = {};
+		normal[nAxis / 2] = (nAxis % 2 == 0) ? 1.0f : -1.0f;
+		fEdgeError = (std::max)(fEdgeError, NormalError(normal));
+	}
+	for (int i = 0; i < 360; ++i)
+	{
+		float fAngle = i * 3.14159265f / 180.0f;
+		const float fZ[] = { 0.0f, 1e-4f, -1e-4f, -0.5f };
+		for (float z : fZ)
+		{
+			float r = std::sqrt(1.0f - z * z);
+			const float normal[3] = { r * std::cos(fAngle), r * std::sin(fAngle), z };
+			fEdgeError = (std::max)(fEdgeError, NormalError(normal));
+		}
+	}
+	bNormal = fEdgeError <= ce_fMaxNormalDegree;
+	sprintf_s(szLine, "normal edge    axes and fold  max %.5f deg  %s\n", fEdgeError, bNormal ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess &= bNormal;
+
+	//--- UV
+	// NaN以外の全ての半精度の値が往復で変わらない
+	int nHalfMismatch = 0;
+	for (uint32_t nHalf = 0; nHalf <= 0xffff; ++nHalf)
+	{
+		bool bNaN = ((nHalf >> 10) & 0x1f) == 0x1f && (nHalf & 0x3ff) != 0;
+		if (bNaN) continue;
+		if (FloatToHalf(HalfToFloat(static_cast<uint16_t>(nHalf))) != nHalf) ++nHalfMismatch;
+	}
+	sprintf_s(szLine, "half roundtrip  mismatch %d  %s\n", nHalfMismatch, nHalfMismatch == 0 ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess &= nHalfMismatch == 0;
+
+	// -2～4の相対誤差(0付近は非正規化数の刻み幅の半分まで)
+	float fUVRelative = 0.0f;
+	int nUVOver = 0;
+	for (int i = 0; i <= ce_nUVNum; ++i)
+	{
+		float fValue = -2.0f + 6.0f * i / ce_nUVNum;
+		float fError = std::fabs(HalfToFloat(FloatToHalf(fValue)) - fValue);
+		if (fError > (std::max)(std::fabs(fValue) * ce_fMaxUVRelative, ce_fMinHalfStep)) ++nUVOver;
+		if (std::fabs(fValue) > 1e-4f) fUVRelative = (std::max)(fUVRelative, fError / std::fabs(fValue));
+	}
+	sprintf_s(szLine, "uv -2..4  max relative %.3e (limit %.3e)  over %d  %s\n", fUVRelative, ce_fMaxUVRelative, nUVOver, nUVOver == 0 ? "ok" : "FAILED");
+	tReport << szLine;
+	bSuccess &= nUVOver == 0;
+
+	//--- レイアウト毎のPack/Unpackの往復
+	tReport << "layout        stride  bytes/vtx(80)  normal deg  uv rel     color     weight    weight sum  index  check\n";
+	const char* szLayoutName[(int)VertexLayout::MAX] = { "Static", "StaticColor", "Skinned", "SkinnedColor" };
+	for (int nLayout = 0; nLayout < (int)VertexLayout::MAX; ++nLayout)
+	{
+		VertexLayout layout = static_cast<VertexLayout>(nLayout);
+		const VertexLayoutInfo& info = GetInfo(layout);
+		bool bColor = info.m_nColorOffset >= 0;
+		bool bSkin = info.m_nWeightOffset >= 0;
+
+		// 要素がストライドに収まっているか
+		bool bValid = ce_nUVOffset + 4 <= info.m_nStride;
+		const int nOffset[] = { info.m_nColorOffset, info.m_nWeightOffset, info.m_nIndexOffset };
+		for (int n : nOffset) bValid = bValid && (n < 0 || static_cast<UINT>(n) + 4 <= info.m_nStride);
+
+		std::mt19937 tRandom(28);
+		std::uniform_real_distribution<float> tUnit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> tUV(-2.0f, 4.0f);
+		std::uniform_real_distribution<float> tColor(0.0f, 1.0f);
+		std::uniform_int_distribution<unsigned int> tIndex(0, 255);
+		std::vector<uint8_t> packed(info.m_nStride);
+
+		float fNormalError = 0.0f;
+		float fUVError = 0.0f;
+		float fColorError = 0.0f;
+		float fWeightError = 0.0f;
+		int nBadSum = 0;
+		int nBadIndex = 0;
+		for (int i = 0; i < ce_nVertexNum; ++i)
+		{
+			VertexAttribute in = {};
+			float fLen = 0.0f;
+			do
+			{
+				for (int k = 0; k < 3; ++k) in.m_fNormal[k] = tUnit(tRandom);
+				fLen = std::sqrt(in.m_fNormal[0] * in.m_fNormal[0] + in.m_fNormal[1] * in.m_fNormal[1] + in.m_fNormal[2] * in.m_fNormal[2]);
+			} while (fLen < 0.1f || fLen > 1.0f);
+			for (int k = 0; k < 3; ++k)
+			{
+				in.m_fPos[k] = tUnit(tRandom) * 100.0f;
+				in.m_fNormal[k] /= fLen;
+			}
+			for (int k = 0; k < 2; ++k) in.m_fUV[k] = tUV(tRandom);
+
+			// ウェイトは合計1、1～4本
+			int nWeightNum = 1 + i % 4;
+			float fWeightSum = 0.0f;
+			for (int k = 0; k < nWeightNum; ++k) fWeightSum += (in.m_fWeight[k] = tColor(tRandom) + 0.01f);
+			for (int k = 0; k < 4; ++k)
+			{
+				in.m_fColor[k] = tColor(tRandom);
+				in.m_fWeight[k] /= fWeightSum;
+				in.m_nIndex[k] = tIndex(tRandom);
+			}
+
+			VertexAttribute out;
+			Pack(layout, in, packed.data());
+			Unpack(layout, packed.data(), out);
+
+			// 座標はそのまま
+			bValid = bValid && std::memcmp(in.m_fPos, out.m_fPos, sizeof(in.m_fPos)) == 0;
+
+			fNormalError = (std::max)(fNormalError, AngleDegree(in.m_fNormal, out.m_fNormal));
+			for (int k = 0; k < 2; ++k)
+				fUVError = (std::max)(fUVError, std::fabs(out.m_fUV[k] - in.m_fUV[k]) / (std::max)(std::fabs(in.m_fUV[k]), 1.0f));
+
+			int nSum = 0;
+			for (int k = 0; k < 4; ++k)
+			{
+				// レイアウトに無い要素は既定値
+				fColorError = (std::max)(fColorError, std::fabs(out.m_fColor[k] - (bColor ? in.m_fColor[k] : 1.0f)));
+				fWeightError = (std::max)(fWeightError, std::fabs(out.m_fWeight[k] - (bSkin ? in.m_fWeight[k] : 0.0f)));
+				if (out.m_nIndex[k] != (bSkin ? in.m_nIndex[k] : 0u)) ++nBadIndex;
+				if (bSkin) nSum += packed[info.m_nWeightOffset + k];
+			}
+			if (bSkin && nSum != 255) ++nBadSum;
+		}
+
+		bValid = bValid && fNormalError <= ce_fMaxNormalDegree && fUVError <= ce_fMaxUVRelative
+			&& fColorError <= ce_fMaxColorError && fWeightError <= ce_fMaxWeightError && nBadSum == 0 && nBadIndex == 0;
+		sprintf_s(szLine, "%-12s  %6u  %12.1f%%  %10.5f  %.3e  %.5f   %.5f   %10d  %5d  %s\n",
+			szLayoutName[nLayout], info.m_nStride, 100.0f * info.m_nStride / sizeof(VertexAttribute),
+			fNormalError, fUVError, fColorError, fWeightError, nBadSum, nBadIndex, bValid ? "ok" : "FAILED");
+		tReport << szLine;
+		bSuccess &= bValid;
+	}
+
+	tReport << (bSuccess ? "ok\n" : "FAILED\n");
+	return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/**************************************************//*
+	@file	| VertexFormat.h
+	@brief	| 圧縮頂点フォーマットのhファイル
+	@note	| モデルの頂点をメッシュ毎に必要な要素だけの量子化した形式で扱う
+			| 法線：八面体エンコード(snorm16x2)
+			| UV：半精度浮動小数(half2)
+			| 色・ウェイト：unorm8x4 / ボーン番号：uint8x4
+*//**************************************************/
+#pragma once
+#include "DirectX.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// @brief 頂点レイアウトの種類
+enum class VertexLayout
+{
+	// 座標・法線・UV
+	Static,
+
+	// 座標・法線・UV・色
+	StaticColor,
+
+	// 座標・法線・UV・ウェイト・ボーン番号
+	Skinned,
+
+	// 座標・法線・UV・色・ウェイト・ボーン番号
+	SkinnedColor,
+
+	MAX
+};
+
+// @brief 頂点レイアウトの情報
+struct VertexLayoutInfo
+{
+	// 頂点1つあたりのサイズ
+	UINT m_nStride;
+
+	// 色のオフセット(-1で要素なし)
+	int m_nColorOffset;
+
+	// ウェイトのオフセット(-1で要素なし)
+	int m_nWeightOffset;
+
+	// ボーン番号のオフセット(-1で要素なし)
+	int m_nIndexOffset;
+};
+
+// @brief 圧縮前の頂点要素
+struct VertexAttribute
+{
+	float m_fPos[3];
+	float m_fNormal[3];
+	float m_fUV[2];
+	float m_fColor[4];
+	float m_fWeight[4];
+	unsigned int m_nIndex[4];
+};
+
+// @brief 頂点圧縮の計測情報
+struct VertexPackStats
+{
+	// 圧縮前の頂点バッファサイズ(バイト)
+	size_t m_nFullBytes;
+
+	// 圧縮後の頂点バッファサイズ(バイト)
+	size_t m_nPackedBytes;
+
+	// レイアウト毎のメッシュ数
+	int m_nLayoutCount[(int)VertexLayout::MAX];
+
+	// 法線の最大誤差(度)
+	float m_fMaxNormalError;
+
+	// UVの最大誤差
+	float m_fMaxUVError;
+
+	// ウェイトの最大誤差
+	float m_fMaxWeightError;
+};
+
+// @brief 圧縮頂点フォーマットクラス
+class VertexFormat
+{
+public:
+	// @brief 初期化
+	// @note 色を持たないレイアウト用の白色ストリームを作成する
+	static void Init();
+
+	// @brief 終了
+	static void Uninit();
+
+	// @brief レイアウトの情報を取得
+	// @param layout：頂点レイアウト
+	// @return レイアウトの情報
+	static const VertexLayoutInfo& GetInfo(VertexLayout layout);
+
+	// @brief 入力レイアウトの要素を取得
+	// @param layout：頂点レイアウト
+	// @param out：要素の格納先
+	// @param isInstanced：インスタンス毎のワールド行列と色(スロット2)を追加するか
+	static void GetInputElements(VertexLayout layout, std::vector<D3D11_INPUT_ELEMENT_DESC>& out, bool isInstanced = false);
+
+	// @brief 色を持たないレイアウトのために白色ストリームを設定
+	// @param layout：頂点レイアウト
+	static void BindColorStream(VertexLayout layout);
+
+	// @brief 頂点を圧縮して書き込む
+	// @param layout：頂点レイアウト
+	// @param in：圧縮前の頂点要素
+	// @param pDst：書き込み先(レイアウトのストライド分の領域)
+	static void Pack(VertexLayout layout, const VertexAttribute& in, void* pDst);
+
+	// @brief 圧縮された頂点を展開する
+	// @param layout：頂点レイアウト
+	// @param pSrc：圧縮された頂点
+	// @param out：展開先(レイアウトに無い要素は既定値)
+	static void Unpack(VertexLayout layout, const void* pSrc, VertexAttribute& out);
+
+	// @brief 法線を八面体エンコードする
+	// @param normal：正規化された法線
+	// @param out：エンコード結果(snorm16)
+	static void EncodeOctNormal(const float normal[3], int16_t out[2]);
+
+	// @brief 八面体エンコードされた法線を展開する
+	// @param in：エンコードされた法線(snorm16)
+	// @param out：正規化された法線
+	static void DecodeOctNormal(const int16_t in[2], float out[3]);
+
+	// @brief 単精度浮動小数を半精度に変換
+	// @param value：変換する値
+	// @return 半精度浮動小数のビット列
+	static uint16_t FloatToHalf(float value);
+
+	// @brief 半精度浮動小数を単精度に変換
+	// @param value：半精度浮動小数のビット列
+	// @return 変換した値
+	static float HalfToFloat(uint16_t value);
+
+	// @brief ウェイトを合計が255になるよう8bitに量子化する
+	// @param weight：ウェイト
+	// @param out：量子化結果
+	static void EncodeWeights(const float weight[4], uint8_t out[4]);
+
+	// @brief 圧縮・展開の精度を計測してファイルに書き出す
+	// @param inReportPath：書き出すファイルのパス
+	// @return 0:全ての精度が許容範囲内 1:範囲外の項目がある
+	static int MeasureAccuracy(const char* inReportPath);
+
+private:
+	// @brief 色を持たないレイアウト用の白色ストリーム
+	static ID3D11Buffer* m_pWhiteColor;
+};
@@ -0,0 +1,449 @@
+/**************************************************//*
+	@file	| BlockCompress.cpp
+	@brief	| ブロック圧縮のcppファイル
+	@note	| 4x4画素のブロックをBC1/BC3/BC7の形式に圧縮する
+			| 端点は画素の主成分の軸上の両端から求め、最小二乗法で1回補正する
+*//**************************************************/
+#include "BlockCompress.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cfloat>
+
+namespace
+{
+	// @brief ブロックの画素数
+	constexpr int ce_nPixelNum = 16;
+
+	// @brief BC7の4bitインデックスの補間の重み(64分率)
+	const int ce_nBC7Weight[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	// @brief 画素の主成分の軸を求める
+	// @param pPixel：画素(inChannel要素ずつ)
+	// @param inChannel：成分数(3か4)
+	// @param outMean：平均
+	// @param outAxis：主成分の軸(正規化済み、全画素が同じ色なら0)
+	void PrincipalAxis(const float (*pPixel)[4], int inChannel, float* outMean, float* outAxis)
+	{
+		for (int c = 0; c < 4; c++) outMean[c] = outAxis[c] = 0.0f;
+		for (int i = 0; i < ce_nPixelNum; i++)
+		{
+			for (int c = 0; c < inChannel; c++) outMean[c] += pPixel[i][c];
+		}
+		for (int c = 0; c < inChannel; c++) outMean[c] /= ce_nPixelNum;
+
+		// 共分散行列
+		float fCov[4][4] = {};
+		for (int i = 0; i < ce_nPixelNum; i++)
+		{
+			float fDiff[4] = {};
+			for (int c = 0; c < inChannel; c++) fDiff[c] = pPixel[i][c] - outMean[c];
+			for (int a = 0; a < inChannel; a++)
+			{
+				for (int b = 0; b < inChannel; b++) fCov[a][b] += fDiff[a] * fDiff[b];
+			}
+		}
+
+		// べき乗法で最大固有値の固有ベクトルを求める(初期値は最も分散の大きい成分)
+		int nMaxChannel = 0;
+		for (int c = 1; c < inChannel; c++)
+		{
+			if (fCov[c][c] > fCov[nMaxChannel][nMaxChannel]) nMaxChannel = c;
+		}
+		if (fCov[nMaxChannel][nMaxChannel] <= FLT_EPSILON) return;
+
+		float fVec[4] = {};
+		for (int c = 0; c < inChannel; c++) fVec[c] = fCov[nMaxChannel][c];
+		for (int iter = 0; iter < 8; iter++)
+		{
+			float fNext[4] = {};
+			for (int a = 0; a < inChannel; a++)
+			{
+				for (int b = 0; b < inChannel; b++) fNext[a] += fCov[a][b] * fVec[b];
+			}
+			float fLen = 0.0f;
+			for (int c = 0; c < inChannel; c++) fLen += fNext[c] * fNext[c];
+			fLen = std::sqrt(fLen);
+			if (fLen <= FLT_EPSILON) return;
+			for (int c = 0; c < inChannel; c++) fVec[c] = fNext[c] / fLen;
+		}
+		for (int c = 0; c < inChannel; c++) outAxis[c] = fVec[c];
+	}
+
+	// @brief 主成分の軸上の両端を端点にする
+	void AxisEndpoints(const float (*pPixel)[4], int inChannel, float* outE0, float* outE1)
+	{
+		float fMean[4], fAxis[4];
+		PrincipalAxis(pPixel, inChannel, fMean, fAxis);
+
+		float fMin = FLT_MAX, fMax = -FLT_MAX;
+		for (int i = 0; i < ce_nPixelNum; i++)
+		{
+			float t = 0.0f;
+			for (int c = 0; c < inChannel; c++) t += (pPixel[i][c] - fMean[c]) * fAxis[c];
+			fMin = (std::min)(fMin, t);
+			fMax = (std::max)(fMax, t);
+		}
+		if (fMin > fMax) fMin = fMax = 0.0f;
+		for (int c = 0; c < 4; c++)
+		{
+			outE0[c] = (std::min)(255.0f, (std::max)(0.0f, fMean[c] + fAxis[c] * fMin));
+			outE1[c] = (std::min)(255.0f, (std::max)(0.0f, fMean[c] + fAxis[c] * fMax));
+		}
+	}
+
+	// @brief 補間の重みを固定して端点を最小二乗法で求め直す
+	// @param pWeight：画素毎の端点1側の重み(0～1)
+	// @return true:求められた false:重みが偏っていて求められない
+	bool RefineEndpoints(const float (*pPixel)[4], int inChannel, const float* pWeight, float* outE0, float* outE1)
+	{
+		float a = 0.0f, b = 0.0f, c = 0.0f;
+		float fRhs0[4] = {}, fRhs1[4] = {};
+		for (int i = 0; i < ce_nPixelNum; i++)
+		{
+			float w1 = pWeight[i], w0 = 1.0f - w1;
+			a += w0 * w0;
+			b += w0 * w1;
+			c += w1 * w1;
+			for (int ch = 0; ch < inChannel; ch++)
+			{
+				fRhs0[ch] += w0 * pPixel[i][ch];
+				fRhs1[ch] += w1 * pPixel[i][ch];
+			}
+		}
+		float fDet = a * c - b * b;
+		if (std::fabs(fDet) <= 1e-6f) return false;
+		for (int ch = 0; ch < inChannel; ch++)
+		{
+			outE0[ch] = (std::min)(255.0f, (std::max)(0.0f, (c * fRhs0[ch] - b * fRhs1[ch]) / fDet));
+			outE1[ch] = (std::min)(255.0f, (std::max)(0.0f, (a * fRhs1[ch] - b * fRhs0[ch]) / fDet));
+		}
+		return true;
+	}
+
+	//==================================================
+	// BC1の色ブロック
+	//==================================================
+
+	// @brief RGBを565に量子化する
+	uint16_t PackRgb565(const float* pColor)
+	{
+		int r = static_cast<int>(std::lround(pColor[0] * 31.0f / 255.0f));
+		int g = static_cast<int>(std::lround(pColor[1] * 63.0f / 255.0f));
+		int b = static_cast<int>(std::lround(pColor[2] * 31.0f / 255.0f));
+		return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+	}
+
+	// @brief 565をRGBに戻す
+	void UnpackRgb565(uint16_t inColor, int* outColor)
+	{
+		int r = (inColor >> 11) & 31, g = (inColor >> 5) & 63, b = inColor & 31;
+		outColor[0] = (r << 3) | (r >> 2);
+		outColor[1] = (g << 2) | (g >> 4);
+		outColor[2] = (b << 3) | (b >> 2);
+	}
+
+	// @brief 色ブロックのインデックスを決めて誤差を返す(4色モード)
+	float EncodeColorIndex(const float (*pPixel)[4], uint16_t inC0, uint16_t inC1, uint32_t& outIndex)
+	{
+		int nPalette[4][3];
+		UnpackRgb565(inC0, nPalette[0]);
+		UnpackRgb565(inC1, nPalette[1]);
+		for (int c = 0; c < 3; c++)
+		{
+			nPalette[2][c] = (2 * nPalette[0][c] + nPalette[1][c]) / 3;
+			nPalette[3][c] = (nPalette[0][c] + 2 * nPalette[1][c]) / 3;
+		}
+
+		float fTotal = 0.0f;
+		outIndex = 0;
+		for (int i = 0; i < ce_nPixelNum; i++)
+		{
+			float fBest = FLT_MAX;
+			uint32_t nBest = 0;
+			for (uint32_t k = 0; k < 4; k++)
+			{
+				float fErr = 0.0f;
+				for (int c = 0; c < 3; c++)
+				{
+					float d = pPixel[i][c] - nPalette[k][c];
+					fErr += d * d;
+				}
+				if (fErr < fBest)
+				{
+					fBest = fErr;
+					nBest = k;
+				}
+			}
+			outIndex |= nBest << (i * 2);
+			fTotal += fBest;
+		}
+		return fTotal;
+	}
+
+	// @brief 色ブロックを圧縮する(常に4色モード)
+	void CompressColorBlock(const float (*pPixel)[4], uint8_t* pOut)
+	{
+		float fE0[4], fE1[4];
+		AxisEndpoints(pPixel, 3, fE0, fE1);
+
+		// 4色モードにするため端点0の方を大きくする(同じなら全画素が端点0)
+		auto Encode = [pPixel](const float* pE0, const float* pE1, uint16_t& c0, uint16_t& c1, uint32_t& nIndex)
+		{
+			c0 = PackRgb565(pE1);
+			c1 = PackRgb565(pE0);
+			if (c0 < c1) std::swap(c0, c1);
+			if (c0 == c1)
+			{
+				nIndex = 0;
+				int nColor[3];
+				UnpackRgb565(c0, nColor);
+				float fErr = 0.0f;
+				for (int i = 0; i < ce_nPixelNum; i++)
+				{
+					for (int c = 0; c < 3; c++) fErr += (pPixel[i][c] - nColor[c]) * (pPixel[i][c] - nColor[c]);
+				}
+				return fErr;
+			}
+			return EncodeColorIndex(pPixel, c0, c1, nIndex);
+		};
+
+		uint16_t c0, c1;
+		uint32_t nIndex;
+		float fErr = Encode(fE0, fE1, c0, c1, nIndex);
+
+		// インデックスを固定して端点を補正し、良くなれば採用する
+		static const float ce_fWeight[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+		float fWeight[ce_nPixelNum];
+		for (int i = 0; i < ce_nPixelNum; i++) fWeight[i] = ce_fWeight[(nIndex >> (i * 2)) & 3];
+		float fR0[4], fR1[4];
+		if (c0 != c1 && RefineEndpoints(pPixel, 3, fWeight, fR0, fR1))
+		{
+			// 重みは端点0(c0)から端点1(c1)への補間
+			uint16_t r0, r1;
+			uint32_t nRefineIndex;
+			float fRefineErr = Encode(fR0, fR1, r0, r1, nRefineIndex);
+			if (fRefineErr < fErr)
+			{
+				c0 = r0;
+				c1 = r1;
+				nIndex = nRefineIndex;
+			}
+		}
+
+		pOut[0] = static_cast<uint8_t>(c0 & 0xff);
+		pOut[1] = static_cast<uint8_t>(c0 >> 8);
+		pOut[2] = static_cast<uint8_t>(c1 & 0xff);
+		pOut[3] = static_cast<uint8_t>(c1 >> 8);
+		for (int i = 0; i < 4; i++) pOut[4 + i] = static_cast<uint8_t>(nIndex >> (i * 8));
+	}
+
+	// @brief 画素を浮動小数に変換する
+	void ToFloat(const uint8_t* pRgba, float (*outPixel)[4])
+	{
+		for (int i = 0; i < ce_nPixelNum; i++)
+		{
+			for (int c = 0; c < 4; c++) outPixel[i][c] = pRgba[i * 4 + c];
+		}
+	}
+
+	//==================================================
+	// BC7
+	//==================================================
+
+	// @brief 128bitのブロックに下位ビットから書き込む
+	struct BitWriter
+	{
+		uint8_t* m_pOut;
+		int m_nPos;
+
+		void Write(uint32_t inValue, int inBits)
+		{
+			for (int i = 0; i < inBits; i++, m_nPos++)
+			{
+				if ((inValue >> i) & 1) m_pOut[m_nPos >> 3] |= static_cast<uint8_t>(1 << (m_nPos & 7));
+			}
+		}
+	};
+
+	// @brief 端点を7bit + 共有の最下位ビット(pビット)に量子化する
+	void QuantizeBC7(const float* pEndpoint, int inPBit, int* outQuant, int* outValue)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			int q = static_cast<int>(std::lround((pEndpoint[c] - inPBit) / 2.0f));
+			q = (std::min)(127, (std::max)(0, q));
+			outQuant[c] = q;
+			outValue[c] = (q << 1) | inPBit;
+		}
+	}
+
+	// @brief BC7モード6のインデックスを決めて誤差を返す
+	float EncodeBC7Index(const float (*pPixel)[4], const int* pE0, const int* pE1, uint8_t* outIndex)
+	{
+		int nPalette[16][4];
+		for (int k = 0; k < 16; k++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				nPalette[k][c] = ((64 - ce_nBC7Weight[k]) * pE0[c] + ce_nBC7Weight[k] * pE1[c] + 32) >> 6;
+			}
+		}
+
+		float fTotal = 0.0f;
+		for (int i = 0; i < ce_nPixelNum; i++)
+		{
+			float fBest = FLT_MAX;
+			for (int k = 0; k < 16; k++)
+			{
+				float fErr = 0.0f;
+				for (int c = 0; c < 4; c++)
+				{
+					float d = pPixel[i][c] - nPalette[k][c];
+					fErr += d * d;
+				}
+				if (fErr < fBest)
+				{
+					fBest = fErr;
+					outIndex[i] = static_cast<uint8_t>(k);
+				}
+			}
+			fTotal += fBest;
+		}
+		return fTotal;
+	}
+
+	// @brief BC7モード6の端点候補
+	struct BC7Candidate
+	{
+		int m_nQuant[2][4];
+		int m_nPBit[2];
+		uint8_t m_nIndex[ce_nPixelNum];
+		float m_fError;
+	};
+
+	// @brief pビットの4通りの組み合わせから最も誤差の小さい量子化を選ぶ
+	BC7Candidate SelectBC7(const float (*pPixel)[4], const float* pE0, const float* pE1)
+	{
+		BC7Candidate tBest = {};
+		tBest.m_fError = FLT_MAX;
+		for (int p0 = 0; p0 < 2; p0++)
+		{
+			for (int p1 = 0; p1 < 2; p1++)
+			{
+				BC7Candidate tCand = {};
+				int nValue[2][4];
+				QuantizeBC7(pE0, p0, tCand.m_nQuant[0], nValue[0]);
+				QuantizeBC7(pE1, p1, tCand.m_nQuant[1], nValue[1]);
+				tCand.m_nPBit[0] = p0;
+				tCand.m_nPBit[1] = p1;
+				tCand.m_fError = EncodeBC7Index(pPixel, nValue[0], nValue[1], tCand.m_nIndex);
+				if (tCand.m_fError < tBest.m_fError) tBest = tCand;
+			}
+		}
+		return tBest;
+	}
+}
+
+/****************************************//*
+	@brief　	| 4x4画素をBC1に圧縮する
+	@param　	| pRgba：16画素のRGBA(行順)
+	@param　	| pOut：圧縮結果の格納先(8バイト)
+*//****************************************/
+void CompressBlockBC1(const uint8_t* pRgba, uint8_t* pOut)
+{
+	float fPixel[ce_nPixelNum][4];
+	ToFloat(pRgba, fPixel);
+	CompressColorBlock(fPixel, pOut);
+}
+
+/****************************************//*
+	@brief　	| 4x4画素をBC3に圧縮する
+	@param　	| pRgba：16画素のRGBA(行順)
+	@param　	| pOut：圧縮結果の格納先(16バイト)
+*//****************************************/
+void CompressBlockBC3(const uint8_t* pRgba, uint8_t* pOut)
+{
+	// アルファは最大値と最小値の間を8段階に補間する
+	int nMax = 0, nMin = 255;
+	for (int i = 0; i < ce_nPixelNum; i++)
+	{
+		nMax = (std::max)(nMax, static_cast<int>(pRgba[i * 4 + 3]));
+		nMin = (std::min)(nMin, static_cast<int>(pRgba[i * 4 + 3]));
+	}
+
+	memset(pOut, 0, 8);
+	pOut[0] = static_cast<uint8_t>(nMax);
+	pOut[1] = static_cast<uint8_t>(nMin);
+	if (nMax != nMin)
+	{
+		int nPalette[8] = { nMax, nMin };
+		for (int k = 1; k <= 6; k++) nPalette[k + 1] = ((7 - k) * nMax + k * nMin) / 7;
+
+		uint64_t ulIndex = 0;
+		for (int i = 0; i < ce_nPixelNum; i++)
+		{
+			int nAlpha = pRgba[i * 4 + 3];
+			int nBest = 0, nBestErr = INT32_MAX;
+			for (int k = 0; k < 8; k++)
+			{
+				int nErr = std::abs(nPalette[k] - nAlpha);
+				if (nErr < nBestErr)
+				{
+					nBestErr = nErr;
+					nBest = k;
+				}
+			}
+			ulIndex |= static_cast<uint64_t>(nBest) << (i * 3);
+		}
+		for (int i = 0; i < 6; i++) pOut[2 + i] = static_cast<uint8_t>(ulIndex >> (i * 8));
+	}
+
+	CompressBlockBC1(pRgba, pOut + 8);
+}
+
+/****************************************//*
+	@brief　	| 4x4画素をBC7(モード6)に圧縮する
+	@param　	| pRgba：16画素のRGBA(行順)
+	@param　	| pOut：圧縮結果の格納先(16バイト)
+*//****************************************/
+void CompressBlockBC7(const uint8_t* pRgba, uint8_t* pOut)
+{
+	float fPixel[ce_nPixelNum][4];
+	ToFloat(pRgba, fPixel);
+
+	float fE0[4], fE1[4];
+	AxisEndpoints(fPixel, 4, fE0, fE1);
+	BC7Candidate tBest = SelectBC7(fPixel, fE0, fE1);
+
+	// インデックスを固定して端点を補正し、良くなれば採用する
+	float fWeight[ce_nPixelNum];
+	for (int i = 0; i < ce_nPixelNum; i++) fWeight[i] = ce_nBC7Weight[tBest.m_nIndex[i]] / 64.0f;
+	float fR0[4], fR1[4];
+	if (RefineEndpoints(fPixel, 4, fWeight, fR0, fR1))
+	{
+		BC7Candidate tRefine = SelectBC7(fPixel, fR0, fR1);
+		if (tRefine.m_fError < tBest.m_fError) tBest = tRefine;
+	}
+
+	// 先頭画素のインデックスの最上位ビットは0と決まっているので、必要なら端点を入れ替える
+	if (tBest.m_nIndex[0] & 8)
+	{
+		for (int c = 0; c < 4; c++) std::swap(tBest.m_nQuant[0][c], tBest.m_nQuant[1][c]);
+		std::swap(tBest.m_nPBit[0], tBest.m_nPBit[1]);
+		for (int i = 0; i < ce_nPixelNum; i++) tBest.m_nIndex[i] = static_cast<uint8_t>(15 - tBest.m_nIndex[i]);
+	}
+
+	memset(pOut, 0, 16);
+	BitWriter tWriter = { pOut, 0 };
+	tWriter.Write(1 << 6, 7);	// モード6
+	for (int c = 0; c < 4; c++)
+	{
+		tWriter.Write(tBest.m_nQuant[0][c], 7);
+		tWriter.Write(tBest.m_nQuant[1][c], 7);
+	}
+	tWriter.Write(tBest.m_nPBit[0], 1);
+	tWriter.Write(tBest.m_nPBit[1], 1);
+	tWriter.Write(tBest.m_nIndex[0], 3);
+	for (int i = 1; i < ce_nPixelNum; i++) tWriter.Write(tBest.m_nIndex[i], 4);
+}
@@ -0,0 +1,36 @@
+/**************************************************//*
+	@file	| BlockCompress.h
+	@brief	| ブロック圧縮のhファイル
+	@note	| 4x4画素のブロックをBC1/BC3/BC7の形式に圧縮する
+			| BC7はモード6(1領域・RGBA共通の4bitインデックス)のみを使う
+*//**************************************************/
+#pragma once
+#include <cstdint>
+
+// @brief ブロック圧縮の形式
+enum class BlockFormat
+{
+	BC1,	// RGB 4bpp(アルファ無し)
+	BC3,	// RGBA 8bpp(アルファは別ブロック)
+	BC7,	// RGBA 8bpp(高画質)
+};
+
+// @brief 1ブロックの圧縮後のバイト数
+// @param inFormat：圧縮形式
+// @return バイト数
+constexpr uint32_t GetBlockByte(BlockFormat inFormat) { return inFormat == BlockFormat::BC1 ? 8u : 16u; }
+
+// @brief 4x4画素をBC1に圧縮する
+// @param pRgba：16画素のRGBA(行順)
+// @param pOut：圧縮結果の格納先(8バイト)
+void CompressBlockBC1(const uint8_t* pRgba, uint8_t* pOut);
+
+// @brief 4x4画素をBC3に圧縮する
+// @param pRgba：16画素のRGBA(行順)
+// @param pOut：圧縮結果の格納先(16バイト)
+void CompressBlockBC3(const uint8_t* pRgba, uint8_t* pOut);
+
+// @brief 4x4画素をBC7(モード6)に圧縮する
+// @param pRgba：16画素のRGBA(行順)
+// @param pOut：圧縮結果の格納先(16バイト)
+void CompressBlockBC7(const uint8_t* pRgba, uint8_t* pOut);
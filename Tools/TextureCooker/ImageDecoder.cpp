@@ -0,0 +1,975 @@
+/**************************************************//*
+	@file	| ImageDecoder.cpp
+	@brief	| 画像読み込みのcppファイル
+	@note	| テクスチャクッカー用にPNGとベースラインJPEGをRGBA8に展開する
+			| Windows以外でも動くように標準ライブラリだけで実装する
+*//**************************************************/
+#include "ImageDecoder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <climits>
+
+namespace
+{
+	//==================================================
+	// Deflate(zlib)の展開
+	//==================================================
+
+	// @brief 長さ符号の基準値と追加ビット数
+	const short ce_nLengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const short ce_nLengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+	// @brief 距離符号の基準値と追加ビット数
+	const int ce_nDistBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const short ce_nDistExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	// @brief 符号長の並び順(動的ハフマンブロック)
+	const uint8_t ce_nCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+	// @brief 展開の状態
+	struct InflateState
+	{
+		const uint8_t* m_pIn;
+		size_t m_nInSize;
+		size_t m_nInPos;
+		uint32_t m_nBitBuf;
+		int m_nBitCnt;
+		std::vector<uint8_t>* m_pOut;
+		bool m_bError;
+	};
+
+	// @brief ハフマン符号表(符号長毎の数と、符号順の記号)
+	struct InflateHuffman
+	{
+		short m_nCount[16];
+		short m_nSymbol[288];
+	};
+
+	// @brief 下位ビットから順にビットを読む
+	int InflateBits(InflateState& s, int inNeed)
+	{
+		uint32_t nVal = s.m_nBitBuf;
+		while (s.m_nBitCnt < inNeed)
+		{
+			if (s.m_nInPos >= s.m_nInSize)
+			{
+				s.m_bError = true;
+				return 0;
+			}
+			nVal |= static_cast<uint32_t>(s.m_pIn[s.m_nInPos++]) << s.m_nBitCnt;
+			s.m_nBitCnt += 8;
+		}
+		s.m_nBitBuf = nVal >> inNeed;
+		s.m_nBitCnt -= inNeed;
+		return static_cast<int>(nVal & ((1u << inNeed) - 1));
+	}
+
+	// @brief 符号長の一覧からハフマン符号表を作る
+	// @return 0:完全な符号 正:不完全な符号 負:符号長が多すぎる
+	int InflateConstruct(InflateHuffman& h, const short* pLength, int inNum)
+	{
+		memset(h.m_nCount, 0, sizeof(h.m_nCount));
+		for (int i = 0; i < inNum; i++) h.m_nCount[pLength[i]]++;
+		if (h.m_nCount[0] == inNum) return 0;
+
+		int nLeft = 1;
+		for (int len = 1; len < 16; len++)
+		{
+			nLeft <<= 1;
+			nLeft -= h.m_nCount[len];
+			if (nLeft < 0) return nLeft;
+		}
+
+		short nOffset[16];
+		nOffset[1] = 0;
+		for (int len = 1; len < 15; len++) nOffset[len + 1] = nOffset[len] + h.m_nCount[len];
+		for (int i = 0; i < inNum; i++)
+		{
+			if (pLength[i] != 0) h.m_nSymbol[nOffset[pLength[i]]++] = static_cast<short>(i);
+		}
+		return nLeft;
+	}
+
+	// @brief ハフマン符号を1つ読む
+	int InflateDecode(InflateState& s, const InflateHuffman& h)
+	{
+		int nCode = 0, nFirst = 0, nIndex = 0;
+		for (int len = 1; len < 16; len++)
+		{
+			nCode |= InflateBits(s, 1);
+			int nCount = h.m_nCount[len];
+			if (nCode - nCount < nFirst) return h.m_nSymbol[nIndex + (nCode - nFirst)];
+			nIndex += nCount;
+			nFirst += nCount;
+			nFirst <<= 1;
+			nCode <<= 1;
+		}
+		s.m_bError = true;
+		return -1;
+	}
+
+	// @brief 圧縮されたブロックを展開する
+	bool InflateCodes(InflateState& s, const InflateHuffman& tLen, const InflateHuffman& tDist)
+	{
+		std::vector<uint8_t>& out = *s.m_pOut;
+		while (true)
+		{
+			int nSymbol = InflateDecode(s, tLen);
+			if (s.m_bError) return false;
+			if (nSymbol < 256)
+			{
+				out.push_back(static_cast<uint8_t>(nSymbol));
+				continue;
+			}
+			if (nSymbol == 256) return true;
+
+			// 長さと距離で前に出力した内容を複製する
+			nSymbol -= 257;
+			if (nSymbol >= 29) return false;
+			int nLen = ce_nLengthBase[nSymbol] + InflateBits(s, ce_nLengthExtra[nSymbol]);
+			int nDistSymbol = InflateDecode(s, tDist);
+			if (s.m_bError || nDistSymbol < 0 || nDistSymbol >= 30) return false;
+			size_t nDist = static_cast<size_t>(ce_nDistBase[nDistSymbol] + InflateBits(s, ce_nDistExtra[nDistSymbol]));
+			if (s.m_bError || nDist > out.size()) return false;
+
+			size_t nFrom = out.size() - nDist;
+			for (int i = 0; i < nLen; i++) out.push_back(out[nFrom + i]);
+		}
+	}
+
+	// @brief zlib形式のデータを展開する
+	bool Inflate(const uint8_t* pData, size_t inSize, std::vector<uint8_t>& outData)
+	{
+		// zlibのヘッダー(圧縮方式はDeflateのみ)
+		if (inSize < 2 || (pData[0] & 0x0f) != 8) return false;
+
+		InflateState s = {};
+		s.m_pIn = pData;
+		s.m_nInSize = inSize;
+		s.m_nInPos = 2;
+		s.m_pOut = &outData;
+
+		bool bLast = false;
+		while (!bLast)
+		{
+			bLast = InflateBits(s, 1) != 0;
+			int nType = InflateBits(s, 2);
+			if (s.m_bError) return false;
+
+			if (nType == 0)
+			{
+				// 非圧縮ブロック(バイト境界から長さと内容が続く)
+				s.m_nBitBuf = 0;
+				s.m_nBitCnt = 0;
+				if (s.m_nInPos + 4 > s.m_nInSize) return false;
+				size_t nLen = s.m_pIn[s.m_nInPos] | (s.m_pIn[s.m_nInPos + 1] << 8);
+				s.m_nInPos += 4;
+				if (s.m_nInPos + nLen > s.m_nInSize) return false;
+				outData.insert(outData.end(), s.m_pIn + s.m_nInPos, s.m_pIn + s.m_nInPos + nLen);
+				s.m_nInPos += nLen;
+			}
+			else if (nType == 1)
+			{
+				// 固定ハフマンブロック
+				short nLength[288];
+				for (int i = 0; i < 144; i++) nLength[i] = 8;
+				for (int i = 144; i < 256; i++) nLength[i] = 9;
+				for (int i = 256; i < 280; i++) nLength[i] = 7;
+				for (int i = 280; i < 288; i++) nLength[i] = 8;
+				InflateHuffman tLen, tDist;
+				InflateConstruct(tLen, nLength, 288);
+				for (int i = 0; i < 30; i++) nLength[i] = 5;
+				InflateConstruct(tDist, nLength, 30);
+				if (!InflateCodes(s, tLen, tDist)) return false;
+			}
+			else if (nType == 2)
+			{
+				// 動的ハフマンブロック(符号長自体もハフマン符号化されている)
+				int nLenNum = InflateBits(s, 5) + 257;
+				int nDistNum = InflateBits(s, 5) + 1;
+				int nCodeNum = InflateBits(s, 4) + 4;
+				if (s.m_bError || nLenNum > 286 || nDistNum > 30) return false;
+
+				short nLength[320] = {};
+				for (int i = 0; i < nCodeNum; i++) nLength[ce_nCodeLengthOrder[i]] = static_cast<short>(InflateBits(s, 3));
+				InflateHuffman tCode;
+				if (InflateConstruct(tCode, nLength, 19) != 0) return false;
+
+				int nIndex = 0;
+				while (nIndex < nLenNum + nDistNum)
+				{
+					int nSymbol = InflateDecode(s, tCode);
+					if (s.m_bError) return false;
+					if (nSymbol < 16)
+					{
+						nLength[nIndex++] = static_cast<short>(nSymbol);
+						continue;
+					}
+
+					short nRepeatLen = 0;
+					int nRepeat = 0;
+					if (nSymbol == 16)
+					{
+						if (nIndex == 0) return false;
+						nRepeatLen = nLength[nIndex - 1];
+						nRepeat = 3 + InflateBits(s, 2);
+					}
+					else if (nSymbol == 17) nRepeat = 3 + InflateBits(s, 3);
+					else nRepeat = 11 + InflateBits(s, 7);
+					if (nIndex + nRepeat > nLenNum + nDistNum) return false;
+					while (nRepeat--) nLength[nIndex++] = nRepeatLen;
+				}
+
+				InflateHuffman tLen, tDist;
+				if (InflateConstruct(tLen, nLength, nLenNum) < 0) return false;
+				if (InflateConstruct(tDist, nLength + nLenNum, nDistNum) < 0) return false;
+				if (!InflateCodes(s, tLen, tDist)) return false;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//==================================================
+	// PNG
+	//==================================================
+
+	// @brief ビッグエンディアンの32bit値を読む
+	uint32_t ReadBE32(const uint8_t* p)
+	{
+		return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+	}
+
+	// @brief フィルターの予測値(Paeth)
+	uint8_t Paeth(int a, int b, int c)
+	{
+		int p = a + b - c;
+		int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+		if (pa <= pb && pa <= pc) return static_cast<uint8_t>(a);
+		if (pb <= pc) return static_cast<uint8_t>(b);
+		return static_cast<uint8_t>(c);
+	}
+
+	//==================================================
+	// JPEG
+	//==================================================
+
+	// @brief ジグザグ順から行順への変換表
+	const uint8_t ce_nZigZag[64] =
+	{
+		0,  1,  8, 16,  9,  2,  3, 10,
+		17, 24, 32, 25, 18, 11,  4,  5,
+		12, 19, 26, 33, 40, 48, 41, 34,
+		27, 20, 13,  6,  7, 14, 21, 28,
+		35, 42, 49, 56, 57, 50, 43, 36,
+		29, 22, 15, 23, 30, 37, 44, 51,
+		58, 59, 52, 45, 38, 31, 39, 46,
+		53, 60, 61, 54, 47, 55, 62, 63,
+	};
+
+	// @brief JPEGのハフマン符号表
+	struct JpegHuffman
+	{
+		uint8_t m_nValue[256];
+		int m_nMaxCode[18];
+		int m_nValPtr[17];
+		int m_nMinCode[17];
+		bool m_bValid;
+	};
+
+	// @brief JPEGの色成分
+	struct JpegComponent
+	{
+		int m_nId;
+		int m_nH;
+		int m_nV;
+		int m_nQuant;
+		int m_nDcTable;
+		int m_nAcTable;
+		int m_nDcPred;
+		int m_nStride;
+		std::vector<uint8_t> m_Plane;
+	};
+
+	// @brief エントロピー符号化されたデータのビット読み込み
+	struct JpegBitReader
+	{
+		const uint8_t* m_pData;
+		size_t m_nSize;
+		size_t m_nPos;
+		uint32_t m_nBitBuf;
+		int m_nBitCnt;
+
+		// @brief 1バイト読む(0xFF00は0xFF、マーカーに当たったら0を返して進まない)
+		uint8_t ReadByte()
+		{
+			if (m_nPos >= m_nSize) return 0;
+			uint8_t b = m_pData[m_nPos];
+			if (b != 0xFF)
+			{
+				m_nPos++;
+				return b;
+			}
+			if (m_nPos + 1 < m_nSize && m_pData[m_nPos + 1] == 0x00)
+			{
+				m_nPos += 2;
+				return 0xFF;
+			}
+			return 0;
+		}
+
+		// @brief 上位ビットから順に読む
+		int Bits(int inNum)
+		{
+			int nVal = 0;
+			for (int i = 0; i < inNum; i++)
+			{
+				if (m_nBitCnt == 0)
+				{
+					m_nBitBuf = ReadByte();
+					m_nBitCnt = 8;
+				}
+				m_nBitCnt--;
+				nVal = (nVal << 1) | ((m_nBitBuf >> m_nBitCnt) & 1);
+			}
+			return nVal;
+		}
+
+		// @brief ハフマン符号を1つ読む
+		int Decode(const JpegHuffman& h)
+		{
+			int nCode = Bits(1);
+			int nLen = 1;
+			while (nCode > h.m_nMaxCode[nLen])
+			{
+				nCode = (nCode << 1) | Bits(1);
+				if (++nLen > 16) return -1;
+			}
+			return h.m_nValue[h.m_nValPtr[nLen] + nCode - h.m_nMinCode[nLen]];
+		}
+
+		// @brief 符号付きの値を読む
+		int Receive(int inSize)
+		{
+			if (inSize == 0) return 0;
+			int nVal = Bits(inSize);
+			if (nVal < (1 << (inSize - 1))) nVal -= (1 << inSize) - 1;
+			return nVal;
+		}
+	};
+
+	// @brief 8x8の逆離散コサイン変換
+	void InverseDct(const int* pCoef, uint8_t* pOut, int inStride)
+	{
+		static float s_fCos[8][8];
+		static bool s_bInit = false;
+		if (!s_bInit)
+		{
+			for (int x = 0; x < 8; x++)
+			{
+				for (int u = 0; u < 8; u++)
+				{
+					float fScale = u == 0 ? 1.0f / std::sqrt(2.0f) : 1.0f;
+					s_fCos[x][u] = 0.5f * fScale * std::cos((2.0f * x + 1.0f) * u * 3.14159265358979f / 16.0f);
+				}
+			}
+			s_bInit = true;
+		}
+
+		// 行方向と列方向に分けて変換する
+		float fTemp[8][8];
+		for (int v = 0; v < 8; v++)
+		{
+			for (int x = 0; x < 8; x++)
+			{
+				float fSum = 0.0f;
+				for (int u = 0; u < 8; u++) fSum += s_fCos[x][u] * pCoef[v * 8 + u];
+				fTemp[v][x] = fSum;
+			}
+		}
+		for (int y = 0; y < 8; y++)
+		{
+			for (int x = 0; x < 8; x++)
+			{
+				float fSum = 0.0f;
+				for (int v = 0; v < 8; v++) fSum += s_fCos[y][v] * fTemp[v][x];
+				int nVal = static_cast<int>(std::lround(fSum + 128.0f));
+				pOut[y * inStride + x] = static_cast<uint8_t>(nVal < 0 ? 0 : (nVal > 255 ? 255 : nVal));
+			}
+		}
+	}
+
+	// @brief 値を0～255に収める
+	uint8_t ClampByte(float inVal)
+	{
+		int nVal = static_cast<int>(std::lround(inVal));
+		return static_cast<uint8_t>(nVal < 0 ? 0 : (nVal > 255 ? 255 : nVal));
+	}
+}
+
+/****************************************//*
+	@brief　	| 画像ファイルを読み込む(PNG / ベースラインJPEG)
+	@param　	| inPath：ファイルのパス
+	@param　	| outImage：読み込んだ画像の格納先
+	@param　	| outError：失敗した時のエラーメッセージ
+	@return		| true:成功 false:失敗
+*//****************************************/
+bool LoadImageFile(const std::string& inPath, Image& outImage, std::string& outError)
+{
+	std::ifstream tFile(inPath, std::ios::binary);
+	if (!tFile)
+	{
+		outError = "cannot open file";
+		return false;
+	}
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(tFile)), std::istreambuf_iterator<char>());
+
+	// 拡張子と中身が違うファイルもあるのでシグネチャで判定する
+	static const uint8_t ce_nPngSignature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+	if (data.size() >= 8 && memcmp(data.data(), ce_nPngSignature, 8) == 0)
+	{
+		return DecodePng(data.data(), data.size(), outImage, outError);
+	}
+	if (data.size() >= 2 && data[0] == 0xFF && data[1] == 0xD8)
+	{
+		return DecodeJpeg(data.data(), data.size(), outImage, outError);
+	}
+	outError = "unknown image format";
+	return false;
+}
+
+/****************************************//*
+	@brief　	| PNGを展開する
+	@param　	| pData：ファイルの内容
+	@param　	| inSize：ファイルのサイズ
+	@param　	| outImage：展開した画像の格納先
+	@param　	| outError：失敗した時のエラーメッセージ
+	@return		| true:成功 false:失敗
+*//****************************************/
+bool DecodePng(const uint8_t* pData, size_t inSize, Image& outImage, std::string& outError)
+{
+	uint32_t nWidth = 0, nHeight = 0;
+	int nDepth = 0, nColorType = 0, nInterlace = 0;
+	uint8_t nPalette[256][4];
+	for (int i = 0; i < 256; i++) { nPalette[i][0] = nPalette[i][1] = nPalette[i][2] = 0; nPalette[i][3] = 255; }
+	bool bKey = false;
+	uint16_t nKey[3] = {};
+	std::vector<uint8_t> compressed;
+
+	// チャンクを順に読む
+	size_t nPos = 8;
+	while (nPos + 8 <= inSize)
+	{
+		uint32_t nLen = ReadBE32(pData + nPos);
+		const uint8_t* pType = pData + nPos + 4;
+		const uint8_t* pChunk = pData + nPos + 8;
+		if (nPos + 12 + static_cast<size_t>(nLen) > inSize)
+		{
+			outError = "truncated chunk";
+			return false;
+		}
+
+		if (memcmp(pType, "IHDR", 4) == 0 && nLen >= 13)
+		{
+			nWidth = ReadBE32(pChunk);
+			nHeight = ReadBE32(pChunk + 4);
+			nDepth = pChunk[8];
+			nColorType = pChunk[9];
+			nInterlace = pChunk[12];
+		}
+		else if (memcmp(pType, "PLTE", 4) == 0)
+		{
+			for (uint32_t i = 0; i < nLen / 3 && i < 256; i++)
+			{
+				nPalette[i][0] = pChunk[i * 3 + 0];
+				nPalette[i][1] = pChunk[i * 3 + 1];
+				nPalette[i][2] = pChunk[i * 3 + 2];
+			}
+		}
+		else if (memcmp(pType, "tRNS", 4) == 0)
+		{
+			// パレットは色毎の透明度、それ以外は透明にする色
+			if (nColorType == 3)
+			{
+				for (uint32_t i = 0; i < nLen && i < 256; i++) nPalette[i][3] = pChunk[i];
+			}
+			else if (nColorType == 0 && nLen >= 2)
+			{
+				bKey = true;
+				nKey[0] = static_cast<uint16_t>((pChunk[0] << 8) | pChunk[1]);
+			}
+			else if (nColorType == 2 && nLen >= 6)
+			{
+				bKey = true;
+				for (int c = 0; c < 3; c++) nKey[c] = static_cast<uint16_t>((pChunk[c * 2] << 8) | pChunk[c * 2 + 1]);
+			}
+		}
+		else if (memcmp(pType, "IDAT", 4) == 0)
+		{
+			compressed.insert(compressed.end(), pChunk, pChunk + nLen);
+		}
+		else if (memcmp(pType, "IEND", 4) == 0)
+		{
+			break;
+		}
+		nPos += 12 + static_cast<size_t>(nLen);
+	}
+
+	if (nWidth == 0 || nHeight == 0)
+	{
+		outError = "missing IHDR";
+		return false;
+	}
+	if (nInterlace != 0)
+	{
+		outError = "interlaced PNG is not supported";
+		return false;
+	}
+
+	int nChannel = 0;
+	switch (nColorType)
+	{
+	case 0: nChannel = 1; break;	// グレースケール
+	case 2: nChannel = 3; break;	// RGB
+	case 3: nChannel = 1; break;	// パレット
+	case 4: nChannel = 2; break;	// グレースケール + アルファ
+	case 6: nChannel = 4; break;	// RGBA
+	default:
+		outError = "unknown color type";
+		return false;
+	}
+	bool bValidDepth = (nDepth == 8) || (nDepth == 16 && nColorType != 3) || (nDepth < 8 && (nColorType == 0 || nColorType == 3));
+	if (!bValidDepth)
+	{
+		outError = "unsupported bit depth";
+		return false;
+	}
+
+	std::vector<uint8_t> raw;
+	if (!Inflate(compressed.data(), compressed.size(), raw))
+	{
+		outError = "broken zlib stream";
+		return false;
+	}
+
+	size_t nBitsPerPixel = static_cast<size_t>(nChannel) * nDepth;
+	size_t nBytePerPixel = (std::max)(static_cast<size_t>(1), nBitsPerPixel / 8);
+	size_t nStride = (nWidth * nBitsPerPixel + 7) / 8;
+	if (raw.size() < (nStride + 1) * nHeight)
+	{
+		outError = "not enough image data";
+		return false;
+	}
+
+	outImage.m_nWidth = nWidth;
+	outImage.m_nHeight = nHeight;
+	outImage.m_Pixels.assign(static_cast<size_t>(nWidth) * nHeight * 4, 0);
+
+	std::vector<uint8_t> prev(nStride, 0), cur(nStride, 0);
+	int nMaxValue = (1 << nDepth) - 1;
+	for (uint32_t y = 0; y < nHeight; y++)
+	{
+		// 行毎のフィルターを戻す
+		const uint8_t* pRow = raw.data() + y * (nStride + 1);
+		uint8_t nFilter = pRow[0];
+		for (size_t i = 0; i < nStride; i++)
+		{
+			int a = i >= nBytePerPixel ? cur[i - nBytePerPixel] : 0;
+			int b = prev[i];
+			int c = i >= nBytePerPixel ? prev[i - nBytePerPixel] : 0;
+			int x = pRow[1 + i];
+			switch (nFilter)
+			{
+			case 0: cur[i] = static_cast<uint8_t>(x); break;
+			case 1: cur[i] = static_cast<uint8_t>(x + a); break;
+			case 2: cur[i] = static_cast<uint8_t>(x + b); break;
+			case 3: cur[i] = static_cast<uint8_t>(x + ((a + b) >> 1)); break;
+			case 4: cur[i] = static_cast<uint8_t>(x + Paeth(a, b, c)); break;
+			default:
+				outError = "unknown filter type";
+				return false;
+			}
+		}
+
+		// RGBA8に変換する
+		for (uint32_t x = 0; x < nWidth; x++)
+		{
+			uint16_t nSample[4] = {};
+			for (int ch = 0; ch < nChannel; ch++)
+			{
+				if (nDepth == 16)
+				{
+					size_t nIndex = (static_cast<size_t>(x) * nChannel + ch) * 2;
+					nSample[ch] = static_cast<uint16_t>((cur[nIndex] << 8) | cur[nIndex + 1]);
+				}
+				else if (nDepth == 8)
+				{
+					nSample[ch] = cur[static_cast<size_t>(x) * nChannel + ch];
+				}
+				else
+				{
+					size_t nBit = static_cast<size_t>(x) * nDepth;
+					nSample[ch] = static_cast<uint16_t>((cur[nBit / 8] >> (8 - nDepth - nBit % 8)) & nMaxValue);
+				}
+			}
+
+			uint8_t* pOut = &outImage.m_Pixels[(static_cast<size_t>(y) * nWidth + x) * 4];
+			auto To8 = [nDepth, nMaxValue](uint16_t inVal)
+			{
+				if (nDepth == 16) return static_cast<uint8_t>(inVal >> 8);
+				return static_cast<uint8_t>(inVal * 255 / nMaxValue);
+			};
+			switch (nColorType)
+			{
+			case 0:
+				pOut[0] = pOut[1] = pOut[2] = To8(nSample[0]);
+				pOut[3] = (bKey && nSample[0] == nKey[0]) ? 0 : 255;
+				break;
+			case 2:
+				pOut[0] = To8(nSample[0]);
+				pOut[1] = To8(nSample[1]);
+				pOut[2] = To8(nSample[2]);
+				pOut[3] = (bKey && nSample[0] == nKey[0] && nSample[1] == nKey[1] && nSample[2] == nKey[2]) ? 0 : 255;
+				break;
+			case 3:
+				memcpy(pOut, nPalette[nSample[0] & 0xff], 4);
+				break;
+			case 4:
+				pOut[0] = pOut[1] = pOut[2] = To8(nSample[0]);
+				pOut[3] = To8(nSample[1]);
+				break;
+			case 6:
+				for (int ch = 0; ch < 4; ch++) pOut[ch] = To8(nSample[ch]);
+				break;
+			}
+		}
+		prev.swap(cur);
+	}
+	return true;
+}
+
+/****************************************//*
+	@brief　	| ベースラインJPEGを展開する
+	@param　	| pData：ファイルの内容
+	@param　	| inSize：ファイルのサイズ
+	@param　	| outImage：展開した画像の格納先
+	@param　	| outError：失敗した時のエラーメッセージ
+	@return		| true:成功 false:失敗
+	@note		| ハフマン符号のベースライン(SOF0/SOF1)のみ対応、プログレッシブと算術符号は非対応
+*//****************************************/
+bool DecodeJpeg(const uint8_t* pData, size_t inSize, Image& outImage, std::string& outError)
+{
+	uint16_t nQuant[4][64] = {};
+	JpegHuffman tHuffman[8] = {};	// DC0～3, AC0～3
+	std::vector<JpegComponent> tCompVec;
+	uint32_t nWidth = 0, nHeight = 0;
+	int nRestart = 0;
+	int nMaxH = 1, nMaxV = 1;
+	bool bDecoded = false;
+
+	size_t nPos = 2;
+	while (nPos + 4 <= inSize && !bDecoded)
+	{
+		// マーカーを探す(前に余分な0xFFが付くことがある)
+		if (pData[nPos] != 0xFF)
+		{
+			nPos++;
+			continue;
+		}
+		while (nPos < inSize && pData[nPos] == 0xFF) nPos++;
+		if (nPos >= inSize) break;
+		uint8_t nMarker = pData[nPos++];
+		if (nMarker == 0xD8 || (nMarker >= 0xD0 && nMarker <= 0xD7)) continue;
+		if (nMarker == 0xD9) break;
+		if (nPos + 2 > inSize) break;
+
+		size_t nLen = (pData[nPos] << 8) | pData[nPos + 1];
+		if (nLen < 2 || nPos + nLen > inSize)
+		{
+			outError = "truncated segment";
+			return false;
+		}
+		const uint8_t* pSeg = pData + nPos + 2;
+		size_t nSegLen = nLen - 2;
+		size_t nNext = nPos + nLen;
+
+		switch (nMarker)
+		{
+		case 0xC0:
+		case 0xC1:
+		{
+			// フレームヘッダー
+			if (nSegLen < 6 || pSeg[0] != 8)
+			{
+				outError = "unsupported sample precision";
+				return false;
+			}
+			nHeight = (pSeg[1] << 8) | pSeg[2];
+			nWidth = (pSeg[3] << 8) | pSeg[4];
+			int nCompNum = pSeg[5];
+			if (nCompNum != 1 && nCompNum != 3)
+			{
+				outError = "unsupported component count";
+				return false;
+			}
+			if (nSegLen < static_cast<size_t>(6 + nCompNum * 3)) return false;
+			tCompVec.resize(nCompNum);
+			for (int i = 0; i < nCompNum; i++)
+			{
+				JpegComponent& tComp = tCompVec[i];
+				tComp.m_nId = pSeg[6 + i * 3];
+				tComp.m_nH = pSeg[7 + i * 3] >> 4;
+				tComp.m_nV = pSeg[7 + i * 3] & 15;
+				tComp.m_nQuant = pSeg[8 + i * 3] & 3;
+				if (tComp.m_nH < 1 || tComp.m_nH > 4 || tComp.m_nV < 1 || tComp.m_nV > 4)
+				{
+					outError = "invalid sampling factor";
+					return false;
+				}
+				nMaxH = (std::max)(nMaxH, tComp.m_nH);
+				nMaxV = (std::max)(nMaxV, tComp.m_nV);
+			}
+			break;
+		}
+		case 0xC4:
+		{
+			// ハフマン符号表
+			size_t i = 0;
+			while (i + 17 <= nSegLen)
+			{
+				int nClass = pSeg[i] >> 4;
+				int nIndex = (pSeg[i] & 15) & 3;
+				JpegHuffman& h = tHuffman[nClass * 4 + nIndex];
+				int nCount[17] = {};
+				int nTotal = 0;
+				for (int l = 1; l <= 16; l++)
+				{
+					nCount[l] = pSeg[i + l];
+					nTotal += nCount[l];
+				}
+				i += 17;
+				if (nTotal > 256 || i + nTotal > nSegLen)
+				{
+					outError = "broken huffman table";
+					return false;
+				}
+				memcpy(h.m_nValue, pSeg + i, nTotal);
+				i += nTotal;
+
+				// 符号長毎の最小値・最大値と値の位置
+				int nCode = 0, k = 0;
+				for (int l = 1; l <= 16; l++)
+				{
+					h.m_nValPtr[l] = k;
+					h.m_nMinCode[l] = nCode;
+					nCode += nCount[l];
+					k += nCount[l];
+					h.m_nMaxCode[l] = nCount[l] ? nCode - 1 : -1;
+					nCode <<= 1;
+				}
+				h.m_nMaxCode[17] = INT_MAX;
+				h.m_bValid = true;
+			}
+			break;
+		}
+		case 0xDB:
+		{
+			// 量子化テーブル(ジグザグ順のまま保持する)
+			size_t i = 0;
+			while (i < nSegLen)
+			{
+				int nPrecision = pSeg[i] >> 4;
+				int nIndex = pSeg[i] & 3;
+				i++;
+				for (int k = 0; k < 64; k++)
+				{
+					if (nPrecision)
+					{
+						nQuant[nIndex][k] = static_cast<uint16_t>((pSeg[i] << 8) | pSeg[i + 1]);
+						i += 2;
+					}
+					else
+					{
+						nQuant[nIndex][k] = pSeg[i++];
+					}
+				}
+			}
+			break;
+		}
+		case 0xDD:
+			nRestart = (pSeg[0] << 8) | pSeg[1];
+			break;
+		case 0xDA:
+		{
+			// スキャン(全成分を1度に並べたインターリーブのみ対応)
+			if (tCompVec.empty())
+			{
+				outError = "scan before frame header";
+				return false;
+			}
+			int nScanNum = pSeg[0];
+			if (nScanNum != static_cast<int>(tCompVec.size()))
+			{
+				outError = "non-interleaved scan is not supported";
+				return false;
+			}
+			std::vector<JpegComponent*> pScanVec;
+			for (int i = 0; i < nScanNum; i++)
+			{
+				int nId = pSeg[1 + i * 2];
+				int nTable = pSeg[2 + i * 2];
+				for (JpegComponent& tComp : tCompVec)
+				{
+					if (tComp.m_nId != nId) continue;
+					tComp.m_nDcTable = (nTable >> 4) & 3;
+					tComp.m_nAcTable = nTable & 3;
+					pScanVec.push_back(&tComp);
+				}
+			}
+			if (static_cast<int>(pScanVec.size()) != nScanNum)
+			{
+				outError = "unknown component in scan";
+				return false;
+			}
+
+			// MCU(最小符号化単位)の数と、成分毎の画素の格納先
+			int nMcuW = 8 * nMaxH, nMcuH = 8 * nMaxV;
+			int nMcuX = static_cast<int>((nWidth + nMcuW - 1) / nMcuW);
+			int nMcuY = static_cast<int>((nHeight + nMcuH - 1) / nMcuH);
+			for (JpegComponent& tComp : tCompVec)
+			{
+				tComp.m_nStride = nMcuX * tComp.m_nH * 8;
+				tComp.m_Plane.assign(static_cast<size_t>(tComp.m_nStride) * nMcuY * tComp.m_nV * 8, 0);
+				tComp.m_nDcPred = 0;
+			}
+
+			JpegBitReader tReader = { pData, inSize, nNext, 0, 0 };
+			int nMcuCount = 0;
+			for (int my = 0; my < nMcuY; my++)
+			{
+				for (int mx = 0; mx < nMcuX; mx++)
+				{
+					// リスタートマーカーで予測値とビット位置を戻す
+					if (nRestart > 0 && nMcuCount > 0 && nMcuCount % nRestart == 0)
+					{
+						tReader.m_nBitCnt = 0;
+						if (tReader.m_nPos + 1 < inSize && pData[tReader.m_nPos] == 0xFF &&
+							pData[tReader.m_nPos + 1] >= 0xD0 && pData[tReader.m_nPos + 1] <= 0xD7)
+						{
+							tReader.m_nPos += 2;
+						}
+						for (JpegComponent& tComp : tCompVec) tComp.m_nDcPred = 0;
+					}
+					nMcuCount++;
+
+					for (JpegComponent* pComp : pScanVec)
+					{
+						const JpegHuffman& tDc = tHuffman[pComp->m_nDcTable];
+						const JpegHuffman& tAc = tHuffman[4 + pComp->m_nAcTable];
+						if (!tDc.m_bValid || !tAc.m_bValid)
+						{
+							outError = "missing huffman table";
+							return false;
+						}
+						const uint16_t* pQuant = nQuant[pComp->m_nQuant];
+
+						for (int by = 0; by < pComp->m_nV; by++)
+						{
+							for (int bx = 0; bx < pComp->m_nH; bx++)
+							{
+								// 直流成分は前のブロックとの差分、交流成分は0の連続数と値の組
+								int nCoef[64] = {};
+								int t = tReader.Decode(tDc);
+								if (t < 0)
+								{
+									outError = "broken huffman code";
+									return false;
+								}
+								pComp->m_nDcPred += tReader.Receive(t);
+								nCoef[0] = pComp->m_nDcPred * pQuant[0];
+								for (int k = 1; k < 64;)
+								{
+									int rs = tReader.Decode(tAc);
+									if (rs < 0)
+									{
+										outError = "broken huffman code";
+										return false;
+									}
+									int r = rs >> 4, s = rs & 15;
+									if (s == 0)
+									{
+										if (r != 15) break;
+										k += 16;
+										continue;
+									}
+									k += r;
+									if (k > 63) break;
+									nCoef[ce_nZigZag[k]] = tReader.Receive(s) * pQuant[k];
+									k++;
+								}
+
+								int nX = (mx * pComp->m_nH + bx) * 8;
+								int nY = (my * pComp->m_nV + by) * 8;
+								InverseDct(nCoef, &pComp->m_Plane[static_cast<size_t>(nY) * pComp->m_nStride + nX], pComp->m_nStride);
+							}
+						}
+					}
+				}
+			}
+			bDecoded = true;
+			break;
+		}
+		default:
+			if (nMarker == 0xC2 || nMarker == 0xC3 || (nMarker >= 0xC5 && nMarker <= 0xCF && nMarker != 0xC8 && nMarker != 0xCC))
+			{
+				outError = "progressive / lossless / arithmetic JPEG is not supported";
+				return false;
+			}
+			break;
+		}
+		nPos = nNext;
+	}
+
+	if (!bDecoded)
+	{
+		outError = "no image data";
+		return false;
+	}
+
+	// 色差成分を拡大してRGBに変換する
+	outImage.m_nWidth = nWidth;
+	outImage.m_nHeight = nHeight;
+	outImage.m_Pixels.assign(static_cast<size_t>(nWidth) * nHeight * 4, 255);
+	for (uint32_t y = 0; y < nHeight; y++)
+	{
+		for (uint32_t x = 0; x < nWidth; x++)
+		{
+			float fSample[3];
+			for (size_t c = 0; c < tCompVec.size(); c++)
+			{
+				const JpegComponent& tComp = tCompVec[c];
+				size_t sx = x * tComp.m_nH / nMaxH;
+				size_t sy = y * tComp.m_nV / nMaxV;
+				fSample[c] = tComp.m_Plane[sy * tComp.m_nStride + sx];
+			}
+
+			uint8_t* pOut = &outImage.m_Pixels[(static_cast<size_t>(y) * nWidth + x) * 4];
+			if (tCompVec.size() == 1)
+			{
+				pOut[0] = pOut[1] = pOut[2] = static_cast<uint8_t>(fSample[0]);
+				continue;
+			}
+			float fY = fSample[0], fCb = fSample[1] - 128.0f, fCr = fSample[2] - 128.0f;
+			pOut[0] = ClampByte(fY + 1.402f * fCr);
+			pOut[1] = ClampByte(fY - 0.344136f * fCb - 0.714136f * fCr);
+			pOut[2] = ClampByte(fY + 1.772f * fCb);
+		}
+	}
+	return true;
+}
@@ -0,0 +1,47 @@
+/**************************************************//*
+	@file	| ImageDecoder.h
+	@brief	| 画像読み込みのhファイル
+	@note	| テクスチャクッカー用にPNGとベースラインJPEGをRGBA8に展開する
+			| Windows以外でも動くように標準ライブラリだけで実装する
+*//**************************************************/
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// @brief RGBA8の画像
+struct Image
+{
+	// 横幅
+	uint32_t m_nWidth;
+
+	// 縦幅
+	uint32_t m_nHeight;
+
+	// 画素(RGBAの順に1バイトずつ、左上から行単位)
+	std::vector<uint8_t> m_Pixels;
+};
+
+// @brief 画像ファイルを読み込む(PNG / ベースラインJPEG)
+// @param inPath：ファイルのパス
+// @param outImage：読み込んだ画像の格納先
+// @param outError：失敗した時のエラーメッセージ
+// @return true:成功 false:失敗
+// @note 拡張子ではなくファイルの先頭のシグネチャで形式を判定する
+bool LoadImageFile(const std::string& inPath, Image& outImage, std::string& outError);
+
+// @brief PNGを展開する
+// @param pData：ファイルの内容
+// @param inSize：ファイルのサイズ
+// @param outImage：展開した画像の格納先
+// @param outError：失敗した時のエラーメッセージ
+// @return true:成功 false:失敗
+bool DecodePng(const uint8_t* pData, size_t inSize, Image& outImage, std::string& outError);
+
+// @brief ベースラインJPEGを展開する
+// @param pData：ファイルの内容
+// @param inSize：ファイルのサイズ
+// @param outImage：展開した画像の格納先
+// @param outError：失敗した時のエラーメッセージ
+// @return true:成功 false:失敗
+bool DecodeJpeg(const uint8_t* pData, size_t inSize, Image& outImage, std::string& outError);
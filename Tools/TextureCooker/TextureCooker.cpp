@@ -0,0 +1,463 @@
+/**************************************************//*
+	@file	| TextureCooker.cpp
+	@brief	| テクスチャクッカーのcppファイル
+	@note	| Assets/Textureの画像からミップマップを生成してブロック圧縮し、
+			| Assets/Texture/Cooked/<名前>.ddsに書き出す
+			| 実行時のTexture::Createは同名のddsがあればそちらを読み込む
+			| D3D11はブロック圧縮の最上段が4の倍数でないと作成できないため、その大きさは非圧縮で書き出す
+			| Windows以外でも動くように標準ライブラリだけで実装する
+			| ビルド：g++ -std=c++17 -O2 *.cpp -o TextureCooker
+			| 使い方：TextureCooker [入力フォルダ] [-out 出力フォルダ] [-format auto|bc1|bc3|bc7] [-srgb] [-force]
+*//**************************************************/
+#include "ImageDecoder.h"
+#include "BlockCompress.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	// @brief 出力形式の指定
+	enum class FormatOption
+	{
+		Auto,	// アルファが全て255ならBC1、それ以外はBC3
+		BC1,
+		BC3,
+		BC7,
+	};
+
+	// @brief コマンドラインの設定
+	struct CookOption
+	{
+		// 入力フォルダ
+		fs::path m_InputDir = "MyProject_SkillCreateAction/Assets/Texture";
+
+		// 出力フォルダ(空なら入力フォルダ/Cooked)
+		fs::path m_OutputDir;
+
+		// 出力形式
+		FormatOption m_eFormat = FormatOption::Auto;
+
+		// sRGBの形式で書き出すか
+		bool m_bSrgb = false;
+
+		// 出力が新しくても書き出し直すか
+		bool m_bForce = false;
+	};
+
+	// @brief 1枚分の結果
+	struct CookResult
+	{
+		// 非圧縮RGBA(ミップ無し)のバイト数
+		uint64_t m_ulRawByte;
+
+		// 出力したテクセルデータ(ミップ込み)のバイト数
+		uint64_t m_ulCookedByte;
+
+		// ミップの段数
+		uint32_t m_nMipNum;
+
+		// 圧縮形式
+		BlockFormat m_eFormat;
+
+		// ブロック圧縮したか(falseは非圧縮RGBA)
+		bool m_bCompress;
+
+		// 処理時間(ミリ秒)
+		double m_dMs;
+	};
+
+	// @brief DXGI_FORMATの値(dxgiformat.hと同じ)
+	constexpr uint32_t ce_nDxgiBC1 = 71;
+	constexpr uint32_t ce_nDxgiBC1Srgb = 72;
+	constexpr uint32_t ce_nDxgiBC3 = 77;
+	constexpr uint32_t ce_nDxgiBC3Srgb = 78;
+	constexpr uint32_t ce_nDxgiBC7 = 98;
+	constexpr uint32_t ce_nDxgiBC7Srgb = 99;
+	constexpr uint32_t ce_nDxgiRGBA8 = 28;
+	constexpr uint32_t ce_nDxgiRGBA8Srgb = 29;
+
+	// @brief 対象の拡張子か
+	bool IsImageFile(const fs::path& inPath)
+	{
+		std::string sExt = inPath.extension().string();
+		std::transform(sExt.begin(), sExt.end(), sExt.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return sExt == ".png" || sExt == ".jpg" || sExt == ".jpeg";
+	}
+
+	// @brief 形式の名前
+	const char* GetFormatName(BlockFormat inFormat, bool inCompress)
+	{
+		if (!inCompress) return "RGBA8";
+		switch (inFormat)
+		{
+		case BlockFormat::BC1: return "BC1";
+		case BlockFormat::BC3: return "BC3";
+		default:               return "BC7";
+		}
+	}
+
+	// @brief sRGBから線形への変換表
+	const float* GetSrgbToLinearTable()
+	{
+		static float s_fTable[256] = {};
+		static bool s_bInit = false;
+		if (!s_bInit)
+		{
+			for (int i = 0; i < 256; i++)
+			{
+				float c = i / 255.0f;
+				s_fTable[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+			s_bInit = true;
+		}
+		return s_fTable;
+	}
+
+	// @brief 線形からsRGBへ変換する
+	uint8_t LinearToSrgb(float inValue)
+	{
+		float c = (std::min)(1.0f, (std::max)(0.0f, inValue));
+		c = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+		return static_cast<uint8_t>(std::lround(c * 255.0f));
+	}
+
+	// @brief 1段小さいミップを生成する
+	// @note 2x2の平均を取る。色はガンマを外して平均し、アルファはそのまま平均する
+	Image Downsample(const Image& inSrc)
+	{
+		const float* pToLinear = GetSrgbToLinearTable();
+
+		Image tDst;
+		tDst.m_nWidth = (std::max)(1u, inSrc.m_nWidth / 2);
+		tDst.m_nHeight = (std::max)(1u, inSrc.m_nHeight / 2);
+		tDst.m_Pixels.resize(static_cast<size_t>(tDst.m_nWidth) * tDst.m_nHeight * 4);
+
+		for (uint32_t y = 0; y < tDst.m_nHeight; y++)
+		{
+			uint32_t nY0 = (std::min)(y * 2, inSrc.m_nHeight - 1);
+			uint32_t nY1 = (std::min)(y * 2 + 1, inSrc.m_nHeight - 1);
+			for (uint32_t x = 0; x < tDst.m_nWidth; x++)
+			{
+				uint32_t nX0 = (std::min)(x * 2, inSrc.m_nWidth - 1);
+				uint32_t nX1 = (std::min)(x * 2 + 1, inSrc.m_nWidth - 1);
+				const uint8_t* pSrc[4] = {
+					&inSrc.m_Pixels[(static_cast<size_t>(nY0) * inSrc.m_nWidth + nX0) * 4],
+					&inSrc.m_Pixels[(static_cast<size_t>(nY0) * inSrc.m_nWidth + nX1) * 4],
+					&inSrc.m_Pixels[(static_cast<size_t>(nY1) * inSrc.m_nWidth + nX0) * 4],
+					&inSrc.m_Pixels[(static_cast<size_t>(nY1) * inSrc.m_nWidth + nX1) * 4],
+				};
+
+				// 透明な画素の色が混ざらないようにアルファで重み付けする
+				float fColor[3] = {};
+				float fAlphaSum = 0.0f;
+				for (int k = 0; k < 4; k++)
+				{
+					float fAlpha = pSrc[k][3] / 255.0f;
+					fAlphaSum += fAlpha;
+					for (int c = 0; c < 3; c++) fColor[c] += pToLinear[pSrc[k][c]] * fAlpha;
+				}
+
+				uint8_t* pDst = &tDst.m_Pixels[(static_cast<size_t>(y) * tDst.m_nWidth + x) * 4];
+				for (int c = 0; c < 3; c++)
+				{
+					float fValue = 0.0f;
+					if (fAlphaSum > 0.0f) fValue = fColor[c] / fAlphaSum;
+					else
+					{
+						for (int k = 0; k < 4; k++) fValue += pToLinear[pSrc[k][c]] * 0.25f;
+					}
+					pDst[c] = LinearToSrgb(fValue);
+				}
+				pDst[3] = static_cast<uint8_t>(std::lround(fAlphaSum * 255.0f / 4.0f));
+			}
+		}
+		return tDst;
+	}
+
+	// @brief 1段分を圧縮する
+	// @note 4の倍数でない端のブロックは端の画素を繰り返して埋める
+	void CompressImage(const Image& inImage, BlockFormat inFormat, std::vector<uint8_t>& outData)
+	{
+		uint32_t nBlockX = (inImage.m_nWidth + 3) / 4;
+		uint32_t nBlockY = (inImage.m_nHeight + 3) / 4;
+		uint32_t nBlockByte = GetBlockByte(inFormat);
+		size_t nStart = outData.size();
+		outData.resize(nStart + static_cast<size_t>(nBlockX) * nBlockY * nBlockByte);
+
+		uint8_t nBlock[16 * 4];
+		for (uint32_t by = 0; by < nBlockY; by++)
+		{
+			for (uint32_t bx = 0; bx < nBlockX; bx++)
+			{
+				for (uint32_t py = 0; py < 4; py++)
+				{
+					uint32_t y = (std::min)(by * 4 + py, inImage.m_nHeight - 1);
+					for (uint32_t px = 0; px < 4; px++)
+					{
+						uint32_t x = (std::min)(bx * 4 + px, inImage.m_nWidth - 1);
+						memcpy(&nBlock[(py * 4 + px) * 4], &inImage.m_Pixels[(static_cast<size_t>(y) * inImage.m_nWidth + x) * 4], 4);
+					}
+				}
+
+				uint8_t* pOut = &outData[nStart + (static_cast<size_t>(by) * nBlockX + bx) * nBlockByte];
+				switch (inFormat)
+				{
+				case BlockFormat::BC1: CompressBlockBC1(nBlock, pOut); break;
+				case BlockFormat::BC3: CompressBlockBC3(nBlock, pOut); break;
+				case BlockFormat::BC7: CompressBlockBC7(nBlock, pOut); break;
+				}
+			}
+		}
+	}
+
+	// @brief 1段分を非圧縮のまま追加する
+	void AppendImage(const Image& inImage, std::vector<uint8_t>& outData)
+	{
+		outData.insert(outData.end(), inImage.m_Pixels.begin(), inImage.m_Pixels.end());
+	}
+
+	// @brief 32bitの値をリトルエンディアンで追加する
+	void PushU32(std::vector<uint8_t>& outData, uint32_t inValue)
+	{
+		for (int i = 0; i < 4; i++) outData.push_back(static_cast<uint8_t>(inValue >> (i * 8)));
+	}
+
+	// @brief DDSのヘッダーを作る
+	// @note BC7とsRGBはFourCCで表せないのでDX10の拡張ヘッダーを付ける
+	//       非圧縮の場合はRGBAのビットマスクで表す
+	std::vector<uint8_t> MakeDdsHeader(const Image& inImage, BlockFormat inFormat, bool inCompress, bool inSrgb, uint32_t inMipNum)
+	{
+		constexpr uint32_t ce_nFlagCaps = 0x1, ce_nFlagHeight = 0x2, ce_nFlagWidth = 0x4, ce_nFlagPitch = 0x8;
+		constexpr uint32_t ce_nFlagPixelFormat = 0x1000, ce_nFlagMipCount = 0x20000, ce_nFlagLinearSize = 0x80000;
+		constexpr uint32_t ce_nPixelAlpha = 0x1, ce_nPixelFourCC = 0x4, ce_nPixelRgb = 0x40;
+		constexpr uint32_t ce_nCapsComplex = 0x8, ce_nCapsTexture = 0x1000, ce_nCapsMipmap = 0x400000;
+		auto FourCC = [](const char* s) { return static_cast<uint32_t>(s[0]) | (s[1] << 8) | (s[2] << 16) | (s[3] << 24); };
+
+		bool bDx10 = inSrgb || (inCompress && inFormat == BlockFormat::BC7);
+		uint32_t nLinearSize = inCompress
+			? ((inImage.m_nWidth + 3) / 4) * ((inImage.m_nHeight + 3) / 4) * GetBlockByte(inFormat)
+			: inImage.m_nWidth * 4;
+
+		std::vector<uint8_t> tHeader;
+		PushU32(tHeader, FourCC("DDS "));
+		PushU32(tHeader, 124);
+		PushU32(tHeader, ce_nFlagCaps | ce_nFlagHeight | ce_nFlagWidth | ce_nFlagPixelFormat | ce_nFlagMipCount | (inCompress ? ce_nFlagLinearSize : ce_nFlagPitch));
+		PushU32(tHeader, inImage.m_nHeight);
+		PushU32(tHeader, inImage.m_nWidth);
+		PushU32(tHeader, nLinearSize);
+		PushU32(tHeader, 0);		// 深さ
+		PushU32(tHeader, inMipNum);
+		for (int i = 0; i < 11; i++) PushU32(tHeader, 0);
+
+		// ピクセルフォーマット
+		PushU32(tHeader, 32);
+		if (!bDx10 && !inCompress)
+		{
+			// R8G8B8A8(バイト順にR,G,B,A)
+			PushU32(tHeader, ce_nPixelRgb | ce_nPixelAlpha);
+			PushU32(tHeader, 0);
+			PushU32(tHeader, 32);
+			PushU32(tHeader, 0x000000ff);
+			PushU32(tHeader, 0x0000ff00);
+			PushU32(tHeader, 0x00ff0000);
+			PushU32(tHeader, 0xff000000);
+		}
+		else
+		{
+			PushU32(tHeader, ce_nPixelFourCC);
+			if (bDx10) PushU32(tHeader, FourCC("DX10"));
+			else PushU32(tHeader, FourCC(inFormat == BlockFormat::BC1 ? "DXT1" : "DXT5"));
+			for (int i = 0; i < 5; i++) PushU32(tHeader, 0);
+		}
+
+		PushU32(tHeader, ce_nCapsTexture | (inMipNum > 1 ? ce_nCapsComplex | ce_nCapsMipmap : 0));
+		for (int i = 0; i < 4; i++) PushU32(tHeader, 0);
+
+		if (bDx10)
+		{
+			uint32_t nDxgi = inSrgb ? ce_nDxgiRGBA8Srgb : ce_nDxgiRGBA8;
+			if (inCompress)
+			{
+				switch (inFormat)
+				{
+				case BlockFormat::BC1: nDxgi = inSrgb ? ce_nDxgiBC1Srgb : ce_nDxgiBC1; break;
+				case BlockFormat::BC3: nDxgi = inSrgb ? ce_nDxgiBC3Srgb : ce_nDxgiBC3; break;
+				case BlockFormat::BC7: nDxgi = inSrgb ? ce_nDxgiBC7Srgb : ce_nDxgiBC7; break;
+				}
+			}
+			PushU32(tHeader, nDxgi);
+			PushU32(tHeader, 3);	// D3D10_RESOURCE_DIMENSION_TEXTURE2D
+			PushU32(tHeader, 0);
+			PushU32(tHeader, 1);	// 配列数
+			PushU32(tHeader, 0);
+		}
+		return tHeader;
+	}
+
+	// @brief 1枚を変換して書き出す
+	// @return true:成功 false:失敗
+	bool CookTexture(const fs::path& inSrc, const fs::path& inDst, const CookOption& inOption, CookResult& outResult)
+	{
+		auto tStart = std::chrono::steady_clock::now();
+
+		Image tImage;
+		std::string sError;
+		if (!LoadImageFile(inSrc.string(), tImage, sError))
+		{
+			fprintf(stderr, "Error: %s: %s\n", inSrc.string().c_str(), sError.c_str());
+			return false;
+		}
+
+		// 形式の決定
+		BlockFormat eFormat = BlockFormat::BC3;
+		switch (inOption.m_eFormat)
+		{
+		case FormatOption::BC1: eFormat = BlockFormat::BC1; break;
+		case FormatOption::BC3: eFormat = BlockFormat::BC3; break;
+		case FormatOption::BC7: eFormat = BlockFormat::BC7; break;
+		case FormatOption::Auto:
+		{
+			bool bOpaque = true;
+			for (size_t i = 3; i < tImage.m_Pixels.size() && bOpaque; i += 4) bOpaque = tImage.m_Pixels[i] == 255;
+			eFormat = bOpaque ? BlockFormat::BC1 : BlockFormat::BC3;
+			break;
+		}
+		}
+
+		// 最上段が4の倍数でなければD3D11がブロック圧縮のテクスチャを作れないので非圧縮にする
+		bool bCompress = tImage.m_nWidth % 4 == 0 && tImage.m_nHeight % 4 == 0;
+
+		// 1x1までのミップを生成して圧縮する
+		std::vector<uint8_t> tData;
+		Image tMip = tImage;
+		uint32_t nMipNum = 0;
+		while (true)
+		{
+			if (bCompress) CompressImage(tMip, eFormat, tData);
+			else AppendImage(tMip, tData);
+			nMipNum++;
+			if (tMip.m_nWidth == 1 && tMip.m_nHeight == 1) break;
+			tMip = Downsample(tMip);
+		}
+
+		std::vector<uint8_t> tHeader = MakeDdsHeader(tImage, eFormat, bCompress, inOption.m_bSrgb, nMipNum);
+		std::ofstream tFile(inDst, std::ios::binary);
+		if (!tFile)
+		{
+			fprintf(stderr, "Error: %s を書き込めません\n", inDst.string().c_str());
+			return false;
+		}
+		tFile.write(reinterpret_cast<const char*>(tHeader.data()), tHeader.size());
+		tFile.write(reinterpret_cast<const char*>(tData.data()), tData.size());
+
+		outResult.m_ulRawByte = static_cast<uint64_t>(tImage.m_nWidth) * tImage.m_nHeight * 4;
+		outResult.m_ulCookedByte = tData.size();
+		outResult.m_nMipNum = nMipNum;
+		outResult.m_eFormat = eFormat;
+		outResult.m_bCompress = bCompress;
+		outResult.m_dMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tStart).count();
+
+		printf("%-24s %5ux%-5u %-5s mip%2u  raw %10llu B -> cooked %10llu B (%5.1f%%)  %8.1f ms\n",
+			inSrc.filename().string().c_str(), tImage.m_nWidth, tImage.m_nHeight, GetFormatName(eFormat, bCompress), nMipNum,
+			static_cast<unsigned long long>(outResult.m_ulRawByte), static_cast<unsigned long long>(outResult.m_ulCookedByte),
+			100.0 * outResult.m_ulCookedByte / outResult.m_ulRawByte, outResult.m_dMs);
+		return true;
+	}
+
+	// @brief コマンドラインの解析
+	// @return true:成功 false:不正な引数
+	bool ParseOption(int argc, char** argv, CookOption& outOption)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			std::string sArg = argv[i];
+			if (sArg == "-out" && i + 1 < argc) outOption.m_OutputDir = argv[++i];
+			else if (sArg == "-format" && i + 1 < argc)
+			{
+				std::string sFormat = argv[++i];
+				if (sFormat == "auto") outOption.m_eFormat = FormatOption::Auto;
+				else if (sFormat == "bc1") outOption.m_eFormat = FormatOption::BC1;
+				else if (sFormat == "bc3") outOption.m_eFormat = FormatOption::BC3;
+				else if (sFormat == "bc7") outOption.m_eFormat = FormatOption::BC7;
+				else return false;
+			}
+			else if (sArg == "-srgb") outOption.m_bSrgb = true;
+			else if (sArg == "-force") outOption.m_bForce = true;
+			else if (!sArg.empty() && sArg[0] != '-') outOption.m_InputDir = sArg;
+			else return false;
+		}
+		if (outOption.m_OutputDir.empty()) outOption.m_OutputDir = outOption.m_InputDir / "Cooked";
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	CookOption tOption;
+	if (!ParseOption(argc, argv, tOption))
+	{
+		fprintf(stderr, "Usage: TextureCooker [入力フォルダ] [-out 出力フォルダ] [-format auto|bc1|bc3|bc7] [-srgb] [-force]\n");
+		return 1;
+	}
+
+	std::error_code ec;
+	if (!fs::is_directory(tOption.m_InputDir, ec))
+	{
+		fprintf(stderr, "Error: %s はフォルダではありません\n", tOption.m_InputDir.string().c_str());
+		return 1;
+	}
+	fs::create_directories(tOption.m_OutputDir, ec);
+
+	// 名前順に処理する
+	std::vector<fs::path> tSourceVec;
+	for (const fs::directory_entry& tEntry : fs::directory_iterator(tOption.m_InputDir))
+	{
+		if (tEntry.is_regular_file() && IsImageFile(tEntry.path())) tSourceVec.push_back(tEntry.path());
+	}
+	std::sort(tSourceVec.begin(), tSourceVec.end());
+
+	uint64_t ulRawTotal = 0, ulCookedTotal = 0;
+	double dMsTotal = 0.0;
+	int nCookNum = 0, nSkipNum = 0, nFailNum = 0;
+	for (const fs::path& tSrc : tSourceVec)
+	{
+		fs::path tDst = tOption.m_OutputDir / tSrc.stem();
+		tDst += ".dds";
+
+		// 出力の方が新しければ書き出さない
+		if (!tOption.m_bForce && fs::exists(tDst, ec) && fs::last_write_time(tDst, ec) >= fs::last_write_time(tSrc, ec))
+		{
+			nSkipNum++;
+			continue;
+		}
+
+		CookResult tResult = {};
+		if (!CookTexture(tSrc, tDst, tOption, tResult))
+		{
+			nFailNum++;
+			continue;
+		}
+		nCookNum++;
+		ulRawTotal += tResult.m_ulRawByte;
+		ulCookedTotal += tResult.m_ulCookedByte;
+		dMsTotal += tResult.m_dMs;
+	}
+
+	printf("cooked %d, skipped %d, failed %d\n", nCookNum, nSkipNum, nFailNum);
+	if (nCookNum > 0)
+	{
+		printf("total raw %llu B -> cooked %llu B (%.1f%%), %.1f ms\n",
+			static_cast<unsigned long long>(ulRawTotal), static_cast<unsigned long long>(ulCookedTotal),
+			100.0 * ulCookedTotal / ulRawTotal, dMsTotal);
+	}
+	return nFailNum > 0 ? 1 : 0;
+}